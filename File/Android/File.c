@@ -1,4 +1,7 @@
 #include "../File.h"
+#include "../Compressed.h"
+#include "../Pack.h"
+#include "../VFS.h"
 
 #include <SDL2/SDL.h>
 #include <assert.h>
@@ -12,12 +15,15 @@
 	#define ANDROID_INFO(...) ((void)__android_log_print(ANDROID_LOG_INFO, "[FILE] ", __VA_ARGS__))
 
 AAssetManager* getAssetManager(void);
+static GAE_BOOL openCompressed(GAE_File_t* file);
+static GAE_BOOL readAt(void* source, const unsigned long offset, GAE_BYTE* destination, const unsigned long amount);
 
 GAE_File_t* GAE_File_create(const char* filePath) {
 	GAE_File_t* file = malloc(sizeof(GAE_File_t));
 	GAE_PlatformFile_t* platform = malloc(sizeof(GAE_PlatformFile_t));
 
-	strncpy(file->filePath, filePath, sizeof(file->filePath));
+	strncpy(file->filePath, filePath, sizeof(file->filePath) - 1U);
+	file->filePath[sizeof(file->filePath) - 1U] = '\0';
 	file->buffer = 0;
 	file->readPosition = 0U;
 	file->bufferSize = 0U;
@@ -27,6 +33,8 @@ GAE_File_t* GAE_File_create(const char* filePath) {
 	file->owned = GAE_FALSE;
 	platform->file = 0;
 	platform->asset = 0;
+	platform->entry = 0;
+	platform->compressed = 0;
 	file->platformFile = (void*)platform;
 
 	return file;
@@ -34,6 +42,11 @@ GAE_File_t* GAE_File_create(const char* filePath) {
 
 void GAE_File_delete(GAE_File_t* file) {
 	GAE_PlatformFile_t* platform = (GAE_PlatformFile_t*)file->platformFile;
+	if (0 != platform->compressed) {
+		GAE_Compressed_delete(platform->compressed);
+		platform->compressed = 0;
+	}
+
 	if (0 != platform->file) {
 		fclose(platform->file);
 		platform->file = 0;
@@ -44,6 +57,11 @@ void GAE_File_delete(GAE_File_t* file) {
 		platform->asset = 0;
 	}
 
+	if (0 != platform->entry) {
+		GAE_Pack_Entry_delete(platform->entry);
+		platform->entry = 0;
+	}
+
 	free(platform);
 	free(file);
 	file = 0;
@@ -51,7 +69,10 @@ void GAE_File_delete(GAE_File_t* file) {
 
 GAE_File_t* GAE_File_open(GAE_File_t* file, const GAE_FILE_OPEN_MODE openMode, const GAE_FILE_MODE fileMode, GAE_FILE_STATUS* status) {
 	GAE_PlatformFile_t* platform = (GAE_PlatformFile_t*)file->platformFile;
-	char options[2];
+	char options[3] = { '\0', '\0', '\0' };
+	char diskPath[GAE_VFS_PATH_SIZE];
+	const char* path = file->filePath;
+	GAE_VFS_Status found = GAE_VFS_UNKNOWN;
 
 	if (file->fileStatus != GAE_FILE_CLOSED) {
 		if (0 != status)
@@ -59,7 +80,7 @@ GAE_File_t* GAE_File_open(GAE_File_t* file, const GAE_FILE_OPEN_MODE openMode, c
 		return file;
 	}
 	
-	if (0 != platform->file) {
+	if ((0 != platform->file) || (0 != platform->asset) || (0 != platform->entry)) {
 		if (0 != status)
 			*status = GAE_FILE_ERROR;
 		return file;
@@ -70,9 +91,36 @@ GAE_File_t* GAE_File_open(GAE_File_t* file, const GAE_FILE_OPEN_MODE openMode, c
 			*status = GAE_FILE_ERROR;
 		return file;
 	}
+
+	if ((GAE_FILE_OPEN_WRITE != openMode) && (GAE_FILE_OPEN_APPEND != openMode)) {
+		found = GAE_VFS_resolve(file->filePath, diskPath, sizeof(diskPath), &platform->entry);
+		if (GAE_VFS_MISSING == found) {
+			if (0 != status)
+				*status = GAE_FILE_NOT_FOUND;
+			return file;
+		}
+
+		if (0 != platform->entry) {
+			file->fileSize = platform->entry->size;
+			file->owned = GAE_TRUE;
+			file->fileStatus = GAE_FILE_OPEN;
+			file->openMode = openMode;
+
+			if (0 != status)
+				*status = file->fileStatus;
+			return file;
+		}
+
+		if (GAE_VFS_FOUND == found)
+			path = diskPath;
+	}
+	else
+		GAE_VFS_forget(file->filePath);
 	
 	switch (openMode) {
 		case GAE_FILE_OPEN_READ:
+		case GAE_FILE_OPEN_MAP:			/* not mapped here - read in whole, as GAE_FILE_OPEN_READ */
+		case GAE_FILE_OPEN_MAP_RANDOM:
 			options[0] = 'r';
 			file->owned = GAE_TRUE;
 			break;
@@ -95,12 +143,14 @@ GAE_File_t* GAE_File_open(GAE_File_t* file, const GAE_FILE_OPEN_MODE openMode, c
 			break;
 	};
 	
-	platform->file = fopen(file->filePath, options);
+	platform->file = fopen(path, options);
 	
 	if (0 == platform->file) /* not on sdcard, lets try the apk */
-		platform->asset = AAssetManager_open(getAssetManager(), file->filePath, AASSET_MODE_UNKNOWN);
+		platform->asset = AAssetManager_open(getAssetManager(), path, AASSET_MODE_UNKNOWN);
 
 	if ((0 == platform->file) && (0 == platform->asset)) { /* nope, not found at all */
+		if ((GAE_FILE_OPEN_WRITE != openMode) && (GAE_FILE_OPEN_APPEND != openMode) && (GAE_VFS_UNKNOWN == found))
+			GAE_VFS_markMissing(file->filePath);
 		if (0 != status)
 			*status = GAE_FILE_NOT_FOUND;
 		ANDROID_INFO("File Not Found: %s", file->filePath);
@@ -117,6 +167,21 @@ GAE_File_t* GAE_File_open(GAE_File_t* file, const GAE_FILE_OPEN_MODE openMode, c
 	}
 	else
 		file->fileSize = AAsset_getLength(platform->asset);
+
+	if ((GAE_FILE_OPEN_WRITE != openMode) && (GAE_FILE_OPEN_APPEND != openMode) && (GAE_FALSE == openCompressed(file))) {
+		if (0 != platform->file)
+			fclose(platform->file);
+		if (0 != platform->asset)
+			AAsset_close(platform->asset);
+		platform->file = 0;
+		platform->asset = 0;
+		file->fileSize = 0U;
+		file->fileStatus = GAE_FILE_CLOSED;
+		if (0 != status)
+			*status = GAE_FILE_ERROR;
+		ANDROID_INFO("Damaged: %s", file->filePath);
+		return file;
+	}
 	
 	if (0 != status)
 		*status = file->fileStatus;
@@ -135,17 +200,27 @@ GAE_File_t* GAE_File_close(GAE_File_t* file, const GAE_FILE_CLOSE_MODE mode, GAE
 		return file;
 	}
 	
-	if (0 == platform->file) {
+	if ((0 == platform->file) && (0 == platform->asset) && (0 == platform->entry)) {
 		if (0 != status)
 			*status = GAE_FILE_ERROR;
 		return file;
 	}
 	
+	if (0 != platform->compressed) {
+		GAE_Compressed_delete(platform->compressed);
+		platform->compressed = 0;
+	}
+
 	if (0 != platform->file) {
 		fclose(platform->file);
 		platform->file = 0;
 	}
 
+	if (0 != platform->entry) {
+		GAE_Pack_Entry_delete(platform->entry);
+		platform->entry = 0;
+	}
+
 	if (0 != platform->asset) {
 		AAsset_close(platform->asset);
 		platform->asset = 0;
@@ -194,7 +269,7 @@ GAE_File_t* GAE_File_read(GAE_File_t* file, const unsigned long amount, GAE_FILE
 	unsigned long readAmount = amount;
 	long read = 0;
 
-	if (file->openMode != GAE_FILE_OPEN_READ) {
+	if ((file->openMode != GAE_FILE_OPEN_READ) && (file->openMode != GAE_FILE_OPEN_MAP) && (file->openMode != GAE_FILE_OPEN_MAP_RANDOM)) {
 		if (0 != status)
 			*status = GAE_FILE_READ_ERROR;
 		return file;
@@ -206,6 +281,14 @@ GAE_File_t* GAE_File_read(GAE_File_t* file, const unsigned long amount, GAE_FILE
 		return file;
 	}
 	
+	/* views into the pack aren't the file's to free, but are its to replace */
+	if (0 != platform->entry) {
+		if (GAE_TRUE == file->owned)
+			free(file->buffer);
+		file->buffer = 0;
+		return GAE_Pack_Entry_read(platform->entry, file, amount, status);
+	}
+
 	if (0 == platform->file && 0 == platform->asset) {
 		if (0 != status)
 			*status = GAE_FILE_READ_ERROR;
@@ -217,6 +300,12 @@ GAE_File_t* GAE_File_read(GAE_File_t* file, const unsigned long amount, GAE_FILE
 			*status = GAE_FILE_READ_ERROR;
 		return file;
 	}
+
+	if (0 != platform->compressed) {
+		free(file->buffer);
+		file->buffer = 0;
+		return GAE_Compressed_read(platform->compressed, file, amount, status);
+	}
 	
 	if (readAmount < file->fileSize)
 		file->bufferSize = readAmount;
@@ -229,7 +318,6 @@ GAE_File_t* GAE_File_read(GAE_File_t* file, const unsigned long amount, GAE_FILE
 		free(file->buffer);
 	
 	file->buffer = malloc(file->bufferSize + 1U);
-	memset(file->buffer, '\0', file->bufferSize);
 	if (0 == file->buffer) {
 		if (0 != status)
 			*status = GAE_FILE_READ_ERROR;
@@ -244,6 +332,9 @@ GAE_File_t* GAE_File_read(GAE_File_t* file, const unsigned long amount, GAE_FILE
 		read = AAsset_read(platform->asset, file->buffer, file->bufferSize);
 
 	file->readPosition += (unsigned long)read;
+	/* terminated for text, and zeroed past a short read rather than left as whatever malloc gave */
+	if (0 <= read)
+		memset(file->buffer + read, '\0', file->bufferSize + 1U - (unsigned long)read);
 
 	ANDROID_INFO("Read %d", file->readPosition);
 	
@@ -264,6 +355,66 @@ GAE_File_t* GAE_File_read(GAE_File_t* file, const unsigned long amount, GAE_FILE
 	}
 }
 
+GAE_File_t* GAE_File_readInto(GAE_File_t* file, GAE_BYTE* destination, const unsigned long amount, unsigned long* readAmount, GAE_FILE_READ_STATUS* status) {
+	GAE_PlatformFile_t* platform = (GAE_PlatformFile_t*)file->platformFile;
+	unsigned long used = 0U;
+	GAE_BOOL isEOF = GAE_FALSE;
+
+	if (0 != readAmount)
+		*readAmount = 0U;
+
+	if ((file->openMode != GAE_FILE_OPEN_READ) && (file->openMode != GAE_FILE_OPEN_MAP) && (file->openMode != GAE_FILE_OPEN_MAP_RANDOM)) {
+		if (0 != status)
+			*status = GAE_FILE_READ_ERROR;
+		return file;
+	}
+
+	if (file->fileStatus != GAE_FILE_OPEN) {
+		if (0 != status)
+			*status = GAE_FILE_READ_ERROR;
+		return file;
+	}
+
+	if (0 != platform->entry)
+		return GAE_Pack_Entry_readInto(platform->entry, file, destination, amount, readAmount, status);
+
+	if (0 != platform->compressed)
+		return GAE_Compressed_readInto(platform->compressed, file, destination, amount, readAmount, status);
+
+	if (0 != platform->file) {
+		used = (unsigned long)fread(destination, 1, amount, platform->file);
+		isEOF = (0 != feof(platform->file)) ? GAE_TRUE : GAE_FALSE;
+	}
+	else if (0 != platform->asset) {
+		while (used < amount) {
+			const int got = AAsset_read(platform->asset, destination + used, amount - used);
+			if (0 < got)
+				used += (unsigned long)got;
+			else {
+				isEOF = (0 == got) ? GAE_TRUE : GAE_FALSE;
+				break;
+			}
+		}
+	}
+	else {
+		if (0 != status)
+			*status = GAE_FILE_READ_ERROR;
+		return file;
+	}
+
+	file->readPosition += used;
+	if (0 != readAmount)
+		*readAmount = used;
+
+	if (0 != status) {
+		if (used == amount)
+			*status = GAE_FILE_READ_OK;
+		else
+			*status = (GAE_TRUE == isEOF) ? GAE_FILE_READ_EOF : GAE_FILE_READ_ERROR;
+	}
+	return file;
+}
+
 GAE_File_t* GAE_File_write(GAE_File_t* file, GAE_FILE_WRITE_STATUS* status) {
 	GAE_PlatformFile_t* platform = (GAE_PlatformFile_t*)file->platformFile;
 	long written = 0;
@@ -305,7 +456,7 @@ GAE_File_t* GAE_File_write(GAE_File_t* file, GAE_FILE_WRITE_STATUS* status) {
 	}
 }
 
-GAE_File_t* GAE_FILE_setReadPosition(GAE_File_t* file, const unsigned long readPosition, GAE_FILE_READ_STATUS* status) {
+GAE_File_t* GAE_File_setReadPosition(GAE_File_t* file, const unsigned long readPosition, GAE_FILE_READ_STATUS* status) {
 	GAE_PlatformFile_t* platform = (GAE_PlatformFile_t*)file->platformFile;
 
 	if (file->fileStatus != GAE_FILE_OPEN) {
@@ -314,19 +465,27 @@ GAE_File_t* GAE_FILE_setReadPosition(GAE_File_t* file, const unsigned long readP
 		return file;
 	}
 	
-	if (file->openMode != GAE_FILE_OPEN_READ) {
+	if ((file->openMode != GAE_FILE_OPEN_READ) && (file->openMode != GAE_FILE_OPEN_MAP) && (file->openMode != GAE_FILE_OPEN_MAP_RANDOM)) {
 		if (0 != status)
 			*status = GAE_FILE_READ_ERROR;
 		return file;
 	}
 	
-	if (0 == platform->file) {
+	/* packs and decompressing both read from readPosition, so there's nothing else to move */
+	if ((0 != platform->entry) || (0 != platform->compressed)) {
+		file->readPosition = (readPosition < file->fileSize) ? readPosition : file->fileSize;
+		if (0 != status)
+			*status = (readPosition < file->fileSize) ? GAE_FILE_READ_OK : GAE_FILE_READ_EOF;
+		return file;
+	}
+
+	if ((0 == platform->file) && (0 == platform->asset)) {
 		if (0 != status)
 			*status = GAE_FILE_READ_ERROR;
 		return file;
 	}
 	
-	if (file->readPosition < file->fileSize) {
+	if (readPosition < file->fileSize) {
 		file->readPosition = readPosition;
 		if (0 != platform->file)
 			fseek(platform->file, file->readPosition, SEEK_SET);
@@ -393,7 +552,7 @@ GAE_File_t* GAE_File_setBuffer(GAE_File_t* file, unsigned char* buffer, const un
 	return file;
 }
 
-GAE_File_t* GAE_FILE_newBuffer(GAE_File_t* file, const unsigned long size, GAE_BOOL* status) {
+GAE_File_t* GAE_File_newBuffer(GAE_File_t* file, const unsigned long size, GAE_BOOL* status) {
 	if (file->fileStatus == GAE_FILE_OPEN) {
 		if (0 != status)
 			*status = GAE_FALSE;
@@ -413,6 +572,53 @@ GAE_File_t* GAE_FILE_newBuffer(GAE_File_t* file, const unsigned long size, GAE_B
 	return file;
 }
 
+GAE_BOOL openCompressed(GAE_File_t* file) {
+	GAE_PlatformFile_t* platform = (GAE_PlatformFile_t*)file->platformFile;
+	GAE_BYTE header[GAE_COMPRESSED_HEADER_SIZE];
+	GAE_BOOL isCompressed = GAE_FALSE;
+
+	if (GAE_COMPRESSED_HEADER_SIZE <= file->fileSize)
+		isCompressed = ((GAE_TRUE == readAt(platform, 0U, header, sizeof(header))) && (GAE_TRUE == GAE_Compressed_isHeader(header, sizeof(header)))) ? GAE_TRUE : GAE_FALSE;
+
+	if (GAE_FALSE == isCompressed) {
+		if (0 != platform->file)
+			rewind(platform->file);
+		if (0 != platform->asset)
+			AAsset_seek(platform->asset, 0, SEEK_SET);
+		return GAE_TRUE;
+	}
+
+	platform->compressed = GAE_Compressed_create(readAt, platform, file->fileSize);
+	if (0 == platform->compressed)
+		return GAE_FALSE;
+
+	file->fileSize = platform->compressed->size;
+	return GAE_TRUE;
+}
+
+GAE_BOOL readAt(void* source, const unsigned long offset, GAE_BYTE* destination, const unsigned long amount) {
+	GAE_PlatformFile_t* platform = (GAE_PlatformFile_t*)source;
+	unsigned long used = 0U;
+
+	if (0 != platform->file) {
+		if (0 != fseek(platform->file, (long)offset, SEEK_SET))
+			return GAE_FALSE;
+		return (amount == (unsigned long)fread(destination, 1U, amount, platform->file)) ? GAE_TRUE : GAE_FALSE;
+	}
+
+	if (-1 == AAsset_seek(platform->asset, (off_t)offset, SEEK_SET))
+		return GAE_FALSE;
+
+	while (used < amount) {
+		const int got = AAsset_read(platform->asset, destination + used, amount - used);
+		if (0 >= got)
+			return GAE_FALSE;
+		used += (unsigned long)got;
+	}
+
+	return GAE_TRUE;
+}
+
 AAssetManager* getAssetManager(void) {
 	JNIEnv* jniEnv = (JNIEnv*)SDL_AndroidGetJNIEnv();
 
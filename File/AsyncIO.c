@@ -0,0 +1,306 @@
+#include "AsyncIO.h"
+
+#include <stdlib.h>
+
+#include "../Threads/Thread.h"
+#include "../Utils/Array.h"
+
+static void workerMain(void* userData);
+static void readRequest(GAE_AsyncIO_t* io, GAE_AsyncIO_Request_t* request);
+static GAE_BOOL removeRequest(GAE_AsyncIO_Request_t** list, GAE_AsyncIO_Request_t* request);
+static void complete(GAE_AsyncIO_t* io, GAE_AsyncIO_Request_t* request);
+static void discard(GAE_File_t* file);
+static void deleteRequests(GAE_AsyncIO_Request_t* request);
+
+GAE_AsyncIO_t* GAE_AsyncIO_create(const unsigned int threadCount) {
+	GAE_AsyncIO_t* io = malloc(sizeof(GAE_AsyncIO_t));
+	const unsigned int count = (0U == threadCount) ? 2U : threadCount;
+	unsigned int index = 0U;
+
+	io->queued = 0;
+	io->inFlight = 0;
+	io->completed = 0;
+	io->lastCompleted = 0;
+	io->mutex = GAE_Mutex_create();
+	io->requestReady = GAE_Condition_create();
+	io->completedReady = GAE_Condition_create();
+	io->nextId = 1U;
+	io->stats.queuedRequests = 0U;
+	io->stats.inFlightRequests = 0U;
+	io->stats.inFlightBytes = 0UL;
+	io->stats.completedRequests = 0U;
+	io->stats.readBytes = 0UL;
+	io->isRunning = GAE_TRUE;
+
+	io->threads = GAE_Array_create(sizeof(GAE_Thread_t*));
+	for (index = 0U; index < count; ++index) {
+		GAE_Thread_t* thread = GAE_Thread_create(workerMain, io);
+		if (0 != thread)
+			GAE_Array_push(io->threads, &thread);
+	}
+
+	return io;
+}
+
+unsigned int GAE_AsyncIO_read(GAE_AsyncIO_t* io, GAE_File_t* file, const GAE_FILE_OPEN_MODE openMode, const GAE_FILE_MODE fileMode, const int priority, GAE_AsyncIO_Callback_t callback, void* userData) {
+	GAE_AsyncIO_Request_t* request = 0;
+	GAE_AsyncIO_Request_t** next = 0;
+
+	if ((GAE_FILE_OPEN_WRITE == openMode) || (GAE_FILE_OPEN_APPEND == openMode) || (GAE_FILE_CLOSED != file->fileStatus) || (0 != file->buffer))
+		return 0U;
+
+	if (0U == GAE_Array_length(io->threads))
+		return 0U;
+
+	request = malloc(sizeof(GAE_AsyncIO_Request_t));
+	if (0 == request)
+		return 0U;
+
+	request->file = file;
+	request->openMode = openMode;
+	request->fileMode = fileMode;
+	request->priority = priority;
+	request->callback = callback;
+	request->userData = userData;
+	request->size = 0UL;
+	request->status = GAE_ASYNCIO_FAILED;
+	request->isCancelled = GAE_FALSE;
+
+	GAE_Mutex_lock(io->mutex);
+	request->id = io->nextId++;
+	if (0U == io->nextId)
+		io->nextId = 1U;
+
+	/* behind everything of the same priority or higher, so equal priorities stay in order */
+	next = &io->queued;
+	while ((0 != *next) && ((*next)->priority >= priority))
+		next = &(*next)->next;
+	request->next = *next;
+	*next = request;
+	++io->stats.queuedRequests;
+
+	GAE_Condition_signal(io->requestReady);
+	GAE_Mutex_unlock(io->mutex);
+
+	return request->id;
+}
+
+GAE_BOOL GAE_AsyncIO_cancel(GAE_AsyncIO_t* io, const unsigned int id) {
+	GAE_AsyncIO_Request_t* request = 0;
+	GAE_BOOL isFound = GAE_FALSE;
+
+	GAE_Mutex_lock(io->mutex);
+
+	/* queued requests go straight to completed, in flight ones are thrown away when their read ends */
+	request = io->queued;
+	while ((0 != request) && (id != request->id))
+		request = request->next;
+
+	if (0 != request) {
+		removeRequest(&io->queued, request);
+		--io->stats.queuedRequests;
+		request->isCancelled = GAE_TRUE;
+		complete(io, request);
+		isFound = GAE_TRUE;
+	}
+
+	for (request = io->inFlight; (GAE_FALSE == isFound) && (0 != request); request = request->next) {
+		if (id == request->id) {
+			request->isCancelled = GAE_TRUE;
+			isFound = GAE_TRUE;
+		}
+	}
+
+	for (request = io->completed; (GAE_FALSE == isFound) && (0 != request); request = request->next) {
+		if (id == request->id) {
+			if (GAE_FALSE == request->isCancelled)
+				discard(request->file);
+			request->isCancelled = GAE_TRUE;
+			request->status = GAE_ASYNCIO_CANCELLED;
+			isFound = GAE_TRUE;
+		}
+	}
+
+	GAE_Mutex_unlock(io->mutex);
+	return isFound;
+}
+
+GAE_AsyncIO_t* GAE_AsyncIO_update(GAE_AsyncIO_t* io) {
+	GAE_AsyncIO_Request_t* request = 0;
+
+	/* taken in one go, so callbacks run unlocked and can queue more reads */
+	GAE_Mutex_lock(io->mutex);
+	request = io->completed;
+	io->completed = 0;
+	io->lastCompleted = 0;
+	io->stats.completedRequests = 0U;
+	GAE_Mutex_unlock(io->mutex);
+
+	while (0 != request) {
+		GAE_AsyncIO_Request_t* next = request->next;
+		if (0 != request->callback)
+			request->callback(request->file, request->status, request->userData);
+		free(request);
+		request = next;
+	}
+
+	return io;
+}
+
+GAE_AsyncIO_t* GAE_AsyncIO_flush(GAE_AsyncIO_t* io) {
+	for (;;) {
+		GAE_BOOL isIdle = GAE_FALSE;
+
+		GAE_Mutex_lock(io->mutex);
+		while ((0 == io->completed) && ((0 != io->queued) || (0 != io->inFlight)))
+			GAE_Condition_wait(io->completedReady, io->mutex);
+		isIdle = ((0 == io->completed) && (0 == io->queued) && (0 == io->inFlight)) ? GAE_TRUE : GAE_FALSE;
+		GAE_Mutex_unlock(io->mutex);
+
+		if (GAE_TRUE == isIdle)
+			return io;
+
+		GAE_AsyncIO_update(io);
+	}
+}
+
+GAE_AsyncIO_t* GAE_AsyncIO_getStats(GAE_AsyncIO_t* io, GAE_AsyncIO_Stats_t* stats) {
+	GAE_Mutex_lock(io->mutex);
+	*stats = io->stats;
+	GAE_Mutex_unlock(io->mutex);
+
+	return io;
+}
+
+void GAE_AsyncIO_delete(GAE_AsyncIO_t* io) {
+	GAE_Thread_t** thread = 0;
+
+	GAE_Mutex_lock(io->mutex);
+	io->isRunning = GAE_FALSE;
+	GAE_Condition_broadcast(io->requestReady);
+	GAE_Mutex_unlock(io->mutex);
+
+	thread = GAE_Array_begin(io->threads);
+	while (thread != GAE_Array_end(io->threads)) {
+		GAE_Thread_delete(*thread);
+		++thread;
+	}
+	GAE_Array_delete(io->threads);
+
+	deleteRequests(io->queued);
+	deleteRequests(io->completed);
+
+	GAE_Condition_delete(io->requestReady);
+	GAE_Condition_delete(io->completedReady);
+	GAE_Mutex_delete(io->mutex);
+	free(io);
+	io = 0;
+}
+
+void workerMain(void* userData) {
+	GAE_AsyncIO_t* io = (GAE_AsyncIO_t*)userData;
+
+	for (;;) {
+		GAE_AsyncIO_Request_t* request = 0;
+
+		GAE_Mutex_lock(io->mutex);
+		while ((GAE_TRUE == io->isRunning) && (0 == io->queued))
+			GAE_Condition_wait(io->requestReady, io->mutex);
+
+		if (GAE_FALSE == io->isRunning) {
+			GAE_Mutex_unlock(io->mutex);
+			return;
+		}
+
+		request = io->queued;
+		io->queued = request->next;
+		request->next = io->inFlight;
+		io->inFlight = request;
+		--io->stats.queuedRequests;
+		++io->stats.inFlightRequests;
+		GAE_Mutex_unlock(io->mutex);
+
+		readRequest(io, request);
+
+		GAE_Mutex_lock(io->mutex);
+		removeRequest(&io->inFlight, request);
+		--io->stats.inFlightRequests;
+		io->stats.inFlightBytes -= request->size;
+		if (GAE_ASYNCIO_DONE == request->status)
+			io->stats.readBytes += request->file->bufferSize;
+		if ((GAE_TRUE == request->isCancelled) && (GAE_ASYNCIO_DONE == request->status))
+			discard(request->file);
+		complete(io, request);
+		GAE_Mutex_unlock(io->mutex);
+	}
+}
+
+void readRequest(GAE_AsyncIO_t* io, GAE_AsyncIO_Request_t* request) {
+	GAE_File_t* file = request->file;
+	GAE_FILE_STATUS fileStatus = GAE_FILE_ERROR;
+	GAE_FILE_READ_STATUS readStatus = GAE_FILE_READ_ERROR;
+
+	GAE_File_open(file, request->openMode, request->fileMode, &fileStatus);
+	if (GAE_FILE_OPEN != fileStatus)
+		return;
+
+	GAE_Mutex_lock(io->mutex);
+	request->size = file->fileSize;
+	io->stats.inFlightBytes += request->size;
+	GAE_Mutex_unlock(io->mutex);
+
+	GAE_File_read(file, GAE_FILE_READ_ALL, &readStatus);
+	if (GAE_FILE_READ_ERROR == readStatus) {
+		GAE_File_close(file, GAE_FILE_CLOSE_DELETE_DATA, 0);
+		discard(file);
+		return;
+	}
+
+	GAE_File_close(file, GAE_FILE_CLOSE_RETAIN_DATA, 0);
+	request->status = GAE_ASYNCIO_DONE;
+}
+
+GAE_BOOL removeRequest(GAE_AsyncIO_Request_t** list, GAE_AsyncIO_Request_t* request) {
+	GAE_AsyncIO_Request_t** next = list;
+
+	while ((0 != *next) && (request != *next))
+		next = &(*next)->next;
+
+	if (0 == *next)
+		return GAE_FALSE;
+
+	*next = request->next;
+	request->next = 0;
+	return GAE_TRUE;
+}
+
+void complete(GAE_AsyncIO_t* io, GAE_AsyncIO_Request_t* request) {
+	if (GAE_TRUE == request->isCancelled)
+		request->status = GAE_ASYNCIO_CANCELLED;
+
+	request->next = 0;
+	if (0 == io->lastCompleted)
+		io->completed = request;
+	else
+		io->lastCompleted->next = request;
+	io->lastCompleted = request;
+	++io->stats.completedRequests;
+
+	GAE_Condition_signal(io->completedReady);
+}
+
+void discard(GAE_File_t* file) {
+	/* views into a pack aren't owned, and are simply dropped */
+	GAE_File_deleteBuffer(file, 0);
+	file->buffer = 0;
+	file->bufferSize = 0UL;
+}
+
+void deleteRequests(GAE_AsyncIO_Request_t* request) {
+	while (0 != request) {
+		GAE_AsyncIO_Request_t* next = request->next;
+		discard(request->file);
+		free(request);
+		request = next;
+	}
+}
@@ -0,0 +1,83 @@
+#ifndef _ASYNC_IO_H_
+#define _ASYNC_IO_H_
+
+#include "File.h"
+
+/*
+	Reads whole files on worker threads, so loading never stalls the frame.
+	Requests are taken highest priority first, oldest first within a priority. Each file is opened, read in whole and closed
+	with its data kept, then handed back through its callback from GAE_AsyncIO_update - so callbacks always run on whichever
+	thread calls that, at a point it chooses. A file belongs to the service from being queued until its callback, and must not be touched meanwhile.
+	Everything but the workers should be called from the one thread.
+*/
+
+struct GAE_Array_s;
+struct GAE_Mutex_s;
+struct GAE_Condition_s;
+
+typedef enum GAE_AsyncIO_Status_e {
+	GAE_ASYNCIO_DONE				/* the file is closed, with its data in buffer */
+,	GAE_ASYNCIO_FAILED				/* it couldn't be opened or read - the file is closed with no buffer */
+,	GAE_ASYNCIO_CANCELLED			/* as failed, but because it was asked to be */
+} GAE_AsyncIO_Status;
+
+typedef void (*GAE_AsyncIO_Callback_t)(GAE_File_t* file, const GAE_AsyncIO_Status status, void* userData);
+
+typedef struct GAE_AsyncIO_Request_s {
+	unsigned int id;
+	GAE_File_t* file;
+	GAE_FILE_OPEN_MODE openMode;
+	GAE_FILE_MODE fileMode;
+	int priority;
+	GAE_AsyncIO_Callback_t callback;
+	void* userData;
+	unsigned long size;				/* of the file, once it's open */
+	GAE_AsyncIO_Status status;
+	GAE_BOOL isCancelled;
+	struct GAE_AsyncIO_Request_s* next;
+} GAE_AsyncIO_Request_t;
+
+typedef struct GAE_AsyncIO_Stats_s {
+	unsigned int queuedRequests;	/* waiting for a worker */
+	unsigned int inFlightRequests;	/* being read now */
+	unsigned long inFlightBytes;	/* total size of the files being read now */
+	unsigned int completedRequests;	/* waiting for GAE_AsyncIO_update to call back */
+	unsigned long readBytes;		/* read since the service was created */
+} GAE_AsyncIO_Stats_t;
+
+typedef struct GAE_AsyncIO_s {
+	struct GAE_Array_s* threads;
+	GAE_AsyncIO_Request_t* queued;
+	GAE_AsyncIO_Request_t* inFlight;
+	GAE_AsyncIO_Request_t* completed;	/* in the order they finished */
+	GAE_AsyncIO_Request_t* lastCompleted;
+	struct GAE_Mutex_s* mutex;
+	struct GAE_Condition_s* requestReady;
+	struct GAE_Condition_s* completedReady;
+	unsigned int nextId;
+	GAE_AsyncIO_Stats_t stats;
+	GAE_BOOL isRunning;
+} GAE_AsyncIO_t;
+
+/* Creates a new service with its worker threads - a threadCount of 0 uses two, as they mostly wait on the disk. */
+GAE_AsyncIO_t* GAE_AsyncIO_create(const unsigned int threadCount);
+
+/* Queues file, which must be closed with no buffer, to be read in whole - returns the request's id, or 0 if it couldn't be queued. */
+unsigned int GAE_AsyncIO_read(GAE_AsyncIO_t* io, GAE_File_t* file, const GAE_FILE_OPEN_MODE openMode, const GAE_FILE_MODE fileMode, const int priority, GAE_AsyncIO_Callback_t callback, void* userData);
+
+/* Cancels the request - its callback still comes, with GAE_ASYNCIO_CANCELLED. Returns GAE_FALSE if it had already been called back. */
+GAE_BOOL GAE_AsyncIO_cancel(GAE_AsyncIO_t* io, const unsigned int id);
+
+/* Calls back every request finished since the last update. */
+GAE_AsyncIO_t* GAE_AsyncIO_update(GAE_AsyncIO_t* io);
+
+/* Blocks until every request has finished and been called back. */
+GAE_AsyncIO_t* GAE_AsyncIO_flush(GAE_AsyncIO_t* io);
+
+/* Fills stats with the counts as they are now. */
+GAE_AsyncIO_t* GAE_AsyncIO_getStats(GAE_AsyncIO_t* io, GAE_AsyncIO_Stats_t* stats);
+
+/* Stops the worker threads once they finish their current reads and deletes the service - requests not yet called back never are, and their files are left closed with no buffer. */
+void GAE_AsyncIO_delete(GAE_AsyncIO_t* io);
+
+#endif
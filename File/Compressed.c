@@ -0,0 +1,359 @@
+#include "Compressed.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../Threads/Thread.h"
+#include "../Utils/LZ4.h"
+#include "../Utils/Zstd.h"
+
+/* fewer blocks a thread than this and starting it costs more than it saves */
+#define GAE_COMPRESSED_THREAD_BLOCKS 4U
+
+typedef struct Unpacker_s {
+	GAE_Compressed_t* compressed;
+	const GAE_BYTE* packed;			/* the stored data of the whole run */
+	GAE_BYTE* destination;			/* where the whole run goes */
+	unsigned int first;				/* the block the run starts with */
+	unsigned int start;				/* this share of it */
+	unsigned int end;
+	GAE_BOOL isValid;
+	GAE_Thread_t* thread;
+} Unpacker_t;
+
+static unsigned int readUint32(const GAE_BYTE* data);
+static unsigned long packLZ4(void* packer, const GAE_BYTE* const source, const unsigned long size, GAE_BYTE* destination, const unsigned long capacity);
+static void writeUint32(GAE_BYTE* data, const unsigned int value);
+static unsigned long getBlockLength(GAE_Compressed_t* const compressed, const unsigned int index);
+static GAE_BOOL unpackBlock(GAE_Compressed_t* const compressed, const unsigned int index, const GAE_BYTE* packed, GAE_BYTE* destination);
+static GAE_BOOL loadBlock(GAE_Compressed_t* compressed, const unsigned int index);
+static GAE_BOOL unpackBlocks(GAE_Compressed_t* compressed, const unsigned int first, const unsigned int count, GAE_BYTE* destination);
+static void unpackerMain(void* userData);
+static GAE_BOOL decompress(GAE_Compressed_t* compressed, const unsigned long position, GAE_BYTE* destination, const unsigned long amount);
+
+GAE_BOOL GAE_Compressed_isHeader(const GAE_BYTE* const data, const unsigned long count) {
+	return ((GAE_COMPRESSED_HEADER_SIZE <= count) && ((0 == memcmp(data, "GLZ4", 4U)) || (0 == memcmp(data, "GZST", 4U)))) ? GAE_TRUE : GAE_FALSE;
+}
+
+GAE_Compressed_t* GAE_Compressed_create(GAE_Compressed_Source_t read, void* source, const unsigned long sourceSize) {
+	GAE_Compressed_t* compressed = 0;
+	GAE_BYTE header[GAE_COMPRESSED_HEADER_SIZE];
+	GAE_BYTE* table = 0;
+	unsigned long tableSize = 0U;
+	unsigned int index = 0U;
+	GAE_BOOL isValid = GAE_TRUE;
+
+	if ((GAE_COMPRESSED_HEADER_SIZE > sourceSize) || (GAE_FALSE == read(source, 0U, header, sizeof(header))))
+		return 0;
+
+	if ((GAE_FALSE == GAE_Compressed_isHeader(header, sizeof(header))) || (GAE_COMPRESSED_VERSION != readUint32(header + 4U)))
+		return 0;
+
+	if ((0U == readUint32(header + 12U)) || (GAE_COMPRESSED_MAX_BLOCK_SIZE < readUint32(header + 12U)))
+		return 0;
+
+	compressed = malloc(sizeof(GAE_Compressed_t));
+	compressed->read = read;
+	compressed->source = source;
+	compressed->codec = (0 == memcmp(header, "GZST", 4U)) ? GAE_COMPRESSED_CODEC_ZSTD : GAE_COMPRESSED_CODEC_LZ4;
+	compressed->size = readUint32(header + 8U);
+	compressed->blockSize = readUint32(header + 12U);
+	compressed->blockCount = (unsigned int)((compressed->size + compressed->blockSize - 1U) / compressed->blockSize);
+	compressed->offsets = 0;
+	compressed->packed = 0;
+	compressed->block = 0;
+	compressed->blockIndex = compressed->blockCount;
+
+	tableSize = ((unsigned long)compressed->blockCount + 1U) * 4U;
+	if (tableSize > sourceSize - GAE_COMPRESSED_HEADER_SIZE) {
+		GAE_Compressed_delete(compressed);
+		return 0;
+	}
+
+	compressed->offsets = malloc(((unsigned long)compressed->blockCount + 1U) * sizeof(unsigned long));
+	compressed->packed = malloc(compressed->blockSize);
+	compressed->block = malloc(compressed->blockSize);
+	table = malloc(tableSize);
+	if ((0 == compressed->offsets) || (0 == compressed->packed) || (0 == compressed->block) || (0 == table)
+	||	(GAE_FALSE == read(source, GAE_COMPRESSED_HEADER_SIZE, table, tableSize))) {
+		free(table);
+		GAE_Compressed_delete(compressed);
+		return 0;
+	}
+
+	/* checked once here, so reads never need to - every block is stored in at most its own length */
+	compressed->offsets[0] = readUint32(table);
+	isValid = (GAE_COMPRESSED_HEADER_SIZE + tableSize == compressed->offsets[0]) ? GAE_TRUE : GAE_FALSE;
+	for (index = 1U; (index <= compressed->blockCount) && (GAE_TRUE == isValid); ++index) {
+		compressed->offsets[index] = readUint32(table + index * 4U);
+		if ((compressed->offsets[index] <= compressed->offsets[index - 1U]) || (compressed->offsets[index] > sourceSize))
+			isValid = GAE_FALSE;
+		else if (compressed->offsets[index] - compressed->offsets[index - 1U] > getBlockLength(compressed, index - 1U))
+			isValid = GAE_FALSE;
+	}
+
+	free(table);
+	if (GAE_FALSE == isValid) {
+		GAE_Compressed_delete(compressed);
+		return 0;
+	}
+
+	return compressed;
+}
+
+GAE_File_t* GAE_Compressed_read(GAE_Compressed_t* compressed, GAE_File_t* file, const unsigned long amount, GAE_FILE_READ_STATUS* status) {
+	const unsigned long remaining = (file->readPosition < compressed->size) ? compressed->size - file->readPosition : 0U;
+	const unsigned long size = (amount < remaining) ? amount : remaining;
+
+	file->buffer = malloc(size + 1U);
+	if ((0 == file->buffer) || (GAE_FALSE == decompress(compressed, file->readPosition, file->buffer, size))) {
+		free(file->buffer);
+		file->buffer = 0;
+		file->bufferSize = 0U;
+		if (0 != status)
+			*status = GAE_FILE_READ_ERROR;
+		return file;
+	}
+
+	file->buffer[size] = '\0';
+	file->owned = GAE_TRUE;
+	file->bufferSize = size;
+	file->readPosition += size;
+
+	/* as the disk reads - a chunk that runs short is the end, but asking for the whole file isn't */
+	if (0 != status)
+		*status = ((amount < compressed->size) && (size < amount)) ? GAE_FILE_READ_EOF : GAE_FILE_READ_OK;
+	return file;
+}
+
+GAE_File_t* GAE_Compressed_readInto(GAE_Compressed_t* compressed, GAE_File_t* file, GAE_BYTE* destination, const unsigned long amount, unsigned long* readAmount, GAE_FILE_READ_STATUS* status) {
+	const unsigned long remaining = (file->readPosition < compressed->size) ? compressed->size - file->readPosition : 0U;
+	const unsigned long size = (amount < remaining) ? amount : remaining;
+
+	if (0 != readAmount)
+		*readAmount = 0U;
+
+	if (GAE_FALSE == decompress(compressed, file->readPosition, destination, size)) {
+		if (0 != status)
+			*status = GAE_FILE_READ_ERROR;
+		return file;
+	}
+
+	file->readPosition += size;
+
+	if (0 != readAmount)
+		*readAmount = size;
+	if (0 != status)
+		*status = (size < amount) ? GAE_FILE_READ_EOF : GAE_FILE_READ_OK;
+	return file;
+}
+
+GAE_BYTE* GAE_Compressed_compress(const GAE_BYTE* const data, const unsigned long size, const unsigned long blockSize, unsigned long* compressedSize) {
+	return GAE_Compressed_compressWith(GAE_COMPRESSED_CODEC_LZ4, packLZ4, 0, data, size, blockSize, compressedSize);
+}
+
+GAE_BYTE* GAE_Compressed_compressWith(const GAE_Compressed_Codec codec, GAE_Compressed_Packer_t pack, void* packer, const GAE_BYTE* const data, const unsigned long size, const unsigned long blockSize, unsigned long* compressedSize) {
+	const unsigned long blockCount = (0U != blockSize) ? (size + blockSize - 1U) / blockSize : 0U;
+	const unsigned long tableSize = (blockCount + 1U) * 4U;
+	unsigned long position = GAE_COMPRESSED_HEADER_SIZE + tableSize;
+	unsigned long index = 0U;
+	GAE_BYTE* output = 0;
+
+	/* every block stored as it is, at worst, and sizes and offsets are 32 bit */
+	if ((0U == blockSize) || (GAE_COMPRESSED_MAX_BLOCK_SIZE < blockSize) || (0xFFFFFFFFUL - position <= size))
+		return 0;
+
+	output = malloc(position + size);
+	if (0 == output)
+		return 0;
+
+	memcpy(output, (GAE_COMPRESSED_CODEC_ZSTD == codec) ? "GZST" : "GLZ4", 4U);
+	writeUint32(output + 4U, GAE_COMPRESSED_VERSION);
+	writeUint32(output + 8U, (unsigned int)size);
+	writeUint32(output + 12U, (unsigned int)blockSize);
+
+	for (index = 0U; index < blockCount; ++index) {
+		const GAE_BYTE* block = data + index * blockSize;
+		const unsigned long length = (index + 1U < blockCount) ? blockSize : size - index * blockSize;
+		/* packed straight into place - anything not smaller is stored as it is over the top */
+		const unsigned long packedSize = (1U < length) ? pack(packer, block, length, output + position, length - 1U) : 0U;
+
+		writeUint32(output + GAE_COMPRESSED_HEADER_SIZE + index * 4U, (unsigned int)position);
+		if ((0U != packedSize) && (packedSize < length))
+			position += packedSize;
+		else {
+			memcpy(output + position, block, length);
+			position += length;
+		}
+	}
+	writeUint32(output + GAE_COMPRESSED_HEADER_SIZE + blockCount * 4U, (unsigned int)position);
+
+	*compressedSize = position;
+	return output;
+}
+
+void GAE_Compressed_delete(GAE_Compressed_t* compressed) {
+	free(compressed->offsets);
+	free(compressed->packed);
+	free(compressed->block);
+	free(compressed);
+	compressed = 0;
+}
+
+unsigned int readUint32(const GAE_BYTE* data) {
+	return (unsigned int)data[0] | ((unsigned int)data[1] << 8U) | ((unsigned int)data[2] << 16U) | ((unsigned int)data[3] << 24U);
+}
+
+unsigned long packLZ4(void* packer, const GAE_BYTE* const source, const unsigned long size, GAE_BYTE* destination, const unsigned long capacity) {
+	(void)packer;
+	return GAE_LZ4_compress(source, size, destination, capacity);
+}
+
+void writeUint32(GAE_BYTE* data, const unsigned int value) {
+	data[0] = (GAE_BYTE)(value & 0xFFU);
+	data[1] = (GAE_BYTE)((value >> 8U) & 0xFFU);
+	data[2] = (GAE_BYTE)((value >> 16U) & 0xFFU);
+	data[3] = (GAE_BYTE)(value >> 24U);
+}
+
+unsigned long getBlockLength(GAE_Compressed_t* const compressed, const unsigned int index) {
+	return (index + 1U < compressed->blockCount) ? compressed->blockSize : compressed->size - (unsigned long)index * compressed->blockSize;
+}
+
+GAE_BOOL unpackBlock(GAE_Compressed_t* const compressed, const unsigned int index, const GAE_BYTE* packed, GAE_BYTE* destination) {
+	const unsigned long storedSize = compressed->offsets[index + 1U] - compressed->offsets[index];
+	const unsigned long length = getBlockLength(compressed, index);
+
+	if (storedSize == length) {
+		memcpy(destination, packed, length);
+		return GAE_TRUE;
+	}
+
+	if (GAE_COMPRESSED_CODEC_ZSTD == compressed->codec)
+		return GAE_Zstd_decompress(packed, storedSize, destination, length);
+	return GAE_LZ4_decompress(packed, storedSize, destination, length);
+}
+
+GAE_BOOL loadBlock(GAE_Compressed_t* compressed, const unsigned int index) {
+	const unsigned long storedSize = compressed->offsets[index + 1U] - compressed->offsets[index];
+
+	if (index == compressed->blockIndex)
+		return GAE_TRUE;
+
+	compressed->blockIndex = compressed->blockCount;
+	if (GAE_FALSE == compressed->read(compressed->source, compressed->offsets[index], compressed->packed, storedSize))
+		return GAE_FALSE;
+
+	if (GAE_FALSE == unpackBlock(compressed, index, compressed->packed, compressed->block))
+		return GAE_FALSE;
+
+	compressed->blockIndex = index;
+	return GAE_TRUE;
+}
+
+GAE_BOOL unpackBlocks(GAE_Compressed_t* compressed, const unsigned int first, const unsigned int count, GAE_BYTE* destination) {
+	const unsigned long storedSize = compressed->offsets[first + count] - compressed->offsets[first];
+	unsigned int unpackerCount = GAE_Thread_getHardwareCount();
+	Unpacker_t single;
+	Unpacker_t* unpackers = &single;
+	GAE_BYTE* packed = (1U == count) ? compressed->packed : malloc(storedSize);
+	unsigned int index = 0U;
+	GAE_BOOL isValid = GAE_TRUE;
+
+	/* one read for the lot, which slow storage much prefers to one a block */
+	if ((0 == packed) || (GAE_FALSE == compressed->read(compressed->source, compressed->offsets[first], packed, storedSize))) {
+		if (packed != compressed->packed)
+			free(packed);
+		return GAE_FALSE;
+	}
+
+	if (count / GAE_COMPRESSED_THREAD_BLOCKS < unpackerCount)
+		unpackerCount = count / GAE_COMPRESSED_THREAD_BLOCKS;
+	if (1U < unpackerCount)
+		unpackers = malloc(unpackerCount * sizeof(Unpacker_t));
+	if ((0U == unpackerCount) || (0 == unpackers)) {
+		unpackerCount = 1U;
+		unpackers = &single;
+	}
+
+	for (index = 0U; index < unpackerCount; ++index) {
+		Unpacker_t* unpacker = &unpackers[index];
+		unpacker->compressed = compressed;
+		unpacker->packed = packed;
+		unpacker->destination = destination;
+		unpacker->first = first;
+		unpacker->start = first + (unsigned int)(((unsigned long)count * index) / unpackerCount);
+		unpacker->end = first + (unsigned int)(((unsigned long)count * (index + 1U)) / unpackerCount);
+		unpacker->isValid = GAE_FALSE;
+		/* the calling thread takes the first share itself */
+		unpacker->thread = (0U < index) ? GAE_Thread_create(unpackerMain, unpacker) : 0;
+	}
+
+	unpackerMain(&unpackers[0]);
+	for (index = 0U; index < unpackerCount; ++index) {
+		Unpacker_t* unpacker = &unpackers[index];
+		if (0 != unpacker->thread)
+			GAE_Thread_delete(unpacker->thread);
+		else if (0U < index)
+			/* no thread to be had, so it's done here */
+			unpackerMain(unpacker);
+
+		if (GAE_FALSE == unpacker->isValid)
+			isValid = GAE_FALSE;
+	}
+
+	if (unpackers != &single)
+		free(unpackers);
+	if (packed != compressed->packed)
+		free(packed);
+	return isValid;
+}
+
+void unpackerMain(void* userData) {
+	Unpacker_t* unpacker = (Unpacker_t*)userData;
+	GAE_Compressed_t* compressed = unpacker->compressed;
+	const unsigned long start = compressed->offsets[unpacker->first];
+	unsigned int index = 0U;
+
+	unpacker->isValid = GAE_TRUE;
+	for (index = unpacker->start; (index < unpacker->end) && (GAE_TRUE == unpacker->isValid); ++index) {
+		const GAE_BYTE* packed = unpacker->packed + (compressed->offsets[index] - start);
+		GAE_BYTE* destination = unpacker->destination + (unsigned long)(index - unpacker->first) * compressed->blockSize;
+		unpacker->isValid = unpackBlock(compressed, index, packed, destination);
+	}
+}
+
+GAE_BOOL decompress(GAE_Compressed_t* compressed, const unsigned long position, GAE_BYTE* destination, const unsigned long amount) {
+	unsigned long done = 0U;
+
+	while (done < amount) {
+		const unsigned long at = position + done;
+		const unsigned int index = (unsigned int)(at / compressed->blockSize);
+		const unsigned long offset = at % compressed->blockSize;
+		const unsigned long length = getBlockLength(compressed, index);
+		unsigned long size = length - offset;
+
+		/* whole blocks go straight into destination, all together */
+		if ((0U == offset) && (amount - done >= length)) {
+			const unsigned long end = position + amount;
+			const unsigned int last = (end == compressed->size) ? compressed->blockCount : (unsigned int)(end / compressed->blockSize);
+			const unsigned long covered = ((last == compressed->blockCount) ? compressed->size : (unsigned long)last * compressed->blockSize) - at;
+
+			if (GAE_FALSE == unpackBlocks(compressed, index, last - index, destination + done))
+				return GAE_FALSE;
+			done += covered;
+			continue;
+		}
+
+		/* part blocks are unpacked whole and kept, as the next chunk most likely carries on from here */
+		if (amount - done < size)
+			size = amount - done;
+		if (GAE_FALSE == loadBlock(compressed, index))
+			return GAE_FALSE;
+
+		memcpy(destination + done, compressed->block + offset, size);
+		done += size;
+	}
+
+	return GAE_TRUE;
+}
@@ -0,0 +1,71 @@
+#ifndef _COMPRESSED_H_
+#define _COMPRESSED_H_
+
+#include "File.h"
+
+/*
+	Compressed files - GAE_File_open spots the header on a file opened to read, and reads from then on come back decompressed,
+	with fileSize the decompressed size, so nothing above the file layer knows the difference.
+	The data is cut into blocks of a fixed size, so any part of it can be read without unpacking what comes before:
+	chunked reads unpack only the blocks they touch, keeping the last for the reads after, and reads of many blocks
+	fetch all of them in one go and unpack them across every hardware thread.
+	All values little endian:
+	 0 - "GLZ4" or "GZST"   8 - size
+	 4 - version           12 - block size
+	followed by an offset for every block and one past the last, from the start of the file, where its data begins.
+	"GLZ4" blocks are raw LZ4 blocks, "GZST" blocks are each a whole Zstandard frame - slower to unpack, but smaller.
+	A block stored at its full size didn't compress, and is kept as it is.
+*/
+
+#define GAE_COMPRESSED_VERSION 1U
+#define GAE_COMPRESSED_HEADER_SIZE 16U
+#define GAE_COMPRESSED_BLOCK_SIZE 131072U
+/* larger blocks would only be a way to make opening a damaged file allocate wildly */
+#define GAE_COMPRESSED_MAX_BLOCK_SIZE 16777216U
+
+typedef enum GAE_Compressed_Codec_e {
+	GAE_COMPRESSED_CODEC_LZ4
+,	GAE_COMPRESSED_CODEC_ZSTD
+} GAE_Compressed_Codec;
+
+/* Reads amount bytes from offset in source, returning GAE_TRUE only if it got them all. */
+typedef GAE_BOOL (*GAE_Compressed_Source_t)(void* source, const unsigned long offset, GAE_BYTE* destination, const unsigned long amount);
+
+/* Packs size bytes at source into at most capacity bytes at destination for a codec, returning how many it took - or 0 if it didn't fit. */
+typedef unsigned long (*GAE_Compressed_Packer_t)(void* packer, const GAE_BYTE* const source, const unsigned long size, GAE_BYTE* destination, const unsigned long capacity);
+
+typedef struct GAE_Compressed_s {
+	GAE_Compressed_Source_t read;
+	void* source;
+	GAE_Compressed_Codec codec;
+	unsigned long size;				/* decompressed */
+	unsigned long blockSize;
+	unsigned int blockCount;
+	unsigned long* offsets;
+	GAE_BYTE* packed;				/* a single block as stored */
+	GAE_BYTE* block;				/* the last block unpacked for a chunked read */
+	unsigned int blockIndex;		/* of block, or blockCount while it holds none */
+} GAE_Compressed_t;
+
+/* Returns whether the first count bytes of a file start a compressed one. */
+GAE_BOOL GAE_Compressed_isHeader(const GAE_BYTE* const data, const unsigned long count);
+
+/* Reads the header and offsets of the sourceSize bytes of compressed file read from source, returning 0 if they aren't valid. */
+GAE_Compressed_t* GAE_Compressed_create(GAE_Compressed_Source_t read, void* source, const unsigned long sourceSize);
+
+/* Decompresses amount bytes from file->readPosition into a new buffer, as GAE_File_read does. */
+GAE_File_t* GAE_Compressed_read(GAE_Compressed_t* compressed, GAE_File_t* file, const unsigned long amount, GAE_FILE_READ_STATUS* status);
+
+/* Decompresses amount bytes from file->readPosition into destination, as GAE_File_readInto does. */
+GAE_File_t* GAE_Compressed_readInto(GAE_Compressed_t* compressed, GAE_File_t* file, GAE_BYTE* destination, const unsigned long amount, unsigned long* readAmount, GAE_FILE_READ_STATUS* status);
+
+/* Compresses size bytes at data into a new LZ4 compressed file of blockSize blocks, returning it and its size in compressedSize, or 0 if it's too large. */
+GAE_BYTE* GAE_Compressed_compress(const GAE_BYTE* const data, const unsigned long size, const unsigned long blockSize, unsigned long* compressedSize);
+
+/* As GAE_Compressed_compress, with each block packed for codec by pack - only LZ4 can be packed here, so Zstandard needs an encoder of the caller's. */
+GAE_BYTE* GAE_Compressed_compressWith(const GAE_Compressed_Codec codec, GAE_Compressed_Packer_t pack, void* packer, const GAE_BYTE* const data, const unsigned long size, const unsigned long blockSize, unsigned long* compressedSize);
+
+/* Deletes the compressed file - the source is left for its owner to close. */
+void GAE_Compressed_delete(GAE_Compressed_t* compressed);
+
+#endif
@@ -7,6 +7,8 @@ typedef enum GAE_FILE_OPEN_MODE_e {
 	GAE_FILE_OPEN_READ
 ,	GAE_FILE_OPEN_WRITE
 ,	GAE_FILE_OPEN_APPEND
+,	GAE_FILE_OPEN_MAP			/* read only, mapped straight into buffer where the platform can, and read front to back - a chunk is only terminated if it runs to the end */
+,	GAE_FILE_OPEN_MAP_RANDOM	/* as GAE_FILE_OPEN_MAP, but read in no particular order */
 } GAE_FILE_OPEN_MODE;
 	
 typedef enum GAE_FILE_MODE_e {
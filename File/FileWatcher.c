@@ -0,0 +1,228 @@
+#include "FileWatcher.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(LINUX) || defined(PANDORA)
+	#include <sys/inotify.h>
+	#include <unistd.h>
+#endif
+
+#include "Pack.h"
+#include "../Time/Clock.h"
+#include "../Utils/Array.h"
+
+/* room for plenty of events a read - any more are picked up by the next */
+#define GAE_FILEWATCHER_EVENT_BUFFER 4096U
+
+static int watchDirectory(GAE_FileWatcher_t* watcher, const char* const path);
+static void readEvents(GAE_FileWatcher_t* watcher, const float time);
+static void markChanged(GAE_FileWatcher_t* watcher, const int directory, const char* const name, const float time);
+
+GAE_FileWatcher_t* GAE_FileWatcher_create(const float debounceTime) {
+	GAE_FileWatcher_t* watcher = malloc(sizeof(GAE_FileWatcher_t));
+
+	watcher->watches = GAE_Array_create(sizeof(GAE_FileWatcher_Watch_t));
+	watcher->clock = GAE_Clock_create();
+	watcher->debounceTime = debounceTime;
+#if defined(LINUX) || defined(PANDORA)
+	watcher->descriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#else
+	watcher->descriptor = -1;
+#endif
+
+	return watcher;
+}
+
+GAE_FileWatcher_t* GAE_FileWatcher_watch(GAE_FileWatcher_t* watcher, const char* const path, GAE_FileWatcher_Callback_t callback, void* userData, GAE_BOOL* status) {
+	GAE_FileWatcher_Watch_t watch;
+
+	if ((0 == callback) || (sizeof(watch.path) <= strlen(path))) {
+		if (0 != status)
+			*status = GAE_FALSE;
+		return watcher;
+	}
+
+	watch.directory = watchDirectory(watcher, path);
+	if (-1 == watch.directory) {
+		if (0 != status)
+			*status = GAE_FALSE;
+		return watcher;
+	}
+
+	watch.hash = GAE_Pack_hashPath(path);
+	strcpy(watch.path, path);
+	watch.callback = callback;
+	watch.userData = userData;
+	watch.changedTime = 0.0F;
+	watch.isChanged = GAE_FALSE;
+	GAE_Array_push(watcher->watches, &watch);
+
+	if (0 != status)
+		*status = GAE_TRUE;
+	return watcher;
+}
+
+GAE_FileWatcher_t* GAE_FileWatcher_unwatch(GAE_FileWatcher_t* watcher, const char* const path, void* userData, GAE_BOOL* status) {
+	const GAE_HashString_t hash = GAE_Pack_hashPath(path);
+	const unsigned int length = GAE_Array_length(watcher->watches);
+	unsigned int index = 0U;
+	int directory = -1;
+
+	for (index = 0U; index < length; ++index) {
+		GAE_FileWatcher_Watch_t* watch = GAE_Array_get(watcher->watches, index);
+		if ((hash == watch->hash) && (userData == watch->userData)) {
+			/* the last watch takes its place, as order doesn't matter */
+			GAE_FileWatcher_Watch_t* last = GAE_Array_get(watcher->watches, length - 1U);
+			directory = watch->directory;
+			if (watch != last)
+				memcpy(watch, last, sizeof(GAE_FileWatcher_Watch_t));
+			free(GAE_Array_pop(watcher->watches));
+			break;
+		}
+	}
+
+	if (-1 == directory) {
+		if (0 != status)
+			*status = GAE_FALSE;
+		return watcher;
+	}
+
+#if defined(LINUX) || defined(PANDORA)
+	/* the directory's left watched for as long as anything else in it is */
+	for (index = 0U; index < length - 1U; ++index) {
+		GAE_FileWatcher_Watch_t* watch = GAE_Array_get(watcher->watches, index);
+		if (directory == watch->directory)
+			break;
+	}
+
+	if (length - 1U == index)
+		inotify_rm_watch(watcher->descriptor, directory);
+#endif
+
+	if (0 != status)
+		*status = GAE_TRUE;
+	return watcher;
+}
+
+GAE_FileWatcher_t* GAE_FileWatcher_update(GAE_FileWatcher_t* watcher) {
+	unsigned int index = 0U;
+	float now = 0.0F;
+
+	GAE_Clock_update(watcher->clock);
+	now = watcher->clock->deltaTime;
+	readEvents(watcher, now);
+
+	/* fetched afresh each time round, as callbacks are free to watch and unwatch */
+	for (index = 0U; index < GAE_Array_length(watcher->watches); ++index) {
+		GAE_FileWatcher_Watch_t* watch = GAE_Array_get(watcher->watches, index);
+		if ((GAE_TRUE == watch->isChanged) && (now - watch->changedTime >= watcher->debounceTime)) {
+			GAE_FileWatcher_Callback_t callback = watch->callback;
+			void* userData = watch->userData;
+			char path[sizeof(watch->path)];
+
+			strcpy(path, watch->path);
+			watch->isChanged = GAE_FALSE;
+			callback(path, userData);
+		}
+	}
+
+	return watcher;
+}
+
+void GAE_FileWatcher_delete(GAE_FileWatcher_t* watcher) {
+#if defined(LINUX) || defined(PANDORA)
+	/* closing drops every directory watch along with it */
+	if (-1 != watcher->descriptor)
+		close(watcher->descriptor);
+#endif
+
+	GAE_Array_delete(watcher->watches);
+	GAE_Clock_delete(watcher->clock);
+	free(watcher);
+	watcher = 0;
+}
+
+int watchDirectory(GAE_FileWatcher_t* watcher, const char* const path) {
+#if defined(LINUX) || defined(PANDORA)
+	const char* slash = strrchr(path, '/');
+	char directory[sizeof(((GAE_FileWatcher_Watch_t*)0)->path)];
+
+	if (-1 == watcher->descriptor)
+		return -1;
+
+	if (0 == slash)
+		strcpy(directory, ".");
+	else if (slash == path)
+		strcpy(directory, "/");
+	else {
+		const size_t length = (size_t)(slash - path);
+		memcpy(directory, path, length);
+		directory[length] = '\0';
+	}
+
+	/* watching the same directory again hands back the same descriptor, so files in it share one watch */
+	return inotify_add_watch(watcher->descriptor, directory, IN_CLOSE_WRITE | IN_MOVED_TO | IN_MODIFY);
+#else
+	(void)watcher;
+	(void)path;
+	return 0;
+#endif
+}
+
+void readEvents(GAE_FileWatcher_t* watcher, const float time) {
+#if defined(LINUX) || defined(PANDORA)
+	union {
+		struct inotify_event event;
+		char bytes[GAE_FILEWATCHER_EVENT_BUFFER];
+	} buffer;
+
+	if (-1 == watcher->descriptor)
+		return;
+
+	/* nonblocking, so this stops as soon as there's nothing left to read */
+	for (;;) {
+		const ssize_t length = read(watcher->descriptor, buffer.bytes, sizeof(buffer.bytes));
+		ssize_t offset = 0;
+
+		if (length <= 0)
+			break;
+
+		while (offset < length) {
+			const struct inotify_event* event = (const struct inotify_event*)(void*)(buffer.bytes + offset);
+
+			if (0U != (event->mask & IN_Q_OVERFLOW))
+				/* events were lost, so any file might have changed */
+				markChanged(watcher, -1, 0, time);
+			else if (0U < event->len)
+				markChanged(watcher, event->wd, event->name, time);
+
+			offset += (ssize_t)(sizeof(struct inotify_event) + event->len);
+		}
+	}
+#else
+	(void)watcher;
+	(void)time;
+#endif
+}
+
+void markChanged(GAE_FileWatcher_t* watcher, const int directory, const char* const name, const float time) {
+	GAE_FileWatcher_Watch_t* watch = GAE_Array_begin(watcher->watches);
+
+	while (watch != GAE_Array_end(watcher->watches)) {
+		GAE_BOOL isMatch = GAE_TRUE;
+
+		if (0 != name) {
+			const char* slash = strrchr(watch->path, '/');
+			const char* fileName = (0 == slash) ? watch->path : slash + 1;
+			isMatch = ((directory == watch->directory) && (0 == strcmp(fileName, name))) ? GAE_TRUE : GAE_FALSE;
+		}
+
+		/* every further write pushes the callback back */
+		if (GAE_TRUE == isMatch) {
+			watch->isChanged = GAE_TRUE;
+			watch->changedTime = time;
+		}
+		++watch;
+	}
+}
@@ -0,0 +1,52 @@
+#ifndef _FILE_WATCHER_H_
+#define _FILE_WATCHER_H_
+
+#include "../GAE_Types.h"
+
+/*
+	Watches files for changes so content can be reloaded while running.
+	Each watched file's directory is watched rather than the file, as editors often save by writing a new file and renaming it over the old.
+	Watches are kept by path hash, as GAE_Pack_hashPath gives, so a path only matches itself spelled the same way.
+	Changes are held until a file has been left alone for the debounce time, so a burst of writes from one save calls back once.
+	Poll with GAE_FileWatcher_update once a frame - it never blocks, and callbacks run from it.
+	Only Linux has a watcher - elsewhere nothing ever changes.
+*/
+
+struct GAE_Array_s;
+struct GAE_Clock_s;
+
+typedef void (*GAE_FileWatcher_Callback_t)(const char* const path, void* userData);
+
+typedef struct GAE_FileWatcher_Watch_s {
+	GAE_HashString_t hash;
+	char path[1024];
+	int directory;					/* the platform's handle on the directory being watched */
+	GAE_FileWatcher_Callback_t callback;
+	void* userData;
+	float changedTime;				/* of the last change seen, on the watcher's clock */
+	GAE_BOOL isChanged;
+} GAE_FileWatcher_Watch_t;
+
+typedef struct GAE_FileWatcher_s {
+	struct GAE_Array_s* watches;
+	struct GAE_Clock_s* clock;
+	float debounceTime;				/* in seconds */
+	int descriptor;
+} GAE_FileWatcher_t;
+
+/* Creates a new watcher that calls back once a changed file has been left alone for debounceTime seconds. */
+GAE_FileWatcher_t* GAE_FileWatcher_create(const float debounceTime);
+
+/* Calls callback with userData whenever the file at path changes - the same path can be watched any number of times. */
+GAE_FileWatcher_t* GAE_FileWatcher_watch(GAE_FileWatcher_t* watcher, const char* const path, GAE_FileWatcher_Callback_t callback, void* userData, GAE_BOOL* status);
+
+/* Stops the watch on path made with this userData. */
+GAE_FileWatcher_t* GAE_FileWatcher_unwatch(GAE_FileWatcher_t* watcher, const char* const path, void* userData, GAE_BOOL* status);
+
+/* Picks up any changes since the last update, and calls back for those that have settled. */
+GAE_FileWatcher_t* GAE_FileWatcher_update(GAE_FileWatcher_t* watcher);
+
+/* Deletes the watcher and all its watches. */
+void GAE_FileWatcher_delete(GAE_FileWatcher_t* watcher);
+
+#endif
@@ -1,13 +1,36 @@
+/* mmap's anonymous mappings and madvise are outside plain POSIX */
+#define _DEFAULT_SOURCE
+#define _BSD_SOURCE
+
 #include "../File.h"
+#include "../Compressed.h"
+#include "../Pack.h"
+#include "../VFS.h"
 
+#include <errno.h>
+#include <fcntl.h>
 #include <string.h>
 #include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* where the size isn't known up front, read in buffers start here and double */
+#define GAE_FILE_READ_CHUNK 65536UL
+
+static GAE_BOOL isMapMode(const GAE_FILE_OPEN_MODE openMode);
+static void releaseBuffer(GAE_File_t* file);
+static GAE_BOOL mapBuffer(GAE_File_t* file, const unsigned long amount);
+static GAE_File_t* readDescriptor(GAE_File_t* file, const unsigned long amount, GAE_FILE_READ_STATUS* status);
+static GAE_BOOL openCompressed(GAE_File_t* file);
+static GAE_BOOL readAt(void* source, const unsigned long offset, GAE_BYTE* destination, const unsigned long amount);
 
 GAE_File_t* GAE_File_create(const char* filePath) {
 	GAE_File_t* file = malloc(sizeof(GAE_File_t));
 	GAE_PlatformFile_t* platform = malloc(sizeof(GAE_PlatformFile_t));
 
-	strncpy(file->filePath, filePath, sizeof(file->filePath));
+	strncpy(file->filePath, filePath, sizeof(file->filePath) - 1U);
+	file->filePath[sizeof(file->filePath) - 1U] = '\0';
 	file->buffer = 0;
 	file->readPosition = 0U;
 	file->bufferSize = 0U;
@@ -16,6 +39,12 @@ GAE_File_t* GAE_File_create(const char* filePath) {
 	file->openMode = GAE_FILE_OPEN_READ;
 	file->owned = GAE_FALSE;
 	platform->file = 0;
+	platform->entry = 0;
+	platform->descriptor = -1;
+	platform->isRegular = GAE_FALSE;
+	platform->mapping = 0;
+	platform->mappingSize = 0U;
+	platform->compressed = 0;
 	file->platformFile = (void*)platform;
 
 	return file;
@@ -23,11 +52,30 @@ GAE_File_t* GAE_File_create(const char* filePath) {
 
 void GAE_File_delete(GAE_File_t* file) {
 	GAE_PlatformFile_t* platform = (GAE_PlatformFile_t*)file->platformFile;
+	if (0 != platform->compressed) {
+		GAE_Compressed_delete(platform->compressed);
+		platform->compressed = 0;
+	}
+
 	if (0 != platform->file) {
 		fclose(platform->file);
 		platform->file = 0;
 	}
 
+	if (-1 != platform->descriptor) {
+		close(platform->descriptor);
+		platform->descriptor = -1;
+	}
+
+	if (0 != platform->entry) {
+		GAE_Pack_Entry_delete(platform->entry);
+		platform->entry = 0;
+	}
+
+	/* nobody else can unmap it */
+	if (0 != platform->mapping)
+		releaseBuffer(file);
+
 	free(platform);
 	free(file);
 	file = 0;
@@ -35,7 +83,10 @@ void GAE_File_delete(GAE_File_t* file) {
 
 GAE_File_t* GAE_File_open(GAE_File_t* file, const GAE_FILE_OPEN_MODE openMode, const GAE_FILE_MODE fileMode, GAE_FILE_STATUS* status) {
 	GAE_PlatformFile_t* platform = (GAE_PlatformFile_t*)file->platformFile;
-	char options[2];
+	char options[3] = { '\0', '\0', '\0' };
+	char diskPath[GAE_VFS_PATH_SIZE];
+	const char* path = file->filePath;
+	GAE_VFS_Status found = GAE_VFS_UNKNOWN;
 
 	if (file->fileStatus != GAE_FILE_CLOSED) {
 		if (0 != status)
@@ -43,7 +94,7 @@ GAE_File_t* GAE_File_open(GAE_File_t* file, const GAE_FILE_OPEN_MODE openMode, c
 		return file;
 	}
 	
-	if (0 != platform->file) {
+	if ((0 != platform->file) || (0 != platform->entry) || (-1 != platform->descriptor)) {
 		if (0 != status)
 			*status = GAE_FILE_ERROR;
 		return file;
@@ -54,6 +105,67 @@ GAE_File_t* GAE_File_open(GAE_File_t* file, const GAE_FILE_OPEN_MODE openMode, c
 			*status = GAE_FILE_ERROR;
 		return file;
 	}
+
+	/* reopened, it reads from the start again rather than wherever the last read left off */
+	file->readPosition = 0U;
+
+	if ((GAE_FILE_OPEN_READ == openMode) || (GAE_TRUE == isMapMode(openMode))) {
+		found = GAE_VFS_resolve(file->filePath, diskPath, sizeof(diskPath), &platform->entry);
+		if (GAE_VFS_MISSING == found) {
+			if (0 != status)
+				*status = GAE_FILE_NOT_FOUND;
+			return file;
+		}
+
+		if (0 != platform->entry) {
+			file->fileSize = platform->entry->size;
+			file->owned = GAE_TRUE;
+			file->fileStatus = GAE_FILE_OPEN;
+			file->openMode = openMode;
+
+			if (0 != status)
+				*status = file->fileStatus;
+			return file;
+		}
+
+		if (GAE_VFS_FOUND == found)
+			path = diskPath;
+	}
+	else
+		GAE_VFS_forget(file->filePath);
+
+	if (GAE_TRUE == isMapMode(openMode)) {
+		struct stat info;
+
+		platform->descriptor = open(path, O_RDONLY);
+		if (-1 == platform->descriptor) {
+			if ((GAE_VFS_UNKNOWN == found) && (ENOENT == errno))
+				GAE_VFS_markMissing(file->filePath);
+			if (0 != status)
+				*status = GAE_FILE_NOT_FOUND;
+			return file;
+		}
+
+		/* sizes of anything but regular files mean nothing - they're read until they run dry */
+		platform->isRegular = ((0 == fstat(platform->descriptor, &info)) && (S_ISREG(info.st_mode))) ? GAE_TRUE : GAE_FALSE;
+		file->fileSize = (GAE_TRUE == platform->isRegular) ? (unsigned long)info.st_size : 0U;
+		if (GAE_FALSE == openCompressed(file)) {
+			close(platform->descriptor);
+			platform->descriptor = -1;
+			file->fileSize = 0U;
+			if (0 != status)
+				*status = GAE_FILE_ERROR;
+			return file;
+		}
+
+		file->owned = GAE_TRUE;
+		file->fileStatus = GAE_FILE_OPEN;
+		file->openMode = openMode;
+
+		if (0 != status)
+			*status = file->fileStatus;
+		return file;
+	}
 	
 	switch (openMode) {
 		case GAE_FILE_OPEN_READ:
@@ -68,6 +180,9 @@ GAE_File_t* GAE_File_open(GAE_File_t* file, const GAE_FILE_OPEN_MODE openMode, c
 			options[0] = 'a';
 			file->owned = GAE_FALSE;
 			break;
+		case GAE_FILE_OPEN_MAP:
+		case GAE_FILE_OPEN_MAP_RANDOM:
+			break;
 	};
 	
 	switch (fileMode) {
@@ -79,9 +194,12 @@ GAE_File_t* GAE_File_open(GAE_File_t* file, const GAE_FILE_OPEN_MODE openMode, c
 			break;
 	};
 	
-	platform->file = fopen(file->filePath, options);
+	platform->file = fopen(path, options);
 	
 	if (0 == platform->file) {
+		/* so probing for it again doesn't need the disk */
+		if ((GAE_FILE_OPEN_READ == openMode) && (GAE_VFS_UNKNOWN == found) && (ENOENT == errno))
+			GAE_VFS_markMissing(file->filePath);
 		if (0 != status)
 			*status = GAE_FILE_NOT_FOUND;
 		return file;
@@ -93,6 +211,16 @@ GAE_File_t* GAE_File_open(GAE_File_t* file, const GAE_FILE_OPEN_MODE openMode, c
 	fseek(platform->file, 0, SEEK_END);
 	file->fileSize = ftell(platform->file);
 	rewind(platform->file);
+
+	if ((GAE_FILE_OPEN_READ == openMode) && (GAE_FALSE == openCompressed(file))) {
+		fclose(platform->file);
+		platform->file = 0;
+		file->fileSize = 0U;
+		file->fileStatus = GAE_FILE_CLOSED;
+		if (0 != status)
+			*status = GAE_FILE_ERROR;
+		return file;
+	}
 	
 	if (0 != status)
 		*status = file->fileStatus;
@@ -109,14 +237,30 @@ GAE_File_t* GAE_File_close(GAE_File_t* file, const GAE_FILE_CLOSE_MODE mode, GAE
 		return file;
 	}
 	
-	if (0 == platform->file) {
+	if ((0 == platform->file) && (0 == platform->entry) && (-1 == platform->descriptor)) {
 		if (0 != status)
 			*status = GAE_FILE_ERROR;
 		return file;
 	}
 	
-	fclose(platform->file);
-	platform->file = 0;
+	if (0 != platform->compressed) {
+		GAE_Compressed_delete(platform->compressed);
+		platform->compressed = 0;
+	}
+
+	/* a mapping outlives the descriptor it was made from, and a view the entry it came from */
+	if (0 != platform->file) {
+		fclose(platform->file);
+		platform->file = 0;
+	}
+	else if (0 != platform->entry) {
+		GAE_Pack_Entry_delete(platform->entry);
+		platform->entry = 0;
+	}
+	else {
+		close(platform->descriptor);
+		platform->descriptor = -1;
+	}
 	
 	file->fileStatus = GAE_FILE_CLOSED;
 	if (0 != status)
@@ -124,8 +268,7 @@ GAE_File_t* GAE_File_close(GAE_File_t* file, const GAE_FILE_CLOSE_MODE mode, GAE
 	
 	if (mode == GAE_FILE_CLOSE_DELETE_DATA) {
 		if (GAE_TRUE == file->owned) {
-			free(file->buffer);
-			file->buffer = 0;
+			releaseBuffer(file);
 			file->owned = GAE_FALSE;
 			file->bufferSize = 0U;
 		}
@@ -147,8 +290,7 @@ GAE_File_t* GAE_File_deleteBuffer(GAE_File_t* file, GAE_BOOL* status) {
 		return file;
 	}
 	
-	free(file->buffer);
-	file->buffer = 0;
+	releaseBuffer(file);
 
 	if (0 != status)
 		*status = GAE_TRUE;
@@ -161,7 +303,7 @@ GAE_File_t* GAE_File_read(GAE_File_t* file, const unsigned long amount, GAE_FILE
 	unsigned long readAmount = amount;
 	long read = 0;
 
-	if (file->openMode != GAE_FILE_OPEN_READ) {
+	if ((file->openMode != GAE_FILE_OPEN_READ) && (GAE_FALSE == isMapMode(file->openMode))) {
 		if (0 != status)
 			*status = GAE_FILE_READ_ERROR;
 		return file;
@@ -173,17 +315,44 @@ GAE_File_t* GAE_File_read(GAE_File_t* file, const unsigned long amount, GAE_FILE
 		return file;
 	}
 	
-	if (0 == platform->file) {
+	if ((0 == platform->file) && (0 == platform->entry) && (-1 == platform->descriptor)) {
 		if (0 != status)
 			*status = GAE_FILE_READ_ERROR;
 		return file;
 	}
+
+	/* views into the pack aren't the file's to free, but are its to replace */
+	if (0 != platform->entry) {
+		if (GAE_TRUE == file->owned)
+			releaseBuffer(file);
+		file->buffer = 0;
+		return GAE_Pack_Entry_read(platform->entry, file, amount, status);
+	}
 	
 	if (GAE_FALSE == file->owned) {
 		if (0 != status)
 			*status = GAE_FILE_READ_ERROR;
 		return file;
 	}
+
+	if (0 != platform->compressed) {
+		releaseBuffer(file);
+		return GAE_Compressed_read(platform->compressed, file, amount, status);
+	}
+
+	if (GAE_TRUE == isMapMode(file->openMode)) {
+		releaseBuffer(file);
+		if ((GAE_TRUE == platform->isRegular) && (file->readPosition < file->fileSize) && (GAE_TRUE == mapBuffer(file, amount))) {
+			file->readPosition += file->bufferSize;
+			/* as the copying read - a chunk that runs short is the end, but asking for the whole file isn't */
+			if (0 != status)
+				*status = ((amount < file->fileSize) && (file->bufferSize < amount)) ? GAE_FILE_READ_EOF : GAE_FILE_READ_OK;
+			return file;
+		}
+
+		/* pipes, empty looking files such as those under /proc, and anything the mapping failed on */
+		return readDescriptor(file, amount, status);
+	}
 	
 	if (readAmount < file->fileSize)
 		file->bufferSize = readAmount;
@@ -192,11 +361,9 @@ GAE_File_t* GAE_File_read(GAE_File_t* file, const unsigned long amount, GAE_FILE
 		readAmount = file->fileSize;
 	}
 	
-	if (0 != file->buffer)
-		free(file->buffer);
+	releaseBuffer(file);
 	
 	file->buffer = malloc(file->bufferSize + 1U);
-	memset(file->buffer, '\0', file->bufferSize);
 	if (0 == file->buffer) {
 		if (0 != status)
 			*status = GAE_FILE_READ_ERROR;
@@ -206,6 +373,8 @@ GAE_File_t* GAE_File_read(GAE_File_t* file, const unsigned long amount, GAE_FILE
 	file->owned = GAE_TRUE;
 	read = fread(file->buffer, 1, file->bufferSize, platform->file);
 	file->readPosition += (unsigned long)read;
+	/* terminated for text, and zeroed past a short read rather than left as whatever malloc gave */
+	memset(file->buffer + read, '\0', file->bufferSize + 1U - (unsigned long)read);
 	
 	if ((unsigned long)(read) == readAmount) {
 		if (0 != status)
@@ -224,6 +393,82 @@ GAE_File_t* GAE_File_read(GAE_File_t* file, const unsigned long amount, GAE_FILE
 	}
 }
 
+GAE_File_t* GAE_File_readInto(GAE_File_t* file, GAE_BYTE* destination, const unsigned long amount, unsigned long* readAmount, GAE_FILE_READ_STATUS* status) {
+	GAE_PlatformFile_t* platform = (GAE_PlatformFile_t*)file->platformFile;
+	unsigned long used = 0U;
+	GAE_BOOL isEOF = GAE_FALSE;
+	GAE_BOOL isError = GAE_FALSE;
+
+	if (0 != readAmount)
+		*readAmount = 0U;
+
+	if ((file->openMode != GAE_FILE_OPEN_READ) && (GAE_FALSE == isMapMode(file->openMode))) {
+		if (0 != status)
+			*status = GAE_FILE_READ_ERROR;
+		return file;
+	}
+
+	if (file->fileStatus != GAE_FILE_OPEN) {
+		if (0 != status)
+			*status = GAE_FILE_READ_ERROR;
+		return file;
+	}
+
+	if ((0 == platform->file) && (0 == platform->entry) && (-1 == platform->descriptor)) {
+		if (0 != status)
+			*status = GAE_FILE_READ_ERROR;
+		return file;
+	}
+
+	if (0 != platform->entry)
+		return GAE_Pack_Entry_readInto(platform->entry, file, destination, amount, readAmount, status);
+
+	if (0 != platform->compressed)
+		return GAE_Compressed_readInto(platform->compressed, file, destination, amount, readAmount, status);
+
+	if (0 != platform->file) {
+		used = (unsigned long)fread(destination, 1, amount, platform->file);
+		isEOF = (0 != feof(platform->file)) ? GAE_TRUE : GAE_FALSE;
+		isError = ((used < amount) && (GAE_FALSE == isEOF)) ? GAE_TRUE : GAE_FALSE;
+	}
+	else {
+		/* nothing is mapped - the data already has somewhere to go */
+		const GAE_BOOL isSized = ((GAE_TRUE == platform->isRegular) && (0U != file->fileSize)) ? GAE_TRUE : GAE_FALSE;
+
+		if (GAE_TRUE == isSized)
+			lseek(platform->descriptor, (off_t)file->readPosition, SEEK_SET);
+
+		while (used < amount) {
+			const long got = (long)read(platform->descriptor, destination + used, amount - used);
+			if (0 < got)
+				used += (unsigned long)got;
+			else if (0 == got) {
+				isEOF = GAE_TRUE;
+				break;
+			}
+			else if (EINTR != errno) {
+				isError = GAE_TRUE;
+				break;
+			}
+		}
+
+		if (GAE_FALSE == isSized)
+			file->fileSize = file->readPosition + used;
+	}
+
+	file->readPosition += used;
+	if (0 != readAmount)
+		*readAmount = used;
+
+	if (0 != status) {
+		if (GAE_TRUE == isError)
+			*status = GAE_FILE_READ_ERROR;
+		else
+			*status = (used < amount) ? GAE_FILE_READ_EOF : GAE_FILE_READ_OK;
+	}
+	return file;
+}
+
 GAE_File_t* GAE_File_write(GAE_File_t* file, GAE_FILE_WRITE_STATUS* status) {
 	GAE_PlatformFile_t* platform = (GAE_PlatformFile_t*)file->platformFile;
 	long written = 0;
@@ -265,7 +510,7 @@ GAE_File_t* GAE_File_write(GAE_File_t* file, GAE_FILE_WRITE_STATUS* status) {
 	}
 }
 
-GAE_File_t* GAE_FILE_setReadPosition(GAE_File_t* file, const unsigned long readPosition, GAE_FILE_READ_STATUS* status) {
+GAE_File_t* GAE_File_setReadPosition(GAE_File_t* file, const unsigned long readPosition, GAE_FILE_READ_STATUS* status) {
 	GAE_PlatformFile_t* platform = (GAE_PlatformFile_t*)file->platformFile;
 
 	if (file->fileStatus != GAE_FILE_OPEN) {
@@ -274,11 +519,25 @@ GAE_File_t* GAE_FILE_setReadPosition(GAE_File_t* file, const unsigned long readP
 		return file;
 	}
 	
-	if (file->openMode != GAE_FILE_OPEN_READ) {
+	if ((file->openMode != GAE_FILE_OPEN_READ) && (GAE_FALSE == isMapMode(file->openMode))) {
 		if (0 != status)
 			*status = GAE_FILE_READ_ERROR;
 		return file;
 	}
+
+	if ((0 != platform->entry) || (0 != platform->compressed) || (GAE_TRUE == isMapMode(file->openMode))) {
+		/* packs, decompressing, mapping and reading in all start from readPosition, so there's nothing else to move - but pipes only go forwards */
+		if ((0 == platform->entry) && (0 == platform->compressed) && (GAE_FALSE == platform->isRegular)) {
+			if (0 != status)
+				*status = GAE_FILE_READ_ERROR;
+			return file;
+		}
+
+		file->readPosition = (readPosition < file->fileSize) ? readPosition : file->fileSize;
+		if (0 != status)
+			*status = (readPosition < file->fileSize) ? GAE_FILE_READ_OK : GAE_FILE_READ_EOF;
+		return file;
+	}
 	
 	if (0 == platform->file) {
 		if (0 != status)
@@ -286,7 +545,7 @@ GAE_File_t* GAE_FILE_setReadPosition(GAE_File_t* file, const unsigned long readP
 		return file;
 	}
 	
-	if (file->readPosition < file->fileSize) {
+	if (readPosition < file->fileSize) {
 		file->readPosition = readPosition;
 		fseek(platform->file, file->readPosition, SEEK_SET);
 		if (0 != status)
@@ -310,7 +569,7 @@ GAE_File_t* GAE_File_setBuffer(GAE_File_t* file, unsigned char* buffer, const un
 	}
 	
 	if (file->owned == GAE_TRUE)
-		free(file->buffer);
+		releaseBuffer(file);
 	
 	switch(type) {
 		case GAE_FILE_BUFFER_COPY: {
@@ -347,7 +606,7 @@ GAE_File_t* GAE_File_setBuffer(GAE_File_t* file, unsigned char* buffer, const un
 	return file;
 }
 
-GAE_File_t* GAE_FILE_newBuffer(GAE_File_t* file, const unsigned long size, GAE_BOOL* status) {
+GAE_File_t* GAE_File_newBuffer(GAE_File_t* file, const unsigned long size, GAE_BOOL* status) {
 	if (file->fileStatus == GAE_FILE_OPEN) {
 		if (0 != status)
 			*status = GAE_FALSE;
@@ -355,7 +614,7 @@ GAE_File_t* GAE_FILE_newBuffer(GAE_File_t* file, const unsigned long size, GAE_B
 	}
 	
 	if (file->owned == GAE_TRUE)
-		free(file->buffer);
+		releaseBuffer(file);
 	
 	file->buffer = malloc(size);
 	file->owned = GAE_TRUE;
@@ -366,3 +625,167 @@ GAE_File_t* GAE_FILE_newBuffer(GAE_File_t* file, const unsigned long size, GAE_B
 		*status = GAE_TRUE;
 	return file;
 }
+
+GAE_BOOL isMapMode(const GAE_FILE_OPEN_MODE openMode) {
+	return ((GAE_FILE_OPEN_MAP == openMode) || (GAE_FILE_OPEN_MAP_RANDOM == openMode)) ? GAE_TRUE : GAE_FALSE;
+}
+
+void releaseBuffer(GAE_File_t* file) {
+	GAE_PlatformFile_t* platform = (GAE_PlatformFile_t*)file->platformFile;
+
+	if (0 != platform->mapping) {
+		munmap(platform->mapping, platform->mappingSize);
+		platform->mapping = 0;
+		platform->mappingSize = 0U;
+	}
+	else
+		free(file->buffer);
+	file->buffer = 0;
+}
+
+GAE_BOOL mapBuffer(GAE_File_t* file, const unsigned long amount) {
+	GAE_PlatformFile_t* platform = (GAE_PlatformFile_t*)file->platformFile;
+	const unsigned long page = (unsigned long)sysconf(_SC_PAGESIZE);
+	const unsigned long remaining = file->fileSize - file->readPosition;
+	const unsigned long size = (amount < remaining) ? amount : remaining;
+	const unsigned long start = file->readPosition - (file->readPosition % page);
+	const unsigned long length = file->readPosition + size - start;
+	/* a spare zeroed page past the end keeps the terminator read in buffers have, when the data runs to the end of the file -
+	   the kernel zeroes the rest of a file's last page, but a file that fills its last page exactly leaves nothing after it */
+	const unsigned long reserved = ((length / page) + 1U) * page;
+	void* reservation = mmap(0, reserved, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	void* mapping = MAP_FAILED;
+
+	if (MAP_FAILED == reservation)
+		return GAE_FALSE;
+
+	mapping = mmap(reservation, length, PROT_READ, MAP_PRIVATE | MAP_FIXED, platform->descriptor, (off_t)start);
+	if (MAP_FAILED == mapping) {
+		munmap(reservation, reserved);
+		return GAE_FALSE;
+	}
+
+	if (GAE_FILE_OPEN_MAP_RANDOM == file->openMode)
+		madvise(mapping, length, MADV_RANDOM);
+	else {
+		/* read ahead aggressively, and drop pages behind the reader first */
+		madvise(mapping, length, MADV_SEQUENTIAL);
+		madvise(mapping, length, MADV_WILLNEED);
+	}
+
+	platform->mapping = mapping;
+	platform->mappingSize = reserved;
+	file->buffer = (GAE_BYTE*)mapping + (file->readPosition - start);
+	file->bufferSize = size;
+	file->owned = GAE_TRUE;
+	return GAE_TRUE;
+}
+
+GAE_File_t* readDescriptor(GAE_File_t* file, const unsigned long amount, GAE_FILE_READ_STATUS* status) {
+	GAE_PlatformFile_t* platform = (GAE_PlatformFile_t*)file->platformFile;
+	const GAE_BOOL isSized = ((GAE_TRUE == platform->isRegular) && (0U != file->fileSize)) ? GAE_TRUE : GAE_FALSE;
+	unsigned long wanted = amount;
+	unsigned long capacity = 0U;
+	unsigned long used = 0U;
+	GAE_BOOL isEOF = GAE_FALSE;
+	GAE_BYTE* buffer = 0;
+
+	if (GAE_TRUE == isSized) {
+		wanted = (file->readPosition < file->fileSize) ? file->fileSize - file->readPosition : 0U;
+		if (amount < wanted)
+			wanted = amount;
+		lseek(platform->descriptor, (off_t)file->readPosition, SEEK_SET);
+	}
+
+	capacity = ((GAE_TRUE == isSized) || (wanted < GAE_FILE_READ_CHUNK)) ? wanted : GAE_FILE_READ_CHUNK;
+	buffer = malloc(capacity + 1U);
+	while ((0 != buffer) && (used < wanted)) {
+		long got = 0;
+
+		if (used == capacity) {
+			GAE_BYTE* grown = 0;
+			capacity = (capacity > wanted / 2U) ? wanted : capacity * 2U;
+			grown = realloc(buffer, capacity + 1U);
+			if (0 == grown) {
+				free(buffer);
+				buffer = 0;
+				break;
+			}
+			buffer = grown;
+		}
+
+		got = (long)read(platform->descriptor, buffer + used, capacity - used);
+		if (0 < got)
+			used += (unsigned long)got;
+		else if (0 == got) {
+			isEOF = GAE_TRUE;
+			break;
+		}
+		else if (EINTR != errno) {
+			free(buffer);
+			buffer = 0;
+		}
+	}
+
+	if (0 == buffer) {
+		if (0 != status)
+			*status = GAE_FILE_READ_ERROR;
+		return file;
+	}
+
+	buffer[used] = '\0';
+	file->buffer = buffer;
+	file->bufferSize = used;
+	file->owned = GAE_TRUE;
+	file->readPosition += used;
+	if (GAE_FALSE == isSized)
+		file->fileSize = file->readPosition;
+
+	if (0 != status)
+		*status = ((GAE_TRUE == isEOF) || (0U == wanted)) ? GAE_FILE_READ_EOF : GAE_FILE_READ_OK;
+	return file;
+}
+
+GAE_BOOL openCompressed(GAE_File_t* file) {
+	GAE_PlatformFile_t* platform = (GAE_PlatformFile_t*)file->platformFile;
+	GAE_BYTE header[GAE_COMPRESSED_HEADER_SIZE];
+	GAE_BOOL isCompressed = GAE_FALSE;
+
+	/* only ever looked for in sized files, as peeking at a pipe would eat what it peeked at */
+	if (GAE_COMPRESSED_HEADER_SIZE <= file->fileSize)
+		isCompressed = ((GAE_TRUE == readAt(platform, 0U, header, sizeof(header))) && (GAE_TRUE == GAE_Compressed_isHeader(header, sizeof(header)))) ? GAE_TRUE : GAE_FALSE;
+
+	if (GAE_FALSE == isCompressed) {
+		if (0 != platform->file)
+			rewind(platform->file);
+		return GAE_TRUE;
+	}
+
+	platform->compressed = GAE_Compressed_create(readAt, platform, file->fileSize);
+	if (0 == platform->compressed)
+		return GAE_FALSE;
+
+	file->fileSize = platform->compressed->size;
+	return GAE_TRUE;
+}
+
+GAE_BOOL readAt(void* source, const unsigned long offset, GAE_BYTE* destination, const unsigned long amount) {
+	GAE_PlatformFile_t* platform = (GAE_PlatformFile_t*)source;
+	unsigned long used = 0U;
+
+	if (0 != platform->file) {
+		if (0 != fseek(platform->file, (long)offset, SEEK_SET))
+			return GAE_FALSE;
+		return (amount == (unsigned long)fread(destination, 1U, amount, platform->file)) ? GAE_TRUE : GAE_FALSE;
+	}
+
+	while (used < amount) {
+		const long got = (long)pread(platform->descriptor, destination + used, amount - used, (off_t)(offset + used));
+		if (0 < got)
+			used += (unsigned long)got;
+		else if ((0 == got) || (EINTR != errno))
+			return GAE_FALSE;
+	}
+
+	return GAE_TRUE;
+}
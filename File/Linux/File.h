@@ -3,8 +3,17 @@
 
 #include <stdio.h>
 
+struct GAE_Compressed_s;
+struct GAE_Pack_Entry_s;
+
 typedef struct GAE_PlatformFile_s {
 	FILE* file;
+	struct GAE_Pack_Entry_s* entry;	/* in place of file when found in a mounted pack */
+	int descriptor;					/* in place of file when opened to map */
+	GAE_BOOL isRegular;				/* pipes and the like can't be mapped, and are read in instead */
+	void* mapping;					/* buffer points into this while it's mapped */
+	unsigned long mappingSize;
+	struct GAE_Compressed_s* compressed;	/* read through in place of file or descriptor when the data on disk is compressed */
 } GAE_PlatformFile_t;
 
 static const unsigned int GAE_FILE_READ_ALL = (unsigned int)-1;
@@ -15,6 +24,7 @@ GAE_File_t* GAE_File_open(GAE_File_t* file, const GAE_FILE_OPEN_MODE openMode, c
 GAE_File_t* GAE_File_close(GAE_File_t* file, const GAE_FILE_CLOSE_MODE closeMode, GAE_FILE_STATUS* status);
 GAE_File_t* GAE_File_deleteBuffer(GAE_File_t* file, GAE_BOOL* success);
 GAE_File_t* GAE_File_read(GAE_File_t* file, const unsigned long amount, GAE_FILE_READ_STATUS* status);
+GAE_File_t* GAE_File_readInto(GAE_File_t* file, GAE_BYTE* destination, const unsigned long amount, unsigned long* readAmount, GAE_FILE_READ_STATUS* status);
 GAE_File_t* GAE_File_write(GAE_File_t* file, GAE_FILE_WRITE_STATUS* status);
 GAE_File_t* GAE_File_setReadPosition(GAE_File_t* file, const unsigned long position, GAE_FILE_READ_STATUS* status);
 GAE_File_t* GAE_File_setBuffer(GAE_File_t* file, GAE_BYTE* buffer, const unsigned long size, const GAE_FILE_BUFFER_TYPE type, GAE_BOOL* success);
@@ -0,0 +1,265 @@
+#include "Pack.h"
+#include "VFS.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../Utils/HashString.h"
+#include "../Utils/LZ4.h"
+
+static unsigned int readUint32(const GAE_BYTE* data);
+static GAE_BOOL validate(GAE_Pack_t* pack);
+static GAE_BYTE* unpackWhole(GAE_Pack_Entry_t* entry);
+
+GAE_Pack_t* GAE_Pack_create(const char* const filePath) {
+	GAE_Pack_t* pack = malloc(sizeof(GAE_Pack_t));
+	GAE_FILE_STATUS fileStatus = GAE_FILE_ERROR;
+	GAE_FILE_READ_STATUS readStatus = GAE_FILE_READ_ERROR;
+
+	pack->file = GAE_File_create(filePath);
+	pack->data = 0;
+	pack->size = 0U;
+	pack->entryCount = 0U;
+
+	/* a pack is mostly read through in one go as its level loads, so it's mapped to read ahead -
+	   hinted random, each file faulted in on its own and a cold load ran slower than loose files */
+	GAE_File_open(pack->file, GAE_FILE_OPEN_MAP, GAE_FILE_BINARY, &fileStatus);
+	if (GAE_FILE_OPEN == fileStatus)
+		GAE_File_read(pack->file, GAE_FILE_READ_ALL, &readStatus);
+	GAE_File_close(pack->file, GAE_FILE_CLOSE_RETAIN_DATA, 0);
+
+	pack->data = pack->file->buffer;
+	pack->size = pack->file->bufferSize;
+	if ((GAE_FILE_READ_ERROR == readStatus) || (GAE_FALSE == validate(pack))) {
+		GAE_Pack_delete(pack);
+		return 0;
+	}
+
+	return pack;
+}
+
+GAE_HashString_t GAE_Pack_hashPath(const char* const path) {
+	char normalised[1024];
+	const char* source = path;
+	unsigned int index = 0U;
+
+	while (('.' == source[0]) && (('/' == source[1]) || ('\\' == source[1])))
+		source += 2;
+
+	for (index = 0U; (index + 1U < sizeof(normalised)) && ('\0' != source[index]); ++index)
+		normalised[index] = ('\\' == source[index]) ? '/' : source[index];
+	normalised[index] = '\0';
+
+	return GAE_HashString_create(normalised);
+}
+
+GAE_BOOL GAE_Pack_find(GAE_Pack_t* const pack, const char* const path, GAE_Pack_Entry_t* entry) {
+	const GAE_HashString_t hash = GAE_Pack_hashPath(path);
+	const GAE_BYTE* directory = pack->data + GAE_PACK_HEADER_SIZE;
+	unsigned int low = 0U;
+	unsigned int high = pack->entryCount;
+
+	while (low < high) {
+		const unsigned int middle = low + (high - low) / 2U;
+		const GAE_BYTE* current = directory + middle * GAE_PACK_ENTRY_SIZE;
+		const GAE_HashString_t currentHash = readUint32(current);
+
+		if (currentHash < hash)
+			low = middle + 1U;
+		else if (currentHash > hash)
+			high = middle;
+		else {
+			entry->pack = pack;
+			entry->flags = readUint32(current + 4U);
+			entry->size = readUint32(current + 8U);
+			entry->storedSize = readUint32(current + 12U);
+			entry->data = pack->data + readUint32(current + 16U);
+			entry->unpacked = 0;
+			return GAE_TRUE;
+		}
+	}
+
+	return GAE_FALSE;
+}
+
+GAE_HashString_t GAE_Pack_getHash(GAE_Pack_t* const pack, const unsigned int index) {
+	return readUint32(pack->data + GAE_PACK_HEADER_SIZE + index * GAE_PACK_ENTRY_SIZE);
+}
+
+GAE_Pack_t* GAE_Pack_mount(GAE_Pack_t* pack, GAE_BOOL* status) {
+	GAE_VFS_mountPack(pack, 0);
+	if (0 != status)
+		*status = GAE_TRUE;
+	return pack;
+}
+
+GAE_Pack_t* GAE_Pack_unmount(GAE_Pack_t* pack, GAE_BOOL* status) {
+	GAE_VFS_Mount_t* mount = GAE_VFS_findPack(pack);
+
+	if (0 != mount)
+		GAE_VFS_unmount(mount);
+	if (0 != status)
+		*status = (0 != mount) ? GAE_TRUE : GAE_FALSE;
+	return pack;
+}
+
+void GAE_Pack_delete(GAE_Pack_t* pack) {
+	GAE_Pack_unmount(pack, 0);
+
+	GAE_File_deleteBuffer(pack->file, 0);
+	GAE_File_delete(pack->file);
+	free(pack);
+	pack = 0;
+}
+
+GAE_BOOL GAE_Pack_Entry_unpack(GAE_Pack_Entry_t* const entry, GAE_BYTE* destination) {
+	if (0U == (entry->flags & GAE_PACK_FLAG_LZ4)) {
+		memcpy(destination, entry->data, entry->size);
+		return GAE_TRUE;
+	}
+
+	return GAE_LZ4_decompress(entry->data, entry->storedSize, destination, entry->size);
+}
+
+GAE_File_t* GAE_Pack_Entry_read(GAE_Pack_Entry_t* entry, GAE_File_t* file, const unsigned long amount, GAE_FILE_READ_STATUS* status) {
+	const unsigned long remaining = (file->readPosition < entry->size) ? entry->size - file->readPosition : 0U;
+	const unsigned long size = (amount < remaining) ? amount : remaining;
+	const GAE_BOOL isCompressed = (0U != (entry->flags & GAE_PACK_FLAG_LZ4)) ? GAE_TRUE : GAE_FALSE;
+	const GAE_BOOL isMapped = ((GAE_FILE_OPEN_MAP == file->openMode) || (GAE_FILE_OPEN_MAP_RANDOM == file->openMode)) ? GAE_TRUE : GAE_FALSE;
+	const GAE_BYTE* source = entry->data;
+
+	if ((GAE_TRUE == isCompressed) && (0U != size)) {
+		/* read whole in one go, it goes straight into the file's buffer - in chunks, it's unpacked once and copied out of */
+		GAE_BYTE* unpacked = unpackWhole(entry);
+		if (0 == unpacked) {
+			if (0 != status)
+				*status = GAE_FILE_READ_ERROR;
+			return file;
+		}
+
+		if ((0U == file->readPosition) && (size == remaining)) {
+			entry->unpacked = 0;
+			file->buffer = unpacked;
+			file->owned = GAE_TRUE;
+		}
+		else {
+			entry->unpacked = unpacked;
+			source = unpacked;
+		}
+	}
+	else if ((GAE_FALSE == isCompressed) && ((size == remaining) || (GAE_TRUE == isMapped))) {
+		/* the zero byte after each file keeps it terminated - only mapped reads may stop short of it */
+		file->buffer = (GAE_BYTE*)(entry->data + file->readPosition);
+		file->owned = GAE_FALSE;
+	}
+
+	if (0 == file->buffer) {
+		file->buffer = malloc(size + 1U);
+		if (0 == file->buffer) {
+			if (0 != status)
+				*status = GAE_FILE_READ_ERROR;
+			return file;
+		}
+		memcpy(file->buffer, source + file->readPosition, size);
+		file->buffer[size] = '\0';
+		file->owned = GAE_TRUE;
+	}
+
+	file->bufferSize = size;
+	file->readPosition += size;
+
+	/* as the disk reads - a chunk that runs short is the end, but asking for the whole file isn't */
+	if (0 != status)
+		*status = ((amount < entry->size) && (size < amount)) ? GAE_FILE_READ_EOF : GAE_FILE_READ_OK;
+	return file;
+}
+
+GAE_File_t* GAE_Pack_Entry_readInto(GAE_Pack_Entry_t* entry, GAE_File_t* file, GAE_BYTE* destination, const unsigned long amount, unsigned long* readAmount, GAE_FILE_READ_STATUS* status) {
+	const unsigned long remaining = (file->readPosition < entry->size) ? entry->size - file->readPosition : 0U;
+	const unsigned long size = (amount < remaining) ? amount : remaining;
+	const GAE_BYTE* source = entry->data;
+
+	if (0 != readAmount)
+		*readAmount = 0U;
+
+	/* a block can only be unpacked whole, so it's kept for the reads after */
+	if ((0U != (entry->flags & GAE_PACK_FLAG_LZ4)) && (0U != size)) {
+		entry->unpacked = unpackWhole(entry);
+		if (0 == entry->unpacked) {
+			if (0 != status)
+				*status = GAE_FILE_READ_ERROR;
+			return file;
+		}
+		source = entry->unpacked;
+	}
+
+	memcpy(destination, source + file->readPosition, size);
+	file->readPosition += size;
+
+	if (0 != readAmount)
+		*readAmount = size;
+	if (0 != status)
+		*status = (size < amount) ? GAE_FILE_READ_EOF : GAE_FILE_READ_OK;
+	return file;
+}
+
+void GAE_Pack_Entry_delete(GAE_Pack_Entry_t* entry) {
+	free(entry->unpacked);
+	free(entry);
+	entry = 0;
+}
+
+unsigned int readUint32(const GAE_BYTE* data) {
+	return (unsigned int)data[0] | ((unsigned int)data[1] << 8U) | ((unsigned int)data[2] << 16U) | ((unsigned int)data[3] << 24U);
+}
+
+GAE_BOOL validate(GAE_Pack_t* pack) {
+	const GAE_BYTE* directory = pack->data + GAE_PACK_HEADER_SIZE;
+	unsigned int index = 0U;
+
+	if ((0 == pack->data) || (GAE_PACK_HEADER_SIZE > pack->size) || (0 != memcmp(pack->data, "GPAK", 4U)))
+		return GAE_FALSE;
+
+	if (GAE_PACK_VERSION != readUint32(pack->data + 4U))
+		return GAE_FALSE;
+
+	pack->entryCount = readUint32(pack->data + 8U);
+	if ((unsigned long)pack->entryCount > (pack->size - GAE_PACK_HEADER_SIZE) / GAE_PACK_ENTRY_SIZE)
+		return GAE_FALSE;
+
+	/* checked once here, so reads never need to */
+	for (index = 0U; index < pack->entryCount; ++index) {
+		const GAE_BYTE* entry = directory + index * GAE_PACK_ENTRY_SIZE;
+		const unsigned int flags = readUint32(entry + 4U);
+		const unsigned long size = readUint32(entry + 8U);
+		const unsigned long storedSize = readUint32(entry + 12U);
+		const unsigned long offset = readUint32(entry + 16U);
+
+		if ((0U < index) && (readUint32(entry - GAE_PACK_ENTRY_SIZE) >= readUint32(entry)))
+			return GAE_FALSE;
+
+		if ((0U != (flags & ~(unsigned int)GAE_PACK_FLAG_LZ4)) || ((0U == (flags & GAE_PACK_FLAG_LZ4)) && (size != storedSize)))
+			return GAE_FALSE;
+
+		if ((offset >= pack->size) || (storedSize >= pack->size - offset) || ('\0' != pack->data[offset + storedSize]))
+			return GAE_FALSE;
+	}
+
+	return GAE_TRUE;
+}
+
+GAE_BYTE* unpackWhole(GAE_Pack_Entry_t* entry) {
+	GAE_BYTE* unpacked = entry->unpacked;
+
+	if (0 != unpacked)
+		return unpacked;
+
+	unpacked = malloc(entry->size + 1U);
+	if ((0 == unpacked) || (GAE_FALSE == GAE_Pack_Entry_unpack(entry, unpacked))) {
+		free(unpacked);
+		return 0;
+	}
+
+	unpacked[entry->size] = '\0';
+	return unpacked;
+}
@@ -0,0 +1,80 @@
+#ifndef _PACK_H_
+#define _PACK_H_
+
+#include "File.h"
+
+/*
+	Packed asset archives - many files in one, found by the hash of their path, so a level loads with one open rather than thousands.
+	All values little endian:
+	 0 - "GPAK"             8 - entry count
+	 4 - version           12 - reserved
+	followed by the directory, an entry per file sorted by path hash:
+	 0 - path hash          8 - size              16 - offset
+	 4 - flags             12 - stored size       20 - reserved
+	Each file's data starts on a GAE_PACK_ALIGNMENT boundary and is followed by at least one zero byte,
+	so an uncompressed file read whole straight out of the pack is terminated as any read buffer is.
+	Only hashes are kept, so a path that isn't packed but hashes the same as one that is will find it - the packer refuses collisions between its own files.
+
+	Packs are mounted in the VFS - GAE_Pack_mount mounts at priority 0, where the newest pack wins.
+	Mounting and unmounting isn't thread safe - do it before other threads open files.
+*/
+
+#define GAE_PACK_VERSION 1U
+#define GAE_PACK_HEADER_SIZE 16U
+#define GAE_PACK_ENTRY_SIZE 24U
+#define GAE_PACK_ALIGNMENT 16U
+
+typedef enum GAE_Pack_Flags_e {
+	GAE_PACK_FLAG_LZ4 = 1			/* stored as a single LZ4 block */
+} GAE_Pack_Flags;
+
+typedef struct GAE_Pack_s {
+	GAE_File_t* file;			/* holds the whole pack - mapped where the platform can */
+	const GAE_BYTE* data;
+	unsigned long size;
+	unsigned int entryCount;
+} GAE_Pack_t;
+
+typedef struct GAE_Pack_Entry_s {
+	GAE_Pack_t* pack;				/* 0 for a blob mounted in the VFS */
+	const GAE_BYTE* data;			/* as stored, in the pack */
+	unsigned long size;
+	unsigned long storedSize;
+	unsigned int flags;
+	GAE_BYTE* unpacked;				/* the whole file once a compressed entry has been read in chunks */
+} GAE_Pack_Entry_t;
+
+/* Opens the pack at filePath, returning 0 if it can't be read or isn't a valid pack. */
+GAE_Pack_t* GAE_Pack_create(const char* const filePath);
+
+/* Returns the hash a path is packed under - leading "./" is skipped and backslashes count as slashes. */
+GAE_HashString_t GAE_Pack_hashPath(const char* const path);
+
+/* Looks path up in the pack, filling entry if it's there. */
+GAE_BOOL GAE_Pack_find(GAE_Pack_t* const pack, const char* const path, GAE_Pack_Entry_t* entry);
+
+/* Returns the path hash of the entry at index in the directory. */
+GAE_HashString_t GAE_Pack_getHash(GAE_Pack_t* const pack, const unsigned int index);
+
+/* Mounts the pack in the VFS at priority 0, ahead of any mounted there before it. */
+GAE_Pack_t* GAE_Pack_mount(GAE_Pack_t* pack, GAE_BOOL* status);
+
+/* Unmounts the pack from the VFS - files already open from it carry on working until the pack is deleted. */
+GAE_Pack_t* GAE_Pack_unmount(GAE_Pack_t* pack, GAE_BOOL* status);
+
+/* Unmounts the pack if need be and deletes it - buffers viewing it, from any file, go with it. */
+void GAE_Pack_delete(GAE_Pack_t* pack);
+
+/* Decompresses the whole entry into destination, which must hold entry->size bytes. */
+GAE_BOOL GAE_Pack_Entry_unpack(GAE_Pack_Entry_t* const entry, GAE_BYTE* destination);
+
+/* Reads for GAE_File_read, once the file's own buffer is out of the way - uncompressed data read to the end, or mapped, is a view into the pack rather than a copy, and isn't owned by the file. */
+GAE_File_t* GAE_Pack_Entry_read(GAE_Pack_Entry_t* entry, GAE_File_t* file, const unsigned long amount, GAE_FILE_READ_STATUS* status);
+
+/* Reads for GAE_File_readInto, copying up to amount bytes from the read position into destination. */
+GAE_File_t* GAE_Pack_Entry_readInto(GAE_Pack_Entry_t* entry, GAE_File_t* file, GAE_BYTE* destination, const unsigned long amount, unsigned long* readAmount, GAE_FILE_READ_STATUS* status);
+
+/* Deletes the entry, and anything it unpacked. */
+void GAE_Pack_Entry_delete(GAE_Pack_Entry_t* entry);
+
+#endif
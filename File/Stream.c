@@ -0,0 +1,235 @@
+#include "Stream.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../Threads/Thread.h"
+
+static void readAheadMain(void* userData);
+static unsigned long getSpace(GAE_Stream_t* stream, unsigned long* offset);
+
+GAE_Stream_t* GAE_Stream_create(const char* const filePath, GAE_BYTE* buffer, const unsigned long capacity, const GAE_BOOL isReadAhead) {
+	GAE_Stream_t* stream = 0;
+	GAE_File_t* file = 0;
+	GAE_FILE_STATUS fileStatus = GAE_FILE_ERROR;
+
+	if (0U == capacity)
+		return 0;
+
+	file = GAE_File_create(filePath);
+	GAE_File_open(file, GAE_FILE_OPEN_READ, GAE_FILE_BINARY, &fileStatus);
+	if (GAE_FILE_OPEN != fileStatus) {
+		GAE_File_delete(file);
+		return 0;
+	}
+
+	stream = malloc(sizeof(GAE_Stream_t));
+	stream->file = file;
+	stream->buffer = (0 != buffer) ? buffer : malloc(capacity);
+	stream->capacity = capacity;
+	stream->start = 0U;
+	stream->count = 0U;
+	stream->position = 0U;
+	stream->fileStatus = GAE_FILE_READ_OK;
+	stream->owned = (0 != buffer) ? GAE_FALSE : GAE_TRUE;
+	stream->isFilling = GAE_FALSE;
+	stream->isRunning = GAE_FALSE;
+	stream->thread = 0;
+	stream->mutex = 0;
+	stream->spaceReady = 0;
+	stream->dataReady = 0;
+
+	if (0 == stream->buffer) {
+		GAE_Stream_delete(stream);
+		return 0;
+	}
+
+	/* without a thread, it carries on reading on the caller's */
+	if (GAE_TRUE == isReadAhead) {
+		stream->mutex = GAE_Mutex_create();
+		stream->spaceReady = GAE_Condition_create();
+		stream->dataReady = GAE_Condition_create();
+		stream->isRunning = GAE_TRUE;
+		stream->thread = GAE_Thread_create(readAheadMain, stream);
+		if (0 == stream->thread)
+			stream->isRunning = GAE_FALSE;
+	}
+
+	return stream;
+}
+
+GAE_Stream_t* GAE_Stream_read(GAE_Stream_t* stream, GAE_BYTE* destination, const unsigned long amount, unsigned long* readAmount, GAE_FILE_READ_STATUS* status) {
+	unsigned long used = 0U;
+
+	if (0 != stream->thread)
+		GAE_Mutex_lock(stream->mutex);
+
+	while (used < amount) {
+		unsigned long size = 0U;
+
+		if (0U == stream->count) {
+			if (GAE_FILE_READ_OK != stream->fileStatus)
+				break;
+
+			if (0 != stream->thread)
+				GAE_Condition_wait(stream->dataReady, stream->mutex);
+			else if (amount - used >= stream->capacity) {
+				/* nothing gained going through the ring for anything that won't fit in it */
+				unsigned long got = 0U;
+				GAE_File_readInto(stream->file, destination + used, amount - used, &got, &stream->fileStatus);
+				stream->position += got;
+				used += got;
+			}
+			else {
+				unsigned long offset = 0U;
+				const unsigned long space = getSpace(stream, &offset);
+				unsigned long got = 0U;
+				GAE_File_readInto(stream->file, stream->buffer + offset, space, &got, &stream->fileStatus);
+				stream->count += got;
+			}
+			continue;
+		}
+
+		size = stream->capacity - stream->start;
+		if (stream->count < size)
+			size = stream->count;
+		if (amount - used < size)
+			size = amount - used;
+
+		memcpy(destination + used, stream->buffer + stream->start, size);
+		stream->start = (stream->start + size) % stream->capacity;
+		stream->count -= size;
+		stream->position += size;
+		used += size;
+
+		if (0 != stream->thread)
+			GAE_Condition_signal(stream->spaceReady);
+	}
+
+	if (0 != readAmount)
+		*readAmount = used;
+	if (0 != status)
+		*status = (used == amount) ? GAE_FILE_READ_OK : stream->fileStatus;
+
+	if (0 != stream->thread)
+		GAE_Mutex_unlock(stream->mutex);
+	return stream;
+}
+
+GAE_Stream_t* GAE_Stream_seek(GAE_Stream_t* stream, const unsigned long position, GAE_FILE_READ_STATUS* status) {
+	const unsigned long target = (position < stream->file->fileSize) ? position : stream->file->fileSize;
+	GAE_FILE_READ_STATUS readStatus = GAE_FILE_READ_OK;
+
+	if (0 != stream->thread)
+		GAE_Mutex_lock(stream->mutex);
+
+	if ((target >= stream->position) && (target - stream->position <= stream->count)) {
+		const unsigned long skipped = target - stream->position;
+		stream->start = (stream->start + skipped) % stream->capacity;
+		stream->count -= skipped;
+		stream->position = target;
+	}
+	else {
+		/* the file can't be moved under a fill */
+		while (GAE_TRUE == stream->isFilling)
+			GAE_Condition_wait(stream->dataReady, stream->mutex);
+
+		GAE_File_setReadPosition(stream->file, target, &readStatus);
+		stream->start = 0U;
+		stream->count = 0U;
+		stream->position = target;
+		/* the end of the file is left for the next fill to find */
+		stream->fileStatus = (GAE_FILE_READ_ERROR == readStatus) ? GAE_FILE_READ_ERROR : GAE_FILE_READ_OK;
+	}
+
+	if (0 != stream->thread) {
+		GAE_Condition_signal(stream->spaceReady);
+		GAE_Mutex_unlock(stream->mutex);
+	}
+
+	if (0 != status) {
+		if (GAE_FILE_READ_ERROR == readStatus)
+			*status = GAE_FILE_READ_ERROR;
+		else
+			*status = (target < stream->file->fileSize) ? GAE_FILE_READ_OK : GAE_FILE_READ_EOF;
+	}
+	return stream;
+}
+
+unsigned long GAE_Stream_tell(GAE_Stream_t* const stream) {
+	return stream->position;
+}
+
+unsigned long GAE_Stream_getSize(GAE_Stream_t* const stream) {
+	return stream->file->fileSize;
+}
+
+void GAE_Stream_delete(GAE_Stream_t* stream) {
+	if (0 != stream->thread) {
+		GAE_Mutex_lock(stream->mutex);
+		stream->isRunning = GAE_FALSE;
+		GAE_Condition_broadcast(stream->spaceReady);
+		GAE_Mutex_unlock(stream->mutex);
+		GAE_Thread_delete(stream->thread);
+	}
+
+	if (0 != stream->mutex) {
+		GAE_Condition_delete(stream->spaceReady);
+		GAE_Condition_delete(stream->dataReady);
+		GAE_Mutex_delete(stream->mutex);
+	}
+
+	GAE_File_close(stream->file, GAE_FILE_CLOSE_DELETE_DATA, 0);
+	GAE_File_delete(stream->file);
+	if (GAE_TRUE == stream->owned)
+		free(stream->buffer);
+	free(stream);
+	stream = 0;
+}
+
+void readAheadMain(void* userData) {
+	GAE_Stream_t* stream = (GAE_Stream_t*)userData;
+	/* filled a piece at a time, so a reader waiting on an empty ring isn't kept waiting on all of it */
+	const unsigned long piece = (3U < stream->capacity) ? stream->capacity / 4U : stream->capacity;
+
+	GAE_Mutex_lock(stream->mutex);
+	for (;;) {
+		unsigned long offset = 0U;
+		unsigned long space = 0U;
+		unsigned long got = 0U;
+		GAE_FILE_READ_STATUS readStatus = GAE_FILE_READ_ERROR;
+
+		while ((GAE_TRUE == stream->isRunning) && ((stream->count == stream->capacity) || (GAE_FILE_READ_OK != stream->fileStatus)))
+			GAE_Condition_wait(stream->spaceReady, stream->mutex);
+
+		if (GAE_FALSE == stream->isRunning)
+			break;
+
+		space = getSpace(stream, &offset);
+		if (piece < space)
+			space = piece;
+
+		/* the reader only touches what's already counted, so the rest of the ring is free to fill unlocked */
+		stream->isFilling = GAE_TRUE;
+		GAE_Mutex_unlock(stream->mutex);
+		GAE_File_readInto(stream->file, stream->buffer + offset, space, &got, &readStatus);
+		GAE_Mutex_lock(stream->mutex);
+		stream->count += got;
+		stream->fileStatus = readStatus;
+		stream->isFilling = GAE_FALSE;
+		GAE_Condition_broadcast(stream->dataReady);
+	}
+	GAE_Mutex_unlock(stream->mutex);
+}
+
+unsigned long getSpace(GAE_Stream_t* stream, unsigned long* offset) {
+	/* an empty ring starts over, so fills stay as large as they can be */
+	if (0U == stream->count)
+		stream->start = 0U;
+
+	*offset = (stream->start + stream->count) % stream->capacity;
+	if (stream->count == stream->capacity)
+		return 0U;
+
+	return (*offset < stream->start) ? stream->start - *offset : stream->capacity - *offset;
+}
@@ -0,0 +1,54 @@
+#ifndef _STREAM_H_
+#define _STREAM_H_
+
+#include "File.h"
+
+/*
+	Reads a file front to back through a fixed size ring buffer, so large maps, audio and logs never need to be held whole.
+	The file is opened once and read straight into the ring with GAE_File_readInto - nothing is allocated after creation.
+	With read ahead, a background thread keeps the ring topped up while the caller works through what's already there;
+	without, the ring is refilled on the caller's thread whenever it runs dry.
+	Seeking within what's buffered skips forward without touching the disk - anywhere else empties the ring.
+	A stream should only be used from the one thread.
+*/
+
+struct GAE_Thread_s;
+struct GAE_Mutex_s;
+struct GAE_Condition_s;
+
+typedef struct GAE_Stream_s {
+	GAE_File_t* file;
+	GAE_BYTE* buffer;
+	unsigned long capacity;
+	unsigned long start;			/* of the oldest unread byte in buffer */
+	unsigned long count;			/* unread bytes in buffer, running on from start and wrapping round */
+	unsigned long position;			/* in the file, of the byte at start */
+	GAE_FILE_READ_STATUS fileStatus;	/* of the last fill - reading stops on anything but GAE_FILE_READ_OK */
+	GAE_BOOL owned;
+	GAE_BOOL isFilling;				/* the read ahead thread is reading into buffer without the lock */
+	GAE_BOOL isRunning;
+	struct GAE_Thread_s* thread;
+	struct GAE_Mutex_s* mutex;
+	struct GAE_Condition_s* spaceReady;
+	struct GAE_Condition_s* dataReady;
+} GAE_Stream_t;
+
+/* Opens the file at filePath to stream through buffer, which must hold capacity bytes - or a buffer of its own if 0. Returns 0 if the file can't be opened. */
+GAE_Stream_t* GAE_Stream_create(const char* const filePath, GAE_BYTE* buffer, const unsigned long capacity, const GAE_BOOL isReadAhead);
+
+/* Copies up to amount bytes into destination, waiting on the disk for as long as it takes - readAmount only falls short at the end of the file or on an error. */
+GAE_Stream_t* GAE_Stream_read(GAE_Stream_t* stream, GAE_BYTE* destination, const unsigned long amount, unsigned long* readAmount, GAE_FILE_READ_STATUS* status);
+
+/* Moves to position in the file, clamped to its end. */
+GAE_Stream_t* GAE_Stream_seek(GAE_Stream_t* stream, const unsigned long position, GAE_FILE_READ_STATUS* status);
+
+/* Returns the position in the file the next read starts from. */
+unsigned long GAE_Stream_tell(GAE_Stream_t* const stream);
+
+/* Returns the size of the file being streamed. */
+unsigned long GAE_Stream_getSize(GAE_Stream_t* const stream);
+
+/* Stops reading ahead, closes the file and deletes the stream - a buffer it was given is left alone. */
+void GAE_Stream_delete(GAE_Stream_t* stream);
+
+#endif
@@ -0,0 +1,552 @@
+#if defined(LINUX) || defined(PANDORA) || defined(ANDROID)
+	/* dirent's d_type is outside plain POSIX */
+	#define _DEFAULT_SOURCE
+	#define _BSD_SOURCE
+#endif
+
+#include "VFS.h"
+#include "Pack.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(LINUX) || defined(PANDORA) || defined(ANDROID)
+	#include <dirent.h>
+	#include <sys/stat.h>
+#elif defined(WIN32)
+	#include <windows.h>
+#endif
+
+#include "../Threads/Thread.h"
+
+/* the index starts with this many slots and doubles, keeping at least half of them empty */
+#define GAE_VFS_INDEX_START 256U
+
+static GAE_VFS_Mount_t* createMount(const GAE_VFS_Type type, const int priority);
+static void addMount(GAE_VFS_Mount_t* mount);
+static void deleteMount(GAE_VFS_Mount_t* mount);
+static void addPath(GAE_VFS_Mount_t* mount, const char* const relative);
+static GAE_BOOL walkDirectory(GAE_VFS_Mount_t* mount, const char* const relative);
+static unsigned int normalise(const char* const path, char* normalised);
+static GAE_BOOL isAbove(GAE_VFS_Mount_t* const mount, GAE_VFS_Mount_t* const other);
+static GAE_VFS_Entry_t* findEntry(const GAE_HashString_t hash);
+static void insertEntry(const GAE_HashString_t hash, GAE_VFS_Mount_t* mount);
+static void rebuildIndex(void);
+static void lock(void);
+static GAE_BOOL lockIfMounted(void);
+
+static GAE_VFS_Mount_t** mounts = 0;
+static unsigned int mountCount = 0U;
+static unsigned int nextOrder = 0U;
+static GAE_VFS_Entry_t* entries = 0;
+static unsigned int entryCapacity = 0U;
+static unsigned int entryCount = 0U;		/* slots not empty, removed ones included */
+static GAE_Mutex_t* mutex = 0;				/* guards everything above, and every mount in mounts */
+static volatile unsigned int hasMutex = 0U;		/* set once the first mount has created it - it's never deleted, as another thread may be about to lock it */
+static volatile unsigned int creatingMutex = 0U;
+
+GAE_VFS_Mount_t* GAE_VFS_mountDirectory(const char* const directory, const char* const mountPoint, const int priority) {
+	GAE_VFS_Mount_t* mount = 0;
+	unsigned long length = strlen(directory);
+
+	/* room left for the mount point, a slash and a file name */
+	if (GAE_VFS_PATH_SIZE / 2U <= length)
+		return 0;
+
+	mount = createMount(GAE_VFS_DIRECTORY, priority);
+	memcpy(mount->directory, directory, length + 1U);
+	while ((1U < length) && (('/' == mount->directory[length - 1U]) || ('\\' == mount->directory[length - 1U])))
+		mount->directory[--length] = '\0';
+
+	length = normalise(mountPoint, mount->path);
+	if ((0U < length) && ('/' != mount->path[length - 1U]) && (length + 1U < GAE_VFS_PATH_SIZE)) {
+		mount->path[length] = '/';
+		mount->path[length + 1U] = '\0';
+	}
+
+	if (GAE_FALSE == walkDirectory(mount, "")) {
+		deleteMount(mount);
+		return 0;
+	}
+
+	addMount(mount);
+	return mount;
+}
+
+GAE_VFS_Mount_t* GAE_VFS_mountPack(GAE_Pack_t* const pack, const int priority) {
+	GAE_VFS_Mount_t* mount = createMount(GAE_VFS_PACK, priority);
+	unsigned int index = 0U;
+
+	mount->pack = pack;
+
+	/* the pack only holds hashes, which is all the index needs */
+	mount->hashes = malloc((0U < pack->entryCount ? pack->entryCount : 1U) * sizeof(GAE_HashString_t));
+	mount->hashCapacity = pack->entryCount;
+	for (index = 0U; index < pack->entryCount; ++index)
+		mount->hashes[mount->hashCount++] = GAE_Pack_getHash(pack, index);
+
+	addMount(mount);
+	return mount;
+}
+
+GAE_VFS_Mount_t* GAE_VFS_mountMemory(const GAE_BYTE* data, const unsigned long size, const char* const path, const int priority) {
+	GAE_VFS_Mount_t* mount = createMount(GAE_VFS_MEMORY, priority);
+
+	mount->data = data;
+	mount->size = size;
+	normalise(path, mount->path);
+	addPath(mount, "");
+
+	addMount(mount);
+	return mount;
+}
+
+void GAE_VFS_unmount(GAE_VFS_Mount_t* mount) {
+	unsigned int index = 0U;
+
+	lock();
+	for (index = 0U; index < mountCount; ++index) {
+		if (mount == mounts[index]) {
+			memmove(&mounts[index], &mounts[index + 1U], (mountCount - index - 1U) * sizeof(GAE_VFS_Mount_t*));
+			--mountCount;
+			break;
+		}
+	}
+
+	/* with nothing mounted, every path goes straight to the disk as it always did */
+	if (0U == mountCount) {
+		free(mounts);
+		mounts = 0;
+		free(entries);
+		entries = 0;
+		entryCapacity = 0U;
+		entryCount = 0U;
+	}
+	else
+		rebuildIndex();
+	GAE_Mutex_unlock(mutex);
+
+	/* nothing can reach it now the index has let go of it, and resolve is done with it once it has the lock */
+	deleteMount(mount);
+}
+
+GAE_VFS_Mount_t* GAE_VFS_findPack(GAE_Pack_t* const pack) {
+	GAE_VFS_Mount_t* found = 0;
+	unsigned int index = 0U;
+
+	if (GAE_FALSE == lockIfMounted())
+		return 0;
+
+	for (index = mountCount; (0 == found) && (0U < index); --index) {
+		if ((GAE_VFS_PACK == mounts[index - 1U]->type) && (pack == mounts[index - 1U]->pack))
+			found = mounts[index - 1U];
+	}
+	GAE_Mutex_unlock(mutex);
+
+	return found;
+}
+
+void GAE_VFS_refresh(void) {
+	unsigned int index = 0U;
+
+	/* the walks are done holding the lock too, so a mount can't be unmounted from under one */
+	if (GAE_FALSE == lockIfMounted())
+		return;
+
+	for (index = 0U; index < mountCount; ++index) {
+		GAE_VFS_Mount_t* mount = mounts[index];
+		if (GAE_VFS_DIRECTORY == mount->type) {
+			/* a directory that's gone away is left mounted, empty, in case it comes back */
+			mount->hashCount = 0U;
+			walkDirectory(mount, "");
+		}
+	}
+
+	if (0U < mountCount)
+		rebuildIndex();
+	GAE_Mutex_unlock(mutex);
+}
+
+GAE_VFS_Status GAE_VFS_resolve(const char* const path, char* diskPath, const unsigned long diskPathSize, GAE_Pack_Entry_t** entry) {
+	char normalised[GAE_VFS_PATH_SIZE];
+	GAE_VFS_Entry_t* found = 0;
+	GAE_VFS_Mount_t* mount = 0;
+	GAE_VFS_Status status = GAE_VFS_FOUND;
+
+	*entry = 0;
+	normalise(path, normalised);
+
+	/* the mount is only used holding the lock, so it can't be unmounted and deleted part way through */
+	if (GAE_FALSE == lockIfMounted())
+		return GAE_VFS_UNKNOWN;
+
+	found = findEntry(GAE_Pack_hashPath(normalised));
+	if (0 == found) {
+		GAE_Mutex_unlock(mutex);
+		return GAE_VFS_UNKNOWN;
+	}
+	mount = found->mount;
+
+	if (0 == mount) {
+		GAE_Mutex_unlock(mutex);
+		return GAE_VFS_MISSING;
+	}
+
+	switch (mount->type) {
+		case GAE_VFS_PACK: {
+			GAE_Pack_Entry_t packEntry;
+			if (GAE_FALSE == GAE_Pack_find(mount->pack, normalised, &packEntry)) {
+				status = GAE_VFS_UNKNOWN;
+				break;
+			}
+
+			*entry = malloc(sizeof(GAE_Pack_Entry_t));
+			memcpy(*entry, &packEntry, sizeof(GAE_Pack_Entry_t));
+			break;
+		}
+		case GAE_VFS_MEMORY: {
+			/* read just as an uncompressed file in a pack would be */
+			*entry = malloc(sizeof(GAE_Pack_Entry_t));
+			(*entry)->pack = 0;
+			(*entry)->data = mount->data;
+			(*entry)->size = mount->size;
+			(*entry)->storedSize = mount->size;
+			(*entry)->flags = 0U;
+			(*entry)->unpacked = 0;
+			break;
+		}
+		case GAE_VFS_DIRECTORY: {
+			const unsigned long pathLength = strlen(mount->path);
+			const unsigned long directoryLength = strlen(mount->directory);
+
+			/* the path is checked as well as the hash, as it's there to check */
+			if ((0 != strncmp(normalised, mount->path, pathLength)) || (directoryLength + 1U + strlen(normalised + pathLength) >= diskPathSize)) {
+				status = GAE_VFS_UNKNOWN;
+				break;
+			}
+
+			memcpy(diskPath, mount->directory, directoryLength);
+			diskPath[directoryLength] = '/';
+			strcpy(diskPath + directoryLength + 1U, normalised + pathLength);
+			break;
+		}
+	}
+	GAE_Mutex_unlock(mutex);
+
+	return status;
+}
+
+GAE_BOOL GAE_VFS_exists(const char* const path) {
+	char diskPath[GAE_VFS_PATH_SIZE];
+	GAE_Pack_Entry_t* entry = 0;
+	GAE_File_t* file = 0;
+	GAE_FILE_STATUS fileStatus = GAE_FILE_ERROR;
+
+	switch (GAE_VFS_resolve(path, diskPath, sizeof(diskPath), &entry)) {
+		case GAE_VFS_FOUND:
+			if (0 != entry)
+				GAE_Pack_Entry_delete(entry);
+			return GAE_TRUE;
+		case GAE_VFS_MISSING:
+			return GAE_FALSE;
+		case GAE_VFS_UNKNOWN:
+			break;
+	}
+
+	/* opening it marks it missing if it's not there */
+	file = GAE_File_create(path);
+	GAE_File_open(file, GAE_FILE_OPEN_READ, GAE_FILE_BINARY, &fileStatus);
+	GAE_File_close(file, GAE_FILE_CLOSE_DELETE_DATA, 0);
+	GAE_File_delete(file);
+
+	return (GAE_FILE_OPEN == fileStatus) ? GAE_TRUE : GAE_FALSE;
+}
+
+void GAE_VFS_markMissing(const char* const path) {
+	char normalised[GAE_VFS_PATH_SIZE];
+	GAE_HashString_t hash = 0U;
+
+	normalise(path, normalised);
+	hash = GAE_Pack_hashPath(normalised);
+
+	if (GAE_FALSE == lockIfMounted())
+		return;
+
+	if (0 == findEntry(hash))
+		insertEntry(hash, 0);
+	GAE_Mutex_unlock(mutex);
+}
+
+void GAE_VFS_forget(const char* const path) {
+	char normalised[GAE_VFS_PATH_SIZE];
+	GAE_VFS_Entry_t* entry = 0;
+
+	normalise(path, normalised);
+
+	if (GAE_FALSE == lockIfMounted())
+		return;
+
+	entry = findEntry(GAE_Pack_hashPath(normalised));
+	if ((0 != entry) && (0 == entry->mount))
+		entry->state = GAE_VFS_ENTRY_REMOVED;
+	GAE_Mutex_unlock(mutex);
+}
+
+GAE_VFS_Mount_t* createMount(const GAE_VFS_Type type, const int priority) {
+	GAE_VFS_Mount_t* mount = malloc(sizeof(GAE_VFS_Mount_t));
+
+	mount->type = type;
+	mount->priority = priority;
+	mount->order = 0U;
+	mount->path[0] = '\0';
+	mount->directory[0] = '\0';
+	mount->pack = 0;
+	mount->data = 0;
+	mount->size = 0UL;
+	mount->hashes = 0;
+	mount->hashCount = 0U;
+	mount->hashCapacity = 0U;
+
+	return mount;
+}
+
+void addMount(GAE_VFS_Mount_t* mount) {
+	unsigned int index = 0U;
+
+	lock();
+	mount->order = nextOrder++;
+	mounts = realloc(mounts, (mountCount + 1U) * sizeof(GAE_VFS_Mount_t*));
+	mounts[mountCount++] = mount;
+
+	/* a path missing until now is found in this one just as any other is */
+	for (index = 0U; index < mount->hashCount; ++index)
+		insertEntry(mount->hashes[index], mount);
+	GAE_Mutex_unlock(mutex);
+}
+
+void deleteMount(GAE_VFS_Mount_t* mount) {
+	free(mount->hashes);
+	free(mount);
+	mount = 0;
+}
+
+void addPath(GAE_VFS_Mount_t* mount, const char* const relative) {
+	char path[GAE_VFS_PATH_SIZE];
+	const unsigned long pathLength = strlen(mount->path);
+
+	if (pathLength + strlen(relative) >= sizeof(path))
+		return;
+
+	memcpy(path, mount->path, pathLength);
+	strcpy(path + pathLength, relative);
+
+	if (mount->hashCount == mount->hashCapacity) {
+		mount->hashCapacity = (0U == mount->hashCapacity) ? 64U : mount->hashCapacity * 2U;
+		mount->hashes = realloc(mount->hashes, mount->hashCapacity * sizeof(GAE_HashString_t));
+	}
+	mount->hashes[mount->hashCount++] = GAE_Pack_hashPath(path);
+}
+
+GAE_BOOL walkDirectory(GAE_VFS_Mount_t* mount, const char* const relative) {
+	char diskPath[GAE_VFS_PATH_SIZE];
+	char childPath[GAE_VFS_PATH_SIZE];
+	const unsigned long directoryLength = strlen(mount->directory);
+	const unsigned long relativeLength = strlen(relative);
+
+	if (directoryLength + 1U + relativeLength + 2U >= sizeof(diskPath))
+		return GAE_FALSE;
+
+	memcpy(diskPath, mount->directory, directoryLength);
+	diskPath[directoryLength] = '/';
+	strcpy(diskPath + directoryLength + 1U, relative);
+
+#if defined(LINUX) || defined(PANDORA) || defined(ANDROID)
+	{
+		DIR* directory = opendir(diskPath);
+		struct dirent* item = 0;
+
+		if (0 == directory)
+			return GAE_FALSE;
+
+		while (0 != (item = readdir(directory))) {
+			const unsigned long nameLength = strlen(item->d_name);
+			GAE_BOOL isDirectory = (DT_DIR == item->d_type) ? GAE_TRUE : GAE_FALSE;
+			GAE_BOOL isFile = (DT_REG == item->d_type) ? GAE_TRUE : GAE_FALSE;
+
+			if ((0 == strcmp(item->d_name, ".")) || (0 == strcmp(item->d_name, "..")))
+				continue;
+
+			if (directoryLength + 1U + relativeLength + nameLength + 1U >= sizeof(childPath))
+				continue;
+
+			sprintf(childPath, "%s%s%s", relative, (0U < relativeLength) ? "/" : "", item->d_name);
+
+			/* links are followed to files but not directories, so a loop of them can't be walked forever */
+			if ((DT_UNKNOWN == item->d_type) || (DT_LNK == item->d_type)) {
+				struct stat info;
+				char fullPath[GAE_VFS_PATH_SIZE];
+
+				memcpy(fullPath, diskPath, directoryLength + 1U);
+				strcpy(fullPath + directoryLength + 1U, childPath);
+				if (0 == stat(fullPath, &info)) {
+					isFile = (S_ISREG(info.st_mode)) ? GAE_TRUE : GAE_FALSE;
+					isDirectory = ((DT_UNKNOWN == item->d_type) && (S_ISDIR(info.st_mode))) ? GAE_TRUE : GAE_FALSE;
+				}
+			}
+
+			if (GAE_TRUE == isDirectory)
+				walkDirectory(mount, childPath);
+			else if (GAE_TRUE == isFile)
+				addPath(mount, childPath);
+		}
+
+		closedir(directory);
+	}
+#elif defined(WIN32)
+	{
+		WIN32_FIND_DATAA item;
+		HANDLE search = INVALID_HANDLE_VALUE;
+
+		strcat(diskPath, (0U < relativeLength) ? "/*" : "*");
+		search = FindFirstFileA(diskPath, &item);
+		if (INVALID_HANDLE_VALUE == search)
+			return GAE_FALSE;
+
+		do {
+			const unsigned long nameLength = strlen(item.cFileName);
+
+			if ((0 == strcmp(item.cFileName, ".")) || (0 == strcmp(item.cFileName, "..")))
+				continue;
+
+			if (directoryLength + 1U + relativeLength + nameLength + 1U >= sizeof(childPath))
+				continue;
+
+			sprintf(childPath, "%s%s%s", relative, (0U < relativeLength) ? "/" : "", item.cFileName);
+
+			if (0U != (item.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+				walkDirectory(mount, childPath);
+			else
+				addPath(mount, childPath);
+		} while (0 != FindNextFileA(search, &item));
+
+		FindClose(search);
+	}
+#else
+	(void)childPath;
+	return GAE_FALSE;
+#endif
+
+	return GAE_TRUE;
+}
+
+unsigned int normalise(const char* const path, char* normalised) {
+	const char* source = path;
+	unsigned int index = 0U;
+
+	/* as GAE_Pack_hashPath sees it, so the hashes agree */
+	while (('.' == source[0]) && (('/' == source[1]) || ('\\' == source[1])))
+		source += 2;
+
+	for (index = 0U; (index + 1U < GAE_VFS_PATH_SIZE) && ('\0' != source[index]); ++index)
+		normalised[index] = ('\\' == source[index]) ? '/' : source[index];
+	normalised[index] = '\0';
+
+	return index;
+}
+
+GAE_BOOL isAbove(GAE_VFS_Mount_t* const mount, GAE_VFS_Mount_t* const other) {
+	if (mount->priority != other->priority)
+		return (mount->priority > other->priority) ? GAE_TRUE : GAE_FALSE;
+
+	return (mount->order > other->order) ? GAE_TRUE : GAE_FALSE;
+}
+
+GAE_VFS_Entry_t* findEntry(const GAE_HashString_t hash) {
+	unsigned int slot = 0U;
+
+	if (0U == entryCapacity)
+		return 0;
+
+	/* removed slots are stepped over, only an empty one ends the run */
+	for (slot = hash & (entryCapacity - 1U); GAE_VFS_ENTRY_EMPTY != entries[slot].state; slot = (slot + 1U) & (entryCapacity - 1U)) {
+		if ((GAE_VFS_ENTRY_USED == entries[slot].state) && (hash == entries[slot].hash))
+			return &entries[slot];
+	}
+
+	return 0;
+}
+
+void insertEntry(const GAE_HashString_t hash, GAE_VFS_Mount_t* mount) {
+	GAE_VFS_Entry_t* entry = findEntry(hash);
+	unsigned int slot = 0U;
+
+	if (0 != entry) {
+		if ((0 == entry->mount) || ((0 != mount) && (GAE_TRUE == isAbove(mount, entry->mount))))
+			entry->mount = mount;
+		return;
+	}
+
+	if ((entryCount + 1U) * 2U > entryCapacity) {
+		GAE_VFS_Entry_t* oldEntries = entries;
+		const unsigned int oldCapacity = entryCapacity;
+		unsigned int index = 0U;
+
+		entryCapacity = (0U == entryCapacity) ? GAE_VFS_INDEX_START : entryCapacity * 2U;
+		entries = calloc(entryCapacity, sizeof(GAE_VFS_Entry_t));
+		entryCount = 0U;
+
+		for (index = 0U; index < oldCapacity; ++index) {
+			if (GAE_VFS_ENTRY_USED == oldEntries[index].state)
+				insertEntry(oldEntries[index].hash, oldEntries[index].mount);
+		}
+		free(oldEntries);
+	}
+
+	for (slot = hash & (entryCapacity - 1U); GAE_VFS_ENTRY_USED == entries[slot].state; slot = (slot + 1U) & (entryCapacity - 1U));
+
+	if (GAE_VFS_ENTRY_EMPTY == entries[slot].state)
+		++entryCount;
+	entries[slot].hash = hash;
+	entries[slot].mount = mount;
+	entries[slot].state = GAE_VFS_ENTRY_USED;
+}
+
+void rebuildIndex(void) {
+	unsigned int index = 0U;
+	unsigned int hashIndex = 0U;
+
+	free(entries);
+	entries = 0;
+	entryCapacity = 0U;
+	entryCount = 0U;
+
+	for (index = 0U; index < mountCount; ++index) {
+		for (hashIndex = 0U; hashIndex < mounts[index]->hashCount; ++hashIndex)
+			insertEntry(mounts[index]->hashes[hashIndex], mounts[index]);
+	}
+}
+
+void lock(void) {
+	/* mounts racing to be first take turns, and only the first creates it */
+	if (0U == GAE_Atomic_load(&hasMutex)) {
+		while (0U != GAE_Atomic_exchange(&creatingMutex, 1U))
+			GAE_Thread_sleep(0U);
+
+		if (0U == GAE_Atomic_load(&hasMutex)) {
+			mutex = GAE_Mutex_create();
+			GAE_Atomic_store(&hasMutex, 1U);
+		}
+		GAE_Atomic_store(&creatingMutex, 0U);
+	}
+
+	GAE_Mutex_lock(mutex);
+}
+
+GAE_BOOL lockIfMounted(void) {
+	/* nothing has ever been mounted, so there's nothing to find */
+	if (0U == GAE_Atomic_load(&hasMutex))
+		return GAE_FALSE;
+
+	GAE_Mutex_lock(mutex);
+	return GAE_TRUE;
+}
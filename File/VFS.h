@@ -0,0 +1,93 @@
+#ifndef _VFS_H_
+#define _VFS_H_
+
+#include "File.h"
+
+/*
+	Layered virtual file system - directories, packs and blobs in memory are mounted as overlays, and the highest priority mount with a path has it.
+	Every path a mount holds is indexed by its hash, as GAE_Pack_hashPath gives, when it's mounted,
+	so finding a file is one hash lookup however many mounts there are, and never touches the disk.
+	Directories are walked when they're mounted - files added to them afterwards aren't found until GAE_VFS_refresh.
+	Paths in no mount fall through to the disk as given, and those not there either are remembered,
+	so probing for optional files only ever costs the first time. Unmounting and refreshing forget them all.
+	Only hashes are kept, so two paths that hash the same are the same path as far as any pack or blob is concerned.
+
+	GAE_File_open resolves through here for the read modes, and opening a path to write forgets it was missing.
+	Every function here can be called from any thread - a mount is only unmounted once no lookup is using it, though refreshing holds every lookup up while it walks.
+*/
+
+#define GAE_VFS_PATH_SIZE 1024U
+
+struct GAE_Pack_s;
+struct GAE_Pack_Entry_s;
+struct GAE_Mutex_s;
+
+typedef enum GAE_VFS_Type_e {
+	GAE_VFS_DIRECTORY
+,	GAE_VFS_PACK
+,	GAE_VFS_MEMORY
+} GAE_VFS_Type;
+
+typedef enum GAE_VFS_Status_e {
+	GAE_VFS_FOUND			/* in a mount */
+,	GAE_VFS_MISSING			/* in no mount, and already known not to be on the disk */
+,	GAE_VFS_UNKNOWN			/* in no mount - open it as given */
+} GAE_VFS_Status;
+
+typedef enum GAE_VFS_Entry_State_e {
+	GAE_VFS_ENTRY_EMPTY
+,	GAE_VFS_ENTRY_USED
+,	GAE_VFS_ENTRY_REMOVED	/* a missing path since found - kept so lookups carry on past it */
+} GAE_VFS_Entry_State;
+
+typedef struct GAE_VFS_Mount_s {
+	GAE_VFS_Type type;
+	int priority;
+	unsigned int order;				/* of mounting, so the newest wins between equal priorities */
+	char path[GAE_VFS_PATH_SIZE];	/* normalised - where a directory is mounted, ending in a slash unless it's the root, or a blob's own path */
+	char directory[GAE_VFS_PATH_SIZE];
+	struct GAE_Pack_s* pack;
+	const GAE_BYTE* data;
+	unsigned long size;
+	GAE_HashString_t* hashes;		/* of every path the mount holds, so the index can be rebuilt without walking it again */
+	unsigned int hashCount;
+	unsigned int hashCapacity;
+} GAE_VFS_Mount_t;
+
+typedef struct GAE_VFS_Entry_s {
+	GAE_HashString_t hash;
+	GAE_VFS_Mount_t* mount;			/* 0 for a path known to be missing */
+	GAE_VFS_Entry_State state;
+} GAE_VFS_Entry_t;
+
+/* Mounts the files under directory at mountPoint - "" for the root - returning 0 if it can't be read. */
+GAE_VFS_Mount_t* GAE_VFS_mountDirectory(const char* const directory, const char* const mountPoint, const int priority);
+
+/* Mounts every file in the pack at the root, as packs hold whole paths. The pack must outlive the mount. */
+GAE_VFS_Mount_t* GAE_VFS_mountPack(struct GAE_Pack_s* const pack, const int priority);
+
+/* Mounts size bytes at data as the file at path. The data must outlive the mount, and be followed by a zero byte as any read buffer is. */
+GAE_VFS_Mount_t* GAE_VFS_mountMemory(const GAE_BYTE* data, const unsigned long size, const char* const path, const int priority);
+
+/* Unmounts and deletes the mount - files already open from it carry on working. */
+void GAE_VFS_unmount(GAE_VFS_Mount_t* mount);
+
+/* Returns the newest mount of the pack, or 0. */
+GAE_VFS_Mount_t* GAE_VFS_findPack(struct GAE_Pack_s* const pack);
+
+/* Walks every mounted directory again and forgets every path known to be missing. */
+void GAE_VFS_refresh(void);
+
+/* Looks path up - a file found in a pack or blob fills a new entry, one found in a directory fills diskPath with where it is on the disk. */
+GAE_VFS_Status GAE_VFS_resolve(const char* const path, char* diskPath, const unsigned long diskPathSize, struct GAE_Pack_Entry_s** entry);
+
+/* Returns whether path is in a mount or on the disk. */
+GAE_BOOL GAE_VFS_exists(const char* const path);
+
+/* Remembers that path, in no mount, isn't on the disk either. */
+void GAE_VFS_markMissing(const char* const path);
+
+/* Forgets that path was missing, as when it's about to be written. */
+void GAE_VFS_forget(const char* const path);
+
+#endif
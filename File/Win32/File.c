@@ -1,13 +1,21 @@
 #include "../File.h"
+#include "../Compressed.h"
+#include "../Pack.h"
+#include "../VFS.h"
 
+#include <errno.h>
 #include <string.h>
 #include <stdlib.h>
 
+static GAE_BOOL openCompressed(GAE_File_t* file);
+static GAE_BOOL readAt(void* source, const unsigned long offset, GAE_BYTE* destination, const unsigned long amount);
+
 GAE_File_t* GAE_File_create(const char* filePath) {
 	GAE_File_t* file = (GAE_File_t*)malloc(sizeof(GAE_File_t));
 	GAE_PlatformFile_t* platform = (GAE_PlatformFile_t*)malloc(sizeof(GAE_PlatformFile_t));
 
-	strncpy(file->filePath, filePath, sizeof(file->filePath));
+	strncpy(file->filePath, filePath, sizeof(file->filePath) - 1U);
+	file->filePath[sizeof(file->filePath) - 1U] = '\0';
 	file->buffer = 0;
 	file->readPosition = 0U;
 	file->bufferSize = 0U;
@@ -16,6 +24,8 @@ GAE_File_t* GAE_File_create(const char* filePath) {
 	file->openMode = GAE_FILE_OPEN_READ;
 	file->owned = GAE_FALSE;
 	platform->file = 0;
+	platform->entry = 0;
+	platform->compressed = 0;
 	file->platformFile = (void*)platform;
 
 	return file;
@@ -23,11 +33,21 @@ GAE_File_t* GAE_File_create(const char* filePath) {
 
 void GAE_File_delete(GAE_File_t* file) {
 	GAE_PlatformFile_t* platform = (GAE_PlatformFile_t*)file->platformFile;
+	if (0 != platform->compressed) {
+		GAE_Compressed_delete(platform->compressed);
+		platform->compressed = 0;
+	}
+
 	if (0 != platform->file) {
 		fclose(platform->file);
 		platform->file = 0;
 	}
 
+	if (0 != platform->entry) {
+		GAE_Pack_Entry_delete(platform->entry);
+		platform->entry = 0;
+	}
+
 	free(platform);
 	free(file);
 	file = 0;
@@ -36,6 +56,9 @@ void GAE_File_delete(GAE_File_t* file) {
 GAE_File_t* GAE_File_open(GAE_File_t* file, const GAE_FILE_OPEN_MODE openMode, const GAE_FILE_MODE fileMode, GAE_FILE_STATUS* status) {
 	GAE_PlatformFile_t* platform = (GAE_PlatformFile_t*)file->platformFile;
 	char options[3];
+	char diskPath[GAE_VFS_PATH_SIZE];
+	const char* path = file->filePath;
+	GAE_VFS_Status found = GAE_VFS_UNKNOWN;
 	options[2] = '\0';
 
 	if (file->fileStatus != GAE_FILE_CLOSED) {
@@ -44,7 +67,7 @@ GAE_File_t* GAE_File_open(GAE_File_t* file, const GAE_FILE_OPEN_MODE openMode, c
 		return file;
 	}
 	
-	if (0 != platform->file) {
+	if ((0 != platform->file) || (0 != platform->entry)) {
 		if (0 != status)
 			*status = GAE_FILE_ERROR;
 		return file;
@@ -55,9 +78,39 @@ GAE_File_t* GAE_File_open(GAE_File_t* file, const GAE_FILE_OPEN_MODE openMode, c
 			*status = GAE_FILE_ERROR;
 		return file;
 	}
+
+	/* reopened, it reads from the start again rather than wherever the last read left off */
+	file->readPosition = 0U;
+
+	if ((GAE_FILE_OPEN_WRITE != openMode) && (GAE_FILE_OPEN_APPEND != openMode)) {
+		found = GAE_VFS_resolve(file->filePath, diskPath, sizeof(diskPath), &platform->entry);
+		if (GAE_VFS_MISSING == found) {
+			if (0 != status)
+				*status = GAE_FILE_NOT_FOUND;
+			return file;
+		}
+
+		if (0 != platform->entry) {
+			file->fileSize = platform->entry->size;
+			file->owned = GAE_TRUE;
+			file->fileStatus = GAE_FILE_OPEN;
+			file->openMode = openMode;
+
+			if (0 != status)
+				*status = file->fileStatus;
+			return file;
+		}
+
+		if (GAE_VFS_FOUND == found)
+			path = diskPath;
+	}
+	else
+		GAE_VFS_forget(file->filePath);
 	
 	switch (openMode) {
 		case GAE_FILE_OPEN_READ:
+		case GAE_FILE_OPEN_MAP:			/* not mapped here - read in whole, as GAE_FILE_OPEN_READ */
+		case GAE_FILE_OPEN_MAP_RANDOM:
 			options[0] = 'r';
 			file->owned = GAE_TRUE;
 			break;
@@ -80,9 +133,12 @@ GAE_File_t* GAE_File_open(GAE_File_t* file, const GAE_FILE_OPEN_MODE openMode, c
 			break;
 	};
 	
-	platform->file = fopen(file->filePath, options);
+	platform->file = fopen(path, options);
 	
 	if (0 == platform->file) {
+		/* so probing for it again doesn't need the disk */
+		if ((GAE_FILE_OPEN_WRITE != openMode) && (GAE_FILE_OPEN_APPEND != openMode) && (GAE_VFS_UNKNOWN == found) && (ENOENT == errno))
+			GAE_VFS_markMissing(file->filePath);
 		if (0 != status)
 			*status = GAE_FILE_NOT_FOUND;
 		return file;
@@ -94,6 +150,16 @@ GAE_File_t* GAE_File_open(GAE_File_t* file, const GAE_FILE_OPEN_MODE openMode, c
 	fseek(platform->file, 0, SEEK_END);
 	file->fileSize = ftell(platform->file);
 	rewind(platform->file);
+
+	if ((GAE_FILE_OPEN_WRITE != openMode) && (GAE_FILE_OPEN_APPEND != openMode) && (GAE_FALSE == openCompressed(file))) {
+		fclose(platform->file);
+		platform->file = 0;
+		file->fileSize = 0U;
+		file->fileStatus = GAE_FILE_CLOSED;
+		if (0 != status)
+			*status = GAE_FILE_ERROR;
+		return file;
+	}
 	
 	if (0 != status)
 		*status = file->fileStatus;
@@ -110,14 +176,25 @@ GAE_File_t* GAE_File_close(GAE_File_t* file, const GAE_FILE_CLOSE_MODE mode, GAE
 		return file;
 	}
 	
-	if (0 == platform->file) {
+	if ((0 == platform->file) && (0 == platform->entry)) {
 		if (0 != status)
 			*status = GAE_FILE_ERROR;
 		return file;
 	}
 	
-	fclose(platform->file);
-	platform->file = 0;
+	if (0 != platform->compressed) {
+		GAE_Compressed_delete(platform->compressed);
+		platform->compressed = 0;
+	}
+
+	if (0 != platform->file) {
+		fclose(platform->file);
+		platform->file = 0;
+	}
+	else {
+		GAE_Pack_Entry_delete(platform->entry);
+		platform->entry = 0;
+	}
 	
 	file->fileStatus = GAE_FILE_CLOSED;
 	if (0 != status)
@@ -162,7 +239,7 @@ GAE_File_t* GAE_File_read(GAE_File_t* file, const unsigned long amount, GAE_FILE
 	unsigned long readAmount = amount;
 	long read = 0;
 
-	if (file->openMode != GAE_FILE_OPEN_READ) {
+	if ((file->openMode != GAE_FILE_OPEN_READ) && (file->openMode != GAE_FILE_OPEN_MAP) && (file->openMode != GAE_FILE_OPEN_MAP_RANDOM)) {
 		if (0 != status)
 			*status = GAE_FILE_READ_ERROR;
 		return file;
@@ -174,6 +251,14 @@ GAE_File_t* GAE_File_read(GAE_File_t* file, const unsigned long amount, GAE_FILE
 		return file;
 	}
 	
+	/* views into the pack aren't the file's to free, but are its to replace */
+	if (0 != platform->entry) {
+		if (GAE_TRUE == file->owned)
+			free(file->buffer);
+		file->buffer = 0;
+		return GAE_Pack_Entry_read(platform->entry, file, amount, status);
+	}
+
 	if (0 == platform->file) {
 		if (0 != status)
 			*status = GAE_FILE_READ_ERROR;
@@ -185,6 +270,12 @@ GAE_File_t* GAE_File_read(GAE_File_t* file, const unsigned long amount, GAE_FILE
 			*status = GAE_FILE_READ_ERROR;
 		return file;
 	}
+
+	if (0 != platform->compressed) {
+		free(file->buffer);
+		file->buffer = 0;
+		return GAE_Compressed_read(platform->compressed, file, amount, status);
+	}
 	
 	if (readAmount < file->fileSize)
 		file->bufferSize = readAmount;
@@ -197,7 +288,6 @@ GAE_File_t* GAE_File_read(GAE_File_t* file, const unsigned long amount, GAE_FILE
 		free(file->buffer);
 	
 	file->buffer = (GAE_BYTE*)malloc(file->bufferSize + 1U);
-	memset(file->buffer, '\0', file->bufferSize);
 	if (0 == file->buffer) {
 		if (0 != status)
 			*status = GAE_FILE_READ_ERROR;
@@ -207,6 +297,8 @@ GAE_File_t* GAE_File_read(GAE_File_t* file, const unsigned long amount, GAE_FILE
 	file->owned = GAE_TRUE;
 	read = fread(file->buffer, 1, file->bufferSize, platform->file);
 	file->readPosition += (unsigned long)read;
+	/* terminated for text, and zeroed past a short read rather than left as whatever malloc gave */
+	memset(file->buffer + read, '\0', file->bufferSize + 1U - (unsigned long)read);
 	
 	if ((unsigned long)(read) == readAmount) {
 		if (0 != status)
@@ -225,6 +317,51 @@ GAE_File_t* GAE_File_read(GAE_File_t* file, const unsigned long amount, GAE_FILE
 	}
 }
 
+GAE_File_t* GAE_File_readInto(GAE_File_t* file, GAE_BYTE* destination, const unsigned long amount, unsigned long* readAmount, GAE_FILE_READ_STATUS* status) {
+	GAE_PlatformFile_t* platform = (GAE_PlatformFile_t*)file->platformFile;
+	unsigned long used = 0U;
+
+	if (0 != readAmount)
+		*readAmount = 0U;
+
+	if ((file->openMode != GAE_FILE_OPEN_READ) && (file->openMode != GAE_FILE_OPEN_MAP) && (file->openMode != GAE_FILE_OPEN_MAP_RANDOM)) {
+		if (0 != status)
+			*status = GAE_FILE_READ_ERROR;
+		return file;
+	}
+
+	if (file->fileStatus != GAE_FILE_OPEN) {
+		if (0 != status)
+			*status = GAE_FILE_READ_ERROR;
+		return file;
+	}
+
+	if (0 != platform->entry)
+		return GAE_Pack_Entry_readInto(platform->entry, file, destination, amount, readAmount, status);
+
+	if (0 != platform->compressed)
+		return GAE_Compressed_readInto(platform->compressed, file, destination, amount, readAmount, status);
+
+	if (0 == platform->file) {
+		if (0 != status)
+			*status = GAE_FILE_READ_ERROR;
+		return file;
+	}
+
+	used = (unsigned long)fread(destination, 1, amount, platform->file);
+	file->readPosition += used;
+	if (0 != readAmount)
+		*readAmount = used;
+
+	if (0 != status) {
+		if (used == amount)
+			*status = GAE_FILE_READ_OK;
+		else
+			*status = (0 != feof(platform->file)) ? GAE_FILE_READ_EOF : GAE_FILE_READ_ERROR;
+	}
+	return file;
+}
+
 GAE_File_t* GAE_File_write(GAE_File_t* file, GAE_FILE_WRITE_STATUS* status) {
 	GAE_PlatformFile_t* platform = (GAE_PlatformFile_t*)file->platformFile;
 	long written = 0;
@@ -266,7 +403,7 @@ GAE_File_t* GAE_File_write(GAE_File_t* file, GAE_FILE_WRITE_STATUS* status) {
 	}
 }
 
-GAE_File_t* GAE_FILE_setReadPosition(GAE_File_t* file, const unsigned long readPosition, GAE_FILE_READ_STATUS* status) {
+GAE_File_t* GAE_File_setReadPosition(GAE_File_t* file, const unsigned long readPosition, GAE_FILE_READ_STATUS* status) {
 	GAE_PlatformFile_t* platform = (GAE_PlatformFile_t*)file->platformFile;
 
 	if (file->fileStatus != GAE_FILE_OPEN) {
@@ -275,19 +412,27 @@ GAE_File_t* GAE_FILE_setReadPosition(GAE_File_t* file, const unsigned long readP
 		return file;
 	}
 	
-	if (file->openMode != GAE_FILE_OPEN_READ) {
+	if ((file->openMode != GAE_FILE_OPEN_READ) && (file->openMode != GAE_FILE_OPEN_MAP) && (file->openMode != GAE_FILE_OPEN_MAP_RANDOM)) {
 		if (0 != status)
 			*status = GAE_FILE_READ_ERROR;
 		return file;
 	}
 	
+	/* packs and decompressing both read from readPosition, so there's nothing else to move */
+	if ((0 != platform->entry) || (0 != platform->compressed)) {
+		file->readPosition = (readPosition < file->fileSize) ? readPosition : file->fileSize;
+		if (0 != status)
+			*status = (readPosition < file->fileSize) ? GAE_FILE_READ_OK : GAE_FILE_READ_EOF;
+		return file;
+	}
+
 	if (0 == platform->file) {
 		if (0 != status)
 			*status = GAE_FILE_READ_ERROR;
 		return file;
 	}
 	
-	if (file->readPosition < file->fileSize) {
+	if (readPosition < file->fileSize) {
 		file->readPosition = readPosition;
 		fseek(platform->file, file->readPosition, SEEK_SET);
 		if (0 != status)
@@ -348,7 +493,7 @@ GAE_File_t* GAE_File_setBuffer(GAE_File_t* file, unsigned char* buffer, const un
 	return file;
 }
 
-GAE_File_t* GAE_FILE_newBuffer(GAE_File_t* file, const unsigned long size, GAE_BOOL* status) {
+GAE_File_t* GAE_File_newBuffer(GAE_File_t* file, const unsigned long size, GAE_BOOL* status) {
 	if (file->fileStatus == GAE_FILE_OPEN) {
 		if (0 != status)
 			*status = GAE_FALSE;
@@ -367,3 +512,32 @@ GAE_File_t* GAE_FILE_newBuffer(GAE_File_t* file, const unsigned long size, GAE_B
 		*status = GAE_TRUE;
 	return file;
 }
+
+GAE_BOOL openCompressed(GAE_File_t* file) {
+	GAE_PlatformFile_t* platform = (GAE_PlatformFile_t*)file->platformFile;
+	GAE_BYTE header[GAE_COMPRESSED_HEADER_SIZE];
+	GAE_BOOL isCompressed = GAE_FALSE;
+
+	if (GAE_COMPRESSED_HEADER_SIZE <= file->fileSize)
+		isCompressed = ((GAE_TRUE == readAt(platform, 0U, header, sizeof(header))) && (GAE_TRUE == GAE_Compressed_isHeader(header, sizeof(header)))) ? GAE_TRUE : GAE_FALSE;
+
+	if (GAE_FALSE == isCompressed) {
+		rewind(platform->file);
+		return GAE_TRUE;
+	}
+
+	platform->compressed = GAE_Compressed_create(readAt, platform, file->fileSize);
+	if (0 == platform->compressed)
+		return GAE_FALSE;
+
+	file->fileSize = platform->compressed->size;
+	return GAE_TRUE;
+}
+
+GAE_BOOL readAt(void* source, const unsigned long offset, GAE_BYTE* destination, const unsigned long amount) {
+	GAE_PlatformFile_t* platform = (GAE_PlatformFile_t*)source;
+
+	if (0 != fseek(platform->file, (long)offset, SEEK_SET))
+		return GAE_FALSE;
+	return (amount == (unsigned long)fread(destination, 1U, amount, platform->file)) ? GAE_TRUE : GAE_FALSE;
+}
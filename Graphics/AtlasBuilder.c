@@ -0,0 +1,406 @@
+#include "AtlasBuilder.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../Utils/Array.h"
+#include "../File/File.h"
+#include "../External/stb/stb_image.h"
+
+typedef struct GAE_AtlasBuilder_SkylineNode_s {
+	unsigned int x;
+	unsigned int y;
+	unsigned int width;
+} GAE_AtlasBuilder_SkylineNode_t;
+
+typedef struct GAE_AtlasBuilder_Image_s {
+	GAE_BYTE* data;
+	unsigned int width;
+	unsigned int height;
+} GAE_AtlasBuilder_Image_t;
+
+typedef struct GAE_AtlasBuilder_Order_s {
+	unsigned int id;
+	unsigned int width; /* including padding and extrusion */
+	unsigned int height;
+} GAE_AtlasBuilder_Order_t;
+
+static unsigned int nextPowerOfTwo(const unsigned int value);
+static int compareOrder(const void* a, const void* b);
+static void clearPages(GAE_AtlasBuilder_t* builder);
+static GAE_AtlasBuilder_Page_t* newPage(GAE_AtlasBuilder_t* builder);
+static GAE_BOOL findPosition(GAE_AtlasBuilder_t* builder, GAE_AtlasBuilder_Page_t* page, const unsigned int width, const unsigned int height, unsigned int* x, unsigned int* y, unsigned int* node);
+static unsigned int fitNode(GAE_AtlasBuilder_t* builder, GAE_AtlasBuilder_Page_t* page, const unsigned int index, const unsigned int width, const unsigned int height);
+static void addSkylineLevel(GAE_AtlasBuilder_Page_t* page, const unsigned int index, const unsigned int x, const unsigned int y, const unsigned int width, const unsigned int height);
+static void blitImage(GAE_AtlasBuilder_Page_t* page, GAE_AtlasBuilder_Image_t* image, GAE_AtlasBuilder_Rect_t* rect, const unsigned int extrude);
+
+GAE_AtlasBuilder_t* GAE_AtlasBuilder_create(const unsigned int maxPageSize, const unsigned int padding, const unsigned int extrude) {
+	GAE_AtlasBuilder_t* builder = malloc(sizeof(GAE_AtlasBuilder_t));
+
+	builder->maxPageSize = nextPowerOfTwo(maxPageSize);
+	builder->padding = padding;
+	builder->extrude = extrude;
+	builder->images = GAE_Array_create(sizeof(GAE_AtlasBuilder_Image_t));
+	builder->rects = GAE_Array_create(sizeof(GAE_AtlasBuilder_Rect_t));
+	builder->pages = GAE_Array_create(sizeof(GAE_AtlasBuilder_Page_t));
+
+	return builder;
+}
+
+unsigned int GAE_AtlasBuilder_addImage(GAE_AtlasBuilder_t* builder, const GAE_BYTE* const data, const unsigned int width, const unsigned int height) {
+	GAE_AtlasBuilder_Image_t image;
+	GAE_AtlasBuilder_Rect_t rect;
+	const unsigned int size = width * height * 4U;
+
+	if (0U == size)
+		return GAE_INVALID;
+
+	image.data = malloc(size);
+	memcpy(image.data, data, size);
+	image.width = width;
+	image.height = height;
+
+	memset(&rect, 0, sizeof(GAE_AtlasBuilder_Rect_t));
+	rect.width = width;
+	rect.height = height;
+	rect.isPacked = GAE_FALSE;
+
+	GAE_Array_push(builder->images, &image);
+	GAE_Array_push(builder->rects, &rect);
+
+	return GAE_Array_length(builder->images) - 1U;
+}
+
+unsigned int GAE_AtlasBuilder_addFile(GAE_AtlasBuilder_t* builder, GAE_File_t* const file) {
+	int width = 0;
+	int height = 0;
+	int channels = 0;
+	unsigned int id = GAE_INVALID;
+	unsigned char* data = 0;
+
+	if (0 == file->buffer)
+		return GAE_INVALID;
+
+	data = stbi_load_from_memory(file->buffer, (int)file->bufferSize, &width, &height, &channels, STBI_rgb_alpha);
+	if (0 == data)
+		return GAE_INVALID;
+
+	id = GAE_AtlasBuilder_addImage(builder, data, (unsigned int)width, (unsigned int)height);
+	stbi_image_free(data);
+
+	return id;
+}
+
+GAE_AtlasBuilder_t* GAE_AtlasBuilder_pack(GAE_AtlasBuilder_t* builder, GAE_BOOL* status) {
+	const unsigned int count = GAE_Array_length(builder->images);
+	const unsigned int border = builder->extrude * 2U;
+	GAE_AtlasBuilder_Order_t* order = 0;
+	GAE_BOOL allPacked = GAE_TRUE;
+	unsigned int index = 0U;
+	unsigned int pageIndex = 0U;
+
+	clearPages(builder);
+
+	if (0U == count) {
+		if (0 != status)
+			*status = GAE_TRUE;
+		return builder;
+	}
+
+	order = malloc(sizeof(GAE_AtlasBuilder_Order_t) * count);
+	for (index = 0U; index < count; ++index) {
+		GAE_AtlasBuilder_Image_t* image = GAE_Array_get(builder->images, index);
+		order[index].id = index;
+		order[index].width = image->width + border + builder->padding;
+		order[index].height = image->height + border + builder->padding;
+	}
+
+	/* tallest first keeps the skyline flat */
+	qsort(order, count, sizeof(GAE_AtlasBuilder_Order_t), compareOrder);
+
+	for (index = 0U; index < count; ++index) {
+		GAE_AtlasBuilder_Rect_t* rect = GAE_Array_get(builder->rects, order[index].id);
+		GAE_AtlasBuilder_Page_t* page = 0;
+		unsigned int x = 0U;
+		unsigned int y = 0U;
+		unsigned int node = 0U;
+
+		rect->isPacked = GAE_FALSE;
+
+		/* trailing padding may hang over the page edge, so only the image and its extrusion have to fit */
+		if ((order[index].width - builder->padding > builder->maxPageSize) || (order[index].height - builder->padding > builder->maxPageSize)) {
+			allPacked = GAE_FALSE;
+			continue;
+		}
+
+		for (pageIndex = 0U; pageIndex < GAE_Array_length(builder->pages); ++pageIndex) {
+			page = GAE_Array_get(builder->pages, pageIndex);
+			if (GAE_TRUE == findPosition(builder, page, order[index].width, order[index].height, &x, &y, &node))
+				break;
+			page = 0;
+		}
+
+		if (0 == page) {
+			page = newPage(builder);
+			pageIndex = GAE_Array_length(builder->pages) - 1U;
+			findPosition(builder, page, order[index].width, order[index].height, &x, &y, &node);
+		}
+
+		addSkylineLevel(page, node, x, y, order[index].width, order[index].height);
+
+		rect->page = pageIndex;
+		rect->x = x + builder->extrude;
+		rect->y = y + builder->extrude;
+		rect->isPacked = GAE_TRUE;
+
+		/* track the used extents so the page can be shrunk afterwards */
+		if (x + order[index].width - builder->padding > page->width)
+			page->width = x + order[index].width - builder->padding;
+		if (y + order[index].height - builder->padding > page->height)
+			page->height = y + order[index].height - builder->padding;
+	}
+
+	free(order);
+
+	for (pageIndex = 0U; pageIndex < GAE_Array_length(builder->pages); ++pageIndex) {
+		GAE_AtlasBuilder_Page_t* page = GAE_Array_get(builder->pages, pageIndex);
+
+		page->width = nextPowerOfTwo(page->width);
+		page->height = nextPowerOfTwo(page->height);
+		page->data = calloc(page->width * page->height, 4U);
+
+		free(page->skyline);
+		page->skyline = 0;
+		page->skylineLength = 0U;
+	}
+
+	for (index = 0U; index < count; ++index) {
+		GAE_AtlasBuilder_Rect_t* rect = GAE_Array_get(builder->rects, index);
+		GAE_AtlasBuilder_Page_t* page = 0;
+
+		if (GAE_FALSE == rect->isPacked)
+			continue;
+
+		page = GAE_Array_get(builder->pages, rect->page);
+		blitImage(page, GAE_Array_get(builder->images, index), rect, builder->extrude);
+
+		rect->uv[0] = (float)rect->x / (float)page->width;
+		rect->uv[1] = (float)rect->y / (float)page->height;
+		rect->uv[2] = (float)(rect->x + rect->width) / (float)page->width;
+		rect->uv[3] = (float)(rect->y + rect->height) / (float)page->height;
+	}
+
+	if (0 != status)
+		*status = allPacked;
+
+	return builder;
+}
+
+GAE_AtlasBuilder_Rect_t* GAE_AtlasBuilder_getRect(GAE_AtlasBuilder_t* builder, const unsigned int id) {
+	if (id >= GAE_Array_length(builder->rects))
+		return 0;
+
+	return GAE_Array_get(builder->rects, id);
+}
+
+unsigned int GAE_AtlasBuilder_getPageCount(GAE_AtlasBuilder_t* builder) {
+	return GAE_Array_length(builder->pages);
+}
+
+GAE_AtlasBuilder_Page_t* GAE_AtlasBuilder_getPage(GAE_AtlasBuilder_t* builder, const unsigned int page) {
+	if (page >= GAE_Array_length(builder->pages))
+		return 0;
+
+	return GAE_Array_get(builder->pages, page);
+}
+
+void GAE_AtlasBuilder_delete(GAE_AtlasBuilder_t* builder) {
+	GAE_AtlasBuilder_Image_t* image = GAE_Array_begin(builder->images);
+	GAE_AtlasBuilder_Image_t* end = GAE_Array_end(builder->images);
+
+	while (image != end) {
+		free(image->data);
+		++image;
+	}
+
+	clearPages(builder);
+
+	GAE_Array_delete(builder->images);
+	GAE_Array_delete(builder->rects);
+	GAE_Array_delete(builder->pages);
+	free(builder);
+	builder = 0;
+}
+
+unsigned int nextPowerOfTwo(const unsigned int value) {
+	unsigned int power = 1U;
+	while (power < value)
+		power <<= 1U;
+	return power;
+}
+
+int compareOrder(const void* a, const void* b) {
+	const GAE_AtlasBuilder_Order_t* lhs = (const GAE_AtlasBuilder_Order_t*)a;
+	const GAE_AtlasBuilder_Order_t* rhs = (const GAE_AtlasBuilder_Order_t*)b;
+
+	if (lhs->height != rhs->height)
+		return (lhs->height > rhs->height) ? -1 : 1;
+	if (lhs->width != rhs->width)
+		return (lhs->width > rhs->width) ? -1 : 1;
+	return (lhs->id < rhs->id) ? -1 : 1;
+}
+
+void clearPages(GAE_AtlasBuilder_t* builder) {
+	GAE_AtlasBuilder_Page_t* page = GAE_Array_begin(builder->pages);
+	GAE_AtlasBuilder_Page_t* end = GAE_Array_end(builder->pages);
+
+	while (page != end) {
+		free(page->data);
+		free(page->skyline);
+		++page;
+	}
+
+	builder->pages->used = 0U;
+}
+
+GAE_AtlasBuilder_Page_t* newPage(GAE_AtlasBuilder_t* builder) {
+	GAE_AtlasBuilder_Page_t page;
+
+	page.width = 0U;
+	page.height = 0U;
+	page.data = 0;
+	/* every node covers at least one pixel, so the skyline can never hold more nodes than the page is wide */
+	page.skyline = malloc(sizeof(GAE_AtlasBuilder_SkylineNode_t) * (builder->maxPageSize + builder->padding));
+	page.skyline[0].x = 0U;
+	page.skyline[0].y = 0U;
+	page.skyline[0].width = builder->maxPageSize + builder->padding;
+	page.skylineLength = 1U;
+
+	GAE_Array_push(builder->pages, &page);
+
+	return GAE_Array_get(builder->pages, GAE_Array_length(builder->pages) - 1U);
+}
+
+GAE_BOOL findPosition(GAE_AtlasBuilder_t* builder, GAE_AtlasBuilder_Page_t* page, const unsigned int width, const unsigned int height, unsigned int* x, unsigned int* y, unsigned int* node) {
+	unsigned int bestBottom = GAE_INVALID;
+	unsigned int bestWidth = GAE_INVALID;
+	unsigned int index = 0U;
+
+	/* bottom-left rule: lowest resulting edge wins, narrowest node breaks ties */
+	for (index = 0U; index < page->skylineLength; ++index) {
+		const unsigned int fitY = fitNode(builder, page, index, width, height);
+		if (GAE_INVALID == fitY)
+			continue;
+
+		if ((fitY + height < bestBottom) || ((fitY + height == bestBottom) && (page->skyline[index].width < bestWidth))) {
+			bestBottom = fitY + height;
+			bestWidth = page->skyline[index].width;
+			*x = page->skyline[index].x;
+			*y = fitY;
+			*node = index;
+		}
+	}
+
+	return (GAE_INVALID != bestBottom) ? GAE_TRUE : GAE_FALSE;
+}
+
+unsigned int fitNode(GAE_AtlasBuilder_t* builder, GAE_AtlasBuilder_Page_t* page, const unsigned int index, const unsigned int width, const unsigned int height) {
+	const unsigned int limit = builder->maxPageSize + builder->padding;
+	unsigned int x = page->skyline[index].x;
+	unsigned int y = 0U;
+	unsigned int remaining = width;
+	unsigned int current = index;
+
+	if (x + width > limit)
+		return GAE_INVALID;
+
+	while (remaining > 0U) {
+		if (page->skyline[current].y > y)
+			y = page->skyline[current].y;
+		if (y + height > limit)
+			return GAE_INVALID;
+		if (page->skyline[current].width >= remaining)
+			break;
+		remaining -= page->skyline[current].width;
+		++current;
+	}
+
+	return y;
+}
+
+void addSkylineLevel(GAE_AtlasBuilder_Page_t* page, const unsigned int index, const unsigned int x, const unsigned int y, const unsigned int width, const unsigned int height) {
+	GAE_AtlasBuilder_SkylineNode_t* nodes = page->skyline;
+	unsigned int current = 0U;
+
+	memmove(&nodes[index + 1U], &nodes[index], sizeof(GAE_AtlasBuilder_SkylineNode_t) * (page->skylineLength - index));
+	nodes[index].x = x;
+	nodes[index].y = y + height;
+	nodes[index].width = width;
+	++page->skylineLength;
+
+	/* trim or remove the nodes now covered by the new level */
+	current = index + 1U;
+	while (current < page->skylineLength) {
+		const unsigned int edge = nodes[current - 1U].x + nodes[current - 1U].width;
+		unsigned int shrink = 0U;
+
+		if (nodes[current].x >= edge)
+			break;
+
+		shrink = edge - nodes[current].x;
+		if (nodes[current].width > shrink) {
+			nodes[current].x += shrink;
+			nodes[current].width -= shrink;
+			break;
+		}
+
+		memmove(&nodes[current], &nodes[current + 1U], sizeof(GAE_AtlasBuilder_SkylineNode_t) * (page->skylineLength - current - 1U));
+		--page->skylineLength;
+	}
+
+	/* merge neighbouring nodes on the same level */
+	current = 0U;
+	while (current + 1U < page->skylineLength) {
+		if (nodes[current].y == nodes[current + 1U].y) {
+			nodes[current].width += nodes[current + 1U].width;
+			memmove(&nodes[current + 1U], &nodes[current + 2U], sizeof(GAE_AtlasBuilder_SkylineNode_t) * (page->skylineLength - current - 2U));
+			--page->skylineLength;
+		}
+		else
+			++current;
+	}
+}
+
+void blitImage(GAE_AtlasBuilder_Page_t* page, GAE_AtlasBuilder_Image_t* image, GAE_AtlasBuilder_Rect_t* rect, const unsigned int extrude) {
+	const unsigned int pitch = page->width * 4U;
+	const unsigned int rowSize = image->width * 4U;
+	const unsigned int left = rect->x - extrude;
+	const unsigned int top = rect->y - extrude;
+	const unsigned int rows = image->height + extrude * 2U;
+	unsigned int row = 0U;
+
+	for (row = 0U; row < rows; ++row) {
+		/* rows above and below repeat the first and last image row */
+		unsigned int sourceRow = 0U;
+		GAE_BYTE* source = 0;
+		GAE_BYTE* target = page->data + (top + row) * pitch + left * 4U;
+		unsigned int column = 0U;
+
+		if (row >= extrude)
+			sourceRow = (row - extrude < image->height) ? row - extrude : image->height - 1U;
+		source = image->data + sourceRow * rowSize;
+
+		for (column = 0U; column < extrude; ++column) {
+			memcpy(target, source, 4U);
+			target += 4U;
+		}
+
+		memcpy(target, source, rowSize);
+		target += rowSize;
+
+		for (column = 0U; column < extrude; ++column) {
+			memcpy(target, source + rowSize - 4U, 4U);
+			target += 4U;
+		}
+	}
+}
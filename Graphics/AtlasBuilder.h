@@ -0,0 +1,65 @@
+#ifndef _ATLAS_BUILDER_H_
+#define _ATLAS_BUILDER_H_
+
+#include "../GAE_Types.h"
+
+struct GAE_File_s;
+struct GAE_Array_s;
+struct GAE_Texture_s;
+struct GAE_AtlasBuilder_SkylineNode_s;
+
+typedef struct GAE_AtlasBuilder_Rect_s {
+	unsigned int page;
+	unsigned int x; /* in pixels, excluding padding and extrusion */
+	unsigned int y;
+	unsigned int width;
+	unsigned int height;
+	float uv[4]; /* 0 - u0, 1 - v0, 2 - u1, 3 - v1 */
+	GAE_BOOL isPacked;
+} GAE_AtlasBuilder_Rect_t;
+
+typedef struct GAE_AtlasBuilder_Page_s {
+	unsigned int width;
+	unsigned int height;
+	GAE_BYTE* data; /* RGBA8, width * height * 4 */
+	struct GAE_AtlasBuilder_SkylineNode_s* skyline;
+	unsigned int skylineLength;
+} GAE_AtlasBuilder_Page_t;
+
+typedef struct GAE_AtlasBuilder_s {
+	unsigned int maxPageSize; /* power of two */
+	unsigned int padding; /* empty pixels between images */
+	unsigned int extrude; /* edge pixels repeated around each image */
+	struct GAE_Array_s* images;
+	struct GAE_Array_s* rects;
+	struct GAE_Array_s* pages;
+} GAE_AtlasBuilder_t;
+
+/* Creates a new Atlas Builder - maxPageSize is rounded up to a power of two. */
+GAE_AtlasBuilder_t* GAE_AtlasBuilder_create(const unsigned int maxPageSize, const unsigned int padding, const unsigned int extrude);
+
+/* Copies RGBA8 pixels into the builder and returns the image id, or GAE_INVALID if empty - the data can be freed after this call. */
+unsigned int GAE_AtlasBuilder_addImage(GAE_AtlasBuilder_t* builder, const GAE_BYTE* const data, const unsigned int width, const unsigned int height);
+
+/* Decodes an image file already read into the file buffer and returns the image id, or GAE_INVALID on failure. */
+unsigned int GAE_AtlasBuilder_addFile(GAE_AtlasBuilder_t* builder, struct GAE_File_s* const file);
+
+/* Packs every added image into as few power of two pages as possible - status is false if any image did not fit. */
+GAE_AtlasBuilder_t* GAE_AtlasBuilder_pack(GAE_AtlasBuilder_t* builder, GAE_BOOL* status);
+
+/* Returns the packed rect for the image id. This element should NOT be freed after use. */
+GAE_AtlasBuilder_Rect_t* GAE_AtlasBuilder_getRect(GAE_AtlasBuilder_t* builder, const unsigned int id);
+
+/* Returns the amount of packed pages. */
+unsigned int GAE_AtlasBuilder_getPageCount(GAE_AtlasBuilder_t* builder);
+
+/* Returns the packed page. This element should NOT be freed after use. */
+GAE_AtlasBuilder_Page_t* GAE_AtlasBuilder_getPage(GAE_AtlasBuilder_t* builder, const unsigned int page);
+
+/* Creates an unloaded texture pointing at the page pixels - GAE_Texture_load uploads it with a single glTexImage2D while the builder is alive. */
+struct GAE_Texture_s* GAE_AtlasBuilder_createTexture(GAE_AtlasBuilder_t* builder, const unsigned int page);
+
+/* Deletes the Atlas Builder, its images and its pages. */
+void GAE_AtlasBuilder_delete(GAE_AtlasBuilder_t* builder);
+
+#endif
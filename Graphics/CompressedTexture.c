@@ -0,0 +1,338 @@
+#include "CompressedTexture.h"
+
+#include <string.h>
+
+static unsigned int readUint32(const GAE_BYTE* data);
+static GAE_BOOL parseDDS(GAE_CompressedTexture_t* texture, const GAE_BYTE* const buffer, const unsigned long size);
+static GAE_BOOL parseKTX(GAE_CompressedTexture_t* texture, const GAE_BYTE* const buffer, const unsigned long size);
+static void decodeColourBlock(const GAE_BYTE* block, GAE_BYTE colours[16][4], const GAE_BOOL hasPunchThrough);
+static void decodeAlphaBlock(const GAE_BYTE* block, GAE_BYTE colours[16][4]);
+static void decodeETC1Block(const GAE_BYTE* block, GAE_BYTE colours[16][4]);
+static GAE_BYTE clampColour(const int value);
+
+static const GAE_BYTE ktxIdentifier[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+
+static const int etc1Modifiers[8][4] = {
+	{ 2, 8, -2, -8 }
+,	{ 5, 17, -5, -17 }
+,	{ 9, 29, -9, -29 }
+,	{ 13, 42, -13, -42 }
+,	{ 18, 60, -18, -60 }
+,	{ 24, 80, -24, -80 }
+,	{ 33, 106, -33, -106 }
+,	{ 47, 183, -47, -183 }
+};
+
+GAE_BOOL GAE_CompressedTexture_parse(GAE_CompressedTexture_t* texture, const GAE_BYTE* const buffer, const unsigned long size) {
+	memset(texture, 0, sizeof(GAE_CompressedTexture_t));
+
+	if ((4UL <= size) && (0 == memcmp(buffer, "DDS ", 4U)))
+		return parseDDS(texture, buffer, size);
+
+	if ((sizeof(ktxIdentifier) <= size) && (0 == memcmp(buffer, ktxIdentifier, sizeof(ktxIdentifier))))
+		return parseKTX(texture, buffer, size);
+
+	return GAE_FALSE;
+}
+
+unsigned int GAE_CompressedTexture_getSize(const GAE_CompressedTexture_Format format, const unsigned int width, const unsigned int height) {
+	const unsigned int blocks = ((width + 3U) / 4U) * ((height + 3U) / 4U);
+
+	switch (format) {
+		case GAE_COMPRESSED_TEXTURE_FORMAT_DXT1:
+		case GAE_COMPRESSED_TEXTURE_FORMAT_ETC1:
+			return blocks * 8U;
+		case GAE_COMPRESSED_TEXTURE_FORMAT_DXT5:
+			return blocks * 16U;
+		case GAE_COMPRESSED_TEXTURE_FORMAT_INVALID:
+		default:
+			return 0U;
+	}
+}
+
+GAE_BOOL GAE_CompressedTexture_decode(GAE_CompressedTexture_t* texture, const unsigned int level, GAE_BYTE* rgba) {
+	GAE_CompressedTexture_Level_t* current = 0;
+	const GAE_BYTE* block = 0;
+	GAE_BYTE colours[16][4];
+	unsigned int blockX = 0U;
+	unsigned int blockY = 0U;
+
+	if (level >= texture->levelCount)
+		return GAE_FALSE;
+
+	current = &texture->levels[level];
+	block = current->data;
+
+	for (blockY = 0U; blockY < current->height; blockY += 4U) {
+		for (blockX = 0U; blockX < current->width; blockX += 4U) {
+			unsigned int x = 0U;
+			unsigned int y = 0U;
+
+			switch (texture->format) {
+				case GAE_COMPRESSED_TEXTURE_FORMAT_DXT1:
+					decodeColourBlock(block, colours, GAE_TRUE);
+					block += 8U;
+					break;
+				case GAE_COMPRESSED_TEXTURE_FORMAT_DXT5:
+					decodeColourBlock(block + 8U, colours, GAE_FALSE);
+					decodeAlphaBlock(block, colours);
+					block += 16U;
+					break;
+				case GAE_COMPRESSED_TEXTURE_FORMAT_ETC1:
+					decodeETC1Block(block, colours);
+					block += 8U;
+					break;
+				case GAE_COMPRESSED_TEXTURE_FORMAT_INVALID:
+				default:
+					return GAE_FALSE;
+			}
+
+			/* edge blocks of non multiple of 4 levels are clipped */
+			for (y = 0U; (y < 4U) && (blockY + y < current->height); ++y) {
+				for (x = 0U; (x < 4U) && (blockX + x < current->width); ++x)
+					memcpy(rgba + ((blockY + y) * current->width + blockX + x) * 4U, colours[y * 4U + x], 4U);
+			}
+		}
+	}
+
+	return GAE_TRUE;
+}
+
+unsigned int readUint32(const GAE_BYTE* data) {
+	return (unsigned int)data[0] | ((unsigned int)data[1] << 8U) | ((unsigned int)data[2] << 16U) | ((unsigned int)data[3] << 24U);
+}
+
+GAE_BOOL parseDDS(GAE_CompressedTexture_t* texture, const GAE_BYTE* const buffer, const unsigned long size) {
+	const unsigned int headerSize = 128U;
+	const unsigned int ddpfFourCC = 0x4U;
+	unsigned long offset = headerSize;
+	unsigned int level = 0U;
+
+	if ((size < headerSize) || (124U != readUint32(buffer + 4U)))
+		return GAE_FALSE;
+
+	if (0U == (readUint32(buffer + 80U) & ddpfFourCC))
+		return GAE_FALSE;
+
+	if (0 == memcmp(buffer + 84U, "DXT1", 4U))
+		texture->format = GAE_COMPRESSED_TEXTURE_FORMAT_DXT1;
+	else if (0 == memcmp(buffer + 84U, "DXT5", 4U))
+		texture->format = GAE_COMPRESSED_TEXTURE_FORMAT_DXT5;
+	else if (0 == memcmp(buffer + 84U, "ETC1", 4U))
+		texture->format = GAE_COMPRESSED_TEXTURE_FORMAT_ETC1;
+	else
+		return GAE_FALSE;
+
+	texture->container = GAE_COMPRESSED_TEXTURE_CONTAINER_DDS;
+	texture->height = readUint32(buffer + 12U);
+	texture->width = readUint32(buffer + 16U);
+	texture->levelCount = readUint32(buffer + 28U);
+	if (0U == texture->levelCount)
+		texture->levelCount = 1U;
+	if (GAE_COMPRESSED_TEXTURE_MAX_LEVELS < texture->levelCount)
+		texture->levelCount = GAE_COMPRESSED_TEXTURE_MAX_LEVELS;
+
+	if ((0U == texture->width) || (0U == texture->height))
+		return GAE_FALSE;
+
+	/* DDS levels are tightly packed one after another */
+	for (level = 0U; level < texture->levelCount; ++level) {
+		GAE_CompressedTexture_Level_t* current = &texture->levels[level];
+
+		current->width = (0U < (texture->width >> level)) ? texture->width >> level : 1U;
+		current->height = (0U < (texture->height >> level)) ? texture->height >> level : 1U;
+		current->size = GAE_CompressedTexture_getSize(texture->format, current->width, current->height);
+		current->data = buffer + offset;
+
+		if (offset + current->size > size)
+			return GAE_FALSE;
+		offset += current->size;
+	}
+
+	return GAE_TRUE;
+}
+
+GAE_BOOL parseKTX(GAE_CompressedTexture_t* texture, const GAE_BYTE* const buffer, const unsigned long size) {
+	const unsigned int headerSize = 64U;
+	unsigned long offset = headerSize;
+	unsigned int level = 0U;
+
+	/* only little endian files with a single 2D face are supported */
+	if ((size < headerSize) || (0x04030201U != readUint32(buffer + 12U)))
+		return GAE_FALSE;
+
+	if ((0U != readUint32(buffer + 44U)) || (0U != readUint32(buffer + 48U)) || (1U != readUint32(buffer + 52U)))
+		return GAE_FALSE;
+
+	switch (readUint32(buffer + 28U)) {
+		case 0x83F0U: /* GL_COMPRESSED_RGB_S3TC_DXT1_EXT */
+		case 0x83F1U: /* GL_COMPRESSED_RGBA_S3TC_DXT1_EXT */
+			texture->format = GAE_COMPRESSED_TEXTURE_FORMAT_DXT1;
+			break;
+		case 0x83F3U: /* GL_COMPRESSED_RGBA_S3TC_DXT5_EXT */
+			texture->format = GAE_COMPRESSED_TEXTURE_FORMAT_DXT5;
+			break;
+		case 0x8D64U: /* GL_ETC1_RGB8_OES */
+			texture->format = GAE_COMPRESSED_TEXTURE_FORMAT_ETC1;
+			break;
+		default:
+			return GAE_FALSE;
+	}
+
+	texture->container = GAE_COMPRESSED_TEXTURE_CONTAINER_KTX;
+	texture->width = readUint32(buffer + 36U);
+	texture->height = readUint32(buffer + 40U);
+	texture->levelCount = readUint32(buffer + 56U);
+	if (0U == texture->levelCount)
+		texture->levelCount = 1U;
+	if (GAE_COMPRESSED_TEXTURE_MAX_LEVELS < texture->levelCount)
+		texture->levelCount = GAE_COMPRESSED_TEXTURE_MAX_LEVELS;
+
+	if ((0U == texture->width) || (0U == texture->height))
+		return GAE_FALSE;
+
+	offset += readUint32(buffer + 60U); /* skip the key value data */
+
+	/* every KTX level is prefixed with its size and padded to 4 bytes */
+	for (level = 0U; level < texture->levelCount; ++level) {
+		GAE_CompressedTexture_Level_t* current = &texture->levels[level];
+
+		if (offset + 4U > size)
+			return GAE_FALSE;
+
+		current->width = (0U < (texture->width >> level)) ? texture->width >> level : 1U;
+		current->height = (0U < (texture->height >> level)) ? texture->height >> level : 1U;
+		current->size = readUint32(buffer + offset);
+		current->data = buffer + offset + 4U;
+
+		if ((current->size != GAE_CompressedTexture_getSize(texture->format, current->width, current->height)) || (offset + 4U + current->size > size))
+			return GAE_FALSE;
+
+		offset += 4U + ((current->size + 3U) & ~3U);
+	}
+
+	return GAE_TRUE;
+}
+
+void decodeColourBlock(const GAE_BYTE* block, GAE_BYTE colours[16][4], const GAE_BOOL hasPunchThrough) {
+	const unsigned int colour0 = (unsigned int)block[0] | ((unsigned int)block[1] << 8U);
+	const unsigned int colour1 = (unsigned int)block[2] | ((unsigned int)block[3] << 8U);
+	const unsigned int indices = readUint32(block + 4U);
+	unsigned int palette[4][4];
+	unsigned int channel = 0U;
+	unsigned int pixel = 0U;
+
+	/* expand 565 to 888 */
+	palette[0][0] = ((colour0 >> 11U) & 0x1FU) * 255U / 31U;
+	palette[0][1] = ((colour0 >> 5U) & 0x3FU) * 255U / 63U;
+	palette[0][2] = (colour0 & 0x1FU) * 255U / 31U;
+	palette[0][3] = 255U;
+	palette[1][0] = ((colour1 >> 11U) & 0x1FU) * 255U / 31U;
+	palette[1][1] = ((colour1 >> 5U) & 0x3FU) * 255U / 63U;
+	palette[1][2] = (colour1 & 0x1FU) * 255U / 31U;
+	palette[1][3] = 255U;
+
+	if ((GAE_FALSE == hasPunchThrough) || (colour0 > colour1)) {
+		for (channel = 0U; channel < 3U; ++channel) {
+			palette[2][channel] = (2U * palette[0][channel] + palette[1][channel]) / 3U;
+			palette[3][channel] = (palette[0][channel] + 2U * palette[1][channel]) / 3U;
+		}
+		palette[2][3] = 255U;
+		palette[3][3] = 255U;
+	}
+	else {
+		for (channel = 0U; channel < 3U; ++channel) {
+			palette[2][channel] = (palette[0][channel] + palette[1][channel]) / 2U;
+			palette[3][channel] = 0U;
+		}
+		palette[2][3] = 255U;
+		palette[3][3] = 0U;
+	}
+
+	for (pixel = 0U; pixel < 16U; ++pixel) {
+		const unsigned int index = (indices >> (pixel * 2U)) & 0x3U;
+		for (channel = 0U; channel < 4U; ++channel)
+			colours[pixel][channel] = (GAE_BYTE)palette[index][channel];
+	}
+}
+
+void decodeAlphaBlock(const GAE_BYTE* block, GAE_BYTE colours[16][4]) {
+	unsigned int alphas[8];
+	unsigned int index = 0U;
+	unsigned int pixel = 0U;
+	/* 16 3-bit indices packed little endian into the last 6 bytes, 8 pixels per 3 bytes */
+	const unsigned int bits[2] = {
+		(unsigned int)block[2] | ((unsigned int)block[3] << 8U) | ((unsigned int)block[4] << 16U)
+	,	(unsigned int)block[5] | ((unsigned int)block[6] << 8U) | ((unsigned int)block[7] << 16U) };
+
+	alphas[0] = block[0];
+	alphas[1] = block[1];
+
+	if (alphas[0] > alphas[1]) {
+		for (index = 1U; index < 7U; ++index)
+			alphas[index + 1U] = ((7U - index) * alphas[0] + index * alphas[1]) / 7U;
+	}
+	else {
+		for (index = 1U; index < 5U; ++index)
+			alphas[index + 1U] = ((5U - index) * alphas[0] + index * alphas[1]) / 5U;
+		alphas[6] = 0U;
+		alphas[7] = 255U;
+	}
+
+	for (pixel = 0U; pixel < 16U; ++pixel)
+		colours[pixel][3] = (GAE_BYTE)alphas[(bits[pixel / 8U] >> ((pixel % 8U) * 3U)) & 0x7U];
+}
+
+void decodeETC1Block(const GAE_BYTE* block, GAE_BYTE colours[16][4]) {
+	const GAE_BOOL isDifferential = (0U != (block[3] & 0x2U)) ? GAE_TRUE : GAE_FALSE;
+	const GAE_BOOL isFlipped = (0U != (block[3] & 0x1U)) ? GAE_TRUE : GAE_FALSE;
+	const unsigned int tables[2] = { (block[3] >> 5U) & 0x7U, (block[3] >> 2U) & 0x7U };
+	const unsigned int msb = ((unsigned int)block[4] << 8U) | block[5];
+	const unsigned int lsb = ((unsigned int)block[6] << 8U) | block[7];
+	int bases[2][3];
+	unsigned int channel = 0U;
+	unsigned int x = 0U;
+	unsigned int y = 0U;
+
+	for (channel = 0U; channel < 3U; ++channel) {
+		if (GAE_TRUE == isDifferential) {
+			/* 5 bit base with a signed 3 bit delta for the second sub block */
+			const int base = block[channel] >> 3U;
+			int delta = block[channel] & 0x7;
+			if (3 < delta)
+				delta -= 8;
+			bases[0][channel] = (base << 3) | (base >> 2);
+			bases[1][channel] = (((base + delta) & 0x1F) << 3) | (((base + delta) & 0x1F) >> 2);
+		}
+		else {
+			const int first = block[channel] >> 4U;
+			const int second = block[channel] & 0xF;
+			bases[0][channel] = (first << 4) | first;
+			bases[1][channel] = (second << 4) | second;
+		}
+	}
+
+	/* pixel indices are stored column major */
+	for (x = 0U; x < 4U; ++x) {
+		for (y = 0U; y < 4U; ++y) {
+			const unsigned int bit = x * 4U + y;
+			const unsigned int subBlock = (GAE_TRUE == isFlipped) ? ((2U <= y) ? 1U : 0U) : ((2U <= x) ? 1U : 0U);
+			const unsigned int index = (((msb >> bit) & 0x1U) << 1U) | ((lsb >> bit) & 0x1U);
+			const int modifier = etc1Modifiers[tables[subBlock]][index];
+			GAE_BYTE* pixel = colours[y * 4U + x];
+
+			pixel[0] = clampColour(bases[subBlock][0] + modifier);
+			pixel[1] = clampColour(bases[subBlock][1] + modifier);
+			pixel[2] = clampColour(bases[subBlock][2] + modifier);
+			pixel[3] = 255U;
+		}
+	}
+}
+
+GAE_BYTE clampColour(const int value) {
+	if (0 > value)
+		return 0U;
+	if (255 < value)
+		return 255U;
+	return (GAE_BYTE)value;
+}
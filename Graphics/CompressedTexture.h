@@ -0,0 +1,45 @@
+#ifndef _COMPRESSED_TEXTURE_H_
+#define _COMPRESSED_TEXTURE_H_
+
+#include "../GAE_Types.h"
+
+#define GAE_COMPRESSED_TEXTURE_MAX_LEVELS 16U
+
+typedef enum GAE_CompressedTexture_Format_e {
+	GAE_COMPRESSED_TEXTURE_FORMAT_INVALID
+,	GAE_COMPRESSED_TEXTURE_FORMAT_DXT1
+,	GAE_COMPRESSED_TEXTURE_FORMAT_DXT5
+,	GAE_COMPRESSED_TEXTURE_FORMAT_ETC1
+} GAE_CompressedTexture_Format;
+
+typedef enum GAE_CompressedTexture_Container_e {
+	GAE_COMPRESSED_TEXTURE_CONTAINER_DDS
+,	GAE_COMPRESSED_TEXTURE_CONTAINER_KTX
+} GAE_CompressedTexture_Container;
+
+typedef struct GAE_CompressedTexture_Level_s {
+	const GAE_BYTE* data; /* points into the container buffer */
+	unsigned int size;
+	unsigned int width;
+	unsigned int height;
+} GAE_CompressedTexture_Level_t;
+
+typedef struct GAE_CompressedTexture_s {
+	GAE_CompressedTexture_Format format;
+	GAE_CompressedTexture_Container container;
+	unsigned int width;
+	unsigned int height;
+	unsigned int levelCount;
+	GAE_CompressedTexture_Level_t levels[GAE_COMPRESSED_TEXTURE_MAX_LEVELS];
+} GAE_CompressedTexture_t;
+
+/* Parses a DDS or KTX container held in memory - the levels point into the buffer, so it must outlive the texture. */
+GAE_BOOL GAE_CompressedTexture_parse(GAE_CompressedTexture_t* texture, const GAE_BYTE* const buffer, const unsigned long size);
+
+/* Returns the size in bytes of a width x height image in the given format. */
+unsigned int GAE_CompressedTexture_getSize(const GAE_CompressedTexture_Format format, const unsigned int width, const unsigned int height);
+
+/* Decodes a level into width * height RGBA8 pixels - used when the GPU lacks the format. */
+GAE_BOOL GAE_CompressedTexture_decode(GAE_CompressedTexture_t* texture, const unsigned int level, GAE_BYTE* rgba);
+
+#endif
@@ -67,12 +67,15 @@ GAE_RenderContext_t* GAE_RenderContext_shutdown(GAE_RenderContext_t* context) {
 
 GAE_RenderContext_t* GAE_RenderContext_update(GAE_RenderContext_t* context) {
 	GAE_X11_RenderWindow_t* x11Window = (GAE_X11_RenderWindow_t*)context->window->platform;
+	/* the clear needs the whole screen, but the scissor test is put back as it was so the render state's shadow of it holds */
+	const GLboolean isScissorEnabled = glIsEnabled(GL_SCISSOR_TEST);
 	glDisable(GL_SCISSOR_TEST);
 	
 	glXSwapBuffers(x11Window->display, x11Window->window);
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 	
-	glEnable(GL_SCISSOR_TEST);
+	if (GL_FALSE != isScissorEnabled)
+		glEnable(GL_SCISSOR_TEST);
 
 	return context;
 }
@@ -0,0 +1,1858 @@
+#include "MockGL.h"
+
+#include "../../../Utils/Array.h"
+
+#include <assert.h>
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define GAE_MOCKGL_TEXTURE_UNITS 8U
+#define GAE_MOCKGL_VERTEX_ATTRIBS 16U
+#define GAE_MOCKGL_MAX_VARIABLES 32U
+#define GAE_MOCKGL_MAX_NAME 64U
+#define GAE_MOCKGL_PROGRAM_BINARY_FORMAT 0x4D4F434BU
+#define GAE_MOCKGL_PROGRAM_BINARY_HEADER (4U + GAE_MOCKGL_MAX_NAME + 8U)
+#define GAE_MOCKGL_TEXTURE_LEVELS 16U
+
+typedef struct GAE_MockGL_Buffer_s {
+	GAE_BOOL isAlive;
+	GLsizeiptr size;
+	GLenum usage;
+} GAE_MockGL_Buffer_t;
+
+typedef struct GAE_MockGL_Texture_s {
+	GAE_BOOL isAlive;
+	GLsizei width;
+	GLsizei height;
+	GLint internalFormat;
+	GLint minFilter;
+	GLint magFilter;
+	GAE_BOOL hasMipmaps;
+	GAE_BYTE* images[GAE_MOCKGL_TEXTURE_LEVELS];	/* copies of each level as uploaded, only while images are kept */
+	unsigned long imageSizes[GAE_MOCKGL_TEXTURE_LEVELS];
+	GLenum imageFormats[GAE_MOCKGL_TEXTURE_LEVELS];
+} GAE_MockGL_Texture_t;
+
+typedef struct GAE_MockGL_Shader_s {
+	GAE_BOOL isAlive;
+	GLenum type;
+	char* source;
+	GAE_BOOL isCompiled;
+} GAE_MockGL_Shader_t;
+
+typedef struct GAE_MockGL_Variable_s {
+	char name[GAE_MOCKGL_MAX_NAME];
+	GLenum type;
+	GLint size;
+} GAE_MockGL_Variable_t;
+
+typedef struct GAE_MockGL_Program_s {
+	GAE_BOOL isAlive;
+	GAE_BOOL isDeletePending;	/* deleted while in use - it goes, name and all, once another program replaces it */
+	GAE_BOOL isLinked;
+	GLuint vertex;
+	GLuint fragment;
+	GAE_MockGL_Variable_t attributes[GAE_MOCKGL_MAX_VARIABLES];
+	unsigned int attributeCount;
+	GAE_MockGL_Variable_t uniforms[GAE_MOCKGL_MAX_VARIABLES];
+	unsigned int uniformCount;
+} GAE_MockGL_Program_t;
+
+typedef struct GAE_MockGL_Object_s {
+	GAE_BOOL isAlive;
+} GAE_MockGL_Object_t;
+
+typedef struct GAE_MockGL_s {
+	GAE_Array_t* buffers;
+	GAE_Array_t* textures;
+	GAE_Array_t* shaders;
+	GAE_Array_t* programs;
+	GAE_Array_t* framebuffers;
+	GAE_Array_t* renderbuffers;
+	GAE_Array_t* commandLog;
+
+	GLuint arrayBuffer;
+	GLuint elementBuffer;
+	GLuint program;
+	GLuint framebuffer;
+	GLuint renderbuffer;
+	GLenum activeTexture;
+	GLuint boundTextures[GAE_MOCKGL_TEXTURE_UNITS];
+	GAE_BOOL enabledAttributes[GAE_MOCKGL_VERTEX_ATTRIBS];
+
+	GAE_BOOL isBlendEnabled;
+	GAE_BOOL isDepthTestEnabled;
+	GAE_BOOL isCullFaceEnabled;
+	GAE_BOOL isScissorTestEnabled;
+	GAE_BOOL isTexture2DEnabled;
+	GLenum blendFunc[4]; /* 0 - src RGB, 1 - dst RGB, 2 - src Alpha, 3 - dst Alpha */
+	GLenum blendEquation;
+	GLenum depthFunc;
+	GAE_BOOL isDepthWriteEnabled;
+	GLenum cullFace;
+	GLenum frontFace;
+	GLint viewport[4];
+	GLint scissor[4];
+	GLint unpackAlignment;
+	GLenum error;
+
+	GAE_BOOL isRecording;
+	GAE_BOOL isKeepingImages;
+	const char* extensions;
+	const char* renderer;
+	unsigned int compileTime;
+
+	GAE_MockGL_Stats_t frame;
+	GAE_MockGL_Stats_t lastFrame;
+	GAE_MockGL_Stats_t total;
+} GAE_MockGL_t;
+
+static GAE_MockGL_t mockGL;
+static GAE_BOOL isInitialised = GAE_FALSE;
+
+static void initialise(void);
+static void record(const GAE_MockGL_CommandType type, const unsigned int a, const unsigned int b, const unsigned int c, const unsigned int d);
+static void setError(const GLenum error);
+static void countStateChange(void);
+static void countBufferBytes(const unsigned long bytes);
+static void countTextureBytes(const unsigned long bytes);
+static void countDraw(const unsigned int vertices);
+static void countCompile(void);
+static GAE_BOOL hasExtension(const char* extension);
+static GLuint genObject(GAE_Array_t* objects, void* const object);
+static void* getObject(GAE_Array_t* objects, const GLuint name);
+static GAE_BOOL isNameValid(GAE_Array_t* objects, const GLuint name);
+static GAE_MockGL_Buffer_t* getBoundBuffer(const GLenum target);
+static unsigned long imageSize(const GLsizei width, const GLsizei height, const GLenum format, const GLenum type);
+static void keepImage(GAE_MockGL_Texture_t* texture, const GLint level, const GLenum format, const GLvoid* data, const unsigned long size);
+static void dropImages(GAE_MockGL_Texture_t* texture, const GLint firstLevel);
+static void parseVariables(const char* source, const char* qualifier, GAE_MockGL_Variable_t* variables, unsigned int* count);
+static GLenum typeFromName(const char* name, const unsigned int length);
+
+void initialise(void) {
+	unsigned int index = 0U;
+
+	if (GAE_TRUE == isInitialised)
+		return;
+
+	memset(&mockGL, 0, sizeof(GAE_MockGL_t));
+	mockGL.buffers = GAE_Array_create(sizeof(GAE_MockGL_Buffer_t));
+	mockGL.textures = GAE_Array_create(sizeof(GAE_MockGL_Texture_t));
+	mockGL.shaders = GAE_Array_create(sizeof(GAE_MockGL_Shader_t));
+	mockGL.programs = GAE_Array_create(sizeof(GAE_MockGL_Program_t));
+	mockGL.framebuffers = GAE_Array_create(sizeof(GAE_MockGL_Object_t));
+	mockGL.renderbuffers = GAE_Array_create(sizeof(GAE_MockGL_Object_t));
+	mockGL.commandLog = GAE_Array_create(sizeof(GAE_MockGL_Command_t));
+
+	mockGL.activeTexture = GL_TEXTURE0;
+	for (index = 0U; index < GAE_MOCKGL_TEXTURE_UNITS; ++index)
+		mockGL.boundTextures[index] = 0U;
+
+	mockGL.blendFunc[0] = GL_ONE;
+	mockGL.blendFunc[1] = GL_ZERO;
+	mockGL.blendFunc[2] = GL_ONE;
+	mockGL.blendFunc[3] = GL_ZERO;
+	mockGL.blendEquation = GL_FUNC_ADD;
+	mockGL.depthFunc = GL_LESS;
+	mockGL.isDepthWriteEnabled = GAE_TRUE;
+	mockGL.cullFace = GL_BACK;
+	mockGL.frontFace = GL_CCW;
+	mockGL.unpackAlignment = 4;
+	mockGL.error = GL_NO_ERROR;
+	mockGL.isRecording = GAE_TRUE;
+	mockGL.extensions = "";
+	mockGL.renderer = "GLESGAE MockGL";
+	mockGL.compileTime = 0U;
+
+	isInitialised = GAE_TRUE;
+}
+
+void GAE_MockGL_reset(void) {
+	GAE_MockGL_Shader_t* shader = 0;
+	GAE_MockGL_Texture_t* texture = 0;
+	GAE_BOOL isRecording = GAE_TRUE;
+	GAE_BOOL isKeepingImages = GAE_FALSE;
+	const char* extensions = "";
+	const char* renderer = "GLESGAE MockGL";
+	unsigned int compileTime = 0U;
+
+	if (GAE_TRUE == isInitialised) {
+		isRecording = mockGL.isRecording;
+		isKeepingImages = mockGL.isKeepingImages;
+		extensions = mockGL.extensions;
+		renderer = mockGL.renderer;
+		compileTime = mockGL.compileTime;
+
+		for (shader = (GAE_MockGL_Shader_t*)GAE_Array_begin(mockGL.shaders); shader < (GAE_MockGL_Shader_t*)GAE_Array_end(mockGL.shaders); ++shader)
+			free(shader->source);
+		for (texture = (GAE_MockGL_Texture_t*)GAE_Array_begin(mockGL.textures); texture < (GAE_MockGL_Texture_t*)GAE_Array_end(mockGL.textures); ++texture)
+			dropImages(texture, 0);
+
+		GAE_Array_delete(mockGL.buffers);
+		GAE_Array_delete(mockGL.textures);
+		GAE_Array_delete(mockGL.shaders);
+		GAE_Array_delete(mockGL.programs);
+		GAE_Array_delete(mockGL.framebuffers);
+		GAE_Array_delete(mockGL.renderbuffers);
+		GAE_Array_delete(mockGL.commandLog);
+		isInitialised = GAE_FALSE;
+	}
+
+	initialise();
+	mockGL.isRecording = isRecording;
+	mockGL.isKeepingImages = isKeepingImages;
+	mockGL.extensions = extensions;
+	mockGL.renderer = renderer;
+	mockGL.compileTime = compileTime;
+}
+
+void GAE_MockGL_endFrame(void) {
+	initialise();
+	mockGL.lastFrame = mockGL.frame;
+	memset(&mockGL.frame, 0, sizeof(GAE_MockGL_Stats_t));
+	mockGL.commandLog->used = 0U;
+}
+
+GAE_MockGL_Stats_t* GAE_MockGL_getFrameStats(void) {
+	initialise();
+	return &mockGL.frame;
+}
+
+GAE_MockGL_Stats_t* GAE_MockGL_getLastFrameStats(void) {
+	initialise();
+	return &mockGL.lastFrame;
+}
+
+GAE_MockGL_Stats_t* GAE_MockGL_getTotalStats(void) {
+	initialise();
+	return &mockGL.total;
+}
+
+GAE_Array_t* GAE_MockGL_getCommandLog(void) {
+	initialise();
+	return mockGL.commandLog;
+}
+
+void GAE_MockGL_setRecording(const GAE_BOOL isRecording) {
+	initialise();
+	mockGL.isRecording = isRecording;
+}
+
+void GAE_MockGL_setKeepingImages(const GAE_BOOL isKeepingImages) {
+	initialise();
+	mockGL.isKeepingImages = isKeepingImages;
+}
+
+const GAE_BYTE* GAE_MockGL_getTextureImage(const GLuint name, const GLint level, GLenum* format, unsigned long* size) {
+	GAE_MockGL_Texture_t* texture = 0;
+
+	initialise();
+	texture = (GAE_MockGL_Texture_t*)getObject(mockGL.textures, name);
+	if ((0 == texture) || (0 > level) || (GAE_MOCKGL_TEXTURE_LEVELS <= (unsigned int)level) || (0 == texture->images[level]))
+		return 0;
+
+	if (0 != format)
+		*format = texture->imageFormats[level];
+	if (0 != size)
+		*size = texture->imageSizes[level];
+	return texture->images[level];
+}
+
+void GAE_MockGL_setExtensions(const char* extensions) {
+	initialise();
+	mockGL.extensions = (0 != extensions) ? extensions : "";
+}
+
+void GAE_MockGL_setRenderer(const char* renderer) {
+	initialise();
+	mockGL.renderer = (0 != renderer) ? renderer : "GLESGAE MockGL";
+}
+
+void GAE_MockGL_setCompileTime(const unsigned int microseconds) {
+	initialise();
+	mockGL.compileTime = microseconds;
+}
+
+/* Buffers */
+void glGenBuffers(GLsizei n, GLuint* buffers) {
+	GAE_MockGL_Buffer_t buffer;
+	GLsizei index = 0;
+
+	initialise();
+	buffer.isAlive = GAE_TRUE;
+	buffer.size = 0;
+	buffer.usage = GL_STATIC_DRAW;
+
+	for (index = 0; index < n; ++index) {
+		buffers[index] = genObject(mockGL.buffers, &buffer);
+		record(GAE_MOCKGL_COMMAND_GEN_BUFFER, buffers[index], 0U, 0U, 0U);
+	}
+}
+
+void glDeleteBuffers(GLsizei n, const GLuint* buffers) {
+	GAE_MockGL_Buffer_t* buffer = 0;
+	GLsizei index = 0;
+
+	initialise();
+	for (index = 0; index < n; ++index) {
+		buffer = (GAE_MockGL_Buffer_t*)getObject(mockGL.buffers, buffers[index]);
+		if (0 == buffer)
+			continue;
+
+		buffer->isAlive = GAE_FALSE;
+		if (mockGL.arrayBuffer == buffers[index])
+			mockGL.arrayBuffer = 0U;
+		if (mockGL.elementBuffer == buffers[index])
+			mockGL.elementBuffer = 0U;
+		record(GAE_MOCKGL_COMMAND_DELETE_BUFFER, buffers[index], 0U, 0U, 0U);
+	}
+}
+
+GLboolean glIsBuffer(GLuint buffer) {
+	initialise();
+	return (0 != getObject(mockGL.buffers, buffer)) ? GL_TRUE : GL_FALSE;
+}
+
+void glBindBuffer(GLenum target, GLuint buffer) {
+	initialise();
+	if (GAE_FALSE == isNameValid(mockGL.buffers, buffer)) {
+		setError(GL_INVALID_OPERATION);
+		return;
+	}
+
+	switch (target) {
+		case GL_ARRAY_BUFFER:
+			mockGL.arrayBuffer = buffer;
+			break;
+		case GL_ELEMENT_ARRAY_BUFFER:
+			mockGL.elementBuffer = buffer;
+			break;
+		default:
+			setError(GL_INVALID_ENUM);
+			return;
+	};
+
+	countStateChange();
+	record(GAE_MOCKGL_COMMAND_BIND_BUFFER, target, buffer, 0U, 0U);
+}
+
+void glBufferData(GLenum target, GLsizeiptr size, const GLvoid* data, GLenum usage) {
+	GAE_MockGL_Buffer_t* buffer = 0;
+
+	initialise();
+	buffer = getBoundBuffer(target);
+	if (0 == buffer) {
+		setError(GL_INVALID_OPERATION);
+		return;
+	}
+
+	buffer->size = size;
+	buffer->usage = usage;
+	if (0 != data)
+		countBufferBytes((unsigned long)size);
+	record(GAE_MOCKGL_COMMAND_BUFFER_DATA, target, (unsigned int)size, usage, 0U);
+}
+
+void glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const GLvoid* data) {
+	GAE_MockGL_Buffer_t* buffer = 0;
+
+	initialise();
+	buffer = getBoundBuffer(target);
+	if (0 == buffer) {
+		setError(GL_INVALID_OPERATION);
+		return;
+	}
+
+	if ((offset < 0) || (size < 0) || ((offset + size) > buffer->size)) {
+		setError(GL_INVALID_VALUE);
+		return;
+	}
+
+	if (0 != data)
+		countBufferBytes((unsigned long)size);
+	record(GAE_MOCKGL_COMMAND_BUFFER_SUB_DATA, target, (unsigned int)offset, (unsigned int)size, 0U);
+}
+
+/* Vertex Attributes and Drawing */
+void glVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const GLvoid* pointer) {
+	GAE_UNUSED(normalized);
+	GAE_UNUSED(pointer);
+
+	initialise();
+	if ((GAE_MOCKGL_VERTEX_ATTRIBS <= index) || (1 > size) || (4 < size)) {
+		setError(GL_INVALID_VALUE);
+		return;
+	}
+
+	countStateChange();
+	record(GAE_MOCKGL_COMMAND_VERTEX_ATTRIB_POINTER, index, (unsigned int)size, type, (unsigned int)stride);
+}
+
+void glEnableVertexAttribArray(GLuint index) {
+	initialise();
+	if (GAE_MOCKGL_VERTEX_ATTRIBS <= index) {
+		setError(GL_INVALID_VALUE);
+		return;
+	}
+
+	mockGL.enabledAttributes[index] = GAE_TRUE;
+	countStateChange();
+	record(GAE_MOCKGL_COMMAND_ENABLE_VERTEX_ATTRIB, index, 0U, 0U, 0U);
+}
+
+void glDisableVertexAttribArray(GLuint index) {
+	initialise();
+	if (GAE_MOCKGL_VERTEX_ATTRIBS <= index) {
+		setError(GL_INVALID_VALUE);
+		return;
+	}
+
+	mockGL.enabledAttributes[index] = GAE_FALSE;
+	countStateChange();
+	record(GAE_MOCKGL_COMMAND_DISABLE_VERTEX_ATTRIB, index, 0U, 0U, 0U);
+}
+
+void glDrawArrays(GLenum mode, GLint first, GLsizei count) {
+	initialise();
+	if (GL_TRIANGLE_FAN < mode) {
+		setError(GL_INVALID_ENUM);
+		return;
+	}
+
+	if ((0 > first) || (0 > count)) {
+		setError(GL_INVALID_VALUE);
+		return;
+	}
+
+	countDraw((unsigned int)count);
+	record(GAE_MOCKGL_COMMAND_DRAW_ARRAYS, mode, (unsigned int)first, (unsigned int)count, 0U);
+}
+
+void glDrawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid* indices) {
+	GAE_MockGL_Buffer_t* buffer = 0;
+	unsigned long indexSize = 0U;
+
+	initialise();
+	if (GL_TRIANGLE_FAN < mode) {
+		setError(GL_INVALID_ENUM);
+		return;
+	}
+
+	switch (type) {
+		case GL_UNSIGNED_BYTE:
+			indexSize = sizeof(GLubyte);
+			break;
+		case GL_UNSIGNED_SHORT:
+			indexSize = sizeof(GLushort);
+			break;
+		case GL_UNSIGNED_INT: /* ES 2 only has these through OES_element_index_uint */
+			if (0 == strstr(mockGL.extensions, "GL_OES_element_index_uint")) {
+				setError(GL_INVALID_ENUM);
+				return;
+			}
+			indexSize = sizeof(GLuint);
+			break;
+		default: /* GL_FLOAT and friends are not valid index types */
+			setError(GL_INVALID_ENUM);
+			return;
+	};
+
+	if (0 > count) {
+		setError(GL_INVALID_VALUE);
+		return;
+	}
+
+	buffer = getBoundBuffer(GL_ELEMENT_ARRAY_BUFFER);
+	if ((0 != buffer) && ((unsigned long)(size_t)indices + (indexSize * (unsigned long)count) > (unsigned long)buffer->size)) {
+		setError(GL_INVALID_OPERATION);
+		return;
+	}
+
+	countDraw((unsigned int)count);
+	record(GAE_MOCKGL_COMMAND_DRAW_ELEMENTS, mode, (unsigned int)count, type, (unsigned int)(size_t)indices);
+}
+
+/* Shaders and Programs */
+GLuint glCreateShader(GLenum type) {
+	GAE_MockGL_Shader_t shader;
+	GLuint name = 0U;
+
+	initialise();
+	if ((GL_VERTEX_SHADER != type) && (GL_FRAGMENT_SHADER != type)) {
+		setError(GL_INVALID_ENUM);
+		return 0U;
+	}
+
+	shader.isAlive = GAE_TRUE;
+	shader.type = type;
+	shader.source = 0;
+	shader.isCompiled = GAE_FALSE;
+
+	name = genObject(mockGL.shaders, &shader);
+	record(GAE_MOCKGL_COMMAND_CREATE_SHADER, name, type, 0U, 0U);
+	return name;
+}
+
+void glDeleteShader(GLuint shader) {
+	GAE_MockGL_Shader_t* object = 0;
+
+	initialise();
+	object = (GAE_MockGL_Shader_t*)getObject(mockGL.shaders, shader);
+	if (0 == object)
+		return;
+
+	free(object->source);
+	object->source = 0;
+	object->isAlive = GAE_FALSE;
+	record(GAE_MOCKGL_COMMAND_DELETE_SHADER, shader, 0U, 0U, 0U);
+}
+
+void glShaderSource(GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length) {
+	GAE_MockGL_Shader_t* object = 0;
+	size_t totalLength = 0U;
+	size_t partLength = 0U;
+	GLsizei index = 0;
+
+	initialise();
+	object = (GAE_MockGL_Shader_t*)getObject(mockGL.shaders, shader);
+	if (0 == object) {
+		setError(GL_INVALID_VALUE);
+		return;
+	}
+
+	for (index = 0; index < count; ++index)
+		totalLength += ((0 != length) && (0 <= length[index])) ? (size_t)length[index] : strlen(string[index]);
+
+	free(object->source);
+	object->source = malloc(totalLength + 1U);
+	object->source[0] = '\0';
+	totalLength = 0U;
+
+	for (index = 0; index < count; ++index) {
+		partLength = ((0 != length) && (0 <= length[index])) ? (size_t)length[index] : strlen(string[index]);
+		memcpy(object->source + totalLength, string[index], partLength);
+		totalLength += partLength;
+	}
+	object->source[totalLength] = '\0';
+}
+
+void glCompileShader(GLuint shader) {
+	GAE_MockGL_Shader_t* object = 0;
+
+	initialise();
+	object = (GAE_MockGL_Shader_t*)getObject(mockGL.shaders, shader);
+	if (0 == object) {
+		setError(GL_INVALID_VALUE);
+		return;
+	}
+
+	countCompile();
+	object->isCompiled = ((0 != object->source) && (0 != strstr(object->source, "main"))) ? GAE_TRUE : GAE_FALSE;
+	record(GAE_MOCKGL_COMMAND_COMPILE_SHADER, shader, object->isCompiled, 0U, 0U);
+}
+
+void glGetShaderiv(GLuint shader, GLenum pname, GLint* params) {
+	GAE_MockGL_Shader_t* object = 0;
+
+	initialise();
+	object = (GAE_MockGL_Shader_t*)getObject(mockGL.shaders, shader);
+	if (0 == object) {
+		setError(GL_INVALID_VALUE);
+		return;
+	}
+
+	switch (pname) {
+		case GL_COMPILE_STATUS:
+			*params = object->isCompiled;
+			break;
+		case GL_INFO_LOG_LENGTH:
+			*params = 0;
+			break;
+		case GL_SHADER_SOURCE_LENGTH:
+			*params = (0 != object->source) ? (GLint)strlen(object->source) + 1 : 0;
+			break;
+		case GL_DELETE_STATUS:
+			*params = GL_FALSE;
+			break;
+		default:
+			setError(GL_INVALID_ENUM);
+			break;
+	};
+}
+
+void glGetShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog) {
+	GAE_UNUSED(shader);
+
+	initialise();
+	if (0 != length)
+		*length = 0;
+	if ((0 < bufSize) && (0 != infoLog))
+		infoLog[0] = '\0';
+}
+
+GLuint glCreateProgram(void) {
+	GAE_MockGL_Program_t program;
+	GLuint name = 0U;
+
+	initialise();
+	memset(&program, 0, sizeof(GAE_MockGL_Program_t));
+	program.isAlive = GAE_TRUE;
+
+	name = genObject(mockGL.programs, &program);
+	record(GAE_MOCKGL_COMMAND_CREATE_PROGRAM, name, 0U, 0U, 0U);
+	return name;
+}
+
+void glDeleteProgram(GLuint program) {
+	GAE_MockGL_Program_t* object = 0;
+
+	initialise();
+	object = (GAE_MockGL_Program_t*)getObject(mockGL.programs, program);
+	if (0 == object)
+		return;
+
+	if (mockGL.program == program)
+		object->isDeletePending = GAE_TRUE;
+	else
+		object->isAlive = GAE_FALSE;
+	record(GAE_MOCKGL_COMMAND_DELETE_PROGRAM, program, 0U, 0U, 0U);
+}
+
+void glAttachShader(GLuint program, GLuint shader) {
+	GAE_MockGL_Program_t* object = 0;
+	GAE_MockGL_Shader_t* shaderObject = 0;
+
+	initialise();
+	object = (GAE_MockGL_Program_t*)getObject(mockGL.programs, program);
+	shaderObject = (GAE_MockGL_Shader_t*)getObject(mockGL.shaders, shader);
+	if ((0 == object) || (0 == shaderObject)) {
+		setError(GL_INVALID_VALUE);
+		return;
+	}
+
+	if (GL_VERTEX_SHADER == shaderObject->type)
+		object->vertex = shader;
+	else
+		object->fragment = shader;
+}
+
+void glDetachShader(GLuint program, GLuint shader) {
+	GAE_MockGL_Program_t* object = 0;
+
+	initialise();
+	object = (GAE_MockGL_Program_t*)getObject(mockGL.programs, program);
+	if (0 == object) {
+		setError(GL_INVALID_VALUE);
+		return;
+	}
+
+	if (object->vertex == shader)
+		object->vertex = 0U;
+	if (object->fragment == shader)
+		object->fragment = 0U;
+}
+
+void glLinkProgram(GLuint program) {
+	GAE_MockGL_Program_t* object = 0;
+	GAE_MockGL_Shader_t* vertex = 0;
+	GAE_MockGL_Shader_t* fragment = 0;
+
+	initialise();
+	object = (GAE_MockGL_Program_t*)getObject(mockGL.programs, program);
+	if (0 == object) {
+		setError(GL_INVALID_VALUE);
+		return;
+	}
+
+	vertex = (GAE_MockGL_Shader_t*)getObject(mockGL.shaders, object->vertex);
+	fragment = (GAE_MockGL_Shader_t*)getObject(mockGL.shaders, object->fragment);
+
+	countCompile();
+	object->attributeCount = 0U;
+	object->uniformCount = 0U;
+	object->isLinked = ((0 != vertex) && (0 != fragment) && (GAE_TRUE == vertex->isCompiled) && (GAE_TRUE == fragment->isCompiled)) ? GAE_TRUE : GAE_FALSE;
+
+	if (GAE_TRUE == object->isLinked) {
+		parseVariables(vertex->source, "attribute", object->attributes, &object->attributeCount);
+		parseVariables(vertex->source, "uniform", object->uniforms, &object->uniformCount);
+		parseVariables(fragment->source, "uniform", object->uniforms, &object->uniformCount);
+	}
+
+	record(GAE_MOCKGL_COMMAND_LINK_PROGRAM, program, object->isLinked, object->attributeCount, object->uniformCount);
+}
+
+void glUseProgram(GLuint program) {
+	GAE_MockGL_Program_t* object = 0;
+	GAE_MockGL_Program_t* previous = 0;
+
+	initialise();
+	if (0U != program) {
+		object = (GAE_MockGL_Program_t*)getObject(mockGL.programs, program);
+		if ((0 == object) || (GAE_FALSE == object->isLinked)) {
+			setError(GL_INVALID_OPERATION);
+			return;
+		}
+	}
+
+	previous = (GAE_MockGL_Program_t*)getObject(mockGL.programs, mockGL.program);
+	if ((0 != previous) && (program != mockGL.program) && (GAE_TRUE == previous->isDeletePending))
+		previous->isAlive = GAE_FALSE;
+
+	mockGL.program = program;
+	countStateChange();
+	record(GAE_MOCKGL_COMMAND_USE_PROGRAM, program, 0U, 0U, 0U);
+}
+
+void glGetProgramiv(GLuint program, GLenum pname, GLint* params) {
+	GAE_MockGL_Program_t* object = 0;
+	GLint maxLength = 0;
+	unsigned int index = 0U;
+
+	initialise();
+	object = (GAE_MockGL_Program_t*)getObject(mockGL.programs, program);
+	if (0 == object) {
+		setError(GL_INVALID_VALUE);
+		return;
+	}
+
+	switch (pname) {
+		case GL_LINK_STATUS:
+			*params = object->isLinked;
+			break;
+		case GL_INFO_LOG_LENGTH:
+			*params = 0;
+			break;
+		case GL_DELETE_STATUS:
+			*params = GL_FALSE;
+			break;
+		case GL_ATTACHED_SHADERS:
+			*params = (0U != object->vertex) + (0U != object->fragment);
+			break;
+		case GL_ACTIVE_ATTRIBUTES:
+			*params = (GLint)object->attributeCount;
+			break;
+		case GL_ACTIVE_UNIFORMS:
+			*params = (GLint)object->uniformCount;
+			break;
+		case GL_PROGRAM_BINARY_LENGTH_OES:
+			*params = (GAE_TRUE == object->isLinked) ? (GLint)(GAE_MOCKGL_PROGRAM_BINARY_HEADER + (object->attributeCount + object->uniformCount) * sizeof(GAE_MockGL_Variable_t)) : 0;
+			break;
+		case GL_ACTIVE_ATTRIBUTE_MAX_LENGTH:
+			for (index = 0U; index < object->attributeCount; ++index) {
+				if (maxLength < (GLint)strlen(object->attributes[index].name) + 1)
+					maxLength = (GLint)strlen(object->attributes[index].name) + 1;
+			}
+			*params = maxLength;
+			break;
+		case GL_ACTIVE_UNIFORM_MAX_LENGTH:
+			for (index = 0U; index < object->uniformCount; ++index) {
+				if (maxLength < (GLint)strlen(object->uniforms[index].name) + 1)
+					maxLength = (GLint)strlen(object->uniforms[index].name) + 1;
+			}
+			*params = maxLength;
+			break;
+		default:
+			setError(GL_INVALID_ENUM);
+			break;
+	};
+}
+
+void glGetProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog) {
+	GAE_UNUSED(program);
+
+	initialise();
+	if (0 != length)
+		*length = 0;
+	if ((0 < bufSize) && (0 != infoLog))
+		infoLog[0] = '\0';
+}
+
+void glGetProgramBinaryOES(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, GLvoid* binary) {
+	GAE_MockGL_Program_t* object = 0;
+	GAE_BYTE* output = (GAE_BYTE*)binary;
+	GLint binaryLength = 0;
+	unsigned int counts[2];
+
+	initialise();
+	object = (GAE_MockGL_Program_t*)getObject(mockGL.programs, program);
+	if ((GAE_FALSE == hasExtension("GL_OES_get_program_binary")) || (0 == object) || (GAE_FALSE == object->isLinked)) {
+		setError(GL_INVALID_OPERATION);
+		return;
+	}
+
+	glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH_OES, &binaryLength);
+	if (bufSize < binaryLength) {
+		setError(GL_INVALID_OPERATION);
+		return;
+	}
+
+	/* the "binary" is the driver it came from and the linked variable tables - enough to restore the program */
+	counts[0] = object->attributeCount;
+	counts[1] = object->uniformCount;
+	memcpy(output, "MOCK", 4U);
+	memset(output + 4U, 0, GAE_MOCKGL_MAX_NAME);
+	strncpy((char*)output + 4U, mockGL.renderer, GAE_MOCKGL_MAX_NAME - 1U);
+	memcpy(output + 4U + GAE_MOCKGL_MAX_NAME, counts, sizeof(counts));
+	memcpy(output + GAE_MOCKGL_PROGRAM_BINARY_HEADER, object->attributes, object->attributeCount * sizeof(GAE_MockGL_Variable_t));
+	memcpy(output + GAE_MOCKGL_PROGRAM_BINARY_HEADER + object->attributeCount * sizeof(GAE_MockGL_Variable_t), object->uniforms, object->uniformCount * sizeof(GAE_MockGL_Variable_t));
+
+	if (0 != length)
+		*length = binaryLength;
+	*binaryFormat = GAE_MOCKGL_PROGRAM_BINARY_FORMAT;
+}
+
+void glProgramBinaryOES(GLuint program, GLenum binaryFormat, const GLvoid* binary, GLint length) {
+	GAE_MockGL_Program_t* object = 0;
+	const GAE_BYTE* input = (const GAE_BYTE*)binary;
+	char renderer[GAE_MOCKGL_MAX_NAME];
+	unsigned int counts[2] = { 0U, 0U };
+
+	initialise();
+	object = (GAE_MockGL_Program_t*)getObject(mockGL.programs, program);
+	if ((GAE_FALSE == hasExtension("GL_OES_get_program_binary")) || (0 == object)) {
+		setError(GL_INVALID_OPERATION);
+		return;
+	}
+
+	if (GAE_MOCKGL_PROGRAM_BINARY_FORMAT != binaryFormat) {
+		setError(GL_INVALID_ENUM);
+		return;
+	}
+
+	object->isLinked = GAE_FALSE;
+	object->attributeCount = 0U;
+	object->uniformCount = 0U;
+
+	/* like a real driver, a binary from another driver fails to link rather than raising an error */
+	if ((0 != input) && ((GLint)GAE_MOCKGL_PROGRAM_BINARY_HEADER <= length) && (0 == memcmp(input, "MOCK", 4U))) {
+		memcpy(renderer, input + 4U, GAE_MOCKGL_MAX_NAME);
+		renderer[GAE_MOCKGL_MAX_NAME - 1U] = '\0';
+		memcpy(counts, input + 4U + GAE_MOCKGL_MAX_NAME, sizeof(counts));
+
+		if ((0 == strncmp(renderer, mockGL.renderer, GAE_MOCKGL_MAX_NAME - 1U))
+		&& (GAE_MOCKGL_MAX_VARIABLES >= counts[0]) && (GAE_MOCKGL_MAX_VARIABLES >= counts[1])
+		&& ((unsigned long)length == GAE_MOCKGL_PROGRAM_BINARY_HEADER + (counts[0] + counts[1]) * sizeof(GAE_MockGL_Variable_t))) {
+			memcpy(object->attributes, input + GAE_MOCKGL_PROGRAM_BINARY_HEADER, counts[0] * sizeof(GAE_MockGL_Variable_t));
+			memcpy(object->uniforms, input + GAE_MOCKGL_PROGRAM_BINARY_HEADER + counts[0] * sizeof(GAE_MockGL_Variable_t), counts[1] * sizeof(GAE_MockGL_Variable_t));
+			object->attributeCount = counts[0];
+			object->uniformCount = counts[1];
+			object->isLinked = GAE_TRUE;
+		}
+	}
+
+	record(GAE_MOCKGL_COMMAND_PROGRAM_BINARY, program, object->isLinked, object->attributeCount, object->uniformCount);
+}
+
+void glGetActiveAttrib(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name) {
+	GAE_MockGL_Program_t* object = 0;
+
+	initialise();
+	object = (GAE_MockGL_Program_t*)getObject(mockGL.programs, program);
+	if ((0 == object) || (index >= object->attributeCount) || (0 >= bufSize)) {
+		setError(GL_INVALID_VALUE);
+		return;
+	}
+
+	strncpy(name, object->attributes[index].name, (size_t)bufSize - 1U);
+	name[bufSize - 1] = '\0';
+	if (0 != length)
+		*length = (GLsizei)strlen(name);
+	*size = object->attributes[index].size;
+	*type = object->attributes[index].type;
+}
+
+void glGetActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name) {
+	GAE_MockGL_Program_t* object = 0;
+
+	initialise();
+	object = (GAE_MockGL_Program_t*)getObject(mockGL.programs, program);
+	if ((0 == object) || (index >= object->uniformCount) || (0 >= bufSize)) {
+		setError(GL_INVALID_VALUE);
+		return;
+	}
+
+	strncpy(name, object->uniforms[index].name, (size_t)bufSize - 1U);
+	name[bufSize - 1] = '\0';
+	if (0 != length)
+		*length = (GLsizei)strlen(name);
+	*size = object->uniforms[index].size;
+	*type = object->uniforms[index].type;
+}
+
+GLint glGetAttribLocation(GLuint program, const GLchar* name) {
+	GAE_MockGL_Program_t* object = 0;
+	unsigned int index = 0U;
+
+	initialise();
+	object = (GAE_MockGL_Program_t*)getObject(mockGL.programs, program);
+	if ((0 == object) || (GAE_FALSE == object->isLinked)) {
+		setError(GL_INVALID_OPERATION);
+		return -1;
+	}
+
+	for (index = 0U; index < object->attributeCount; ++index) {
+		if (0 == strcmp(object->attributes[index].name, name))
+			return (GLint)index;
+	}
+
+	return -1;
+}
+
+GLint glGetUniformLocation(GLuint program, const GLchar* name) {
+	GAE_MockGL_Program_t* object = 0;
+	unsigned int index = 0U;
+
+	initialise();
+	object = (GAE_MockGL_Program_t*)getObject(mockGL.programs, program);
+	if ((0 == object) || (GAE_FALSE == object->isLinked)) {
+		setError(GL_INVALID_OPERATION);
+		return -1;
+	}
+
+	for (index = 0U; index < object->uniformCount; ++index) {
+		if (0 == strcmp(object->uniforms[index].name, name))
+			return (GLint)index;
+	}
+
+	return -1;
+}
+
+void glUniform1i(GLint location, GLint v0) {
+	initialise();
+	record(GAE_MOCKGL_COMMAND_UNIFORM, (unsigned int)location, 1U, (unsigned int)v0, 0U);
+}
+
+void glUniform1f(GLint location, GLfloat v0) {
+	GAE_UNUSED(v0);
+	initialise();
+	record(GAE_MOCKGL_COMMAND_UNIFORM, (unsigned int)location, 1U, 0U, 0U);
+}
+
+void glUniform2fv(GLint location, GLsizei count, const GLfloat* value) {
+	GAE_UNUSED(value);
+	initialise();
+	record(GAE_MOCKGL_COMMAND_UNIFORM, (unsigned int)location, (unsigned int)count * 2U, 0U, 0U);
+}
+
+void glUniform3fv(GLint location, GLsizei count, const GLfloat* value) {
+	GAE_UNUSED(value);
+	initialise();
+	record(GAE_MOCKGL_COMMAND_UNIFORM, (unsigned int)location, (unsigned int)count * 3U, 0U, 0U);
+}
+
+void glUniform4fv(GLint location, GLsizei count, const GLfloat* value) {
+	GAE_UNUSED(value);
+	initialise();
+	record(GAE_MOCKGL_COMMAND_UNIFORM, (unsigned int)location, (unsigned int)count * 4U, 0U, 0U);
+}
+
+void glUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+	GAE_UNUSED(transpose);
+	GAE_UNUSED(value);
+	initialise();
+	record(GAE_MOCKGL_COMMAND_UNIFORM, (unsigned int)location, (unsigned int)count * 16U, 0U, 0U);
+}
+
+/* Textures */
+void glGenTextures(GLsizei n, GLuint* textures) {
+	GAE_MockGL_Texture_t texture;
+	GLsizei index = 0;
+
+	initialise();
+	memset(&texture, 0, sizeof(GAE_MockGL_Texture_t));
+	texture.isAlive = GAE_TRUE;
+	texture.minFilter = GL_NEAREST_MIPMAP_LINEAR;
+	texture.magFilter = GL_LINEAR;
+
+	for (index = 0; index < n; ++index) {
+		textures[index] = genObject(mockGL.textures, &texture);
+		record(GAE_MOCKGL_COMMAND_GEN_TEXTURE, textures[index], 0U, 0U, 0U);
+	}
+}
+
+void glDeleteTextures(GLsizei n, const GLuint* textures) {
+	GAE_MockGL_Texture_t* texture = 0;
+	GLsizei index = 0;
+	unsigned int unit = 0U;
+
+	initialise();
+	for (index = 0; index < n; ++index) {
+		texture = (GAE_MockGL_Texture_t*)getObject(mockGL.textures, textures[index]);
+		if (0 == texture)
+			continue;
+
+		texture->isAlive = GAE_FALSE;
+		dropImages(texture, 0);
+		for (unit = 0U; unit < GAE_MOCKGL_TEXTURE_UNITS; ++unit) {
+			if (mockGL.boundTextures[unit] == textures[index])
+				mockGL.boundTextures[unit] = 0U;
+		}
+		record(GAE_MOCKGL_COMMAND_DELETE_TEXTURE, textures[index], 0U, 0U, 0U);
+	}
+}
+
+GLboolean glIsTexture(GLuint texture) {
+	initialise();
+	return (0 != getObject(mockGL.textures, texture)) ? GL_TRUE : GL_FALSE;
+}
+
+void glActiveTexture(GLenum texture) {
+	initialise();
+	if ((GL_TEXTURE0 > texture) || ((GL_TEXTURE0 + GAE_MOCKGL_TEXTURE_UNITS) <= texture)) {
+		setError(GL_INVALID_ENUM);
+		return;
+	}
+
+	mockGL.activeTexture = texture;
+	countStateChange();
+	record(GAE_MOCKGL_COMMAND_ACTIVE_TEXTURE, texture, 0U, 0U, 0U);
+}
+
+void glBindTexture(GLenum target, GLuint texture) {
+	initialise();
+	if (GL_TEXTURE_2D != target) {
+		setError(GL_INVALID_ENUM);
+		return;
+	}
+
+	if (GAE_FALSE == isNameValid(mockGL.textures, texture)) {
+		setError(GL_INVALID_OPERATION);
+		return;
+	}
+
+	mockGL.boundTextures[mockGL.activeTexture - GL_TEXTURE0] = texture;
+	countStateChange();
+	record(GAE_MOCKGL_COMMAND_BIND_TEXTURE, target, texture, mockGL.activeTexture - GL_TEXTURE0, 0U);
+}
+
+void glTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const GLvoid* pixels) {
+	GAE_MockGL_Texture_t* texture = 0;
+
+	initialise();
+	if (GL_TEXTURE_2D != target) {
+		setError(GL_INVALID_ENUM);
+		return;
+	}
+
+	if ((0 > level) || (0 > width) || (0 > height) || (0 != border)) {
+		setError(GL_INVALID_VALUE);
+		return;
+	}
+
+	texture = (GAE_MockGL_Texture_t*)getObject(mockGL.textures, mockGL.boundTextures[mockGL.activeTexture - GL_TEXTURE0]);
+	if (0 == texture) {
+		setError(GL_INVALID_OPERATION);
+		return;
+	}
+
+	if (0 == level) {
+		texture->width = width;
+		texture->height = height;
+		texture->internalFormat = internalformat;
+	}
+
+	if (0 != pixels) {
+		countTextureBytes(imageSize(width, height, format, type));
+		keepImage(texture, level, format, pixels, imageSize(width, height, format, type));
+	}
+	record(GAE_MOCKGL_COMMAND_TEX_IMAGE, (unsigned int)level, (unsigned int)width, (unsigned int)height, format);
+}
+
+void glTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid* pixels) {
+	GAE_MockGL_Texture_t* texture = 0;
+
+	initialise();
+	if (GL_TEXTURE_2D != target) {
+		setError(GL_INVALID_ENUM);
+		return;
+	}
+
+	texture = (GAE_MockGL_Texture_t*)getObject(mockGL.textures, mockGL.boundTextures[mockGL.activeTexture - GL_TEXTURE0]);
+	if (0 == texture) {
+		setError(GL_INVALID_OPERATION);
+		return;
+	}
+
+	if ((0 == level) && (((xoffset + width) > texture->width) || ((yoffset + height) > texture->height))) {
+		setError(GL_INVALID_VALUE);
+		return;
+	}
+
+	if (0 != pixels)
+		countTextureBytes(imageSize(width, height, format, type));
+	/* only whole images are kept, so one updated in part is dropped */
+	if ((0 <= level) && (GAE_MOCKGL_TEXTURE_LEVELS > (unsigned int)level) && (0 != texture->images[level])) {
+		free(texture->images[level]);
+		texture->images[level] = 0;
+	}
+	record(GAE_MOCKGL_COMMAND_TEX_SUB_IMAGE, (unsigned int)level, (unsigned int)width, (unsigned int)height, format);
+}
+
+void glCompressedTexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const GLvoid* data) {
+	GAE_MockGL_Texture_t* texture = 0;
+	const char* extension = 0;
+	unsigned long blockSize = 0U;
+
+	initialise();
+	if (GL_TEXTURE_2D != target) {
+		setError(GL_INVALID_ENUM);
+		return;
+	}
+
+	/* compressed formats only exist while their extension is advertised */
+	switch (internalformat) {
+		case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+		case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+			extension = "GL_EXT_texture_compression_s3tc";
+			blockSize = 8U;
+			break;
+		case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+			extension = "GL_EXT_texture_compression_s3tc";
+			blockSize = 16U;
+			break;
+		case GL_ETC1_RGB8_OES:
+			extension = "GL_OES_compressed_ETC1_RGB8_texture";
+			blockSize = 8U;
+			break;
+		default:
+			break;
+	};
+
+	if ((0 == extension) || (0 == strstr(mockGL.extensions, extension))) {
+		setError(GL_INVALID_ENUM);
+		return;
+	}
+
+	if ((0 > level) || (0 > width) || (0 > height) || (0 != border)
+	|| ((unsigned long)imageSize != ((unsigned long)width + 3U) / 4U * (((unsigned long)height + 3U) / 4U) * blockSize)) {
+		setError(GL_INVALID_VALUE);
+		return;
+	}
+
+	texture = (GAE_MockGL_Texture_t*)getObject(mockGL.textures, mockGL.boundTextures[mockGL.activeTexture - GL_TEXTURE0]);
+	if (0 == texture) {
+		setError(GL_INVALID_OPERATION);
+		return;
+	}
+
+	if (0 == level) {
+		texture->width = width;
+		texture->height = height;
+		texture->internalFormat = (GLint)internalformat;
+	}
+
+	if (0 != data) {
+		countTextureBytes((unsigned long)imageSize);
+		keepImage(texture, level, internalformat, data, (unsigned long)imageSize);
+	}
+	record(GAE_MOCKGL_COMMAND_COMPRESSED_TEX_IMAGE, (unsigned int)level, (unsigned int)width, (unsigned int)height, internalformat);
+}
+
+void glTexParameteri(GLenum target, GLenum pname, GLint param) {
+	GAE_MockGL_Texture_t* texture = 0;
+
+	initialise();
+	texture = (GAE_MockGL_Texture_t*)getObject(mockGL.textures, mockGL.boundTextures[mockGL.activeTexture - GL_TEXTURE0]);
+	if ((GL_TEXTURE_2D != target) || (0 == texture)) {
+		setError(GL_INVALID_OPERATION);
+		return;
+	}
+
+	switch (pname) {
+		case GL_TEXTURE_MIN_FILTER:
+			texture->minFilter = param;
+			break;
+		case GL_TEXTURE_MAG_FILTER:
+			texture->magFilter = param;
+			break;
+		case GL_TEXTURE_WRAP_S:
+		case GL_TEXTURE_WRAP_T:
+			break;
+		default:
+			setError(GL_INVALID_ENUM);
+			return;
+	};
+
+	countStateChange();
+	record(GAE_MOCKGL_COMMAND_TEX_PARAMETER, target, pname, (unsigned int)param, 0U);
+}
+
+void glGenerateMipmap(GLenum target) {
+	GAE_MockGL_Texture_t* texture = 0;
+
+	initialise();
+	texture = (GAE_MockGL_Texture_t*)getObject(mockGL.textures, mockGL.boundTextures[mockGL.activeTexture - GL_TEXTURE0]);
+	if ((GL_TEXTURE_2D != target) || (0 == texture)) {
+		setError(GL_INVALID_OPERATION);
+		return;
+	}
+
+	texture->hasMipmaps = GAE_TRUE;
+	/* generated levels aren't computed, so none kept from before can stand for them */
+	dropImages(texture, 1);
+	record(GAE_MOCKGL_COMMAND_GENERATE_MIPMAP, target, 0U, 0U, 0U);
+}
+
+void glPixelStorei(GLenum pname, GLint param) {
+	initialise();
+	if ((1 != param) && (2 != param) && (4 != param) && (8 != param)) {
+		setError(GL_INVALID_VALUE);
+		return;
+	}
+
+	if (GL_UNPACK_ALIGNMENT == pname)
+		mockGL.unpackAlignment = param;
+}
+
+/* Framebuffers and Renderbuffers */
+void glGenFramebuffers(GLsizei n, GLuint* framebuffers) {
+	GAE_MockGL_Object_t object;
+	GLsizei index = 0;
+
+	initialise();
+	object.isAlive = GAE_TRUE;
+	for (index = 0; index < n; ++index)
+		framebuffers[index] = genObject(mockGL.framebuffers, &object);
+}
+
+void glDeleteFramebuffers(GLsizei n, const GLuint* framebuffers) {
+	GAE_MockGL_Object_t* object = 0;
+	GLsizei index = 0;
+
+	initialise();
+	for (index = 0; index < n; ++index) {
+		object = (GAE_MockGL_Object_t*)getObject(mockGL.framebuffers, framebuffers[index]);
+		if (0 == object)
+			continue;
+
+		object->isAlive = GAE_FALSE;
+		if (mockGL.framebuffer == framebuffers[index])
+			mockGL.framebuffer = 0U;
+	}
+}
+
+void glBindFramebuffer(GLenum target, GLuint framebuffer) {
+	initialise();
+	if (GL_FRAMEBUFFER != target) {
+		setError(GL_INVALID_ENUM);
+		return;
+	}
+
+	if (GAE_FALSE == isNameValid(mockGL.framebuffers, framebuffer)) {
+		setError(GL_INVALID_OPERATION);
+		return;
+	}
+
+	mockGL.framebuffer = framebuffer;
+	countStateChange();
+	record(GAE_MOCKGL_COMMAND_BIND_FRAMEBUFFER, target, framebuffer, 0U, 0U);
+}
+
+void glFramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level) {
+	GAE_UNUSED(attachment);
+	GAE_UNUSED(level);
+
+	initialise();
+	if ((GL_FRAMEBUFFER != target) || (GL_TEXTURE_2D != textarget)) {
+		setError(GL_INVALID_ENUM);
+		return;
+	}
+
+	if ((0U == mockGL.framebuffer) || (GAE_FALSE == isNameValid(mockGL.textures, texture)))
+		setError(GL_INVALID_OPERATION);
+}
+
+void glFramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer) {
+	GAE_UNUSED(attachment);
+
+	initialise();
+	if ((GL_FRAMEBUFFER != target) || (GL_RENDERBUFFER != renderbuffertarget)) {
+		setError(GL_INVALID_ENUM);
+		return;
+	}
+
+	if ((0U == mockGL.framebuffer) || (GAE_FALSE == isNameValid(mockGL.renderbuffers, renderbuffer)))
+		setError(GL_INVALID_OPERATION);
+}
+
+GLenum glCheckFramebufferStatus(GLenum target) {
+	GAE_UNUSED(target);
+	initialise();
+	return GL_FRAMEBUFFER_COMPLETE;
+}
+
+void glGenRenderbuffers(GLsizei n, GLuint* renderbuffers) {
+	GAE_MockGL_Object_t object;
+	GLsizei index = 0;
+
+	initialise();
+	object.isAlive = GAE_TRUE;
+	for (index = 0; index < n; ++index)
+		renderbuffers[index] = genObject(mockGL.renderbuffers, &object);
+}
+
+void glDeleteRenderbuffers(GLsizei n, const GLuint* renderbuffers) {
+	GAE_MockGL_Object_t* object = 0;
+	GLsizei index = 0;
+
+	initialise();
+	for (index = 0; index < n; ++index) {
+		object = (GAE_MockGL_Object_t*)getObject(mockGL.renderbuffers, renderbuffers[index]);
+		if (0 == object)
+			continue;
+
+		object->isAlive = GAE_FALSE;
+		if (mockGL.renderbuffer == renderbuffers[index])
+			mockGL.renderbuffer = 0U;
+	}
+}
+
+void glBindRenderbuffer(GLenum target, GLuint renderbuffer) {
+	initialise();
+	if (GL_RENDERBUFFER != target) {
+		setError(GL_INVALID_ENUM);
+		return;
+	}
+
+	if (GAE_FALSE == isNameValid(mockGL.renderbuffers, renderbuffer)) {
+		setError(GL_INVALID_OPERATION);
+		return;
+	}
+
+	mockGL.renderbuffer = renderbuffer;
+	countStateChange();
+	record(GAE_MOCKGL_COMMAND_BIND_RENDERBUFFER, target, renderbuffer, 0U, 0U);
+}
+
+void glRenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height) {
+	GAE_UNUSED(internalformat);
+
+	initialise();
+	if ((GL_RENDERBUFFER != target) || (0U == mockGL.renderbuffer)) {
+		setError(GL_INVALID_OPERATION);
+		return;
+	}
+
+	if ((0 > width) || (0 > height))
+		setError(GL_INVALID_VALUE);
+}
+
+/* Fixed State */
+void glEnable(GLenum cap) {
+	initialise();
+	switch (cap) {
+		case GL_BLEND:
+			mockGL.isBlendEnabled = GAE_TRUE;
+			break;
+		case GL_DEPTH_TEST:
+			mockGL.isDepthTestEnabled = GAE_TRUE;
+			break;
+		case GL_CULL_FACE:
+			mockGL.isCullFaceEnabled = GAE_TRUE;
+			break;
+		case GL_SCISSOR_TEST:
+			mockGL.isScissorTestEnabled = GAE_TRUE;
+			break;
+		case GL_TEXTURE_2D:
+			mockGL.isTexture2DEnabled = GAE_TRUE;
+			break;
+		default:
+			setError(GL_INVALID_ENUM);
+			return;
+	};
+
+	countStateChange();
+	record(GAE_MOCKGL_COMMAND_ENABLE, cap, 0U, 0U, 0U);
+}
+
+void glDisable(GLenum cap) {
+	initialise();
+	switch (cap) {
+		case GL_BLEND:
+			mockGL.isBlendEnabled = GAE_FALSE;
+			break;
+		case GL_DEPTH_TEST:
+			mockGL.isDepthTestEnabled = GAE_FALSE;
+			break;
+		case GL_CULL_FACE:
+			mockGL.isCullFaceEnabled = GAE_FALSE;
+			break;
+		case GL_SCISSOR_TEST:
+			mockGL.isScissorTestEnabled = GAE_FALSE;
+			break;
+		case GL_TEXTURE_2D:
+			mockGL.isTexture2DEnabled = GAE_FALSE;
+			break;
+		default:
+			setError(GL_INVALID_ENUM);
+			return;
+	};
+
+	countStateChange();
+	record(GAE_MOCKGL_COMMAND_DISABLE, cap, 0U, 0U, 0U);
+}
+
+GLboolean glIsEnabled(GLenum cap) {
+	initialise();
+	switch (cap) {
+		case GL_BLEND:
+			return (GLboolean)mockGL.isBlendEnabled;
+		case GL_DEPTH_TEST:
+			return (GLboolean)mockGL.isDepthTestEnabled;
+		case GL_CULL_FACE:
+			return (GLboolean)mockGL.isCullFaceEnabled;
+		case GL_SCISSOR_TEST:
+			return (GLboolean)mockGL.isScissorTestEnabled;
+		case GL_TEXTURE_2D:
+			return (GLboolean)mockGL.isTexture2DEnabled;
+		default:
+			setError(GL_INVALID_ENUM);
+			return GL_FALSE;
+	};
+}
+
+void glBlendFunc(GLenum sfactor, GLenum dfactor) {
+	glBlendFuncSeparate(sfactor, dfactor, sfactor, dfactor);
+}
+
+void glBlendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha) {
+	initialise();
+	mockGL.blendFunc[0] = srcRGB;
+	mockGL.blendFunc[1] = dstRGB;
+	mockGL.blendFunc[2] = srcAlpha;
+	mockGL.blendFunc[3] = dstAlpha;
+
+	countStateChange();
+	record(GAE_MOCKGL_COMMAND_BLEND_FUNC, srcRGB, dstRGB, srcAlpha, dstAlpha);
+}
+
+void glBlendEquation(GLenum mode) {
+	initialise();
+	if ((GL_FUNC_ADD != mode) && (GL_FUNC_SUBTRACT != mode) && (GL_FUNC_REVERSE_SUBTRACT != mode)) {
+		setError(GL_INVALID_ENUM);
+		return;
+	}
+
+	mockGL.blendEquation = mode;
+
+	countStateChange();
+	record(GAE_MOCKGL_COMMAND_BLEND_EQUATION, mode, 0U, 0U, 0U);
+}
+
+void glDepthFunc(GLenum func) {
+	initialise();
+	if ((GL_NEVER > func) || (GL_ALWAYS < func)) {
+		setError(GL_INVALID_ENUM);
+		return;
+	}
+
+	mockGL.depthFunc = func;
+
+	countStateChange();
+	record(GAE_MOCKGL_COMMAND_DEPTH_FUNC, func, 0U, 0U, 0U);
+}
+
+void glDepthMask(GLboolean flag) {
+	initialise();
+	mockGL.isDepthWriteEnabled = (GL_FALSE != flag) ? GAE_TRUE : GAE_FALSE;
+
+	countStateChange();
+	record(GAE_MOCKGL_COMMAND_DEPTH_MASK, flag, 0U, 0U, 0U);
+}
+
+void glCullFace(GLenum mode) {
+	initialise();
+	if ((GL_FRONT != mode) && (GL_BACK != mode) && (GL_FRONT_AND_BACK != mode)) {
+		setError(GL_INVALID_ENUM);
+		return;
+	}
+
+	mockGL.cullFace = mode;
+
+	countStateChange();
+	record(GAE_MOCKGL_COMMAND_CULL_FACE, mode, 0U, 0U, 0U);
+}
+
+void glFrontFace(GLenum mode) {
+	initialise();
+	if ((GL_CW != mode) && (GL_CCW != mode)) {
+		setError(GL_INVALID_ENUM);
+		return;
+	}
+
+	mockGL.frontFace = mode;
+
+	countStateChange();
+	record(GAE_MOCKGL_COMMAND_FRONT_FACE, mode, 0U, 0U, 0U);
+}
+
+void glViewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+	initialise();
+	if ((0 > width) || (0 > height)) {
+		setError(GL_INVALID_VALUE);
+		return;
+	}
+
+	mockGL.viewport[0] = x;
+	mockGL.viewport[1] = y;
+	mockGL.viewport[2] = width;
+	mockGL.viewport[3] = height;
+
+	countStateChange();
+	record(GAE_MOCKGL_COMMAND_VIEWPORT, (unsigned int)x, (unsigned int)y, (unsigned int)width, (unsigned int)height);
+}
+
+void glScissor(GLint x, GLint y, GLsizei width, GLsizei height) {
+	initialise();
+	if ((0 > width) || (0 > height)) {
+		setError(GL_INVALID_VALUE);
+		return;
+	}
+
+	mockGL.scissor[0] = x;
+	mockGL.scissor[1] = y;
+	mockGL.scissor[2] = width;
+	mockGL.scissor[3] = height;
+
+	countStateChange();
+	record(GAE_MOCKGL_COMMAND_SCISSOR, (unsigned int)x, (unsigned int)y, (unsigned int)width, (unsigned int)height);
+}
+
+void glClearColor(GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha) {
+	initialise();
+	record(GAE_MOCKGL_COMMAND_CLEAR_COLOUR, (unsigned int)(red * 255.0F), (unsigned int)(green * 255.0F), (unsigned int)(blue * 255.0F), (unsigned int)(alpha * 255.0F));
+}
+
+void glClear(GLbitfield mask) {
+	initialise();
+	record(GAE_MOCKGL_COMMAND_CLEAR, mask, 0U, 0U, 0U);
+}
+
+void glFlush(void) {
+}
+
+void glFinish(void) {
+}
+
+/* Queries */
+GLenum glGetError(void) {
+	GLenum error = GL_NO_ERROR;
+
+	initialise();
+	error = mockGL.error;
+	mockGL.error = GL_NO_ERROR;
+	return error;
+}
+
+const GLubyte* glGetString(GLenum name) {
+	initialise();
+	switch (name) {
+		case GL_VENDOR:
+			return (const GLubyte*)"GLESGAE";
+		case GL_RENDERER:
+			return (const GLubyte*)mockGL.renderer;
+		case GL_VERSION:
+			return (const GLubyte*)"OpenGL ES 2.0 MockGL";
+		case GL_EXTENSIONS:
+			return (const GLubyte*)mockGL.extensions;
+		default:
+			setError(GL_INVALID_ENUM);
+			return 0;
+	};
+}
+
+void glGetIntegerv(GLenum pname, GLint* params) {
+	initialise();
+	switch (pname) {
+		case GL_ARRAY_BUFFER_BINDING:
+			*params = (GLint)mockGL.arrayBuffer;
+			break;
+		case GL_ELEMENT_ARRAY_BUFFER_BINDING:
+			*params = (GLint)mockGL.elementBuffer;
+			break;
+		case GL_CURRENT_PROGRAM:
+			*params = (GLint)mockGL.program;
+			break;
+		case GL_FRAMEBUFFER_BINDING:
+			*params = (GLint)mockGL.framebuffer;
+			break;
+		case GL_RENDERBUFFER_BINDING:
+			*params = (GLint)mockGL.renderbuffer;
+			break;
+		case GL_ACTIVE_TEXTURE:
+			*params = (GLint)mockGL.activeTexture;
+			break;
+		case GL_TEXTURE_BINDING_2D:
+			*params = (GLint)mockGL.boundTextures[mockGL.activeTexture - GL_TEXTURE0];
+			break;
+		case GL_VIEWPORT:
+			memcpy(params, mockGL.viewport, sizeof(mockGL.viewport));
+			break;
+		case GL_BLEND_EQUATION:
+			*params = (GLint)mockGL.blendEquation;
+			break;
+		case GL_UNPACK_ALIGNMENT:
+			*params = mockGL.unpackAlignment;
+			break;
+		case GL_MAX_TEXTURE_IMAGE_UNITS:
+			*params = (GLint)GAE_MOCKGL_TEXTURE_UNITS;
+			break;
+		case GL_MAX_VERTEX_ATTRIBS:
+			*params = (GLint)GAE_MOCKGL_VERTEX_ATTRIBS;
+			break;
+		case GL_MAX_TEXTURE_SIZE:
+			*params = 4096;
+			break;
+		case GL_NUM_PROGRAM_BINARY_FORMATS_OES:
+			*params = (GAE_TRUE == hasExtension("GL_OES_get_program_binary")) ? 1 : 0;
+			break;
+		case GL_PROGRAM_BINARY_FORMATS_OES:
+			if (GAE_TRUE == hasExtension("GL_OES_get_program_binary"))
+				*params = (GLint)GAE_MOCKGL_PROGRAM_BINARY_FORMAT;
+			break;
+		default:
+			setError(GL_INVALID_ENUM);
+			break;
+	};
+}
+
+void record(const GAE_MockGL_CommandType type, const unsigned int a, const unsigned int b, const unsigned int c, const unsigned int d) {
+	GAE_MockGL_Command_t command;
+
+	if (GAE_FALSE == mockGL.isRecording)
+		return;
+
+	command.type = type;
+	command.params[0] = a;
+	command.params[1] = b;
+	command.params[2] = c;
+	command.params[3] = d;
+	GAE_Array_push(mockGL.commandLog, &command);
+}
+
+void setError(const GLenum error) {
+	/* GL only keeps the first error until it is queried */
+	if (GL_NO_ERROR == mockGL.error)
+		mockGL.error = error;
+}
+
+void countStateChange(void) {
+	++mockGL.frame.stateChanges;
+	++mockGL.total.stateChanges;
+}
+
+void countBufferBytes(const unsigned long bytes) {
+	mockGL.frame.bufferBytes += bytes;
+	mockGL.total.bufferBytes += bytes;
+}
+
+void countTextureBytes(const unsigned long bytes) {
+	mockGL.frame.textureBytes += bytes;
+	mockGL.total.textureBytes += bytes;
+}
+
+void countDraw(const unsigned int vertices) {
+	++mockGL.frame.drawCalls;
+	++mockGL.total.drawCalls;
+	mockGL.frame.vertices += vertices;
+	mockGL.total.vertices += vertices;
+}
+
+void countCompile(void) {
+	const clock_t end = clock() + (clock_t)((double)mockGL.compileTime * CLOCKS_PER_SEC / 1000000.0);
+
+	++mockGL.frame.compiles;
+	++mockGL.total.compiles;
+
+	/* spin rather than sleep, so the time shows up in the caller's CPU timings */
+	while ((0U < mockGL.compileTime) && (clock() < end)) {
+	}
+}
+
+GAE_BOOL hasExtension(const char* extension) {
+	return (0 != strstr(mockGL.extensions, extension)) ? GAE_TRUE : GAE_FALSE;
+}
+
+GLuint genObject(GAE_Array_t* objects, void* const object) {
+	const unsigned int length = GAE_Array_length(objects);
+	unsigned int index = 0U;
+
+	/* the lowest deleted name goes out again first, as drivers do, so anything holding on to a stale one gets caught */
+	for (index = 0U; index < length; ++index) {
+		GAE_MockGL_Object_t* slot = (GAE_MockGL_Object_t*)GAE_Array_get(objects, index);
+		if (GAE_FALSE == slot->isAlive) {
+			memcpy(slot, object, objects->size);
+			return index + 1U;
+		}
+	}
+
+	GAE_Array_push(objects, object);
+	return GAE_Array_length(objects); /* names start at 1, as 0 is reserved */
+}
+
+void* getObject(GAE_Array_t* objects, const GLuint name) {
+	GAE_MockGL_Object_t* object = 0;
+
+	if ((0U == name) || (name > GAE_Array_length(objects)))
+		return 0;
+
+	/* every tracked object starts with its isAlive flag */
+	object = (GAE_MockGL_Object_t*)GAE_Array_get(objects, name - 1U);
+	return (GAE_TRUE == object->isAlive) ? object : 0;
+}
+
+GAE_BOOL isNameValid(GAE_Array_t* objects, const GLuint name) {
+	return ((0U == name) || (0 != getObject(objects, name))) ? GAE_TRUE : GAE_FALSE;
+}
+
+GAE_MockGL_Buffer_t* getBoundBuffer(const GLenum target) {
+	switch (target) {
+		case GL_ARRAY_BUFFER:
+			return (GAE_MockGL_Buffer_t*)getObject(mockGL.buffers, mockGL.arrayBuffer);
+		case GL_ELEMENT_ARRAY_BUFFER:
+			return (GAE_MockGL_Buffer_t*)getObject(mockGL.buffers, mockGL.elementBuffer);
+		default:
+			return 0;
+	};
+}
+
+unsigned long imageSize(const GLsizei width, const GLsizei height, const GLenum format, const GLenum type) {
+	unsigned long pixelSize = 4U;
+	unsigned long rowSize = 0U;
+	const unsigned long alignment = (unsigned long)mockGL.unpackAlignment;
+
+	switch (format) {
+		case GL_ALPHA:
+		case GL_LUMINANCE:
+			pixelSize = 1U;
+			break;
+		case GL_LUMINANCE_ALPHA:
+			pixelSize = 2U;
+			break;
+		case GL_RGB:
+			pixelSize = 3U;
+			break;
+		case GL_RGBA:
+		default:
+			pixelSize = 4U;
+			break;
+	};
+
+	if ((GL_UNSIGNED_SHORT == type) || (GL_SHORT == type))
+		pixelSize *= 2U;
+	else if (GL_FLOAT == type)
+		pixelSize *= 4U;
+
+	rowSize = (((unsigned long)width * pixelSize) + alignment - 1U) / alignment * alignment;
+	return rowSize * (unsigned long)height;
+}
+
+void keepImage(GAE_MockGL_Texture_t* texture, const GLint level, const GLenum format, const GLvoid* data, const unsigned long size) {
+	if ((GAE_FALSE == mockGL.isKeepingImages) || (0 > level) || (GAE_MOCKGL_TEXTURE_LEVELS <= (unsigned int)level))
+		return;
+
+	free(texture->images[level]);
+	texture->images[level] = malloc((0UL < size) ? size : 1UL);
+	memcpy(texture->images[level], data, size);
+	texture->imageSizes[level] = size;
+	texture->imageFormats[level] = format;
+}
+
+void dropImages(GAE_MockGL_Texture_t* texture, const GLint firstLevel) {
+	unsigned int level = 0U;
+
+	for (level = (unsigned int)firstLevel; level < GAE_MOCKGL_TEXTURE_LEVELS; ++level) {
+		free(texture->images[level]);
+		texture->images[level] = 0;
+	}
+}
+
+void parseVariables(const char* source, const char* qualifier, GAE_MockGL_Variable_t* variables, unsigned int* count) {
+	const size_t qualifierLength = strlen(qualifier);
+	const char* itr = source;
+	const char* type = 0;
+	const char* name = 0;
+	unsigned int typeLength = 0U;
+	unsigned int nameLength = 0U;
+	unsigned int index = 0U;
+	GAE_BOOL isDuplicate = GAE_FALSE;
+
+	while (0 != (itr = strstr(itr, qualifier))) {
+		/* Must be a whole word */
+		if (((itr != source) && (isalnum((unsigned char)itr[-1]) || ('_' == itr[-1]))) || !isspace((unsigned char)itr[qualifierLength])) {
+			itr += qualifierLength;
+			continue;
+		}
+		itr += qualifierLength;
+
+		/* Skip any precision qualifiers to get to the type */
+		do {
+			while (isspace((unsigned char)*itr))
+				++itr;
+			type = itr;
+			while (isalnum((unsigned char)*itr) || ('_' == *itr))
+				++itr;
+			typeLength = (unsigned int)(itr - type);
+		} while (((4U == typeLength) && (0 == strncmp(type, "lowp", 4U)))
+			|| ((7U == typeLength) && (0 == strncmp(type, "mediump", 7U)))
+			|| ((5U == typeLength) && (0 == strncmp(type, "highp", 5U))));
+
+		while (isspace((unsigned char)*itr))
+			++itr;
+		name = itr;
+		while (isalnum((unsigned char)*itr) || ('_' == *itr))
+			++itr;
+		nameLength = (unsigned int)(itr - name);
+
+		if ((0U == nameLength) || (GAE_MOCKGL_MAX_NAME <= nameLength) || (GAE_MOCKGL_MAX_VARIABLES <= *count))
+			continue;
+
+		/* Uniforms may be declared in both stages */
+		isDuplicate = GAE_FALSE;
+		for (index = 0U; index < *count; ++index) {
+			if ((nameLength == strlen(variables[index].name)) && (0 == strncmp(variables[index].name, name, nameLength)))
+				isDuplicate = GAE_TRUE;
+		}
+		if (GAE_TRUE == isDuplicate)
+			continue;
+
+		memcpy(variables[*count].name, name, nameLength);
+		variables[*count].name[nameLength] = '\0';
+		variables[*count].type = typeFromName(type, typeLength);
+		variables[*count].size = 1;
+
+		while (isspace((unsigned char)*itr))
+			++itr;
+		if ('[' == *itr)
+			variables[*count].size = atoi(itr + 1);
+
+		++(*count);
+	}
+}
+
+GLenum typeFromName(const char* name, const unsigned int length) {
+	#define TYPE_IS(x) ((sizeof(x) - 1U == length) && (0 == strncmp(name, x, length)))
+
+	if (TYPE_IS("vec2"))
+		return GL_FLOAT_VEC2;
+	else if (TYPE_IS("vec3"))
+		return GL_FLOAT_VEC3;
+	else if (TYPE_IS("vec4"))
+		return GL_FLOAT_VEC4;
+	else if (TYPE_IS("mat2"))
+		return GL_FLOAT_MAT2;
+	else if (TYPE_IS("mat3"))
+		return GL_FLOAT_MAT3;
+	else if (TYPE_IS("mat4"))
+		return GL_FLOAT_MAT4;
+	else if (TYPE_IS("sampler2D"))
+		return GL_SAMPLER_2D;
+	else if (TYPE_IS("int"))
+		return GL_INT;
+
+	#undef TYPE_IS
+
+	return GL_FLOAT;
+}
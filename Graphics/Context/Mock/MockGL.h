@@ -0,0 +1,374 @@
+#ifndef _MOCK_GL_H_
+#define _MOCK_GL_H_
+
+/*
+	Headless recording GL backend.
+	Provides every GL entry point the engine uses as a software stub, so Graphics/ can be built and exercised without a GLX/EGL context.
+	Object names and bound state are tracked, each call is appended to a per-frame command log, and draw/state/upload counters are kept for profiling.
+	Deleted names are handed out again, lowest first, as drivers do - a program deleted while in use keeps its name until it's replaced.
+*/
+
+#include <stddef.h>
+#include "../../../GAE_Types.h"
+
+struct GAE_Array_s;
+
+typedef unsigned int GLenum;
+typedef unsigned int GLuint;
+typedef int GLint;
+typedef int GLsizei;
+typedef unsigned int GLbitfield;
+typedef unsigned char GLboolean;
+typedef signed char GLbyte;
+typedef unsigned char GLubyte;
+typedef short GLshort;
+typedef unsigned short GLushort;
+typedef float GLfloat;
+typedef float GLclampf;
+typedef char GLchar;
+typedef void GLvoid;
+typedef ptrdiff_t GLintptr;
+typedef ptrdiff_t GLsizeiptr;
+
+#define GL_FALSE					0
+#define GL_TRUE						1
+#define GL_NONE						0
+
+#define GL_NO_ERROR					0
+#define GL_INVALID_ENUM					0x0500
+#define GL_INVALID_VALUE				0x0501
+#define GL_INVALID_OPERATION				0x0502
+#define GL_OUT_OF_MEMORY				0x0505
+
+#define GL_POINTS					0x0000
+#define GL_LINES					0x0001
+#define GL_LINE_LOOP					0x0002
+#define GL_LINE_STRIP					0x0003
+#define GL_TRIANGLES					0x0004
+#define GL_TRIANGLE_STRIP				0x0005
+#define GL_TRIANGLE_FAN					0x0006
+
+#define GL_BYTE						0x1400
+#define GL_UNSIGNED_BYTE				0x1401
+#define GL_SHORT					0x1402
+#define GL_UNSIGNED_SHORT				0x1403
+#define GL_INT						0x1404
+#define GL_UNSIGNED_INT					0x1405
+#define GL_FLOAT					0x1406
+
+#define GL_DEPTH_BUFFER_BIT				0x00000100
+#define GL_STENCIL_BUFFER_BIT				0x00000400
+#define GL_COLOR_BUFFER_BIT				0x00004000
+
+#define GL_CULL_FACE					0x0B44
+#define GL_DEPTH_TEST					0x0B71
+#define GL_BLEND					0x0BE2
+#define GL_SCISSOR_TEST					0x0C11
+#define GL_TEXTURE_2D					0x0DE1
+
+#define GL_VIEWPORT					0x0BA2
+#define GL_MAX_TEXTURE_SIZE				0x0D33
+#define GL_UNPACK_ALIGNMENT				0x0CF5
+#define GL_PACK_ALIGNMENT				0x0D05
+
+#define GL_ZERO						0
+#define GL_ONE						1
+#define GL_SRC_COLOR					0x0300
+#define GL_ONE_MINUS_SRC_COLOR				0x0301
+#define GL_SRC_ALPHA					0x0302
+#define GL_ONE_MINUS_SRC_ALPHA				0x0303
+#define GL_DST_ALPHA					0x0304
+#define GL_ONE_MINUS_DST_ALPHA				0x0305
+#define GL_DST_COLOR					0x0306
+#define GL_ONE_MINUS_DST_COLOR				0x0307
+
+#define GL_FUNC_ADD					0x8006
+#define GL_BLEND_EQUATION				0x8009
+#define GL_FUNC_SUBTRACT				0x800A
+#define GL_FUNC_REVERSE_SUBTRACT			0x800B
+
+#define GL_NEVER					0x0200
+#define GL_LESS						0x0201
+#define GL_EQUAL					0x0202
+#define GL_LEQUAL					0x0203
+#define GL_GREATER					0x0204
+#define GL_NOTEQUAL					0x0205
+#define GL_GEQUAL					0x0206
+#define GL_ALWAYS					0x0207
+
+#define GL_FRONT					0x0404
+#define GL_BACK						0x0405
+#define GL_FRONT_AND_BACK				0x0408
+#define GL_CW						0x0900
+#define GL_CCW						0x0901
+
+#define GL_VENDOR					0x1F00
+#define GL_RENDERER					0x1F01
+#define GL_VERSION					0x1F02
+#define GL_EXTENSIONS					0x1F03
+
+#define GL_ALPHA					0x1906
+#define GL_RGB						0x1907
+#define GL_RGBA						0x1908
+#define GL_LUMINANCE					0x1909
+#define GL_LUMINANCE_ALPHA				0x190A
+
+#define GL_NEAREST					0x2600
+#define GL_LINEAR					0x2601
+#define GL_NEAREST_MIPMAP_NEAREST			0x2700
+#define GL_LINEAR_MIPMAP_NEAREST			0x2701
+#define GL_NEAREST_MIPMAP_LINEAR			0x2702
+#define GL_LINEAR_MIPMAP_LINEAR				0x2703
+#define GL_TEXTURE_MAG_FILTER				0x2800
+#define GL_TEXTURE_MIN_FILTER				0x2801
+#define GL_TEXTURE_WRAP_S				0x2802
+#define GL_TEXTURE_WRAP_T				0x2803
+#define GL_REPEAT					0x2901
+#define GL_CLAMP_TO_EDGE				0x812F
+
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT			0x83F0
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT		0x83F1
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT		0x83F3
+#define GL_ETC1_RGB8_OES				0x8D64
+
+#define GL_TEXTURE0					0x84C0
+#define GL_ACTIVE_TEXTURE				0x84E0
+#define GL_TEXTURE_BINDING_2D				0x8069
+#define GL_MAX_TEXTURE_IMAGE_UNITS			0x8872
+
+#define GL_ARRAY_BUFFER					0x8892
+#define GL_ELEMENT_ARRAY_BUFFER				0x8893
+#define GL_ARRAY_BUFFER_BINDING				0x8894
+#define GL_ELEMENT_ARRAY_BUFFER_BINDING			0x8895
+#define GL_STREAM_DRAW					0x88E0
+#define GL_STATIC_DRAW					0x88E4
+#define GL_DYNAMIC_DRAW					0x88E8
+#define GL_BUFFER_SIZE					0x8764
+#define GL_BUFFER_USAGE					0x8765
+#define GL_MAX_VERTEX_ATTRIBS				0x8869
+
+#define GL_FRAGMENT_SHADER				0x8B30
+#define GL_VERTEX_SHADER				0x8B31
+#define GL_FLOAT_VEC2					0x8B50
+#define GL_FLOAT_VEC3					0x8B51
+#define GL_FLOAT_VEC4					0x8B52
+#define GL_FLOAT_MAT2					0x8B5A
+#define GL_FLOAT_MAT3					0x8B5B
+#define GL_FLOAT_MAT4					0x8B5C
+#define GL_SAMPLER_2D					0x8B5E
+#define GL_DELETE_STATUS				0x8B80
+#define GL_COMPILE_STATUS				0x8B81
+#define GL_LINK_STATUS					0x8B82
+#define GL_INFO_LOG_LENGTH				0x8B84
+#define GL_ATTACHED_SHADERS				0x8B85
+#define GL_ACTIVE_UNIFORMS				0x8B86
+#define GL_ACTIVE_UNIFORM_MAX_LENGTH			0x8B87
+#define GL_SHADER_SOURCE_LENGTH				0x8B88
+#define GL_ACTIVE_ATTRIBUTES				0x8B89
+#define GL_ACTIVE_ATTRIBUTE_MAX_LENGTH			0x8B8A
+#define GL_CURRENT_PROGRAM				0x8B8D
+
+#define GL_PROGRAM_BINARY_LENGTH_OES			0x8741
+#define GL_NUM_PROGRAM_BINARY_FORMATS_OES		0x87FE
+#define GL_PROGRAM_BINARY_FORMATS_OES			0x87FF
+
+#define GL_FRAMEBUFFER					0x8D40
+#define GL_RENDERBUFFER					0x8D41
+#define GL_FRAMEBUFFER_BINDING				0x8CA6
+#define GL_RENDERBUFFER_BINDING				0x8CA7
+#define GL_FRAMEBUFFER_COMPLETE				0x8CD5
+#define GL_COLOR_ATTACHMENT0				0x8CE0
+#define GL_DEPTH_ATTACHMENT				0x8D00
+#define GL_STENCIL_ATTACHMENT				0x8D20
+#define GL_DEPTH_COMPONENT16				0x81A5
+
+/* Buffers */
+void glGenBuffers(GLsizei n, GLuint* buffers);
+void glDeleteBuffers(GLsizei n, const GLuint* buffers);
+GLboolean glIsBuffer(GLuint buffer);
+void glBindBuffer(GLenum target, GLuint buffer);
+void glBufferData(GLenum target, GLsizeiptr size, const GLvoid* data, GLenum usage);
+void glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const GLvoid* data);
+
+/* Vertex Attributes and Drawing */
+void glVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const GLvoid* pointer);
+void glEnableVertexAttribArray(GLuint index);
+void glDisableVertexAttribArray(GLuint index);
+void glDrawArrays(GLenum mode, GLint first, GLsizei count);
+void glDrawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid* indices);
+
+/* Shaders and Programs */
+GLuint glCreateShader(GLenum type);
+void glDeleteShader(GLuint shader);
+void glShaderSource(GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length);
+void glCompileShader(GLuint shader);
+void glGetShaderiv(GLuint shader, GLenum pname, GLint* params);
+void glGetShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog);
+GLuint glCreateProgram(void);
+void glDeleteProgram(GLuint program);
+void glAttachShader(GLuint program, GLuint shader);
+void glDetachShader(GLuint program, GLuint shader);
+void glLinkProgram(GLuint program);
+void glUseProgram(GLuint program);
+void glGetProgramiv(GLuint program, GLenum pname, GLint* params);
+void glGetProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog);
+void glGetProgramBinaryOES(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, GLvoid* binary);
+void glProgramBinaryOES(GLuint program, GLenum binaryFormat, const GLvoid* binary, GLint length);
+void glGetActiveAttrib(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name);
+void glGetActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name);
+GLint glGetAttribLocation(GLuint program, const GLchar* name);
+GLint glGetUniformLocation(GLuint program, const GLchar* name);
+void glUniform1i(GLint location, GLint v0);
+void glUniform1f(GLint location, GLfloat v0);
+void glUniform2fv(GLint location, GLsizei count, const GLfloat* value);
+void glUniform3fv(GLint location, GLsizei count, const GLfloat* value);
+void glUniform4fv(GLint location, GLsizei count, const GLfloat* value);
+void glUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value);
+
+/* Textures */
+void glGenTextures(GLsizei n, GLuint* textures);
+void glDeleteTextures(GLsizei n, const GLuint* textures);
+GLboolean glIsTexture(GLuint texture);
+void glActiveTexture(GLenum texture);
+void glBindTexture(GLenum target, GLuint texture);
+void glTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const GLvoid* pixels);
+void glTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid* pixels);
+void glCompressedTexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const GLvoid* data);
+void glTexParameteri(GLenum target, GLenum pname, GLint param);
+void glGenerateMipmap(GLenum target);
+void glPixelStorei(GLenum pname, GLint param);
+
+/* Framebuffers and Renderbuffers */
+void glGenFramebuffers(GLsizei n, GLuint* framebuffers);
+void glDeleteFramebuffers(GLsizei n, const GLuint* framebuffers);
+void glBindFramebuffer(GLenum target, GLuint framebuffer);
+void glFramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level);
+void glFramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer);
+GLenum glCheckFramebufferStatus(GLenum target);
+void glGenRenderbuffers(GLsizei n, GLuint* renderbuffers);
+void glDeleteRenderbuffers(GLsizei n, const GLuint* renderbuffers);
+void glBindRenderbuffer(GLenum target, GLuint renderbuffer);
+void glRenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height);
+
+/* Fixed State */
+void glEnable(GLenum cap);
+void glDisable(GLenum cap);
+GLboolean glIsEnabled(GLenum cap);
+void glBlendFunc(GLenum sfactor, GLenum dfactor);
+void glBlendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha);
+void glBlendEquation(GLenum mode);
+void glDepthFunc(GLenum func);
+void glDepthMask(GLboolean flag);
+void glCullFace(GLenum mode);
+void glFrontFace(GLenum mode);
+void glViewport(GLint x, GLint y, GLsizei width, GLsizei height);
+void glScissor(GLint x, GLint y, GLsizei width, GLsizei height);
+void glClearColor(GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha);
+void glClear(GLbitfield mask);
+void glFlush(void);
+void glFinish(void);
+
+/* Queries */
+GLenum glGetError(void);
+const GLubyte* glGetString(GLenum name);
+void glGetIntegerv(GLenum pname, GLint* params);
+
+/* Recorded command types - one per GL entry point that is logged */
+typedef enum GAE_MockGL_CommandType_e {
+	GAE_MOCKGL_COMMAND_GEN_BUFFER
+,	GAE_MOCKGL_COMMAND_DELETE_BUFFER
+,	GAE_MOCKGL_COMMAND_BIND_BUFFER
+,	GAE_MOCKGL_COMMAND_BUFFER_DATA
+,	GAE_MOCKGL_COMMAND_BUFFER_SUB_DATA
+,	GAE_MOCKGL_COMMAND_VERTEX_ATTRIB_POINTER
+,	GAE_MOCKGL_COMMAND_ENABLE_VERTEX_ATTRIB
+,	GAE_MOCKGL_COMMAND_DISABLE_VERTEX_ATTRIB
+,	GAE_MOCKGL_COMMAND_DRAW_ARRAYS
+,	GAE_MOCKGL_COMMAND_DRAW_ELEMENTS
+,	GAE_MOCKGL_COMMAND_CREATE_SHADER
+,	GAE_MOCKGL_COMMAND_DELETE_SHADER
+,	GAE_MOCKGL_COMMAND_COMPILE_SHADER
+,	GAE_MOCKGL_COMMAND_CREATE_PROGRAM
+,	GAE_MOCKGL_COMMAND_DELETE_PROGRAM
+,	GAE_MOCKGL_COMMAND_LINK_PROGRAM
+,	GAE_MOCKGL_COMMAND_PROGRAM_BINARY
+,	GAE_MOCKGL_COMMAND_USE_PROGRAM
+,	GAE_MOCKGL_COMMAND_UNIFORM
+,	GAE_MOCKGL_COMMAND_GEN_TEXTURE
+,	GAE_MOCKGL_COMMAND_DELETE_TEXTURE
+,	GAE_MOCKGL_COMMAND_ACTIVE_TEXTURE
+,	GAE_MOCKGL_COMMAND_BIND_TEXTURE
+,	GAE_MOCKGL_COMMAND_TEX_IMAGE
+,	GAE_MOCKGL_COMMAND_TEX_SUB_IMAGE
+,	GAE_MOCKGL_COMMAND_COMPRESSED_TEX_IMAGE
+,	GAE_MOCKGL_COMMAND_TEX_PARAMETER
+,	GAE_MOCKGL_COMMAND_GENERATE_MIPMAP
+,	GAE_MOCKGL_COMMAND_BIND_FRAMEBUFFER
+,	GAE_MOCKGL_COMMAND_BIND_RENDERBUFFER
+,	GAE_MOCKGL_COMMAND_ENABLE
+,	GAE_MOCKGL_COMMAND_DISABLE
+,	GAE_MOCKGL_COMMAND_BLEND_FUNC
+,	GAE_MOCKGL_COMMAND_BLEND_EQUATION
+,	GAE_MOCKGL_COMMAND_DEPTH_FUNC
+,	GAE_MOCKGL_COMMAND_DEPTH_MASK
+,	GAE_MOCKGL_COMMAND_CULL_FACE
+,	GAE_MOCKGL_COMMAND_FRONT_FACE
+,	GAE_MOCKGL_COMMAND_VIEWPORT
+,	GAE_MOCKGL_COMMAND_SCISSOR
+,	GAE_MOCKGL_COMMAND_CLEAR_COLOUR
+,	GAE_MOCKGL_COMMAND_CLEAR
+} GAE_MockGL_CommandType;
+
+/* A single recorded GL call. params holds the call's integer arguments in declaration order. */
+typedef struct GAE_MockGL_Command_s {
+	GAE_MockGL_CommandType type;
+	unsigned int params[4];
+} GAE_MockGL_Command_t;
+
+/* Counters gathered since the last endFrame (or since reset for the totals) */
+typedef struct GAE_MockGL_Stats_s {
+	unsigned int drawCalls;
+	unsigned int vertices;
+	unsigned int stateChanges;
+	unsigned long bufferBytes;
+	unsigned long textureBytes;
+	unsigned int compiles;			/* shaders compiled and programs linked from source */
+} GAE_MockGL_Stats_t;
+
+/* Destroys every tracked object, clears bound state, counters and the command log. */
+void GAE_MockGL_reset(void);
+
+/* Closes off the current frame - its counters become the last frame's counters and the command log is cleared. */
+void GAE_MockGL_endFrame(void);
+
+/* Returns the counters for the frame currently being recorded. */
+GAE_MockGL_Stats_t* GAE_MockGL_getFrameStats(void);
+
+/* Returns the counters for the last completed frame. */
+GAE_MockGL_Stats_t* GAE_MockGL_getLastFrameStats(void);
+
+/* Returns the counters accumulated since the last reset. */
+GAE_MockGL_Stats_t* GAE_MockGL_getTotalStats(void);
+
+/* Returns the command log for the current frame as an Array of GAE_MockGL_Command_t. This should NOT be freed. */
+struct GAE_Array_s* GAE_MockGL_getCommandLog(void);
+
+/* Enables or disables command recording - counters are always kept. */
+void GAE_MockGL_setRecording(const GAE_BOOL isRecording);
+
+/* Keeps a copy of every texture level uploaded from here on, compressed or not, so what reached GL can be checked - off by default. */
+void GAE_MockGL_setKeepingImages(const GAE_BOOL isKeepingImages);
+
+/* Returns the kept copy of a level as it was uploaded, with its format - the internal format for compressed ones - and size, or 0 if none is kept. */
+const GAE_BYTE* GAE_MockGL_getTextureImage(const GLuint name, const GLint level, GLenum* format, unsigned long* size);
+
+/* Sets the string returned by glGetString(GL_EXTENSIONS), so extension dependant paths can be exercised. */
+void GAE_MockGL_setExtensions(const char* extensions);
+
+/* Sets the string returned by glGetString(GL_RENDERER), to stand in for a driver change. */
+void GAE_MockGL_setRenderer(const char* renderer);
+
+/* Makes every shader compile and program link take at least this long, to stand in for a real driver's cost. */
+void GAE_MockGL_setCompileTime(const unsigned int microseconds);
+
+#endif
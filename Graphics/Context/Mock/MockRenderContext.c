@@ -0,0 +1,55 @@
+#include "MockRenderContext.h"
+
+#include "../../Window/RenderWindow.h"
+#include <stdlib.h>
+
+GAE_RenderContext_t* GAE_RenderContext_create(void) {
+	GAE_RenderContext_t* context = malloc(sizeof(GAE_RenderContext_t));
+
+	context->window = 0;
+	context->isCurrent = GAE_FALSE;
+
+	return context;
+}
+
+void GAE_RenderContext_delete(GAE_RenderContext_t* context) {
+	if (GAE_TRUE == context->isCurrent)
+		GAE_RenderContext_shutdown(context);
+
+	free(context);
+	context = 0;
+}
+
+GAE_RenderContext_t* GAE_RenderContext_init(GAE_RenderContext_t* context) {
+	GAE_MockGL_reset();
+	context->isCurrent = GAE_TRUE;
+
+	glViewport(0, 0, context->window->width, context->window->height);
+	glScissor(0, 0, context->window->width, context->window->height);
+
+	glClearColor(0.4F, 0.4F, 0.4F, 0.0F);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+	return context;
+}
+
+GAE_RenderContext_t* GAE_RenderContext_shutdown(GAE_RenderContext_t* context) {
+	context->isCurrent = GAE_FALSE;
+
+	return context;
+}
+
+GAE_RenderContext_t* GAE_RenderContext_update(GAE_RenderContext_t* context) {
+	/* the clear needs the whole screen, but the scissor test is put back as it was so the render state's shadow of it holds */
+	const GLboolean isScissorEnabled = glIsEnabled(GL_SCISSOR_TEST);
+	glDisable(GL_SCISSOR_TEST);
+
+	/* Stands in for the buffer swap - closes off this frame's counters and command log */
+	GAE_MockGL_endFrame();
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+	if (GL_FALSE != isScissorEnabled)
+		glEnable(GL_SCISSOR_TEST);
+
+	return context;
+}
@@ -0,0 +1,20 @@
+#ifndef _MOCK_RENDER_CONTEXT_H_
+#define _MOCK_RENDER_CONTEXT_H_
+
+#include "MockGL.h"
+
+struct GAE_RenderWindow_s;
+
+typedef struct GAE_RenderContext_s {
+	struct GAE_RenderWindow_s* window;
+	GAE_BOOL isCurrent;
+} GAE_RenderContext_t;
+
+GAE_RenderContext_t* GAE_RenderContext_create(void);
+GAE_RenderContext_t* GAE_RenderContext_init(GAE_RenderContext_t* context);
+GAE_RenderContext_t* GAE_RenderContext_update(GAE_RenderContext_t* context);
+GAE_RenderContext_t* GAE_RenderContext_shutdown(GAE_RenderContext_t* context);
+void GAE_RenderContext_delete(GAE_RenderContext_t* context);
+
+
+#endif
@@ -9,6 +9,8 @@
 #include "Android/AndroidRenderContext.h"
 #elif defined(PANDORA)
 #include "Pandora/PandoraRenderContext.h"
+#elif defined(MOCKGL)
+#include "Mock/MockRenderContext.h"
 #endif
 
 #endif
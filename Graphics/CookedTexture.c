@@ -0,0 +1,64 @@
+#include "CookedTexture.h"
+
+#include <string.h>
+
+static unsigned int readUint32(const GAE_BYTE* data);
+
+GAE_BOOL GAE_CookedTexture_parse(GAE_CookedTexture_t* texture, const GAE_BYTE* const buffer, const unsigned long size) {
+	unsigned int level = 0U;
+
+	memset(texture, 0, sizeof(GAE_CookedTexture_t));
+
+	if ((GAE_COOKED_TEXTURE_HEADER_SIZE > size) || (0 != memcmp(buffer, "GTEX", 4U)))
+		return GAE_FALSE;
+
+	if (GAE_COOKED_TEXTURE_VERSION != readUint32(buffer + 4U))
+		return GAE_FALSE;
+
+	switch (readUint32(buffer + 8U)) {
+		case GAE_COOKED_TEXTURE_FORMAT_RGBA8:
+			texture->format = GAE_COOKED_TEXTURE_FORMAT_RGBA8;
+			break;
+		case GAE_COOKED_TEXTURE_FORMAT_RGB8:
+			texture->format = GAE_COOKED_TEXTURE_FORMAT_RGB8;
+			break;
+		default:
+			return GAE_FALSE;
+	}
+
+	texture->width = readUint32(buffer + 12U);
+	texture->height = readUint32(buffer + 16U);
+	texture->levelCount = readUint32(buffer + 20U);
+	texture->flags = readUint32(buffer + 24U);
+
+	if ((0U == texture->width) || (0U == texture->height) || (0U == texture->levelCount) || (GAE_COOKED_TEXTURE_MAX_LEVELS < texture->levelCount))
+		return GAE_FALSE;
+
+	if (GAE_COOKED_TEXTURE_HEADER_SIZE + texture->levelCount * 8U > size)
+		return GAE_FALSE;
+
+	for (level = 0U; level < texture->levelCount; ++level) {
+		GAE_CookedTexture_Level_t* current = &texture->levels[level];
+		const GAE_BYTE* entry = buffer + GAE_COOKED_TEXTURE_HEADER_SIZE + level * 8U;
+		const unsigned int offset = readUint32(entry);
+
+		current->width = (0U < (texture->width >> level)) ? texture->width >> level : 1U;
+		current->height = (0U < (texture->height >> level)) ? texture->height >> level : 1U;
+		current->size = readUint32(entry + 4U);
+		current->data = buffer + offset;
+
+		if ((current->size != GAE_CookedTexture_getLevelSize(texture->format, current->width, current->height)) || ((unsigned long)offset + current->size > size))
+			return GAE_FALSE;
+	}
+
+	return GAE_TRUE;
+}
+
+unsigned int GAE_CookedTexture_getLevelSize(const GAE_CookedTexture_Format format, const unsigned int width, const unsigned int height) {
+	const unsigned int pixelSize = (GAE_COOKED_TEXTURE_FORMAT_RGB8 == format) ? 3U : 4U;
+	return ((width * pixelSize + 3U) & ~3U) * height;
+}
+
+unsigned int readUint32(const GAE_BYTE* data) {
+	return (unsigned int)data[0] | ((unsigned int)data[1] << 8U) | ((unsigned int)data[2] << 16U) | ((unsigned int)data[3] << 24U);
+}
@@ -0,0 +1,52 @@
+#ifndef _COOKED_TEXTURE_H_
+#define _COOKED_TEXTURE_H_
+
+#include "../GAE_Types.h"
+
+/*
+	Cooked textures hold raw pixels ready to hand to the GPU, all values little endian:
+	 0 - "GTEX"            16 - height
+	 4 - version           20 - level count
+	 8 - format            24 - flags
+	12 - width             28 - reserved
+	followed by an offset/size pair per level, with each level starting on a
+	GAE_COOKED_TEXTURE_ALIGNMENT boundary and every row padded to 4 bytes.
+*/
+
+#define GAE_COOKED_TEXTURE_VERSION 1U
+#define GAE_COOKED_TEXTURE_HEADER_SIZE 32U
+#define GAE_COOKED_TEXTURE_ALIGNMENT 16U
+#define GAE_COOKED_TEXTURE_MAX_LEVELS 16U
+
+typedef enum GAE_CookedTexture_Format_e {
+	GAE_COOKED_TEXTURE_FORMAT_RGBA8
+,	GAE_COOKED_TEXTURE_FORMAT_RGB8
+} GAE_CookedTexture_Format;
+
+typedef enum GAE_CookedTexture_Flags_e {
+	GAE_COOKED_TEXTURE_FLAG_PREMULTIPLIED = 1
+} GAE_CookedTexture_Flags;
+
+typedef struct GAE_CookedTexture_Level_s {
+	const GAE_BYTE* data; /* points into the cooked buffer */
+	unsigned int size;
+	unsigned int width;
+	unsigned int height;
+} GAE_CookedTexture_Level_t;
+
+typedef struct GAE_CookedTexture_s {
+	GAE_CookedTexture_Format format;
+	unsigned int width;
+	unsigned int height;
+	unsigned int flags;
+	unsigned int levelCount;
+	GAE_CookedTexture_Level_t levels[GAE_COOKED_TEXTURE_MAX_LEVELS];
+} GAE_CookedTexture_t;
+
+/* Parses a cooked texture held in memory - the levels point into the buffer, so it must outlive the texture. */
+GAE_BOOL GAE_CookedTexture_parse(GAE_CookedTexture_t* texture, const GAE_BYTE* const buffer, const unsigned long size);
+
+/* Returns the size in bytes of a level with its rows padded to 4 bytes. */
+unsigned int GAE_CookedTexture_getLevelSize(const GAE_CookedTexture_Format format, const unsigned int width, const unsigned int height);
+
+#endif
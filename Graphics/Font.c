@@ -0,0 +1,494 @@
+#include "Font.h"
+
+#include "Material.h"
+#include "Shader.h"
+#include "Texture.h"
+#include "../File/File.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static GAE_BYTE* readFile(const char* const filePath, unsigned long* size);
+static const char* findLineEnd(const char* cursor, const char* end);
+static GAE_BOOL isTag(const char* line, const char* lineEnd, const char* tag);
+static GAE_BOOL nextPair(const char** cursor, const char* end, const char** key, unsigned int* keyLength, const char** value, unsigned int* valueLength);
+static GAE_BOOL isKey(const char* key, const unsigned int keyLength, const char* name);
+static int parseInt(const char* value, const unsigned int length);
+static GAE_BOOL parse(GAE_Font_t* font, const char* text, const unsigned long size, const char* const filePath);
+static void parseGlyph(GAE_Font_Glyph_t* glyph, const char* cursor, const char* end);
+static void parseKerning(GAE_Font_Kerning_t* kerning, const char* cursor, const char* end);
+static void parsePage(GAE_Font_t* font, const char* cursor, const char* end, const char* const filePath);
+static void buildGlyphTable(GAE_Font_t* font);
+static int compareKerning(const void* a, const void* b);
+static void evictPage(GAE_Font_t* font, const unsigned int keep);
+static void releasePage(GAE_Font_t* font, GAE_Font_Page_t* page);
+static GAE_Shader_t* createShader(void);
+
+GAE_Font_t* GAE_Font_create(const char* const filePath, GAE_BOOL* status) {
+	GAE_Font_t* font = malloc(sizeof(GAE_Font_t));
+	unsigned long size = 0UL;
+	GAE_BYTE* text = readFile(filePath, &size);
+	GAE_BOOL isParsed = GAE_FALSE;
+
+	memset(font, 0, sizeof(GAE_Font_t));
+	font->maxResidentPages = GAE_FONT_DEFAULT_RESIDENT_PAGES;
+
+	if (0 != text) {
+		isParsed = parse(font, (const char*)text, size, filePath);
+		free(text);
+	}
+
+	if (GAE_TRUE == isParsed) {
+		buildGlyphTable(font);
+		font->shader = createShader();
+	}
+
+	if (0 != status)
+		*status = isParsed;
+
+	return font;
+}
+
+const GAE_Font_Glyph_t* GAE_Font_getGlyph(GAE_Font_t* const font, const unsigned int codepoint) {
+	unsigned int slot = 0U;
+
+	if (0 == font->glyphTable)
+		return 0;
+
+	slot = (codepoint * 2654435761U) & font->glyphTableMask;
+	while (0U != font->glyphTable[slot]) {
+		const GAE_Font_Glyph_t* glyph = font->glyphs + font->glyphTable[slot] - 1U;
+		if (codepoint == glyph->codepoint)
+			return glyph;
+		slot = (slot + 1U) & font->glyphTableMask;
+	}
+
+	return 0;
+}
+
+int GAE_Font_getKerning(GAE_Font_t* const font, const unsigned int first, const unsigned int second) {
+	unsigned int low = 0U;
+	unsigned int high = font->kerningCount;
+
+	while (low < high) {
+		const unsigned int middle = low + (high - low) / 2U;
+		const GAE_Font_Kerning_t* kerning = font->kernings + middle;
+
+		if ((kerning->first < first) || ((kerning->first == first) && (kerning->second < second)))
+			low = middle + 1U;
+		else
+			high = middle;
+	}
+
+	if ((low < font->kerningCount) && (first == font->kernings[low].first) && (second == font->kernings[low].second))
+		return font->kernings[low].amount;
+
+	return 0;
+}
+
+GAE_Material_t* GAE_Font_usePage(GAE_Font_t* font, const unsigned int page) {
+	GAE_Font_Page_t* fontPage = 0;
+	GAE_Texture_t* texture = 0;
+
+	if (page >= font->pageCount)
+		return 0;
+
+	fontPage = font->pages + page;
+	fontPage->lastUsed = ++font->useCounter;
+
+	if (0 != fontPage->material)
+		return fontPage->material;
+
+	if ((GAE_TRUE == fontPage->hasFailed) || (0 == fontPage->filePath))
+		return 0;
+
+	if ((0U != font->maxResidentPages) && (font->residentPages >= font->maxResidentPages))
+		evictPage(font, page);
+
+	texture = GAE_Texture_createFromFile(GAE_File_create(fontPage->filePath));
+	#if defined(GLES2) || defined(GLX) || defined(MOCKGL)
+		((GAE_GL_Texture_t*)texture->platform)->format = GAE_GL_TEXTURE_FORMAT_RGBA;
+		((GAE_GL_Texture_t*)texture->platform)->filter = GAE_GL_TEXTURE_FILTER_NONE;
+	#endif
+
+	if (GAE_FALSE == GAE_Texture_load(texture, GAE_FALSE)) {
+		GAE_Texture_delete(texture);
+		fontPage->hasFailed = GAE_TRUE;
+		return 0;
+	}
+
+	fontPage->texture = texture;
+	fontPage->material = GAE_Material_create();
+	fontPage->material->shader = font->shader;
+	GAE_Material_addTexture(fontPage->material, texture);
+	++font->residentPages;
+
+	return fontPage->material;
+}
+
+void GAE_Font_delete(GAE_Font_t* font) {
+	unsigned int index = 0U;
+
+	for (index = 0U; index < font->pageCount; ++index) {
+		releasePage(font, font->pages + index);
+		free(font->pages[index].filePath);
+	}
+
+	if (0 != font->shader)
+		GAE_Shader_delete(font->shader);
+
+	free(font->pages);
+	free(font->kernings);
+	free(font->glyphTable);
+	free(font->glyphs);
+	free(font);
+	font = 0;
+}
+
+GAE_BYTE* readFile(const char* const filePath, unsigned long* size) {
+	GAE_File_t* file = GAE_File_create(filePath);
+	GAE_FILE_STATUS fileStatus = GAE_FILE_ERROR;
+	GAE_FILE_READ_STATUS readStatus = GAE_FILE_READ_ERROR;
+	GAE_BYTE* buffer = 0;
+
+	GAE_File_open(file, GAE_FILE_OPEN_READ, GAE_FILE_ASCII, &fileStatus);
+	if (GAE_FILE_OPEN == fileStatus)
+		GAE_File_read(file, GAE_FILE_READ_ALL, &readStatus);
+
+	if (GAE_FILE_READ_ERROR == readStatus) {
+		GAE_File_close(file, GAE_FILE_CLOSE_DELETE_DATA, 0);
+		GAE_File_delete(file);
+		return 0;
+	}
+
+	/* keep the buffer - the File only lends it */
+	buffer = file->buffer;
+	*size = file->bufferSize;
+
+	GAE_File_close(file, GAE_FILE_CLOSE_RETAIN_DATA, 0);
+	GAE_File_delete(file);
+	return buffer;
+}
+
+const char* findLineEnd(const char* cursor, const char* end) {
+	while ((cursor < end) && ('\n' != *cursor) && ('\r' != *cursor) && ('\0' != *cursor))
+		++cursor;
+	return cursor;
+}
+
+GAE_BOOL isTag(const char* line, const char* lineEnd, const char* tag) {
+	const unsigned int length = (unsigned int)strlen(tag);
+
+	if ((unsigned long)(lineEnd - line) <= length)
+		return GAE_FALSE;
+
+	return ((0 == memcmp(line, tag, length)) && ((' ' == line[length]) || ('\t' == line[length]))) ? GAE_TRUE : GAE_FALSE;
+}
+
+GAE_BOOL nextPair(const char** cursor, const char* end, const char** key, unsigned int* keyLength, const char** value, unsigned int* valueLength) {
+	const char* position = *cursor;
+
+	/* key=value or key="quoted value", separated by whitespace - bare words are skipped */
+	for (;;) {
+		while ((position < end) && ((' ' == *position) || ('\t' == *position)))
+			++position;
+
+		if (position >= end) {
+			*cursor = end;
+			return GAE_FALSE;
+		}
+
+		*key = position;
+		while ((position < end) && ('=' != *position) && (' ' != *position) && ('\t' != *position))
+			++position;
+		*keyLength = (unsigned int)(position - *key);
+
+		if ((position < end) && ('=' == *position))
+			break;
+	}
+
+	++position;
+	if ((position < end) && ('"' == *position)) {
+		*value = ++position;
+		while ((position < end) && ('"' != *position))
+			++position;
+		*valueLength = (unsigned int)(position - *value);
+		if (position < end)
+			++position;
+	}
+	else {
+		*value = position;
+		while ((position < end) && (' ' != *position) && ('\t' != *position))
+			++position;
+		*valueLength = (unsigned int)(position - *value);
+	}
+
+	*cursor = position;
+	return GAE_TRUE;
+}
+
+GAE_BOOL isKey(const char* key, const unsigned int keyLength, const char* name) {
+	return ((strlen(name) == keyLength) && (0 == memcmp(key, name, keyLength))) ? GAE_TRUE : GAE_FALSE;
+}
+
+int parseInt(const char* value, const unsigned int length) {
+	const GAE_BOOL isNegative = ((0U < length) && ('-' == value[0])) ? GAE_TRUE : GAE_FALSE;
+	unsigned int index = (GAE_TRUE == isNegative) ? 1U : 0U;
+	int result = 0;
+
+	for (; (index < length) && ('0' <= value[index]) && ('9' >= value[index]); ++index)
+		result = result * 10 + (value[index] - '0');
+
+	return (GAE_TRUE == isNegative) ? -result : result;
+}
+
+GAE_BOOL parse(GAE_Font_t* font, const char* text, const unsigned long size, const char* const filePath) {
+	const char* end = text + size;
+	const char* line = text;
+	unsigned int glyphCount = 0U;
+	unsigned int kerningCount = 0U;
+	GAE_BOOL hasCommon = GAE_FALSE;
+
+	/* count first, so everything is allocated once at its final size */
+	while (line < end) {
+		const char* lineEnd = findLineEnd(line, end);
+
+		if (GAE_TRUE == isTag(line, lineEnd, "char"))
+			++glyphCount;
+		else if (GAE_TRUE == isTag(line, lineEnd, "kerning"))
+			++kerningCount;
+		else if (GAE_TRUE == isTag(line, lineEnd, "common")) {
+			const char* cursor = line + 6;
+			const char* key = 0;
+			const char* value = 0;
+			unsigned int keyLength = 0U;
+			unsigned int valueLength = 0U;
+
+			while (GAE_TRUE == nextPair(&cursor, lineEnd, &key, &keyLength, &value, &valueLength)) {
+				if (GAE_TRUE == isKey(key, keyLength, "lineHeight"))
+					font->lineHeight = (unsigned int)parseInt(value, valueLength);
+				else if (GAE_TRUE == isKey(key, keyLength, "base"))
+					font->base = (unsigned int)parseInt(value, valueLength);
+				else if (GAE_TRUE == isKey(key, keyLength, "scaleW"))
+					font->scaleWidth = (unsigned int)parseInt(value, valueLength);
+				else if (GAE_TRUE == isKey(key, keyLength, "scaleH"))
+					font->scaleHeight = (unsigned int)parseInt(value, valueLength);
+				else if (GAE_TRUE == isKey(key, keyLength, "pages"))
+					font->pageCount = (unsigned int)parseInt(value, valueLength);
+			}
+
+			hasCommon = GAE_TRUE;
+		}
+
+		line = (lineEnd < end) ? lineEnd + 1 : end;
+	}
+
+	if ((GAE_FALSE == hasCommon) || (0U == glyphCount) || (0U == font->scaleWidth) || (0U == font->scaleHeight) || (0U == font->pageCount) || (0xFFFFU < font->pageCount))
+		return GAE_FALSE;
+
+	font->glyphs = calloc(glyphCount, sizeof(GAE_Font_Glyph_t));
+	font->kernings = (0U < kerningCount) ? calloc(kerningCount, sizeof(GAE_Font_Kerning_t)) : 0;
+	font->pages = calloc(font->pageCount, sizeof(GAE_Font_Page_t));
+
+	for (line = text; line < end;) {
+		const char* lineEnd = findLineEnd(line, end);
+
+		if ((GAE_TRUE == isTag(line, lineEnd, "char")) && (font->glyphCount < glyphCount))
+			parseGlyph(font->glyphs + font->glyphCount++, line + 4, lineEnd);
+		else if ((GAE_TRUE == isTag(line, lineEnd, "kerning")) && (font->kerningCount < kerningCount))
+			parseKerning(font->kernings + font->kerningCount++, line + 7, lineEnd);
+		else if (GAE_TRUE == isTag(line, lineEnd, "page"))
+			parsePage(font, line + 4, lineEnd, filePath);
+
+		line = (lineEnd < end) ? lineEnd + 1 : end;
+	}
+
+	if (1U < font->kerningCount)
+		qsort(font->kernings, font->kerningCount, sizeof(GAE_Font_Kerning_t), compareKerning);
+
+	return GAE_TRUE;
+}
+
+void parseGlyph(GAE_Font_Glyph_t* glyph, const char* cursor, const char* end) {
+	const char* key = 0;
+	const char* value = 0;
+	unsigned int keyLength = 0U;
+	unsigned int valueLength = 0U;
+
+	while (GAE_TRUE == nextPair(&cursor, end, &key, &keyLength, &value, &valueLength)) {
+		const int number = parseInt(value, valueLength);
+
+		if (GAE_TRUE == isKey(key, keyLength, "id"))
+			glyph->codepoint = (unsigned int)number;
+		else if (GAE_TRUE == isKey(key, keyLength, "x"))
+			glyph->x = (unsigned short)number;
+		else if (GAE_TRUE == isKey(key, keyLength, "y"))
+			glyph->y = (unsigned short)number;
+		else if (GAE_TRUE == isKey(key, keyLength, "width"))
+			glyph->width = (unsigned short)number;
+		else if (GAE_TRUE == isKey(key, keyLength, "height"))
+			glyph->height = (unsigned short)number;
+		else if (GAE_TRUE == isKey(key, keyLength, "xoffset"))
+			glyph->xOffset = (short)number;
+		else if (GAE_TRUE == isKey(key, keyLength, "yoffset"))
+			glyph->yOffset = (short)number;
+		else if (GAE_TRUE == isKey(key, keyLength, "xadvance"))
+			glyph->xAdvance = (short)number;
+		else if (GAE_TRUE == isKey(key, keyLength, "page"))
+			glyph->page = (unsigned short)number;
+	}
+}
+
+void parseKerning(GAE_Font_Kerning_t* kerning, const char* cursor, const char* end) {
+	const char* key = 0;
+	const char* value = 0;
+	unsigned int keyLength = 0U;
+	unsigned int valueLength = 0U;
+
+	while (GAE_TRUE == nextPair(&cursor, end, &key, &keyLength, &value, &valueLength)) {
+		if (GAE_TRUE == isKey(key, keyLength, "first"))
+			kerning->first = (unsigned int)parseInt(value, valueLength);
+		else if (GAE_TRUE == isKey(key, keyLength, "second"))
+			kerning->second = (unsigned int)parseInt(value, valueLength);
+		else if (GAE_TRUE == isKey(key, keyLength, "amount"))
+			kerning->amount = parseInt(value, valueLength);
+	}
+}
+
+void parsePage(GAE_Font_t* font, const char* cursor, const char* end, const char* const filePath) {
+	const char* key = 0;
+	const char* value = 0;
+	const char* fileName = 0;
+	unsigned int keyLength = 0U;
+	unsigned int valueLength = 0U;
+	unsigned int fileNameLength = 0U;
+	unsigned int directoryLength = 0U;
+	unsigned int id = 0xFFFFFFFFU;
+	unsigned int index = 0U;
+
+	while (GAE_TRUE == nextPair(&cursor, end, &key, &keyLength, &value, &valueLength)) {
+		if (GAE_TRUE == isKey(key, keyLength, "id"))
+			id = (unsigned int)parseInt(value, valueLength);
+		else if (GAE_TRUE == isKey(key, keyLength, "file")) {
+			fileName = value;
+			fileNameLength = valueLength;
+		}
+	}
+
+	if ((id >= font->pageCount) || (0 == fileName) || (0 != font->pages[id].filePath))
+		return;
+
+	/* page images sit next to the descriptor */
+	for (index = 0U; '\0' != filePath[index]; ++index) {
+		if (('/' == filePath[index]) || ('\\' == filePath[index]))
+			directoryLength = index + 1U;
+	}
+
+	font->pages[id].filePath = malloc(directoryLength + fileNameLength + 1U);
+	memcpy(font->pages[id].filePath, filePath, directoryLength);
+	memcpy(font->pages[id].filePath + directoryLength, fileName, fileNameLength);
+	font->pages[id].filePath[directoryLength + fileNameLength] = '\0';
+}
+
+void buildGlyphTable(GAE_Font_t* font) {
+	unsigned int tableSize = 16U;
+	unsigned int index = 0U;
+
+	/* at most half full, so probes stay short */
+	while (tableSize < font->glyphCount * 2U)
+		tableSize <<= 1U;
+
+	font->glyphTable = calloc(tableSize, sizeof(unsigned int));
+	font->glyphTableMask = tableSize - 1U;
+
+	for (index = 0U; index < font->glyphCount; ++index) {
+		const unsigned int codepoint = font->glyphs[index].codepoint;
+		unsigned int slot = (codepoint * 2654435761U) & font->glyphTableMask;
+
+		while (0U != font->glyphTable[slot]) {
+			if (codepoint == font->glyphs[font->glyphTable[slot] - 1U].codepoint)
+				break;
+			slot = (slot + 1U) & font->glyphTableMask;
+		}
+
+		/* the first definition of a codepoint wins */
+		if (0U == font->glyphTable[slot])
+			font->glyphTable[slot] = index + 1U;
+	}
+}
+
+int compareKerning(const void* a, const void* b) {
+	const GAE_Font_Kerning_t* first = (const GAE_Font_Kerning_t*)a;
+	const GAE_Font_Kerning_t* second = (const GAE_Font_Kerning_t*)b;
+
+	if (first->first != second->first)
+		return (first->first < second->first) ? -1 : 1;
+	if (first->second != second->second)
+		return (first->second < second->second) ? -1 : 1;
+	return 0;
+}
+
+void evictPage(GAE_Font_t* font, const unsigned int keep) {
+	GAE_Font_Page_t* oldest = 0;
+	unsigned int index = 0U;
+
+	for (index = 0U; index < font->pageCount; ++index) {
+		GAE_Font_Page_t* page = font->pages + index;
+
+		if ((keep == index) || (0 == page->material))
+			continue;
+
+		if ((0 == oldest) || (page->lastUsed < oldest->lastUsed))
+			oldest = page;
+	}
+
+	if (0 != oldest)
+		releasePage(font, oldest);
+}
+
+void releasePage(GAE_Font_t* font, GAE_Font_Page_t* page) {
+	if (0 != page->material) {
+		GAE_Material_delete(page->material);
+		page->material = 0;
+	}
+
+	if (0 != page->texture) {
+		GAE_Texture_delete(page->texture);
+		page->texture = 0;
+		--font->residentPages;
+	}
+}
+
+GAE_Shader_t* createShader(void) {
+	/* colours arrive as unnormalised bytes */
+	const char* vSource =
+		"attribute vec4 a_position;			\n\
+		attribute vec2 a_texCoord0;			\n\
+		attribute vec4 a_color;				\n\
+		varying vec2 v_texCoord0;			\n\
+		varying vec4 v_colour;				\n\
+		uniform mat4 u_mvp;					\n\
+		void main() {						\n\
+		gl_Position = u_mvp * a_position;	\n\
+		v_texCoord0 = a_texCoord0;			\n\
+		v_colour = a_color / 255.0;			\n\
+		}									\n";
+	const char* fSource =
+		"varying vec2 v_texCoord0;										\n\
+		varying vec4 v_colour;											\n\
+		uniform sampler2D s_texture0;									\n\
+		void main() {													\n\
+		gl_FragColor = texture2D(s_texture0, v_texCoord0) * v_colour;	\n\
+		}																\n";
+	GAE_File_t* vShader = GAE_File_create("font vertex shader");
+	GAE_File_t* fShader = GAE_File_create("font fragment shader");
+	GAE_Shader_t* shader = 0;
+
+	GAE_File_setBuffer(vShader, (GAE_BYTE*)vSource, strlen(vSource), GAE_FILE_BUFFER_OWNED, 0);
+	GAE_File_setBuffer(fShader, (GAE_BYTE*)fSource, strlen(fSource), GAE_FILE_BUFFER_OWNED, 0);
+	shader = GAE_Shader_create(vShader, fShader);
+	GAE_File_delete(vShader);
+	GAE_File_delete(fShader);
+
+	return shader;
+}
@@ -0,0 +1,79 @@
+#ifndef _FONT_H_
+#define _FONT_H_
+
+#include "../GAE_Types.h"
+
+/*
+	Bitmap fonts from BMFont (AngelCode) text descriptors.
+	Page textures are loaded when text first needs them, and only up to maxResidentPages stay loaded -
+	the least recently used page is dropped to make room, and loaded again if it is drawn later.
+	Glyph positions are in font pixels with y growing downwards, as BMFont lays them out.
+*/
+
+#define GAE_FONT_DEFAULT_RESIDENT_PAGES 4U
+
+struct GAE_Material_s;
+struct GAE_Shader_s;
+struct GAE_Texture_s;
+
+typedef struct GAE_Font_Glyph_s {
+	unsigned int codepoint;
+	unsigned short x;			/* position in the page, in pixels */
+	unsigned short y;
+	unsigned short width;
+	unsigned short height;
+	short xOffset;				/* from the pen position to the top left of the quad */
+	short yOffset;
+	short xAdvance;
+	unsigned short page;
+} GAE_Font_Glyph_t;
+
+typedef struct GAE_Font_Kerning_s {
+	unsigned int first;
+	unsigned int second;
+	int amount;
+} GAE_Font_Kerning_t;
+
+typedef struct GAE_Font_Page_s {
+	char* filePath;
+	struct GAE_Texture_s* texture;		/* 0 while not resident */
+	struct GAE_Material_s* material;
+	unsigned int lastUsed;
+	GAE_BOOL hasFailed;					/* the image couldn't be loaded - not retried every draw */
+} GAE_Font_Page_t;
+
+typedef struct GAE_Font_s {
+	GAE_Font_Glyph_t* glyphs;
+	unsigned int glyphCount;
+	unsigned int* glyphTable;			/* open addressed codepoint lookup, glyph index + 1 with 0 empty */
+	unsigned int glyphTableMask;
+	GAE_Font_Kerning_t* kernings;		/* sorted by first then second */
+	unsigned int kerningCount;
+	GAE_Font_Page_t* pages;
+	unsigned int pageCount;
+	unsigned int residentPages;
+	unsigned int maxResidentPages;		/* 0 keeps every page once loaded */
+	unsigned int useCounter;
+	unsigned int lineHeight;
+	unsigned int base;					/* from the top of a line to the baseline */
+	unsigned int scaleWidth;			/* page size, for texture coordinates */
+	unsigned int scaleHeight;
+	struct GAE_Shader_s* shader;
+} GAE_Font_t;
+
+/* Loads a BMFont text descriptor - page images are found relative to it. */
+GAE_Font_t* GAE_Font_create(const char* const filePath, GAE_BOOL* status);
+
+/* Returns the glyph for codepoint, or 0 if the font doesn't have one. */
+const GAE_Font_Glyph_t* GAE_Font_getGlyph(GAE_Font_t* const font, const unsigned int codepoint);
+
+/* Returns how far to move the pen between first and second, on top of the first's advance. */
+int GAE_Font_getKerning(GAE_Font_t* const font, const unsigned int first, const unsigned int second);
+
+/* Makes sure page is loaded, evicting the least recently used page if over budget. Returns the material to draw it with, or 0 if it couldn't be loaded. */
+struct GAE_Material_s* GAE_Font_usePage(GAE_Font_t* font, const unsigned int page);
+
+/* Deletes the Font and any resident pages. */
+void GAE_Font_delete(GAE_Font_t* font);
+
+#endif
@@ -3,7 +3,9 @@
 #include <string.h>
 #include <stdlib.h>
 
-#if defined(LINUX)
+#if defined(MOCKGL)
+	#include "Context/Mock/MockGL.h"
+#elif defined(LINUX)
 	#include "Context/GLX/GLee.h"
 #elif defined(GLES1)
 	#if defined(PANDORA) || defined(ANDROID)
@@ -15,7 +17,19 @@
 	#endif
 #endif
 
+static unsigned int unshadowedChanges = 0U;
+
 GAE_IndexBuffer_t* GAE_IndexBuffer_create(GAE_BYTE* const data, const unsigned int count, const GAE_IndexBuffer_IndexType type, const GAE_IndexBuffer_Format format, const GAE_IndexBuffer_Draw drawType) {
+	GAE_IndexBuffer_t* buffer = GAE_IndexBuffer_createNotOwned(0, count, type, format, drawType);
+
+	buffer->data = malloc(buffer->size);
+	buffer->owned = GAE_TRUE;
+	memcpy(buffer->data, data, buffer->size);
+
+	return buffer;
+}
+
+GAE_IndexBuffer_t* GAE_IndexBuffer_createNotOwned(GAE_BYTE* const data, const unsigned int count, const GAE_IndexBuffer_IndexType type, const GAE_IndexBuffer_Format format, const GAE_IndexBuffer_Draw drawType) {
 	GAE_IndexBuffer_t* buffer = malloc(sizeof(GAE_IndexBuffer_t));
 	buffer->count = count;
 	buffer->size = count;
@@ -24,6 +38,8 @@ GAE_IndexBuffer_t* GAE_IndexBuffer_create(GAE_BYTE* const data, const unsigned i
 	buffer->draw = drawType;
 	buffer->updateData = 0;
 	buffer->vboId = 0;
+	buffer->owned = GAE_FALSE;
+	buffer->data = data;
 
 	switch (type) {
 		case GAE_INDEXBUFFER_INDEX_FLOAT:
@@ -35,13 +51,13 @@ GAE_IndexBuffer_t* GAE_IndexBuffer_create(GAE_BYTE* const data, const unsigned i
 		case GAE_INDEXBUFFER_INDEX_UNSIGNED_SHORT:
 			buffer->size = count * sizeof(unsigned short);
 			break;
+		case GAE_INDEXBUFFER_INDEX_UNSIGNED_INT:
+			buffer->size = count * sizeof(unsigned int);
+			break;
 		default:
 			break;
 	};
 
-	buffer->data = malloc(buffer->size);
-	memcpy(buffer->data, data, buffer->size);
-
 	return buffer;
 }
 
@@ -54,6 +70,7 @@ GAE_IndexBuffer_t* GAE_IndexBuffer_clone(GAE_IndexBuffer_t* const buffer) {
 	newBuffer->draw = buffer->draw;
 	newBuffer->updateData = 0;
 	newBuffer->vboId = 0;
+	newBuffer->owned = GAE_TRUE;
 
 	newBuffer->data = malloc(newBuffer->size);
 	memcpy(newBuffer->data, buffer->data, newBuffer->size);
@@ -62,7 +79,7 @@ GAE_IndexBuffer_t* GAE_IndexBuffer_clone(GAE_IndexBuffer_t* const buffer) {
 }
 
 void GAE_IndexBuffer_delete(GAE_IndexBuffer_t* buffer) {
-	if (0 != buffer->data) {
+	if ((0 != buffer->data) && (GAE_TRUE == buffer->owned)) {
 		free(buffer->data);
 		buffer->data = 0;
 	}
@@ -71,6 +88,7 @@ void GAE_IndexBuffer_delete(GAE_IndexBuffer_t* buffer) {
 		glDeleteBuffers(1, buffer->vboId);
 		free(buffer->vboId);
 		buffer->vboId = 0;
+		++unshadowedChanges;
 	}
 
 	if (0 != buffer->updateData) {
@@ -85,3 +103,7 @@ void GAE_IndexBuffer_delete(GAE_IndexBuffer_t* buffer) {
 	free(buffer);
 	buffer = 0;
 }
+
+unsigned int GAE_IndexBuffer_getUnshadowedChanges(void) {
+	return unshadowedChanges;
+}
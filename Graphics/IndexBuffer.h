@@ -17,7 +17,7 @@ typedef enum GAE_IndexBuffer_Draw_e {
 } GAE_IndexBuffer_Draw;
 			
 typedef enum GAE_IndexBuffer_IndexType_e {
-	GAE_INDEXBUFFER_INDEX_FLOAT		/* unsupported by ES 1 */
+	GAE_INDEXBUFFER_INDEX_FLOAT		/* not a valid GL index type - kept for compatibility, never drawn */
 ,	GAE_INDEXBUFFER_INDEX_UNSIGNED_BYTE
 ,	GAE_INDEXBUFFER_INDEX_UNSIGNED_SHORT
 ,	GAE_INDEXBUFFER_INDEX_UNSIGNED_INT	/* unsupported by unextended ES variants. */
@@ -38,6 +38,7 @@ typedef struct GAE_IndexBuffer_s {
 	unsigned int size;
 	GAE_BYTE* data;
 	unsigned int* vboId;
+	GAE_BOOL owned; /* data is freed with the buffer */
 	GAE_IndexBuffer_Format format;
 	GAE_IndexBuffer_IndexType type;
 	GAE_IndexBuffer_Draw draw;
@@ -45,7 +46,12 @@ typedef struct GAE_IndexBuffer_s {
 } GAE_IndexBuffer_t;
 
 GAE_IndexBuffer_t* GAE_IndexBuffer_create(GAE_BYTE* const data, const unsigned int count, const GAE_IndexBuffer_IndexType type, const GAE_IndexBuffer_Format format, const GAE_IndexBuffer_Draw drawType);
+/* Wraps data without copying it - it must outlive the buffer, and is not freed with it. */
+GAE_IndexBuffer_t* GAE_IndexBuffer_createNotOwned(GAE_BYTE* const data, const unsigned int count, const GAE_IndexBuffer_IndexType type, const GAE_IndexBuffer_Format format, const GAE_IndexBuffer_Draw drawType);
 GAE_IndexBuffer_t* GAE_IndexBuffer_clone(GAE_IndexBuffer_t* const buffer);
 void GAE_IndexBuffer_delete(GAE_IndexBuffer_t* buffer);
 
+/* Counts the uploaded index buffers deleted, as GAE_VertexBuffer_getUnshadowedChanges does for vertex buffers. */
+unsigned int GAE_IndexBuffer_getUnshadowedChanges(void);
+
 #endif
@@ -0,0 +1,167 @@
+#include "MeshFile.h"
+
+#include "Mesh.h"
+#include "VertexBuffer.h"
+#include "IndexBuffer.h"
+#include "../File/File.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static unsigned int readUint32(const GAE_BYTE* data);
+static GAE_BOOL loadFile(GAE_MeshFile_t* meshFile, const char* const filePath);
+static GAE_BOOL parse(GAE_MeshFile_t* meshFile);
+
+GAE_MeshFile_t* GAE_MeshFile_create(const char* const filePath, GAE_BOOL* status) {
+	GAE_MeshFile_t* meshFile = GAE_MeshFile_createFromBuffer(0, 0UL, 0);
+	GAE_BOOL isLoaded = loadFile(meshFile, filePath);
+
+	if (GAE_TRUE == isLoaded)
+		isLoaded = parse(meshFile);
+
+	if (0 != status)
+		*status = isLoaded;
+
+	return meshFile;
+}
+
+GAE_MeshFile_t* GAE_MeshFile_createFromBuffer(GAE_BYTE* const buffer, const unsigned long size, GAE_BOOL* status) {
+	GAE_MeshFile_t* meshFile = malloc(sizeof(GAE_MeshFile_t));
+	GAE_BOOL isParsed = GAE_FALSE;
+
+	meshFile->data = buffer;
+	meshFile->size = size;
+	meshFile->file = 0;
+	meshFile->vertexBuffer = 0;
+	meshFile->indexBuffer = 0;
+
+	isParsed = parse(meshFile);
+	if (0 != status)
+		*status = isParsed;
+
+	return meshFile;
+}
+
+GAE_Mesh_t* GAE_MeshFile_createMesh(GAE_MeshFile_t* const meshFile, struct GAE_Material_s* const material) {
+	if ((0 == meshFile->vertexBuffer) || (0 == meshFile->indexBuffer))
+		return 0;
+
+	return GAE_Mesh_create(meshFile->vertexBuffer, meshFile->indexBuffer, material);
+}
+
+void GAE_MeshFile_delete(GAE_MeshFile_t* meshFile) {
+	if (0 != meshFile->vertexBuffer)
+		GAE_VertexBuffer_delete(meshFile->vertexBuffer);
+
+	if (0 != meshFile->indexBuffer)
+		GAE_IndexBuffer_delete(meshFile->indexBuffer);
+
+	if (0 != meshFile->file) {
+		GAE_File_deleteBuffer(meshFile->file, 0);
+		GAE_File_delete(meshFile->file);
+	}
+
+	free(meshFile);
+	meshFile = 0;
+}
+
+unsigned int readUint32(const GAE_BYTE* data) {
+	return (unsigned int)data[0] | ((unsigned int)data[1] << 8U) | ((unsigned int)data[2] << 16U) | ((unsigned int)data[3] << 24U);
+}
+
+GAE_BOOL loadFile(GAE_MeshFile_t* meshFile, const char* const filePath) {
+	GAE_File_t* file = GAE_File_create(filePath);
+	GAE_FILE_STATUS fileStatus = GAE_FILE_ERROR;
+	GAE_FILE_READ_STATUS readStatus = GAE_FILE_READ_ERROR;
+
+	/* mapped and read whole in one go - where the platform can map it, the blobs are only paged in as the buffers are filled */
+	GAE_File_open(file, GAE_FILE_OPEN_MAP, GAE_FILE_BINARY, &fileStatus);
+	if (GAE_FILE_OPEN == fileStatus)
+		GAE_File_read(file, GAE_FILE_READ_ALL, &readStatus);
+
+	if (GAE_FILE_READ_ERROR == readStatus) {
+		GAE_File_close(file, GAE_FILE_CLOSE_DELETE_DATA, 0);
+		GAE_File_delete(file);
+		return GAE_FALSE;
+	}
+
+	/* the buffer stays with the File, which releases it however it was made */
+	meshFile->data = file->buffer;
+	meshFile->size = file->bufferSize;
+	meshFile->file = file;
+
+	GAE_File_close(file, GAE_FILE_CLOSE_RETAIN_DATA, 0);
+	return GAE_TRUE;
+}
+
+GAE_BOOL parse(GAE_MeshFile_t* meshFile) {
+	const GAE_BYTE* header = meshFile->data;
+	GAE_VertexBuffer_t* vertexBuffer = 0;
+	unsigned int vertexSize = 0U;
+	unsigned int stride = 0U;
+	unsigned int indexCount = 0U;
+	unsigned int indexType = 0U;
+	unsigned int primitive = 0U;
+	unsigned int vertexOffset = 0U;
+	unsigned int indexOffset = 0U;
+	unsigned int formatCount = 0U;
+	unsigned int indexSize = 0U;
+	unsigned int index = 0U;
+
+	if ((0 == header) || (GAE_MESH_FILE_HEADER_SIZE > meshFile->size) || (0 != memcmp(header, "GMSH", 4U)))
+		return GAE_FALSE;
+
+	if (GAE_MESH_FILE_VERSION != readUint32(header + 4U))
+		return GAE_FALSE;
+
+	vertexSize = readUint32(header + 8U);
+	stride = readUint32(header + 12U);
+	indexCount = readUint32(header + 16U);
+	indexType = readUint32(header + 20U);
+	primitive = readUint32(header + 24U);
+	vertexOffset = readUint32(header + 28U);
+	indexOffset = readUint32(header + 32U);
+	formatCount = readUint32(header + 36U);
+
+	switch (indexType) {
+		case GAE_INDEXBUFFER_INDEX_UNSIGNED_BYTE:
+			indexSize = 1U;
+			break;
+		case GAE_INDEXBUFFER_INDEX_UNSIGNED_SHORT:
+			indexSize = 2U;
+			break;
+		case GAE_INDEXBUFFER_INDEX_UNSIGNED_INT:
+			indexSize = 4U;
+			break;
+		default:
+			return GAE_FALSE;
+	};
+
+	if ((0U == stride) || (GAE_INDEXBUFFER_FORMAT_TRIANGLE_FAN < primitive) || (GAE_VERTEXBUFFER_FORMAT_SIZE < formatCount))
+		return GAE_FALSE;
+
+	if ((0U != vertexOffset % GAE_MESH_FILE_ALIGNMENT) || (0U != indexOffset % GAE_MESH_FILE_ALIGNMENT))
+		return GAE_FALSE;
+
+	if (((unsigned long)vertexOffset + vertexSize > meshFile->size) || ((unsigned long)indexOffset + (unsigned long)indexCount * indexSize > meshFile->size))
+		return GAE_FALSE;
+
+	vertexBuffer = GAE_VertexBuffer_createNotOwned(meshFile->data + vertexOffset, vertexSize, GAE_VERTEXBUFFER_TYPE_STATIC);
+	vertexBuffer->stride = stride;
+	for (index = 0U; index < formatCount; ++index) {
+		const unsigned int type = readUint32(header + 40U + index * 8U);
+		const unsigned int offset = readUint32(header + 44U + index * 8U);
+
+		if ((GAE_VERTEXBUFFER_INVALID_FORMAT == type) || (GAE_VERTEXBUFFER_FORMAT_TEXTURE_4S < type) || (offset >= stride)) {
+			GAE_VertexBuffer_delete(vertexBuffer);
+			return GAE_FALSE;
+		}
+
+		vertexBuffer->format[index] = GAE_VertexBuffer_Format_create((GAE_VertexBuffer_FormatType)type, offset);
+	}
+
+	meshFile->vertexBuffer = vertexBuffer;
+	meshFile->indexBuffer = GAE_IndexBuffer_createNotOwned(meshFile->data + indexOffset, indexCount, (GAE_IndexBuffer_IndexType)indexType, (GAE_IndexBuffer_Format)primitive, GAE_INDEXBUFFER_DRAW_STATIC);
+
+	return GAE_TRUE;
+}
@@ -0,0 +1,49 @@
+#ifndef _MESH_FILE_H_
+#define _MESH_FILE_H_
+
+#include "../GAE_Types.h"
+
+/*
+	Binary meshes, laid out so the vertex and index blobs can be handed to GL straight from a mapping.
+	The header is little endian, as is the blob data since every supported platform is:
+	 0 - "GMSH"            24 - primitive format
+	 4 - version           28 - vertex data offset
+	 8 - vertex data size  32 - index data offset
+	12 - vertex stride     36 - format count
+	16 - index count       40 - GAE_VERTEXBUFFER_FORMAT_SIZE type/offset pairs
+	20 - index type
+	Blob offsets are multiples of GAE_MESH_FILE_ALIGNMENT. Enum values are stored as they are numbered
+	in VertexBuffer.h and IndexBuffer.h - bump the version if those change.
+*/
+
+#define GAE_MESH_FILE_VERSION 1U
+#define GAE_MESH_FILE_HEADER_SIZE 104U
+#define GAE_MESH_FILE_ALIGNMENT 16U
+
+struct GAE_File_s;
+struct GAE_Mesh_s;
+struct GAE_Material_s;
+struct GAE_VertexBuffer_s;
+struct GAE_IndexBuffer_s;
+
+typedef struct GAE_MeshFile_s {
+	GAE_BYTE* data;
+	unsigned long size;
+	struct GAE_File_s* file;	/* holds data when loaded from disk - mapped read only where the platform can */
+	struct GAE_VertexBuffer_s* vertexBuffer;	/* both buffers point into data */
+	struct GAE_IndexBuffer_s* indexBuffer;
+} GAE_MeshFile_t;
+
+/* Maps the mesh file at filePath - where mapping isn't available it is read in whole instead. */
+GAE_MeshFile_t* GAE_MeshFile_create(const char* const filePath, GAE_BOOL* status);
+
+/* Parses a mesh already in memory. The buffer is not copied and must outlive the mesh file. */
+GAE_MeshFile_t* GAE_MeshFile_createFromBuffer(GAE_BYTE* const buffer, const unsigned long size, GAE_BOOL* status);
+
+/* Creates a Mesh using the mesh file's buffers - the mesh file must outlive it. */
+struct GAE_Mesh_s* GAE_MeshFile_createMesh(GAE_MeshFile_t* const meshFile, struct GAE_Material_s* const material);
+
+/* Deletes the buffers and releases the data. */
+void GAE_MeshFile_delete(GAE_MeshFile_t* meshFile);
+
+#endif
@@ -0,0 +1,279 @@
+#include "MeshOptimiser.h"
+
+#include "IndexBuffer.h"
+#include "VertexBuffer.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define INVALID_VERTEX 0xFFFFFFFFU
+
+static unsigned int getIndex(const GAE_IndexBuffer_t* buffer, const unsigned int index);
+static void setIndex(GAE_IndexBuffer_t* buffer, const unsigned int index, const unsigned int value);
+static unsigned int getVertexCount(const GAE_IndexBuffer_t* buffer);
+static float simulateCache(const unsigned int* indices, const unsigned int count, const unsigned int vertexCount, const unsigned int cacheSize);
+static void tipsify(const unsigned int* indices, const unsigned int count, const unsigned int vertexCount, const unsigned int cacheSize, unsigned int* output);
+static unsigned int skipDeadEnd(const unsigned int* liveCount, unsigned int* deadEnds, unsigned int* deadEndCount, const unsigned int vertexCount, unsigned int* cursor);
+static void reorderVertices(GAE_VertexBuffer_t* vertexBuffer, unsigned int* indices, const unsigned int count);
+
+float GAE_MeshOptimiser_getACMR(GAE_IndexBuffer_t* const indexBuffer, const unsigned int cacheSize) {
+	unsigned int* indices = 0;
+	unsigned int index = 0U;
+	float acmr = 0.0F;
+
+	if ((GAE_INDEXBUFFER_FORMAT_TRIANGLES != indexBuffer->format) || (GAE_INDEXBUFFER_INDEX_FLOAT == indexBuffer->type) || (3U > indexBuffer->count))
+		return 0.0F;
+
+	indices = malloc(sizeof(unsigned int) * indexBuffer->count);
+	for (index = 0U; index < indexBuffer->count; ++index)
+		indices[index] = getIndex(indexBuffer, index);
+
+	acmr = simulateCache(indices, indexBuffer->count - indexBuffer->count % 3U, getVertexCount(indexBuffer), cacheSize);
+	free(indices);
+
+	return acmr;
+}
+
+GAE_BOOL GAE_MeshOptimiser_optimise(GAE_IndexBuffer_t* indexBuffer, GAE_VertexBuffer_t* vertexBuffer, const unsigned int cacheSize, GAE_MeshOptimiser_Stats_t* stats) {
+	const unsigned int count = indexBuffer->count;
+	unsigned int vertexCount = 0U;
+	unsigned int* indices = 0;
+	unsigned int* optimised = 0;
+	unsigned int index = 0U;
+
+	if ((GAE_INDEXBUFFER_FORMAT_TRIANGLES != indexBuffer->format) || (GAE_INDEXBUFFER_INDEX_FLOAT == indexBuffer->type))
+		return GAE_FALSE;
+
+	if ((0U == count) || (0U != count % 3U) || (0U == cacheSize))
+		return GAE_FALSE;
+
+	/* buffers wrapping mapped or borrowed data can't be rewritten */
+	if ((GAE_FALSE == indexBuffer->owned) || ((0 != vertexBuffer) && (GAE_FALSE == vertexBuffer->owned)))
+		return GAE_FALSE;
+
+	vertexCount = getVertexCount(indexBuffer);
+
+	/* indices past the end of the vertex data can't be remapped */
+	if ((0 != vertexBuffer) && (0U != vertexBuffer->stride) && (vertexCount > vertexBuffer->size / vertexBuffer->stride))
+		return GAE_FALSE;
+
+	indices = malloc(sizeof(unsigned int) * count);
+	optimised = malloc(sizeof(unsigned int) * count);
+	for (index = 0U; index < count; ++index)
+		indices[index] = getIndex(indexBuffer, index);
+
+	if (0 != stats) {
+		stats->acmrBefore = simulateCache(indices, count, vertexCount, cacheSize);
+		stats->vertexCount = vertexCount;
+		stats->triangleCount = count / 3U;
+	}
+
+	tipsify(indices, count, vertexCount, cacheSize, optimised);
+
+	if ((0 != vertexBuffer) && (0U != vertexBuffer->stride))
+		reorderVertices(vertexBuffer, optimised, count);
+
+	for (index = 0U; index < count; ++index)
+		setIndex(indexBuffer, index, optimised[index]);
+
+	if (0 != stats)
+		stats->acmrAfter = simulateCache(optimised, count, vertexCount, cacheSize);
+
+	free(optimised);
+	free(indices);
+
+	return GAE_TRUE;
+}
+
+unsigned int getIndex(const GAE_IndexBuffer_t* buffer, const unsigned int index) {
+	switch (buffer->type) {
+		case GAE_INDEXBUFFER_INDEX_UNSIGNED_BYTE:
+			return ((const unsigned char*)buffer->data)[index];
+		case GAE_INDEXBUFFER_INDEX_UNSIGNED_SHORT:
+			return ((const unsigned short*)(void*)buffer->data)[index];
+		case GAE_INDEXBUFFER_INDEX_UNSIGNED_INT:
+			return ((const unsigned int*)(void*)buffer->data)[index];
+		default:
+			return 0U;
+	};
+}
+
+void setIndex(GAE_IndexBuffer_t* buffer, const unsigned int index, const unsigned int value) {
+	switch (buffer->type) {
+		case GAE_INDEXBUFFER_INDEX_UNSIGNED_BYTE:
+			((unsigned char*)buffer->data)[index] = (unsigned char)value;
+			break;
+		case GAE_INDEXBUFFER_INDEX_UNSIGNED_SHORT:
+			((unsigned short*)(void*)buffer->data)[index] = (unsigned short)value;
+			break;
+		case GAE_INDEXBUFFER_INDEX_UNSIGNED_INT:
+			((unsigned int*)(void*)buffer->data)[index] = value;
+			break;
+		default:
+			break;
+	};
+}
+
+unsigned int getVertexCount(const GAE_IndexBuffer_t* buffer) {
+	unsigned int maxIndex = 0U;
+	unsigned int index = 0U;
+
+	for (index = 0U; index < buffer->count; ++index) {
+		const unsigned int value = getIndex(buffer, index);
+		if (value > maxIndex)
+			maxIndex = value;
+	}
+
+	return maxIndex + 1U;
+}
+
+float simulateCache(const unsigned int* indices, const unsigned int count, const unsigned int vertexCount, const unsigned int cacheSize) {
+	unsigned int* timeStamps = calloc(vertexCount, sizeof(unsigned int));
+	unsigned int time = cacheSize + 1U;
+	unsigned int misses = 0U;
+	unsigned int index = 0U;
+
+	/* a vertex is still cached while fewer than cacheSize misses have happened since it went in */
+	for (index = 0U; index < count; ++index) {
+		const unsigned int vertex = indices[index];
+		if (time - timeStamps[vertex] > cacheSize) {
+			timeStamps[vertex] = time++;
+			++misses;
+		}
+	}
+
+	free(timeStamps);
+	return (0U < count / 3U) ? (float)misses / (float)(count / 3U) : 0.0F;
+}
+
+/* Sander, Nehab and Barczak - Fast Triangle Reordering for Vertex Locality and Reduced Overdraw.
+ * Fans out around a vertex, then moves to whichever vertex it touched will still be cached. */
+void tipsify(const unsigned int* indices, const unsigned int count, const unsigned int vertexCount, const unsigned int cacheSize, unsigned int* output) {
+	const unsigned int triangleCount = count / 3U;
+	unsigned int* liveCount = calloc(vertexCount, sizeof(unsigned int));
+	unsigned int* offsets = calloc(vertexCount + 1U, sizeof(unsigned int));
+	unsigned int* adjacency = malloc(sizeof(unsigned int) * count);
+	unsigned int* timeStamps = calloc(vertexCount, sizeof(unsigned int));
+	unsigned int* deadEnds = malloc(sizeof(unsigned int) * count);
+	unsigned int* candidates = malloc(sizeof(unsigned int) * count);
+	GAE_BYTE* isEmitted = calloc(triangleCount, sizeof(GAE_BYTE));
+	unsigned int deadEndCount = 0U;
+	unsigned int outputCount = 0U;
+	unsigned int time = cacheSize + 1U;
+	unsigned int cursor = 0U;
+	unsigned int fanVertex = 0U;
+	unsigned int index = 0U;
+
+	/* vertex to triangle adjacency, packed with a counting sort */
+	for (index = 0U; index < count; ++index)
+		++liveCount[indices[index]];
+	for (index = 0U; index < vertexCount; ++index)
+		offsets[index + 1U] = offsets[index] + liveCount[index];
+	for (index = 0U; index < count; ++index)
+		adjacency[offsets[indices[index]]++] = index / 3U;
+	for (index = vertexCount; index > 0U; --index)
+		offsets[index] = offsets[index - 1U];
+	offsets[0] = 0U;
+
+	fanVertex = skipDeadEnd(liveCount, deadEnds, &deadEndCount, vertexCount, &cursor);
+	while (INVALID_VERTEX != fanVertex) {
+		unsigned int candidateCount = 0U;
+		unsigned int bestVertex = INVALID_VERTEX;
+		int bestPriority = -1;
+
+		for (index = offsets[fanVertex]; index < offsets[fanVertex + 1U]; ++index) {
+			const unsigned int triangle = adjacency[index];
+			unsigned int corner = 0U;
+
+			if (0U != isEmitted[triangle])
+				continue;
+
+			for (corner = 0U; corner < 3U; ++corner) {
+				const unsigned int vertex = indices[triangle * 3U + corner];
+				output[outputCount++] = vertex;
+				deadEnds[deadEndCount++] = vertex;
+				candidates[candidateCount++] = vertex;
+				--liveCount[vertex];
+				if (time - timeStamps[vertex] > cacheSize)
+					timeStamps[vertex] = time++;
+			}
+
+			isEmitted[triangle] = 1U;
+		}
+
+		/* prefer the candidate that will still be in the cache after its remaining triangles are emitted, oldest first */
+		for (index = 0U; index < candidateCount; ++index) {
+			const unsigned int vertex = candidates[index];
+			int priority = 0;
+
+			if (0U == liveCount[vertex])
+				continue;
+
+			if (time - timeStamps[vertex] + 2U * liveCount[vertex] <= cacheSize)
+				priority = (int)(time - timeStamps[vertex]);
+
+			if (priority > bestPriority) {
+				bestPriority = priority;
+				bestVertex = vertex;
+			}
+		}
+
+		fanVertex = (INVALID_VERTEX != bestVertex) ? bestVertex : skipDeadEnd(liveCount, deadEnds, &deadEndCount, vertexCount, &cursor);
+	}
+
+	free(isEmitted);
+	free(candidates);
+	free(deadEnds);
+	free(timeStamps);
+	free(adjacency);
+	free(offsets);
+	free(liveCount);
+}
+
+unsigned int skipDeadEnd(const unsigned int* liveCount, unsigned int* deadEnds, unsigned int* deadEndCount, const unsigned int vertexCount, unsigned int* cursor) {
+	/* recently used vertices first, then the next one in input order that still has triangles */
+	while (0U < *deadEndCount) {
+		const unsigned int vertex = deadEnds[--(*deadEndCount)];
+		if (0U < liveCount[vertex])
+			return vertex;
+	}
+
+	for (; *cursor < vertexCount; ++(*cursor)) {
+		if (0U < liveCount[*cursor])
+			return *cursor;
+	}
+
+	return INVALID_VERTEX;
+}
+
+void reorderVertices(GAE_VertexBuffer_t* vertexBuffer, unsigned int* indices, const unsigned int count) {
+	const unsigned int stride = vertexBuffer->stride;
+	const unsigned int totalVertices = vertexBuffer->size / stride;
+	unsigned int* remap = malloc(sizeof(unsigned int) * totalVertices);
+	GAE_BYTE* data = malloc(vertexBuffer->size);
+	unsigned int next = 0U;
+	unsigned int index = 0U;
+
+	memset(remap, 0xFF, sizeof(unsigned int) * totalVertices);
+
+	/* first use order, so the fetches walk forward through memory */
+	for (index = 0U; index < count; ++index) {
+		if (INVALID_VERTEX == remap[indices[index]])
+			remap[indices[index]] = next++;
+		indices[index] = remap[indices[index]];
+	}
+
+	/* unreferenced vertices keep their data, after everything that is drawn */
+	for (index = 0U; index < totalVertices; ++index) {
+		if (INVALID_VERTEX == remap[index])
+			remap[index] = next++;
+		memcpy(data + remap[index] * stride, vertexBuffer->data + index * stride, stride);
+	}
+
+	if (totalVertices * stride < vertexBuffer->size)
+		memcpy(data + totalVertices * stride, vertexBuffer->data + totalVertices * stride, vertexBuffer->size - totalVertices * stride);
+
+	free(vertexBuffer->data);
+	vertexBuffer->data = data;
+	free(remap);
+}
@@ -0,0 +1,27 @@
+#ifndef _MESH_OPTIMISER_H_
+#define _MESH_OPTIMISER_H_
+
+#include "../GAE_Types.h"
+
+/* Post transform cache size to optimise for - small enough to suit the mobile parts, larger caches still benefit. */
+#define GAE_MESHOPTIMISER_CACHE_SIZE 16U
+
+struct GAE_IndexBuffer_s;
+struct GAE_VertexBuffer_s;
+
+typedef struct GAE_MeshOptimiser_Stats_s {
+	float acmrBefore;	/* average cache miss ratio - vertices transformed per triangle */
+	float acmrAfter;
+	unsigned int vertexCount;
+	unsigned int triangleCount;
+} GAE_MeshOptimiser_Stats_t;
+
+/* Returns the average cache miss ratio of a triangle list run through a FIFO cache of cacheSize vertices - 0.5 is ideal, 3.0 the worst. */
+float GAE_MeshOptimiser_getACMR(struct GAE_IndexBuffer_s* const indexBuffer, const unsigned int cacheSize);
+
+/* Reorders the triangles for the post transform cache (Tipsify), then the vertices into first use order so fetches stream linearly.
+ * Both buffers are rewritten in place, so must own their data and not have been drawn yet. The vertex buffer may be 0, or non-interleaved, to only reorder indices.
+ * Only triangle lists are handled - returns GAE_FALSE and leaves the buffers untouched otherwise. stats may be 0. */
+GAE_BOOL GAE_MeshOptimiser_optimise(struct GAE_IndexBuffer_s* indexBuffer, struct GAE_VertexBuffer_s* vertexBuffer, const unsigned int cacheSize, GAE_MeshOptimiser_Stats_t* stats);
+
+#endif
@@ -0,0 +1,488 @@
+#include "ParticleSystem.h"
+
+#include "Mesh.h"
+#include "Material.h"
+#include "Shader.h"
+#include "Texture.h"
+#include "VertexBuffer.h"
+#include "IndexBuffer.h"
+#include "Renderer/Renderer.h"
+#include "../File/File.h"
+#include "../Maths/Matrix.h"
+#include "../Utils/Array.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+	#define GAE_PARTICLES_SSE
+	#include <emmintrin.h>
+#endif
+
+/* position 2F, texture 2F, colour 4UB */
+#define VERTEX_STRIDE 20U
+#define VERTEX_WORDS 5U
+
+static GAE_Shader_t* getShader(GAE_ParticleSystem_t* system, const GAE_BOOL isTextured);
+static GAE_Shader_t* createShader(const char* const fragmentSource);
+static GAE_IndexBuffer_t* createQuadIndices(const unsigned int capacity);
+static float randomSigned(GAE_ParticleSystem_t* system);
+static unsigned int packColour(const GAE_Vector4_t start, const GAE_Vector4_t end, const float t);
+static void spawn(GAE_ParticleSystem_t* system, GAE_ParticleEmitter_t* emitter, const unsigned int amount);
+static void integrate(GAE_ParticleEmitter_t* emitter, const float deltaTime);
+static void compact(GAE_ParticleEmitter_t* emitter);
+static void buildVertices(GAE_ParticleEmitter_t* emitter);
+static void deleteEmitter(GAE_ParticleEmitter_t* emitter);
+
+GAE_ParticleSystem_t* GAE_ParticleSystem_create(void) {
+	GAE_ParticleSystem_t* system = malloc(sizeof(GAE_ParticleSystem_t));
+
+	system->emitters = GAE_Array_create(sizeof(GAE_ParticleEmitter_t*));
+	system->texturedShader = 0;
+	system->untexturedShader = 0;
+	system->random = 0x2545F491U;
+	GAE_Matrix4_setToIdentity(&system->transform);
+
+	return system;
+}
+
+GAE_ParticleEmitter_t* GAE_ParticleSystem_addEmitter(GAE_ParticleSystem_t* system, const unsigned int capacity, GAE_Texture_t* const texture) {
+	GAE_ParticleEmitter_t* emitter = malloc(sizeof(GAE_ParticleEmitter_t));
+	GAE_ParticleEmitter_Settings_t* settings = &emitter->settings;
+	GAE_VertexBuffer_t* vBuffer = 0;
+	GAE_IndexBuffer_t* iBuffer = 0;
+	unsigned int index = 0U;
+
+	memset(settings, 0, sizeof(GAE_ParticleEmitter_Settings_t));
+	settings->minLife = 1.0F;
+	settings->maxLife = 1.0F;
+	settings->startSize = 1.0F;
+	settings->endSize = 1.0F;
+	for (index = 0U; index < 4U; ++index) {
+		settings->startColour[index] = 1.0F;
+		settings->endColour[index] = 1.0F;
+	}
+
+	emitter->isEmitting = GAE_TRUE;
+	emitter->spawnAccumulator = 0.0F;
+	emitter->capacity = capacity;
+	emitter->count = 0U;
+
+	/* zeroed so the vector loops never read uninitialised lanes */
+	emitter->positionX = calloc(capacity, sizeof(float));
+	emitter->positionY = calloc(capacity, sizeof(float));
+	emitter->velocityX = calloc(capacity, sizeof(float));
+	emitter->velocityY = calloc(capacity, sizeof(float));
+	emitter->age = calloc(capacity, sizeof(float));
+	emitter->inverseLife = calloc(capacity, sizeof(float));
+	emitter->size = calloc(capacity, sizeof(float));
+	emitter->colour = calloc(capacity, sizeof(unsigned int));
+
+	/* the vertex buffer uploads straight from its own data each frame, so nothing is allocated per frame */
+	vBuffer = GAE_VertexBuffer_createNotOwned(calloc(capacity * 4U, VERTEX_STRIDE), capacity * 4U * VERTEX_STRIDE, GAE_VERTEXBUFFER_TYPE_STREAM);
+	vBuffer->owned = GAE_TRUE;
+	vBuffer->stride = VERTEX_STRIDE;
+	vBuffer->format[0] = GAE_VertexBuffer_Format_create(GAE_VERTEXBUFFER_FORMAT_POSITION_2F, 0U);
+	vBuffer->format[1] = GAE_VertexBuffer_Format_create(GAE_VERTEXBUFFER_FORMAT_TEXTURE_2F, 8U);
+	vBuffer->format[2] = GAE_VertexBuffer_Format_create(GAE_VERTEXBUFFER_FORMAT_COLOUR_4UB, 16U);
+	vBuffer->updateData = malloc(sizeof(GAE_VertexBuffer_UpdateData_t));
+	vBuffer->updateData->retain = GAE_TRUE;
+	vBuffer->updateData->offset = 0U;
+	vBuffer->updateData->size = 0U;
+	vBuffer->updateData->data = vBuffer->data;
+
+	iBuffer = createQuadIndices(capacity);
+
+	emitter->material = GAE_Material_create();
+	emitter->material->shader = getShader(system, (0 != texture) ? GAE_TRUE : GAE_FALSE);
+	if (0 != texture)
+		GAE_Material_addTexture(emitter->material, texture);
+
+	emitter->mesh = GAE_Mesh_create(vBuffer, iBuffer, emitter->material);
+
+	GAE_Array_push(system->emitters, &emitter);
+	return emitter;
+}
+
+GAE_ParticleEmitter_t* GAE_ParticleSystem_burst(GAE_ParticleSystem_t* system, GAE_ParticleEmitter_t* emitter, const unsigned int amount) {
+	spawn(system, emitter, amount);
+	return emitter;
+}
+
+GAE_ParticleSystem_t* GAE_ParticleSystem_update(GAE_ParticleSystem_t* system, const float deltaTime) {
+	GAE_ParticleEmitter_t** itr = (GAE_ParticleEmitter_t**)GAE_Array_begin(system->emitters);
+	GAE_ParticleEmitter_t** end = (GAE_ParticleEmitter_t**)GAE_Array_end(system->emitters);
+
+	for (; itr < end; ++itr) {
+		GAE_ParticleEmitter_t* emitter = *itr;
+
+		integrate(emitter, deltaTime);
+		compact(emitter);
+
+		if (GAE_TRUE == emitter->isEmitting) {
+			unsigned int amount = 0U;
+
+			emitter->spawnAccumulator += emitter->settings.rate * deltaTime;
+			amount = (unsigned int)emitter->spawnAccumulator;
+			emitter->spawnAccumulator -= (float)amount;
+			spawn(system, emitter, amount);
+		}
+
+		buildVertices(emitter);
+	}
+
+	return system;
+}
+
+GAE_ParticleSystem_t* GAE_ParticleSystem_draw(GAE_ParticleSystem_t* system, GAE_Renderer_t* renderer) {
+	GAE_ParticleEmitter_t** itr = (GAE_ParticleEmitter_t**)GAE_Array_begin(system->emitters);
+	GAE_ParticleEmitter_t** end = (GAE_ParticleEmitter_t**)GAE_Array_end(system->emitters);
+
+	for (; itr < end; ++itr) {
+		if (0U < (*itr)->count)
+			GAE_Renderer_drawMesh(renderer, (*itr)->mesh, &system->transform);
+	}
+
+	return system;
+}
+
+unsigned int GAE_ParticleSystem_getParticleCount(GAE_ParticleSystem_t* system) {
+	GAE_ParticleEmitter_t** itr = (GAE_ParticleEmitter_t**)GAE_Array_begin(system->emitters);
+	GAE_ParticleEmitter_t** end = (GAE_ParticleEmitter_t**)GAE_Array_end(system->emitters);
+	unsigned int count = 0U;
+
+	for (; itr < end; ++itr)
+		count += (*itr)->count;
+
+	return count;
+}
+
+void GAE_ParticleSystem_delete(GAE_ParticleSystem_t* system) {
+	GAE_ParticleEmitter_t** itr = (GAE_ParticleEmitter_t**)GAE_Array_begin(system->emitters);
+	GAE_ParticleEmitter_t** end = (GAE_ParticleEmitter_t**)GAE_Array_end(system->emitters);
+
+	for (; itr < end; ++itr)
+		deleteEmitter(*itr);
+	GAE_Array_delete(system->emitters);
+
+	if (0 != system->texturedShader)
+		GAE_Shader_delete(system->texturedShader);
+	if (0 != system->untexturedShader)
+		GAE_Shader_delete(system->untexturedShader);
+
+	free(system);
+	system = 0;
+}
+
+GAE_Shader_t* getShader(GAE_ParticleSystem_t* system, const GAE_BOOL isTextured) {
+	if (GAE_TRUE == isTextured) {
+		if (0 == system->texturedShader)
+			system->texturedShader = createShader(
+				"varying vec2 v_texCoord0;										\n\
+				varying vec4 v_colour;											\n\
+				uniform sampler2D s_texture0;									\n\
+				void main() {													\n\
+				gl_FragColor = texture2D(s_texture0, v_texCoord0) * v_colour;	\n\
+				}																\n");
+		return system->texturedShader;
+	}
+
+	if (0 == system->untexturedShader)
+		system->untexturedShader = createShader(
+			"varying vec2 v_texCoord0;										\n\
+			varying vec4 v_colour;											\n\
+			void main() {													\n\
+			float falloff = 1.0 - length(v_texCoord0 * 2.0 - 1.0);			\n\
+			gl_FragColor = vec4(v_colour.rgb, v_colour.a * clamp(falloff, 0.0, 1.0));	\n\
+			}																\n");
+	return system->untexturedShader;
+}
+
+GAE_Shader_t* createShader(const char* const fragmentSource) {
+	/* colours arrive as unnormalised bytes */
+	const char* vSource =
+		"attribute vec4 a_position;			\n\
+		attribute vec2 a_texCoord0;			\n\
+		attribute vec4 a_color;				\n\
+		varying vec2 v_texCoord0;			\n\
+		varying vec4 v_colour;				\n\
+		uniform mat4 u_mvp;					\n\
+		void main() {						\n\
+		gl_Position = u_mvp * a_position;	\n\
+		v_texCoord0 = a_texCoord0;			\n\
+		v_colour = a_color / 255.0;			\n\
+		}									\n";
+	GAE_File_t* vShader = GAE_File_create("particle vertex shader");
+	GAE_File_t* fShader = GAE_File_create("particle fragment shader");
+	GAE_Shader_t* shader = 0;
+
+	GAE_File_setBuffer(vShader, (GAE_BYTE*)vSource, strlen(vSource), GAE_FILE_BUFFER_OWNED, 0);
+	GAE_File_setBuffer(fShader, (GAE_BYTE*)fragmentSource, strlen(fragmentSource), GAE_FILE_BUFFER_OWNED, 0);
+	shader = GAE_Shader_create(vShader, fShader);
+	GAE_File_delete(vShader);
+	GAE_File_delete(fShader);
+
+	return shader;
+}
+
+GAE_IndexBuffer_t* createQuadIndices(const unsigned int capacity) {
+	const GAE_BOOL isShort = (GAE_PARTICLE_EMITTER_SHORT_CAPACITY >= capacity) ? GAE_TRUE : GAE_FALSE;
+	const unsigned int count = capacity * 6U;
+	GAE_IndexBuffer_t* iBuffer = 0;
+	unsigned int* indices = malloc(sizeof(unsigned int) * count);
+	unsigned int quad = 0U;
+
+	/* the same winding the sprites and tile chunks use */
+	for (quad = 0U; quad < capacity; ++quad) {
+		const unsigned int vertex = quad * 4U;
+		unsigned int* index = indices + quad * 6U;
+
+		index[0] = vertex;
+		index[1] = vertex + 3U;
+		index[2] = vertex + 2U;
+		index[3] = vertex + 2U;
+		index[4] = vertex + 1U;
+		index[5] = vertex;
+	}
+
+	if (GAE_TRUE == isShort) {
+		unsigned short* shortIndices = malloc(sizeof(unsigned short) * count);
+
+		for (quad = 0U; quad < count; ++quad)
+			shortIndices[quad] = (unsigned short)indices[quad];
+
+		iBuffer = GAE_IndexBuffer_create((GAE_BYTE*)shortIndices, count, GAE_INDEXBUFFER_INDEX_UNSIGNED_SHORT, GAE_INDEXBUFFER_FORMAT_TRIANGLES, GAE_INDEXBUFFER_DRAW_STATIC);
+		free(shortIndices);
+	}
+	else
+		iBuffer = GAE_IndexBuffer_create((GAE_BYTE*)indices, count, GAE_INDEXBUFFER_INDEX_UNSIGNED_INT, GAE_INDEXBUFFER_FORMAT_TRIANGLES, GAE_INDEXBUFFER_DRAW_STATIC);
+
+	free(indices);
+
+	/* only live particles are drawn - the count is set as the vertices are built */
+	iBuffer->count = 0U;
+	return iBuffer;
+}
+
+float randomSigned(GAE_ParticleSystem_t* system) {
+	/* xorshift32 - cheap, and the same sequence on every platform */
+	unsigned int value = system->random;
+
+	value ^= value << 13U;
+	value ^= value >> 17U;
+	value ^= value << 5U;
+	system->random = value;
+
+	/* -1 to 1 */
+	return (float)(value >> 8U) * (2.0F / 16777216.0F) - 1.0F;
+}
+
+unsigned int packColour(const GAE_Vector4_t start, const GAE_Vector4_t end, const float t) {
+	const unsigned int r = (unsigned int)((start[0] + (end[0] - start[0]) * t) * 255.0F + 0.5F);
+	const unsigned int g = (unsigned int)((start[1] + (end[1] - start[1]) * t) * 255.0F + 0.5F);
+	const unsigned int b = (unsigned int)((start[2] + (end[2] - start[2]) * t) * 255.0F + 0.5F);
+	const unsigned int a = (unsigned int)((start[3] + (end[3] - start[3]) * t) * 255.0F + 0.5F);
+
+	/* every supported platform is little endian, so this lays out as R, G, B, A */
+	return r | (g << 8U) | (b << 16U) | (a << 24U);
+}
+
+void spawn(GAE_ParticleSystem_t* system, GAE_ParticleEmitter_t* emitter, const unsigned int amount) {
+	const GAE_ParticleEmitter_Settings_t* settings = &emitter->settings;
+	const unsigned int colour = packColour(settings->startColour, settings->endColour, 0.0F);
+	const float lifeRange = (settings->maxLife - settings->minLife) * 0.5F;
+	unsigned int last = emitter->count + amount;
+	unsigned int index = 0U;
+
+	if (last > emitter->capacity)
+		last = emitter->capacity;
+
+	for (index = emitter->count; index < last; ++index) {
+		const float life = settings->minLife + lifeRange * (randomSigned(system) + 1.0F);
+
+		emitter->positionX[index] = settings->position[0] + settings->area[0] * randomSigned(system);
+		emitter->positionY[index] = settings->position[1] + settings->area[1] * randomSigned(system);
+		emitter->velocityX[index] = settings->velocity[0] + settings->velocityVariance[0] * randomSigned(system);
+		emitter->velocityY[index] = settings->velocity[1] + settings->velocityVariance[1] * randomSigned(system);
+		emitter->age[index] = 0.0F;
+		emitter->inverseLife[index] = (0.0F < life) ? 1.0F / life : 1.0e30F;
+		emitter->size[index] = settings->startSize;
+		emitter->colour[index] = colour;
+	}
+
+	emitter->count = last;
+}
+
+void integrate(GAE_ParticleEmitter_t* emitter, const float deltaTime) {
+	const GAE_ParticleEmitter_Settings_t* settings = &emitter->settings;
+	const float accelerationX = settings->acceleration[0] * deltaTime;
+	const float accelerationY = settings->acceleration[1] * deltaTime;
+	const float sizeRange = settings->endSize - settings->startSize;
+	const unsigned int count = emitter->count;
+	float* positionX = emitter->positionX;
+	float* positionY = emitter->positionY;
+	float* velocityX = emitter->velocityX;
+	float* velocityY = emitter->velocityY;
+	float* age = emitter->age;
+	float* inverseLife = emitter->inverseLife;
+	float* size = emitter->size;
+	unsigned int* colour = emitter->colour;
+	GAE_Vector4_t scaledStart;
+	GAE_Vector4_t scaledRange;
+	unsigned int index = 0U;
+
+	for (index = 0U; index < 4U; ++index) {
+		scaledStart[index] = settings->startColour[index] * 255.0F + 0.5F;
+		scaledRange[index] = (settings->endColour[index] - settings->startColour[index]) * 255.0F;
+	}
+
+	index = 0U;
+
+	#if defined(GAE_PARTICLES_SSE)
+	{
+		const __m128 step = _mm_set1_ps(deltaTime);
+		const __m128 stepX = _mm_set1_ps(accelerationX);
+		const __m128 stepY = _mm_set1_ps(accelerationY);
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.0F);
+		const __m128 startSize = _mm_set1_ps(settings->startSize);
+		const __m128 sizeDelta = _mm_set1_ps(sizeRange);
+		const __m128 startR = _mm_set1_ps(scaledStart[0]);
+		const __m128 startG = _mm_set1_ps(scaledStart[1]);
+		const __m128 startB = _mm_set1_ps(scaledStart[2]);
+		const __m128 startA = _mm_set1_ps(scaledStart[3]);
+		const __m128 rangeR = _mm_set1_ps(scaledRange[0]);
+		const __m128 rangeG = _mm_set1_ps(scaledRange[1]);
+		const __m128 rangeB = _mm_set1_ps(scaledRange[2]);
+		const __m128 rangeA = _mm_set1_ps(scaledRange[3]);
+
+		for (; index + 4U <= count; index += 4U) {
+			__m128 vx = _mm_add_ps(_mm_loadu_ps(velocityX + index), stepX);
+			__m128 vy = _mm_add_ps(_mm_loadu_ps(velocityY + index), stepY);
+			__m128 a = _mm_add_ps(_mm_loadu_ps(age + index), step);
+			__m128 t = _mm_min_ps(_mm_max_ps(_mm_mul_ps(a, _mm_loadu_ps(inverseLife + index)), zero), one);
+			__m128i packed;
+
+			_mm_storeu_ps(velocityX + index, vx);
+			_mm_storeu_ps(velocityY + index, vy);
+			_mm_storeu_ps(positionX + index, _mm_add_ps(_mm_loadu_ps(positionX + index), _mm_mul_ps(vx, step)));
+			_mm_storeu_ps(positionY + index, _mm_add_ps(_mm_loadu_ps(positionY + index), _mm_mul_ps(vy, step)));
+			_mm_storeu_ps(age + index, a);
+			_mm_storeu_ps(size + index, _mm_add_ps(startSize, _mm_mul_ps(sizeDelta, t)));
+
+			/* truncating the +0.5 biased channels rounds them, as packColour does */
+			packed = _mm_cvttps_epi32(_mm_add_ps(startR, _mm_mul_ps(rangeR, t)));
+			packed = _mm_or_si128(packed, _mm_slli_epi32(_mm_cvttps_epi32(_mm_add_ps(startG, _mm_mul_ps(rangeG, t))), 8));
+			packed = _mm_or_si128(packed, _mm_slli_epi32(_mm_cvttps_epi32(_mm_add_ps(startB, _mm_mul_ps(rangeB, t))), 16));
+			packed = _mm_or_si128(packed, _mm_slli_epi32(_mm_cvttps_epi32(_mm_add_ps(startA, _mm_mul_ps(rangeA, t))), 24));
+			_mm_storeu_si128((__m128i*)(void*)(colour + index), packed);
+		}
+	}
+	#endif
+
+	/* written to auto vectorise where there are no intrinsics, and to finish the tail where there are */
+	for (; index < count; ++index) {
+		float t = 0.0F;
+
+		velocityX[index] += accelerationX;
+		velocityY[index] += accelerationY;
+		positionX[index] += velocityX[index] * deltaTime;
+		positionY[index] += velocityY[index] * deltaTime;
+		age[index] += deltaTime;
+
+		t = age[index] * inverseLife[index];
+		t = (t < 1.0F) ? t : 1.0F;
+		size[index] = settings->startSize + sizeRange * t;
+		colour[index] = (unsigned int)(scaledStart[0] + scaledRange[0] * t)
+			| ((unsigned int)(scaledStart[1] + scaledRange[1] * t) << 8U)
+			| ((unsigned int)(scaledStart[2] + scaledRange[2] * t) << 16U)
+			| ((unsigned int)(scaledStart[3] + scaledRange[3] * t) << 24U);
+	}
+}
+
+void compact(GAE_ParticleEmitter_t* emitter) {
+	const float* age = emitter->age;
+	const float* inverseLife = emitter->inverseLife;
+	unsigned int count = emitter->count;
+	unsigned int index = 0U;
+
+	/* dead particles are replaced by the last live one, so only deaths cost a copy */
+	while (index < count) {
+		unsigned int last = 0U;
+
+		#if defined(GAE_PARTICLES_SSE)
+			if (index + 4U <= count) {
+				const __m128 t = _mm_mul_ps(_mm_loadu_ps(age + index), _mm_loadu_ps(inverseLife + index));
+				if (0 == _mm_movemask_ps(_mm_cmpge_ps(t, _mm_set1_ps(1.0F)))) {
+					index += 4U;
+					continue;
+				}
+			}
+		#endif
+
+		if (age[index] * inverseLife[index] < 1.0F) {
+			++index;
+			continue;
+		}
+
+		last = --count;
+		emitter->positionX[index] = emitter->positionX[last];
+		emitter->positionY[index] = emitter->positionY[last];
+		emitter->velocityX[index] = emitter->velocityX[last];
+		emitter->velocityY[index] = emitter->velocityY[last];
+		emitter->age[index] = emitter->age[last];
+		emitter->inverseLife[index] = emitter->inverseLife[last];
+		emitter->size[index] = emitter->size[last];
+		emitter->colour[index] = emitter->colour[last];
+	}
+
+	emitter->count = count;
+}
+
+void buildVertices(GAE_ParticleEmitter_t* emitter) {
+	GAE_VertexBuffer_t* vBuffer = emitter->mesh->vBuffer;
+	float* vertex = (float*)(void*)vBuffer->data;
+	unsigned int* packed = (unsigned int*)(void*)vBuffer->data;
+	const unsigned int count = emitter->count;
+	unsigned int index = 0U;
+
+	for (index = 0U; index < count; ++index) {
+		const float half = emitter->size[index] * 0.5F;
+		const float left = emitter->positionX[index] - half;
+		const float right = emitter->positionX[index] + half;
+		const float top = emitter->positionY[index] + half;
+		const float bottom = emitter->positionY[index] - half;
+		const unsigned int colour = emitter->colour[index];
+
+		vertex[0] = left;	vertex[1] = top;	vertex[2] = 0.0F;	vertex[3] = 1.0F;	packed[4] = colour;
+		vertex[5] = right;	vertex[6] = top;	vertex[7] = 1.0F;	vertex[8] = 1.0F;	packed[9] = colour;
+		vertex[10] = right;	vertex[11] = bottom;	vertex[12] = 1.0F;	vertex[13] = 0.0F;	packed[14] = colour;
+		vertex[15] = left;	vertex[16] = bottom;	vertex[17] = 0.0F;	vertex[18] = 0.0F;	packed[19] = colour;
+
+		vertex += VERTEX_WORDS * 4U;
+		packed += VERTEX_WORDS * 4U;
+	}
+
+	vBuffer->updateData->size = count * 4U * VERTEX_STRIDE;
+	emitter->mesh->iBuffer->count = count * 6U;
+}
+
+void deleteEmitter(GAE_ParticleEmitter_t* emitter) {
+	/* the retained update points at the buffer's own data */
+	emitter->mesh->vBuffer->updateData->data = 0;
+
+	GAE_VertexBuffer_delete(emitter->mesh->vBuffer);
+	GAE_IndexBuffer_delete(emitter->mesh->iBuffer);
+	GAE_Mesh_delete(emitter->mesh);
+	GAE_Material_delete(emitter->material);
+
+	free(emitter->positionX);
+	free(emitter->positionY);
+	free(emitter->velocityX);
+	free(emitter->velocityY);
+	free(emitter->age);
+	free(emitter->inverseLife);
+	free(emitter->size);
+	free(emitter->colour);
+	free(emitter);
+}
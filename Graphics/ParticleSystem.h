@@ -0,0 +1,84 @@
+#ifndef _PARTICLE_SYSTEM_H_
+#define _PARTICLE_SYSTEM_H_
+
+#include "../GAE_Types.h"
+
+/*
+	2D particles, simulated as structure of arrays and written straight into a streaming vertex buffer.
+	Each emitter is a single mesh, so costs one draw call however many particles are alive.
+	Blending is left to the caller - set it up before GAE_ParticleSystem_draw.
+*/
+
+/* Emitters above this capacity need 32 bit indices, which unextended ES lacks. */
+#define GAE_PARTICLE_EMITTER_SHORT_CAPACITY 16384U
+
+struct GAE_Array_s;
+struct GAE_Mesh_s;
+struct GAE_Material_s;
+struct GAE_Shader_s;
+struct GAE_Texture_s;
+struct GAE_Renderer_s;
+
+typedef struct GAE_ParticleEmitter_Settings_s {
+	GAE_Vector2_t position;			/* where new particles spawn */
+	GAE_Vector2_t area;				/* half extents of the box around position they spawn in */
+	GAE_Vector2_t velocity;			/* initial velocity, in units per second */
+	GAE_Vector2_t velocityVariance;	/* up to this much is randomly added or taken from each component */
+	GAE_Vector2_t acceleration;		/* gravity, wind and the like */
+	float minLife;					/* in seconds */
+	float maxLife;
+	float startSize;				/* sizes and colours blend from start to end over each particle's life */
+	float endSize;
+	GAE_Vector4_t startColour;		/* RGBA from 0 to 1 */
+	GAE_Vector4_t endColour;
+	float rate;						/* particles spawned per second while emitting */
+} GAE_ParticleEmitter_Settings_t;
+
+typedef struct GAE_ParticleEmitter_s {
+	GAE_ParticleEmitter_Settings_t settings;
+	GAE_BOOL isEmitting;
+	float spawnAccumulator;
+	unsigned int capacity;
+	unsigned int count;				/* the first count entries of each array are alive */
+	float* positionX;
+	float* positionY;
+	float* velocityX;
+	float* velocityY;
+	float* age;
+	float* inverseLife;				/* 1 / lifetime, so age * inverseLife runs 0 to 1 */
+	float* size;
+	unsigned int* colour;			/* RGBA bytes in memory order, as they go to the vertex */
+	struct GAE_Mesh_s* mesh;
+	struct GAE_Material_s* material;
+} GAE_ParticleEmitter_t;
+
+typedef struct GAE_ParticleSystem_s {
+	struct GAE_Array_s* emitters;	/* GAE_ParticleEmitter_t* */
+	struct GAE_Shader_s* texturedShader;	/* created when first needed, shared by every emitter */
+	struct GAE_Shader_s* untexturedShader;
+	unsigned int random;
+	GAE_Matrix4_t transform;
+} GAE_ParticleSystem_t;
+
+/* Creates an empty Particle System. */
+GAE_ParticleSystem_t* GAE_ParticleSystem_create(void);
+
+/* Adds an emitter with room for capacity particles, drawn with texture or as soft dots if it is 0. The texture is copied into the emitter's material. */
+GAE_ParticleEmitter_t* GAE_ParticleSystem_addEmitter(GAE_ParticleSystem_t* system, const unsigned int capacity, struct GAE_Texture_s* const texture);
+
+/* Spawns amount particles at once, as far as the emitter has room. */
+GAE_ParticleEmitter_t* GAE_ParticleSystem_burst(GAE_ParticleSystem_t* system, GAE_ParticleEmitter_t* emitter, const unsigned int amount);
+
+/* Steps every emitter by deltaTime seconds and rebuilds their vertices. */
+GAE_ParticleSystem_t* GAE_ParticleSystem_update(GAE_ParticleSystem_t* system, const float deltaTime);
+
+/* Draws every emitter with live particles, one draw call each. */
+GAE_ParticleSystem_t* GAE_ParticleSystem_draw(GAE_ParticleSystem_t* system, struct GAE_Renderer_s* renderer);
+
+/* Returns how many particles are alive across all emitters. */
+unsigned int GAE_ParticleSystem_getParticleCount(GAE_ParticleSystem_t* system);
+
+/* Deletes the Particle System, its emitters and shaders. */
+void GAE_ParticleSystem_delete(GAE_ParticleSystem_t* system);
+
+#endif
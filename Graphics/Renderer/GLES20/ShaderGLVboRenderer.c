@@ -1,6 +1,8 @@
 #include "ShaderGLVboRenderer.h"
 
-#if defined(GLX)
+#if defined(MOCKGL)
+	#include "../../Context/Mock/MockGL.h"
+#elif defined(GLX)
 	#include "../../Context/GLX/GLee.h"
 #elif defined(GLES2)
 	#if defined(PANDORA) || defined(ANDROID)
@@ -18,8 +20,13 @@
 #include "../../State/GLES2/GLES2State.h"
 
 #include <stdlib.h>
+#include <string.h>
 
 void setupAttributes(GAE_Renderer_t* renderer, GAE_VertexBuffer_t* vertexBuffer);
+static GLenum getPrimitiveMode(const GAE_IndexBuffer_Format format);
+static GLenum getIndexType(GAE_Renderer_t* renderer, const GAE_IndexBuffer_IndexType type);
+static GAE_BOOL hasUintIndices(GAE_Renderer_t* renderer);
+static void narrowIndices(GAE_IndexBuffer_t* indexBuffer);
 
 GAE_Renderer_t* GAE_Renderer_create(void) {
 	GAE_Renderer_t* renderer = malloc(sizeof(GAE_Renderer_t));
@@ -27,7 +34,10 @@ GAE_Renderer_t* GAE_Renderer_create(void) {
 	renderer->lastVertexBuffer = 0;
 	renderer->lastIndexBuffer = 0;
 	renderer->lastTexture = 0;
+	renderer->bufferChanges = 0U;
 	renderer->state = GAE_RenderState_create();
+	renderer->hasCheckedExtensions = GAE_FALSE;
+	renderer->hasUintIndices = GAE_FALSE;
 
 	return renderer;
 }
@@ -46,17 +56,30 @@ GAE_Renderer_t* GAE_Renderer_drawMesh(GAE_Renderer_t* renderer, GAE_Mesh_t* cons
 	GAE_IndexBuffer_t* const indexBuffer = mesh->iBuffer;
 	GAE_VertexBuffer_t* const vertexBuffer = mesh->vBuffer;
 	GAE_Material_t* const material = mesh->material;
+	GAE_RenderState_GLES2_t* const state = (GAE_RenderState_GLES2_t*)renderer->state->platform;
+
+	/* a new or reloaded shader may put the attributes elsewhere, so the pointers need setting up again */
+	if ((state->currentShader != material->shader) || (state->program != material->shader->program))
+		renderer->lastVertexBuffer = 0;
+
+	/* the last buffers may since have been deleted, and a new one given the same memory */
+	if (renderer->bufferChanges != GAE_VertexBuffer_getUnshadowedChanges() + GAE_IndexBuffer_getUnshadowedChanges()) {
+		renderer->lastVertexBuffer = 0;
+		renderer->lastIndexBuffer = 0;
+		renderer->bufferChanges = GAE_VertexBuffer_getUnshadowedChanges() + GAE_IndexBuffer_getUnshadowedChanges();
+	}
 
 	GAE_RenderState_bindShader(renderer->state, material->shader);
 	GAE_RenderState_updateUniforms(renderer->state, material, transform);
 	GAE_RenderState_updateTextures(renderer->state, material);
 	
-	if (renderer->lastVertexBuffer != vertexBuffer) {
+	/* Pending updates need the buffer bound, even if it was the last one used */
+	if ((renderer->lastVertexBuffer != vertexBuffer) || (0 != vertexBuffer->updateData)) {
 		renderer->lastVertexBuffer = vertexBuffer;
 		if (0 == vertexBuffer->vboId) {
 			vertexBuffer->vboId = malloc(sizeof(GLuint));
 			glGenBuffers(1, vertexBuffer->vboId);
-			glBindBuffer(GL_ARRAY_BUFFER, *vertexBuffer->vboId);
+			GAE_RenderState_bindBuffer(renderer->state, GL_ARRAY_BUFFER, *vertexBuffer->vboId);
 			switch (vertexBuffer->type) {
 				case GAE_VERTEXBUFFER_TYPE_STATIC:
 					glBufferData(GL_ARRAY_BUFFER, vertexBuffer->size, vertexBuffer->data, GL_STATIC_DRAW);
@@ -70,7 +93,7 @@ GAE_Renderer_t* GAE_Renderer_drawMesh(GAE_Renderer_t* renderer, GAE_Mesh_t* cons
 			};
 		}
 		else {
-			glBindBuffer(GL_ARRAY_BUFFER, *vertexBuffer->vboId);
+			GAE_RenderState_bindBuffer(renderer->state, GL_ARRAY_BUFFER, *vertexBuffer->vboId);
 			if (0 != vertexBuffer->updateData) {
 				/* TODO: Assert that this buffer is either stream or dynamic.. should not be updating static buffers! */
 				glBufferSubData(GL_ARRAY_BUFFER, vertexBuffer->updateData->offset, vertexBuffer->updateData->size, vertexBuffer->updateData->data);
@@ -85,12 +108,16 @@ GAE_Renderer_t* GAE_Renderer_drawMesh(GAE_Renderer_t* renderer, GAE_Mesh_t* cons
 		setupAttributes(renderer, vertexBuffer);
 	}
 	
-	if (renderer->lastIndexBuffer != indexBuffer) {
+	if ((renderer->lastIndexBuffer != indexBuffer) || (0 != indexBuffer->updateData)) {
 		renderer->lastIndexBuffer = indexBuffer;
 		if (0 == indexBuffer->vboId) {
+			/* only static buffers are narrowed, later sub data updates would still be 32 bit */
+			if ((GAE_INDEXBUFFER_INDEX_UNSIGNED_INT == indexBuffer->type) && (GAE_INDEXBUFFER_DRAW_STATIC == indexBuffer->draw) && (GAE_FALSE == hasUintIndices(renderer)))
+				narrowIndices(indexBuffer);
+
 			indexBuffer->vboId = malloc(sizeof(GLuint));
 			glGenBuffers(1, indexBuffer->vboId);
-			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *indexBuffer->vboId);
+			GAE_RenderState_bindBuffer(renderer->state, GL_ELEMENT_ARRAY_BUFFER, *indexBuffer->vboId);
 			switch (indexBuffer->draw) {
 				case GAE_INDEXBUFFER_DRAW_STATIC:
 					glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexBuffer->size, indexBuffer->data, GL_STATIC_DRAW);
@@ -104,7 +131,7 @@ GAE_Renderer_t* GAE_Renderer_drawMesh(GAE_Renderer_t* renderer, GAE_Mesh_t* cons
 			};
 		}
 		else {
-			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *indexBuffer->vboId);
+			GAE_RenderState_bindBuffer(renderer->state, GL_ELEMENT_ARRAY_BUFFER, *indexBuffer->vboId);
 			if (0 != indexBuffer->updateData) {
 				glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, indexBuffer->updateData->offset, indexBuffer->updateData->size, indexBuffer->updateData->data);
 				if (GAE_FALSE == indexBuffer->updateData->retain) {
@@ -116,19 +143,11 @@ GAE_Renderer_t* GAE_Renderer_drawMesh(GAE_Renderer_t* renderer, GAE_Mesh_t* cons
 		}
 	}
 
-	switch (indexBuffer->type) {
-		case GAE_INDEXBUFFER_INDEX_FLOAT:
-			glDrawElements(GL_TRIANGLES, indexBuffer->count, GL_FLOAT, 0);
-			break;
-		case GAE_INDEXBUFFER_INDEX_UNSIGNED_BYTE:
-			glDrawElements(GL_TRIANGLES, indexBuffer->count, GL_UNSIGNED_BYTE, 0);
-			break;
-		case GAE_INDEXBUFFER_INDEX_UNSIGNED_SHORT:
-			glDrawElements(GL_TRIANGLES, indexBuffer->count, GL_UNSIGNED_SHORT, 0);
-			break;
-		default:
-			break;
-	};
+	{
+		const GLenum indexType = getIndexType(renderer, indexBuffer->type);
+		if (GL_INVALID_VALUE != indexType)
+			glDrawElements(getPrimitiveMode(indexBuffer->format), indexBuffer->count, indexType, 0);
+	}
 
 	return renderer;
 }
@@ -204,3 +223,77 @@ void setupAttributes(GAE_Renderer_t* renderer, GAE_VertexBuffer_t* vertexBuffer)
 		};
 	}
 }
+
+GLenum getPrimitiveMode(const GAE_IndexBuffer_Format format) {
+	switch (format) {
+		case GAE_INDEXBUFFER_FORMAT_POINTS:
+			return GL_POINTS;
+		case GAE_INDEXBUFFER_FORMAT_LINES:
+			return GL_LINES;
+		case GAE_INDEXBUFFER_FORMAT_LINE_STRIP:
+			return GL_LINE_STRIP;
+		case GAE_INDEXBUFFER_FORMAT_LINE_LOOP:
+			return GL_LINE_LOOP;
+		case GAE_INDEXBUFFER_FORMAT_TRAINGLE_STRIP:
+			return GL_TRIANGLE_STRIP;
+		case GAE_INDEXBUFFER_FORMAT_TRIANGLE_FAN:
+			return GL_TRIANGLE_FAN;
+		case GAE_INDEXBUFFER_FORMAT_TRIANGLES:
+		default:
+			return GL_TRIANGLES;
+	};
+}
+
+GLenum getIndexType(GAE_Renderer_t* renderer, const GAE_IndexBuffer_IndexType type) {
+	switch (type) {
+		case GAE_INDEXBUFFER_INDEX_UNSIGNED_BYTE:
+			return GL_UNSIGNED_BYTE;
+		case GAE_INDEXBUFFER_INDEX_UNSIGNED_SHORT:
+			return GL_UNSIGNED_SHORT;
+		case GAE_INDEXBUFFER_INDEX_UNSIGNED_INT:
+			return (GAE_TRUE == hasUintIndices(renderer)) ? GL_UNSIGNED_INT : GL_INVALID_VALUE;
+		case GAE_INDEXBUFFER_INDEX_FLOAT: /* GL has no float indices */
+		default:
+			return GL_INVALID_VALUE;
+	};
+}
+
+GAE_BOOL hasUintIndices(GAE_Renderer_t* renderer) {
+	/* checked on first use, as the renderer may be created before the context */
+	if (GAE_FALSE == renderer->hasCheckedExtensions) {
+		#if defined(GLES2) || defined(MOCKGL)
+			const char* extensions = (const char*)glGetString(GL_EXTENSIONS);
+			renderer->hasUintIndices = ((0 != extensions) && (0 != strstr(extensions, "GL_OES_element_index_uint"))) ? GAE_TRUE : GAE_FALSE;
+		#else
+			renderer->hasUintIndices = GAE_TRUE;
+		#endif
+		renderer->hasCheckedExtensions = GAE_TRUE;
+	}
+
+	return renderer->hasUintIndices;
+}
+
+void narrowIndices(GAE_IndexBuffer_t* indexBuffer) {
+	const unsigned int* source = (const unsigned int*)(void*)indexBuffer->data;
+	/* the whole buffer, not just count - callers may draw fewer indices than they upload */
+	const unsigned int total = indexBuffer->size / sizeof(unsigned int);
+	unsigned short* target = 0;
+	unsigned int index = 0U;
+
+	/* without the extension, 32 bit indices that fit are drawn as shorts - the rest can't be drawn at all */
+	for (index = 0U; index < total; ++index) {
+		if (0xFFFFU < source[index])
+			return;
+	}
+
+	target = malloc(sizeof(unsigned short) * total);
+	for (index = 0U; index < total; ++index)
+		target[index] = (unsigned short)source[index];
+
+	if (GAE_TRUE == indexBuffer->owned)
+		free(indexBuffer->data);
+	indexBuffer->data = (GAE_BYTE*)target;
+	indexBuffer->owned = GAE_TRUE;
+	indexBuffer->size = sizeof(unsigned short) * total;
+	indexBuffer->type = GAE_INDEXBUFFER_INDEX_UNSIGNED_SHORT;
+}
@@ -14,7 +14,10 @@ typedef struct GAE_Renderer_s {
 	struct GAE_VertexBuffer_s* lastVertexBuffer;
 	struct GAE_IndexBuffer_s* lastIndexBuffer;
 	struct GAE_Texture_s* lastTexture;
+	unsigned int bufferChanges; /* vertex and index buffer deletes counted when lastVertexBuffer and lastIndexBuffer were set */
 	struct GAE_RenderState_s* state;
+	GAE_BOOL hasCheckedExtensions;
+	GAE_BOOL hasUintIndices; /* GL_OES_element_index_uint on ES, always on desktop GL */
 } GAE_Renderer_t;
 
 GAE_Renderer_t* GAE_Renderer_create(void);
@@ -0,0 +1,321 @@
+#include "RenderQueue.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Renderer.h"
+#include "../Material.h"
+#include "../Mesh.h"
+#include "../VertexBuffer.h"
+#include "../../Threads/Thread.h"
+#include "../../Utils/LinearAllocator.h"
+
+#define GAE_RENDER_COMMAND_LIST_BLOCK_SIZE 65536U
+#define GAE_RENDER_QUEUE_BATCHES_PER_THREAD 8U
+
+typedef struct GAE_RenderQueue_Worker_s {
+	GAE_RenderQueue_t* queue;
+	unsigned int list;
+} GAE_RenderQueue_Worker_t;
+
+static void workerMain(void* userData);
+static void recordJobs(GAE_RenderQueue_t* queue, GAE_RenderCommandList_t* list);
+static unsigned int hashPointer(const void* pointer, const unsigned int bits);
+static GAE_RenderQueue_Entry_t* sortEntries(GAE_RenderQueue_Entry_t* entries, GAE_RenderQueue_Entry_t* scratch, const unsigned int count);
+
+GAE_RenderCommandList_t* GAE_RenderCommandList_create(void) {
+	GAE_RenderCommandList_t* list = malloc(sizeof(GAE_RenderCommandList_t));
+
+	list->allocator = GAE_LinearAllocator_create(GAE_RENDER_COMMAND_LIST_BLOCK_SIZE);
+	list->commands = 0;
+	list->count = 0U;
+	list->capacity = 0U;
+
+	return list;
+}
+
+GAE_RenderCommand_t* GAE_RenderCommandList_draw(GAE_RenderCommandList_t* list, const unsigned long long key, GAE_Mesh_t* const mesh, const GAE_Matrix4_t transform) {
+	GAE_RenderCommand_t* command = 0;
+
+	if (list->count == list->capacity) {
+		list->capacity = (0U < list->capacity) ? list->capacity * 2U : 256U;
+		list->commands = realloc(list->commands, sizeof(GAE_RenderCommand_t) * list->capacity);
+	}
+
+	command = list->commands + list->count++;
+	command->key = key;
+	command->mesh = mesh;
+	command->transform = GAE_LinearAllocator_allocate(list->allocator, sizeof(GAE_Matrix4_t), 16U);
+	command->update = 0;
+	memcpy(command->transform, transform, sizeof(GAE_Matrix4_t));
+
+	return command;
+}
+
+GAE_VertexBuffer_UpdateData_t* GAE_RenderCommandList_update(GAE_RenderCommandList_t* list, GAE_RenderCommand_t* command, const unsigned int offset, const unsigned int size) {
+	GAE_VertexBuffer_UpdateData_t* update = GAE_LinearAllocator_allocate(list->allocator, sizeof(GAE_VertexBuffer_UpdateData_t), sizeof(void*));
+
+	/* retained, as the allocator owns the data and the renderer must not free it */
+	update->retain = GAE_TRUE;
+	update->offset = offset;
+	update->size = size;
+	update->data = GAE_LinearAllocator_allocate(list->allocator, size, 16U);
+	command->update = update;
+
+	return update;
+}
+
+void* GAE_RenderCommandList_allocate(GAE_RenderCommandList_t* list, const unsigned int size) {
+	return GAE_LinearAllocator_allocate(list->allocator, size, 16U);
+}
+
+GAE_RenderCommandList_t* GAE_RenderCommandList_reset(GAE_RenderCommandList_t* list) {
+	GAE_LinearAllocator_reset(list->allocator);
+	list->count = 0U;
+
+	return list;
+}
+
+void GAE_RenderCommandList_delete(GAE_RenderCommandList_t* list) {
+	GAE_LinearAllocator_delete(list->allocator);
+	free(list->commands);
+	free(list);
+	list = 0;
+}
+
+unsigned long long GAE_RenderCommand_makeKey(const unsigned int layer, GAE_Mesh_t* const mesh, const float depth) {
+	GAE_Material_t* const material = mesh->material;
+	unsigned int depthBits = 0U;
+
+	/* flipping the sign bit, and every bit of negatives, makes floats sort as unsigned integers */
+	memcpy(&depthBits, &depth, sizeof(depthBits));
+	depthBits = (0U != (depthBits & 0x80000000U)) ? ~depthBits : depthBits | 0x80000000U;
+
+	/* 8 bits of layer, 12 of shader, 12 of material, 32 of depth */
+	return ((unsigned long long)(layer & 0xFFU) << 56U)
+		| ((unsigned long long)hashPointer(material->shader, 12U) << 44U)
+		| ((unsigned long long)hashPointer(material, 12U) << 32U)
+		| (unsigned long long)depthBits;
+}
+
+GAE_RenderQueue_t* GAE_RenderQueue_create(const unsigned int threadCount) {
+	GAE_RenderQueue_t* queue = malloc(sizeof(GAE_RenderQueue_t));
+	unsigned int count = (0U < threadCount) ? threadCount : GAE_Thread_getHardwareCount();
+	unsigned int index = 0U;
+
+	queue->listCount = count;
+	queue->lists = malloc(sizeof(GAE_RenderCommandList_t*) * count);
+	for (index = 0U; index < count; ++index)
+		queue->lists[index] = GAE_RenderCommandList_create();
+
+	queue->mutex = GAE_Mutex_create();
+	queue->workReady = GAE_Condition_create();
+	queue->workDone = GAE_Condition_create();
+	queue->recorder = 0;
+	queue->userData = 0;
+	queue->nextJob = 0U;
+	queue->jobCount = 0U;
+	queue->batchSize = 1U;
+	queue->busyWorkers = 0U;
+	queue->generation = 0U;
+	queue->isRunning = GAE_TRUE;
+	queue->entries = 0;
+	queue->entryCapacity = 0U;
+	queue->lastCommandCount = 0U;
+
+	/* the calling thread records too, so it needs one fewer worker */
+	queue->threads = malloc(sizeof(GAE_Thread_t*) * count);
+	queue->workers = malloc(sizeof(GAE_RenderQueue_Worker_t) * count);
+	queue->threads[0] = 0;
+	queue->workerCount = 0U;
+	for (index = 1U; index < count; ++index) {
+		queue->workers[index].queue = queue;
+		queue->workers[index].list = index;
+		queue->threads[index] = GAE_Thread_create(workerMain, queue->workers + index);
+		if (0 != queue->threads[index])
+			++queue->workerCount;
+	}
+
+	return queue;
+}
+
+GAE_RenderQueue_t* GAE_RenderQueue_record(GAE_RenderQueue_t* queue, const unsigned int jobCount, GAE_RenderQueue_Recorder_t recorder, void* const userData) {
+	unsigned int batchSize = jobCount / (queue->listCount * GAE_RENDER_QUEUE_BATCHES_PER_THREAD);
+
+	if (0U == jobCount)
+		return queue;
+
+	GAE_Mutex_lock(queue->mutex);
+	queue->recorder = recorder;
+	queue->userData = userData;
+	queue->nextJob = 0U;
+	queue->jobCount = jobCount;
+	queue->batchSize = (0U < batchSize) ? batchSize : 1U;
+	queue->busyWorkers = queue->workerCount;
+	++queue->generation;
+	GAE_Condition_broadcast(queue->workReady);
+
+	recordJobs(queue, queue->lists[0]);
+
+	while (0U < queue->busyWorkers)
+		GAE_Condition_wait(queue->workDone, queue->mutex);
+	GAE_Mutex_unlock(queue->mutex);
+
+	return queue;
+}
+
+GAE_RenderQueue_t* GAE_RenderQueue_submit(GAE_RenderQueue_t* queue, GAE_Renderer_t* renderer) {
+	GAE_RenderQueue_Entry_t* sorted = 0;
+	unsigned int count = 0U;
+	unsigned int index = 0U;
+	unsigned int command = 0U;
+
+	for (index = 0U; index < queue->listCount; ++index)
+		count += queue->lists[index]->count;
+
+	if (count > queue->entryCapacity) {
+		queue->entryCapacity = count;
+		queue->entries = realloc(queue->entries, sizeof(GAE_RenderQueue_Entry_t) * count * 2U);
+	}
+
+	count = 0U;
+	for (index = 0U; index < queue->listCount; ++index) {
+		GAE_RenderCommandList_t* list = queue->lists[index];
+		for (command = 0U; command < list->count; ++command) {
+			queue->entries[count].key = list->commands[command].key;
+			queue->entries[count].command = list->commands + command;
+			++count;
+		}
+	}
+
+	sorted = sortEntries(queue->entries, queue->entries + count, count);
+
+	for (index = 0U; index < count; ++index) {
+		GAE_RenderCommand_t* current = sorted[index].command;
+		GAE_VertexBuffer_t* vertexBuffer = current->mesh->vBuffer;
+		GAE_VertexBuffer_UpdateData_t* previous = vertexBuffer->updateData;
+
+		if (0 != current->update)
+			vertexBuffer->updateData = current->update;
+
+		GAE_Renderer_drawMesh(renderer, current->mesh, current->transform);
+
+		if (0 != current->update)
+			vertexBuffer->updateData = previous;
+	}
+
+	for (index = 0U; index < queue->listCount; ++index)
+		GAE_RenderCommandList_reset(queue->lists[index]);
+	queue->lastCommandCount = count;
+
+	return queue;
+}
+
+void GAE_RenderQueue_delete(GAE_RenderQueue_t* queue) {
+	unsigned int index = 0U;
+
+	GAE_Mutex_lock(queue->mutex);
+	queue->isRunning = GAE_FALSE;
+	GAE_Condition_broadcast(queue->workReady);
+	GAE_Mutex_unlock(queue->mutex);
+
+	for (index = 1U; index < queue->listCount; ++index) {
+		if (0 != queue->threads[index])
+			GAE_Thread_delete(queue->threads[index]);
+	}
+
+	for (index = 0U; index < queue->listCount; ++index)
+		GAE_RenderCommandList_delete(queue->lists[index]);
+
+	GAE_Condition_delete(queue->workReady);
+	GAE_Condition_delete(queue->workDone);
+	GAE_Mutex_delete(queue->mutex);
+	free(queue->lists);
+	free(queue->threads);
+	free(queue->workers);
+	free(queue->entries);
+	free(queue);
+	queue = 0;
+}
+
+void workerMain(void* userData) {
+	GAE_RenderQueue_Worker_t* worker = (GAE_RenderQueue_Worker_t*)userData;
+	GAE_RenderQueue_t* queue = worker->queue;
+	unsigned int generation = 0U;
+
+	/* every queue starts at generation 0, so work recorded before this thread got going isn't missed */
+	GAE_Mutex_lock(queue->mutex);
+
+	for (;;) {
+		while ((GAE_TRUE == queue->isRunning) && (generation == queue->generation))
+			GAE_Condition_wait(queue->workReady, queue->mutex);
+
+		if (GAE_FALSE == queue->isRunning)
+			break;
+
+		generation = queue->generation;
+		recordJobs(queue, queue->lists[worker->list]);
+
+		--queue->busyWorkers;
+		if (0U == queue->busyWorkers)
+			GAE_Condition_signal(queue->workDone);
+	}
+
+	GAE_Mutex_unlock(queue->mutex);
+}
+
+void recordJobs(GAE_RenderQueue_t* queue, GAE_RenderCommandList_t* list) {
+	/* called and returns with the mutex held - it's only dropped while recording */
+	while (queue->nextJob < queue->jobCount) {
+		const unsigned int begin = queue->nextJob;
+		const unsigned int end = (queue->jobCount - begin > queue->batchSize) ? begin + queue->batchSize : queue->jobCount;
+
+		queue->nextJob = end;
+		GAE_Mutex_unlock(queue->mutex);
+		queue->recorder(list, begin, end, queue->userData);
+		GAE_Mutex_lock(queue->mutex);
+	}
+}
+
+unsigned int hashPointer(const void* pointer, const unsigned int bits) {
+	const size_t value = (size_t)pointer;
+	unsigned int hash = (unsigned int)(value >> 4U) ^ (unsigned int)((unsigned long long)value >> 32U);
+
+	/* Fibonacci hashing - the top bits are the well mixed ones */
+	hash *= 2654435769U;
+	return hash >> (32U - bits);
+}
+
+GAE_RenderQueue_Entry_t* sortEntries(GAE_RenderQueue_Entry_t* entries, GAE_RenderQueue_Entry_t* scratch, const unsigned int count) {
+	unsigned int counts[256];
+	unsigned int shift = 0U;
+	unsigned int index = 0U;
+
+	/* least significant byte first - a pass is skipped when every key shares that byte, as most frames share layers and shaders */
+	for (shift = 0U; shift < 64U; shift += 8U) {
+		unsigned int offset = 0U;
+		GAE_RenderQueue_Entry_t* swap = 0;
+
+		memset(counts, 0, sizeof(counts));
+		for (index = 0U; index < count; ++index)
+			++counts[(entries[index].key >> shift) & 0xFFU];
+
+		if ((0U == count) || (count == counts[(entries[0].key >> shift) & 0xFFU]))
+			continue;
+
+		for (index = 0U; index < 256U; ++index) {
+			const unsigned int bucket = counts[index];
+			counts[index] = offset;
+			offset += bucket;
+		}
+
+		for (index = 0U; index < count; ++index)
+			scratch[counts[(entries[index].key >> shift) & 0xFFU]++] = entries[index];
+
+		swap = entries;
+		entries = scratch;
+		scratch = swap;
+	}
+
+	return entries;
+}
@@ -0,0 +1,101 @@
+#ifndef _RENDER_QUEUE_H_
+#define _RENDER_QUEUE_H_
+
+#include "../../GAE_Types.h"
+
+/*
+	Render commands recorded across threads and replayed through GAE_Renderer_drawMesh on the GL thread.
+	The CPU side of drawing - culling, transforms, sort keys, generated vertices - happens in a recorder callback,
+	which the queue runs over a range of jobs on its workers and the calling thread at once, each writing to its own command list.
+	Submitting then merges the lists, sorts them by key to group shaders and materials, and draws them in order.
+	Anything a command points at must stay alive until it is submitted - transforms and vertex updates recorded
+	through the list live in its allocator, and so last exactly that long.
+*/
+
+struct GAE_Condition_s;
+struct GAE_LinearAllocator_s;
+struct GAE_Mesh_s;
+struct GAE_Mutex_s;
+struct GAE_Renderer_s;
+struct GAE_Thread_s;
+struct GAE_VertexBuffer_UpdateData_s;
+struct GAE_RenderQueue_Worker_s;
+
+typedef struct GAE_RenderCommand_s {
+	unsigned long long key;
+	struct GAE_Mesh_s* mesh;
+	GAE_Matrix4_t* transform;
+	struct GAE_VertexBuffer_UpdateData_s* update;	/* vertices to upload before drawing, or 0 */
+} GAE_RenderCommand_t;
+
+typedef struct GAE_RenderCommandList_s {
+	struct GAE_LinearAllocator_s* allocator;	/* per frame data, reset on submit */
+	GAE_RenderCommand_t* commands;
+	unsigned int count;
+	unsigned int capacity;
+} GAE_RenderCommandList_t;
+
+/* Records jobs [begin, end) into list - called on several threads at once, so must not touch GL or shared state. */
+typedef void (*GAE_RenderQueue_Recorder_t)(GAE_RenderCommandList_t* list, const unsigned int begin, const unsigned int end, void* const userData);
+
+typedef struct GAE_RenderQueue_Entry_s {
+	unsigned long long key;
+	GAE_RenderCommand_t* command;
+} GAE_RenderQueue_Entry_t;
+
+typedef struct GAE_RenderQueue_s {
+	GAE_RenderCommandList_t** lists;	/* 0 is the calling thread's, then one per worker */
+	unsigned int listCount;
+	struct GAE_Thread_s** threads;
+	struct GAE_RenderQueue_Worker_s* workers;
+	unsigned int workerCount;			/* threads that actually started */
+	struct GAE_Mutex_s* mutex;
+	struct GAE_Condition_s* workReady;
+	struct GAE_Condition_s* workDone;
+	GAE_RenderQueue_Recorder_t recorder;
+	void* userData;
+	unsigned int nextJob;
+	unsigned int jobCount;
+	unsigned int batchSize;
+	unsigned int busyWorkers;
+	unsigned int generation;			/* bumped per record, so workers know there's new work */
+	GAE_BOOL isRunning;
+	GAE_RenderQueue_Entry_t* entries;	/* merged commands, and the radix sort's scratch space after them */
+	unsigned int entryCapacity;
+	unsigned int lastCommandCount;
+} GAE_RenderQueue_t;
+
+/* Creates a new command list. */
+GAE_RenderCommandList_t* GAE_RenderCommandList_create(void);
+
+/* Records a draw of mesh with a copy of transform, returning the command so an update may be attached. */
+GAE_RenderCommand_t* GAE_RenderCommandList_draw(GAE_RenderCommandList_t* list, const unsigned long long key, struct GAE_Mesh_s* const mesh, const GAE_Matrix4_t transform);
+
+/* Attaches a vertex update of size bytes at offset to command, returning it for the caller to fill. */
+struct GAE_VertexBuffer_UpdateData_s* GAE_RenderCommandList_update(GAE_RenderCommandList_t* list, GAE_RenderCommand_t* command, const unsigned int offset, const unsigned int size);
+
+/* Returns size bytes that live until the list is submitted. This should NOT be freed. */
+void* GAE_RenderCommandList_allocate(GAE_RenderCommandList_t* list, const unsigned int size);
+
+/* Drops every recorded command. */
+GAE_RenderCommandList_t* GAE_RenderCommandList_reset(GAE_RenderCommandList_t* list);
+
+/* Deletes the command list. */
+void GAE_RenderCommandList_delete(GAE_RenderCommandList_t* list);
+
+/* Builds a sort key - layers draw in order, then shaders and materials are grouped, then smaller depths draw first. */
+unsigned long long GAE_RenderCommand_makeKey(const unsigned int layer, struct GAE_Mesh_s* const mesh, const float depth);
+
+/* Creates a queue recording on threadCount threads, counting the caller - 0 uses every hardware thread. */
+GAE_RenderQueue_t* GAE_RenderQueue_create(const unsigned int threadCount);
+
+/* Runs recorder over jobCount jobs across every thread, returning once all are recorded. May be called several times before submitting. */
+GAE_RenderQueue_t* GAE_RenderQueue_record(GAE_RenderQueue_t* queue, const unsigned int jobCount, GAE_RenderQueue_Recorder_t recorder, void* const userData);
+
+/* Sorts everything recorded and draws it with renderer, then resets the lists. Call from the GL thread. */
+GAE_RenderQueue_t* GAE_RenderQueue_submit(GAE_RenderQueue_t* queue, struct GAE_Renderer_s* renderer);
+
+/* Stops the workers and deletes the queue. */
+void GAE_RenderQueue_delete(GAE_RenderQueue_t* queue);
+
+#endif
@@ -3,7 +3,7 @@
 
 #if defined(SDL2)
 #include "SDL2/SDL2Renderer.h"
-#elif defined(GLX)
+#elif defined(GLX) || defined(MOCKGL)
 #include "GLES20/ShaderGLVboRenderer.h"
 #elif defined(ANDROID)
 #include "GLES20/ShaderGLVboRenderer.h"
@@ -1,15 +1,18 @@
 #include "Shader.h"
 
-#if defined(GLX) || defined(GLES1) || defined(GLES2)
+#if defined(GLX) || defined(GLES1) || defined(GLES2) || defined(MOCKGL)
 
 #include <assert.h>
 #include <stdlib.h>
 
+#include "ShaderCache.h"
 #include "../File/File.h"
 #include "../Utils/HashString.h"
 #include "../Utils/Map.h"
 
-#if defined(LINUX)
+#if defined(MOCKGL)
+	#include "Context/Mock/MockGL.h"
+#elif defined(LINUX)
 	#include "Context/GLX/GLee.h"
 #elif defined(PANDORA) || defined(ANDROID)
 	#if defined(GLES1)
@@ -20,10 +23,13 @@
 #endif
 
 GLuint loadShader(const char* shaderSource, const GLenum type);
-void checkShaderIsLinked(GAE_Shader_t* shader);
+GLuint linkProgram(const GLuint vertex, const GLuint fragment);
+void releaseProgram(GAE_Shader_t* shader);
 void findShaderAttributes(GAE_Shader_t* shader);
 void findShaderUniforms(GAE_Shader_t* shader);
 
+static GAE_ShaderCache_t* shaderCache = 0;
+
 GAE_Shader_t* GAE_Shader_create(GAE_File_t* const vFile, GAE_File_t* const fFile) {
 	GAE_Shader_t* shader = malloc(sizeof(GAE_Shader_t));
 	assert(shader);
@@ -34,45 +40,72 @@ GAE_Shader_t* GAE_Shader_create(GAE_File_t* const vFile, GAE_File_t* const fFile
 	shader->fragment = GL_INVALID_VALUE;
 	shader->program = GL_INVALID_VALUE;
 
+	/* a hit leaves no shader objects, just the program */
+	if ((0 != shaderCache) && (GAE_TRUE == GAE_ShaderCache_load(shaderCache, shader, (char*)vFile->buffer, vFile->bufferSize, (char*)fFile->buffer, fFile->bufferSize)))
+		return shader;
+
 	shader->vertex = loadShader((char*)vFile->buffer, GL_VERTEX_SHADER);
 	shader->fragment = loadShader((char*)fFile->buffer, GL_FRAGMENT_SHADER);
 	assert(GL_INVALID_VALUE != shader->vertex);
 	assert(GL_INVALID_VALUE != shader->fragment);
 
-	shader->program = glCreateProgram();
-	glAttachShader(shader->program, shader->vertex);
-	glAttachShader(shader->program, shader->fragment);
-	glLinkProgram(shader->program);
-
-	checkShaderIsLinked(shader);
-	assert(shader);
+	shader->program = linkProgram(shader->vertex, shader->fragment);
+	assert(GL_INVALID_VALUE != shader->program);
+	if (GL_INVALID_VALUE == shader->program) {
+		GAE_Shader_delete(shader);
+		shader = 0;
+	}
 
 	if (0 != shader) {
 		findShaderAttributes(shader);
 		findShaderUniforms(shader);
+
+		if (0 != shaderCache)
+			GAE_ShaderCache_store(shaderCache, shader, (char*)vFile->buffer, vFile->bufferSize, (char*)fFile->buffer, fFile->bufferSize);
 	}
 
 	return shader;
 }
 
-void GAE_Shader_delete(GAE_Shader_t* shader) {
+GAE_BOOL GAE_Shader_reload(GAE_Shader_t* shader, GAE_File_t* const vFile, GAE_File_t* const fFile) {
+	const GLuint vertex = loadShader((char*)vFile->buffer, GL_VERTEX_SHADER);
+	const GLuint fragment = loadShader((char*)fFile->buffer, GL_FRAGMENT_SHADER);
+	GLuint program = GL_INVALID_VALUE;
+
+	if ((GL_INVALID_VALUE != vertex) && (GL_INVALID_VALUE != fragment))
+		program = linkProgram(vertex, fragment);
+
+	/* the old program is only let go of once the new one has linked, so a broken edit leaves the last good one running */
+	if (GL_INVALID_VALUE == program) {
+		if (GL_INVALID_VALUE != vertex)
+			glDeleteShader(vertex);
+		if (GL_INVALID_VALUE != fragment)
+			glDeleteShader(fragment);
+		return GAE_FALSE;
+	}
+
+	releaseProgram(shader);
 	GAE_Map_delete(shader->attributes);
 	GAE_Map_delete(shader->uniforms);
+	shader->attributes = GAE_Map_create(sizeof(GAE_HashString_t), sizeof(GLint), GAE_HashString_compare);
+	shader->uniforms = GAE_Map_create(sizeof(GAE_HashString_t), sizeof(GLint), GAE_HashString_compare);
+	shader->vertex = vertex;
+	shader->fragment = fragment;
+	shader->program = program;
 
-	if (GL_INVALID_VALUE != shader->vertex) {
-		glDetachShader(shader->program, shader->vertex);
-		glDeleteShader(shader->vertex);
-	}
-	if (GL_INVALID_VALUE != shader->fragment) {
-		glDetachShader(shader->program, shader->fragment);
-		glDeleteShader(shader->fragment);
-	}
-	if (GL_INVALID_VALUE != shader->program)
-		glDeleteProgram(shader->program);
+	findShaderAttributes(shader);
+	findShaderUniforms(shader);
 
-	shader->vertex = GL_INVALID_VALUE;
-	shader->fragment = GL_INVALID_VALUE;
-	shader->program = GL_INVALID_VALUE;
+	if (0 != shaderCache)
+		GAE_ShaderCache_store(shaderCache, shader, (char*)vFile->buffer, vFile->bufferSize, (char*)fFile->buffer, fFile->bufferSize);
+
+	return GAE_TRUE;
+}
+
+void GAE_Shader_delete(GAE_Shader_t* shader) {
+	GAE_Map_delete(shader->attributes);
+	GAE_Map_delete(shader->uniforms);
+	releaseProgram(shader);
 
 	free(shader);
 	shader = 0;
@@ -92,6 +125,10 @@ GLint GAE_Shader_getUniform(GAE_Shader_t* const shader, const GAE_HashString_t i
 	else return GL_INVALID_VALUE;
 }
 
+void GAE_Shader_setCache(GAE_ShaderCache_t* const cache) {
+	shaderCache = cache;
+}
+
 GLuint loadShader(const char* shaderSource, const GLenum type) {
 	GLuint newShader = glCreateShader(type);
 	GLint isCompiled = 0;
@@ -114,32 +151,56 @@ GLuint loadShader(const char* shaderSource, const GLenum type) {
 		}
 
 		glDeleteShader(newShader);
-		assert(0);
 		return GL_INVALID_VALUE;
 	}
 
 	return newShader;
 }
 
-void checkShaderIsLinked(GAE_Shader_t* shader) {
+GLuint linkProgram(const GLuint vertex, const GLuint fragment) {
+	GLuint program = glCreateProgram();
 	GLint isLinked = 0;
 	GLint infoLength = 0;
 	char* infoLog = 0;
 
-	glGetProgramiv(shader->program, GL_LINK_STATUS, &isLinked);
+	glAttachShader(program, vertex);
+	glAttachShader(program, fragment);
+	glLinkProgram(program);
+
+	glGetProgramiv(program, GL_LINK_STATUS, &isLinked);
 	if (0 == isLinked) {
-		glGetProgramiv(shader->program, GL_INFO_LOG_LENGTH, &infoLength);
+		glGetProgramiv(program, GL_INFO_LOG_LENGTH, &infoLength);
 		if (1 < infoLength) {
 			infoLog = malloc(infoLength);
-			glGetShaderInfoLog(shader->program, infoLength, NULL, infoLog);
+			glGetProgramInfoLog(program, infoLength, NULL, infoLog);
+			printf("%s\n", infoLog);
 			/*Application::getInstance()->getLogger()->log(toString(infoLog) + "\n", Logger::LOG_TYPE_ERROR);*/
 			free(infoLog);
 			infoLog = 0;
 		}
 
-		assert(0);
-		GAE_Shader_delete(shader);
+		glDeleteProgram(program);
+		return GL_INVALID_VALUE;
 	}
+
+	return program;
+}
+
+void releaseProgram(GAE_Shader_t* shader) {
+	if (GL_INVALID_VALUE != shader->vertex) {
+		glDetachShader(shader->program, shader->vertex);
+		glDeleteShader(shader->vertex);
+	}
+	if (GL_INVALID_VALUE != shader->fragment) {
+		glDetachShader(shader->program, shader->fragment);
+		glDeleteShader(shader->fragment);
+	}
+	if (GL_INVALID_VALUE != shader->program)
+		glDeleteProgram(shader->program);
+
+	shader->vertex = GL_INVALID_VALUE;
+	shader->fragment = GL_INVALID_VALUE;
+	shader->program = GL_INVALID_VALUE;
 }
 
 void findShaderUniforms(GAE_Shader_t* shader) {
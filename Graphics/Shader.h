@@ -7,6 +7,7 @@ struct GAE_Map_s;
 struct GAE_Camera_s;
 struct GAE_Material_s;
 struct GAE_File_s;
+struct GAE_ShaderCache_s;
 
 typedef void (*GAE_Shader_UniformUpdater_t)(const int uniformId, struct GAE_Camera_s* const camera, struct GAE_Material_s* const material, GAE_Matrix4_t* const transform);
 
@@ -20,7 +21,14 @@ typedef struct GAE_Shader_s {
 
 GAE_Shader_t* GAE_Shader_create(struct GAE_File_s* const vertex, struct GAE_File_s* const fragment);
 void GAE_Shader_delete(GAE_Shader_t* shader);
+
+/* Compiles and links the shader again from new sources, keeping the old program if either fails - the render state notices the new program on its next bind. */
+GAE_BOOL GAE_Shader_reload(GAE_Shader_t* shader, struct GAE_File_s* const vertex, struct GAE_File_s* const fragment);
+
 int GAE_Shader_getAttribute(GAE_Shader_t* const shader, const GAE_HashString_t id);
 int GAE_Shader_getUniform(GAE_Shader_t* const shader, const GAE_HashString_t id);
 
+/* Has every following GAE_Shader_create try the cache before compiling, and store what it compiles - 0 turns it off again. */
+void GAE_Shader_setCache(struct GAE_ShaderCache_s* const cache);
+
 #endif
@@ -0,0 +1,331 @@
+#include "ShaderCache.h"
+
+#if defined(GLX) || defined(GLES2) || defined(MOCKGL)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Shader.h"
+#include "../Utils/Map.h"
+
+#if defined(MOCKGL)
+	#include "Context/Mock/MockGL.h"
+#elif defined(LINUX)
+	#include "Context/GLX/GLee.h"
+#elif defined(PANDORA) || defined(ANDROID)
+	#include <GLES2/gl2.h>
+	#include <EGL/egl.h>
+#endif
+
+/* the ARB and OES extensions share their values */
+#ifndef GL_PROGRAM_BINARY_LENGTH_OES
+	#define GL_PROGRAM_BINARY_LENGTH_OES 0x8741
+#endif
+#ifndef GL_NUM_PROGRAM_BINARY_FORMATS_OES
+	#define GL_NUM_PROGRAM_BINARY_FORMATS_OES 0x87FE
+#endif
+#ifndef GL_PROGRAM_BINARY_FORMATS_OES
+	#define GL_PROGRAM_BINARY_FORMATS_OES 0x87FF
+#endif
+
+#define FNV_OFFSET 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+
+typedef void (*GAE_GetProgramBinary_t)(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, GLvoid* binary);
+typedef void (*GAE_ProgramBinary_t)(GLuint program, GLenum binaryFormat, const GLvoid* binary, GLint length);
+
+static GAE_GetProgramBinary_t getProgramBinary = 0;
+static GAE_ProgramBinary_t programBinary = 0;
+
+static GAE_BOOL loadEntryPoints(void);
+static unsigned long long hashBytes(unsigned long long hash, const void* data, const unsigned long size);
+static unsigned long long getKey(GAE_ShaderCache_t* const cache, const char* vertex, const unsigned long vertexSize, const char* fragment, const unsigned long fragmentSize);
+static void getPath(GAE_ShaderCache_t* const cache, const unsigned long long key, const char* extension, char* path, const unsigned int pathSize);
+static GAE_BYTE* readEntry(const char* path, unsigned long* size);
+static unsigned int readUint32(const GAE_BYTE* data);
+static void writeUint32(GAE_BYTE* data, const unsigned int value);
+static unsigned long writeTable(GAE_BYTE* data, struct GAE_Map_s* map);
+static void readTable(const GAE_BYTE* data, const unsigned int count, struct GAE_Map_s* map);
+
+GAE_ShaderCache_t* GAE_ShaderCache_create(const char* directory) {
+	GAE_ShaderCache_t* cache = malloc(sizeof(GAE_ShaderCache_t));
+	const char* extensions = (const char*)glGetString(GL_EXTENSIONS);
+	const GLenum names[3] = { GL_VENDOR, GL_RENDERER, GL_VERSION };
+	GLint formatCount = 0;
+	GLint format = 0;
+	unsigned int index = 0U;
+
+	strncpy(cache->directory, directory, sizeof(cache->directory) - 1U);
+	cache->directory[sizeof(cache->directory) - 1U] = '\0';
+	cache->isSupported = GAE_FALSE;
+	cache->binaryFormat = 0U;
+	cache->hits = 0U;
+	cache->misses = 0U;
+	cache->rejects = 0U;
+	cache->stores = 0U;
+
+	/* a driver update changes at least one of these, and with it every key */
+	cache->driverKey = FNV_OFFSET;
+	for (index = 0U; index < 3U; ++index) {
+		const char* string = (const char*)glGetString(names[index]);
+		if (0 != string)
+			cache->driverKey = hashBytes(cache->driverKey, string, strlen(string) + 1U);
+	}
+
+	if ((0 == extensions) || ((0 == strstr(extensions, "GL_OES_get_program_binary")) && (0 == strstr(extensions, "GL_ARB_get_program_binary"))))
+		return cache;
+
+	/* a driver may advertise the extension with no formats, which is as good as not having it */
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS_OES, &formatCount);
+	if ((0 >= formatCount) || (GAE_FALSE == loadEntryPoints()))
+		return cache;
+
+	if (1 == formatCount)
+		glGetIntegerv(GL_PROGRAM_BINARY_FORMATS_OES, &format);
+	else {
+		GLint* formats = malloc(sizeof(GLint) * (unsigned int)formatCount);
+		glGetIntegerv(GL_PROGRAM_BINARY_FORMATS_OES, formats);
+		format = formats[0];
+		free(formats);
+	}
+
+	cache->binaryFormat = (unsigned int)format;
+	cache->isSupported = GAE_TRUE;
+	return cache;
+}
+
+GAE_BOOL GAE_ShaderCache_load(GAE_ShaderCache_t* cache, GAE_Shader_t* shader, const char* vertex, const unsigned long vertexSize, const char* fragment, const unsigned long fragmentSize) {
+	const unsigned long long key = getKey(cache, vertex, vertexSize, fragment, fragmentSize);
+	char path[1100];
+	GAE_BYTE* entry = 0;
+	unsigned long entrySize = 0U;
+	unsigned long long storedKey = 0U;
+	unsigned int binarySize = 0U;
+	unsigned int attributeCount = 0U;
+	unsigned int uniformCount = 0U;
+	unsigned long tableSize = 0U;
+	GLuint program = 0U;
+	GLint isLinked = 0;
+
+	if (GAE_FALSE == cache->isSupported) {
+		++cache->misses;
+		return GAE_FALSE;
+	}
+
+	getPath(cache, key, "gprg", path, sizeof(path));
+	entry = readEntry(path, &entrySize);
+	if (0 == entry) {
+		++cache->misses;
+		return GAE_FALSE;
+	}
+
+	if (GAE_SHADER_CACHE_HEADER_SIZE <= entrySize) {
+		memcpy(&storedKey, entry + 8U, sizeof(storedKey));
+		binarySize = readUint32(entry + 20U);
+		attributeCount = readUint32(entry + 24U);
+		uniformCount = readUint32(entry + 28U);
+		tableSize = ((unsigned long)attributeCount + uniformCount) * 8U;
+	}
+
+	/* anything that doesn't add up is treated as a miss, and replaced when the shader is stored again */
+	if ((GAE_SHADER_CACHE_HEADER_SIZE > entrySize) || (0 != memcmp(entry, "GPRG", 4U)) || (GAE_SHADER_CACHE_VERSION != readUint32(entry + 4U))
+	|| (key != storedKey) || (GAE_SHADER_CACHE_HEADER_SIZE + tableSize + binarySize != entrySize)) {
+		free(entry);
+		remove(path);
+		++cache->misses;
+		return GAE_FALSE;
+	}
+
+	program = glCreateProgram();
+	programBinary(program, (GLenum)readUint32(entry + 16U), entry + GAE_SHADER_CACHE_HEADER_SIZE + tableSize, (GLint)binarySize);
+	glGetProgramiv(program, GL_LINK_STATUS, &isLinked);
+	if (0 == isLinked) {
+		glDeleteProgram(program);
+		free(entry);
+		remove(path);
+		++cache->rejects;
+		++cache->misses;
+		return GAE_FALSE;
+	}
+
+	shader->program = program;
+	readTable(entry + GAE_SHADER_CACHE_HEADER_SIZE, attributeCount, shader->attributes);
+	readTable(entry + GAE_SHADER_CACHE_HEADER_SIZE + attributeCount * 8U, uniformCount, shader->uniforms);
+
+	free(entry);
+	++cache->hits;
+	return GAE_TRUE;
+}
+
+GAE_BOOL GAE_ShaderCache_store(GAE_ShaderCache_t* cache, GAE_Shader_t* const shader, const char* vertex, const unsigned long vertexSize, const char* fragment, const unsigned long fragmentSize) {
+	const unsigned long long key = getKey(cache, vertex, vertexSize, fragment, fragmentSize);
+	char path[1100];
+	char temporaryPath[1100];
+	GAE_BYTE* entry = 0;
+	unsigned long tableSize = 0U;
+	unsigned long written = 0U;
+	GLint binarySize = 0;
+	GLsizei binaryWritten = 0;
+	GLenum format = 0U;
+	FILE* file = 0;
+
+	if ((GAE_FALSE == cache->isSupported) || (GL_INVALID_VALUE == shader->program))
+		return GAE_FALSE;
+
+	glGetProgramiv(shader->program, GL_PROGRAM_BINARY_LENGTH_OES, &binarySize);
+	if (0 >= binarySize)
+		return GAE_FALSE;
+
+	tableSize = ((unsigned long)GAE_Map_length(shader->attributes) + GAE_Map_length(shader->uniforms)) * 8U;
+	entry = malloc(GAE_SHADER_CACHE_HEADER_SIZE + tableSize + (unsigned long)binarySize);
+
+	getProgramBinary(shader->program, binarySize, &binaryWritten, &format, entry + GAE_SHADER_CACHE_HEADER_SIZE + tableSize);
+	if (binaryWritten != binarySize) {
+		free(entry);
+		return GAE_FALSE;
+	}
+
+	memcpy(entry, "GPRG", 4U);
+	writeUint32(entry + 4U, GAE_SHADER_CACHE_VERSION);
+	memcpy(entry + 8U, &key, sizeof(key));
+	writeUint32(entry + 16U, (unsigned int)format);
+	writeUint32(entry + 20U, (unsigned int)binarySize);
+	writeUint32(entry + 24U, GAE_Map_length(shader->attributes));
+	writeUint32(entry + 28U, GAE_Map_length(shader->uniforms));
+	written = writeTable(entry + GAE_SHADER_CACHE_HEADER_SIZE, shader->attributes);
+	writeTable(entry + GAE_SHADER_CACHE_HEADER_SIZE + written, shader->uniforms);
+
+	/* written aside then renamed over, so a crash mid-write never leaves half an entry behind */
+	getPath(cache, key, "gprg", path, sizeof(path));
+	getPath(cache, key, "tmp", temporaryPath, sizeof(temporaryPath));
+	file = fopen(temporaryPath, "wb");
+	if (0 == file) {
+		free(entry);
+		return GAE_FALSE;
+	}
+
+	written = fwrite(entry, 1U, GAE_SHADER_CACHE_HEADER_SIZE + tableSize + (unsigned long)binarySize, file);
+	fclose(file);
+	free(entry);
+
+	if ((written != GAE_SHADER_CACHE_HEADER_SIZE + tableSize + (unsigned long)binarySize) || (0 != rename(temporaryPath, path))) {
+		remove(temporaryPath);
+		return GAE_FALSE;
+	}
+
+	++cache->stores;
+	return GAE_TRUE;
+}
+
+void GAE_ShaderCache_delete(GAE_ShaderCache_t* cache) {
+	free(cache);
+	cache = 0;
+}
+
+GAE_BOOL loadEntryPoints(void) {
+#if defined(MOCKGL)
+	getProgramBinary = glGetProgramBinaryOES;
+	programBinary = glProgramBinaryOES;
+#elif defined(GLX)
+	getProgramBinary = (GAE_GetProgramBinary_t)glXGetProcAddressARB((const GLubyte*)"glGetProgramBinary");
+	programBinary = (GAE_ProgramBinary_t)glXGetProcAddressARB((const GLubyte*)"glProgramBinary");
+#elif defined(GLES2)
+	getProgramBinary = (GAE_GetProgramBinary_t)eglGetProcAddress("glGetProgramBinaryOES");
+	programBinary = (GAE_ProgramBinary_t)eglGetProcAddress("glProgramBinaryOES");
+#endif
+
+	return ((0 != getProgramBinary) && (0 != programBinary)) ? GAE_TRUE : GAE_FALSE;
+}
+
+unsigned long long hashBytes(unsigned long long hash, const void* data, const unsigned long size) {
+	const GAE_BYTE* bytes = (const GAE_BYTE*)data;
+	unsigned long index = 0U;
+
+	for (index = 0U; index < size; ++index) {
+		hash ^= bytes[index];
+		hash *= FNV_PRIME;
+	}
+
+	return hash;
+}
+
+unsigned long long getKey(GAE_ShaderCache_t* const cache, const char* vertex, const unsigned long vertexSize, const char* fragment, const unsigned long fragmentSize) {
+	unsigned long long key = cache->driverKey;
+
+	/* the sizes keep "ab" + "c" apart from "a" + "bc" */
+	key = hashBytes(key, &vertexSize, sizeof(vertexSize));
+	key = hashBytes(key, vertex, vertexSize);
+	key = hashBytes(key, &fragmentSize, sizeof(fragmentSize));
+	return hashBytes(key, fragment, fragmentSize);
+}
+
+void getPath(GAE_ShaderCache_t* const cache, const unsigned long long key, const char* extension, char* path, const unsigned int pathSize) {
+	snprintf(path, pathSize, "%s/%08x%08x.%s", cache->directory, (unsigned int)(key >> 32U), (unsigned int)(key & 0xFFFFFFFFU), extension);
+}
+
+GAE_BYTE* readEntry(const char* path, unsigned long* size) {
+	FILE* file = fopen(path, "rb");
+	GAE_BYTE* entry = 0;
+	long fileSize = 0;
+
+	/* the cache lives somewhere writable, which on Android GAE_File's asset manager can't reach - so plain stdio */
+	if (0 == file)
+		return 0;
+
+	fseek(file, 0, SEEK_END);
+	fileSize = ftell(file);
+	rewind(file);
+
+	if (0 < fileSize) {
+		entry = malloc((unsigned long)fileSize);
+		if ((unsigned long)fileSize != fread(entry, 1U, (unsigned long)fileSize, file)) {
+			free(entry);
+			entry = 0;
+		}
+	}
+
+	fclose(file);
+	*size = (0 != entry) ? (unsigned long)fileSize : 0U;
+	return entry;
+}
+
+unsigned int readUint32(const GAE_BYTE* data) {
+	unsigned int value = 0U;
+	memcpy(&value, data, sizeof(value));
+	return value;
+}
+
+void writeUint32(GAE_BYTE* data, const unsigned int value) {
+	memcpy(data, &value, sizeof(value));
+}
+
+unsigned long writeTable(GAE_BYTE* data, struct GAE_Map_s* map) {
+	const GAE_HashString_t* ids = (const GAE_HashString_t*)GAE_Map_ids(map);
+	const GLint* locations = (const GLint*)GAE_Map_begin(map);
+	const unsigned int count = GAE_Map_length(map);
+	unsigned int index = 0U;
+
+	for (index = 0U; index < count; ++index) {
+		writeUint32(data + index * 8U, ids[index]);
+		writeUint32(data + index * 8U + 4U, (unsigned int)locations[index]);
+	}
+
+	return count * 8U;
+}
+
+void readTable(const GAE_BYTE* data, const unsigned int count, struct GAE_Map_s* map) {
+	GAE_HashString_t id = 0U;
+	GLint location = 0;
+	unsigned int index = 0U;
+
+	if (0U < count)
+		GAE_Map_reserve(map, count);
+	for (index = 0U; index < count; ++index) {
+		id = readUint32(data + index * 8U);
+		location = (GLint)readUint32(data + index * 8U + 4U);
+		GAE_Map_push(map, &id, &location);
+	}
+}
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef _SHADER_CACHE_H_
+#define _SHADER_CACHE_H_
+
+#include "../GAE_Types.h"
+
+/*
+	On-disk cache of linked program binaries, so a warm start skips compiling, linking and introspecting shaders.
+	Entries are keyed by a hash of both sources and the GL vendor, renderer and version strings, so a driver update just misses,
+	and a binary the driver still rejects is deleted and compiled from source again.
+	Needs GL_OES_get_program_binary or GL_ARB_get_program_binary - without either every lookup misses.
+	Entries are native endian, as the binary is only good for this device anyway:
+	 0 - "GPRG"          16 - binary format
+	 4 - version         20 - binary size
+	 8 - key             24 - attribute count
+	                     28 - uniform count
+	followed by a hash/location pair per attribute then per uniform, then the binary.
+*/
+
+#define GAE_SHADER_CACHE_VERSION 1U
+#define GAE_SHADER_CACHE_HEADER_SIZE 32U
+
+struct GAE_Shader_s;
+
+typedef struct GAE_ShaderCache_s {
+	char directory[1024];
+	unsigned long long driverKey;	/* hash of the driver strings, every entry key starts from it */
+	GAE_BOOL isSupported;
+	unsigned int binaryFormat;		/* the first format the driver offers */
+	unsigned int hits;
+	unsigned int misses;
+	unsigned int rejects;			/* entries found but refused by the driver */
+	unsigned int stores;
+} GAE_ShaderCache_t;
+
+/* Creates a cache keeping its entries in directory, which must exist and be writable. Needs a current GL context. */
+GAE_ShaderCache_t* GAE_ShaderCache_create(const char* directory);
+
+/* Creates and links shader->program from a cached binary and fills its tables. Returns GAE_FALSE, with the program untouched, on a miss. */
+GAE_BOOL GAE_ShaderCache_load(GAE_ShaderCache_t* cache, struct GAE_Shader_s* shader, const char* vertex, const unsigned long vertexSize, const char* fragment, const unsigned long fragmentSize);
+
+/* Stores a linked shader's binary and tables for the next run. */
+GAE_BOOL GAE_ShaderCache_store(GAE_ShaderCache_t* cache, struct GAE_Shader_s* const shader, const char* vertex, const unsigned long vertexSize, const char* fragment, const unsigned long fragmentSize);
+
+/* Deletes the cache - entries already stored stay on disk. */
+void GAE_ShaderCache_delete(GAE_ShaderCache_t* cache);
+
+#endif
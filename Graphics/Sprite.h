@@ -3,7 +3,7 @@
 
 #if defined(SDL2)
 #include "Sprite/SDL2/Sprite.h"
-#elif defined(GLX)
+#elif defined(GLX) || defined(MOCKGL)
 #include "Sprite/3D/Sprite.h"
 #endif
 
@@ -1,9 +1,11 @@
 #include "GLES2State.h"
 
 #include "../../Camera.h"
+#include "../../IndexBuffer.h"
 #include "../../Shader.h"
 #include "../../Material.h"
 #include "../../Texture.h"
+#include "../../VertexBuffer.h"
 #include "../../../Maths/Matrix.h"
 #include "../../../GAE_Types.h"
 #include "../../../Utils/Array.h"
@@ -11,6 +13,7 @@
 #include "../../../Utils/HashString.h"
 
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 
 static GAE_HashString_t aPositionHS = 0;
@@ -22,7 +25,10 @@ static GAE_HashString_t aCustom0HS = 0;
 static GAE_HashString_t aCustom1HS = 0;
 static GAE_HashString_t aCustom2HS = 0;
 
-void resetAttributes(GAE_RenderState_GLES2_t* state);
+static void resetAttributes(GAE_RenderState_t* state);
+static GAE_BOOL isRedundant(GAE_RenderState_GLES2_t* platform, const GAE_RenderState_Stat stat, const GAE_BOOL isSame);
+static void setCapability(GAE_RenderState_GLES2_t* platform, unsigned int* shadow, const GLenum capability, const GAE_BOOL isEnabled);
+static unsigned int getBufferChanges(void);
 
 GAE_RenderState_t* GAE_RenderState_create(void) {
 	GAE_RenderState_GLES2_t* state = malloc(sizeof(GAE_RenderState_GLES2_t));
@@ -60,12 +66,13 @@ GAE_RenderState_t* GAE_RenderState_create(void) {
 	state->a_custom1 = GL_INVALID_VALUE;
 	state->a_custom2 = GL_INVALID_VALUE;
 
-	state->lastTexture = 0;
-	state->lastTextureUnit = GL_INVALID_VALUE;
+	state->placeholderTexture = 0;
 
 	state->uniformUpdaters = GAE_Map_create(sizeof(GAE_HashString_t), sizeof(GAE_Shader_UniformUpdater_t), GAE_HashString_compare);
+	memset(&state->stats, 0, sizeof(GAE_RenderState_Stats_t));
 
 	parent->platform = (void*)state;
+	GAE_RenderState_invalidate(parent);
 
 	return parent;
 }
@@ -80,45 +87,266 @@ void GAE_RenderState_delete(GAE_RenderState_t* state) {
 }
 
 GAE_RenderState_t* GAE_RenderState_setTexturingEnabled(GAE_RenderState_t* state, const GAE_BOOL isEnabled) {
-	if (GAE_TRUE == isEnabled) {
-		if (GAE_FALSE == state->isTexturingEnabled) {
-			glEnable(GL_TEXTURE_2D);
-			state->isTexturingEnabled = GAE_TRUE;
-		}
-	} else {
-		if (GAE_TRUE == state->isTexturingEnabled) {
-			glDisable(GL_TEXTURE_2D);
-			state->isTexturingEnabled = GAE_FALSE;
-		}
-	}
-
+	GAE_RenderState_GLES2_t* platform = (GAE_RenderState_GLES2_t*)state->platform;
+	setCapability(platform, &platform->isTexturingEnabled, GL_TEXTURE_2D, isEnabled);
+	state->isTexturingEnabled = isEnabled;
 	return state;
 }
 
 GAE_RenderState_t* GAE_RenderState_setAlphaBlendingEnabled(GAE_RenderState_t* state, const GAE_BOOL isEnabled) {
-	if (GAE_TRUE == isEnabled) {
-		if (GAE_FALSE == state->isAlphaBlendingEnabled) {
-			glEnable(GL_BLEND);
-			state->isAlphaBlendingEnabled = GAE_TRUE;
-		}
-	} else {
-		if (GAE_TRUE == state->isAlphaBlendingEnabled) {
-			glDisable(GL_BLEND);
-			state->isAlphaBlendingEnabled = GAE_FALSE;
-		}
-	}
+	GAE_RenderState_GLES2_t* platform = (GAE_RenderState_GLES2_t*)state->platform;
+	setCapability(platform, &platform->isBlendingEnabled, GL_BLEND, isEnabled);
+	state->isAlphaBlendingEnabled = isEnabled;
+	return state;
+}
 
+GAE_RenderState_t* GAE_RenderState_setDepthTestEnabled(GAE_RenderState_t* state, const GAE_BOOL isEnabled) {
+	GAE_RenderState_GLES2_t* platform = (GAE_RenderState_GLES2_t*)state->platform;
+	setCapability(platform, &platform->isDepthTestEnabled, GL_DEPTH_TEST, isEnabled);
+	return state;
+}
+
+GAE_RenderState_t* GAE_RenderState_setCullingEnabled(GAE_RenderState_t* state, const GAE_BOOL isEnabled) {
+	GAE_RenderState_GLES2_t* platform = (GAE_RenderState_GLES2_t*)state->platform;
+	setCapability(platform, &platform->isCullingEnabled, GL_CULL_FACE, isEnabled);
+	return state;
+}
+
+GAE_RenderState_t* GAE_RenderState_setScissorEnabled(GAE_RenderState_t* state, const GAE_BOOL isEnabled) {
+	GAE_RenderState_GLES2_t* platform = (GAE_RenderState_GLES2_t*)state->platform;
+	setCapability(platform, &platform->isScissorEnabled, GL_SCISSOR_TEST, isEnabled);
 	return state;
 }
 
 GAE_RenderState_t* GAE_RenderState_setBlendingFunction(GAE_RenderState_t* state, const GLenum source, const GLenum destination) {
+	GAE_RenderState_GLES2_t* platform = (GAE_RenderState_GLES2_t*)state->platform;
+	GLenum* const function = platform->blendFunction;
+
+	if (GAE_TRUE == isRedundant(platform, GAE_RENDERSTATE_STAT_BLEND_FUNCTION
+		, (source == function[0]) && (destination == function[1]) && (source == function[2]) && (destination == function[3])))
+		return state;
+
 	glBlendFunc(source, destination);
+	function[0] = source;
+	function[1] = destination;
+	function[2] = source;
+	function[3] = destination;
 	return state;
 }
 
 GAE_RenderState_t* GAE_RenderState_setFullBlendingFunction(GAE_RenderState_t* state, const GLenum sourceRGB, const GLenum destinationRGB
 																					,const GLenum sourceAlpha, const GLenum destinationAlpha) {
+	GAE_RenderState_GLES2_t* platform = (GAE_RenderState_GLES2_t*)state->platform;
+	GLenum* const function = platform->blendFunction;
+
+	if (GAE_TRUE == isRedundant(platform, GAE_RENDERSTATE_STAT_BLEND_FUNCTION
+		, (sourceRGB == function[0]) && (destinationRGB == function[1]) && (sourceAlpha == function[2]) && (destinationAlpha == function[3])))
+		return state;
+
 	glBlendFuncSeparate(sourceRGB, destinationRGB, sourceAlpha, destinationAlpha);
+	function[0] = sourceRGB;
+	function[1] = destinationRGB;
+	function[2] = sourceAlpha;
+	function[3] = destinationAlpha;
+	return state;
+}
+
+GAE_RenderState_t* GAE_RenderState_setBlendingEquation(GAE_RenderState_t* state, const GLenum equation) {
+	GAE_RenderState_GLES2_t* platform = (GAE_RenderState_GLES2_t*)state->platform;
+	if (GAE_FALSE == isRedundant(platform, GAE_RENDERSTATE_STAT_BLEND_EQUATION, equation == platform->blendEquation)) {
+		glBlendEquation(equation);
+		platform->blendEquation = equation;
+	}
+
+	return state;
+}
+
+GAE_RenderState_t* GAE_RenderState_setDepthFunction(GAE_RenderState_t* state, const GLenum function) {
+	GAE_RenderState_GLES2_t* platform = (GAE_RenderState_GLES2_t*)state->platform;
+	if (GAE_FALSE == isRedundant(platform, GAE_RENDERSTATE_STAT_DEPTH, function == platform->depthFunction)) {
+		glDepthFunc(function);
+		platform->depthFunction = function;
+	}
+
+	return state;
+}
+
+GAE_RenderState_t* GAE_RenderState_setDepthWriteEnabled(GAE_RenderState_t* state, const GAE_BOOL isEnabled) {
+	GAE_RenderState_GLES2_t* platform = (GAE_RenderState_GLES2_t*)state->platform;
+	if (GAE_FALSE == isRedundant(platform, GAE_RENDERSTATE_STAT_DEPTH, (unsigned int)isEnabled == platform->isDepthWriteEnabled)) {
+		glDepthMask((GAE_TRUE == isEnabled) ? GL_TRUE : GL_FALSE);
+		platform->isDepthWriteEnabled = isEnabled;
+	}
+
+	return state;
+}
+
+GAE_RenderState_t* GAE_RenderState_setCullFace(GAE_RenderState_t* state, const GLenum face) {
+	GAE_RenderState_GLES2_t* platform = (GAE_RenderState_GLES2_t*)state->platform;
+	if (GAE_FALSE == isRedundant(platform, GAE_RENDERSTATE_STAT_CULL_FACE, face == platform->cullFace)) {
+		glCullFace(face);
+		platform->cullFace = face;
+	}
+
+	return state;
+}
+
+GAE_RenderState_t* GAE_RenderState_setViewport(GAE_RenderState_t* state, const GLint x, const GLint y, const GLsizei width, const GLsizei height) {
+	GAE_RenderState_GLES2_t* platform = (GAE_RenderState_GLES2_t*)state->platform;
+	GLint* const viewport = platform->viewport;
+
+	if (GAE_TRUE == isRedundant(platform, GAE_RENDERSTATE_STAT_VIEWPORT, (x == viewport[0]) && (y == viewport[1]) && (width == viewport[2]) && (height == viewport[3])))
+		return state;
+
+	glViewport(x, y, width, height);
+	viewport[0] = x;
+	viewport[1] = y;
+	viewport[2] = width;
+	viewport[3] = height;
+	return state;
+}
+
+GAE_RenderState_t* GAE_RenderState_setScissor(GAE_RenderState_t* state, const GLint x, const GLint y, const GLsizei width, const GLsizei height) {
+	GAE_RenderState_GLES2_t* platform = (GAE_RenderState_GLES2_t*)state->platform;
+	GLint* const scissor = platform->scissor;
+
+	if (GAE_TRUE == isRedundant(platform, GAE_RENDERSTATE_STAT_SCISSOR, (x == scissor[0]) && (y == scissor[1]) && (width == scissor[2]) && (height == scissor[3])))
+		return state;
+
+	glScissor(x, y, width, height);
+	scissor[0] = x;
+	scissor[1] = y;
+	scissor[2] = width;
+	scissor[3] = height;
+	return state;
+}
+
+GAE_RenderState_t* GAE_RenderState_setActiveTexture(GAE_RenderState_t* state, const unsigned int unit) {
+	GAE_RenderState_GLES2_t* platform = (GAE_RenderState_GLES2_t*)state->platform;
+	const GLenum activeTexture = GL_TEXTURE0 + unit;
+
+	if (GAE_FALSE == isRedundant(platform, GAE_RENDERSTATE_STAT_ACTIVE_TEXTURE, activeTexture == platform->activeTexture)) {
+		glActiveTexture(activeTexture);
+		platform->activeTexture = activeTexture;
+	}
+
+	return state;
+}
+
+GAE_RenderState_t* GAE_RenderState_bindTexture(GAE_RenderState_t* state, const unsigned int unit, const GLuint id) {
+	GAE_RenderState_GLES2_t* platform = (GAE_RenderState_GLES2_t*)state->platform;
+
+	assert(unit < GAE_RENDERSTATE_TEXTURE_UNITS);
+	/* a texture loaded or deleted since the last bind - a font page mid frame, or a reload - has left the shadow stale */
+	if (platform->textureChanges != GAE_GL_Texture_getUnshadowedChanges())
+		GAE_RenderState_invalidateTextures(state);
+
+	/* a unit that already holds the texture needs neither the bind nor the unit switch */
+	if (GAE_FALSE == isRedundant(platform, GAE_RENDERSTATE_STAT_TEXTURE, id == platform->boundTextures[unit])) {
+		GAE_RenderState_setActiveTexture(state, unit);
+		glBindTexture(GL_TEXTURE_2D, id);
+		platform->boundTextures[unit] = id;
+	}
+
+	return state;
+}
+
+GAE_RenderState_t* GAE_RenderState_bindFramebuffer(GAE_RenderState_t* state, const GLuint framebuffer) {
+	GAE_RenderState_GLES2_t* platform = (GAE_RenderState_GLES2_t*)state->platform;
+	if (GAE_FALSE == isRedundant(platform, GAE_RENDERSTATE_STAT_FRAMEBUFFER, framebuffer == platform->framebuffer)) {
+		glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+		platform->framebuffer = framebuffer;
+	}
+
+	return state;
+}
+
+GAE_RenderState_t* GAE_RenderState_bindRenderbuffer(GAE_RenderState_t* state, const GLuint renderbuffer) {
+	GAE_RenderState_GLES2_t* platform = (GAE_RenderState_GLES2_t*)state->platform;
+	if (GAE_FALSE == isRedundant(platform, GAE_RENDERSTATE_STAT_FRAMEBUFFER, renderbuffer == platform->renderbuffer)) {
+		glBindRenderbuffer(GL_RENDERBUFFER, renderbuffer);
+		platform->renderbuffer = renderbuffer;
+	}
+
+	return state;
+}
+
+GAE_RenderState_t* GAE_RenderState_bindBuffer(GAE_RenderState_t* state, const GLenum target, const GLuint buffer) {
+	GAE_RenderState_GLES2_t* platform = (GAE_RenderState_GLES2_t*)state->platform;
+	GLuint* const bound = (GL_ELEMENT_ARRAY_BUFFER == target) ? &platform->elementBuffer : &platform->arrayBuffer;
+
+	/* a buffer deleted since the last bind - a tilemap rebaked, particles or text let go of - may have its name handed out again */
+	if (platform->bufferChanges != getBufferChanges()) {
+		platform->arrayBuffer = GAE_RENDERSTATE_UNKNOWN;
+		platform->elementBuffer = GAE_RENDERSTATE_UNKNOWN;
+		platform->bufferChanges = getBufferChanges();
+	}
+
+	if (GAE_FALSE == isRedundant(platform, GAE_RENDERSTATE_STAT_BUFFER, buffer == *bound)) {
+		glBindBuffer(target, buffer);
+		*bound = buffer;
+	}
+
+	return state;
+}
+
+GAE_RenderState_t* GAE_RenderState_setAttributeEnabled(GAE_RenderState_t* state, const GLuint index, const GAE_BOOL isEnabled) {
+	GAE_RenderState_GLES2_t* platform = (GAE_RenderState_GLES2_t*)state->platform;
+	const unsigned int bit = 1U << index;
+	const unsigned int wanted = (GAE_TRUE == isEnabled) ? bit : 0U;
+
+	assert(index < GAE_RENDERSTATE_VERTEX_ATTRIBS);
+	if (GAE_TRUE == isRedundant(platform, GAE_RENDERSTATE_STAT_ATTRIBUTE, (0U != (platform->knownAttributes & bit)) && (wanted == (platform->enabledAttributes & bit))))
+		return state;
+
+	if (GAE_TRUE == isEnabled)
+		glEnableVertexAttribArray(index);
+	else
+		glDisableVertexAttribArray(index);
+	platform->enabledAttributes = (platform->enabledAttributes & ~bit) | wanted;
+	platform->knownAttributes |= bit;
+	return state;
+}
+
+GAE_RenderState_t* GAE_RenderState_invalidate(GAE_RenderState_t* state) {
+	GAE_RenderState_GLES2_t* platform = (GAE_RenderState_GLES2_t*)state->platform;
+	unsigned int index = 0U;
+
+	platform->isTexturingEnabled = GAE_RENDERSTATE_UNKNOWN;
+	platform->isBlendingEnabled = GAE_RENDERSTATE_UNKNOWN;
+	platform->isDepthTestEnabled = GAE_RENDERSTATE_UNKNOWN;
+	platform->isCullingEnabled = GAE_RENDERSTATE_UNKNOWN;
+	platform->isScissorEnabled = GAE_RENDERSTATE_UNKNOWN;
+	for (index = 0U; index < 4U; ++index)
+		platform->blendFunction[index] = GAE_RENDERSTATE_UNKNOWN;
+	platform->blendEquation = GAE_RENDERSTATE_UNKNOWN;
+	platform->depthFunction = GAE_RENDERSTATE_UNKNOWN;
+	platform->isDepthWriteEnabled = GAE_RENDERSTATE_UNKNOWN;
+	platform->cullFace = GAE_RENDERSTATE_UNKNOWN;
+	platform->viewport[2] = -1;
+	platform->scissor[2] = -1;
+	platform->activeTexture = GAE_RENDERSTATE_UNKNOWN;
+	platform->framebuffer = GAE_RENDERSTATE_UNKNOWN;
+	platform->renderbuffer = GAE_RENDERSTATE_UNKNOWN;
+	platform->program = GAE_RENDERSTATE_UNKNOWN;
+	platform->arrayBuffer = GAE_RENDERSTATE_UNKNOWN;
+	platform->elementBuffer = GAE_RENDERSTATE_UNKNOWN;
+	platform->bufferChanges = getBufferChanges();
+	platform->enabledAttributes = 0U;
+	platform->knownAttributes = 0U;
+	platform->currentShader = 0;
+
+	return GAE_RenderState_invalidateTextures(state);
+}
+
+GAE_RenderState_Stats_t* GAE_RenderState_getStats(GAE_RenderState_t* state) {
+	GAE_RenderState_GLES2_t* platform = (GAE_RenderState_GLES2_t*)state->platform;
+	return &platform->stats;
+}
+
+GAE_RenderState_t* GAE_RenderState_resetStats(GAE_RenderState_t* state) {
+	GAE_RenderState_GLES2_t* platform = (GAE_RenderState_GLES2_t*)state->platform;
+	memset(&platform->stats, 0, sizeof(GAE_RenderState_Stats_t));
 	return state;
 }
 
@@ -131,57 +359,42 @@ GAE_RenderState_t* GAE_RenderState_addUniformUpdater(GAE_RenderState_t* state, c
 GAE_RenderState_t* GAE_RenderState_bindShader(GAE_RenderState_t* state, GAE_Shader_t* const shader) {
 	GAE_RenderState_GLES2_t* platform = (GAE_RenderState_GLES2_t*)state->platform;
 	assert(0 != shader);
-	if (platform->currentShader != shader) {
+	/* a reloaded shader keeps its pointer but not its program, or where its attributes are */
+	if (GAE_FALSE == isRedundant(platform, GAE_RENDERSTATE_STAT_PROGRAM, (platform->currentShader == shader) && (platform->program == shader->program))) {
 		platform->currentShader = shader;
-		glUseProgram(shader->program);
-		resetAttributes(platform);
-/*		
-//		const std::vector<std::pair<HashString, GLint> >& attributes(shader->getAttributeArray());
-//		for (std::vector<std::pair<HashString, GLint> >::const_iterator itr(attributes.begin()); itr < attributes.end(); ++itr)
-//			glEnableVertexAttribArray(itr->second);
-*/
+		/* different shaders can share a program, which still needs its attributes looking up */
+		if (shader->program != platform->program) {
+			glUseProgram(shader->program);
+			platform->program = shader->program;
+		}
+		resetAttributes(state);
 	}
 
 	return state;
 }
 
-void resetAttributes(GAE_RenderState_GLES2_t* state) {
-	state->a_position = GL_INVALID_VALUE;
-	state->a_colour = GL_INVALID_VALUE;
-	state->a_normal = GL_INVALID_VALUE;
-	state->a_texCoord0 = GL_INVALID_VALUE;
-	state->a_texCoord1 = GL_INVALID_VALUE;
-	state->a_custom0 = GL_INVALID_VALUE;
-	state->a_custom1 = GL_INVALID_VALUE;
-	state->a_custom2 = GL_INVALID_VALUE;
+void resetAttributes(GAE_RenderState_t* state) {
+	GAE_RenderState_GLES2_t* platform = (GAE_RenderState_GLES2_t*)state->platform;
+	GLuint* const locations[8] = { &platform->a_position, &platform->a_colour, &platform->a_normal, &platform->a_texCoord0
+								, &platform->a_texCoord1, &platform->a_custom0, &platform->a_custom1, &platform->a_custom2 };
+	const GAE_HashString_t names[8] = { aPositionHS, aColourHS, aNormalHS, aTexCoord0HS, aTexCoord1HS, aCustom0HS, aCustom1HS, aCustom2HS };
+	unsigned int used = 0U;
+	unsigned int index = 0U;
 
-	if (0 != state->currentShader) {
-		state->a_position = GAE_Shader_getAttribute(state->currentShader, aPositionHS);
-		state->a_colour = GAE_Shader_getAttribute(state->currentShader, aColourHS);
-		state->a_normal = GAE_Shader_getAttribute(state->currentShader, aNormalHS);
-		state->a_texCoord0 = GAE_Shader_getAttribute(state->currentShader, aTexCoord0HS);
-		state->a_texCoord1 = GAE_Shader_getAttribute(state->currentShader, aTexCoord1HS);
-		state->a_custom0 = GAE_Shader_getAttribute(state->currentShader, aCustom0HS);
-		state->a_custom1 = GAE_Shader_getAttribute(state->currentShader, aCustom1HS);
-		state->a_custom2 = GAE_Shader_getAttribute(state->currentShader, aCustom2HS);
+	for (index = 0U; index < 8U; ++index) {
+		*locations[index] = (0 != platform->currentShader) ? (GLuint)GAE_Shader_getAttribute(platform->currentShader, names[index]) : GL_INVALID_VALUE;
+		if (*locations[index] < GAE_RENDERSTATE_VERTEX_ATTRIBS)
+			used |= 1U << *locations[index];
 	}
 
-	if (GL_INVALID_VALUE != state->a_position)
-		glEnableVertexAttribArray(state->a_position);
-	if (GL_INVALID_VALUE != state->a_colour)
-		glEnableVertexAttribArray(state->a_colour);
-	if (GL_INVALID_VALUE != state->a_normal)
-		glEnableVertexAttribArray(state->a_normal);
-	if (GL_INVALID_VALUE != state->a_texCoord0)
-		glEnableVertexAttribArray(state->a_texCoord0);
-	if (GL_INVALID_VALUE != state->a_texCoord1)
-		glEnableVertexAttribArray(state->a_texCoord1);
-	if (GL_INVALID_VALUE != state->a_custom0)
-		glEnableVertexAttribArray(state->a_custom0);
-	if (GL_INVALID_VALUE != state->a_custom1)
-		glEnableVertexAttribArray(state->a_custom1);
-	if (GL_INVALID_VALUE != state->a_custom2)
-		glEnableVertexAttribArray(state->a_custom2);
+	/* attributes left enabled from the last shader would be read past the end of buffers that don't have them */
+	for (index = 0U; index < GAE_RENDERSTATE_VERTEX_ATTRIBS; ++index) {
+		const unsigned int bit = 1U << index;
+		if (0U != (used & bit))
+			GAE_RenderState_setAttributeEnabled(state, index, GAE_TRUE);
+		else if (0U != (platform->enabledAttributes & platform->knownAttributes & bit))
+			GAE_RenderState_setAttributeEnabled(state, index, GAE_FALSE);
+	}
 }
 
 GAE_RenderState_t* GAE_RenderState_updateUniforms(GAE_RenderState_t* state, GAE_Material_t* const material, GAE_Matrix4_t* const transform) {
@@ -207,23 +420,57 @@ GAE_RenderState_t* GAE_RenderState_updateTextures(GAE_RenderState_t* state, GAE_
 	const unsigned int textureCount = GAE_Array_length(material->textures);
 	GAE_RenderState_GLES2_t* platform = (GAE_RenderState_GLES2_t*)state->platform;
 	unsigned int index = 0U;
-	GLenum currentUnit = GL_INVALID_VALUE;
 	GAE_Texture_t* texture;
 
+	assert(textureCount <= GAE_RENDERSTATE_TEXTURE_UNITS);
 	for (index = 0U; index < textureCount; ++index) {
-		currentUnit = GL_TEXTURE0 + index;
-		if (currentUnit != platform->lastTextureUnit) {
-			glActiveTexture(currentUnit);
-			platform->lastTextureUnit = currentUnit;
-		}
-		
+		GAE_GL_Texture_t* glTexture;
 		texture = (GAE_Texture_t*)GAE_Array_get(material->textures, index);
-		if (texture != platform->lastTexture) {
-			GAE_GL_Texture_t* glTexture = (GAE_GL_Texture_t*)texture->platform;
-			platform->lastTexture = texture;
-			glBindTexture(GL_TEXTURE_2D, glTexture->id);
-		}
+		glTexture = (GAE_GL_Texture_t*)texture->platform;
+		/* a pending texture is stood in for until its upload lands - the real id differs, so it's bound as soon as it's ready */
+		if (GAE_TRUE == glTexture->isPending)
+			GAE_RenderState_bindTexture(state, index, (0 != platform->placeholderTexture) ? ((GAE_GL_Texture_t*)platform->placeholderTexture->platform)->id : 0U);
+		else
+			GAE_RenderState_bindTexture(state, index, glTexture->id);
 	}
 
 	return state;
 }
+
+GAE_RenderState_t* GAE_RenderState_setPlaceholderTexture(GAE_RenderState_t* state, GAE_Texture_t* const texture) {
+	GAE_RenderState_GLES2_t* platform = (GAE_RenderState_GLES2_t*)state->platform;
+	platform->placeholderTexture = texture;
+	return state;
+}
+
+GAE_RenderState_t* GAE_RenderState_invalidateTextures(GAE_RenderState_t* state) {
+	GAE_RenderState_GLES2_t* platform = (GAE_RenderState_GLES2_t*)state->platform;
+	unsigned int index = 0U;
+
+	for (index = 0U; index < GAE_RENDERSTATE_TEXTURE_UNITS; ++index)
+		platform->boundTextures[index] = GAE_RENDERSTATE_UNKNOWN;
+	platform->textureChanges = GAE_GL_Texture_getUnshadowedChanges();
+	return state;
+}
+
+GAE_BOOL isRedundant(GAE_RenderState_GLES2_t* platform, const GAE_RenderState_Stat stat, const GAE_BOOL isSame) {
+	++platform->stats.calls[stat];
+	if (GAE_TRUE == isSame)
+		++platform->stats.redundant[stat];
+	return isSame;
+}
+
+void setCapability(GAE_RenderState_GLES2_t* platform, unsigned int* shadow, const GLenum capability, const GAE_BOOL isEnabled) {
+	if (GAE_TRUE == isRedundant(platform, GAE_RENDERSTATE_STAT_ENABLE, (unsigned int)isEnabled == *shadow))
+		return;
+
+	if (GAE_TRUE == isEnabled)
+		glEnable(capability);
+	else
+		glDisable(capability);
+	*shadow = isEnabled;
+}
+
+unsigned int getBufferChanges(void) {
+	return GAE_VertexBuffer_getUnshadowedChanges() + GAE_IndexBuffer_getUnshadowedChanges();
+}
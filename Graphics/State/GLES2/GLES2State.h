@@ -1,7 +1,9 @@
 #ifndef _GLES2_STATE_H_
 #define _GLES2_STATE_H_
 
-#if defined(GLX)
+#if defined(MOCKGL)
+	#include "../../Context/Mock/MockGL.h"
+#elif defined(GLX)
 	#include "../../Context/GLX/GLee.h"
 #elif defined(PANDORA) || defined(ANDROID)
 	#if defined(GLES1)
@@ -19,6 +21,44 @@ struct GAE_Texture_s;
 struct GAE_Map_s;
 struct GAE_Material_s;
 
+/*
+	Every piece of GL state the engine touches is shadowed here, and each setter compares against the shadow before calling GL,
+	so redundant binds and switches never reach the driver.
+	Nothing is assumed about GL on creation - each value is unknown until first set, so the first set always goes through.
+	Anything that changes this state behind the shadow's back - deleting framebuffers or renderbuffers, third party code -
+	must call GAE_RenderState_invalidate or GAE_RenderState_invalidateTextures afterwards.
+	Texture loads, reloads and deletes, and vertex and index buffer deletes, are the exception - they're counted,
+	and the texture or buffer shadow drops itself on the next bind after one. Shader reloads need nothing either,
+	as the program a shader holds is shadowed rather than the shader.
+*/
+
+#define GAE_RENDERSTATE_TEXTURE_UNITS 8U
+#define GAE_RENDERSTATE_VERTEX_ATTRIBS 16U
+#define GAE_RENDERSTATE_UNKNOWN 0xFFFFFFFFU
+
+/* Setter groups counted for profiling */
+typedef enum GAE_RenderState_Stat_e {
+	GAE_RENDERSTATE_STAT_ENABLE			/* texturing, blending, depth test, culling and scissor test switches */
+,	GAE_RENDERSTATE_STAT_BLEND_FUNCTION
+,	GAE_RENDERSTATE_STAT_BLEND_EQUATION
+,	GAE_RENDERSTATE_STAT_DEPTH
+,	GAE_RENDERSTATE_STAT_CULL_FACE
+,	GAE_RENDERSTATE_STAT_VIEWPORT
+,	GAE_RENDERSTATE_STAT_SCISSOR
+,	GAE_RENDERSTATE_STAT_ACTIVE_TEXTURE
+,	GAE_RENDERSTATE_STAT_TEXTURE
+,	GAE_RENDERSTATE_STAT_FRAMEBUFFER
+,	GAE_RENDERSTATE_STAT_PROGRAM
+,	GAE_RENDERSTATE_STAT_BUFFER
+,	GAE_RENDERSTATE_STAT_ATTRIBUTE
+,	GAE_RENDERSTATE_STAT_COUNT
+} GAE_RenderState_Stat;
+
+typedef struct GAE_RenderState_Stats_s {
+	unsigned int calls[GAE_RENDERSTATE_STAT_COUNT];
+	unsigned int redundant[GAE_RENDERSTATE_STAT_COUNT];	/* calls that matched the shadow, and never reached GL */
+} GAE_RenderState_Stats_t;
+
 typedef struct GAE_RenderState_GLES2_s {
 	GAE_Matrix4_t* textureMatrix;
 	GAE_Shader_t* currentShader;
@@ -32,10 +72,36 @@ typedef struct GAE_RenderState_GLES2_s {
 	GLuint a_custom1;
 	GLuint a_custom2;
 
-	struct GAE_Texture_s* lastTexture;
-	GLenum lastTextureUnit;
+	struct GAE_Texture_s* placeholderTexture;
 
 	struct GAE_Map_s* uniformUpdaters;
+
+	/* the shadow - switches are GAE_TRUE, GAE_FALSE or GAE_RENDERSTATE_UNKNOWN */
+	unsigned int isTexturingEnabled;
+	unsigned int isBlendingEnabled;
+	unsigned int isDepthTestEnabled;
+	unsigned int isCullingEnabled;
+	unsigned int isScissorEnabled;
+	GLenum blendFunction[4];			/* 0 - src RGB, 1 - dst RGB, 2 - src Alpha, 3 - dst Alpha */
+	GLenum blendEquation;
+	GLenum depthFunction;
+	unsigned int isDepthWriteEnabled;
+	GLenum cullFace;
+	GLint viewport[4];					/* a negative width while unknown */
+	GLint scissor[4];
+	GLenum activeTexture;
+	GLuint boundTextures[GAE_RENDERSTATE_TEXTURE_UNITS];
+	unsigned int textureChanges;		/* GAE_GL_Texture_getUnshadowedChanges when boundTextures was last known good */
+	GLuint framebuffer;
+	GLuint renderbuffer;
+	GLuint program;
+	GLuint arrayBuffer;
+	GLuint elementBuffer;
+	unsigned int bufferChanges;			/* vertex and index buffer deletes counted when the buffers were last known good */
+	unsigned int enabledAttributes;		/* one bit per attribute index */
+	unsigned int knownAttributes;		/* which bits of enabledAttributes are known */
+
+	GAE_RenderState_Stats_t stats;
 } GAE_RenderState_GLES2_t;
 
 GAE_RenderState_t* GAE_RenderState_create(void);
@@ -48,6 +114,62 @@ GAE_RenderState_t* GAE_RenderState_setFullBlendingFunction(GAE_RenderState_t* st
 GAE_RenderState_t* GAE_RenderState_addUniformUpdater(GAE_RenderState_t* state, const GAE_HashString_t uniformName, GAE_Shader_UniformUpdater_t updater);
 GAE_RenderState_t* GAE_RenderState_updateUniforms(GAE_RenderState_t* state, struct GAE_Material_s* const material, GAE_Matrix4_t* const transform);
 GAE_RenderState_t* GAE_RenderState_updateTextures(GAE_RenderState_t* state, struct GAE_Material_s* const material);
+GAE_RenderState_t* GAE_RenderState_setPlaceholderTexture(GAE_RenderState_t* state, struct GAE_Texture_s* const texture);
+GAE_RenderState_t* GAE_RenderState_invalidateTextures(GAE_RenderState_t* state);
 GAE_RenderState_t* GAE_RenderState_bindShader(GAE_RenderState_t* state, GAE_Shader_t* const shader);
 
+/* Enables or disables depth testing. */
+GAE_RenderState_t* GAE_RenderState_setDepthTestEnabled(GAE_RenderState_t* state, const GAE_BOOL isEnabled);
+
+/* Enables or disables back face culling. */
+GAE_RenderState_t* GAE_RenderState_setCullingEnabled(GAE_RenderState_t* state, const GAE_BOOL isEnabled);
+
+/* Enables or disables the scissor test. */
+GAE_RenderState_t* GAE_RenderState_setScissorEnabled(GAE_RenderState_t* state, const GAE_BOOL isEnabled);
+
+/* Sets the blend equation - GL_FUNC_ADD, GL_FUNC_SUBTRACT or GL_FUNC_REVERSE_SUBTRACT. */
+GAE_RenderState_t* GAE_RenderState_setBlendingEquation(GAE_RenderState_t* state, const GLenum equation);
+
+/* Sets the depth comparison function. */
+GAE_RenderState_t* GAE_RenderState_setDepthFunction(GAE_RenderState_t* state, const GLenum function);
+
+/* Enables or disables depth writes. */
+GAE_RenderState_t* GAE_RenderState_setDepthWriteEnabled(GAE_RenderState_t* state, const GAE_BOOL isEnabled);
+
+/* Sets which faces are culled when culling is enabled. */
+GAE_RenderState_t* GAE_RenderState_setCullFace(GAE_RenderState_t* state, const GLenum face);
+
+/* Sets the viewport rectangle. */
+GAE_RenderState_t* GAE_RenderState_setViewport(GAE_RenderState_t* state, const GLint x, const GLint y, const GLsizei width, const GLsizei height);
+
+/* Sets the scissor rectangle. */
+GAE_RenderState_t* GAE_RenderState_setScissor(GAE_RenderState_t* state, const GLint x, const GLint y, const GLsizei width, const GLsizei height);
+
+/* Makes unit the active texture unit. */
+GAE_RenderState_t* GAE_RenderState_setActiveTexture(GAE_RenderState_t* state, const unsigned int unit);
+
+/* Binds the GL texture id to unit, only switching the active unit if the binding changes. */
+GAE_RenderState_t* GAE_RenderState_bindTexture(GAE_RenderState_t* state, const unsigned int unit, const GLuint id);
+
+/* Binds a framebuffer - 0 is the screen. */
+GAE_RenderState_t* GAE_RenderState_bindFramebuffer(GAE_RenderState_t* state, const GLuint framebuffer);
+
+/* Binds a renderbuffer. */
+GAE_RenderState_t* GAE_RenderState_bindRenderbuffer(GAE_RenderState_t* state, const GLuint renderbuffer);
+
+/* Binds a buffer to GL_ARRAY_BUFFER or GL_ELEMENT_ARRAY_BUFFER. */
+GAE_RenderState_t* GAE_RenderState_bindBuffer(GAE_RenderState_t* state, const GLenum target, const GLuint buffer);
+
+/* Enables or disables a vertex attribute array. */
+GAE_RenderState_t* GAE_RenderState_setAttributeEnabled(GAE_RenderState_t* state, const GLuint index, const GAE_BOOL isEnabled);
+
+/* Forgets the whole shadow, so every next set reaches GL. */
+GAE_RenderState_t* GAE_RenderState_invalidate(GAE_RenderState_t* state);
+
+/* Returns the setter counts since creation or the last reset. This should NOT be freed. */
+GAE_RenderState_Stats_t* GAE_RenderState_getStats(GAE_RenderState_t* state);
+
+/* Starts the setter counts over. */
+GAE_RenderState_t* GAE_RenderState_resetStats(GAE_RenderState_t* state);
+
 #endif
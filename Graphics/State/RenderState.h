@@ -12,7 +12,7 @@ typedef struct GAE_RenderState_s {
 	void* platform;
 } GAE_RenderState_t;
 
-#if defined(GLX)
+#if defined(GLX) || defined(MOCKGL)
 #include "GLES2/GLES2State.h"
 #elif defined(ANDROID)
 #include "GLES2/GLES2State.h"
@@ -3,13 +3,15 @@
 
 #include "../RenderTarget.h"
 
+struct GAE_RenderState_s;
+
 typedef struct GAE_RenderTarget_Buffer_s {
 	GAE_RenderTarget_t parent;
 } GAE_RenderTarget_Buffer_t;
 
 GAE_RenderTarget_Buffer_t* GAE_RenderTarget_Buffer_create(const GAE_RenderTarget_Type type, const GAE_RenderTarget_Options options);
-GAE_RenderTarget_Buffer_t* GAE_RenderTarget_Buffer_bind(GAE_RenderTarget_Buffer_t* target);
-GAE_RenderTarget_Buffer_t* GAE_RenderTarget_Buffer_unbind(GAE_RenderTarget_Buffer_t* target);
+GAE_RenderTarget_Buffer_t* GAE_RenderTarget_Buffer_bind(GAE_RenderTarget_Buffer_t* target, struct GAE_RenderState_s* state);
+GAE_RenderTarget_Buffer_t* GAE_RenderTarget_Buffer_unbind(GAE_RenderTarget_Buffer_t* target, struct GAE_RenderState_s* state);
 void GAE_RenderTarget_Buffer_delete(GAE_RenderTarget_Buffer_t* target);
 
 #endif
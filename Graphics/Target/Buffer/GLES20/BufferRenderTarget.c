@@ -6,11 +6,11 @@ GAE_RenderTarget_Buffer_t* GAE_RenderTarget_Buffer_create(const GAE_RenderTarget
 	return 0;
 }
 
-GAE_RenderTarget_Buffer_t* GAE_RenderTarget_Buffer_bind(GAE_RenderTarget_Screen_t* target) {
+GAE_RenderTarget_Buffer_t* GAE_RenderTarget_Buffer_bind(GAE_RenderTarget_Screen_t* target, struct GAE_RenderState_s* state) {
 	return target;
 }
 
-GAE_RenderTarget_Buffer_t* GAE_RenderTarget_Buffer_unbind(GAE_RenderTarget_Screen_t* target) {
+GAE_RenderTarget_Buffer_t* GAE_RenderTarget_Buffer_unbind(GAE_RenderTarget_Screen_t* target, struct GAE_RenderState_s* state) {
 	return target;
 }
 
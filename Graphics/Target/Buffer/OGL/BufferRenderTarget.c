@@ -1,6 +1,8 @@
 #include "../BufferRenderTarget.h"
 
-#if defined(GLX)
+#if defined(MOCKGL)
+#include "../../../Context/Mock/MockGL.h"
+#elif defined(GLX)
 #include "../../../Context/GLX/GLee.h"
 #endif
 
@@ -13,11 +15,13 @@ GAE_RenderTarget_Buffer_t* GAE_RenderTarget_Buffer_create(const GAE_RenderTarget
 	return 0;
 }
 
-GAE_RenderTarget_Buffer_t* GAE_RenderTarget_Buffer_bind(GAE_RenderTarget_Buffer_t* target) {
+GAE_RenderTarget_Buffer_t* GAE_RenderTarget_Buffer_bind(GAE_RenderTarget_Buffer_t* target, struct GAE_RenderState_s* state) {
+	GAE_UNUSED(state);
 	return target;
 }
 
-GAE_RenderTarget_Buffer_t* GAE_RenderTarget_Buffer_unbind(GAE_RenderTarget_Buffer_t* target) {
+GAE_RenderTarget_Buffer_t* GAE_RenderTarget_Buffer_unbind(GAE_RenderTarget_Buffer_t* target, struct GAE_RenderState_s* state) {
+	GAE_UNUSED(state);
 	return target;
 }
 
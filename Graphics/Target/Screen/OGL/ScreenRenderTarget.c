@@ -1,9 +1,13 @@
 #include "../ScreenRenderTarget.h"
 
-#if defined(GLX)
+#if defined(MOCKGL)
+#include "../../../Context/Mock/MockGL.h"
+#elif defined(GLX)
 #include "../../../Context/GLX/GLee.h"
 #endif
 
+#include "../../../State/RenderState.h"
+#include "../../../../GAE_Types.h"
 #include <stdlib.h>
 
 GAE_RenderTarget_Screen_t* GAE_RenderTarget_Screen_create(const GAE_RenderTarget_Type type, const GAE_RenderTarget_Options options) {
@@ -14,14 +18,15 @@ GAE_RenderTarget_Screen_t* GAE_RenderTarget_Screen_create(const GAE_RenderTarget
 	return target;
 }
 
-GAE_RenderTarget_Screen_t* GAE_RenderTarget_Screen_bind(GAE_RenderTarget_Screen_t* target) {
-	glBindFramebuffer(GL_FRAMEBUFFER, 0); /* As per OpenGL Reference Manual, 0 is kept for the screen */
+GAE_RenderTarget_Screen_t* GAE_RenderTarget_Screen_bind(GAE_RenderTarget_Screen_t* target, struct GAE_RenderState_s* state) {
+	GAE_RenderState_bindFramebuffer(state, 0U); /* As per OpenGL Reference Manual, 0 is kept for the screen */
 
 	return target;
 }
 
-GAE_RenderTarget_Screen_t* GAE_RenderTarget_Screen_unbind(GAE_RenderTarget_Screen_t* target) {
-	glBindFramebuffer(GL_FRAMEBUFFER, GL_INVALID_VALUE); /* Unbinding the screen shouldn't crash, but should cause undefined behaviour */
+GAE_RenderTarget_Screen_t* GAE_RenderTarget_Screen_unbind(GAE_RenderTarget_Screen_t* target, struct GAE_RenderState_s* state) {
+	/* nothing to do - the screen is what every other target unbinds to */
+	GAE_UNUSED(state);
 
 	return target;
 }
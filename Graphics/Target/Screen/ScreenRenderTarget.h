@@ -3,13 +3,15 @@
 
 #include "../RenderTarget.h"
 
+struct GAE_RenderState_s;
+
 typedef struct GAE_RenderTarget_Screen_s {
 	GAE_RenderTarget_t parent;
 } GAE_RenderTarget_Screen_t;
 
 GAE_RenderTarget_Screen_t* GAE_RenderTarget_Screen_create(const GAE_RenderTarget_Type type, const GAE_RenderTarget_Options options);
-GAE_RenderTarget_Screen_t* GAE_RenderTarget_Screen_bind(GAE_RenderTarget_Screen_t* target);
-GAE_RenderTarget_Screen_t* GAE_RenderTarget_Screen_unbind(GAE_RenderTarget_Screen_t* target);
+GAE_RenderTarget_Screen_t* GAE_RenderTarget_Screen_bind(GAE_RenderTarget_Screen_t* target, struct GAE_RenderState_s* state);
+GAE_RenderTarget_Screen_t* GAE_RenderTarget_Screen_unbind(GAE_RenderTarget_Screen_t* target, struct GAE_RenderState_s* state);
 void GAE_RenderTarget_Screen_delete(GAE_RenderTarget_Screen_t* target);
 
 #endif
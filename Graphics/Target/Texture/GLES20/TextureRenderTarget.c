@@ -5,6 +5,8 @@
 	#include <GLES2/gl2.h>
 #endif
 
+#include "../../../State/RenderState.h"
+
 GAE_RenderTarget_Texture_t* GAE_RenderTarget_Texture_create(const GAE_RenderTarget_Type type, const GAE_RenderTarget_Options options) {
 	GAE_RenderTarget_Texture_t* target = malloc(sizeof(GAE_RenderTarget_Texture_t));
 	target->parent.type = type;
@@ -21,7 +23,7 @@ GAE_RenderTarget_Texture_t* GAE_RenderTarget_Texture_create(const GAE_RenderTarg
 	return target;
 }
 
-GAE_RenderTarget_Texture_t* GAE_RenderTarget_Texture_bind(GAE_RenderTarget_Texture_t* target) {
+GAE_RenderTarget_Texture_t* GAE_RenderTarget_Texture_bind(GAE_RenderTarget_Texture_t* target, struct GAE_RenderState_s* state) {
 	GAE_GL_Texture_t* texture = (GAE_GL_Texture_t*)target->texture;
 	if (0 == texture) {
 		/*Application::getInstance()->getLogger()->log("TextureRenderTarget: No Texture Bound\n", Logger::LOG_TYPE_ERROR);*/
@@ -29,12 +31,12 @@ GAE_RenderTarget_Texture_t* GAE_RenderTarget_Texture_bind(GAE_RenderTarget_Textu
 	}
 	
 	if (GL_INVALID_VALUE != target->fb) {
-		glBindFramebuffer(GL_FRAMEBUFFER, target->fb);
+		GAE_RenderState_bindFramebuffer(state, target->fb);
 		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture->id, 0);
 	}
 	
 	if (GL_INVALID_VALUE != target->rb) {
-		glBindRenderbuffer(GL_RENDERBUFFER, target->rb);
+		GAE_RenderState_bindRenderbuffer(state, target->rb);
 		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT16, target->texture->width, target->texture->height);
 		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, target->rb);
 	}
@@ -42,9 +44,9 @@ GAE_RenderTarget_Texture_t* GAE_RenderTarget_Texture_bind(GAE_RenderTarget_Textu
 	return target;
 }
 
-GAE_RenderTarget_Texture_t* GAE_RenderTarget_Texture_unbind(GAE_RenderTarget_Texture_t* target) {
-	glBindFramebuffer(GL_FRAMEBUFFER, GL_INVALID_VALUE);
-	glBindRenderbuffer(GL_RENDERBUFFER, GL_INVALID_VALUE);
+GAE_RenderTarget_Texture_t* GAE_RenderTarget_Texture_unbind(GAE_RenderTarget_Texture_t* target, struct GAE_RenderState_s* state) {
+	GAE_RenderState_bindFramebuffer(state, 0U);
+	GAE_RenderState_bindRenderbuffer(state, 0U);
 }
 
 void GAE_RenderTarget_Texture_delete(GAE_RenderTarget_Texture_t* target) {
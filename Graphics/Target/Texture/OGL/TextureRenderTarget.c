@@ -1,10 +1,13 @@
 #include "../TextureRenderTarget.h"
 
-#if defined(GLX)
+#if defined(MOCKGL)
+#include "../../../Context/Mock/MockGL.h"
+#elif defined(GLX)
 #include "../../../Context/GLX/GLee.h"
 #endif
 
 #include "../../../Texture.h"
+#include "../../../State/RenderState.h"
 #include <stdlib.h>
 
 GAE_RenderTarget_Texture_t* GAE_RenderTarget_Texture_create(const GAE_RenderTarget_Type type, const GAE_RenderTarget_Options options) {
@@ -23,7 +26,7 @@ GAE_RenderTarget_Texture_t* GAE_RenderTarget_Texture_create(const GAE_RenderTarg
 	return target;
 }
 
-GAE_RenderTarget_Texture_t* GAE_RenderTarget_Texture_bind(GAE_RenderTarget_Texture_t* target) {
+GAE_RenderTarget_Texture_t* GAE_RenderTarget_Texture_bind(GAE_RenderTarget_Texture_t* target, struct GAE_RenderState_s* state) {
 	GAE_GL_Texture_t* texture = (GAE_GL_Texture_t*)target->texture;
 
 	if (0 == texture) {
@@ -32,12 +35,12 @@ GAE_RenderTarget_Texture_t* GAE_RenderTarget_Texture_bind(GAE_RenderTarget_Textu
 	}
 	
 	if (GL_INVALID_VALUE != target->fb) {
-		glBindFramebuffer(GL_FRAMEBUFFER, target->fb);
+		GAE_RenderState_bindFramebuffer(state, target->fb);
 		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture->id, 0);
 	}
 	
 	if (GL_INVALID_VALUE != target->rb) {
-		glBindRenderbuffer(GL_RENDERBUFFER, target->rb);
+		GAE_RenderState_bindRenderbuffer(state, target->rb);
 		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT16, target->texture->width, target->texture->height);
 		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, target->rb);
 	}
@@ -45,9 +48,10 @@ GAE_RenderTarget_Texture_t* GAE_RenderTarget_Texture_bind(GAE_RenderTarget_Textu
 	return target;
 }
 
-GAE_RenderTarget_Texture_t* GAE_RenderTarget_Texture_unbind(GAE_RenderTarget_Texture_t* target) {
-	glBindFramebuffer(GL_FRAMEBUFFER, GL_INVALID_VALUE);
-	glBindRenderbuffer(GL_RENDERBUFFER, GL_INVALID_VALUE);
+GAE_RenderTarget_Texture_t* GAE_RenderTarget_Texture_unbind(GAE_RenderTarget_Texture_t* target, struct GAE_RenderState_s* state) {
+	/* back to the screen - GL_INVALID_VALUE was never a framebuffer name, so binding it only raised an error */
+	GAE_RenderState_bindFramebuffer(state, 0U);
+	GAE_RenderState_bindRenderbuffer(state, 0U);
 
 	return target;
 }
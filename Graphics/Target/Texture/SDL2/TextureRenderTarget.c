@@ -17,8 +17,9 @@ GAE_RenderTarget_Texture_t* GAE_RenderTarget_Texture_create(const GAE_RenderTarg
 	return target;
 }
 
-GAE_RenderTarget_Texture_t* GAE_RenderTarget_Texture_bind(GAE_RenderTarget_Texture_t* target) {
+GAE_RenderTarget_Texture_t* GAE_RenderTarget_Texture_bind(GAE_RenderTarget_Texture_t* target, struct GAE_RenderState_s* state) {
 	GAE_SDL2_Texture_t* texture = (GAE_SDL2_Texture_t*)target->texture;
+	GAE_UNUSED(state);
 
 	if (0 == texture) {
 		/*Application::getInstance()->getLogger()->log("TextureRenderTarget: No Texture Bound\n", Logger::LOG_TYPE_ERROR);*/
@@ -32,8 +33,9 @@ GAE_RenderTarget_Texture_t* GAE_RenderTarget_Texture_bind(GAE_RenderTarget_Textu
 	return target;
 }
 
-GAE_RenderTarget_Texture_t* GAE_RenderTarget_Texture_unbind(GAE_RenderTarget_Texture_t* target) {
+GAE_RenderTarget_Texture_t* GAE_RenderTarget_Texture_unbind(GAE_RenderTarget_Texture_t* target, struct GAE_RenderState_s* state) {
 	GAE_SDL2_Texture_t* texture = (GAE_SDL2_Texture_t*)target->texture;
+	GAE_UNUSED(state);
 	SDL_SetRenderTarget(texture->renderer, NULL);
 
 	return target;
@@ -3,6 +3,8 @@
 
 #include "../RenderTarget.h"
 
+struct GAE_RenderState_s;
+
 typedef struct GAE_RenderTarget_Texture_s {
 	GAE_RenderTarget_t parent;
 	struct GAE_Texture_s* texture;
@@ -11,8 +13,8 @@ typedef struct GAE_RenderTarget_Texture_s {
 } GAE_RenderTarget_Texture_t;
 
 GAE_RenderTarget_Texture_t* GAE_RenderTarget_Texture_create(const GAE_RenderTarget_Type type, const GAE_RenderTarget_Options options);
-GAE_RenderTarget_Texture_t* GAE_RenderTarget_Texture_bind(GAE_RenderTarget_Texture_t* target);
-GAE_RenderTarget_Texture_t* GAE_RenderTarget_Texture_unbind(GAE_RenderTarget_Texture_t* target);
+GAE_RenderTarget_Texture_t* GAE_RenderTarget_Texture_bind(GAE_RenderTarget_Texture_t* target, struct GAE_RenderState_s* state);
+GAE_RenderTarget_Texture_t* GAE_RenderTarget_Texture_unbind(GAE_RenderTarget_Texture_t* target, struct GAE_RenderState_s* state);
 void GAE_RenderTarget_Texture_delete(GAE_RenderTarget_Texture_t* target);
 
 #endif
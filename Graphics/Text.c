@@ -0,0 +1,345 @@
+#include "Text.h"
+
+#include "Font.h"
+#include "Mesh.h"
+#include "Material.h"
+#include "IndexBuffer.h"
+#include "Renderer/Renderer.h"
+#include "../Maths/Matrix.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* position 2F, texture 2F, colour 4UB */
+#define VERTEX_STRIDE 20U
+#define VERTEX_WORDS 5U
+#define REPLACEMENT_CHARACTER 0xFFFDU
+
+static unsigned int decodeUtf8(const unsigned char** cursor);
+static const GAE_Font_Glyph_t* findGlyph(GAE_Font_t* const font, const unsigned int codepoint);
+static unsigned int packColour(const GAE_Vector4_t colour);
+static void layout(GAE_Text_t* text);
+static void reserveBatch(GAE_Text_Batch_t* batch, const unsigned int count);
+static void deleteBatch(GAE_Text_Batch_t* batch);
+static void writeQuad(GAE_Text_t* text, const GAE_Font_Glyph_t* glyph, const float x, const float y, const unsigned int colour);
+
+GAE_Text_t* GAE_Text_create(GAE_Font_t* const font) {
+	GAE_Text_t* text = malloc(sizeof(GAE_Text_t));
+	unsigned int index = 0U;
+
+	text->font = font;
+	text->stringCapacity = 16U;
+	text->string = malloc(text->stringCapacity);
+	text->string[0] = '\0';
+	text->batches = calloc((0U < font->pageCount) ? font->pageCount : 1U, sizeof(GAE_Text_Batch_t));
+	for (index = 0U; index < 4U; ++index)
+		text->colour[index] = 1.0F;
+	text->width = 0.0F;
+	text->height = 0.0F;
+	GAE_Matrix4_setToIdentity(&text->transform);
+
+	return text;
+}
+
+GAE_Text_t* GAE_Text_setString(GAE_Text_t* text, const char* const string) {
+	const unsigned int length = (unsigned int)strlen(string);
+
+	/* unchanged strings keep their layout and vertices */
+	if (0 == strcmp(text->string, string))
+		return text;
+
+	if (length >= text->stringCapacity) {
+		while (length >= text->stringCapacity)
+			text->stringCapacity *= 2U;
+		free(text->string);
+		text->string = malloc(text->stringCapacity);
+	}
+
+	memcpy(text->string, string, length + 1U);
+	layout(text);
+
+	return text;
+}
+
+GAE_Text_t* GAE_Text_setColour(GAE_Text_t* text, const GAE_Vector4_t colour) {
+	if (0 == memcmp(text->colour, colour, sizeof(GAE_Vector4_t)))
+		return text;
+
+	memcpy(text->colour, colour, sizeof(GAE_Vector4_t));
+	layout(text);
+
+	return text;
+}
+
+GAE_Text_t* GAE_Text_draw(GAE_Text_t* text, GAE_Renderer_t* renderer) {
+	unsigned int page = 0U;
+
+	for (page = 0U; page < text->font->pageCount; ++page) {
+		GAE_Text_Batch_t* batch = text->batches + page;
+		GAE_Material_t* material = 0;
+
+		if (0U == batch->count)
+			continue;
+
+		/* pages may have been evicted since the last draw, so the material is fetched each time */
+		material = GAE_Font_usePage(text->font, page);
+		if (0 == material)
+			continue;
+
+		batch->mesh->material = material;
+		if (GAE_TRUE == batch->isDirty)
+			batch->mesh->vBuffer->updateData = &batch->update;
+
+		GAE_Renderer_drawMesh(renderer, batch->mesh, &text->transform);
+
+		batch->mesh->vBuffer->updateData = 0;
+		batch->isDirty = GAE_FALSE;
+	}
+
+	return text;
+}
+
+void GAE_Text_delete(GAE_Text_t* text) {
+	unsigned int page = 0U;
+
+	for (page = 0U; page < text->font->pageCount; ++page)
+		deleteBatch(text->batches + page);
+
+	free(text->batches);
+	free(text->string);
+	free(text);
+	text = 0;
+}
+
+unsigned int decodeUtf8(const unsigned char** cursor) {
+	const unsigned char* position = *cursor;
+	unsigned int codepoint = *position++;
+	unsigned int continuation = 0U;
+
+	if (0x80U > codepoint)
+		continuation = 0U;
+	else if (0xE0U > codepoint) {
+		codepoint &= 0x1FU;
+		continuation = 1U;
+	}
+	else if (0xF0U > codepoint) {
+		codepoint &= 0x0FU;
+		continuation = 2U;
+	}
+	else {
+		codepoint &= 0x07U;
+		continuation = 3U;
+	}
+
+	for (; 0U < continuation; --continuation) {
+		if (0x80U != (*position & 0xC0U)) {
+			*cursor = position;
+			return REPLACEMENT_CHARACTER;
+		}
+		codepoint = (codepoint << 6U) | (*position++ & 0x3FU);
+	}
+
+	*cursor = position;
+	return codepoint;
+}
+
+const GAE_Font_Glyph_t* findGlyph(GAE_Font_t* const font, const unsigned int codepoint) {
+	const GAE_Font_Glyph_t* glyph = GAE_Font_getGlyph(font, codepoint);
+
+	if (0 == glyph)
+		glyph = GAE_Font_getGlyph(font, REPLACEMENT_CHARACTER);
+	if (0 == glyph)
+		glyph = GAE_Font_getGlyph(font, '?');
+
+	return glyph;
+}
+
+unsigned int packColour(const GAE_Vector4_t colour) {
+	unsigned int packed = 0U;
+	unsigned int index = 0U;
+
+	/* every supported platform is little endian, so this lays out as R, G, B, A */
+	for (index = 0U; index < 4U; ++index) {
+		const float channel = (colour[index] < 0.0F) ? 0.0F : ((colour[index] > 1.0F) ? 1.0F : colour[index]);
+		packed |= (unsigned int)(channel * 255.0F + 0.5F) << (index * 8U);
+	}
+
+	return packed;
+}
+
+void layout(GAE_Text_t* text) {
+	GAE_Font_t* const font = text->font;
+	const unsigned int colour = packColour(text->colour);
+	const unsigned char* cursor = 0;
+	unsigned int previous = 0U;
+	unsigned int page = 0U;
+	unsigned int lines = 1U;
+	float x = 0.0F;
+	float y = 0.0F;
+
+	for (page = 0U; page < font->pageCount; ++page)
+		text->batches[page].count = 0U;
+
+	/* count the quads each page needs first, so the batches are sized once */
+	cursor = (const unsigned char*)text->string;
+	while ('\0' != *cursor) {
+		const unsigned int codepoint = decodeUtf8(&cursor);
+		const GAE_Font_Glyph_t* glyph = ('\n' != codepoint) ? findGlyph(font, codepoint) : 0;
+
+		if ((0 != glyph) && (0U < glyph->width) && (0U < glyph->height) && (glyph->page < font->pageCount))
+			++text->batches[glyph->page].count;
+	}
+
+	for (page = 0U; page < font->pageCount; ++page) {
+		GAE_Text_Batch_t* batch = text->batches + page;
+
+		if (batch->count > GAE_TEXT_MAX_BATCH_GLYPHS)
+			batch->count = GAE_TEXT_MAX_BATCH_GLYPHS;
+		if (batch->count > batch->capacity)
+			reserveBatch(batch, batch->count);
+		batch->count = 0U;
+	}
+
+	text->width = 0.0F;
+	cursor = (const unsigned char*)text->string;
+	while ('\0' != *cursor) {
+		const unsigned int codepoint = decodeUtf8(&cursor);
+		const GAE_Font_Glyph_t* glyph = 0;
+
+		if ('\n' == codepoint) {
+			text->width = (x > text->width) ? x : text->width;
+			x = 0.0F;
+			y += (float)font->lineHeight;
+			previous = 0U;
+			++lines;
+			continue;
+		}
+
+		glyph = findGlyph(font, codepoint);
+		if (0 == glyph)
+			continue;
+
+		if ((0U != previous) && (0U < font->kerningCount))
+			x += (float)GAE_Font_getKerning(font, previous, glyph->codepoint);
+
+		writeQuad(text, glyph, x, y, colour);
+		x += (float)glyph->xAdvance;
+		previous = glyph->codepoint;
+	}
+
+	text->width = (x > text->width) ? x : text->width;
+	text->height = (float)(lines * font->lineHeight);
+
+	for (page = 0U; page < font->pageCount; ++page) {
+		GAE_Text_Batch_t* batch = text->batches + page;
+
+		if (0 == batch->mesh)
+			continue;
+
+		batch->update.size = batch->count * 4U * VERTEX_STRIDE;
+		batch->mesh->iBuffer->count = batch->count * 6U;
+		batch->isDirty = GAE_TRUE;
+	}
+}
+
+void reserveBatch(GAE_Text_Batch_t* batch, const unsigned int count) {
+	GAE_VertexBuffer_t* vBuffer = 0;
+	GAE_IndexBuffer_t* iBuffer = 0;
+	unsigned short* indices = 0;
+	unsigned int capacity = 16U;
+	unsigned int quad = 0U;
+
+	while (capacity < count)
+		capacity *= 2U;
+	if (capacity > GAE_TEXT_MAX_BATCH_GLYPHS)
+		capacity = GAE_TEXT_MAX_BATCH_GLYPHS;
+
+	deleteBatch(batch);
+
+	vBuffer = GAE_VertexBuffer_createNotOwned(calloc(capacity * 4U, VERTEX_STRIDE), capacity * 4U * VERTEX_STRIDE, GAE_VERTEXBUFFER_TYPE_DYNAMIC);
+	vBuffer->owned = GAE_TRUE;
+	vBuffer->stride = VERTEX_STRIDE;
+	vBuffer->format[0] = GAE_VertexBuffer_Format_create(GAE_VERTEXBUFFER_FORMAT_POSITION_2F, 0U);
+	vBuffer->format[1] = GAE_VertexBuffer_Format_create(GAE_VERTEXBUFFER_FORMAT_TEXTURE_2F, 8U);
+	vBuffer->format[2] = GAE_VertexBuffer_Format_create(GAE_VERTEXBUFFER_FORMAT_COLOUR_4UB, 16U);
+
+	/* the same winding the sprites and tile chunks use */
+	indices = malloc(sizeof(unsigned short) * capacity * 6U);
+	for (quad = 0U; quad < capacity; ++quad) {
+		const unsigned short vertex = (unsigned short)(quad * 4U);
+		unsigned short* index = indices + quad * 6U;
+
+		index[0] = vertex;
+		index[1] = (unsigned short)(vertex + 3U);
+		index[2] = (unsigned short)(vertex + 2U);
+		index[3] = (unsigned short)(vertex + 2U);
+		index[4] = (unsigned short)(vertex + 1U);
+		index[5] = vertex;
+	}
+	iBuffer = GAE_IndexBuffer_create((GAE_BYTE*)indices, capacity * 6U, GAE_INDEXBUFFER_INDEX_UNSIGNED_SHORT, GAE_INDEXBUFFER_FORMAT_TRIANGLES, GAE_INDEXBUFFER_DRAW_STATIC);
+	free(indices);
+
+	batch->mesh = GAE_Mesh_create(vBuffer, iBuffer, 0);
+	batch->capacity = capacity;
+	batch->update.retain = GAE_TRUE;
+	batch->update.offset = 0U;
+	batch->update.size = 0U;
+	batch->update.data = vBuffer->data;
+}
+
+void deleteBatch(GAE_Text_Batch_t* batch) {
+	if (0 == batch->mesh)
+		return;
+
+	/* the update is the batch's own, never the buffer's to free */
+	batch->mesh->vBuffer->updateData = 0;
+	GAE_VertexBuffer_delete(batch->mesh->vBuffer);
+	GAE_IndexBuffer_delete(batch->mesh->iBuffer);
+	GAE_Mesh_delete(batch->mesh);
+
+	batch->mesh = 0;
+	batch->capacity = 0U;
+	batch->count = 0U;
+	batch->isDirty = GAE_FALSE;
+}
+
+void writeQuad(GAE_Text_t* text, const GAE_Font_Glyph_t* glyph, const float x, const float y, const unsigned int colour) {
+	GAE_Font_t* const font = text->font;
+	GAE_Text_Batch_t* batch = 0;
+	float* vertex = 0;
+	unsigned int* packed = 0;
+	float left = 0.0F;
+	float right = 0.0F;
+	float top = 0.0F;
+	float bottom = 0.0F;
+	float u0 = 0.0F;
+	float u1 = 0.0F;
+	float v0 = 0.0F;
+	float v1 = 0.0F;
+
+	if ((0U == glyph->width) || (0U == glyph->height) || (glyph->page >= font->pageCount))
+		return;
+
+	batch = text->batches + glyph->page;
+	if (batch->count >= batch->capacity)
+		return;
+
+	left = x + (float)glyph->xOffset;
+	top = y + (float)glyph->yOffset;
+	right = left + (float)glyph->width;
+	bottom = top + (float)glyph->height;
+	u0 = (float)glyph->x / (float)font->scaleWidth;
+	v0 = (float)glyph->y / (float)font->scaleHeight;
+	u1 = (float)(glyph->x + glyph->width) / (float)font->scaleWidth;
+	v1 = (float)(glyph->y + glyph->height) / (float)font->scaleHeight;
+
+	vertex = (float*)(void*)batch->mesh->vBuffer->data + batch->count * VERTEX_WORDS * 4U;
+	packed = (unsigned int*)(void*)vertex;
+
+	vertex[0] = left;	vertex[1] = top;	vertex[2] = u0;		vertex[3] = v0;		packed[4] = colour;
+	vertex[5] = right;	vertex[6] = top;	vertex[7] = u1;		vertex[8] = v0;		packed[9] = colour;
+	vertex[10] = right;	vertex[11] = bottom;	vertex[12] = u1;	vertex[13] = v1;	packed[14] = colour;
+	vertex[15] = left;	vertex[16] = bottom;	vertex[17] = u0;	vertex[18] = v1;	packed[19] = colour;
+
+	++batch->count;
+}
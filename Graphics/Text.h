@@ -0,0 +1,55 @@
+#ifndef _TEXT_H_
+#define _TEXT_H_
+
+#include "../GAE_Types.h"
+#include "VertexBuffer.h"
+
+/*
+	A string laid out in a Font, kept as one batch of quads per font page it uses.
+	Layout only happens when the string or colour changes, and the vertices are only uploaded after it does,
+	so static text costs a draw call per page and allocates nothing per frame.
+	UTF-8 strings, with '\n' starting a new line.
+*/
+
+/* Quads a single batch can hold, so it can be drawn with short indices. */
+#define GAE_TEXT_MAX_BATCH_GLYPHS 16384U
+
+struct GAE_Font_s;
+struct GAE_Mesh_s;
+struct GAE_Renderer_s;
+
+typedef struct GAE_Text_Batch_s {
+	struct GAE_Mesh_s* mesh;			/* 0 until the string uses this page */
+	unsigned int capacity;				/* in glyphs */
+	unsigned int count;
+	GAE_BOOL isDirty;					/* vertices changed since they were last uploaded */
+	GAE_VertexBuffer_UpdateData_t update;	/* points at the mesh's own data, only attached while dirty */
+} GAE_Text_Batch_t;
+
+typedef struct GAE_Text_s {
+	struct GAE_Font_s* font;
+	char* string;
+	unsigned int stringCapacity;
+	GAE_Text_Batch_t* batches;			/* one per font page */
+	GAE_Vector4_t colour;				/* RGBA from 0 to 1 */
+	float width;						/* extents of the laid out string, in font pixels */
+	float height;
+	GAE_Matrix4_t transform;
+} GAE_Text_t;
+
+/* Creates an empty Text in font - the font must outlive it. */
+GAE_Text_t* GAE_Text_create(struct GAE_Font_s* const font);
+
+/* Sets the string, laying it out again only if it differs from the current one. */
+GAE_Text_t* GAE_Text_setString(GAE_Text_t* text, const char* const string);
+
+/* Sets the colour every glyph is tinted with. */
+GAE_Text_t* GAE_Text_setColour(GAE_Text_t* text, const GAE_Vector4_t colour);
+
+/* Draws the text with its transform, one draw call per font page it uses. */
+GAE_Text_t* GAE_Text_draw(GAE_Text_t* text, struct GAE_Renderer_s* renderer);
+
+/* Deletes the Text. */
+void GAE_Text_delete(GAE_Text_t* text);
+
+#endif
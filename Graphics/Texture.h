@@ -22,12 +22,17 @@ GAE_Texture_t* GAE_Texture_createFromFile(struct GAE_File_s* const image);
 GAE_Texture_t* GAE_Texture_createFromBuffer(struct GAE_File_s* const buffer, const unsigned int width, const unsigned int height);
 void GAE_Texture_delete(GAE_Texture_t* texture);
 
+/* Uploads the texture, leaving it bound to the active unit behind the render state's back.
+ * GL builds count that, so the render state rechecks its bindings next time, and nothing needs invalidating by hand. */
 GAE_BOOL GAE_Texture_load(GAE_Texture_t* texture, const GAE_BOOL retainData);
 GAE_BOOL GAE_Texture_save(GAE_Texture_t* texture);
 
+/* Reads a loaded file texture's image again and replaces it in place, keeping the old one on failure - it binds as GAE_Texture_load does. */
+GAE_BOOL GAE_Texture_reload(GAE_Texture_t* texture, const GAE_BOOL retainData);
+
 #if defined(SDL2)
 #include "Texture/SDL2/SDL2Texture.h"
-#elif defined(GLES2) || defined(GLX)
+#elif defined(GLES2) || defined(GLX) || defined(MOCKGL)
 #include "Texture/GL/GLTexture.h"
 #endif
 
@@ -0,0 +1,25 @@
+#include "../../AtlasBuilder.h"
+
+#include "../../Texture.h"
+#include "../../../File/File.h"
+
+GAE_Texture_t* GAE_AtlasBuilder_createTexture(GAE_AtlasBuilder_t* builder, const unsigned int page) {
+	GAE_AtlasBuilder_Page_t* atlasPage = GAE_AtlasBuilder_getPage(builder, page);
+	GAE_Texture_t* texture = 0;
+	GAE_GL_Texture_t* platform = 0;
+	GAE_File_t* buffer = 0;
+
+	if ((0 == atlasPage) || (0 == atlasPage->data))
+		return 0;
+
+	/* the page pixels stay with the builder, the texture only borrows them for the upload */
+	buffer = GAE_File_create("atlas");
+	GAE_File_setBuffer(buffer, atlasPage->data, atlasPage->width * atlasPage->height * 4U, GAE_FILE_BUFFER_NOT_OWNED, 0);
+
+	texture = GAE_Texture_createFromBuffer(buffer, atlasPage->width, atlasPage->height);
+	platform = (GAE_GL_Texture_t*)texture->platform;
+	platform->format = GAE_GL_TEXTURE_FORMAT_RGBA;
+	platform->filter = GAE_GL_TEXTURE_FILTER_BILINEAR;
+
+	return texture;
+}
@@ -1,12 +1,17 @@
 #include "../../Texture.h"
 
 #include <stdlib.h>
+#include <string.h>
 
 #include "../../../Utils/HashString.h"
 #include "../../../External/stb/stb_image.h"
 #include "../../../File/File.h"
+#include "../../CompressedTexture.h"
+#include "../../CookedTexture.h"
 
-#if defined(GLX)
+#if defined(MOCKGL)
+	#include "../../Context/Mock/MockGL.h"
+#elif defined(GLX)
 	#include "../../Context/GLX/GLee.h"
 #elif defined(WGL)
 	#include "../../Context/Win32/GLee.h"
@@ -20,8 +25,26 @@
 	#endif
 #endif
 
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+	#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+	#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_ETC1_RGB8_OES
+	#define GL_ETC1_RGB8_OES 0x8D64
+#endif
+
+static GAE_BOOL readTextureFile(GAE_File_t* file);
 static GLuint loadTextureFromFile(GAE_Texture_t* texture);
+static unsigned int unshadowedChanges = 0U;
+
 static GLuint loadTextureFromBuffer(GAE_Texture_t* texture);
+static GLuint loadCompressedTexture(GAE_Texture_t* texture);
+static GLuint loadCookedTexture(GAE_Texture_t* texture, GAE_CookedTexture_t* cooked);
+static GLuint generateTexture(const GLuint texId);
+static void setParameters(GAE_GL_Texture_t* platform);
+static GAE_BOOL hasExtension(const char* extension);
 
 GAE_Texture_t* GAE_Texture_createFromFile(GAE_File_t* const image) {
 	GAE_Texture_t* texture = malloc(sizeof(GAE_Texture_t));
@@ -35,6 +58,8 @@ GAE_Texture_t* GAE_Texture_createFromFile(GAE_File_t* const image) {
 	platform->id = GL_INVALID_VALUE;
 	platform->format = GAE_GL_TEXTURE_FORMAT_INVALID;
 	platform->filter = GAE_GL_TEXTURE_FILTER_NONE;
+	platform->isPending = GAE_FALSE;
+	platform->isPremultiplied = GAE_FALSE;
 
 	texture->platform = (void*)platform;
 
@@ -53,6 +78,8 @@ GAE_Texture_t* GAE_Texture_createFromBuffer(GAE_File_t* const buffer, const unsi
 	platform->id = GL_INVALID_VALUE;
 	platform->format = GAE_GL_TEXTURE_FORMAT_INVALID;
 	platform->filter = GAE_GL_TEXTURE_FILTER_NONE;
+	platform->isPending = GAE_FALSE;
+	platform->isPremultiplied = GAE_FALSE;
 
 	texture->platform = (void*)platform;
 
@@ -63,11 +90,15 @@ void GAE_Texture_delete(GAE_Texture_t* texture) {
 	GAE_GL_Texture_t* platform = (GAE_GL_Texture_t*)texture->platform;
 
 	if (GL_INVALID_VALUE != platform->id) {
+		/* GL unbinds a deleted texture, and may hand its name straight out again */
 		glDeleteTextures(1, &platform->id);
 		platform->id = GL_INVALID_VALUE;
+		++unshadowedChanges;
 	}
 
-	GAE_File_delete(texture->file);
+	if (0 != texture->file)
+		GAE_File_delete(texture->file);
+
 	free(platform);
 	free(texture);
 	texture = 0;
@@ -78,7 +109,6 @@ GAE_BOOL GAE_Texture_load(GAE_Texture_t* texture, const GAE_BOOL retainData) {
 
 	GAE_File_t* file = texture->file;
 	GAE_FILE_STATUS openStatus;
-	GAE_FILE_READ_STATUS readStatus;
 
 	if (GL_INVALID_VALUE != platform->id) {
 		/*Application::getInstance()->getLogger()->log("Texture already loaded: " + mFile->getFilePath() + "\n", Logger::LOG_TYPE_ERROR);*/
@@ -87,20 +117,8 @@ GAE_BOOL GAE_Texture_load(GAE_Texture_t* texture, const GAE_BOOL retainData) {
 	
 	switch (texture->type) {
 		case GAE_TEXTURE_TYPE_FILE: {
-			if (0 == file->buffer) {
-				GAE_File_open(texture->file, GAE_FILE_OPEN_READ, GAE_FILE_BINARY, &openStatus);
-				if (GAE_FILE_ERROR == openStatus) {
-					GAE_File_close(texture->file, GAE_FILE_CLOSE_DELETE_DATA, NULL);
-					/*Application::getInstance()->getLogger()->log("Failed to open Texture: " + mFile->getFilePath() + "\n", Logger::LOG_TYPE_ERROR);*/
-					return GAE_FALSE;
-				}
-				GAE_File_read(texture->file, GAE_FILE_READ_ALL, &readStatus);
-				if (GAE_FILE_READ_ERROR == readStatus) {
-					GAE_File_close(texture->file, GAE_FILE_CLOSE_DELETE_DATA, NULL);
-					/*Application::getInstance()->getLogger()->log("Failed to read Texture: " + mFile->getFilePath() + "\n", Logger::LOG_TYPE_ERROR);*/
-					return GAE_FALSE;
-				}
-			}
+			if ((0 == file->buffer) && (GAE_FALSE == readTextureFile(file)))
+				return GAE_FALSE;
 
 			platform->id = loadTextureFromFile(texture);
 
@@ -120,8 +138,10 @@ GAE_BOOL GAE_Texture_load(GAE_Texture_t* texture, const GAE_BOOL retainData) {
 		case GAE_TEXTURE_TYPE_BUFFER: {
 			platform->id = loadTextureFromBuffer(texture);
 
-			if (GAE_FALSE == retainData)
+			if (GAE_FALSE == retainData) {
 				GAE_File_delete(texture->file);
+				texture->file = 0;
+			}
 
 			if (GL_INVALID_VALUE == platform->id) {
 				/*Application::getInstance()->getLogger()->log("Texture creation error: " + std::string(SOIL_last_result()) + "\n", Logger::LOG_TYPE_ERROR);*/
@@ -132,24 +152,35 @@ GAE_BOOL GAE_Texture_load(GAE_Texture_t* texture, const GAE_BOOL retainData) {
 		}
 	}
 	
-	switch (platform->filter) {
-		case GAE_GL_TEXTURE_FILTER_NONE:
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-			break;
-		case GAE_GL_TEXTURE_FILTER_BILINEAR:
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-			break;
-		case GAE_GL_TEXTURE_FILTER_TRILINEAR:
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-			break;
+	setParameters(platform);
+	return GAE_TRUE;
+}
+
+GAE_BOOL GAE_Texture_reload(GAE_Texture_t* texture, const GAE_BOOL retainData) {
+	GAE_GL_Texture_t* platform = (GAE_GL_Texture_t*)texture->platform;
+	GAE_File_t* file = texture->file;
+	GLuint texId = GL_INVALID_VALUE;
+
+	if ((GAE_TEXTURE_TYPE_FILE != texture->type) || (GL_INVALID_VALUE == platform->id) || (GAE_TRUE == platform->isPending))
+		return GAE_FALSE;
+
+	/* anything kept from the last load is out of date */
+	if (0 != file->buffer) {
+		GAE_File_deleteBuffer(file, 0);
+		file->buffer = 0;
+		file->bufferSize = 0UL;
 	}
-	
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-	
+
+	if (GAE_FALSE == readTextureFile(file))
+		return GAE_FALSE;
+
+	/* uploaded into the same name, so everything already pointing at this texture picks up the new image */
+	texId = loadTextureFromFile(texture);
+	GAE_File_close(file, (GAE_TRUE == retainData) ? GAE_FILE_CLOSE_RETAIN_DATA : GAE_FILE_CLOSE_DELETE_DATA, 0);
+	if (GL_INVALID_VALUE == texId)
+		return GAE_FALSE;
+
+	setParameters(platform);
 	return GAE_TRUE;
 }
 
@@ -159,6 +190,26 @@ GAE_BOOL GAE_Texture_save(GAE_Texture_t* texture) {
 	return GAE_FALSE;
 }
 
+GAE_BOOL readTextureFile(GAE_File_t* file) {
+	GAE_FILE_STATUS openStatus;
+	GAE_FILE_READ_STATUS readStatus;
+
+	GAE_File_open(file, GAE_FILE_OPEN_READ, GAE_FILE_BINARY, &openStatus);
+	if (GAE_FILE_ERROR == openStatus) {
+		GAE_File_close(file, GAE_FILE_CLOSE_DELETE_DATA, NULL);
+		/*Application::getInstance()->getLogger()->log("Failed to open Texture: " + mFile->getFilePath() + "\n", Logger::LOG_TYPE_ERROR);*/
+		return GAE_FALSE;
+	}
+	GAE_File_read(file, GAE_FILE_READ_ALL, &readStatus);
+	if (GAE_FILE_READ_ERROR == readStatus) {
+		GAE_File_close(file, GAE_FILE_CLOSE_DELETE_DATA, NULL);
+		/*Application::getInstance()->getLogger()->log("Failed to read Texture: " + mFile->getFilePath() + "\n", Logger::LOG_TYPE_ERROR);*/
+		return GAE_FALSE;
+	}
+
+	return GAE_TRUE;
+}
+
 GLuint loadTextureFromFile(GAE_Texture_t* texture) {
 	GAE_GL_Texture_t* platform = (GAE_GL_Texture_t*)texture->platform;
 	GAE_File_t* file = texture->file;
@@ -167,6 +218,11 @@ GLuint loadTextureFromFile(GAE_Texture_t* texture) {
 	int height = 1;
 	int channels = 3;
 	GLuint texId = GL_INVALID_VALUE;
+	GAE_CookedTexture_t cooked;
+
+	/* cooked textures skip decoding entirely */
+	if (GAE_TRUE == GAE_CookedTexture_parse(&cooked, file->buffer, file->bufferSize))
+		return loadCookedTexture(texture, &cooked);
 
 	switch (platform->format) {
 		case GAE_GL_TEXTURE_FORMAT_RGB:
@@ -177,6 +233,8 @@ GLuint loadTextureFromFile(GAE_Texture_t* texture) {
 			break;
 		case GAE_GL_TEXTURE_FORMAT_DXT1:
 		case GAE_GL_TEXTURE_FORMAT_DXT5:
+		case GAE_GL_TEXTURE_FORMAT_ETC1:
+			return loadCompressedTexture(texture);
 		default:
 			/*Application::getInstance()->getLogger()->log("Invalid Texture Format specified\n", Logger::LOG_TYPE_ERROR);*/
 			return texId;
@@ -184,11 +242,14 @@ GLuint loadTextureFromFile(GAE_Texture_t* texture) {
 	
     int nFormat = STBI_rgb_alpha;
     unsigned char* data = stbi_load_from_memory(file->buffer, file->bufferSize, &width, &height, &nFormat, channels);
+	if (0 == data)
+		return texId;
 	
-	glGenTextures(1, &texId);
-	glBindTexture(GL_TEXTURE_2D, texId);  
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, (3 == nFormat) ? GL_RGB : GL_RGBA, GL_UNSIGNED_BYTE, data);
-	glGenerateMipmap(GL_TEXTURE_2D);
+	texId = generateTexture(platform->id);
+	glTexImage2D(GL_TEXTURE_2D, 0, (3 == channels) ? GL_RGB : GL_RGBA, width, height, 0, (3 == channels) ? GL_RGB : GL_RGBA, GL_UNSIGNED_BYTE, data);
+	stbi_image_free(data);
+	if (GAE_GL_TEXTURE_FILTER_TRILINEAR == platform->filter)
+		glGenerateMipmap(GL_TEXTURE_2D);
 	
 	texture->width = (unsigned int)width;
 	texture->height = (unsigned int)height;
@@ -201,6 +262,10 @@ GLuint loadTextureFromBuffer(GAE_Texture_t* texture) {
 	unsigned int imageSize = 0U;
 	unsigned int imageFormat = 0U;
 	GLuint texId = GL_INVALID_VALUE;
+	GAE_CookedTexture_t cooked;
+
+	if (GAE_TRUE == GAE_CookedTexture_parse(&cooked, texture->file->buffer, texture->file->bufferSize))
+		return loadCookedTexture(texture, &cooked);
 
 	switch (platform->format) {
 		case GAE_GL_TEXTURE_FORMAT_RGB:
@@ -213,6 +278,8 @@ GLuint loadTextureFromBuffer(GAE_Texture_t* texture) {
 			break;
 		case GAE_GL_TEXTURE_FORMAT_DXT1:
 		case GAE_GL_TEXTURE_FORMAT_DXT5:
+		case GAE_GL_TEXTURE_FORMAT_ETC1:
+			return loadCompressedTexture(texture);
 		default:
 			/*Application::getInstance()->getLogger()->log("Invalid Texture Format specified\n", Logger::LOG_TYPE_ERROR);*/
 			return texId;
@@ -223,10 +290,139 @@ GLuint loadTextureFromBuffer(GAE_Texture_t* texture) {
 		return texId;
 	}
 	
-	glGenTextures(1, &texId);
-	glBindTexture(GL_TEXTURE_2D, texId);  
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, texture->width, texture->height, 0, (3 == imageFormat) ? GL_RGB : GL_RGBA, GL_UNSIGNED_BYTE, texture->file->buffer);
-	glGenerateMipmap(GL_TEXTURE_2D);
+	texId = generateTexture(platform->id);
+	glTexImage2D(GL_TEXTURE_2D, 0, (3 == imageFormat) ? GL_RGB : GL_RGBA, texture->width, texture->height, 0, (3 == imageFormat) ? GL_RGB : GL_RGBA, GL_UNSIGNED_BYTE, texture->file->buffer);
+	if (GAE_GL_TEXTURE_FILTER_TRILINEAR == platform->filter)
+		glGenerateMipmap(GL_TEXTURE_2D);
 	
 	return texId;
 }
+
+GLuint loadCompressedTexture(GAE_Texture_t* texture) {
+	GAE_GL_Texture_t* platform = (GAE_GL_Texture_t*)texture->platform;
+	GAE_CompressedTexture_t image;
+	GLenum internalFormat = GL_INVALID_VALUE;
+	GAE_BOOL isSupported = GAE_FALSE;
+	GLuint texId = GL_INVALID_VALUE;
+	unsigned int level = 0U;
+
+	/* the buffer holds a DDS or KTX container, which decides the actual format */
+	if (GAE_FALSE == GAE_CompressedTexture_parse(&image, texture->file->buffer, texture->file->bufferSize))
+		return texId;
+
+	switch (image.format) {
+		case GAE_COMPRESSED_TEXTURE_FORMAT_DXT1:
+			platform->format = GAE_GL_TEXTURE_FORMAT_DXT1;
+			internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+			isSupported = hasExtension("GL_EXT_texture_compression_s3tc") || hasExtension("GL_EXT_texture_compression_dxt1");
+			break;
+		case GAE_COMPRESSED_TEXTURE_FORMAT_DXT5:
+			platform->format = GAE_GL_TEXTURE_FORMAT_DXT5;
+			internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+			isSupported = hasExtension("GL_EXT_texture_compression_s3tc");
+			break;
+		case GAE_COMPRESSED_TEXTURE_FORMAT_ETC1:
+			platform->format = GAE_GL_TEXTURE_FORMAT_ETC1;
+			internalFormat = GL_ETC1_RGB8_OES;
+			isSupported = hasExtension("GL_OES_compressed_ETC1_RGB8_texture");
+			break;
+		case GAE_COMPRESSED_TEXTURE_FORMAT_INVALID:
+		default:
+			return texId;
+	}
+
+	texId = generateTexture(platform->id);
+
+	if (GAE_TRUE == isSupported) {
+		for (level = 0U; level < image.levelCount; ++level)
+			glCompressedTexImage2D(GL_TEXTURE_2D, (GLint)level, internalFormat, image.levels[level].width, image.levels[level].height, 0, image.levels[level].size, image.levels[level].data);
+
+		/* compressed textures can't have their mips generated, so drop to bilinear when the container has none */
+		if ((1U == image.levelCount) && (GAE_GL_TEXTURE_FILTER_TRILINEAR == platform->filter))
+			platform->filter = GAE_GL_TEXTURE_FILTER_BILINEAR;
+	}
+	else {
+		/* no hardware support - decode every level on the CPU instead */
+		GAE_BYTE* pixels = malloc(image.width * image.height * 4U);
+
+		for (level = 0U; level < image.levelCount; ++level) {
+			GAE_CompressedTexture_decode(&image, level, pixels);
+			glTexImage2D(GL_TEXTURE_2D, (GLint)level, GL_RGBA, image.levels[level].width, image.levels[level].height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+		}
+
+		free(pixels);
+
+		if ((1U == image.levelCount) && (GAE_GL_TEXTURE_FILTER_TRILINEAR == platform->filter))
+			glGenerateMipmap(GL_TEXTURE_2D);
+	}
+
+	texture->width = image.width;
+	texture->height = image.height;
+
+	return texId;
+}
+
+GLuint loadCookedTexture(GAE_Texture_t* texture, GAE_CookedTexture_t* cooked) {
+	GAE_GL_Texture_t* platform = (GAE_GL_Texture_t*)texture->platform;
+	const GLenum format = (GAE_COOKED_TEXTURE_FORMAT_RGB8 == cooked->format) ? GL_RGB : GL_RGBA;
+	GLuint texId = GL_INVALID_VALUE;
+	unsigned int level = 0U;
+
+	platform->format = (GAE_COOKED_TEXTURE_FORMAT_RGB8 == cooked->format) ? GAE_GL_TEXTURE_FORMAT_RGB : GAE_GL_TEXTURE_FORMAT_RGBA;
+	platform->isPremultiplied = (0U != (cooked->flags & GAE_COOKED_TEXTURE_FLAG_PREMULTIPLIED)) ? GAE_TRUE : GAE_FALSE;
+
+	texId = generateTexture(platform->id);
+
+	/* rows are cooked to the default 4 byte unpack alignment */
+	for (level = 0U; level < cooked->levelCount; ++level)
+		glTexImage2D(GL_TEXTURE_2D, (GLint)level, format, cooked->levels[level].width, cooked->levels[level].height, 0, format, GL_UNSIGNED_BYTE, cooked->levels[level].data);
+
+	if ((1U == cooked->levelCount) && (GAE_GL_TEXTURE_FILTER_TRILINEAR == platform->filter))
+		glGenerateMipmap(GL_TEXTURE_2D);
+
+	texture->width = cooked->width;
+	texture->height = cooked->height;
+
+	return texId;
+}
+
+unsigned int GAE_GL_Texture_getUnshadowedChanges(void) {
+	return unshadowedChanges;
+}
+
+GLuint generateTexture(const GLuint texId) {
+	GLuint newId = texId;
+
+	/* a reload keeps the name it already has */
+	if (GL_INVALID_VALUE == newId)
+		glGenTextures(1, &newId);
+	glBindTexture(GL_TEXTURE_2D, newId);
+	++unshadowedChanges;
+
+	return newId;
+}
+
+void setParameters(GAE_GL_Texture_t* platform) {
+	switch (platform->filter) {
+		case GAE_GL_TEXTURE_FILTER_NONE:
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+			break;
+		case GAE_GL_TEXTURE_FILTER_BILINEAR:
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			break;
+		case GAE_GL_TEXTURE_FILTER_TRILINEAR:
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			break;
+	}
+	
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+}
+
+GAE_BOOL hasExtension(const char* extension) {
+	const char* extensions = (const char*)glGetString(GL_EXTENSIONS);
+	return ((0 != extensions) && (0 != strstr(extensions, extension))) ? GAE_TRUE : GAE_FALSE;
+}
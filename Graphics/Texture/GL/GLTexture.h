@@ -1,12 +1,15 @@
 #ifndef _GL_TEXTURE_H_
 #define _GL_TEXTURE_H_
 
+#include "../../../GAE_Types.h"
+
 typedef enum GAE_GL_Texture_Format_e {
 	GAE_GL_TEXTURE_FORMAT_INVALID
 ,	GAE_GL_TEXTURE_FORMAT_DXT1
 ,	GAE_GL_TEXTURE_FORMAT_DXT5
 ,	GAE_GL_TEXTURE_FORMAT_RGBA
 ,	GAE_GL_TEXTURE_FORMAT_RGB
+,	GAE_GL_TEXTURE_FORMAT_ETC1
 } GAE_GL_Texture_Format;
 
 typedef enum GAE_GL_Texture_Filter_e {
@@ -19,6 +22,12 @@ typedef struct GAE_GL_Texture_s {
 	unsigned int id;
 	GAE_GL_Texture_Format format;
 	GAE_GL_Texture_Filter filter;
+	GAE_BOOL isPending; /* queued on a GAE_TextureLoader, the placeholder is drawn instead */
+	GAE_BOOL isPremultiplied; /* cooked with premultiplied alpha, blend with GL_ONE, GL_ONE_MINUS_SRC_ALPHA */
 } GAE_GL_Texture_t;
 
+/* Counts the times a texture load, reload or delete has changed the bound texture behind the render state's back.
+ * The render state drops its texture shadow whenever this has moved on since it last looked. */
+unsigned int GAE_GL_Texture_getUnshadowedChanges(void);
+
 #endif
@@ -0,0 +1,322 @@
+#include "../../TextureLoader.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../Texture.h"
+#include "../../State/RenderState.h"
+#include "../../../File/File.h"
+#include "../../../Threads/Thread.h"
+#include "../../../Utils/Array.h"
+#include "../../../Utils/List.h"
+#include "../../../External/stb/stb_image.h"
+
+typedef struct GAE_TextureLoader_Request_s {
+	GAE_Texture_t* texture;
+	int channels; /* 0 for compressed containers, which are only read */
+} GAE_TextureLoader_Request_t;
+
+typedef struct GAE_TextureLoader_Result_s {
+	GAE_Texture_t* texture;
+	GAE_BYTE* pixels; /* 0 if the read or decode failed */
+	unsigned long size;
+	unsigned int width;
+	unsigned int height;
+} GAE_TextureLoader_Result_t;
+
+static void workerMain(void* userData);
+static GAE_TextureLoader_Result_t decodeRequest(GAE_TextureLoader_Request_t* request);
+static void uploadResult(GAE_TextureLoader_t* loader, GAE_TextureLoader_Result_t* result);
+static GAE_Texture_t* createPlaceholder(void);
+
+GAE_TextureLoader_t* GAE_TextureLoader_create(GAE_RenderState_t* state, const unsigned int threadCount, const unsigned long uploadBudget) {
+	GAE_TextureLoader_t* loader = malloc(sizeof(GAE_TextureLoader_t));
+	unsigned int count = threadCount;
+	unsigned int index = 0U;
+
+	if (0U == count) {
+		count = GAE_Thread_getHardwareCount();
+		count = (1U < count) ? count - 1U : 1U;
+	}
+
+	loader->requests = GAE_SingleList_create(sizeof(GAE_TextureLoader_Request_t));
+	loader->completed = GAE_SingleList_create(sizeof(GAE_TextureLoader_Result_t));
+	loader->mutex = GAE_Mutex_create();
+	loader->requestReady = GAE_Condition_create();
+	loader->completedReady = GAE_Condition_create();
+	loader->placeholder = createPlaceholder();
+	loader->state = state;
+	loader->uploadBudget = uploadBudget;
+	loader->uploadedBytes = 0UL;
+	loader->pendingCount = 0U;
+	loader->failedCount = 0U;
+	loader->isRunning = GAE_TRUE;
+
+	GAE_RenderState_setPlaceholderTexture(state, loader->placeholder);
+	GAE_RenderState_invalidateTextures(state);
+
+	loader->threads = GAE_Array_create(sizeof(GAE_Thread_t*));
+	for (index = 0U; index < count; ++index) {
+		GAE_Thread_t* thread = GAE_Thread_create(workerMain, loader);
+		if (0 != thread)
+			GAE_Array_push(loader->threads, &thread);
+	}
+
+	return loader;
+}
+
+GAE_TextureLoader_t* GAE_TextureLoader_load(GAE_TextureLoader_t* loader, GAE_Texture_t* const texture, GAE_BOOL* status) {
+	GAE_GL_Texture_t* platform = (GAE_GL_Texture_t*)texture->platform;
+	GAE_TextureLoader_Request_t request;
+
+	if ((GAE_TEXTURE_TYPE_FILE != texture->type) || (GL_INVALID_VALUE != platform->id) || (GAE_TRUE == platform->isPending)) {
+		if (0 != status)
+			*status = GAE_FALSE;
+		return loader;
+	}
+
+	switch (platform->format) {
+		case GAE_GL_TEXTURE_FORMAT_RGB:
+			request.channels = 3;
+			break;
+		case GAE_GL_TEXTURE_FORMAT_RGBA:
+			request.channels = 4;
+			break;
+		case GAE_GL_TEXTURE_FORMAT_DXT1:
+		case GAE_GL_TEXTURE_FORMAT_DXT5:
+		case GAE_GL_TEXTURE_FORMAT_ETC1:
+			request.channels = 0;
+			break;
+		default:
+			if (0 != status)
+				*status = GAE_FALSE;
+			return loader;
+	}
+
+	request.texture = texture;
+	platform->isPending = GAE_TRUE;
+	++loader->pendingCount;
+
+	GAE_Mutex_lock(loader->mutex);
+	GAE_SingleList_push(loader->requests, &request);
+	GAE_Condition_signal(loader->requestReady);
+	GAE_Mutex_unlock(loader->mutex);
+
+	if (0 != status)
+		*status = GAE_TRUE;
+
+	return loader;
+}
+
+GAE_TextureLoader_t* GAE_TextureLoader_update(GAE_TextureLoader_t* loader) {
+	loader->uploadedBytes = 0UL;
+
+	while (0U < loader->pendingCount) {
+		GAE_TextureLoader_Result_t* result = 0;
+
+		GAE_Mutex_lock(loader->mutex);
+		if (0 != loader->completed->begin) {
+			/* peek first so a texture that would blow the budget waits for the next frame */
+			const unsigned long size = ((GAE_TextureLoader_Result_t*)loader->completed->begin->data)->size;
+			if ((0UL == loader->uploadedBytes) || (loader->uploadedBytes + size <= loader->uploadBudget))
+				result = GAE_SingleList_pop(loader->completed);
+		}
+		GAE_Mutex_unlock(loader->mutex);
+
+		if (0 == result)
+			break;
+
+		loader->uploadedBytes += result->size;
+		uploadResult(loader, result);
+		free(result);
+	}
+
+	return loader;
+}
+
+GAE_TextureLoader_t* GAE_TextureLoader_flush(GAE_TextureLoader_t* loader) {
+	while (0U < loader->pendingCount) {
+		GAE_TextureLoader_Result_t* result = 0;
+
+		GAE_Mutex_lock(loader->mutex);
+		while (0U == GAE_SingleList_length(loader->completed))
+			GAE_Condition_wait(loader->completedReady, loader->mutex);
+		result = GAE_SingleList_pop(loader->completed);
+		GAE_Mutex_unlock(loader->mutex);
+
+		uploadResult(loader, result);
+		free(result);
+	}
+
+	return loader;
+}
+
+unsigned int GAE_TextureLoader_getPendingCount(GAE_TextureLoader_t* loader) {
+	return loader->pendingCount;
+}
+
+void GAE_TextureLoader_delete(GAE_TextureLoader_t* loader) {
+	GAE_Thread_t** thread = 0;
+	GAE_TextureLoader_Request_t* request = 0;
+	GAE_TextureLoader_Result_t* result = 0;
+
+	GAE_Mutex_lock(loader->mutex);
+	loader->isRunning = GAE_FALSE;
+	GAE_Condition_broadcast(loader->requestReady);
+	GAE_Mutex_unlock(loader->mutex);
+
+	thread = GAE_Array_begin(loader->threads);
+	while (thread != GAE_Array_end(loader->threads)) {
+		GAE_Thread_delete(*thread);
+		++thread;
+	}
+	GAE_Array_delete(loader->threads);
+
+	while (0 != (request = GAE_SingleList_pop(loader->requests))) {
+		((GAE_GL_Texture_t*)request->texture->platform)->isPending = GAE_FALSE;
+		free(request);
+	}
+
+	while (0 != (result = GAE_SingleList_pop(loader->completed))) {
+		((GAE_GL_Texture_t*)result->texture->platform)->isPending = GAE_FALSE;
+		free(result->pixels);
+		free(result);
+	}
+
+	GAE_RenderState_setPlaceholderTexture(loader->state, 0);
+	GAE_Texture_delete(loader->placeholder);
+
+	GAE_SingleList_delete(loader->requests);
+	GAE_SingleList_delete(loader->completed);
+	GAE_Condition_delete(loader->requestReady);
+	GAE_Condition_delete(loader->completedReady);
+	GAE_Mutex_delete(loader->mutex);
+	free(loader);
+	loader = 0;
+}
+
+void workerMain(void* userData) {
+	GAE_TextureLoader_t* loader = (GAE_TextureLoader_t*)userData;
+
+	for (;;) {
+		GAE_TextureLoader_Request_t* request = 0;
+		GAE_TextureLoader_Result_t result;
+
+		GAE_Mutex_lock(loader->mutex);
+		while ((GAE_TRUE == loader->isRunning) && (0U == GAE_SingleList_length(loader->requests)))
+			GAE_Condition_wait(loader->requestReady, loader->mutex);
+
+		if (GAE_FALSE == loader->isRunning) {
+			GAE_Mutex_unlock(loader->mutex);
+			return;
+		}
+
+		request = GAE_SingleList_pop(loader->requests);
+		GAE_Mutex_unlock(loader->mutex);
+
+		result = decodeRequest(request);
+		free(request);
+
+		GAE_Mutex_lock(loader->mutex);
+		GAE_SingleList_push(loader->completed, &result);
+		GAE_Condition_signal(loader->completedReady);
+		GAE_Mutex_unlock(loader->mutex);
+	}
+}
+
+GAE_TextureLoader_Result_t decodeRequest(GAE_TextureLoader_Request_t* request) {
+	GAE_File_t* file = request->texture->file;
+	GAE_TextureLoader_Result_t result;
+	GAE_BOOL isOpened = GAE_FALSE;
+	int width = 0;
+	int height = 0;
+	int fileChannels = 0;
+
+	result.texture = request->texture;
+	result.pixels = 0;
+	result.size = 0UL;
+	result.width = 0U;
+	result.height = 0U;
+
+	/* the file may already hold the encoded image, otherwise it's read here on the worker */
+	if (0 == file->buffer) {
+		GAE_FILE_STATUS openStatus = GAE_FILE_ERROR;
+		GAE_FILE_READ_STATUS readStatus = GAE_FILE_READ_ERROR;
+
+		GAE_File_open(file, GAE_FILE_OPEN_READ, GAE_FILE_BINARY, &openStatus);
+		if (GAE_FILE_OPEN != openStatus)
+			return result;
+
+		isOpened = GAE_TRUE;
+		GAE_File_read(file, GAE_FILE_READ_ALL, &readStatus);
+		if (GAE_FILE_READ_ERROR == readStatus) {
+			GAE_File_close(file, GAE_FILE_CLOSE_DELETE_DATA, 0);
+			return result;
+		}
+	}
+
+	if ((0 == request->channels) || ((4UL <= file->bufferSize) && (0 == memcmp(file->buffer, "GTEX", 4U)))) {
+		/* compressed containers and cooked textures go to the GPU as they are, the upload parses them */
+		result.pixels = malloc(file->bufferSize);
+		memcpy(result.pixels, file->buffer, file->bufferSize);
+		result.size = file->bufferSize;
+	}
+	else {
+		result.pixels = stbi_load_from_memory(file->buffer, (int)file->bufferSize, &width, &height, &fileChannels, request->channels);
+		result.width = (unsigned int)width;
+		result.height = (unsigned int)height;
+		result.size = (unsigned long)width * (unsigned long)height * (unsigned long)request->channels;
+	}
+
+	if (GAE_TRUE == isOpened)
+		GAE_File_close(file, GAE_FILE_CLOSE_DELETE_DATA, 0);
+
+	return result;
+}
+
+void uploadResult(GAE_TextureLoader_t* loader, GAE_TextureLoader_Result_t* result) {
+	GAE_Texture_t* texture = result->texture;
+	GAE_GL_Texture_t* platform = (GAE_GL_Texture_t*)texture->platform;
+
+	platform->isPending = GAE_FALSE;
+	--loader->pendingCount;
+
+	if (0 == result->pixels) {
+		++loader->failedCount;
+		return;
+	}
+
+	/* hand the decoded pixels over as a buffer texture so the regular upload path is used */
+	GAE_File_setBuffer(texture->file, result->pixels, result->size, GAE_FILE_BUFFER_OWNED, 0);
+	texture->type = GAE_TEXTURE_TYPE_BUFFER;
+	texture->width = result->width;
+	texture->height = result->height;
+
+	if (GAE_FALSE == GAE_Texture_load(texture, GAE_TRUE))
+		++loader->failedCount;
+
+	GAE_File_deleteBuffer(texture->file, 0);
+	texture->type = GAE_TEXTURE_TYPE_FILE;
+
+	/* the upload bound a texture behind the render state's back */
+	GAE_RenderState_invalidateTextures(loader->state);
+}
+
+GAE_Texture_t* createPlaceholder(void) {
+	const GAE_BYTE pixels[16] = {
+		0x80, 0x80, 0x80, 0xFF, 0xC0, 0xC0, 0xC0, 0xFF,
+		0xC0, 0xC0, 0xC0, 0xFF, 0x80, 0x80, 0x80, 0xFF };
+	GAE_File_t* buffer = GAE_File_create("placeholder");
+	GAE_Texture_t* texture = 0;
+	GAE_GL_Texture_t* platform = 0;
+
+	GAE_File_setBuffer(buffer, (GAE_BYTE*)pixels, sizeof(pixels), GAE_FILE_BUFFER_COPY, 0);
+	texture = GAE_Texture_createFromBuffer(buffer, 2U, 2U);
+	platform = (GAE_GL_Texture_t*)texture->platform;
+	platform->format = GAE_GL_TEXTURE_FORMAT_RGBA;
+	platform->filter = GAE_GL_TEXTURE_FILTER_NONE;
+	GAE_Texture_load(texture, GAE_TRUE);
+	GAE_File_deleteBuffer(buffer, 0);
+
+	return texture;
+}
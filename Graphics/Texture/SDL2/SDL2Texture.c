@@ -143,6 +143,46 @@ GAE_BOOL GAE_Texture_load(GAE_Texture_t* texture, const GAE_BOOL retainData) {
 	return GAE_TRUE;
 }
 
+GAE_BOOL GAE_Texture_reload(GAE_Texture_t* texture, const GAE_BOOL retainData) {
+	GAE_SDL2_Texture_t* platform = (GAE_SDL2_Texture_t*)texture->platform;
+	GAE_File_t* file = texture->file;
+	SDL_Texture* oldTexture = platform->texture;
+	GAE_FILE_STATUS openStatus;
+	GAE_FILE_READ_STATUS readStatus;
+
+	if ((GAE_TEXTURE_TYPE_FILE != texture->type) || (0 == oldTexture))
+		return GAE_FALSE;
+
+	/* anything kept from the last load is out of date */
+	if (0 != file->buffer) {
+		GAE_File_deleteBuffer(file, 0);
+		file->buffer = 0;
+		file->bufferSize = 0UL;
+	}
+
+	GAE_File_open(file, GAE_FILE_OPEN_READ, GAE_FILE_BINARY, &openStatus);
+	if (GAE_FILE_ERROR == openStatus) {
+		GAE_File_close(file, GAE_FILE_CLOSE_DELETE_DATA, NULL);
+		return GAE_FALSE;
+	}
+	GAE_File_read(file, GAE_FILE_READ_ALL, &readStatus);
+	if (GAE_FILE_READ_ERROR == readStatus) {
+		GAE_File_close(file, GAE_FILE_CLOSE_DELETE_DATA, NULL);
+		return GAE_FALSE;
+	}
+
+	/* SDL can't replace a texture's image at a new size, so the new texture takes the old one's place once it exists */
+	platform->texture = loadTextureFromFile(texture);
+	GAE_File_close(file, (GAE_TRUE == retainData) ? GAE_FILE_CLOSE_RETAIN_DATA : GAE_FILE_CLOSE_DELETE_DATA, NULL);
+	if (0 == platform->texture) {
+		platform->texture = oldTexture;
+		return GAE_FALSE;
+	}
+
+	SDL_DestroyTexture(oldTexture);
+	return GAE_TRUE;
+}
+
 /* todo: unimplemented */
 GAE_BOOL GAE_Texture_save(GAE_Texture_t* texture) {
 	GAE_UNUSED(texture);
@@ -160,6 +200,9 @@ SDL_Texture* loadTextureFromFile(GAE_Texture_t* texture) {
 	SDL_Surface* surf = 0;
 	SDL_Texture* tex = 0;
 
+	if (0 == data)
+		return tex;
+
 	#if SDL_BYTEORDER == SDL_BIG_ENDIAN
         int shift = (STBI_rgb == nFormat) ? 8 : 0;
         rmask = 0xff000000 >> shift;
@@ -0,0 +1,47 @@
+#ifndef _TEXTURE_LOADER_H_
+#define _TEXTURE_LOADER_H_
+
+#include "../GAE_Types.h"
+
+struct GAE_Array_s;
+struct GAE_SingleList_s;
+struct GAE_Mutex_s;
+struct GAE_Condition_s;
+struct GAE_Texture_s;
+struct GAE_RenderState_s;
+
+typedef struct GAE_TextureLoader_s {
+	struct GAE_Array_s* threads;
+	struct GAE_SingleList_s* requests; /* waiting to be read and decoded */
+	struct GAE_SingleList_s* completed; /* decoded and waiting to be uploaded */
+	struct GAE_Mutex_s* mutex;
+	struct GAE_Condition_s* requestReady;
+	struct GAE_Condition_s* completedReady;
+	struct GAE_Texture_s* placeholder;
+	struct GAE_RenderState_s* state;
+	unsigned long uploadBudget; /* bytes uploaded per update, at least one texture is always uploaded */
+	unsigned long uploadedBytes; /* during the last update */
+	unsigned int pendingCount;
+	unsigned int failedCount;
+	GAE_BOOL isRunning;
+} GAE_TextureLoader_t;
+
+/* Creates a new Texture Loader with its worker threads and registers its placeholder texture with the render state. A threadCount of 0 uses one thread per hardware thread, minus the render thread. */
+GAE_TextureLoader_t* GAE_TextureLoader_create(struct GAE_RenderState_s* state, const unsigned int threadCount, const unsigned long uploadBudget);
+
+/* Queues an unloaded file texture with its format and filter set - it draws as the placeholder until uploaded. */
+GAE_TextureLoader_t* GAE_TextureLoader_load(GAE_TextureLoader_t* loader, struct GAE_Texture_s* const texture, GAE_BOOL* status);
+
+/* Uploads decoded textures until the per update byte budget is spent. Call once a frame on the render thread. */
+GAE_TextureLoader_t* GAE_TextureLoader_update(GAE_TextureLoader_t* loader);
+
+/* Blocks until every queued texture has been uploaded, ignoring the budget. */
+GAE_TextureLoader_t* GAE_TextureLoader_flush(GAE_TextureLoader_t* loader);
+
+/* Returns the amount of textures queued but not yet uploaded. */
+unsigned int GAE_TextureLoader_getPendingCount(GAE_TextureLoader_t* loader);
+
+/* Stops the worker threads and deletes the loader. Textures still queued are left unloaded. */
+void GAE_TextureLoader_delete(GAE_TextureLoader_t* loader);
+
+#endif
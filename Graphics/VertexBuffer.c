@@ -5,7 +5,9 @@
 #include <stdlib.h>
 #include <assert.h>
 
-#if defined(LINUX)
+#if defined(MOCKGL)
+	#include "Context/Mock/MockGL.h"
+#elif defined(LINUX)
 	#include "Context/GLX/GLee.h"
 #elif defined(WIN32)
 	#include "Context/Win32/GLee.h"
@@ -19,6 +21,8 @@
 	#endif
 #endif
 
+static unsigned int unshadowedChanges = 0U;
+
 GAE_VertexBuffer_Format_t GAE_VertexBuffer_Format_create(const GAE_VertexBuffer_FormatType type, unsigned int offset) {
 	GAE_VertexBuffer_Format_t format;
 	format.type = type;
@@ -60,6 +64,7 @@ GAE_VertexBuffer_Format_t GAE_VertexBuffer_Format_create(const GAE_VertexBuffer_
 		case GAE_VERTEXBUFFER_FORMAT_COLOUR_4UB:
 		case GAE_VERTEXBUFFER_FORMAT_TEXTURE_4B:
 			format.size = sizeof(char) * 4;
+			break;
 		case GAE_VERTEXBUFFER_FORMAT_CUSTOM_2S:
 		case GAE_VERTEXBUFFER_FORMAT_POSITION_2S:
 		case GAE_VERTEXBUFFER_FORMAT_TEXTURE_2S:
@@ -86,6 +91,16 @@ GAE_VertexBuffer_Format_t GAE_VertexBuffer_Format_create(const GAE_VertexBuffer_
 }
 
 GAE_VertexBuffer_t* GAE_VertexBuffer_create(GAE_BYTE* const data, const unsigned int size, const GAE_VertexBuffer_Type type) {
+	GAE_VertexBuffer_t* buffer = GAE_VertexBuffer_createNotOwned(0, size, type);
+
+	buffer->data = malloc(size);
+	buffer->owned = GAE_TRUE;
+	memcpy(buffer->data, data, size);
+
+	return buffer;
+}
+
+GAE_VertexBuffer_t* GAE_VertexBuffer_createNotOwned(GAE_BYTE* const data, const unsigned int size, const GAE_VertexBuffer_Type type) {
 	GAE_VertexBuffer_t* buffer = (GAE_VertexBuffer_t*)malloc(sizeof(GAE_VertexBuffer_t));
 	GAE_VertexBuffer_Format_t invalidFormat;
 	unsigned int index = 0U;
@@ -98,15 +113,14 @@ GAE_VertexBuffer_t* GAE_VertexBuffer_create(GAE_BYTE* const data, const unsigned
 		buffer->format[index] = invalidFormat;
 
 	buffer->size = size;
-	buffer->data = malloc(size);
+	buffer->data = data;
 	buffer->stride = 0U;
 	buffer->offset = 0U;
 	buffer->type = type;
 	buffer->vboId = 0;
+	buffer->owned = GAE_FALSE;
 	buffer->updateData = 0;
-	
 
-	memcpy(buffer->data, data, size);
 	return buffer;
 }
 
@@ -131,7 +145,7 @@ GAE_VertexBuffer_t* GAE_VertexBuffer_clone(GAE_VertexBuffer_t* buffer) {
 }
 
 void GAE_VertexBuffer_delete(GAE_VertexBuffer_t* buffer) {
-	if (0 != buffer->data) {
+	if ((0 != buffer->data) && (GAE_TRUE == buffer->owned)) {
 		free(buffer->data);
 		buffer->data = 0;
 	}
@@ -149,12 +163,17 @@ void GAE_VertexBuffer_delete(GAE_VertexBuffer_t* buffer) {
 		glDeleteBuffers(1, buffer->vboId);
 		free(buffer->vboId);
 		buffer->vboId = 0;
+		++unshadowedChanges;
 	}
 
 	free(buffer);
 	buffer = 0;
 }
 
+unsigned int GAE_VertexBuffer_getUnshadowedChanges(void) {
+	return unshadowedChanges;
+}
+
 GAE_VertexBuffer_t* GAE_VertexBuffer_setInterleaved(GAE_VertexBuffer_t* buffer) {
 	unsigned int vertexSize = 0U;
 	unsigned int index = 0U;
@@ -73,6 +73,7 @@ typedef struct GAE_VertexBuffer_s {
 	unsigned int stride;
 	unsigned int offset;
 	unsigned int* vboId;
+	GAE_BOOL owned; /* data is freed with the buffer */
 	GAE_VertexBuffer_Type type;
 	GAE_VertexBuffer_Format_t format[GAE_VERTEXBUFFER_FORMAT_SIZE];
 	GAE_VertexBuffer_UpdateData_t* updateData;
@@ -81,10 +82,16 @@ typedef struct GAE_VertexBuffer_s {
 GAE_VertexBuffer_Format_t GAE_VertexBuffer_Format_create(const GAE_VertexBuffer_FormatType type, unsigned int offset);
 
 GAE_VertexBuffer_t* GAE_VertexBuffer_create(GAE_BYTE* const data, const unsigned int size, const GAE_VertexBuffer_Type type);
+/* Wraps data without copying it - it must outlive the buffer, and is not freed with it. */
+GAE_VertexBuffer_t* GAE_VertexBuffer_createNotOwned(GAE_BYTE* const data, const unsigned int size, const GAE_VertexBuffer_Type type);
 GAE_VertexBuffer_t* GAE_VertexBuffer_createWithFormat(GAE_BYTE* const data, const unsigned int size, const GAE_VertexBuffer_Type type, const GAE_VertexBuffer_Format_t format[]);
 GAE_VertexBuffer_t* GAE_VertexBuffer_clone(GAE_VertexBuffer_t* buffer);
 void GAE_VertexBuffer_delete(GAE_VertexBuffer_t* buffer);
 
+/* Counts the uploaded vertex buffers deleted - GL unbinds them and may hand their names straight out again,
+ * so the render state drops its buffer shadow whenever this has moved on since it last looked. */
+unsigned int GAE_VertexBuffer_getUnshadowedChanges(void);
+
 GAE_VertexBuffer_t* GAE_VertexBuffer_setInterleaved(GAE_VertexBuffer_t* buffer);
 GAE_VertexBuffer_t* GAE_VertexBuffer_addFormatIdentifier(GAE_VertexBuffer_t* buffer, const GAE_VertexBuffer_FormatType type, const unsigned int amount);
 
@@ -0,0 +1,52 @@
+#include "MockRenderWindow.h"
+#include <stdlib.h>
+
+GAE_RenderWindow_t* GAE_RenderWindow_create(char* const name, const unsigned int width, const unsigned int height, const unsigned int bpp, const GAE_BOOL fullscreen) {
+	GAE_RenderWindow_t* window = malloc(sizeof(GAE_RenderWindow_t));
+	GAE_Mock_RenderWindow_t* mockWindow = malloc(sizeof(GAE_Mock_RenderWindow_t));
+
+	window->name = name;
+	window->width = width;
+	window->height = height;
+	window->bpp = bpp;
+	window->isFullscreen = fullscreen;
+
+	mockWindow->isOpen = GAE_FALSE;
+	mockWindow->refreshCount = 0U;
+
+	window->platform = (void*)mockWindow;
+
+	return window;
+}
+
+GAE_RenderWindow_t* GAE_RenderWindow_open(GAE_RenderWindow_t* window) {
+	GAE_Mock_RenderWindow_t* mockWindow = (GAE_Mock_RenderWindow_t*)window->platform;
+	mockWindow->isOpen = GAE_TRUE;
+
+	return window;
+}
+
+GAE_RenderWindow_t* GAE_RenderWindow_refresh(GAE_RenderWindow_t* window) {
+	GAE_Mock_RenderWindow_t* mockWindow = (GAE_Mock_RenderWindow_t*)window->platform;
+	++mockWindow->refreshCount;
+
+	return window;
+}
+
+GAE_RenderWindow_t* GAE_RenderWindow_close(GAE_RenderWindow_t* window) {
+	GAE_Mock_RenderWindow_t* mockWindow = (GAE_Mock_RenderWindow_t*)window->platform;
+	mockWindow->isOpen = GAE_FALSE;
+
+	return window;
+}
+
+void GAE_RenderWindow_delete(GAE_RenderWindow_t* window) {
+	GAE_Mock_RenderWindow_t* mockWindow = (GAE_Mock_RenderWindow_t*)window->platform;
+	GAE_RenderWindow_close(window);
+
+	free(mockWindow);
+	mockWindow = 0;
+
+	free(window);
+	window = 0;
+}
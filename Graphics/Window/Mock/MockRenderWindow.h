@@ -0,0 +1,12 @@
+#ifndef _MOCK_RENDER_WINDOW_H_
+#define _MOCK_RENDER_WINDOW_H_
+
+#include "../RenderWindow.h"
+
+/* Headless window - there's nothing to display, so we only track whether it's been opened */
+typedef struct GAE_Mock_RenderWindow_s {
+	GAE_BOOL isOpen;
+	unsigned int refreshCount;
+} GAE_Mock_RenderWindow_t;
+
+#endif
@@ -24,6 +24,8 @@ void GAE_RenderWindow_delete(GAE_RenderWindow_t* window);
 #include "X11/X11RenderWindow.h"
 #elif defined(ANDROID)
 #include "Android/AndroidRenderWindow.h"
+#elif defined(MOCKGL)
+#include "Mock/MockRenderWindow.h"
 #endif
 
 #endif
@@ -0,0 +1,228 @@
+/* Renderer test - draws meshes through GAE_Renderer_drawMesh on the headless mock GL and checks the calls it recorded,
+ * including that a buffer deleted and replaced under a reused name, and a shader reloaded in place, still reach GL.
+ * Prints each failed check and exits non zero if there were any.
+ * Usage: renderertest
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "../../GAE_Types.h"
+#include "../../File/File.h"
+#include "../../Graphics/IndexBuffer.h"
+#include "../../Graphics/Material.h"
+#include "../../Graphics/Mesh.h"
+#include "../../Graphics/Shader.h"
+#include "../../Graphics/VertexBuffer.h"
+#include "../../Graphics/Renderer/Renderer.h"
+#include "../../Graphics/Context/Mock/MockGL.h"
+#include "../../Utils/Array.h"
+#include "../../Utils/HashString.h"
+
+static unsigned int failures = 0U;
+
+static void check(const GAE_BOOL isPassing, const char* test, const char* what);
+static GAE_Mesh_t* createMesh(GAE_Shader_t* const shader);
+static void deleteMesh(GAE_Mesh_t* mesh);
+static GAE_Shader_t* createShader(GAE_Shader_t* const reloading, const float scale);
+static unsigned int countCommands(const GAE_MockGL_CommandType type, const unsigned int param);
+static void testDraw(void);
+static void testDeletedBuffers(void);
+static void testReloadedShader(void);
+
+int main(void) {
+	testDraw();
+	testDeletedBuffers();
+	testReloadedShader();
+
+	if (0U < failures) {
+		printf("%u checks failed\n", failures);
+		return 1;
+	}
+
+	printf("All checks passed\n");
+	return 0;
+}
+
+void check(const GAE_BOOL isPassing, const char* test, const char* what) {
+	if (GAE_FALSE == isPassing) {
+		printf("%s: %s\n", test, what);
+		++failures;
+	}
+}
+
+GAE_Mesh_t* createMesh(GAE_Shader_t* const shader) {
+	float vertexData[20] = {
+		-0.5F, 0.5F, 0.0F,
+		0.5F, 0.5F, 0.0F,
+		0.5F, -0.5F, 0.0F,
+		-0.5F, -0.5F, 0.0F,
+		0.0F, 1.0F,
+		1.0F, 1.0F,
+		1.0F, 0.0F,
+		0.0F, 0.0F};
+	unsigned short indexData[6] = { 0, 3, 2, 2, 1, 0 };
+	GAE_VertexBuffer_t* vBuffer = GAE_VertexBuffer_create((GAE_BYTE*)vertexData, sizeof(vertexData), GAE_VERTEXBUFFER_TYPE_STATIC);
+	GAE_IndexBuffer_t* iBuffer = GAE_IndexBuffer_create((GAE_BYTE*)indexData, 6U, GAE_INDEXBUFFER_INDEX_UNSIGNED_SHORT, GAE_INDEXBUFFER_FORMAT_TRIANGLES, GAE_INDEXBUFFER_DRAW_STATIC);
+	GAE_Material_t* material = GAE_Material_create();
+
+	material->shader = shader;
+	GAE_VertexBuffer_addFormatIdentifier(vBuffer, GAE_VERTEXBUFFER_FORMAT_POSITION_3F, 4U);
+	GAE_VertexBuffer_addFormatIdentifier(vBuffer, GAE_VERTEXBUFFER_FORMAT_TEXTURE_2F, 4U);
+
+	return GAE_Mesh_create(vBuffer, iBuffer, material);
+}
+
+void deleteMesh(GAE_Mesh_t* mesh) {
+	GAE_VertexBuffer_delete(mesh->vBuffer);
+	GAE_IndexBuffer_delete(mesh->iBuffer);
+	GAE_Material_delete(mesh->material);
+	GAE_Mesh_delete(mesh);
+}
+
+GAE_Shader_t* createShader(GAE_Shader_t* const reloading, const float scale) {
+	GAE_File_t* vFile = GAE_File_create("test vertex shader");
+	GAE_File_t* fFile = GAE_File_create("test fragment shader");
+	GAE_Shader_t* shader = reloading;
+	char vSource[512];
+	char fSource[512];
+
+	snprintf(vSource, sizeof(vSource), "attribute vec4 a_position;\nattribute vec2 a_texCoord0;\nvarying vec2 v_texCoord0;\nuniform mat4 u_mvp;\nvoid main() {\ngl_Position = u_mvp * a_position * %f;\nv_texCoord0 = a_texCoord0;\n}\n", (double)scale);
+	snprintf(fSource, sizeof(fSource), "varying vec2 v_texCoord0;\nuniform sampler2D s_texture0;\nvoid main() {\ngl_FragColor = texture2D(s_texture0, v_texCoord0);\n}\n");
+	GAE_File_setBuffer(vFile, (GAE_BYTE*)vSource, strlen(vSource) + 1U, GAE_FILE_BUFFER_NOT_OWNED, 0);
+	GAE_File_setBuffer(fFile, (GAE_BYTE*)fSource, strlen(fSource) + 1U, GAE_FILE_BUFFER_NOT_OWNED, 0);
+	if (0 == shader)
+		shader = GAE_Shader_create(vFile, fFile);
+	else
+		GAE_Shader_reload(shader, vFile, fFile);
+
+	GAE_File_delete(vFile);
+	GAE_File_delete(fFile);
+	return shader;
+}
+
+unsigned int countCommands(const GAE_MockGL_CommandType type, const unsigned int param) {
+	GAE_Array_t* log = GAE_MockGL_getCommandLog();
+	unsigned int count = 0U;
+	unsigned int index = 0U;
+
+	/* param matches the call's first argument - its target, mode or name - so calls of one kind can be told apart */
+	for (index = 0U; index < GAE_Array_length(log); ++index) {
+		const GAE_MockGL_Command_t* const command = (GAE_MockGL_Command_t*)GAE_Array_get(log, index);
+		if ((type == command->type) && (param == command->params[0]))
+			++count;
+	}
+
+	return count;
+}
+
+void testDraw(void) {
+	const char* test = "Draw";
+	GAE_Renderer_t* renderer = 0;
+	GAE_Shader_t* shader = 0;
+	GAE_Mesh_t* mesh = 0;
+	GAE_Matrix4_t transform;
+	GLint binding = 0;
+
+	GAE_MockGL_reset();
+	renderer = GAE_Renderer_create();
+	shader = createShader(0, 1.0F);
+	mesh = createMesh(shader);
+	memset(transform, 0, sizeof(GAE_Matrix4_t));
+	GAE_MockGL_endFrame();
+
+	/* the first draw uploads both buffers, so everything it needs should be in the log */
+	GAE_Renderer_drawMesh(renderer, mesh, &transform);
+	check((1U == countCommands(GAE_MOCKGL_COMMAND_USE_PROGRAM, shader->program)) ? GAE_TRUE : GAE_FALSE, test, "the shader's program wasn't used once");
+	check((1U == countCommands(GAE_MOCKGL_COMMAND_BUFFER_DATA, GL_ARRAY_BUFFER)) ? GAE_TRUE : GAE_FALSE, test, "the vertex buffer wasn't uploaded once");
+	check((1U == countCommands(GAE_MOCKGL_COMMAND_BUFFER_DATA, GL_ELEMENT_ARRAY_BUFFER)) ? GAE_TRUE : GAE_FALSE, test, "the index buffer wasn't uploaded once");
+	check((1U == countCommands(GAE_MOCKGL_COMMAND_DRAW_ELEMENTS, GL_TRIANGLES)) ? GAE_TRUE : GAE_FALSE, test, "the mesh wasn't drawn once as triangles");
+	check((6U == GAE_MockGL_getFrameStats()->vertices) ? GAE_TRUE : GAE_FALSE, test, "the draw didn't cover all six indices");
+	glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &binding);
+	check((*mesh->vBuffer->vboId == (GLuint)binding) ? GAE_TRUE : GAE_FALSE, test, "the vertex buffer isn't left bound");
+	check((GL_NO_ERROR == glGetError()) ? GAE_TRUE : GAE_FALSE, test, "GL reported an error");
+
+	/* drawing it again needs no program, binds or uploads - only the draw */
+	GAE_MockGL_endFrame();
+	GAE_Renderer_drawMesh(renderer, mesh, &transform);
+	check((0U == countCommands(GAE_MOCKGL_COMMAND_USE_PROGRAM, shader->program)) ? GAE_TRUE : GAE_FALSE, test, "the program was used again");
+	check((0U == countCommands(GAE_MOCKGL_COMMAND_BIND_BUFFER, GL_ARRAY_BUFFER)) ? GAE_TRUE : GAE_FALSE, test, "the vertex buffer was bound again");
+	check((0U == countCommands(GAE_MOCKGL_COMMAND_BUFFER_DATA, GL_ARRAY_BUFFER)) ? GAE_TRUE : GAE_FALSE, test, "the vertex buffer was uploaded again");
+	check((1U == countCommands(GAE_MOCKGL_COMMAND_DRAW_ELEMENTS, GL_TRIANGLES)) ? GAE_TRUE : GAE_FALSE, test, "the mesh wasn't drawn again");
+	check((GL_NO_ERROR == glGetError()) ? GAE_TRUE : GAE_FALSE, test, "GL reported an error on the second draw");
+
+	deleteMesh(mesh);
+	GAE_Shader_delete(shader);
+	GAE_Renderer_delete(renderer);
+}
+
+void testDeletedBuffers(void) {
+	const char* test = "Deleted buffers";
+	GAE_Renderer_t* renderer = 0;
+	GAE_Shader_t* shader = 0;
+	GAE_Mesh_t* mesh = 0;
+	GAE_Matrix4_t transform;
+	GLuint vertexName = 0U;
+	GLuint indexName = 0U;
+
+	GAE_MockGL_reset();
+	renderer = GAE_Renderer_create();
+	shader = createShader(0, 1.0F);
+	mesh = createMesh(shader);
+	memset(transform, 0, sizeof(GAE_Matrix4_t));
+	GAE_Renderer_drawMesh(renderer, mesh, &transform);
+	vertexName = *mesh->vBuffer->vboId;
+	indexName = *mesh->iBuffer->vboId;
+
+	/* the replacement gets the deleted buffers' names back, which the render state must not take as still bound */
+	deleteMesh(mesh);
+	mesh = createMesh(shader);
+	GAE_MockGL_endFrame();
+	GAE_Renderer_drawMesh(renderer, mesh, &transform);
+	/* a replacement allocated where the old buffer was can be taken for it outright, and never be created at all */
+	check(((0 != mesh->vBuffer->vboId) && (vertexName == *mesh->vBuffer->vboId)) ? GAE_TRUE : GAE_FALSE, test, "the new vertex buffer wasn't created under the old name");
+	check(((0 != mesh->iBuffer->vboId) && (indexName == *mesh->iBuffer->vboId)) ? GAE_TRUE : GAE_FALSE, test, "the new index buffer wasn't created under the old name");
+	check((1U == countCommands(GAE_MOCKGL_COMMAND_BIND_BUFFER, GL_ARRAY_BUFFER)) ? GAE_TRUE : GAE_FALSE, test, "the new vertex buffer wasn't bound");
+	check((1U == countCommands(GAE_MOCKGL_COMMAND_BIND_BUFFER, GL_ELEMENT_ARRAY_BUFFER)) ? GAE_TRUE : GAE_FALSE, test, "the new index buffer wasn't bound");
+	check((1U == countCommands(GAE_MOCKGL_COMMAND_BUFFER_DATA, GL_ARRAY_BUFFER)) ? GAE_TRUE : GAE_FALSE, test, "the new vertex buffer wasn't uploaded");
+	check((1U == countCommands(GAE_MOCKGL_COMMAND_DRAW_ELEMENTS, GL_TRIANGLES)) ? GAE_TRUE : GAE_FALSE, test, "the new mesh wasn't drawn");
+	check((GL_NO_ERROR == glGetError()) ? GAE_TRUE : GAE_FALSE, test, "GL reported an error");
+
+	deleteMesh(mesh);
+	GAE_Shader_delete(shader);
+	GAE_Renderer_delete(renderer);
+}
+
+void testReloadedShader(void) {
+	const char* test = "Reloaded shader";
+	GAE_Renderer_t* renderer = 0;
+	GAE_Shader_t* shader = 0;
+	GAE_Mesh_t* mesh = 0;
+	GAE_Matrix4_t transform;
+	GLuint oldProgram = 0U;
+	GLint current = 0;
+
+	GAE_MockGL_reset();
+	renderer = GAE_Renderer_create();
+	shader = createShader(0, 1.0F);
+	mesh = createMesh(shader);
+	memset(transform, 0, sizeof(GAE_Matrix4_t));
+	GAE_Renderer_drawMesh(renderer, mesh, &transform);
+	oldProgram = shader->program;
+
+	/* the shader keeps its pointer, so only its new program tells the render state anything changed */
+	createShader(shader, 2.0F);
+	GAE_MockGL_endFrame();
+	GAE_Renderer_drawMesh(renderer, mesh, &transform);
+	glGetIntegerv(GL_CURRENT_PROGRAM, &current);
+	check((oldProgram != shader->program) ? GAE_TRUE : GAE_FALSE, test, "the reload didn't link a new program");
+	check((1U == countCommands(GAE_MOCKGL_COMMAND_USE_PROGRAM, shader->program)) ? GAE_TRUE : GAE_FALSE, test, "the new program wasn't used");
+	check((shader->program == (GLuint)current) ? GAE_TRUE : GAE_FALSE, test, "the new program isn't current");
+	check((1U == countCommands(GAE_MOCKGL_COMMAND_VERTEX_ATTRIB_POINTER, (GLuint)GAE_Shader_getAttribute(shader, GAE_HashString_create("a_position")))) ? GAE_TRUE : GAE_FALSE, test, "the position attribute wasn't set up again");
+	check((1U == countCommands(GAE_MOCKGL_COMMAND_DRAW_ELEMENTS, GL_TRIANGLES)) ? GAE_TRUE : GAE_FALSE, test, "the mesh wasn't drawn");
+	check((GL_NO_ERROR == glGetError()) ? GAE_TRUE : GAE_FALSE, test, "GL reported an error");
+
+	deleteMesh(mesh);
+	GAE_Shader_delete(shader);
+	GAE_Renderer_delete(renderer);
+}
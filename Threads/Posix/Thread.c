@@ -0,0 +1,138 @@
+#include "../Thread.h"
+
+#if __STDC_VERSION__ >= 199901L
+#define _XOPEN_SOURCE 600
+#else
+#define _XOPEN_SOURCE 500
+#endif
+
+#include <stdlib.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+static void* threadEntry(void* userData);
+
+GAE_Thread_t* GAE_Thread_create(GAE_Thread_Function_t function, void* userData) {
+	GAE_Thread_t* thread = malloc(sizeof(GAE_Thread_t));
+	pthread_t* posixThread = malloc(sizeof(pthread_t));
+
+	thread->function = function;
+	thread->userData = userData;
+	thread->isRunning = GAE_TRUE;
+	thread->platformData = posixThread;
+
+	if (0 != pthread_create(posixThread, 0, threadEntry, thread)) {
+		free(posixThread);
+		free(thread);
+		return 0;
+	}
+
+	return thread;
+}
+
+GAE_Thread_t* GAE_Thread_join(GAE_Thread_t* thread) {
+	if (GAE_TRUE == thread->isRunning) {
+		pthread_join(*(pthread_t*)thread->platformData, 0);
+		thread->isRunning = GAE_FALSE;
+	}
+
+	return thread;
+}
+
+unsigned int GAE_Thread_getHardwareCount(void) {
+	const long count = sysconf(_SC_NPROCESSORS_ONLN);
+	return (0L < count) ? (unsigned int)count : 1U;
+}
+
+void GAE_Thread_delete(GAE_Thread_t* thread) {
+	GAE_Thread_join(thread);
+	free(thread->platformData);
+	free(thread);
+	thread = 0;
+}
+
+void GAE_Thread_sleep(const unsigned int microseconds) {
+	struct timespec time;
+
+	time.tv_sec = (time_t)(microseconds / 1000000U);
+	time.tv_nsec = (long)(microseconds % 1000000U) * 1000L;
+	while (0 != nanosleep(&time, &time));
+}
+
+unsigned int GAE_Atomic_exchange(volatile unsigned int* target, const unsigned int value) {
+	return __atomic_exchange_n(target, value, __ATOMIC_ACQ_REL);
+}
+
+unsigned int GAE_Atomic_load(volatile unsigned int* const target) {
+	return __atomic_load_n(target, __ATOMIC_ACQUIRE);
+}
+
+void GAE_Atomic_store(volatile unsigned int* target, const unsigned int value) {
+	__atomic_store_n(target, value, __ATOMIC_RELEASE);
+}
+
+GAE_Mutex_t* GAE_Mutex_create(void) {
+	GAE_Mutex_t* mutex = malloc(sizeof(GAE_Mutex_t));
+	pthread_mutex_t* posixMutex = malloc(sizeof(pthread_mutex_t));
+
+	pthread_mutex_init(posixMutex, 0);
+	mutex->platformData = posixMutex;
+
+	return mutex;
+}
+
+GAE_Mutex_t* GAE_Mutex_lock(GAE_Mutex_t* mutex) {
+	pthread_mutex_lock((pthread_mutex_t*)mutex->platformData);
+	return mutex;
+}
+
+GAE_Mutex_t* GAE_Mutex_unlock(GAE_Mutex_t* mutex) {
+	pthread_mutex_unlock((pthread_mutex_t*)mutex->platformData);
+	return mutex;
+}
+
+void GAE_Mutex_delete(GAE_Mutex_t* mutex) {
+	pthread_mutex_destroy((pthread_mutex_t*)mutex->platformData);
+	free(mutex->platformData);
+	free(mutex);
+	mutex = 0;
+}
+
+GAE_Condition_t* GAE_Condition_create(void) {
+	GAE_Condition_t* condition = malloc(sizeof(GAE_Condition_t));
+	pthread_cond_t* posixCondition = malloc(sizeof(pthread_cond_t));
+
+	pthread_cond_init(posixCondition, 0);
+	condition->platformData = posixCondition;
+
+	return condition;
+}
+
+GAE_Condition_t* GAE_Condition_wait(GAE_Condition_t* condition, GAE_Mutex_t* mutex) {
+	pthread_cond_wait((pthread_cond_t*)condition->platformData, (pthread_mutex_t*)mutex->platformData);
+	return condition;
+}
+
+GAE_Condition_t* GAE_Condition_signal(GAE_Condition_t* condition) {
+	pthread_cond_signal((pthread_cond_t*)condition->platformData);
+	return condition;
+}
+
+GAE_Condition_t* GAE_Condition_broadcast(GAE_Condition_t* condition) {
+	pthread_cond_broadcast((pthread_cond_t*)condition->platformData);
+	return condition;
+}
+
+void GAE_Condition_delete(GAE_Condition_t* condition) {
+	pthread_cond_destroy((pthread_cond_t*)condition->platformData);
+	free(condition->platformData);
+	free(condition);
+	condition = 0;
+}
+
+void* threadEntry(void* userData) {
+	GAE_Thread_t* thread = (GAE_Thread_t*)userData;
+	thread->function(thread->userData);
+	return 0;
+}
@@ -0,0 +1,74 @@
+#ifndef _THREAD_H_
+#define _THREAD_H_
+
+#include "../GAE_Types.h"
+
+typedef void (*GAE_Thread_Function_t)(void* userData);
+
+typedef struct GAE_Thread_s {
+	GAE_Thread_Function_t function;
+	void* userData;
+	GAE_BOOL isRunning;
+	void* platformData;
+} GAE_Thread_t;
+
+typedef struct GAE_Mutex_s {
+	void* platformData;
+} GAE_Mutex_t;
+
+typedef struct GAE_Condition_s {
+	void* platformData;
+} GAE_Condition_t;
+
+/* Creates and starts a new thread running function(userData). */
+GAE_Thread_t* GAE_Thread_create(GAE_Thread_Function_t function, void* userData);
+
+/* Waits for the thread function to return. */
+GAE_Thread_t* GAE_Thread_join(GAE_Thread_t* thread);
+
+/* Returns the amount of hardware threads available, at least 1. */
+unsigned int GAE_Thread_getHardwareCount(void);
+
+/* Joins the thread if it is still running and deletes it. */
+void GAE_Thread_delete(GAE_Thread_t* thread);
+
+/* Puts the calling thread to sleep for at least microseconds. */
+void GAE_Thread_sleep(const unsigned int microseconds);
+
+/* Stores value in target and returns what it held, as one atomic step - writes before it are seen by whoever reads value, as are their writes before it by us. */
+unsigned int GAE_Atomic_exchange(volatile unsigned int* target, const unsigned int value);
+
+/* Reads target atomically, seeing every write made before the value was stored. */
+unsigned int GAE_Atomic_load(volatile unsigned int* const target);
+
+/* Writes value to target atomically, publishing every write made before it. */
+void GAE_Atomic_store(volatile unsigned int* target, const unsigned int value);
+
+/* Creates a new non-recursive mutex. */
+GAE_Mutex_t* GAE_Mutex_create(void);
+
+/* Blocks until the mutex is owned by the calling thread. */
+GAE_Mutex_t* GAE_Mutex_lock(GAE_Mutex_t* mutex);
+
+/* Releases the mutex. */
+GAE_Mutex_t* GAE_Mutex_unlock(GAE_Mutex_t* mutex);
+
+/* Deletes the mutex - it must not be locked. */
+void GAE_Mutex_delete(GAE_Mutex_t* mutex);
+
+/* Creates a new condition variable. */
+GAE_Condition_t* GAE_Condition_create(void);
+
+/* Atomically releases the locked mutex and sleeps until signalled - the mutex is locked again on return. Spurious wakeups are possible. */
+GAE_Condition_t* GAE_Condition_wait(GAE_Condition_t* condition, GAE_Mutex_t* mutex);
+
+/* Wakes a single waiting thread. */
+GAE_Condition_t* GAE_Condition_signal(GAE_Condition_t* condition);
+
+/* Wakes every waiting thread. */
+GAE_Condition_t* GAE_Condition_broadcast(GAE_Condition_t* condition);
+
+/* Deletes the condition variable - no thread may be waiting on it. */
+void GAE_Condition_delete(GAE_Condition_t* condition);
+
+#endif
@@ -0,0 +1,129 @@
+#include "../Thread.h"
+
+#include <stdlib.h>
+#include <Windows.h>
+
+static DWORD WINAPI threadEntry(LPVOID userData);
+
+GAE_Thread_t* GAE_Thread_create(GAE_Thread_Function_t function, void* userData) {
+	GAE_Thread_t* thread = (GAE_Thread_t*)malloc(sizeof(GAE_Thread_t));
+	HANDLE handle = 0;
+
+	thread->function = function;
+	thread->userData = userData;
+	thread->isRunning = GAE_TRUE;
+	thread->platformData = 0;
+
+	handle = CreateThread(0, 0, threadEntry, thread, 0, 0);
+	if (0 == handle) {
+		free(thread);
+		return 0;
+	}
+
+	thread->platformData = handle;
+	return thread;
+}
+
+GAE_Thread_t* GAE_Thread_join(GAE_Thread_t* thread) {
+	if (GAE_TRUE == thread->isRunning) {
+		WaitForSingleObject((HANDLE)thread->platformData, INFINITE);
+		thread->isRunning = GAE_FALSE;
+	}
+
+	return thread;
+}
+
+unsigned int GAE_Thread_getHardwareCount(void) {
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return (0 < info.dwNumberOfProcessors) ? (unsigned int)info.dwNumberOfProcessors : 1U;
+}
+
+void GAE_Thread_delete(GAE_Thread_t* thread) {
+	GAE_Thread_join(thread);
+	CloseHandle((HANDLE)thread->platformData);
+	free(thread);
+	thread = 0;
+}
+
+void GAE_Thread_sleep(const unsigned int microseconds) {
+	/* Sleep only takes milliseconds - round up, as callers asked for at least this long */
+	Sleep((DWORD)((microseconds + 999U) / 1000U));
+}
+
+unsigned int GAE_Atomic_exchange(volatile unsigned int* target, const unsigned int value) {
+	return (unsigned int)InterlockedExchange((volatile LONG*)target, (LONG)value);
+}
+
+unsigned int GAE_Atomic_load(volatile unsigned int* const target) {
+	return (unsigned int)InterlockedCompareExchange((volatile LONG*)target, 0, 0);
+}
+
+void GAE_Atomic_store(volatile unsigned int* target, const unsigned int value) {
+	InterlockedExchange((volatile LONG*)target, (LONG)value);
+}
+
+GAE_Mutex_t* GAE_Mutex_create(void) {
+	GAE_Mutex_t* mutex = (GAE_Mutex_t*)malloc(sizeof(GAE_Mutex_t));
+	CRITICAL_SECTION* section = (CRITICAL_SECTION*)malloc(sizeof(CRITICAL_SECTION));
+
+	InitializeCriticalSection(section);
+	mutex->platformData = section;
+
+	return mutex;
+}
+
+GAE_Mutex_t* GAE_Mutex_lock(GAE_Mutex_t* mutex) {
+	EnterCriticalSection((CRITICAL_SECTION*)mutex->platformData);
+	return mutex;
+}
+
+GAE_Mutex_t* GAE_Mutex_unlock(GAE_Mutex_t* mutex) {
+	LeaveCriticalSection((CRITICAL_SECTION*)mutex->platformData);
+	return mutex;
+}
+
+void GAE_Mutex_delete(GAE_Mutex_t* mutex) {
+	DeleteCriticalSection((CRITICAL_SECTION*)mutex->platformData);
+	free(mutex->platformData);
+	free(mutex);
+	mutex = 0;
+}
+
+GAE_Condition_t* GAE_Condition_create(void) {
+	GAE_Condition_t* condition = (GAE_Condition_t*)malloc(sizeof(GAE_Condition_t));
+	CONDITION_VARIABLE* variable = (CONDITION_VARIABLE*)malloc(sizeof(CONDITION_VARIABLE));
+
+	InitializeConditionVariable(variable);
+	condition->platformData = variable;
+
+	return condition;
+}
+
+GAE_Condition_t* GAE_Condition_wait(GAE_Condition_t* condition, GAE_Mutex_t* mutex) {
+	SleepConditionVariableCS((CONDITION_VARIABLE*)condition->platformData, (CRITICAL_SECTION*)mutex->platformData, INFINITE);
+	return condition;
+}
+
+GAE_Condition_t* GAE_Condition_signal(GAE_Condition_t* condition) {
+	WakeConditionVariable((CONDITION_VARIABLE*)condition->platformData);
+	return condition;
+}
+
+GAE_Condition_t* GAE_Condition_broadcast(GAE_Condition_t* condition) {
+	WakeAllConditionVariable((CONDITION_VARIABLE*)condition->platformData);
+	return condition;
+}
+
+void GAE_Condition_delete(GAE_Condition_t* condition) {
+	/* Win32 condition variables need no destruction */
+	free(condition->platformData);
+	free(condition);
+	condition = 0;
+}
+
+DWORD WINAPI threadEntry(LPVOID userData) {
+	GAE_Thread_t* thread = (GAE_Thread_t*)userData;
+	thread->function(thread->userData);
+	return 0;
+}
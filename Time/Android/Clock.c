@@ -7,6 +7,7 @@
 #endif
 
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 
 typedef struct GAE_Clock_Linux_s {
@@ -38,6 +39,17 @@ GAE_Clock_t* GAE_Clock_create(void) {
 	return clock;
 }
 
+GAE_Clock_t* GAE_Clock_clone(GAE_Clock_t* const clock) {
+	GAE_Clock_t* newClock = malloc(sizeof(GAE_Clock_t));
+	GAE_Clock_Linux_t* linuxClock = malloc(sizeof(GAE_Clock_Linux_t));
+
+	memcpy(newClock, clock, sizeof(GAE_Clock_t));
+	memcpy(linuxClock, clock->platformData, sizeof(GAE_Clock_Linux_t));
+	newClock->platformData = linuxClock;
+
+	return newClock;
+}
+
 void GAE_Clock_delete(GAE_Clock_t* clock) {
 	free(clock->platformData);
 	free(clock);
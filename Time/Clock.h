@@ -11,6 +11,7 @@ typedef struct GAE_Clock_s {
 } GAE_Clock_t;
 
 GAE_Clock_t* GAE_Clock_create(void);
+GAE_Clock_t* GAE_Clock_clone(GAE_Clock_t* const clock);
 GAE_Clock_t* GAE_Clock_reset(GAE_Clock_t* clock);
 GAE_Clock_t* GAE_Clock_update(GAE_Clock_t* clock);
 GAE_Clock_t* GAE_Clock_pause(GAE_Clock_t* clock);
@@ -0,0 +1,343 @@
+#include "Simulation.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Clock.h"
+#include "../Maths/Matrix.h"
+#include "../Threads/Thread.h"
+#include "../Utils/TripleBuffer.h"
+
+static void threadMain(void* userData);
+static float runTicks(GAE_Simulation_t* simulation, GAE_Clock_t* clock);
+static void blendMatrix(GAE_Matrix4_t out, const GAE_Matrix4_t from, const GAE_Matrix4_t to, const float alpha);
+
+GAE_Snapshot_t* GAE_Snapshot_create(const unsigned int entityCapacity) {
+	GAE_Snapshot_t* snapshot = malloc(sizeof(GAE_Snapshot_t));
+
+	snapshot->tick = 0U;
+	snapshot->time = 0.0F;
+	snapshot->publishTime = 0.0F;
+	snapshot->tickTime = 0.0F;
+	snapshot->busyTime = 0.0F;
+	snapshot->droppedTicks = 0U;
+	GAE_Matrix4_setToIdentity(&snapshot->camera);
+	snapshot->entities = malloc(sizeof(GAE_Snapshot_Entity_t) * ((0U < entityCapacity) ? entityCapacity : 1U));
+	snapshot->entityCount = 0U;
+	snapshot->entityCapacity = entityCapacity;
+
+	return snapshot;
+}
+
+GAE_Snapshot_Entity_t* GAE_Snapshot_add(GAE_Snapshot_t* snapshot, const unsigned int id, const unsigned int frame, const GAE_Matrix4_t transform) {
+	GAE_Snapshot_Entity_t* entity = 0;
+
+	if (snapshot->entityCount == snapshot->entityCapacity)
+		return 0;
+
+	entity = snapshot->entities + snapshot->entityCount++;
+	entity->id = id;
+	entity->frame = frame;
+	memcpy(entity->transform, transform, sizeof(GAE_Matrix4_t));
+
+	return entity;
+}
+
+GAE_Snapshot_t* GAE_Snapshot_copy(GAE_Snapshot_t* snapshot, GAE_Snapshot_t* const source) {
+	snapshot->tick = source->tick;
+	snapshot->time = source->time;
+	snapshot->publishTime = source->publishTime;
+	snapshot->tickTime = source->tickTime;
+	snapshot->busyTime = source->busyTime;
+	snapshot->droppedTicks = source->droppedTicks;
+	memcpy(snapshot->camera, source->camera, sizeof(GAE_Matrix4_t));
+	snapshot->entityCount = (source->entityCount < snapshot->entityCapacity) ? source->entityCount : snapshot->entityCapacity;
+	memcpy(snapshot->entities, source->entities, sizeof(GAE_Snapshot_Entity_t) * snapshot->entityCount);
+
+	return snapshot;
+}
+
+void GAE_Snapshot_delete(GAE_Snapshot_t* snapshot) {
+	free(snapshot->entities);
+	free(snapshot);
+	snapshot = 0;
+}
+
+GAE_Simulation_t* GAE_Simulation_create(const float ticksPerSecond, const unsigned int entityCapacity, GAE_Simulation_Tick_t tick, void* userData) {
+	GAE_Simulation_t* simulation = malloc(sizeof(GAE_Simulation_t));
+	unsigned int index = 0U;
+
+	simulation->tick = tick;
+	simulation->userData = userData;
+	simulation->interval = (0.0F < ticksPerSecond) ? 1.0F / ticksPerSecond : 1.0F / 60.0F;
+	for (index = 0U; index < 3U; ++index)
+		simulation->snapshots[index] = GAE_Snapshot_create(entityCapacity);
+	simulation->previous = GAE_Snapshot_create(entityCapacity);
+	simulation->buffer = GAE_TripleBuffer_create();
+	simulation->clock = GAE_Clock_create();
+	simulation->tickClock = 0;
+	simulation->thread = 0;
+	simulation->isRunning = 0U;
+	simulation->isThreaded = GAE_FALSE;
+	simulation->hasSnapshot = GAE_FALSE;
+	simulation->nextTick = 0U;
+	simulation->nextTickTime = 0.0F;
+	simulation->busyTime = 0.0F;
+	simulation->droppedTicks = 0U;
+	simulation->frameStart = -1.0F;
+	GAE_Simulation_resetStats(simulation);
+
+	return simulation;
+}
+
+GAE_Simulation_t* GAE_Simulation_start(GAE_Simulation_t* simulation, const GAE_BOOL isThreaded) {
+	GAE_Simulation_stop(simulation);
+
+	GAE_Clock_reset(simulation->clock);
+	simulation->hasSnapshot = GAE_FALSE;
+	simulation->nextTick = 0U;
+	simulation->nextTickTime = 0.0F;
+	simulation->busyTime = 0.0F;
+	simulation->droppedTicks = 0U;
+	simulation->frameStart = -1.0F;
+	simulation->isThreaded = GAE_FALSE;
+	GAE_Simulation_resetStats(simulation);
+
+	/* anything left over from a previous run is taken and forgotten, so the first snapshot seen is a new one */
+	GAE_TripleBuffer_acquire(simulation->buffer);
+
+	if (GAE_TRUE == isThreaded) {
+		simulation->tickClock = GAE_Clock_clone(simulation->clock);
+		GAE_Atomic_store(&simulation->isRunning, 1U);
+		simulation->thread = GAE_Thread_create(threadMain, simulation);
+		if (0 != simulation->thread)
+			simulation->isThreaded = GAE_TRUE;
+		else {
+			GAE_Atomic_store(&simulation->isRunning, 0U);
+			GAE_Clock_delete(simulation->tickClock);
+			simulation->tickClock = 0;
+		}
+	}
+
+	return simulation;
+}
+
+GAE_Simulation_t* GAE_Simulation_stop(GAE_Simulation_t* simulation) {
+	if (0 == simulation->thread)
+		return simulation;
+
+	GAE_Atomic_store(&simulation->isRunning, 0U);
+	GAE_Thread_delete(simulation->thread);
+	simulation->thread = 0;
+	GAE_Clock_delete(simulation->tickClock);
+	simulation->tickClock = 0;
+	simulation->isThreaded = GAE_FALSE;
+
+	return simulation;
+}
+
+GAE_Snapshot_t* GAE_Simulation_interpolate(GAE_Simulation_t* simulation, GAE_Snapshot_t* out) {
+	GAE_Snapshot_t* current = 0;
+	GAE_Snapshot_t* previous = simulation->previous;
+	float now = 0.0F;
+	float renderTime = 0.0F;
+	float span = 0.0F;
+	float alpha = 1.0F;
+	unsigned int index = 0U;
+
+	if (GAE_FALSE == simulation->isThreaded)
+		runTicks(simulation, simulation->clock);
+
+	GAE_Clock_update(simulation->clock);
+	now = simulation->clock->deltaTime;
+	if (0.0F <= simulation->frameStart) {
+		simulation->frameTimeTotal += now - simulation->frameStart;
+		++simulation->stats.frames;
+	}
+	simulation->frameStart = now;
+
+	/* front goes back to the writer on acquiring, so it's kept first as the older half of the blend */
+	if (GAE_TRUE == GAE_TripleBuffer_isFresh(simulation->buffer)) {
+		if (GAE_TRUE == simulation->hasSnapshot)
+			GAE_Snapshot_copy(previous, simulation->snapshots[GAE_TripleBuffer_getFront(simulation->buffer)]);
+
+		GAE_TripleBuffer_acquire(simulation->buffer);
+		current = simulation->snapshots[GAE_TripleBuffer_getFront(simulation->buffer)];
+
+		if (GAE_FALSE == simulation->hasSnapshot) {
+			GAE_Snapshot_copy(previous, current);
+			simulation->hasSnapshot = GAE_TRUE;
+			simulation->statsTicks = current->tick;
+			simulation->statsBusyTime = current->busyTime - current->tickTime;
+			simulation->statsDroppedTicks = current->droppedTicks;
+		}
+		else {
+			/* dropped ticks were never published, so only the rest count as missed */
+			simulation->stats.missedSnapshots += current->tick - previous->tick - 1U - (current->droppedTicks - previous->droppedTicks);
+		}
+
+		simulation->latencyTotal += now - current->publishTime;
+		++simulation->latencyCount;
+		if (now - current->publishTime > simulation->stats.maxLatency)
+			simulation->stats.maxLatency = now - current->publishTime;
+	}
+
+	if (GAE_FALSE == simulation->hasSnapshot) {
+		out->entityCount = 0U;
+		return out;
+	}
+
+	current = simulation->snapshots[GAE_TripleBuffer_getFront(simulation->buffer)];
+	simulation->stats.ticks = current->tick;
+
+	renderTime = now - simulation->interval;
+	span = current->time - previous->time;
+	if (0.0F < span) {
+		alpha = (renderTime - previous->time) / span;
+		alpha = (alpha < 0.0F) ? 0.0F : ((alpha > 1.0F) ? 1.0F : alpha);
+	}
+
+	GAE_Snapshot_copy(out, current);
+	out->time = previous->time + span * alpha;
+	blendMatrix(out->camera, previous->camera, current->camera, alpha);
+	for (index = 0U; index < out->entityCount; ++index) {
+		GAE_Snapshot_Entity_t* entity = out->entities + index;
+		if ((index < previous->entityCount) && (entity->id == previous->entities[index].id))
+			blendMatrix(entity->transform, previous->entities[index].transform, current->entities[index].transform, alpha);
+	}
+
+	return out;
+}
+
+GAE_Simulation_t* GAE_Simulation_endFrame(GAE_Simulation_t* simulation) {
+	if (0.0F > simulation->frameStart)
+		return simulation;
+
+	GAE_Clock_update(simulation->clock);
+	simulation->renderTimeTotal += simulation->clock->deltaTime - simulation->frameStart;
+	++simulation->renderFrames;
+
+	return simulation;
+}
+
+GAE_Simulation_Stats_t* GAE_Simulation_getStats(GAE_Simulation_t* simulation) {
+	GAE_Simulation_Stats_t* stats = &simulation->stats;
+	const unsigned int frames = (0U < stats->frames) ? stats->frames : 1U;
+
+	stats->tickTime = 0.0F;
+	stats->droppedTicks = 0U;
+	if (GAE_TRUE == simulation->hasSnapshot) {
+		GAE_Snapshot_t* const current = simulation->snapshots[GAE_TripleBuffer_getFront(simulation->buffer)];
+		const unsigned int ticks = current->tick + 1U - simulation->statsTicks - (current->droppedTicks - simulation->statsDroppedTicks);
+
+		if (0U < ticks)
+			stats->tickTime = (current->busyTime - simulation->statsBusyTime) / (float)ticks;
+		stats->droppedTicks = current->droppedTicks - simulation->statsDroppedTicks;
+	}
+
+	stats->tickLoad = stats->tickTime / simulation->interval;
+	stats->frameTime = simulation->frameTimeTotal / (float)frames;
+	stats->renderTime = (0U < simulation->renderFrames) ? simulation->renderTimeTotal / (float)simulation->renderFrames : 0.0F;
+	stats->renderLoad = (0.0F < stats->frameTime) ? stats->renderTime / stats->frameTime : 0.0F;
+	stats->latency = (0U < simulation->latencyCount) ? simulation->latencyTotal / (float)simulation->latencyCount : 0.0F;
+
+	return stats;
+}
+
+GAE_Simulation_t* GAE_Simulation_resetStats(GAE_Simulation_t* simulation) {
+	memset(&simulation->stats, 0, sizeof(GAE_Simulation_Stats_t));
+	simulation->frameTimeTotal = 0.0F;
+	simulation->renderTimeTotal = 0.0F;
+	simulation->renderFrames = 0U;
+	simulation->latencyTotal = 0.0F;
+	simulation->latencyCount = 0U;
+	simulation->statsTicks = 0U;
+	simulation->statsBusyTime = 0.0F;
+	simulation->statsDroppedTicks = 0U;
+
+	/* the next frame starts the count over, as this one's time can't be split */
+	if (0.0F <= simulation->frameStart)
+		simulation->frameStart = -1.0F;
+
+	if (GAE_TRUE == simulation->hasSnapshot) {
+		GAE_Snapshot_t* const current = simulation->snapshots[GAE_TripleBuffer_getFront(simulation->buffer)];
+		simulation->statsTicks = current->tick + 1U;
+		simulation->statsBusyTime = current->busyTime;
+		simulation->statsDroppedTicks = current->droppedTicks;
+	}
+
+	return simulation;
+}
+
+void GAE_Simulation_delete(GAE_Simulation_t* simulation) {
+	unsigned int index = 0U;
+
+	GAE_Simulation_stop(simulation);
+	for (index = 0U; index < 3U; ++index)
+		GAE_Snapshot_delete(simulation->snapshots[index]);
+	GAE_Snapshot_delete(simulation->previous);
+	GAE_TripleBuffer_delete(simulation->buffer);
+	GAE_Clock_delete(simulation->clock);
+	free(simulation);
+	simulation = 0;
+}
+
+void threadMain(void* userData) {
+	GAE_Simulation_t* simulation = (GAE_Simulation_t*)userData;
+
+	while (0U != GAE_Atomic_load(&simulation->isRunning)) {
+		const float wait = runTicks(simulation, simulation->tickClock);
+		if (0.0F < wait)
+			GAE_Thread_sleep((unsigned int)(wait * 1000000.0F));
+	}
+}
+
+float runTicks(GAE_Simulation_t* simulation, GAE_Clock_t* clock) {
+	unsigned int ticks = 0U;
+	float now = GAE_Clock_update(clock)->deltaTime;
+
+	while (now >= simulation->nextTickTime) {
+		GAE_Snapshot_t* snapshot = 0;
+		float start = 0.0F;
+
+		/* too far behind to catch up - skip ahead, so a stall slows the game down rather than locking it up */
+		if (GAE_SIMULATION_MAX_CATCH_UP == ticks) {
+			const unsigned int skipped = (unsigned int)((now - simulation->nextTickTime) / simulation->interval) + 1U;
+			simulation->droppedTicks += skipped;
+			simulation->nextTick += skipped;
+			simulation->nextTickTime += (float)skipped * simulation->interval;
+			break;
+		}
+
+		snapshot = simulation->snapshots[GAE_TripleBuffer_getBack(simulation->buffer)];
+		snapshot->tick = simulation->nextTick;
+		snapshot->time = simulation->nextTickTime;
+		snapshot->entityCount = 0U;
+		GAE_Matrix4_setToIdentity(&snapshot->camera);
+
+		start = now;
+		simulation->tick(snapshot, simulation->interval, simulation->userData);
+		now = GAE_Clock_update(clock)->deltaTime;
+
+		simulation->busyTime += now - start;
+		snapshot->tickTime = now - start;
+		snapshot->busyTime = simulation->busyTime;
+		snapshot->droppedTicks = simulation->droppedTicks;
+		snapshot->publishTime = now;
+		GAE_TripleBuffer_publish(simulation->buffer);
+
+		++simulation->nextTick;
+		simulation->nextTickTime += simulation->interval;
+		++ticks;
+	}
+
+	return simulation->nextTickTime - now;
+}
+
+void blendMatrix(GAE_Matrix4_t out, const GAE_Matrix4_t from, const GAE_Matrix4_t to, const float alpha) {
+	unsigned int index = 0U;
+
+	/* a straight blend is fine for the little a transform turns in one tick */
+	for (index = 0U; index < 16U; ++index)
+		out[index] = from[index] + (to[index] - from[index]) * alpha;
+}
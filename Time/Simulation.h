@@ -0,0 +1,127 @@
+#ifndef _SIMULATION_H_
+#define _SIMULATION_H_
+
+#include "../GAE_Types.h"
+
+/*
+	Fixed tick simulation, decoupled from rendering - either on its own thread, or run inline by the render thread as it needs ticks.
+	Each tick fills a snapshot of what drawing needs - entity transforms, sprite frames and the camera - which is handed
+	to the render thread through a GAE_TripleBuffer, so neither thread ever waits on the other.
+	The render thread draws one tick interval behind the newest snapshot, blending the two either side of that time,
+	so motion stays smooth at any display rate.
+	The tick callback owns the simulation's state; it must not touch GL, and anything else it shares with the render thread needs its own locking.
+*/
+
+struct GAE_Clock_s;
+struct GAE_Thread_s;
+struct GAE_TripleBuffer_s;
+
+typedef struct GAE_Snapshot_Entity_s {
+	unsigned int id;				/* blended with the entity in the same slot of the last snapshot, if it has the same id */
+	unsigned int frame;				/* sprite frame, never blended */
+	GAE_Matrix4_t transform;
+} GAE_Snapshot_Entity_t;
+
+typedef struct GAE_Snapshot_s {
+	unsigned int tick;
+	float time;						/* simulation clock time this state is for */
+	float publishTime;				/* when the simulation handed it over */
+	float tickTime;					/* how long the tick took */
+	float busyTime;					/* total time spent ticking so far */
+	unsigned int droppedTicks;		/* total ticks skipped after falling too far behind */
+	GAE_Matrix4_t camera;
+	GAE_Snapshot_Entity_t* entities;
+	unsigned int entityCount;
+	unsigned int entityCapacity;
+} GAE_Snapshot_t;
+
+/* Advances the simulation by deltaTime and fills snapshot, which arrives with no entities and an identity camera. */
+typedef void (*GAE_Simulation_Tick_t)(GAE_Snapshot_t* snapshot, const float deltaTime, void* userData);
+
+typedef struct GAE_Simulation_Stats_s {
+	unsigned int ticks;				/* newest tick the render thread has seen */
+	unsigned int frames;
+	unsigned int missedSnapshots;	/* published, but replaced before a frame saw them */
+	unsigned int droppedTicks;
+	float tickTime;					/* average time in the tick callback */
+	float tickLoad;					/* share of each tick interval spent in it */
+	float frameTime;				/* average time between interpolations */
+	float renderTime;				/* average time from interpolating to ending the frame */
+	float renderLoad;				/* share of each frame spent rendering */
+	float latency;					/* average time from a snapshot being published to a frame first using it */
+	float maxLatency;
+} GAE_Simulation_Stats_t;
+
+typedef struct GAE_Simulation_s {
+	GAE_Simulation_Tick_t tick;
+	void* userData;
+	float interval;
+	GAE_Snapshot_t* snapshots[3];
+	GAE_Snapshot_t* previous;		/* the render thread's copy of the snapshot before front */
+	struct GAE_TripleBuffer_s* buffer;
+	struct GAE_Clock_s* clock;		/* the render thread's */
+	struct GAE_Clock_s* tickClock;	/* the simulation thread's, on the same timeline */
+	struct GAE_Thread_s* thread;
+	volatile unsigned int isRunning;
+	GAE_BOOL isThreaded;
+	GAE_BOOL hasSnapshot;
+
+	/* written by whichever thread ticks */
+	unsigned int nextTick;
+	float nextTickTime;
+	float busyTime;
+	unsigned int droppedTicks;
+
+	/* written by the render thread */
+	float frameStart;
+	unsigned int statsTicks;
+	float statsBusyTime;
+	unsigned int statsDroppedTicks;
+	float frameTimeTotal;
+	float renderTimeTotal;
+	unsigned int renderFrames;
+	float latencyTotal;
+	unsigned int latencyCount;
+	GAE_Simulation_Stats_t stats;
+} GAE_Simulation_t;
+
+/* The most ticks run back to back to catch up, before the simulation skips ahead and counts the rest as dropped. */
+#define GAE_SIMULATION_MAX_CATCH_UP 5U
+
+/* Creates a new snapshot with room for entityCapacity entities. */
+GAE_Snapshot_t* GAE_Snapshot_create(const unsigned int entityCapacity);
+
+/* Adds an entity, returning it - or 0 if the snapshot is full. */
+GAE_Snapshot_Entity_t* GAE_Snapshot_add(GAE_Snapshot_t* snapshot, const unsigned int id, const unsigned int frame, const GAE_Matrix4_t transform);
+
+/* Copies source over snapshot, dropping entities that don't fit. */
+GAE_Snapshot_t* GAE_Snapshot_copy(GAE_Snapshot_t* snapshot, GAE_Snapshot_t* const source);
+
+/* Deletes the snapshot. */
+void GAE_Snapshot_delete(GAE_Snapshot_t* snapshot);
+
+/* Creates a simulation calling tick ticksPerSecond times a second, with snapshots of up to entityCapacity entities. */
+GAE_Simulation_t* GAE_Simulation_create(const float ticksPerSecond, const unsigned int entityCapacity, GAE_Simulation_Tick_t tick, void* userData);
+
+/* Starts ticking from tick 0 - on a thread of its own if isThreaded, otherwise from GAE_Simulation_interpolate. Falls back to the latter if the thread can't start. */
+GAE_Simulation_t* GAE_Simulation_start(GAE_Simulation_t* simulation, const GAE_BOOL isThreaded);
+
+/* Stops ticking, waiting for the simulation thread to finish its tick. */
+GAE_Simulation_t* GAE_Simulation_stop(GAE_Simulation_t* simulation);
+
+/* Begins a frame - fills out with the state one tick interval ago, blended between the snapshots either side. Render thread only. */
+GAE_Snapshot_t* GAE_Simulation_interpolate(GAE_Simulation_t* simulation, GAE_Snapshot_t* out);
+
+/* Ends the frame begun by GAE_Simulation_interpolate, for the render timings. Render thread only. */
+GAE_Simulation_t* GAE_Simulation_endFrame(GAE_Simulation_t* simulation);
+
+/* Returns the timings since start or the last reset. This should NOT be freed. Render thread only. */
+GAE_Simulation_Stats_t* GAE_Simulation_getStats(GAE_Simulation_t* simulation);
+
+/* Starts the timings over. Render thread only. */
+GAE_Simulation_t* GAE_Simulation_resetStats(GAE_Simulation_t* simulation);
+
+/* Stops the simulation if need be and deletes it. */
+void GAE_Simulation_delete(GAE_Simulation_t* simulation);
+
+#endif
@@ -1,6 +1,7 @@
 #include "../Clock.h"
 
 #include <stdlib.h>
+#include <string.h>
 #include <Windows.h>
 
 typedef struct GAE_Clock_Win32_s {
@@ -37,6 +38,17 @@ GAE_Clock_t* GAE_Clock_create(void) {
 	return clock;
 }
 
+GAE_Clock_t* GAE_Clock_clone(GAE_Clock_t* const clock) {
+	GAE_Clock_t* newClock = (GAE_Clock_t*)malloc(sizeof(GAE_Clock_t));
+	GAE_Clock_Win32_t* win32Clock = (GAE_Clock_Win32_t*)malloc(sizeof(GAE_Clock_Win32_t));
+
+	memcpy(newClock, clock, sizeof(GAE_Clock_t));
+	memcpy(win32Clock, clock->platformData, sizeof(GAE_Clock_Win32_t));
+	newClock->platformData = win32Clock;
+
+	return newClock;
+}
+
 void GAE_Clock_delete(GAE_Clock_t* clock) {
 	free(clock->platformData);
 	free(clock);
@@ -0,0 +1,251 @@
+/* AsyncIO benchmark - writes a set of files, then loads them a few a frame as a level streaming in would, first with
+ * GAE_File on the main thread and then through GAE_AsyncIO, and prints the worst time a frame spent loading and the time to load them all.
+ * The page cache is dropped before each pass where the platform allows, so the disk is waited on as on a fresh boot.
+ * Each frame sleeps for the rest of its 16ms, as the main thread would be busy with everything else.
+ * Usage: asynciobenchmark [-dir PATH] [-count N] [-size KILOBYTES] [-perframe N] [-threads N]
+ */
+
+#if defined(LINUX) || defined(PANDORA)
+	/* posix_fadvise */
+	#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(LINUX) || defined(PANDORA)
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+#include "../../GAE_Types.h"
+#include "../../File/AsyncIO.h"
+#include "../../File/File.h"
+#include "../../Threads/Thread.h"
+#include "../../Time/Clock.h"
+
+#define FRAME_MICROSECONDS 16000U
+
+typedef struct Results_s {
+	float worstFrame;
+	float total;
+	unsigned int frames;
+	unsigned int loaded;
+	unsigned int finished;
+	unsigned long bytes;
+} Results_t;
+
+static void printUsage(const char* name);
+static GAE_BOOL writeFile(const char* const path, const unsigned long size, const unsigned int seed);
+static void dropCache(const char* path);
+static void loadSync(char** paths, const unsigned int count, const unsigned int perFrame, Results_t* results);
+static void loadAsync(char** paths, const unsigned int count, const unsigned int perFrame, const unsigned int threads, Results_t* results);
+static void onLoaded(GAE_File_t* file, const GAE_AsyncIO_Status status, void* userData);
+static void printResults(const char* name, Results_t* results);
+
+int main(int argc, char** argv) {
+	const char* dir = "/tmp";
+	unsigned int count = 64U;
+	unsigned long size = 1024UL * 1024UL;
+	unsigned int perFrame = 4U;
+	unsigned int threads = 0U;
+	Results_t sync = { 0.0F, 0.0F, 0U, 0U, 0U, 0UL };
+	Results_t async = { 0.0F, 0.0F, 0U, 0U, 0U, 0UL };
+	char** paths = 0;
+	unsigned int index = 0U;
+	int arg = 1;
+
+	for (; arg < argc; ++arg) {
+		if ((0 == strcmp(argv[arg], "-dir")) && (arg + 1 < argc))
+			dir = argv[++arg];
+		else if ((0 == strcmp(argv[arg], "-count")) && (arg + 1 < argc))
+			count = (unsigned int)strtoul(argv[++arg], 0, 10);
+		else if ((0 == strcmp(argv[arg], "-size")) && (arg + 1 < argc))
+			size = strtoul(argv[++arg], 0, 10) * 1024UL;
+		else if ((0 == strcmp(argv[arg], "-perframe")) && (arg + 1 < argc))
+			perFrame = (unsigned int)strtoul(argv[++arg], 0, 10);
+		else if ((0 == strcmp(argv[arg], "-threads")) && (arg + 1 < argc))
+			threads = (unsigned int)strtoul(argv[++arg], 0, 10);
+		else {
+			printUsage(argv[0]);
+			return 1;
+		}
+	}
+
+	if ((0U == count) || (0UL == size) || (0U == perFrame)) {
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	paths = malloc(count * sizeof(char*));
+	for (index = 0U; index < count; ++index) {
+		/* the directory, then "/asynciobenchmark-", up to ten digits and ".bin" */
+		const size_t pathSize = strlen(dir) + 32U;
+
+		paths[index] = malloc(pathSize);
+		snprintf(paths[index], pathSize, "%s/asynciobenchmark-%u.bin", dir, index);
+		if (GAE_FALSE == writeFile(paths[index], size, index)) {
+			fprintf(stderr, "Failed to write %s\n", paths[index]);
+			count = index + 1U;
+			break;
+		}
+	}
+
+	if (index == count) {
+		printf("%u files of %luKB, %u a frame\n", count, size / 1024UL, perFrame);
+		printf("%10s  %12s %10s %8s\n", "", "worst frame", "total", "frames");
+
+		for (index = 0U; index < count; ++index)
+			dropCache(paths[index]);
+		loadSync(paths, count, perFrame, &sync);
+		printResults("sync", &sync);
+
+		for (index = 0U; index < count; ++index)
+			dropCache(paths[index]);
+		loadAsync(paths, count, perFrame, threads, &async);
+		printResults("async", &async);
+
+		if ((count != sync.loaded) || (count != async.loaded) || (sync.bytes != async.bytes))
+			fprintf(stderr, "Loaded %u and %u files, of %lu and %lu bytes\n", sync.loaded, async.loaded, sync.bytes, async.bytes);
+	}
+
+	for (index = 0U; index < count; ++index) {
+		remove(paths[index]);
+		free(paths[index]);
+	}
+	free(paths);
+
+	return ((count == sync.loaded) && (count == async.loaded)) ? 0 : 1;
+}
+
+void printUsage(const char* name) {
+	fprintf(stderr, "Usage: %s [-dir PATH] [-count N] [-size KILOBYTES] [-perframe N] [-threads N]\n", name);
+}
+
+GAE_BOOL writeFile(const char* const path, const unsigned long size, const unsigned int seed) {
+	FILE* file = fopen(path, "wb");
+	GAE_BYTE block[4096];
+	unsigned long written = 0UL;
+	unsigned long index = 0UL;
+
+	if (0 == file)
+		return GAE_FALSE;
+
+	for (index = 0UL; index < sizeof(block); ++index)
+		block[index] = (GAE_BYTE)(index * 31UL + seed);
+
+	while (written < size) {
+		const unsigned long amount = (size - written < sizeof(block)) ? size - written : sizeof(block);
+		if (amount != fwrite(block, 1U, amount, file)) {
+			fclose(file);
+			return GAE_FALSE;
+		}
+		written += amount;
+	}
+
+	fclose(file);
+	return GAE_TRUE;
+}
+
+void dropCache(const char* path) {
+#if defined(LINUX) || defined(PANDORA)
+	/* clean pages are dropped without needing root - anything still dirty is written out first */
+	const int descriptor = open(path, O_RDONLY);
+	if (-1 == descriptor)
+		return;
+
+	fdatasync(descriptor);
+	posix_fadvise(descriptor, 0, 0, POSIX_FADV_DONTNEED);
+	close(descriptor);
+#else
+	(void)path;
+#endif
+}
+
+void loadSync(char** paths, const unsigned int count, const unsigned int perFrame, Results_t* results) {
+	GAE_Clock_t* frameClock = GAE_Clock_create();
+	GAE_Clock_t* totalClock = GAE_Clock_create();
+	unsigned int next = 0U;
+
+	GAE_Clock_reset(totalClock);
+	while (next < count) {
+		const unsigned int last = (count - next < perFrame) ? count : next + perFrame;
+
+		GAE_Clock_reset(frameClock);
+		for (; next < last; ++next) {
+			GAE_File_t* file = GAE_File_create(paths[next]);
+			GAE_FILE_STATUS fileStatus = GAE_FILE_ERROR;
+			GAE_FILE_READ_STATUS readStatus = GAE_FILE_READ_ERROR;
+
+			GAE_File_open(file, GAE_FILE_OPEN_READ, GAE_FILE_BINARY, &fileStatus);
+			if (GAE_FILE_OPEN == fileStatus)
+				GAE_File_read(file, GAE_FILE_READ_ALL, &readStatus);
+			GAE_File_close(file, GAE_FILE_CLOSE_RETAIN_DATA, 0);
+			onLoaded(file, (GAE_FILE_READ_ERROR == readStatus) ? GAE_ASYNCIO_FAILED : GAE_ASYNCIO_DONE, results);
+		}
+		GAE_Clock_update(frameClock);
+
+		if (frameClock->deltaTime > results->worstFrame)
+			results->worstFrame = frameClock->deltaTime;
+		++results->frames;
+		GAE_Thread_sleep(FRAME_MICROSECONDS);
+	}
+	GAE_Clock_update(totalClock);
+	results->total = totalClock->deltaTime;
+
+	GAE_Clock_delete(totalClock);
+	GAE_Clock_delete(frameClock);
+}
+
+void loadAsync(char** paths, const unsigned int count, const unsigned int perFrame, const unsigned int threads, Results_t* results) {
+	GAE_AsyncIO_t* io = GAE_AsyncIO_create(threads);
+	GAE_Clock_t* frameClock = GAE_Clock_create();
+	GAE_Clock_t* totalClock = GAE_Clock_create();
+	unsigned int next = 0U;
+
+	GAE_Clock_reset(totalClock);
+	while (results->finished < count) {
+		const unsigned int last = (count - next < perFrame) ? count : next + perFrame;
+
+		/* queued at the same rate as the synchronous pass loads them, earliest first */
+		GAE_Clock_reset(frameClock);
+		for (; next < last; ++next) {
+			GAE_File_t* file = GAE_File_create(paths[next]);
+			if (0U == GAE_AsyncIO_read(io, file, GAE_FILE_OPEN_READ, GAE_FILE_BINARY, (int)(count - next), onLoaded, results))
+				onLoaded(file, GAE_ASYNCIO_FAILED, results);
+		}
+		GAE_AsyncIO_update(io);
+		GAE_Clock_update(frameClock);
+
+		if (frameClock->deltaTime > results->worstFrame)
+			results->worstFrame = frameClock->deltaTime;
+		++results->frames;
+		GAE_Thread_sleep(FRAME_MICROSECONDS);
+	}
+	GAE_Clock_update(totalClock);
+	results->total = totalClock->deltaTime;
+
+	GAE_Clock_delete(totalClock);
+	GAE_Clock_delete(frameClock);
+	GAE_AsyncIO_delete(io);
+}
+
+void onLoaded(GAE_File_t* file, const GAE_AsyncIO_Status status, void* userData) {
+	Results_t* results = (Results_t*)userData;
+
+	++results->finished;
+	if (GAE_ASYNCIO_DONE == status) {
+		++results->loaded;
+		results->bytes += file->bufferSize;
+	}
+	else
+		fprintf(stderr, "Failed to load %s\n", file->filePath);
+
+	GAE_File_deleteBuffer(file, 0);
+	GAE_File_delete(file);
+}
+
+void printResults(const char* name, Results_t* results) {
+	printf("%10s  %10.3fms %8.1fms %8u\n", name, results->worstFrame * 1000.0F, results->total * 1000.0F, results->frames);
+}
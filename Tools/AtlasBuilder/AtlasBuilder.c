@@ -0,0 +1,162 @@
+/* Offline atlas packer - packs images into power of two pages and writes
+ * <output>_<page>.tga along with an <output>.atlas rect table:
+ *   page x y width height u0 v0 u1 v1 name
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../GAE_Types.h"
+#include "../../File/File.h"
+#include "../../Graphics/AtlasBuilder.h"
+
+static void printUsage(const char* name);
+static GAE_BOOL writePage(const char* path, GAE_AtlasBuilder_Page_t* page);
+static GAE_BOOL writeTable(const char* path, GAE_AtlasBuilder_t* builder, char** names, const unsigned int count);
+
+int main(int argc, char** argv) {
+	GAE_AtlasBuilder_t* builder = 0;
+	unsigned int maxPageSize = 2048U;
+	unsigned int padding = 1U;
+	unsigned int extrude = 1U;
+	const char* output = 0;
+	char path[1024];
+	GAE_BOOL packed = GAE_FALSE;
+	unsigned int page = 0U;
+	int arg = 1;
+	int firstImage = 0;
+
+	while ((arg < argc) && ('-' == argv[arg][0])) {
+		if ((0 == strcmp(argv[arg], "-size")) && (arg + 1 < argc))
+			maxPageSize = (unsigned int)strtoul(argv[++arg], 0, 10);
+		else if ((0 == strcmp(argv[arg], "-padding")) && (arg + 1 < argc))
+			padding = (unsigned int)strtoul(argv[++arg], 0, 10);
+		else if ((0 == strcmp(argv[arg], "-extrude")) && (arg + 1 < argc))
+			extrude = (unsigned int)strtoul(argv[++arg], 0, 10);
+		else {
+			printUsage(argv[0]);
+			return 1;
+		}
+		++arg;
+	}
+
+	if (arg + 2 > argc) {
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	output = argv[arg++];
+	firstImage = arg;
+	builder = GAE_AtlasBuilder_create(maxPageSize, padding, extrude);
+
+	for (; arg < argc; ++arg) {
+		GAE_File_t* file = GAE_File_create(argv[arg]);
+		GAE_FILE_STATUS fileStatus = GAE_FILE_ERROR;
+		GAE_FILE_READ_STATUS readStatus = GAE_FILE_READ_ERROR;
+
+		GAE_File_open(file, GAE_FILE_OPEN_READ, GAE_FILE_BINARY, &fileStatus);
+		if (GAE_FILE_OPEN == fileStatus)
+			GAE_File_read(file, GAE_FILE_READ_ALL, &readStatus);
+
+		if ((GAE_FILE_READ_ERROR == readStatus) || (GAE_INVALID == GAE_AtlasBuilder_addFile(builder, file))) {
+			fprintf(stderr, "Failed to load image: %s\n", argv[arg]);
+			GAE_File_close(file, GAE_FILE_CLOSE_DELETE_DATA, 0);
+			GAE_File_delete(file);
+			GAE_AtlasBuilder_delete(builder);
+			return 1;
+		}
+
+		GAE_File_close(file, GAE_FILE_CLOSE_DELETE_DATA, 0);
+		GAE_File_delete(file);
+	}
+
+	GAE_AtlasBuilder_pack(builder, &packed);
+	if (GAE_FALSE == packed) {
+		fprintf(stderr, "Images larger than the %u page size were skipped\n", builder->maxPageSize);
+		GAE_AtlasBuilder_delete(builder);
+		return 1;
+	}
+
+	for (page = 0U; page < GAE_AtlasBuilder_getPageCount(builder); ++page) {
+		sprintf(path, "%.1000s_%u.tga", output, page);
+		if (GAE_FALSE == writePage(path, GAE_AtlasBuilder_getPage(builder, page))) {
+			fprintf(stderr, "Failed to write page: %s\n", path);
+			GAE_AtlasBuilder_delete(builder);
+			return 1;
+		}
+	}
+
+	sprintf(path, "%.1000s.atlas", output);
+	if (GAE_FALSE == writeTable(path, builder, &argv[firstImage], (unsigned int)(argc - firstImage))) {
+		fprintf(stderr, "Failed to write rect table: %s\n", path);
+		GAE_AtlasBuilder_delete(builder);
+		return 1;
+	}
+
+	printf("Packed %u images into %u pages\n", (unsigned int)(argc - firstImage), GAE_AtlasBuilder_getPageCount(builder));
+
+	GAE_AtlasBuilder_delete(builder);
+	return 0;
+}
+
+void printUsage(const char* name) {
+	fprintf(stderr, "Usage: %s [-size 2048] [-padding 1] [-extrude 1] output image [image ...]\n", name);
+}
+
+GAE_BOOL writePage(const char* path, GAE_AtlasBuilder_Page_t* page) {
+	FILE* file = fopen(path, "wb");
+	GAE_BYTE header[18];
+	GAE_BYTE* row = 0;
+	unsigned int y = 0U;
+	unsigned int x = 0U;
+	GAE_BOOL status = GAE_TRUE;
+
+	if (0 == file)
+		return GAE_FALSE;
+
+	/* uncompressed 32 bit true colour, top left origin */
+	memset(header, 0, sizeof(header));
+	header[2] = 2U;
+	header[12] = (GAE_BYTE)(page->width & 0xFFU);
+	header[13] = (GAE_BYTE)(page->width >> 8U);
+	header[14] = (GAE_BYTE)(page->height & 0xFFU);
+	header[15] = (GAE_BYTE)(page->height >> 8U);
+	header[16] = 32U;
+	header[17] = 0x28U;
+
+	if (sizeof(header) != fwrite(header, 1U, sizeof(header), file))
+		status = GAE_FALSE;
+
+	row = malloc(page->width * 4U);
+	for (y = 0U; (y < page->height) && (GAE_TRUE == status); ++y) {
+		const GAE_BYTE* source = page->data + y * page->width * 4U;
+		for (x = 0U; x < page->width; ++x) {
+			row[x * 4U + 0U] = source[x * 4U + 2U];
+			row[x * 4U + 1U] = source[x * 4U + 1U];
+			row[x * 4U + 2U] = source[x * 4U + 0U];
+			row[x * 4U + 3U] = source[x * 4U + 3U];
+		}
+		if (page->width * 4U != fwrite(row, 1U, page->width * 4U, file))
+			status = GAE_FALSE;
+	}
+
+	free(row);
+	fclose(file);
+	return status;
+}
+
+GAE_BOOL writeTable(const char* path, GAE_AtlasBuilder_t* builder, char** names, const unsigned int count) {
+	FILE* file = fopen(path, "w");
+	unsigned int index = 0U;
+
+	if (0 == file)
+		return GAE_FALSE;
+
+	for (index = 0U; index < count; ++index) {
+		GAE_AtlasBuilder_Rect_t* rect = GAE_AtlasBuilder_getRect(builder, index);
+		fprintf(file, "%u %u %u %u %u %f %f %f %f %s\n", rect->page, rect->x, rect->y, rect->width, rect->height, rect->uv[0], rect->uv[1], rect->uv[2], rect->uv[3], names[index]);
+	}
+
+	return (0 == fclose(file)) ? GAE_TRUE : GAE_FALSE;
+}
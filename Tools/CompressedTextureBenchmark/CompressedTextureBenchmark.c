@@ -0,0 +1,949 @@
+/* Compressed texture benchmark - compares DXT1, DXT5 and ETC1 textures against plain RGBA on a generated sample set,
+ * by their size on disk and in video memory and the time to load each from its file - uploaded as is, and decoded on the CPU
+ * as happens when GL lacks the extension. The RGBA textures are TGAs, decoded by stb_image with their mips generated by GL,
+ * so their load times are a floor for any other image format. Every texture carries a full mip chain.
+ * Each compressed texture is checked as well: with the extension, every level has to reach glCompressedTexImage2D exactly as
+ * it was written, and without, what's uploaded has to match a reference decoder written here from the format specifications -
+ * exactly for ETC1, and to within a few steps for DXT, whose rounding GL leaves to the implementation.
+ * The samples are written to the working directory and removed afterwards.
+ * Usage: compressedtexturebenchmark [-size N] [-iterations N]
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../../GAE_Types.h"
+#include "../../File/File.h"
+#include "../../Graphics/CompressedTexture.h"
+#include "../../Graphics/Texture.h"
+#include "../../Graphics/Context/Mock/MockGL.h"
+
+#define SAMPLE_COUNT 4U
+#define FORMAT_COUNT 3U
+#define MAX_LEVELS GAE_COMPRESSED_TEXTURE_MAX_LEVELS
+#define PATH_SIZE 128U
+#define DXT_TOLERANCE 3U
+#define EXTENSIONS "GL_EXT_texture_compression_s3tc GL_OES_compressed_ETC1_RGB8_texture"
+
+typedef struct Image_s {
+	GAE_BYTE* pixels; /* RGBA */
+	unsigned int width;
+	unsigned int height;
+} Image_t;
+
+typedef struct Result_s {
+	unsigned long fileSize;
+	unsigned long videoSize;
+	double loadTime; /* seconds per load */
+	double decodedTime; /* the same, decoded on the CPU */
+} Result_t;
+
+static const char* const SAMPLE_NAMES[SAMPLE_COUNT] = { "gradient", "noise", "shapes", "cutout" };
+static const GAE_CompressedTexture_Format FORMATS[FORMAT_COUNT] = { GAE_COMPRESSED_TEXTURE_FORMAT_DXT1, GAE_COMPRESSED_TEXTURE_FORMAT_DXT5, GAE_COMPRESSED_TEXTURE_FORMAT_ETC1 };
+static const char* const FORMAT_NAMES[FORMAT_COUNT] = { "dxt1", "dxt5", "etc1" };
+static const GLenum FORMAT_ENUMS[FORMAT_COUNT] = { GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, GL_ETC1_RGB8_OES };
+
+static const int ETC1_MODIFIERS[8][2] = { { 2, 8 }, { 5, 17 }, { 9, 29 }, { 13, 42 }, { 18, 60 }, { 24, 80 }, { 33, 106 }, { 47, 183 } };
+static const GAE_BYTE KTX_IDENTIFIER[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+
+static void printUsage(const char* name);
+static void generateSample(const unsigned int sample, const unsigned int size, Image_t* image);
+static unsigned int buildMips(Image_t* levels);
+static unsigned long encodeLevel(const GAE_CompressedTexture_Format format, const Image_t* image, GAE_BYTE* target);
+static void fetchBlock(const Image_t* image, const unsigned int blockX, const unsigned int blockY, GAE_BYTE block[16][4]);
+static void encodeColourBlock(GAE_BYTE block[16][4], GAE_BYTE* target);
+static void encodeAlphaBlock(GAE_BYTE block[16][4], GAE_BYTE* target);
+static void encodeETC1Block(GAE_BYTE block[16][4], GAE_BYTE* target);
+static void decodeReference(const GAE_CompressedTexture_Format format, const GAE_BYTE* data, const unsigned int width, const unsigned int height, GAE_BYTE* rgba);
+static void decodeReferenceColour(const GAE_BYTE* block, GAE_BYTE colours[16][4], const GAE_BOOL hasPunchThrough);
+static void decodeReferenceAlpha(const GAE_BYTE* block, GAE_BYTE colours[16][4]);
+static void decodeReferenceETC1(const GAE_BYTE* block, GAE_BYTE colours[16][4]);
+static void expand565(const unsigned int colour, int rgb[3]);
+static int clampColour(const int value);
+static unsigned int colourDistance(const GAE_BYTE* a, const int* b);
+static void writeUint32(FILE* file, const unsigned int value);
+static GAE_BOOL writeTGA(const char* const path, const Image_t* image);
+static GAE_BOOL writeCompressed(const char* const path, const unsigned int formatIndex, GAE_BYTE** levels, const unsigned long* sizes, const Image_t* images, const unsigned int levelCount);
+static GAE_Texture_t* loadTexture(const char* const path, const GAE_GL_Texture_Format format);
+static double timeLoads(const char* const path, const GAE_GL_Texture_Format format, const unsigned int iterations);
+static GAE_BOOL checkTexture(const char* const path, const unsigned int formatIndex, GAE_BYTE** levels, const unsigned long* sizes, const Image_t* images, const unsigned int levelCount, unsigned int* maxDifference);
+static double getPSNR(const Image_t* image, const GAE_BYTE* decoded, const GAE_BOOL hasAlpha);
+
+int main(int argc, char** argv) {
+	Result_t totals[FORMAT_COUNT + 1U];
+	unsigned int size = 256U;
+	unsigned int iterations = 20U;
+	unsigned int sample = 0U;
+	GAE_BOOL status = GAE_TRUE;
+	int arg = 1;
+
+	for (; arg < argc; ++arg) {
+		if ((0 == strcmp(argv[arg], "-size")) && (arg + 1 < argc))
+			size = (unsigned int)strtoul(argv[++arg], 0, 10);
+		else if ((0 == strcmp(argv[arg], "-iterations")) && (arg + 1 < argc))
+			iterations = (unsigned int)strtoul(argv[++arg], 0, 10);
+		else {
+			printUsage(argv[0]);
+			return 1;
+		}
+	}
+
+	/* a whole number of blocks, and no bigger than the chain a container can hold */
+	if ((0U == iterations) || (4U > size) || (0U != size % 4U) || ((1U << (MAX_LEVELS - 1U)) < size)) {
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	memset(totals, 0, sizeof(totals));
+	for (sample = 0U; (sample < SAMPLE_COUNT) && (GAE_TRUE == status); ++sample) {
+		Image_t images[MAX_LEVELS];
+		char path[PATH_SIZE];
+		unsigned int levelCount = 0U;
+		unsigned int level = 0U;
+		unsigned int formatIndex = 0U;
+		Result_t rgba;
+
+		generateSample(sample, size, &images[0]);
+		levelCount = buildMips(images);
+
+		/* plain RGBA first, as the baseline */
+		memset(&rgba, 0, sizeof(Result_t));
+		snprintf(path, sizeof(path), "compressedtexturebenchmark_%s.tga", SAMPLE_NAMES[sample]);
+		status = writeTGA(path, &images[0]);
+		if (GAE_TRUE == status) {
+			rgba.fileSize = 18UL + (unsigned long)size * size * 4UL;
+			for (level = 0U; level < levelCount; ++level)
+				rgba.videoSize += (unsigned long)images[level].width * images[level].height * 4UL;
+
+			GAE_MockGL_setExtensions(EXTENSIONS);
+			rgba.loadTime = timeLoads(path, GAE_GL_TEXTURE_FORMAT_RGBA, iterations);
+			rgba.decodedTime = rgba.loadTime;
+			remove(path);
+
+			printf("%s, %ux%u with %u levels\n", SAMPLE_NAMES[sample], size, size, levelCount);
+			printf("  rgba: %8lu bytes on disk, %8lu in video memory, %8.3fms to load\n", rgba.fileSize, rgba.videoSize, rgba.loadTime * 1000.0);
+			totals[FORMAT_COUNT].fileSize += rgba.fileSize;
+			totals[FORMAT_COUNT].videoSize += rgba.videoSize;
+			totals[FORMAT_COUNT].loadTime += rgba.loadTime;
+			totals[FORMAT_COUNT].decodedTime += rgba.decodedTime;
+		}
+
+		for (formatIndex = 0U; (formatIndex < FORMAT_COUNT) && (GAE_TRUE == status); ++formatIndex) {
+			GAE_BYTE* levels[MAX_LEVELS];
+			unsigned long sizes[MAX_LEVELS];
+			GAE_BYTE* decoded = malloc((unsigned long)size * size * 4U);
+			const GAE_BOOL hasAlpha = (GAE_COMPRESSED_TEXTURE_FORMAT_DXT5 == FORMATS[formatIndex]) ? GAE_TRUE : GAE_FALSE;
+			unsigned int maxDifference = 0U;
+			Result_t result;
+
+			memset(&result, 0, sizeof(Result_t));
+			for (level = 0U; level < levelCount; ++level) {
+				levels[level] = malloc(GAE_CompressedTexture_getSize(FORMATS[formatIndex], images[level].width, images[level].height));
+				sizes[level] = encodeLevel(FORMATS[formatIndex], &images[level], levels[level]);
+				result.videoSize += sizes[level];
+			}
+
+			snprintf(path, sizeof(path), "compressedtexturebenchmark_%s.%s", SAMPLE_NAMES[sample], (GAE_COMPRESSED_TEXTURE_FORMAT_ETC1 == FORMATS[formatIndex]) ? "ktx" : "dds");
+			status = writeCompressed(path, formatIndex, levels, sizes, images, levelCount);
+			if (GAE_TRUE == status)
+				status = checkTexture(path, formatIndex, levels, sizes, images, levelCount, &maxDifference);
+
+			if (GAE_TRUE == status) {
+				FILE* file = fopen(path, "rb");
+
+				if (0 != file) {
+					fseek(file, 0L, SEEK_END);
+					result.fileSize = (unsigned long)ftell(file);
+					fclose(file);
+				}
+
+				GAE_MockGL_setExtensions(EXTENSIONS);
+				result.loadTime = timeLoads(path, GAE_GL_TEXTURE_FORMAT_DXT1, iterations);
+				GAE_MockGL_setExtensions("");
+				result.decodedTime = timeLoads(path, GAE_GL_TEXTURE_FORMAT_DXT1, iterations);
+
+				decodeReference(FORMATS[formatIndex], levels[0], size, size, decoded);
+				printf("  %s: %8lu bytes on disk, %8lu in video memory, %8.3fms to load, %8.3fms decoded - %.1fdB, decoders %u apart at most\n",
+					FORMAT_NAMES[formatIndex], result.fileSize, result.videoSize, result.loadTime * 1000.0, result.decodedTime * 1000.0,
+					getPSNR(&images[0], decoded, hasAlpha), maxDifference);
+
+				totals[formatIndex].fileSize += result.fileSize;
+				totals[formatIndex].videoSize += result.videoSize;
+				totals[formatIndex].loadTime += result.loadTime;
+				totals[formatIndex].decodedTime += result.decodedTime;
+			}
+			remove(path);
+
+			free(decoded);
+			for (level = 0U; level < levelCount; ++level)
+				free(levels[level]);
+		}
+
+		for (level = 0U; level < levelCount; ++level)
+			free(images[level].pixels);
+	}
+
+	if (GAE_TRUE == status) {
+		unsigned int formatIndex = 0U;
+
+		printf("Against RGBA over the set:\n");
+		for (formatIndex = 0U; formatIndex < FORMAT_COUNT; ++formatIndex) {
+			printf("  %s: %.2fx the disk, %.2fx the video memory, %.2fx the load time, %.2fx decoded\n", FORMAT_NAMES[formatIndex],
+				(double)totals[formatIndex].fileSize / (double)totals[FORMAT_COUNT].fileSize,
+				(double)totals[formatIndex].videoSize / (double)totals[FORMAT_COUNT].videoSize,
+				(0.0 < totals[FORMAT_COUNT].loadTime) ? totals[formatIndex].loadTime / totals[FORMAT_COUNT].loadTime : 0.0,
+				(0.0 < totals[FORMAT_COUNT].loadTime) ? totals[formatIndex].decodedTime / totals[FORMAT_COUNT].loadTime : 0.0);
+		}
+	}
+
+	return (GAE_TRUE == status) ? 0 : 1;
+}
+
+void printUsage(const char* name) {
+	fprintf(stderr, "Usage: %s [-size N] [-iterations N]\n", name);
+	fprintf(stderr, "  the size is a multiple of 4\n");
+}
+
+/* Fills in one of the samples - a smooth gradient, noise, soft edged shapes with alpha, and hard edged cutouts. */
+void generateSample(const unsigned int sample, const unsigned int size, Image_t* image) {
+	unsigned int seed = 1U + sample;
+	unsigned int x = 0U;
+	unsigned int y = 0U;
+
+	image->width = size;
+	image->height = size;
+	image->pixels = malloc((unsigned long)size * size * 4U);
+
+	for (y = 0U; y < size; ++y) {
+		for (x = 0U; x < size; ++x) {
+			GAE_BYTE* pixel = image->pixels + ((unsigned long)y * size + x) * 4U;
+			const float u = (float)x / (float)size;
+			const float v = (float)y / (float)size;
+
+			switch (sample) {
+				case 0U: {
+					pixel[0] = (GAE_BYTE)(u * 255.0F);
+					pixel[1] = (GAE_BYTE)(v * 255.0F);
+					pixel[2] = (GAE_BYTE)((1.0F - u * v) * 255.0F);
+					pixel[3] = 255U;
+				}
+				break;
+				case 1U: {
+					seed = (seed * 1103515245U) + 12345U;
+					pixel[0] = (GAE_BYTE)(seed >> 16U);
+					pixel[1] = (GAE_BYTE)(seed >> 8U);
+					pixel[2] = (GAE_BYTE)(seed >> 24U);
+					pixel[3] = 255U;
+				}
+				break;
+				case 2U: {
+					const float dx = u - 0.5F;
+					const float dy = v - 0.5F;
+					const float ring = 0.5F + 0.5F * (float)sin(sqrt(dx * dx + dy * dy) * 40.0);
+					const float fade = 1.0F - 2.0F * (float)sqrt(dx * dx + dy * dy);
+
+					pixel[0] = (GAE_BYTE)(ring * 255.0F);
+					pixel[1] = (GAE_BYTE)(ring * 128.0F + 64.0F);
+					pixel[2] = (GAE_BYTE)((1.0F - ring) * 255.0F);
+					pixel[3] = (GAE_BYTE)((0.0F < fade) ? fade * 255.0F : 0.0F);
+				}
+				break;
+				default: {
+					const GAE_BOOL isSolid = (0U != (((x / 16U) ^ (y / 16U)) & 1U)) ? GAE_TRUE : GAE_FALSE;
+
+					pixel[0] = (GAE_TRUE == isSolid) ? 240U : 20U;
+					pixel[1] = (GAE_BYTE)(x ^ y);
+					pixel[2] = (GAE_TRUE == isSolid) ? 30U : 200U;
+					pixel[3] = (GAE_TRUE == isSolid) ? 255U : 0U;
+				}
+				break;
+			}
+		}
+	}
+}
+
+/* Box filters the first image down to 1x1, returning how many levels there are. */
+unsigned int buildMips(Image_t* levels) {
+	unsigned int levelCount = 1U;
+
+	while ((1U < levels[levelCount - 1U].width) || (1U < levels[levelCount - 1U].height)) {
+		const Image_t* source = &levels[levelCount - 1U];
+		Image_t* target = &levels[levelCount];
+		unsigned int x = 0U;
+		unsigned int y = 0U;
+
+		target->width = (1U < source->width) ? source->width / 2U : 1U;
+		target->height = (1U < source->height) ? source->height / 2U : 1U;
+		target->pixels = malloc((unsigned long)target->width * target->height * 4U);
+
+		for (y = 0U; y < target->height; ++y) {
+			for (x = 0U; x < target->width; ++x) {
+				const unsigned int x0 = (x * 2U < source->width) ? x * 2U : source->width - 1U;
+				const unsigned int y0 = (y * 2U < source->height) ? y * 2U : source->height - 1U;
+				const unsigned int x1 = (x0 + 1U < source->width) ? x0 + 1U : x0;
+				const unsigned int y1 = (y0 + 1U < source->height) ? y0 + 1U : y0;
+				unsigned int channel = 0U;
+
+				for (channel = 0U; channel < 4U; ++channel) {
+					const unsigned int sum = source->pixels[(y0 * source->width + x0) * 4U + channel] + source->pixels[(y0 * source->width + x1) * 4U + channel]
+						+ source->pixels[(y1 * source->width + x0) * 4U + channel] + source->pixels[(y1 * source->width + x1) * 4U + channel];
+					target->pixels[(y * target->width + x) * 4U + channel] = (GAE_BYTE)((sum + 2U) / 4U);
+				}
+			}
+		}
+
+		++levelCount;
+	}
+
+	return levelCount;
+}
+
+unsigned long encodeLevel(const GAE_CompressedTexture_Format format, const Image_t* image, GAE_BYTE* target) {
+	GAE_BYTE* block = target;
+	unsigned int blockX = 0U;
+	unsigned int blockY = 0U;
+
+	for (blockY = 0U; blockY < image->height; blockY += 4U) {
+		for (blockX = 0U; blockX < image->width; blockX += 4U) {
+			GAE_BYTE pixels[16][4];
+
+			fetchBlock(image, blockX, blockY, pixels);
+			switch (format) {
+				case GAE_COMPRESSED_TEXTURE_FORMAT_DXT1: {
+					encodeColourBlock(pixels, block);
+					block += 8U;
+				}
+				break;
+				case GAE_COMPRESSED_TEXTURE_FORMAT_DXT5: {
+					encodeAlphaBlock(pixels, block);
+					encodeColourBlock(pixels, block + 8U);
+					block += 16U;
+				}
+				break;
+				case GAE_COMPRESSED_TEXTURE_FORMAT_ETC1: {
+					encodeETC1Block(pixels, block);
+					block += 8U;
+				}
+				break;
+				case GAE_COMPRESSED_TEXTURE_FORMAT_INVALID:
+				default:
+					return 0UL;
+			}
+		}
+	}
+
+	return (unsigned long)(block - target);
+}
+
+/* Blocks hanging off the edge of small levels repeat the last row and column. */
+void fetchBlock(const Image_t* image, const unsigned int blockX, const unsigned int blockY, GAE_BYTE block[16][4]) {
+	unsigned int x = 0U;
+	unsigned int y = 0U;
+
+	for (y = 0U; y < 4U; ++y) {
+		for (x = 0U; x < 4U; ++x) {
+			const unsigned int sourceX = (blockX + x < image->width) ? blockX + x : image->width - 1U;
+			const unsigned int sourceY = (blockY + y < image->height) ? blockY + y : image->height - 1U;
+			memcpy(block[y * 4U + x], image->pixels + ((unsigned long)sourceY * image->width + sourceX) * 4U, 4U);
+		}
+	}
+}
+
+/* Takes the ends of the block's bounding box, inset a little, always in four colour mode - DXT1 is left opaque. */
+void encodeColourBlock(GAE_BYTE block[16][4], GAE_BYTE* target) {
+	int minimum[3] = { 255, 255, 255 };
+	int maximum[3] = { 0, 0, 0 };
+	int palette[4][3];
+	unsigned int colours[2];
+	unsigned int indices = 0U;
+	unsigned int pixel = 0U;
+	unsigned int channel = 0U;
+
+	for (pixel = 0U; pixel < 16U; ++pixel) {
+		for (channel = 0U; channel < 3U; ++channel) {
+			if (block[pixel][channel] < minimum[channel])
+				minimum[channel] = block[pixel][channel];
+			if (block[pixel][channel] > maximum[channel])
+				maximum[channel] = block[pixel][channel];
+		}
+	}
+
+	for (channel = 0U; channel < 3U; ++channel) {
+		const int inset = (maximum[channel] - minimum[channel]) / 16;
+		minimum[channel] += inset;
+		maximum[channel] -= inset;
+	}
+
+	/* the box's top corner packs to at least its bottom one, so the colours are already in four colour order */
+	colours[0] = ((unsigned int)(maximum[0] >> 3) << 11U) | ((unsigned int)(maximum[1] >> 2) << 5U) | (unsigned int)(maximum[2] >> 3);
+	colours[1] = ((unsigned int)(minimum[0] >> 3) << 11U) | ((unsigned int)(minimum[1] >> 2) << 5U) | (unsigned int)(minimum[2] >> 3);
+
+	if (colours[0] != colours[1]) {
+		expand565(colours[0], palette[0]);
+		expand565(colours[1], palette[1]);
+		for (channel = 0U; channel < 3U; ++channel) {
+			palette[2][channel] = (2 * palette[0][channel] + palette[1][channel] + 1) / 3;
+			palette[3][channel] = (palette[0][channel] + 2 * palette[1][channel] + 1) / 3;
+		}
+
+		for (pixel = 0U; pixel < 16U; ++pixel) {
+			unsigned int best = 0U;
+			unsigned int index = 0U;
+
+			for (index = 1U; index < 4U; ++index) {
+				if (colourDistance(block[pixel], palette[index]) < colourDistance(block[pixel], palette[best]))
+					best = index;
+			}
+			indices |= best << (pixel * 2U);
+		}
+	}
+
+	target[0] = (GAE_BYTE)(colours[0] & 0xFFU);
+	target[1] = (GAE_BYTE)(colours[0] >> 8U);
+	target[2] = (GAE_BYTE)(colours[1] & 0xFFU);
+	target[3] = (GAE_BYTE)(colours[1] >> 8U);
+	target[4] = (GAE_BYTE)(indices & 0xFFU);
+	target[5] = (GAE_BYTE)((indices >> 8U) & 0xFFU);
+	target[6] = (GAE_BYTE)((indices >> 16U) & 0xFFU);
+	target[7] = (GAE_BYTE)(indices >> 24U);
+}
+
+/* Spans the block's alpha with the eight value mode. */
+void encodeAlphaBlock(GAE_BYTE block[16][4], GAE_BYTE* target) {
+	unsigned int alphas[8];
+	unsigned int bits[2] = { 0U, 0U };
+	unsigned int pixel = 0U;
+	unsigned int index = 0U;
+
+	alphas[0] = 0U;
+	alphas[1] = 255U;
+	for (pixel = 0U; pixel < 16U; ++pixel) {
+		if (block[pixel][3] > alphas[0])
+			alphas[0] = block[pixel][3];
+		if (block[pixel][3] < alphas[1])
+			alphas[1] = block[pixel][3];
+	}
+
+	for (index = 1U; index < 7U; ++index)
+		alphas[index + 1U] = ((7U - index) * alphas[0] + index * alphas[1] + 3U) / 7U;
+
+	/* with a single alpha every index is 0, which either mode reads as it */
+	if (alphas[0] != alphas[1]) {
+		for (pixel = 0U; pixel < 16U; ++pixel) {
+			unsigned int best = 0U;
+
+			for (index = 1U; index < 8U; ++index) {
+				const int distance = (int)block[pixel][3] - (int)alphas[index];
+				const int bestDistance = (int)block[pixel][3] - (int)alphas[best];
+				if (distance * distance < bestDistance * bestDistance)
+					best = index;
+			}
+			bits[pixel / 8U] |= best << ((pixel % 8U) * 3U);
+		}
+	}
+
+	target[0] = (GAE_BYTE)alphas[0];
+	target[1] = (GAE_BYTE)alphas[1];
+	for (index = 0U; index < 3U; ++index) {
+		target[2U + index] = (GAE_BYTE)((bits[0] >> (index * 8U)) & 0xFFU);
+		target[5U + index] = (GAE_BYTE)((bits[1] >> (index * 8U)) & 0xFFU);
+	}
+}
+
+/* Individual mode only - each half's average as its base, with whichever table and flip fit best. */
+void encodeETC1Block(GAE_BYTE block[16][4], GAE_BYTE* target) {
+	unsigned long bestError = 0xFFFFFFFFUL;
+	unsigned int flip = 0U;
+
+	for (flip = 0U; flip < 2U; ++flip) {
+		unsigned int bases[2][3];
+		unsigned int tables[2] = { 0U, 0U };
+		unsigned int indices[16];
+		unsigned long error = 0UL;
+		unsigned int half = 0U;
+
+		for (half = 0U; half < 2U; ++half) {
+			unsigned long halfError = 0xFFFFFFFFUL;
+			unsigned int sums[3] = { 0U, 0U, 0U };
+			unsigned int table = 0U;
+			unsigned int pixel = 0U;
+			unsigned int channel = 0U;
+
+			for (pixel = 0U; pixel < 16U; ++pixel) {
+				const unsigned int pixelHalf = (1U == flip) ? ((2U <= pixel / 4U) ? 1U : 0U) : ((2U <= pixel % 4U) ? 1U : 0U);
+				if (half == pixelHalf) {
+					for (channel = 0U; channel < 3U; ++channel)
+						sums[channel] += block[pixel][channel];
+				}
+			}
+
+			for (channel = 0U; channel < 3U; ++channel)
+				bases[half][channel] = ((sums[channel] + 4U) / 8U * 15U + 127U) / 255U;
+
+			for (table = 0U; table < 8U; ++table) {
+				unsigned int tableIndices[16];
+				unsigned long tableError = 0UL;
+
+				for (pixel = 0U; pixel < 16U; ++pixel) {
+					const unsigned int pixelHalf = (1U == flip) ? ((2U <= pixel / 4U) ? 1U : 0U) : ((2U <= pixel % 4U) ? 1U : 0U);
+					unsigned int bestDistance = 0xFFFFFFFFU;
+					unsigned int index = 0U;
+
+					if (half != pixelHalf)
+						continue;
+
+					for (index = 0U; index < 4U; ++index) {
+						const int modifier = (2U <= index) ? -ETC1_MODIFIERS[table][index - 2U] : ETC1_MODIFIERS[table][index];
+						int colour[3];
+						unsigned int distance = 0U;
+
+						for (channel = 0U; channel < 3U; ++channel)
+							colour[channel] = clampColour((int)(bases[half][channel] * 17U) + modifier);
+						distance = colourDistance(block[pixel], colour);
+						if (distance < bestDistance) {
+							bestDistance = distance;
+							tableIndices[pixel] = index;
+						}
+					}
+					tableError += bestDistance;
+				}
+
+				if (tableError < halfError) {
+					halfError = tableError;
+					tables[half] = table;
+					for (pixel = 0U; pixel < 16U; ++pixel) {
+						const unsigned int pixelHalf = (1U == flip) ? ((2U <= pixel / 4U) ? 1U : 0U) : ((2U <= pixel % 4U) ? 1U : 0U);
+						if (half == pixelHalf)
+							indices[pixel] = tableIndices[pixel];
+					}
+				}
+			}
+
+			error += halfError;
+		}
+
+		if (error < bestError) {
+			unsigned int msb = 0U;
+			unsigned int lsb = 0U;
+			unsigned int pixel = 0U;
+
+			bestError = error;
+			/* pixel indices are stored column major, most significant bits first */
+			for (pixel = 0U; pixel < 16U; ++pixel) {
+				const unsigned int bit = (pixel % 4U) * 4U + pixel / 4U;
+				msb |= (indices[pixel] >> 1U) << bit;
+				lsb |= (indices[pixel] & 0x1U) << bit;
+			}
+
+			target[0] = (GAE_BYTE)((bases[0][0] << 4U) | bases[1][0]);
+			target[1] = (GAE_BYTE)((bases[0][1] << 4U) | bases[1][1]);
+			target[2] = (GAE_BYTE)((bases[0][2] << 4U) | bases[1][2]);
+			target[3] = (GAE_BYTE)((tables[0] << 5U) | (tables[1] << 2U) | flip);
+			target[4] = (GAE_BYTE)(msb >> 8U);
+			target[5] = (GAE_BYTE)(msb & 0xFFU);
+			target[6] = (GAE_BYTE)(lsb >> 8U);
+			target[7] = (GAE_BYTE)(lsb & 0xFFU);
+		}
+	}
+}
+
+void decodeReference(const GAE_CompressedTexture_Format format, const GAE_BYTE* data, const unsigned int width, const unsigned int height, GAE_BYTE* rgba) {
+	const GAE_BYTE* block = data;
+	unsigned int blockX = 0U;
+	unsigned int blockY = 0U;
+
+	for (blockY = 0U; blockY < height; blockY += 4U) {
+		for (blockX = 0U; blockX < width; blockX += 4U) {
+			GAE_BYTE colours[16][4];
+			unsigned int x = 0U;
+			unsigned int y = 0U;
+
+			switch (format) {
+				case GAE_COMPRESSED_TEXTURE_FORMAT_DXT1: {
+					decodeReferenceColour(block, colours, GAE_TRUE);
+					block += 8U;
+				}
+				break;
+				case GAE_COMPRESSED_TEXTURE_FORMAT_DXT5: {
+					decodeReferenceColour(block + 8U, colours, GAE_FALSE);
+					decodeReferenceAlpha(block, colours);
+					block += 16U;
+				}
+				break;
+				case GAE_COMPRESSED_TEXTURE_FORMAT_ETC1: {
+					decodeReferenceETC1(block, colours);
+					block += 8U;
+				}
+				break;
+				case GAE_COMPRESSED_TEXTURE_FORMAT_INVALID:
+				default:
+					return;
+			}
+
+			for (y = 0U; (y < 4U) && (blockY + y < height); ++y) {
+				for (x = 0U; (x < 4U) && (blockX + x < width); ++x)
+					memcpy(rgba + ((unsigned long)(blockY + y) * width + blockX + x) * 4U, colours[y * 4U + x], 4U);
+			}
+		}
+	}
+}
+
+/* As EXT_texture_compression_s3tc gives it - DXT5's colours are always read in four colour mode. */
+void decodeReferenceColour(const GAE_BYTE* block, GAE_BYTE colours[16][4], const GAE_BOOL hasPunchThrough) {
+	const unsigned int colour0 = (unsigned int)block[0] | ((unsigned int)block[1] << 8U);
+	const unsigned int colour1 = (unsigned int)block[2] | ((unsigned int)block[3] << 8U);
+	const unsigned int indices = (unsigned int)block[4] | ((unsigned int)block[5] << 8U) | ((unsigned int)block[6] << 16U) | ((unsigned int)block[7] << 24U);
+	const GAE_BOOL isFourColour = ((GAE_FALSE == hasPunchThrough) || (colour0 > colour1)) ? GAE_TRUE : GAE_FALSE;
+	int palette[4][3];
+	unsigned int channel = 0U;
+	unsigned int pixel = 0U;
+
+	expand565(colour0, palette[0]);
+	expand565(colour1, palette[1]);
+	for (channel = 0U; channel < 3U; ++channel) {
+		if (GAE_TRUE == isFourColour) {
+			palette[2][channel] = (2 * palette[0][channel] + palette[1][channel] + 1) / 3;
+			palette[3][channel] = (palette[0][channel] + 2 * palette[1][channel] + 1) / 3;
+		}
+		else {
+			palette[2][channel] = (palette[0][channel] + palette[1][channel] + 1) / 2;
+			palette[3][channel] = 0;
+		}
+	}
+
+	for (pixel = 0U; pixel < 16U; ++pixel) {
+		const unsigned int index = (indices >> (pixel * 2U)) & 0x3U;
+
+		for (channel = 0U; channel < 3U; ++channel)
+			colours[pixel][channel] = (GAE_BYTE)palette[index][channel];
+		colours[pixel][3] = ((GAE_FALSE == isFourColour) && (3U == index)) ? 0U : 255U;
+	}
+}
+
+void decodeReferenceAlpha(const GAE_BYTE* block, GAE_BYTE colours[16][4]) {
+	const unsigned int alpha0 = block[0];
+	const unsigned int alpha1 = block[1];
+	unsigned int pixel = 0U;
+
+	for (pixel = 0U; pixel < 16U; ++pixel) {
+		/* 48 bits of 3 bit indices, little endian from the third byte */
+		const unsigned int bit = pixel * 3U;
+		const unsigned int index = (((unsigned int)block[2U + bit / 8U] | ((2U + bit / 8U + 1U < 8U) ? (unsigned int)block[2U + bit / 8U + 1U] << 8U : 0U)) >> (bit % 8U)) & 0x7U;
+		unsigned int alpha = 0U;
+
+		if (0U == index)
+			alpha = alpha0;
+		else if (1U == index)
+			alpha = alpha1;
+		else if (alpha0 > alpha1)
+			alpha = ((8U - index) * alpha0 + (index - 1U) * alpha1 + 3U) / 7U;
+		else if (6U == index)
+			alpha = 0U;
+		else if (7U == index)
+			alpha = 255U;
+		else
+			alpha = ((6U - index) * alpha0 + (index - 1U) * alpha1 + 2U) / 5U;
+
+		colours[pixel][3] = (GAE_BYTE)alpha;
+	}
+}
+
+/* As OES_compressed_ETC1_RGB8_texture gives it, differential mode included. */
+void decodeReferenceETC1(const GAE_BYTE* block, GAE_BYTE colours[16][4]) {
+	const unsigned int tables[2] = { (unsigned int)block[3] >> 5U, ((unsigned int)block[3] >> 2U) & 0x7U };
+	const GAE_BOOL isDifferential = (0U != (block[3] & 0x2U)) ? GAE_TRUE : GAE_FALSE;
+	const GAE_BOOL isFlipped = (0U != (block[3] & 0x1U)) ? GAE_TRUE : GAE_FALSE;
+	int bases[2][3];
+	unsigned int channel = 0U;
+	unsigned int pixel = 0U;
+
+	for (channel = 0U; channel < 3U; ++channel) {
+		if (GAE_TRUE == isDifferential) {
+			const int first = block[channel] >> 3;
+			const int delta = ((block[channel] & 0x4) != 0) ? (int)(block[channel] & 0x7) - 8 : (int)(block[channel] & 0x7);
+			const int second = first + delta;
+
+			bases[0][channel] = (first << 3) | (first >> 2);
+			bases[1][channel] = (second << 3) | (second >> 2);
+		}
+		else {
+			bases[0][channel] = (block[channel] >> 4) * 17;
+			bases[1][channel] = (block[channel] & 0xF) * 17;
+		}
+	}
+
+	for (pixel = 0U; pixel < 16U; ++pixel) {
+		const unsigned int x = pixel % 4U;
+		const unsigned int y = pixel / 4U;
+		const unsigned int bit = x * 4U + y;
+		const unsigned int half = (GAE_TRUE == isFlipped) ? y / 2U : x / 2U;
+		const unsigned int msb = ((((unsigned int)block[4] << 8U) | block[5]) >> bit) & 0x1U;
+		const unsigned int lsb = ((((unsigned int)block[6] << 8U) | block[7]) >> bit) & 0x1U;
+		const int magnitude = ETC1_MODIFIERS[tables[half]][lsb];
+		const int modifier = (1U == msb) ? -magnitude : magnitude;
+
+		for (channel = 0U; channel < 3U; ++channel)
+			colours[pixel][channel] = (GAE_BYTE)clampColour(bases[half][channel] + modifier);
+		colours[pixel][3] = 255U;
+	}
+}
+
+/* Bit replicated, so the ends of the range stay at 0 and 255. */
+void expand565(const unsigned int colour, int rgb[3]) {
+	const int red = (int)((colour >> 11U) & 0x1FU);
+	const int green = (int)((colour >> 5U) & 0x3FU);
+	const int blue = (int)(colour & 0x1FU);
+
+	rgb[0] = (red << 3) | (red >> 2);
+	rgb[1] = (green << 2) | (green >> 4);
+	rgb[2] = (blue << 3) | (blue >> 2);
+}
+
+int clampColour(const int value) {
+	return (0 > value) ? 0 : ((255 < value) ? 255 : value);
+}
+
+unsigned int colourDistance(const GAE_BYTE* a, const int* b) {
+	const int red = (int)a[0] - b[0];
+	const int green = (int)a[1] - b[1];
+	const int blue = (int)a[2] - b[2];
+
+	return (unsigned int)(red * red + green * green + blue * blue);
+}
+
+void writeUint32(FILE* file, const unsigned int value) {
+	fputc((int)(value & 0xFFU), file);
+	fputc((int)((value >> 8U) & 0xFFU), file);
+	fputc((int)((value >> 16U) & 0xFFU), file);
+	fputc((int)(value >> 24U), file);
+}
+
+/* Uncompressed 32 bit, top row first, stored BGRA. */
+GAE_BOOL writeTGA(const char* const path, const Image_t* image) {
+	FILE* file = fopen(path, "wb");
+	GAE_BYTE header[18];
+	unsigned long pixel = 0UL;
+	GAE_BOOL status = GAE_TRUE;
+
+	if (0 == file) {
+		fprintf(stderr, "Failed to create %s\n", path);
+		return GAE_FALSE;
+	}
+
+	memset(header, 0, sizeof(header));
+	header[2] = 2U;
+	header[12] = (GAE_BYTE)(image->width & 0xFFU);
+	header[13] = (GAE_BYTE)(image->width >> 8U);
+	header[14] = (GAE_BYTE)(image->height & 0xFFU);
+	header[15] = (GAE_BYTE)(image->height >> 8U);
+	header[16] = 32U;
+	header[17] = 0x28U;
+	fwrite(header, 1U, sizeof(header), file);
+
+	for (pixel = 0UL; pixel < (unsigned long)image->width * image->height; ++pixel) {
+		const GAE_BYTE* source = image->pixels + pixel * 4UL;
+		const GAE_BYTE bgra[4] = { source[2], source[1], source[0], source[3] };
+		fwrite(bgra, 1U, 4U, file);
+	}
+
+	if (0 != ferror(file))
+		status = GAE_FALSE;
+	if (0 != fclose(file))
+		status = GAE_FALSE;
+	if (GAE_FALSE == status)
+		fprintf(stderr, "Failed to write %s\n", path);
+
+	return status;
+}
+
+/* DXT goes in a DDS, ETC1 in a KTX, as the tools that make them usually write them. */
+GAE_BOOL writeCompressed(const char* const path, const unsigned int formatIndex, GAE_BYTE** levels, const unsigned long* sizes, const Image_t* images, const unsigned int levelCount) {
+	FILE* file = fopen(path, "wb");
+	unsigned int level = 0U;
+	unsigned int index = 0U;
+	GAE_BOOL status = GAE_TRUE;
+
+	if (0 == file) {
+		fprintf(stderr, "Failed to create %s\n", path);
+		return GAE_FALSE;
+	}
+
+	if (GAE_COMPRESSED_TEXTURE_FORMAT_ETC1 == FORMATS[formatIndex]) {
+		fwrite(KTX_IDENTIFIER, 1U, sizeof(KTX_IDENTIFIER), file);
+		writeUint32(file, 0x04030201U);
+		writeUint32(file, 0U); /* type, type size and format are 0 for compressed data, bar the size of 1 */
+		writeUint32(file, 1U);
+		writeUint32(file, 0U);
+		writeUint32(file, FORMAT_ENUMS[formatIndex]);
+		writeUint32(file, GL_RGB);
+		writeUint32(file, images[0].width);
+		writeUint32(file, images[0].height);
+		writeUint32(file, 0U);
+		writeUint32(file, 0U);
+		writeUint32(file, 1U);
+		writeUint32(file, levelCount);
+		writeUint32(file, 0U);
+
+		/* ETC1 levels are always whole blocks of 8 bytes, so never need padding */
+		for (level = 0U; level < levelCount; ++level) {
+			writeUint32(file, (unsigned int)sizes[level]);
+			fwrite(levels[level], 1U, sizes[level], file);
+		}
+	}
+	else {
+		fwrite("DDS ", 1U, 4U, file);
+		writeUint32(file, 124U);
+		writeUint32(file, 0x1U | 0x2U | 0x4U | 0x1000U | 0x20000U | 0x80000U); /* caps, height, width, pixel format, mip count, linear size */
+		writeUint32(file, images[0].height);
+		writeUint32(file, images[0].width);
+		writeUint32(file, (unsigned int)sizes[0]);
+		writeUint32(file, 0U);
+		writeUint32(file, levelCount);
+		for (index = 0U; index < 11U; ++index)
+			writeUint32(file, 0U);
+
+		writeUint32(file, 32U);
+		writeUint32(file, 0x4U); /* four CC */
+		fwrite((GAE_COMPRESSED_TEXTURE_FORMAT_DXT1 == FORMATS[formatIndex]) ? "DXT1" : "DXT5", 1U, 4U, file);
+		for (index = 0U; index < 5U; ++index)
+			writeUint32(file, 0U);
+
+		writeUint32(file, 0x1000U | 0x400000U | 0x8U); /* texture, mipmap, complex */
+		for (index = 0U; index < 4U; ++index)
+			writeUint32(file, 0U);
+
+		for (level = 0U; level < levelCount; ++level)
+			fwrite(levels[level], 1U, sizes[level], file);
+	}
+
+	if (0 != ferror(file))
+		status = GAE_FALSE;
+	if (0 != fclose(file))
+		status = GAE_FALSE;
+	if (GAE_FALSE == status)
+		fprintf(stderr, "Failed to write %s\n", path);
+
+	return status;
+}
+
+/* Loads the file as a game would, trilinear filtered - any compressed format will do, as the container has the last word. */
+GAE_Texture_t* loadTexture(const char* const path, const GAE_GL_Texture_Format format) {
+	GAE_Texture_t* texture = GAE_Texture_createFromFile(GAE_File_create(path));
+	GAE_GL_Texture_t* platform = (GAE_GL_Texture_t*)texture->platform;
+
+	platform->format = format;
+	platform->filter = GAE_GL_TEXTURE_FILTER_TRILINEAR;
+	if ((GAE_FALSE == GAE_Texture_load(texture, GAE_FALSE)) || (GL_INVALID_VALUE == platform->id)) {
+		fprintf(stderr, "Failed to load %s\n", path);
+		GAE_Texture_delete(texture);
+		return 0;
+	}
+
+	return texture;
+}
+
+double timeLoads(const char* const path, const GAE_GL_Texture_Format format, const unsigned int iterations) {
+	double elapsed = 0.0;
+	unsigned int iteration = 0U;
+
+	GAE_MockGL_setRecording(GAE_FALSE);
+	for (iteration = 0U; iteration < iterations; ++iteration) {
+		const clock_t start = clock();
+		GAE_Texture_t* texture = loadTexture(path, format);
+
+		elapsed += (double)(clock() - start) / (double)CLOCKS_PER_SEC;
+		if (0 != texture)
+			GAE_Texture_delete(texture);
+	}
+	GAE_MockGL_setRecording(GAE_TRUE);
+
+	return elapsed / (double)iterations;
+}
+
+GAE_BOOL checkTexture(const char* const path, const unsigned int formatIndex, GAE_BYTE** levels, const unsigned long* sizes, const Image_t* images, const unsigned int levelCount, unsigned int* maxDifference) {
+	const unsigned int tolerance = (GAE_COMPRESSED_TEXTURE_FORMAT_ETC1 == FORMATS[formatIndex]) ? 0U : DXT_TOLERANCE;
+	GAE_Texture_t* texture = 0;
+	GAE_BYTE* reference = malloc((unsigned long)images[0].width * images[0].height * 4UL);
+	GAE_BOOL status = GAE_TRUE;
+	unsigned int level = 0U;
+
+	*maxDifference = 0U;
+	GAE_MockGL_setKeepingImages(GAE_TRUE);
+
+	/* with the extension, every level goes to GL untouched */
+	GAE_MockGL_setExtensions(EXTENSIONS);
+	texture = loadTexture(path, GAE_GL_TEXTURE_FORMAT_DXT1);
+	status = (0 != texture) ? GAE_TRUE : GAE_FALSE;
+	for (level = 0U; (level < levelCount) && (GAE_TRUE == status); ++level) {
+		GLenum format = GL_NONE;
+		unsigned long size = 0UL;
+		const GAE_BYTE* uploaded = GAE_MockGL_getTextureImage(((GAE_GL_Texture_t*)texture->platform)->id, (GLint)level, &format, &size);
+
+		if ((0 == uploaded) || (FORMAT_ENUMS[formatIndex] != format) || (sizes[level] != size) || (0 != memcmp(uploaded, levels[level], size))) {
+			fprintf(stderr, "%s: level %u didn't reach glCompressedTexImage2D as it was written\n", path, level);
+			status = GAE_FALSE;
+		}
+	}
+	if (0 != texture)
+		GAE_Texture_delete(texture);
+
+	/* without it, every level is decoded on the CPU, so has to match the reference decoding those same blocks */
+	if (GAE_TRUE == status) {
+		GAE_MockGL_setExtensions("");
+		texture = loadTexture(path, GAE_GL_TEXTURE_FORMAT_DXT1);
+		status = (0 != texture) ? GAE_TRUE : GAE_FALSE;
+	}
+	for (level = 0U; (level < levelCount) && (GAE_TRUE == status); ++level) {
+		const unsigned long size = (unsigned long)images[level].width * images[level].height * 4UL;
+		GLenum format = GL_NONE;
+		unsigned long uploadedSize = 0UL;
+		const GAE_BYTE* uploaded = GAE_MockGL_getTextureImage(((GAE_GL_Texture_t*)texture->platform)->id, (GLint)level, &format, &uploadedSize);
+		unsigned long index = 0UL;
+
+		if ((0 == uploaded) || (GL_RGBA != format) || (size != uploadedSize)) {
+			fprintf(stderr, "%s: level %u wasn't decoded to RGBA\n", path, level);
+			status = GAE_FALSE;
+			break;
+		}
+
+		decodeReference(FORMATS[formatIndex], levels[level], images[level].width, images[level].height, reference);
+		for (index = 0UL; index < size; ++index) {
+			const unsigned int difference = (uploaded[index] > reference[index]) ? uploaded[index] - reference[index] : reference[index] - uploaded[index];
+			if (difference > *maxDifference)
+				*maxDifference = difference;
+		}
+
+		if (*maxDifference > tolerance) {
+			fprintf(stderr, "%s: level %u decoded on the CPU is %u from the reference decoder, more than %u\n", path, level, *maxDifference, tolerance);
+			status = GAE_FALSE;
+		}
+	}
+	if (0 != texture)
+		GAE_Texture_delete(texture);
+
+	GAE_MockGL_setKeepingImages(GAE_FALSE);
+	free(reference);
+	return status;
+}
+
+/* Of the top level decoded against the original, over RGB - and alpha too where the format keeps it. */
+double getPSNR(const Image_t* image, const GAE_BYTE* decoded, const GAE_BOOL hasAlpha) {
+	const unsigned int channels = (GAE_TRUE == hasAlpha) ? 4U : 3U;
+	const unsigned long pixels = (unsigned long)image->width * image->height;
+	double error = 0.0;
+	unsigned long pixel = 0UL;
+	unsigned int channel = 0U;
+
+	for (pixel = 0UL; pixel < pixels; ++pixel) {
+		for (channel = 0U; channel < channels; ++channel) {
+			const double difference = (double)image->pixels[pixel * 4UL + channel] - (double)decoded[pixel * 4UL + channel];
+			error += difference * difference;
+		}
+	}
+
+	error /= (double)(pixels * channels);
+	return (0.0 < error) ? 10.0 * log10(255.0 * 255.0 / error) : 99.0;
+}
@@ -0,0 +1,251 @@
+/* Compressor - compresses each input into the block format GAE_File_open decompresses as it reads (see File/Compressed.h),
+ * so a compressed asset can stand in for the original without whatever loads it knowing.
+ * Blocks are LZ4 unless -zstd gives a Zstandard level, from 1 to 22, which packs smaller but is slower to unpack - the engine only decodes Zstandard,
+ * so that needs the tool built with COMPRESSOR_ZSTD, against the system libzstd.
+ * Inputs are read through GAE_File, so one that's already compressed is recompressed from what it holds.
+ * With -bench, each original and its compressed copy are then loaded through GAE_File, whole and in 64KB pieces,
+ * with the page cache dropped for each pass where the platform allows, and the time taken printed beside the CPU time spent,
+ * which counts every thread decompressing.
+ * Usage: compressor [-block KILOBYTES] [-zstd LEVEL] [-bench ITERATIONS] input output [input output ...]
+ */
+
+#if defined(LINUX) || defined(PANDORA)
+	/* posix_fadvise */
+	#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(LINUX) || defined(PANDORA)
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+#if defined(COMPRESSOR_ZSTD)
+	#include <zstd.h>
+#endif
+
+#include "../../GAE_Types.h"
+#include "../../File/File.h"
+#include "../../File/Compressed.h"
+#include "../../Time/Clock.h"
+
+#define PIECE_SIZE 65536UL
+
+typedef struct Timings_s {
+	float time;
+	float cpuTime;
+	unsigned long sum;
+} Timings_t;
+
+static void printUsage(const char* name);
+static GAE_BOOL compressFile(const char* const input, const char* const output, const unsigned long blockSize, int zstdLevel);
+#if defined(COMPRESSOR_ZSTD)
+static unsigned long packZstd(void* packer, const GAE_BYTE* const source, const unsigned long size, GAE_BYTE* destination, const unsigned long capacity);
+#endif
+static void dropCache(const char* path);
+static GAE_BOOL loadFile(const char* const path, const GAE_BOOL isPieces, GAE_BYTE* piece, GAE_Clock_t* timer, Timings_t* timings);
+static void benchmark(const char* const input, const char* const output, const unsigned int iterations);
+
+int main(int argc, char** argv) {
+	unsigned long blockSize = GAE_COMPRESSED_BLOCK_SIZE;
+	unsigned int iterations = 0U;
+	int zstdLevel = 0;
+	GAE_BOOL status = GAE_TRUE;
+	int first = 0;
+	int arg = 1;
+
+	while ((arg < argc) && ('-' == argv[arg][0])) {
+		if ((0 == strcmp(argv[arg], "-block")) && (arg + 1 < argc))
+			blockSize = strtoul(argv[++arg], 0, 10) * 1024UL;
+		else if ((0 == strcmp(argv[arg], "-zstd")) && (arg + 1 < argc))
+			zstdLevel = atoi(argv[++arg]);
+		else if ((0 == strcmp(argv[arg], "-bench")) && (arg + 1 < argc))
+			iterations = (unsigned int)strtoul(argv[++arg], 0, 10);
+		else {
+			printUsage(argv[0]);
+			return 1;
+		}
+		++arg;
+	}
+
+	if ((arg >= argc) || (0 != (argc - arg) % 2) || (0UL == blockSize) || (GAE_COMPRESSED_MAX_BLOCK_SIZE < blockSize) || (0 > zstdLevel) || (22 < zstdLevel)) {
+		printUsage(argv[0]);
+		return 1;
+	}
+
+#if !defined(COMPRESSOR_ZSTD)
+	if (0 != zstdLevel) {
+		fprintf(stderr, "Built without Zstandard - configure with COMPRESSOR_ZSTD for -zstd\n");
+		return 1;
+	}
+#endif
+
+	first = arg;
+	for (; (arg < argc) && (GAE_TRUE == status); arg += 2)
+		status = compressFile(argv[arg], argv[arg + 1], blockSize, zstdLevel);
+
+	if ((GAE_TRUE == status) && (0U < iterations)) {
+		for (arg = first; arg < argc; arg += 2)
+			benchmark(argv[arg], argv[arg + 1], iterations);
+	}
+
+	return (GAE_TRUE == status) ? 0 : 1;
+}
+
+void printUsage(const char* name) {
+	fprintf(stderr, "Usage: %s [-block KILOBYTES] [-zstd LEVEL] [-bench ITERATIONS] input output [input output ...]\n", name);
+}
+
+GAE_BOOL compressFile(const char* const input, const char* const output, const unsigned long blockSize, int zstdLevel) {
+	GAE_File_t* file = GAE_File_create(input);
+	GAE_FILE_STATUS fileStatus = GAE_FILE_ERROR;
+	GAE_FILE_READ_STATUS readStatus = GAE_FILE_READ_ERROR;
+	GAE_BYTE* compressed = 0;
+	unsigned long compressedSize = 0UL;
+	FILE* outputFile = 0;
+	GAE_BOOL status = GAE_FALSE;
+
+	GAE_File_open(file, GAE_FILE_OPEN_READ, GAE_FILE_BINARY, &fileStatus);
+	if (GAE_FILE_OPEN == fileStatus)
+		GAE_File_read(file, GAE_FILE_READ_ALL, &readStatus);
+	GAE_File_close(file, GAE_FILE_CLOSE_RETAIN_DATA, 0);
+
+	if (GAE_FILE_READ_ERROR == readStatus) {
+		fprintf(stderr, "Failed to read %s\n", input);
+		GAE_File_delete(file);
+		return GAE_FALSE;
+	}
+
+#if defined(COMPRESSOR_ZSTD)
+	if (0 != zstdLevel)
+		compressed = GAE_Compressed_compressWith(GAE_COMPRESSED_CODEC_ZSTD, packZstd, &zstdLevel, file->buffer, file->bufferSize, blockSize, &compressedSize);
+	else
+		compressed = GAE_Compressed_compress(file->buffer, file->bufferSize, blockSize, &compressedSize);
+#else
+	(void)zstdLevel;
+	compressed = GAE_Compressed_compress(file->buffer, file->bufferSize, blockSize, &compressedSize);
+#endif
+	if (0 == compressed)
+		fprintf(stderr, "%s is too large to compress\n", input);
+	else {
+		outputFile = fopen(output, "wb");
+		if (0 != outputFile) {
+			status = (compressedSize == fwrite(compressed, 1U, compressedSize, outputFile)) ? GAE_TRUE : GAE_FALSE;
+			if (0 != fclose(outputFile))
+				status = GAE_FALSE;
+		}
+
+		if (GAE_FALSE == status)
+			fprintf(stderr, "Failed to write %s\n", output);
+		else
+			printf("%s: %lu bytes into %lu - %.1f%%\n", input, file->bufferSize, compressedSize, (0UL < file->bufferSize) ? 100.0 * (double)compressedSize / (double)file->bufferSize : 100.0);
+	}
+
+	free(compressed);
+	GAE_File_deleteBuffer(file, 0);
+	GAE_File_delete(file);
+	return status;
+}
+
+#if defined(COMPRESSOR_ZSTD)
+unsigned long packZstd(void* packer, const GAE_BYTE* const source, const unsigned long size, GAE_BYTE* destination, const unsigned long capacity) {
+	const size_t packedSize = ZSTD_compress(destination, capacity, source, size, *(int*)packer);
+	return (0U != ZSTD_isError(packedSize)) ? 0UL : (unsigned long)packedSize;
+}
+#endif
+
+void dropCache(const char* path) {
+#if defined(LINUX) || defined(PANDORA)
+	/* clean pages are dropped without needing root - anything still dirty is written out first */
+	const int descriptor = open(path, O_RDONLY);
+	if (-1 == descriptor)
+		return;
+
+	fdatasync(descriptor);
+	posix_fadvise(descriptor, 0, 0, POSIX_FADV_DONTNEED);
+	close(descriptor);
+#else
+	(void)path;
+#endif
+}
+
+GAE_BOOL loadFile(const char* const path, const GAE_BOOL isPieces, GAE_BYTE* piece, GAE_Clock_t* timer, Timings_t* timings) {
+	GAE_File_t* file = GAE_File_create(path);
+	GAE_FILE_STATUS fileStatus = GAE_FILE_ERROR;
+	GAE_FILE_READ_STATUS readStatus = GAE_FILE_READ_OK;
+	const clock_t cpuStart = clock();
+	unsigned long offset = 0UL;
+
+	GAE_Clock_reset(timer);
+	GAE_File_open(file, GAE_FILE_OPEN_READ, GAE_FILE_BINARY, &fileStatus);
+	if (GAE_FILE_OPEN != fileStatus) {
+		GAE_File_delete(file);
+		return GAE_FALSE;
+	}
+
+	/* every page touched once, as whatever loaded it would */
+	if (GAE_FALSE == isPieces) {
+		GAE_File_read(file, GAE_FILE_READ_ALL, &readStatus);
+		for (offset = 0UL; offset < file->bufferSize; offset += 4096UL)
+			timings->sum += file->buffer[offset];
+	}
+	else {
+		while (GAE_FILE_READ_OK == readStatus) {
+			unsigned long got = 0UL;
+			GAE_File_readInto(file, piece, PIECE_SIZE, &got, &readStatus);
+			for (offset = 0UL; offset < got; offset += 4096UL)
+				timings->sum += piece[offset];
+		}
+	}
+
+	GAE_File_close(file, GAE_FILE_CLOSE_DELETE_DATA, 0);
+	GAE_Clock_update(timer);
+	timings->time += timer->deltaTime;
+	timings->cpuTime += (float)(clock() - cpuStart) / (float)CLOCKS_PER_SEC;
+
+	GAE_File_delete(file);
+	return (GAE_FILE_READ_ERROR != readStatus) ? GAE_TRUE : GAE_FALSE;
+}
+
+void benchmark(const char* const input, const char* const output, const unsigned int iterations) {
+	GAE_Clock_t* timer = GAE_Clock_create();
+	GAE_BYTE* piece = malloc(PIECE_SIZE);
+	Timings_t timings[4];
+	const char* paths[2];
+	unsigned int iteration = 0U;
+	unsigned int index = 0U;
+	GAE_BOOL status = GAE_TRUE;
+
+	paths[0] = input;
+	paths[1] = output;
+	memset(timings, 0, sizeof(timings));
+
+	/* original whole, compressed whole, original in pieces, compressed in pieces */
+	for (iteration = 0U; (iteration < iterations) && (GAE_TRUE == status); ++iteration) {
+		for (index = 0U; (index < 4U) && (GAE_TRUE == status); ++index) {
+			dropCache(paths[index % 2U]);
+			status = loadFile(paths[index % 2U], (2U <= index) ? GAE_TRUE : GAE_FALSE, piece, timer, &timings[index]);
+		}
+	}
+
+	if (GAE_FALSE == status)
+		fprintf(stderr, "Failed to load %s or %s\n", input, output);
+	else {
+		if ((timings[0].sum != timings[1].sum) || (timings[2].sum != timings[3].sum))
+			fprintf(stderr, "%s doesn't decompress to %s\n", output, input);
+
+		printf("%s whole: %.3fms (%.3fms CPU), compressed %.3fms (%.3fms CPU)\n", input,
+			timings[0].time * 1000.0F / (float)iterations, timings[0].cpuTime * 1000.0F / (float)iterations,
+			timings[1].time * 1000.0F / (float)iterations, timings[1].cpuTime * 1000.0F / (float)iterations);
+		printf("%s pieces: %.3fms (%.3fms CPU), compressed %.3fms (%.3fms CPU)\n", input,
+			timings[2].time * 1000.0F / (float)iterations, timings[2].cpuTime * 1000.0F / (float)iterations,
+			timings[3].time * 1000.0F / (float)iterations, timings[3].cpuTime * 1000.0F / (float)iterations);
+	}
+
+	free(piece);
+	GAE_Clock_delete(timer);
+}
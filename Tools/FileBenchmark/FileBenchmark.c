@@ -0,0 +1,222 @@
+/* File benchmark - writes files of 1KB up to 256MB, then loads each through GAE_File, copied in with GAE_FILE_OPEN_READ
+ * and mapped with GAE_FILE_OPEN_MAP, and prints the time to load and the time to then touch every page of the buffer.
+ * Each is also read through in 64KB pieces, with GAE_File_read and with a read ahead GAE_Stream, and the time to get through it printed.
+ * The files are read back while still in the page cache, as assets loaded more than once a run would be.
+ * Usage: filebenchmark [-dir PATH] [-max KILOBYTES] [-iterations N]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../GAE_Types.h"
+#include "../../File/File.h"
+#include "../../File/Stream.h"
+#include "../../Time/Clock.h"
+
+#define MIN_SIZE 1024UL
+#define SIZE_STEP 4UL
+#define PAGE_SIZE 4096UL
+#define PIECE_SIZE 65536UL
+
+typedef struct Timings_s {
+	float load;
+	float touch;
+	unsigned long sum;
+} Timings_t;
+
+static void printUsage(const char* name);
+static GAE_BOOL writeFile(const char* const path, const unsigned long size);
+static GAE_BOOL loadFile(const char* const path, const GAE_FILE_OPEN_MODE mode, GAE_Clock_t* clock, Timings_t* timings);
+static GAE_BOOL readPieces(const char* const path, GAE_Clock_t* clock, Timings_t* timings);
+static GAE_BOOL streamPieces(const char* const path, GAE_BYTE* piece, GAE_Clock_t* clock, Timings_t* timings);
+
+int main(int argc, char** argv) {
+	const char* dir = "/tmp";
+	unsigned long maxSize = 256UL * 1024UL * 1024UL;
+	unsigned int iterations = 5U;
+	GAE_Clock_t* clock = 0;
+	GAE_BYTE* piece = 0;
+	unsigned long size = MIN_SIZE;
+	char path[1024];
+	int arg = 1;
+
+	for (; arg < argc; ++arg) {
+		if ((0 == strcmp(argv[arg], "-dir")) && (arg + 1 < argc))
+			dir = argv[++arg];
+		else if ((0 == strcmp(argv[arg], "-max")) && (arg + 1 < argc))
+			maxSize = strtoul(argv[++arg], 0, 10) * 1024UL;
+		else if ((0 == strcmp(argv[arg], "-iterations")) && (arg + 1 < argc))
+			iterations = (unsigned int)strtoul(argv[++arg], 0, 10);
+		else {
+			printUsage(argv[0]);
+			return 1;
+		}
+	}
+
+	if ((MIN_SIZE > maxSize) || (0U == iterations)) {
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	clock = GAE_Clock_create();
+	piece = malloc(PIECE_SIZE);
+	printf("%10s  %10s %10s  %10s %10s  %10s %10s\n", "size", "read load", "map load", "read touch", "map touch", "pieces", "streamed");
+	for (; size <= maxSize; size *= SIZE_STEP) {
+		Timings_t read = { 0.0F, 0.0F, 0UL };
+		Timings_t map = { 0.0F, 0.0F, 0UL };
+		Timings_t pieces = { 0.0F, 0.0F, 0UL };
+		Timings_t streamed = { 0.0F, 0.0F, 0UL };
+		unsigned int iteration = 0U;
+
+		sprintf(path, "%.1000s/filebenchmark-%lu.bin", dir, size);
+		if (GAE_FALSE == writeFile(path, size)) {
+			fprintf(stderr, "Failed to write %s\n", path);
+			free(piece);
+			GAE_Clock_delete(clock);
+			return 1;
+		}
+
+		/* alternate the two, so neither gets a warmer cache than the other */
+		for (iteration = 0U; iteration < iterations; ++iteration) {
+			if ((GAE_FALSE == loadFile(path, GAE_FILE_OPEN_READ, clock, &read))
+			|| (GAE_FALSE == loadFile(path, GAE_FILE_OPEN_MAP, clock, &map))
+			|| (GAE_FALSE == readPieces(path, clock, &pieces))
+			|| (GAE_FALSE == streamPieces(path, piece, clock, &streamed))) {
+				fprintf(stderr, "Failed to load %s\n", path);
+				remove(path);
+				free(piece);
+				GAE_Clock_delete(clock);
+				return 1;
+			}
+		}
+
+		if ((read.sum != map.sum) || (read.sum != pieces.sum) || (read.sum != streamed.sum))
+			fprintf(stderr, "Contents differ for %s\n", path);
+
+		printf("%8luKB  %8.3fms %8.3fms  %8.3fms %8.3fms  %8.3fms %8.3fms\n", size / 1024UL
+			, read.load * 1000.0F / (float)iterations, map.load * 1000.0F / (float)iterations
+			, read.touch * 1000.0F / (float)iterations, map.touch * 1000.0F / (float)iterations
+			, pieces.load * 1000.0F / (float)iterations, streamed.load * 1000.0F / (float)iterations);
+
+		remove(path);
+	}
+
+	free(piece);
+	GAE_Clock_delete(clock);
+	return 0;
+}
+
+void printUsage(const char* name) {
+	fprintf(stderr, "Usage: %s [-dir PATH] [-max KILOBYTES] [-iterations N]\n", name);
+}
+
+GAE_BOOL writeFile(const char* const path, const unsigned long size) {
+	FILE* file = fopen(path, "wb");
+	GAE_BYTE block[PAGE_SIZE];
+	unsigned long written = 0UL;
+	unsigned long index = 0UL;
+
+	if (0 == file)
+		return GAE_FALSE;
+
+	for (index = 0UL; index < PAGE_SIZE; ++index)
+		block[index] = (GAE_BYTE)(index * 31UL);
+
+	while (written < size) {
+		const unsigned long amount = (size - written < PAGE_SIZE) ? size - written : PAGE_SIZE;
+		if (amount != fwrite(block, 1U, amount, file)) {
+			fclose(file);
+			return GAE_FALSE;
+		}
+		written += amount;
+	}
+
+	fclose(file);
+	return GAE_TRUE;
+}
+
+GAE_BOOL loadFile(const char* const path, const GAE_FILE_OPEN_MODE mode, GAE_Clock_t* clock, Timings_t* timings) {
+	GAE_File_t* file = GAE_File_create(path);
+	GAE_FILE_STATUS fileStatus = GAE_FILE_ERROR;
+	GAE_FILE_READ_STATUS readStatus = GAE_FILE_READ_ERROR;
+	unsigned long index = 0UL;
+	unsigned long sum = 0UL;
+
+	GAE_Clock_reset(clock);
+	GAE_File_open(file, mode, GAE_FILE_BINARY, &fileStatus);
+	if (GAE_FILE_OPEN == fileStatus)
+		GAE_File_read(file, GAE_FILE_READ_ALL, &readStatus);
+	GAE_File_close(file, GAE_FILE_CLOSE_RETAIN_DATA, 0);
+	GAE_Clock_update(clock);
+	timings->load += clock->deltaTime;
+
+	if (GAE_FILE_READ_ERROR == readStatus) {
+		GAE_File_delete(file);
+		return GAE_FALSE;
+	}
+
+	/* one byte a page is enough to fault a mapping in - a copy has already paid for it */
+	GAE_Clock_reset(clock);
+	for (index = 0UL; index < file->bufferSize; index += PAGE_SIZE)
+		sum += file->buffer[index];
+	GAE_Clock_update(clock);
+	timings->touch += clock->deltaTime;
+	timings->sum += sum;
+
+	GAE_File_deleteBuffer(file, 0);
+	GAE_File_delete(file);
+	return GAE_TRUE;
+}
+
+GAE_BOOL readPieces(const char* const path, GAE_Clock_t* clock, Timings_t* timings) {
+	GAE_File_t* file = GAE_File_create(path);
+	GAE_FILE_STATUS fileStatus = GAE_FILE_ERROR;
+	GAE_FILE_READ_STATUS readStatus = GAE_FILE_READ_OK;
+	unsigned long index = 0UL;
+	unsigned long sum = 0UL;
+
+	GAE_Clock_reset(clock);
+	GAE_File_open(file, GAE_FILE_OPEN_READ, GAE_FILE_BINARY, &fileStatus);
+	if (GAE_FILE_OPEN != fileStatus)
+		readStatus = GAE_FILE_READ_ERROR;
+
+	/* every piece is a fresh buffer */
+	while ((GAE_FILE_READ_OK == readStatus) && (file->readPosition < file->fileSize)) {
+		GAE_File_read(file, PIECE_SIZE, &readStatus);
+		for (index = 0UL; index < file->bufferSize; index += PAGE_SIZE)
+			sum += file->buffer[index];
+	}
+	GAE_File_close(file, GAE_FILE_CLOSE_DELETE_DATA, 0);
+	GAE_Clock_update(clock);
+	timings->load += clock->deltaTime;
+	timings->sum += sum;
+
+	GAE_File_delete(file);
+	return (GAE_FILE_READ_ERROR != readStatus) ? GAE_TRUE : GAE_FALSE;
+}
+
+GAE_BOOL streamPieces(const char* const path, GAE_BYTE* piece, GAE_Clock_t* clock, Timings_t* timings) {
+	GAE_Stream_t* stream = 0;
+	GAE_FILE_READ_STATUS readStatus = GAE_FILE_READ_OK;
+	unsigned long readAmount = PIECE_SIZE;
+	unsigned long index = 0UL;
+	unsigned long sum = 0UL;
+
+	GAE_Clock_reset(clock);
+	stream = GAE_Stream_create(path, 0, 4UL * PIECE_SIZE, GAE_TRUE);
+	if (0 == stream)
+		return GAE_FALSE;
+
+	while ((GAE_FILE_READ_OK == readStatus) && (PIECE_SIZE == readAmount)) {
+		GAE_Stream_read(stream, piece, PIECE_SIZE, &readAmount, &readStatus);
+		for (index = 0UL; index < readAmount; index += PAGE_SIZE)
+			sum += piece[index];
+	}
+	GAE_Stream_delete(stream);
+	GAE_Clock_update(clock);
+	timings->load += clock->deltaTime;
+	timings->sum += sum;
+
+	return (GAE_FILE_READ_ERROR != readStatus) ? GAE_TRUE : GAE_FALSE;
+}
@@ -0,0 +1,451 @@
+/* Offline mesh converter - turns a Wavefront OBJ into a binary mesh (see Graphics/MeshFile.h)
+ * with interleaved position/texture/normal vertices, shared corners welded, and the
+ * triangles reordered for the post transform cache.
+ * -bench N times N loads of the OBJ against N loads of the converted mesh.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../../GAE_Types.h"
+#include "../../File/File.h"
+#include "../../Graphics/MeshFile.h"
+#include "../../Graphics/MeshOptimiser.h"
+#include "../../Graphics/VertexBuffer.h"
+#include "../../Graphics/IndexBuffer.h"
+
+#define INVALID_SLOT 0xFFFFFFFFU
+
+typedef struct FloatArray_s {
+	float* data;
+	unsigned int count;
+	unsigned int allocated;
+} FloatArray_t;
+
+typedef struct UintArray_s {
+	unsigned int* data;
+	unsigned int count;
+	unsigned int allocated;
+} UintArray_t;
+
+typedef struct Corner_s {
+	int position;
+	int texCoord;
+	int normal;
+	unsigned int vertex;
+} Corner_t;
+
+typedef struct ObjMesh_s {
+	FloatArray_t vertices;	/* interleaved, floatsPerVertex apart */
+	UintArray_t indices;
+	unsigned int floatsPerVertex;
+	GAE_BOOL hasTexCoords;
+	GAE_BOOL hasNormals;
+} ObjMesh_t;
+
+static void printUsage(const char* name);
+static char* readText(const char* path, unsigned long* size);
+static void pushFloat(FloatArray_t* array, const float value);
+static void pushUint(UintArray_t* array, const unsigned int value);
+static unsigned int hashCorner(const Corner_t* corner);
+static GAE_BOOL parseObj(const char* text, ObjMesh_t* mesh);
+static const char* parseCorner(const char* cursor, Corner_t* corner);
+static int resolveIndex(const int index, const unsigned int count);
+static void deleteObj(ObjMesh_t* mesh);
+static GAE_BOOL writeUint32(FILE* file, const unsigned int value);
+static GAE_BOOL writeMesh(const char* path, GAE_VertexBuffer_t* vertexBuffer, GAE_IndexBuffer_t* indexBuffer, const unsigned int vertexCount);
+static void benchmark(const char* text, const char* meshPath, const unsigned int iterations);
+
+int main(int argc, char** argv) {
+	ObjMesh_t mesh;
+	GAE_VertexBuffer_t* vertexBuffer = 0;
+	GAE_IndexBuffer_t* indexBuffer = 0;
+	GAE_MeshOptimiser_Stats_t stats;
+	GAE_BOOL optimise = GAE_TRUE;
+	GAE_BOOL written = GAE_FALSE;
+	unsigned int iterations = 0U;
+	unsigned int vertexCount = 0U;
+	unsigned long size = 0UL;
+	char* text = 0;
+	int arg = 1;
+
+	while ((arg < argc) && ('-' == argv[arg][0])) {
+		if (0 == strcmp(argv[arg], "-nooptimise"))
+			optimise = GAE_FALSE;
+		else if ((0 == strcmp(argv[arg], "-bench")) && (arg + 1 < argc))
+			iterations = (unsigned int)strtoul(argv[++arg], 0, 10);
+		else {
+			printUsage(argv[0]);
+			return 1;
+		}
+		++arg;
+	}
+
+	if (arg + 2 != argc) {
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	text = readText(argv[arg], &size);
+	if ((0 == text) || (GAE_FALSE == parseObj(text, &mesh))) {
+		fprintf(stderr, "Failed to load OBJ: %s\n", argv[arg]);
+		free(text);
+		return 1;
+	}
+
+	vertexCount = mesh.vertices.count / mesh.floatsPerVertex;
+	vertexBuffer = GAE_VertexBuffer_create((GAE_BYTE*)mesh.vertices.data, mesh.vertices.count * sizeof(float), GAE_VERTEXBUFFER_TYPE_STATIC);
+	GAE_VertexBuffer_addFormatIdentifier(vertexBuffer, GAE_VERTEXBUFFER_FORMAT_POSITION_3F, 1U);
+	if (GAE_TRUE == mesh.hasTexCoords)
+		GAE_VertexBuffer_addFormatIdentifier(vertexBuffer, GAE_VERTEXBUFFER_FORMAT_TEXTURE_2F, 1U);
+	if (GAE_TRUE == mesh.hasNormals)
+		GAE_VertexBuffer_addFormatIdentifier(vertexBuffer, GAE_VERTEXBUFFER_FORMAT_NORMAL_3F, 1U);
+	vertexBuffer->stride = mesh.floatsPerVertex * sizeof(float);
+
+	indexBuffer = GAE_IndexBuffer_create((GAE_BYTE*)mesh.indices.data, mesh.indices.count, GAE_INDEXBUFFER_INDEX_UNSIGNED_INT, GAE_INDEXBUFFER_FORMAT_TRIANGLES, GAE_INDEXBUFFER_DRAW_STATIC);
+	deleteObj(&mesh);
+
+	if ((GAE_TRUE == optimise) && (GAE_TRUE == GAE_MeshOptimiser_optimise(indexBuffer, vertexBuffer, GAE_MESHOPTIMISER_CACHE_SIZE, &stats)))
+		printf("ACMR %.3f -> %.3f\n", stats.acmrBefore, stats.acmrAfter);
+
+	written = writeMesh(argv[arg + 1], vertexBuffer, indexBuffer, vertexCount);
+	if (GAE_FALSE == written)
+		fprintf(stderr, "Failed to write mesh: %s\n", argv[arg + 1]);
+	else
+		printf("Converted %u vertices and %u triangles\n", vertexCount, indexBuffer->count / 3U);
+
+	GAE_IndexBuffer_delete(indexBuffer);
+	GAE_VertexBuffer_delete(vertexBuffer);
+
+	if ((GAE_TRUE == written) && (0U < iterations))
+		benchmark(text, argv[arg + 1], iterations);
+
+	free(text);
+	return (GAE_TRUE == written) ? 0 : 1;
+}
+
+void printUsage(const char* name) {
+	fprintf(stderr, "Usage: %s [-nooptimise] [-bench iterations] input.obj output.gmsh\n", name);
+}
+
+char* readText(const char* path, unsigned long* size) {
+	GAE_File_t* file = GAE_File_create(path);
+	GAE_FILE_STATUS fileStatus = GAE_FILE_ERROR;
+	GAE_FILE_READ_STATUS readStatus = GAE_FILE_READ_ERROR;
+	char* text = 0;
+
+	GAE_File_open(file, GAE_FILE_OPEN_READ, GAE_FILE_BINARY, &fileStatus);
+	if (GAE_FILE_OPEN == fileStatus)
+		GAE_File_read(file, GAE_FILE_READ_ALL, &readStatus);
+
+	if (GAE_FILE_READ_ERROR != readStatus) {
+		/* terminated copy so the parser can walk it with the string functions */
+		*size = file->bufferSize;
+		text = malloc(file->bufferSize + 1UL);
+		memcpy(text, file->buffer, file->bufferSize);
+		text[file->bufferSize] = '\0';
+	}
+
+	GAE_File_close(file, GAE_FILE_CLOSE_DELETE_DATA, 0);
+	GAE_File_delete(file);
+	return text;
+}
+
+void pushFloat(FloatArray_t* array, const float value) {
+	if (array->count == array->allocated) {
+		array->allocated = (0U == array->allocated) ? 1024U : array->allocated * 2U;
+		array->data = realloc(array->data, sizeof(float) * array->allocated);
+	}
+	array->data[array->count++] = value;
+}
+
+void pushUint(UintArray_t* array, const unsigned int value) {
+	if (array->count == array->allocated) {
+		array->allocated = (0U == array->allocated) ? 1024U : array->allocated * 2U;
+		array->data = realloc(array->data, sizeof(unsigned int) * array->allocated);
+	}
+	array->data[array->count++] = value;
+}
+
+unsigned int hashCorner(const Corner_t* corner) {
+	unsigned int hash = (unsigned int)corner->position * 73856093U;
+	hash ^= (unsigned int)corner->texCoord * 19349663U;
+	hash ^= (unsigned int)corner->normal * 83492791U;
+	return hash;
+}
+
+GAE_BOOL parseObj(const char* text, ObjMesh_t* mesh) {
+	FloatArray_t positions = { 0, 0U, 0U };
+	FloatArray_t texCoords = { 0, 0U, 0U };
+	FloatArray_t normals = { 0, 0U, 0U };
+	Corner_t* table = 0;
+	unsigned int tableSize = 4096U;
+	unsigned int tableUsed = 0U;
+	const char* cursor = text;
+	GAE_BOOL status = GAE_TRUE;
+
+	memset(mesh, 0, sizeof(ObjMesh_t));
+
+	/* the vertex layout depends on what the file has, so the attributes go first */
+	while ('\0' != *cursor) {
+		char* end = 0;
+		if (('v' == cursor[0]) && (' ' == cursor[1])) {
+			pushFloat(&positions, (float)strtod(cursor + 2, &end));
+			pushFloat(&positions, (float)strtod(end, &end));
+			pushFloat(&positions, (float)strtod(end, &end));
+		}
+		else if (('v' == cursor[0]) && ('t' == cursor[1])) {
+			pushFloat(&texCoords, (float)strtod(cursor + 2, &end));
+			pushFloat(&texCoords, (float)strtod(end, &end));
+		}
+		else if (('v' == cursor[0]) && ('n' == cursor[1])) {
+			pushFloat(&normals, (float)strtod(cursor + 2, &end));
+			pushFloat(&normals, (float)strtod(end, &end));
+			pushFloat(&normals, (float)strtod(end, &end));
+		}
+
+		cursor = strchr(cursor, '\n');
+		if (0 == cursor)
+			break;
+		++cursor;
+	}
+
+	mesh->hasTexCoords = (0U < texCoords.count) ? GAE_TRUE : GAE_FALSE;
+	mesh->hasNormals = (0U < normals.count) ? GAE_TRUE : GAE_FALSE;
+	mesh->floatsPerVertex = 3U + ((GAE_TRUE == mesh->hasTexCoords) ? 2U : 0U) + ((GAE_TRUE == mesh->hasNormals) ? 3U : 0U);
+
+	table = malloc(sizeof(Corner_t) * tableSize);
+	memset(table, 0xFF, sizeof(Corner_t) * tableSize);
+
+	/* faces - polygons are fanned into triangles, and identical corners welded through the table */
+	for (cursor = text; (0 != cursor) && (GAE_TRUE == status); ) {
+		if (('f' == cursor[0]) && (' ' == cursor[1])) {
+			unsigned int first = INVALID_SLOT;
+			unsigned int previous = INVALID_SLOT;
+			unsigned int cornerCount = 0U;
+			Corner_t corner;
+			const char* next = cursor + 2;
+
+			while (0 != (next = parseCorner(next, &corner))) {
+				unsigned int slot = 0U;
+
+				corner.position = resolveIndex(corner.position, positions.count / 3U);
+				corner.texCoord = resolveIndex(corner.texCoord, texCoords.count / 2U);
+				corner.normal = resolveIndex(corner.normal, normals.count / 3U);
+				if (0 > corner.position) {
+					status = GAE_FALSE;
+					break;
+				}
+
+				if (tableUsed * 2U >= tableSize) {
+					Corner_t* old = table;
+					unsigned int oldSize = tableSize;
+					unsigned int index = 0U;
+
+					tableSize *= 2U;
+					table = malloc(sizeof(Corner_t) * tableSize);
+					memset(table, 0xFF, sizeof(Corner_t) * tableSize);
+					for (index = 0U; index < oldSize; ++index) {
+						if (INVALID_SLOT != old[index].vertex) {
+							slot = hashCorner(&old[index]) & (tableSize - 1U);
+							while (INVALID_SLOT != table[slot].vertex)
+								slot = (slot + 1U) & (tableSize - 1U);
+							table[slot] = old[index];
+						}
+					}
+					free(old);
+				}
+
+				slot = hashCorner(&corner) & (tableSize - 1U);
+				while ((INVALID_SLOT != table[slot].vertex) && ((table[slot].position != corner.position) || (table[slot].texCoord != corner.texCoord) || (table[slot].normal != corner.normal)))
+					slot = (slot + 1U) & (tableSize - 1U);
+
+				if (INVALID_SLOT == table[slot].vertex) {
+					unsigned int component = 0U;
+
+					corner.vertex = mesh->vertices.count / mesh->floatsPerVertex;
+					table[slot] = corner;
+					++tableUsed;
+
+					for (component = 0U; component < 3U; ++component)
+						pushFloat(&mesh->vertices, positions.data[corner.position * 3 + (int)component]);
+					if (GAE_TRUE == mesh->hasTexCoords) {
+						for (component = 0U; component < 2U; ++component)
+							pushFloat(&mesh->vertices, (0 <= corner.texCoord) ? texCoords.data[corner.texCoord * 2 + (int)component] : 0.0F);
+					}
+					if (GAE_TRUE == mesh->hasNormals) {
+						for (component = 0U; component < 3U; ++component)
+							pushFloat(&mesh->vertices, (0 <= corner.normal) ? normals.data[corner.normal * 3 + (int)component] : 0.0F);
+					}
+				}
+
+				if (0U == cornerCount)
+					first = table[slot].vertex;
+				else if (2U <= cornerCount) {
+					pushUint(&mesh->indices, first);
+					pushUint(&mesh->indices, previous);
+					pushUint(&mesh->indices, table[slot].vertex);
+				}
+
+				previous = table[slot].vertex;
+				++cornerCount;
+				cursor = next;
+			}
+		}
+
+		cursor = strchr(cursor, '\n');
+		if (0 != cursor)
+			++cursor;
+	}
+
+	free(table);
+	free(normals.data);
+	free(texCoords.data);
+	free(positions.data);
+
+	if ((GAE_FALSE == status) || (0U == mesh->indices.count)) {
+		deleteObj(mesh);
+		return GAE_FALSE;
+	}
+
+	return GAE_TRUE;
+}
+
+const char* parseCorner(const char* cursor, Corner_t* corner) {
+	char* end = 0;
+
+	while ((' ' == *cursor) || ('\t' == *cursor))
+		++cursor;
+
+	/* v, v/vt, v//vn or v/vt/vn - 0 marks a missing attribute as OBJ indices start from 1 */
+	if (('-' != *cursor) && (('0' > *cursor) || ('9' < *cursor)))
+		return 0;
+
+	corner->position = (int)strtol(cursor, &end, 10);
+
+	corner->texCoord = 0;
+	corner->normal = 0;
+	cursor = end;
+	if ('/' == *cursor) {
+		++cursor;
+		if ('/' != *cursor) {
+			corner->texCoord = (int)strtol(cursor, &end, 10);
+			cursor = end;
+		}
+		if ('/' == *cursor) {
+			++cursor;
+			corner->normal = (int)strtol(cursor, &end, 10);
+			cursor = end;
+		}
+	}
+
+	return cursor;
+}
+
+int resolveIndex(const int index, const unsigned int count) {
+	/* negative indices count back from the latest attribute */
+	const int resolved = (0 > index) ? (int)count + index : index - 1;
+	return ((0 <= resolved) && (resolved < (int)count)) ? resolved : -1;
+}
+
+void deleteObj(ObjMesh_t* mesh) {
+	free(mesh->vertices.data);
+	free(mesh->indices.data);
+	mesh->vertices.data = 0;
+	mesh->indices.data = 0;
+}
+
+GAE_BOOL writeUint32(FILE* file, const unsigned int value) {
+	GAE_BYTE bytes[4];
+
+	bytes[0] = (GAE_BYTE)(value & 0xFFU);
+	bytes[1] = (GAE_BYTE)((value >> 8U) & 0xFFU);
+	bytes[2] = (GAE_BYTE)((value >> 16U) & 0xFFU);
+	bytes[3] = (GAE_BYTE)(value >> 24U);
+
+	return (4U == fwrite(bytes, 1U, 4U, file)) ? GAE_TRUE : GAE_FALSE;
+}
+
+GAE_BOOL writeMesh(const char* path, GAE_VertexBuffer_t* vertexBuffer, GAE_IndexBuffer_t* indexBuffer, const unsigned int vertexCount) {
+	FILE* file = fopen(path, "wb");
+	const GAE_BYTE padding[GAE_MESH_FILE_ALIGNMENT] = { 0U };
+	const unsigned int* indices = (const unsigned int*)(void*)indexBuffer->data;
+	const GAE_BOOL isShort = (65536U >= vertexCount) ? GAE_TRUE : GAE_FALSE;
+	const unsigned int align = GAE_MESH_FILE_ALIGNMENT - 1U;
+	const unsigned int vertexOffset = (GAE_MESH_FILE_HEADER_SIZE + align) & ~align;
+	const unsigned int indexOffset = (vertexOffset + vertexBuffer->size + align) & ~align;
+	unsigned int formatCount = 0U;
+	unsigned int index = 0U;
+	GAE_BOOL status = GAE_TRUE;
+
+	if (0 == file)
+		return GAE_FALSE;
+
+	while ((formatCount < GAE_VERTEXBUFFER_FORMAT_SIZE) && (GAE_VERTEXBUFFER_INVALID_FORMAT != vertexBuffer->format[formatCount].type))
+		++formatCount;
+
+	status = (4U == fwrite("GMSH", 1U, 4U, file)) ? GAE_TRUE : GAE_FALSE;
+	status &= writeUint32(file, GAE_MESH_FILE_VERSION);
+	status &= writeUint32(file, vertexBuffer->size);
+	status &= writeUint32(file, vertexBuffer->stride);
+	status &= writeUint32(file, indexBuffer->count);
+	status &= writeUint32(file, (GAE_TRUE == isShort) ? (unsigned int)GAE_INDEXBUFFER_INDEX_UNSIGNED_SHORT : (unsigned int)GAE_INDEXBUFFER_INDEX_UNSIGNED_INT);
+	status &= writeUint32(file, (unsigned int)indexBuffer->format);
+	status &= writeUint32(file, vertexOffset);
+	status &= writeUint32(file, indexOffset);
+	status &= writeUint32(file, formatCount);
+	for (index = 0U; index < GAE_VERTEXBUFFER_FORMAT_SIZE; ++index) {
+		status &= writeUint32(file, (index < formatCount) ? (unsigned int)vertexBuffer->format[index].type : 0U);
+		status &= writeUint32(file, (index < formatCount) ? (unsigned int)(size_t)vertexBuffer->format[index].offset : 0U);
+	}
+
+	status &= (vertexOffset - GAE_MESH_FILE_HEADER_SIZE == fwrite(padding, 1U, vertexOffset - GAE_MESH_FILE_HEADER_SIZE, file)) ? GAE_TRUE : GAE_FALSE;
+	status &= (vertexBuffer->size == fwrite(vertexBuffer->data, 1U, vertexBuffer->size, file)) ? GAE_TRUE : GAE_FALSE;
+	status &= (indexOffset - vertexOffset - vertexBuffer->size == fwrite(padding, 1U, indexOffset - vertexOffset - vertexBuffer->size, file)) ? GAE_TRUE : GAE_FALSE;
+
+	for (index = 0U; (index < indexBuffer->count) && (GAE_TRUE == status); ++index) {
+		if (GAE_TRUE == isShort) {
+			const GAE_BYTE bytes[2] = { (GAE_BYTE)(indices[index] & 0xFFU), (GAE_BYTE)(indices[index] >> 8U) };
+			status &= (2U == fwrite(bytes, 1U, 2U, file)) ? GAE_TRUE : GAE_FALSE;
+		}
+		else
+			status &= writeUint32(file, indices[index]);
+	}
+
+	if (0 != fclose(file))
+		status = GAE_FALSE;
+
+	return status;
+}
+
+void benchmark(const char* text, const char* meshPath, const unsigned int iterations) {
+	clock_t start = clock();
+	double objTime = 0.0;
+	double meshTime = 0.0;
+	unsigned int iteration = 0U;
+	unsigned long touched = 0UL;
+
+	for (iteration = 0U; iteration < iterations; ++iteration) {
+		ObjMesh_t mesh;
+		if (GAE_TRUE == parseObj(text, &mesh))
+			deleteObj(&mesh);
+	}
+	objTime = (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC / iterations;
+
+	start = clock();
+	for (iteration = 0U; iteration < iterations; ++iteration) {
+		GAE_MeshFile_t* meshFile = GAE_MeshFile_create(meshPath, 0);
+		unsigned long offset = 0UL;
+
+		/* touch every page, as the upload would, so faulting the mapping in is counted */
+		for (offset = 0UL; offset < meshFile->size; offset += 4096UL)
+			touched += meshFile->data[offset];
+
+		GAE_MeshFile_delete(meshFile);
+	}
+	meshTime = (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC / iterations;
+
+	printf("OBJ parse %.3fms, binary load %.3fms per load over %u loads (%lu)\n", objTime, meshTime, iterations, touched & 1UL);
+}
@@ -0,0 +1,394 @@
+/* Packer - packs loose files into a pack (see File/Pack.h), each under its path as given,
+ * so run it from wherever the game opens files relative to.
+ * With -lz4, files are compressed wherever that saves at least an eighth - anything less isn't worth losing the view straight into the pack.
+ * With -bench, every packed file is then loaded through GAE_File, loose and from the pack, with the page cache dropped
+ * for each pass where the platform allows, as a level would load on a fresh boot.
+ * Usage: packer [-lz4] [-list FILE] [-bench ITERATIONS] output.gpak [file ...]
+ */
+
+#if defined(LINUX) || defined(PANDORA)
+	/* posix_fadvise */
+	#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(LINUX) || defined(PANDORA)
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+#include "../../GAE_Types.h"
+#include "../../File/File.h"
+#include "../../File/Pack.h"
+#include "../../Time/Clock.h"
+#include "../../Utils/LZ4.h"
+
+typedef struct Entry_s {
+	char* path;
+	GAE_HashString_t hash;
+	GAE_File_t* file;				/* holds the loose data */
+	GAE_BYTE* compressed;
+	unsigned long size;
+	unsigned long storedSize;
+	unsigned long offset;
+	unsigned int flags;
+} Entry_t;
+
+typedef struct Entries_s {
+	Entry_t* entries;
+	unsigned int count;
+	unsigned int capacity;
+} Entries_t;
+
+static void printUsage(const char* name);
+static GAE_BOOL addPath(Entries_t* entries, const char* path);
+static GAE_BOOL addList(Entries_t* entries, const char* listPath);
+static GAE_BOOL loadEntry(Entry_t* entry, const GAE_BOOL isCompressing);
+static int compareEntries(const void* a, const void* b);
+static GAE_BOOL writeUint32(FILE* file, const unsigned int value);
+static GAE_BOOL writePack(const char* path, Entries_t* entries);
+static void dropCache(const char* path);
+static float loadAll(Entries_t* entries, const char* packPath, unsigned long* bytes);
+static void benchmark(Entries_t* entries, const char* packPath, const unsigned int iterations);
+
+int main(int argc, char** argv) {
+	Entries_t entries = { 0, 0U, 0U };
+	const char* output = 0;
+	GAE_BOOL isCompressing = GAE_FALSE;
+	unsigned int iterations = 0U;
+	unsigned long packedSize = 0UL;
+	unsigned long looseSize = 0UL;
+	unsigned int compressedCount = 0U;
+	unsigned int index = 0U;
+	GAE_BOOL status = GAE_TRUE;
+	int arg = 1;
+
+	while ((arg < argc) && ('-' == argv[arg][0])) {
+		if (0 == strcmp(argv[arg], "-lz4"))
+			isCompressing = GAE_TRUE;
+		else if ((0 == strcmp(argv[arg], "-list")) && (arg + 1 < argc)) {
+			if (GAE_FALSE == addList(&entries, argv[++arg])) {
+				fprintf(stderr, "Failed to read the list %s\n", argv[arg]);
+				return 1;
+			}
+		}
+		else if ((0 == strcmp(argv[arg], "-bench")) && (arg + 1 < argc))
+			iterations = (unsigned int)strtoul(argv[++arg], 0, 10);
+		else {
+			printUsage(argv[0]);
+			return 1;
+		}
+		++arg;
+	}
+
+	if (arg >= argc) {
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	output = argv[arg++];
+	for (; arg < argc; ++arg)
+		addPath(&entries, argv[arg]);
+
+	if (0U == entries.count) {
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	for (index = 0U; (index < entries.count) && (GAE_TRUE == status); ++index) {
+		status = loadEntry(&entries.entries[index], isCompressing);
+		if (GAE_FALSE == status)
+			fprintf(stderr, "Failed to load %s\n", entries.entries[index].path);
+	}
+
+	if (GAE_TRUE == status) {
+		qsort(entries.entries, entries.count, sizeof(Entry_t), compareEntries);
+		for (index = 1U; (index < entries.count) && (GAE_TRUE == status); ++index) {
+			if (entries.entries[index - 1U].hash == entries.entries[index].hash) {
+				fprintf(stderr, "%s and %s hash the same - rename one of them, or list it only once\n", entries.entries[index - 1U].path, entries.entries[index].path);
+				status = GAE_FALSE;
+			}
+		}
+	}
+
+	if (GAE_TRUE == status) {
+		status = writePack(output, &entries);
+		if (GAE_FALSE == status)
+			fprintf(stderr, "Failed to write %s\n", output);
+	}
+
+	if (GAE_TRUE == status) {
+		for (index = 0U; index < entries.count; ++index) {
+			looseSize += entries.entries[index].size;
+			if (0U != entries.entries[index].flags)
+				++compressedCount;
+		}
+		packedSize = entries.entries[entries.count - 1U].offset + entries.entries[entries.count - 1U].storedSize + 1UL;
+		printf("Packed %u files, %lu bytes, into %lu bytes - %u compressed\n", entries.count, looseSize, packedSize, compressedCount);
+	}
+
+	for (index = 0U; index < entries.count; ++index) {
+		Entry_t* entry = &entries.entries[index];
+		if (0 != entry->file) {
+			GAE_File_deleteBuffer(entry->file, 0);
+			GAE_File_delete(entry->file);
+			entry->file = 0;
+		}
+		free(entry->compressed);
+		entry->compressed = 0;
+	}
+
+	if ((GAE_TRUE == status) && (0U < iterations))
+		benchmark(&entries, output, iterations);
+
+	for (index = 0U; index < entries.count; ++index)
+		free(entries.entries[index].path);
+	free(entries.entries);
+
+	return (GAE_TRUE == status) ? 0 : 1;
+}
+
+void printUsage(const char* name) {
+	fprintf(stderr, "Usage: %s [-lz4] [-list FILE] [-bench ITERATIONS] output.gpak [file ...]\n", name);
+}
+
+GAE_BOOL addPath(Entries_t* entries, const char* path) {
+	Entry_t* entry = 0;
+
+	if (entries->count == entries->capacity) {
+		const unsigned int capacity = (0U == entries->capacity) ? 64U : entries->capacity * 2U;
+		Entry_t* grown = realloc(entries->entries, capacity * sizeof(Entry_t));
+		if (0 == grown)
+			return GAE_FALSE;
+		entries->entries = grown;
+		entries->capacity = capacity;
+	}
+
+	entry = &entries->entries[entries->count++];
+	memset(entry, 0, sizeof(Entry_t));
+	entry->path = malloc(strlen(path) + 1U);
+	strcpy(entry->path, path);
+	entry->hash = GAE_Pack_hashPath(path);
+
+	return GAE_TRUE;
+}
+
+GAE_BOOL addList(Entries_t* entries, const char* listPath) {
+	FILE* list = fopen(listPath, "r");
+	char line[1024];
+
+	if (0 == list)
+		return GAE_FALSE;
+
+	while (0 != fgets(line, sizeof(line), list)) {
+		size_t length = strlen(line);
+		while ((0U < length) && (('\n' == line[length - 1U]) || ('\r' == line[length - 1U])))
+			line[--length] = '\0';
+
+		if ((0U < length) && (GAE_FALSE == addPath(entries, line))) {
+			fclose(list);
+			return GAE_FALSE;
+		}
+	}
+
+	fclose(list);
+	return GAE_TRUE;
+}
+
+GAE_BOOL loadEntry(Entry_t* entry, const GAE_BOOL isCompressing) {
+	GAE_FILE_STATUS fileStatus = GAE_FILE_ERROR;
+	GAE_FILE_READ_STATUS readStatus = GAE_FILE_READ_ERROR;
+
+	entry->file = GAE_File_create(entry->path);
+	GAE_File_open(entry->file, GAE_FILE_OPEN_MAP, GAE_FILE_BINARY, &fileStatus);
+	if (GAE_FILE_OPEN == fileStatus)
+		GAE_File_read(entry->file, GAE_FILE_READ_ALL, &readStatus);
+	GAE_File_close(entry->file, GAE_FILE_CLOSE_RETAIN_DATA, 0);
+
+	if (GAE_FILE_READ_ERROR == readStatus)
+		return GAE_FALSE;
+
+	/* offsets and sizes are 32 bit */
+	entry->size = entry->file->bufferSize;
+	entry->storedSize = entry->size;
+	if (0xFFFFFFFFUL <= entry->size)
+		return GAE_FALSE;
+
+	if ((GAE_TRUE == isCompressing) && (0UL < entry->size)) {
+		const unsigned long bound = GAE_LZ4_getBound(entry->size);
+		const unsigned long worthwhile = entry->size - entry->size / 8UL;
+		unsigned long compressedSize = 0UL;
+
+		entry->compressed = malloc(bound);
+		if (0 != entry->compressed)
+			compressedSize = GAE_LZ4_compress(entry->file->buffer, entry->size, entry->compressed, bound);
+
+		if ((0UL != compressedSize) && (compressedSize <= worthwhile)) {
+			entry->storedSize = compressedSize;
+			entry->flags = GAE_PACK_FLAG_LZ4;
+		}
+		else {
+			free(entry->compressed);
+			entry->compressed = 0;
+		}
+	}
+
+	return GAE_TRUE;
+}
+
+int compareEntries(const void* a, const void* b) {
+	const Entry_t* entryA = (const Entry_t*)a;
+	const Entry_t* entryB = (const Entry_t*)b;
+
+	if (entryA->hash < entryB->hash)
+		return -1;
+	return (entryA->hash > entryB->hash) ? 1 : 0;
+}
+
+GAE_BOOL writeUint32(FILE* file, const unsigned int value) {
+	GAE_BYTE bytes[4];
+
+	bytes[0] = (GAE_BYTE)(value & 0xFFU);
+	bytes[1] = (GAE_BYTE)((value >> 8U) & 0xFFU);
+	bytes[2] = (GAE_BYTE)((value >> 16U) & 0xFFU);
+	bytes[3] = (GAE_BYTE)(value >> 24U);
+
+	return (4U == fwrite(bytes, 1U, 4U, file)) ? GAE_TRUE : GAE_FALSE;
+}
+
+GAE_BOOL writePack(const char* path, Entries_t* entries) {
+	FILE* file = 0;
+	const GAE_BYTE padding[GAE_PACK_ALIGNMENT] = { 0U };
+	const unsigned long align = GAE_PACK_ALIGNMENT - 1UL;
+	unsigned long position = GAE_PACK_HEADER_SIZE + (unsigned long)entries->count * GAE_PACK_ENTRY_SIZE;
+	unsigned int index = 0U;
+	GAE_BOOL status = GAE_TRUE;
+
+	/* every file gets at least one zero byte after it, before the next alignment */
+	for (index = 0U; index < entries->count; ++index) {
+		Entry_t* entry = &entries->entries[index];
+		entry->offset = (position + align) & ~align;
+		position = entry->offset + entry->storedSize + 1UL;
+		if (0xFFFFFFFFUL <= position)
+			return GAE_FALSE;
+	}
+
+	file = fopen(path, "wb");
+	if (0 == file)
+		return GAE_FALSE;
+
+	status = (4U == fwrite("GPAK", 1U, 4U, file)) ? GAE_TRUE : GAE_FALSE;
+	status &= writeUint32(file, GAE_PACK_VERSION);
+	status &= writeUint32(file, entries->count);
+	status &= writeUint32(file, 0U);
+
+	for (index = 0U; index < entries->count; ++index) {
+		const Entry_t* entry = &entries->entries[index];
+		status &= writeUint32(file, entry->hash);
+		status &= writeUint32(file, entry->flags);
+		status &= writeUint32(file, (unsigned int)entry->size);
+		status &= writeUint32(file, (unsigned int)entry->storedSize);
+		status &= writeUint32(file, (unsigned int)entry->offset);
+		status &= writeUint32(file, 0U);
+	}
+
+	position = GAE_PACK_HEADER_SIZE + (unsigned long)entries->count * GAE_PACK_ENTRY_SIZE;
+	for (index = 0U; (index < entries->count) && (GAE_TRUE == status); ++index) {
+		const Entry_t* entry = &entries->entries[index];
+		const GAE_BYTE* data = (0 != entry->compressed) ? entry->compressed : entry->file->buffer;
+
+		status &= (entry->offset - position == fwrite(padding, 1U, entry->offset - position, file)) ? GAE_TRUE : GAE_FALSE;
+		status &= (entry->storedSize == fwrite(data, 1U, entry->storedSize, file)) ? GAE_TRUE : GAE_FALSE;
+		position = entry->offset + entry->storedSize;
+	}
+	status &= (1U == fwrite(padding, 1U, 1U, file)) ? GAE_TRUE : GAE_FALSE;
+
+	if (0 != fclose(file))
+		status = GAE_FALSE;
+
+	return status;
+}
+
+void dropCache(const char* path) {
+#if defined(LINUX) || defined(PANDORA)
+	/* clean pages are dropped without needing root - anything still dirty is written out first */
+	const int descriptor = open(path, O_RDONLY);
+	if (-1 == descriptor)
+		return;
+
+	fdatasync(descriptor);
+	posix_fadvise(descriptor, 0, 0, POSIX_FADV_DONTNEED);
+	close(descriptor);
+#else
+	(void)path;
+#endif
+}
+
+float loadAll(Entries_t* entries, const char* packPath, unsigned long* bytes) {
+	GAE_Clock_t* clock = GAE_Clock_create();
+	GAE_Pack_t* pack = 0;
+	unsigned int index = 0U;
+	float time = 0.0F;
+
+	GAE_Clock_reset(clock);
+	if (0 != packPath) {
+		pack = GAE_Pack_create(packPath);
+		if (0 != pack)
+			GAE_Pack_mount(pack, 0);
+	}
+
+	/* as a level loader would - each file in turn, read whole and walked once */
+	for (index = 0U; index < entries->count; ++index) {
+		GAE_File_t* file = GAE_File_create(entries->entries[index].path);
+		GAE_FILE_STATUS fileStatus = GAE_FILE_ERROR;
+		GAE_FILE_READ_STATUS readStatus = GAE_FILE_READ_ERROR;
+		unsigned long offset = 0UL;
+
+		GAE_File_open(file, GAE_FILE_OPEN_READ, GAE_FILE_BINARY, &fileStatus);
+		if (GAE_FILE_OPEN == fileStatus)
+			GAE_File_read(file, GAE_FILE_READ_ALL, &readStatus);
+		GAE_File_close(file, GAE_FILE_CLOSE_RETAIN_DATA, 0);
+
+		if (GAE_FILE_READ_ERROR != readStatus) {
+			for (offset = 0UL; offset < file->bufferSize; offset += 4096UL)
+				*bytes += file->buffer[offset];
+		}
+
+		GAE_File_deleteBuffer(file, 0);
+		GAE_File_delete(file);
+	}
+
+	if (0 != pack)
+		GAE_Pack_delete(pack);
+	GAE_Clock_update(clock);
+	time = clock->deltaTime;
+
+	GAE_Clock_delete(clock);
+	return time;
+}
+
+void benchmark(Entries_t* entries, const char* packPath, const unsigned int iterations) {
+	float looseTime = 0.0F;
+	float packTime = 0.0F;
+	unsigned long looseBytes = 0UL;
+	unsigned long packBytes = 0UL;
+	unsigned int iteration = 0U;
+	unsigned int index = 0U;
+
+	for (iteration = 0U; iteration < iterations; ++iteration) {
+		for (index = 0U; index < entries->count; ++index)
+			dropCache(entries->entries[index].path);
+		looseTime += loadAll(entries, 0, &looseBytes);
+
+		dropCache(packPath);
+		packTime += loadAll(entries, packPath, &packBytes);
+	}
+
+	if (looseBytes != packBytes)
+		fprintf(stderr, "Packed files differ from the loose ones\n");
+
+	printf("Loose %.3fms, packed %.3fms per load of all %u files over %u loads\n", looseTime * 1000.0F / (float)iterations, packTime * 1000.0F / (float)iterations, entries->count, iterations);
+}
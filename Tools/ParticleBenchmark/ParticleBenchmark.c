@@ -0,0 +1,122 @@
+/* Particle benchmark - keeps a fountain of particles alive and times each frame's update
+ * (integrate, kill, spawn and vertex build) and draw, against the 60Hz frame budget.
+ * Drawing goes through the headless mock GL, so it counts the CPU side of the draw calls
+ * and buffer uploads only.
+ * Usage: particlebenchmark [-particles N] [-emitters N] [-frames N]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../../GAE_Types.h"
+#include "../../Graphics/ParticleSystem.h"
+#include "../../Graphics/Renderer/Renderer.h"
+#include "../../Graphics/Context/Mock/MockGL.h"
+
+#define FRAME_TIME (1.0F / 60.0F)
+#define FRAME_BUDGET_MS (1000.0 / 60.0)
+#define PARTICLE_LIFE 2.0F
+
+static void printUsage(const char* name);
+
+int main(int argc, char** argv) {
+	GAE_ParticleSystem_t* system = 0;
+	GAE_Renderer_t* renderer = 0;
+	unsigned int particles = 100000U;
+	unsigned int emitters = 4U;
+	unsigned int frames = 600U;
+	unsigned int perEmitter = 0U;
+	unsigned int frame = 0U;
+	unsigned int index = 0U;
+	unsigned int drawCalls = 0U;
+	double updateTime = 0.0;
+	double drawTime = 0.0;
+	double frameTime = 0.0;
+	clock_t start = 0;
+	int arg = 1;
+
+	for (; arg < argc; ++arg) {
+		if ((0 == strcmp(argv[arg], "-particles")) && (arg + 1 < argc))
+			particles = (unsigned int)strtoul(argv[++arg], 0, 10);
+		else if ((0 == strcmp(argv[arg], "-emitters")) && (arg + 1 < argc))
+			emitters = (unsigned int)strtoul(argv[++arg], 0, 10);
+		else if ((0 == strcmp(argv[arg], "-frames")) && (arg + 1 < argc))
+			frames = (unsigned int)strtoul(argv[++arg], 0, 10);
+		else {
+			printUsage(argv[0]);
+			return 1;
+		}
+	}
+
+	if ((0U == particles) || (0U == emitters) || (0U == frames)) {
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	/* large emitters use 32 bit indices, as desktop GL always has them */
+	GAE_MockGL_setExtensions("GL_OES_element_index_uint");
+	renderer = GAE_Renderer_create();
+	system = GAE_ParticleSystem_create();
+	perEmitter = (particles + emitters - 1U) / emitters;
+
+	for (index = 0U; index < emitters; ++index) {
+		GAE_ParticleEmitter_t* emitter = GAE_ParticleSystem_addEmitter(system, perEmitter, 0);
+		GAE_ParticleEmitter_Settings_t* settings = &emitter->settings;
+
+		settings->position[0] = (float)index * 10.0F;
+		settings->area[0] = 1.0F;
+		settings->area[1] = 1.0F;
+		settings->velocity[1] = 20.0F;
+		settings->velocityVariance[0] = 5.0F;
+		settings->velocityVariance[1] = 5.0F;
+		settings->acceleration[1] = -9.8F;
+		settings->minLife = PARTICLE_LIFE * 0.5F;
+		settings->maxLife = PARTICLE_LIFE;
+		settings->startSize = 1.0F;
+		settings->endSize = 0.25F;
+		settings->endColour[1] = 0.5F;
+		settings->endColour[3] = 0.0F;
+
+		/* start full, then spawn at the rate that keeps it full on average */
+		settings->rate = (float)perEmitter / (PARTICLE_LIFE * 0.75F);
+		GAE_ParticleSystem_burst(system, emitter, perEmitter);
+	}
+
+	/* warm up, so the population has settled and the buffers have been created */
+	for (frame = 0U; frame < 60U; ++frame) {
+		GAE_ParticleSystem_update(system, FRAME_TIME);
+		GAE_ParticleSystem_draw(system, renderer);
+		GAE_MockGL_endFrame();
+	}
+
+	for (frame = 0U; frame < frames; ++frame) {
+		start = clock();
+		GAE_ParticleSystem_update(system, FRAME_TIME);
+		updateTime += (double)(clock() - start);
+
+		start = clock();
+		GAE_ParticleSystem_draw(system, renderer);
+		drawTime += (double)(clock() - start);
+
+		GAE_MockGL_endFrame();
+		drawCalls = GAE_MockGL_getLastFrameStats()->drawCalls;
+	}
+
+	updateTime = updateTime * 1000.0 / CLOCKS_PER_SEC / frames;
+	drawTime = drawTime * 1000.0 / CLOCKS_PER_SEC / frames;
+	frameTime = updateTime + drawTime;
+
+	printf("Live particles: %u across %u emitters (%u draw calls)\n", GAE_ParticleSystem_getParticleCount(system), emitters, drawCalls);
+	printf("Update: %.3fms  Draw: %.3fms  Frame: %.3fms of a %.3fms budget (%.0f%%)\n", updateTime, drawTime, frameTime, FRAME_BUDGET_MS, frameTime * 100.0 / FRAME_BUDGET_MS);
+
+	GAE_ParticleSystem_delete(system);
+	GAE_Renderer_delete(renderer);
+
+	return (frameTime <= FRAME_BUDGET_MS) ? 0 : 2;
+}
+
+void printUsage(const char* name) {
+	fprintf(stderr, "Usage: %s [-particles N] [-emitters N] [-frames N]\n", name);
+}
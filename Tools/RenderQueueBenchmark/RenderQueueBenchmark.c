@@ -0,0 +1,338 @@
+/* Render queue benchmark - animates, culls and draws a scene of many objects each frame, first straight through
+ * GAE_Renderer_drawMesh on one thread, then recorded into a GAE_RenderQueue on one thread and on -threads threads,
+ * and times recording and submission separately.
+ * Drawing goes through the headless mock GL, so submission counts the CPU side of the draw calls only.
+ * Usage: renderqueuebenchmark [-objects N] [-meshes N] [-work N] [-threads N] [-frames N]
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../GAE_Types.h"
+#include "../../File/File.h"
+#include "../../Graphics/IndexBuffer.h"
+#include "../../Graphics/Material.h"
+#include "../../Graphics/Mesh.h"
+#include "../../Graphics/Shader.h"
+#include "../../Graphics/VertexBuffer.h"
+#include "../../Graphics/Renderer/Renderer.h"
+#include "../../Graphics/Renderer/RenderQueue.h"
+#include "../../Graphics/State/RenderState.h"
+#include "../../Graphics/Context/Mock/MockGL.h"
+#include "../../Time/Clock.h"
+
+#define SHADER_COUNT 4U
+#define SCENE_SIZE 1000.0F
+#define FRAME_TIME (1.0F / 60.0F)
+
+typedef struct Object_s {
+	float position[2];
+	float velocity[2];
+	float angle;
+	float spin;
+	float scale;
+	GAE_Mesh_t* mesh;
+} Object_t;
+
+typedef struct Scene_s {
+	Object_t* objects;
+	unsigned int objectCount;
+	unsigned int work;			/* matrix multiplies per object, standing in for animation and hierarchy */
+	float time;
+	float view[4];
+} Scene_t;
+
+typedef struct Result_s {
+	double record;
+	double submit;
+	unsigned int drawCalls;
+	unsigned int stateChanges;
+	unsigned int skipped;		/* redundant state calls the render state's shadow kept from GL */
+} Result_t;
+
+static void printUsage(const char* name);
+static GAE_Mesh_t* createMesh(GAE_Shader_t* const shader);
+static GAE_Shader_t* createShader(const unsigned int index);
+static GAE_BOOL updateObject(Scene_t* const scene, const unsigned int index, GAE_Matrix4_t transform, float* depth);
+static void recordObjects(GAE_RenderCommandList_t* list, const unsigned int begin, const unsigned int end, void* const userData);
+static Result_t runDirect(Scene_t* const scene, GAE_Renderer_t* renderer, const unsigned int frames);
+static Result_t runQueue(Scene_t* const scene, GAE_Renderer_t* renderer, const unsigned int threads, const unsigned int frames);
+static unsigned int countSkipped(GAE_Renderer_t* renderer);
+static void printResult(const char* name, const Result_t* const result, const Result_t* const baseline);
+
+int main(int argc, char** argv) {
+	GAE_Renderer_t* renderer = 0;
+	GAE_Shader_t* shaders[SHADER_COUNT];
+	GAE_Mesh_t** meshes = 0;
+	Scene_t scene;
+	Result_t direct;
+	Result_t single;
+	Result_t threaded;
+	unsigned int objects = 100000U;
+	unsigned int meshCount = 16U;
+	unsigned int threads = 0U;
+	unsigned int frames = 60U;
+	unsigned int index = 0U;
+	int arg = 1;
+
+	scene.work = 4U;
+	for (; arg < argc; ++arg) {
+		if ((0 == strcmp(argv[arg], "-objects")) && (arg + 1 < argc))
+			objects = (unsigned int)strtoul(argv[++arg], 0, 10);
+		else if ((0 == strcmp(argv[arg], "-meshes")) && (arg + 1 < argc))
+			meshCount = (unsigned int)strtoul(argv[++arg], 0, 10);
+		else if ((0 == strcmp(argv[arg], "-work")) && (arg + 1 < argc))
+			scene.work = (unsigned int)strtoul(argv[++arg], 0, 10);
+		else if ((0 == strcmp(argv[arg], "-threads")) && (arg + 1 < argc))
+			threads = (unsigned int)strtoul(argv[++arg], 0, 10);
+		else if ((0 == strcmp(argv[arg], "-frames")) && (arg + 1 < argc))
+			frames = (unsigned int)strtoul(argv[++arg], 0, 10);
+		else {
+			printUsage(argv[0]);
+			return 1;
+		}
+	}
+
+	if ((0U == objects) || (0U == meshCount) || (0U == frames)) {
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	renderer = GAE_Renderer_create();
+	for (index = 0U; index < SHADER_COUNT; ++index)
+		shaders[index] = createShader(index);
+	meshes = malloc(sizeof(GAE_Mesh_t*) * meshCount);
+	for (index = 0U; index < meshCount; ++index)
+		meshes[index] = createMesh(shaders[index % SHADER_COUNT]);
+
+	/* objects are spread over twice the view, so about a quarter are culled, and come in no particular mesh order */
+	srand(1234U);
+	scene.objects = malloc(sizeof(Object_t) * objects);
+	scene.objectCount = objects;
+	scene.time = 0.0F;
+	scene.view[0] = SCENE_SIZE * 0.25F;
+	scene.view[1] = SCENE_SIZE * 0.25F;
+	scene.view[2] = SCENE_SIZE * 0.75F;
+	scene.view[3] = SCENE_SIZE * 0.75F;
+	for (index = 0U; index < objects; ++index) {
+		Object_t* object = scene.objects + index;
+		object->position[0] = (float)rand() / (float)RAND_MAX * SCENE_SIZE;
+		object->position[1] = (float)rand() / (float)RAND_MAX * SCENE_SIZE;
+		object->velocity[0] = (float)rand() / (float)RAND_MAX * 20.0F - 10.0F;
+		object->velocity[1] = (float)rand() / (float)RAND_MAX * 20.0F - 10.0F;
+		object->angle = (float)rand() / (float)RAND_MAX * 6.2831853F;
+		object->spin = (float)rand() / (float)RAND_MAX * 2.0F - 1.0F;
+		object->scale = 1.0F + (float)rand() / (float)RAND_MAX * 4.0F;
+		object->mesh = meshes[(unsigned int)rand() % meshCount];
+	}
+
+	direct = runDirect(&scene, renderer, frames);
+	single = runQueue(&scene, renderer, 1U, frames);
+	threaded = runQueue(&scene, renderer, threads, frames);
+
+	printf("%u objects, %u meshes over %u shaders, %u multiplies each, %u frames\n", objects, meshCount, SHADER_COUNT, scene.work, frames);
+	printResult("Direct", &direct, 0);
+	printResult("Queue x1", &single, &direct);
+	printResult((0U < threads) ? "Queue xN" : "Queue xHW", &threaded, &direct);
+
+	for (index = 0U; index < meshCount; ++index) {
+		GAE_VertexBuffer_delete(meshes[index]->vBuffer);
+		GAE_IndexBuffer_delete(meshes[index]->iBuffer);
+		GAE_Material_delete(meshes[index]->material);
+		GAE_Mesh_delete(meshes[index]);
+	}
+	for (index = 0U; index < SHADER_COUNT; ++index)
+		GAE_Shader_delete(shaders[index]);
+	free(meshes);
+	free(scene.objects);
+	GAE_Renderer_delete(renderer);
+
+	return 0;
+}
+
+void printUsage(const char* name) {
+	fprintf(stderr, "Usage: %s [-objects N] [-meshes N] [-work N] [-threads N] [-frames N]\n", name);
+}
+
+GAE_Mesh_t* createMesh(GAE_Shader_t* const shader) {
+	float vertexData[20] = {
+		-0.5F, 0.5F, 0.0F,
+		0.5F, 0.5F, 0.0F,
+		0.5F, -0.5F, 0.0F,
+		-0.5F, -0.5F, 0.0F,
+		0.0F, 1.0F,
+		1.0F, 1.0F,
+		1.0F, 0.0F,
+		0.0F, 0.0F};
+	unsigned short indexData[6] = { 0, 3, 2, 2, 1, 0 };
+	GAE_VertexBuffer_t* vBuffer = GAE_VertexBuffer_create((GAE_BYTE*)vertexData, sizeof(vertexData), GAE_VERTEXBUFFER_TYPE_STATIC);
+	GAE_IndexBuffer_t* iBuffer = GAE_IndexBuffer_create((GAE_BYTE*)indexData, 6U, GAE_INDEXBUFFER_INDEX_UNSIGNED_SHORT, GAE_INDEXBUFFER_FORMAT_TRIANGLES, GAE_INDEXBUFFER_DRAW_STATIC);
+	GAE_Material_t* material = GAE_Material_create();
+
+	material->shader = shader;
+	GAE_VertexBuffer_addFormatIdentifier(vBuffer, GAE_VERTEXBUFFER_FORMAT_POSITION_3F, 4U);
+	GAE_VertexBuffer_addFormatIdentifier(vBuffer, GAE_VERTEXBUFFER_FORMAT_TEXTURE_2F, 4U);
+
+	return GAE_Mesh_create(vBuffer, iBuffer, material);
+}
+
+GAE_Shader_t* createShader(const unsigned int index) {
+	GAE_File_t* vFile = GAE_File_create("benchmark vertex shader");
+	GAE_File_t* fFile = GAE_File_create("benchmark fragment shader");
+	GAE_Shader_t* shader = 0;
+	char vSource[512];
+	char fSource[512];
+
+	snprintf(vSource, sizeof(vSource), "attribute vec4 a_position;\nattribute vec2 a_texCoord0;\nvarying vec2 v_texCoord0;\nuniform mat4 u_mvp;\nvoid main() {\ngl_Position = u_mvp * a_position * %u.0;\nv_texCoord0 = a_texCoord0;\n}\n", index + 1U);
+	snprintf(fSource, sizeof(fSource), "varying vec2 v_texCoord0;\nuniform sampler2D s_texture0;\nvoid main() {\ngl_FragColor = texture2D(s_texture0, v_texCoord0) * %u.0;\n}\n", index + 1U);
+	GAE_File_setBuffer(vFile, (GAE_BYTE*)vSource, strlen(vSource) + 1U, GAE_FILE_BUFFER_NOT_OWNED, 0);
+	GAE_File_setBuffer(fFile, (GAE_BYTE*)fSource, strlen(fSource) + 1U, GAE_FILE_BUFFER_NOT_OWNED, 0);
+	shader = GAE_Shader_create(vFile, fFile);
+
+	GAE_File_delete(vFile);
+	GAE_File_delete(fFile);
+	return shader;
+}
+
+GAE_BOOL updateObject(Scene_t* const scene, const unsigned int index, GAE_Matrix4_t transform, float* depth) {
+	const Object_t* const object = scene->objects + index;
+	const float x = fmodf(object->position[0] + object->velocity[0] * scene->time + SCENE_SIZE * 4.0F, SCENE_SIZE);
+	const float y = fmodf(object->position[1] + object->velocity[1] * scene->time + SCENE_SIZE * 4.0F, SCENE_SIZE);
+	const float radius = object->scale * 0.7072F;
+	unsigned int pass = 0U;
+	unsigned int row = 0U;
+	unsigned int column = 0U;
+
+	if ((x + radius < scene->view[0]) || (x - radius > scene->view[2]) || (y + radius < scene->view[1]) || (y - radius > scene->view[3]))
+		return GAE_FALSE;
+
+	memset(transform, 0, sizeof(GAE_Matrix4_t));
+	transform[0] = object->scale;
+	transform[5] = object->scale;
+	transform[10] = 1.0F;
+	transform[15] = 1.0F;
+
+	/* spin a little per pass, so each multiply depends on the last and can't be skipped */
+	for (pass = 0U; pass < scene->work; ++pass) {
+		const float angle = (object->angle + object->spin * scene->time) / (float)(scene->work);
+		const float rotation[4] = { cosf(angle), -sinf(angle), sinf(angle), cosf(angle) };
+		GAE_Matrix4_t result;
+
+		memcpy(result, transform, sizeof(GAE_Matrix4_t));
+		for (row = 0U; row < 2U; ++row) {
+			for (column = 0U; column < 4U; ++column)
+				result[row * 4U + column] = rotation[row * 2U] * transform[column] + rotation[row * 2U + 1U] * transform[4U + column];
+		}
+		memcpy(transform, result, sizeof(GAE_Matrix4_t));
+	}
+
+	transform[12] = x;
+	transform[13] = y;
+	*depth = y;
+	return GAE_TRUE;
+}
+
+void recordObjects(GAE_RenderCommandList_t* list, const unsigned int begin, const unsigned int end, void* const userData) {
+	Scene_t* const scene = (Scene_t*)userData;
+	GAE_Matrix4_t transform;
+	float depth = 0.0F;
+	unsigned int index = 0U;
+
+	for (index = begin; index < end; ++index) {
+		GAE_Mesh_t* const mesh = scene->objects[index].mesh;
+		if (GAE_TRUE == updateObject(scene, index, transform, &depth))
+			GAE_RenderCommandList_draw(list, GAE_RenderCommand_makeKey(0U, mesh, depth), mesh, transform);
+	}
+}
+
+Result_t runDirect(Scene_t* const scene, GAE_Renderer_t* renderer, const unsigned int frames) {
+	GAE_Clock_t* clock = GAE_Clock_create();
+	GAE_Matrix4_t transform;
+	Result_t result;
+	float depth = 0.0F;
+	unsigned int frame = 0U;
+	unsigned int index = 0U;
+
+	/* the serial baseline - update and draw each object in turn, as a scene without the queue does, after an untimed frame creates the buffers */
+	memset(&result, 0, sizeof(Result_t));
+	for (frame = 0U; frame <= frames; ++frame) {
+		scene->time = (0U < frame) ? (float)(frame - 1U) * FRAME_TIME : 0.0F;
+		GAE_RenderState_resetStats(renderer->state);
+		GAE_Clock_reset(clock);
+		for (index = 0U; index < scene->objectCount; ++index) {
+			if (GAE_TRUE == updateObject(scene, index, transform, &depth))
+				GAE_Renderer_drawMesh(renderer, scene->objects[index].mesh, &transform);
+		}
+		GAE_Clock_update(clock);
+		GAE_MockGL_endFrame();
+		if (0U == frame)
+			continue;
+		result.submit += (double)clock->deltaTime;
+		result.drawCalls = GAE_MockGL_getLastFrameStats()->drawCalls;
+		result.stateChanges = GAE_MockGL_getLastFrameStats()->stateChanges;
+		result.skipped = countSkipped(renderer);
+	}
+
+	result.submit = result.submit * 1000.0 / frames;
+	GAE_Clock_delete(clock);
+	return result;
+}
+
+Result_t runQueue(Scene_t* const scene, GAE_Renderer_t* renderer, const unsigned int threads, const unsigned int frames) {
+	GAE_RenderQueue_t* queue = GAE_RenderQueue_create(threads);
+	GAE_Clock_t* clock = GAE_Clock_create();
+	Result_t result;
+	unsigned int frame = 0U;
+
+	/* one untimed frame grows the command lists and allocators to size */
+	memset(&result, 0, sizeof(Result_t));
+	scene->time = 0.0F;
+	GAE_RenderQueue_record(queue, scene->objectCount, recordObjects, scene);
+	GAE_RenderQueue_submit(queue, renderer);
+	GAE_MockGL_endFrame();
+
+	for (frame = 0U; frame < frames; ++frame, scene->time += FRAME_TIME) {
+		GAE_Clock_reset(clock);
+		GAE_RenderQueue_record(queue, scene->objectCount, recordObjects, scene);
+		GAE_Clock_update(clock);
+		result.record += (double)clock->deltaTime;
+
+		GAE_RenderState_resetStats(renderer->state);
+		GAE_Clock_reset(clock);
+		GAE_RenderQueue_submit(queue, renderer);
+		GAE_Clock_update(clock);
+		result.submit += (double)clock->deltaTime;
+
+		GAE_MockGL_endFrame();
+		result.drawCalls = GAE_MockGL_getLastFrameStats()->drawCalls;
+		result.stateChanges = GAE_MockGL_getLastFrameStats()->stateChanges;
+		result.skipped = countSkipped(renderer);
+	}
+
+	result.record = result.record * 1000.0 / frames;
+	result.submit = result.submit * 1000.0 / frames;
+	GAE_Clock_delete(clock);
+	GAE_RenderQueue_delete(queue);
+	return result;
+}
+
+unsigned int countSkipped(GAE_Renderer_t* renderer) {
+	GAE_RenderState_Stats_t* const stats = GAE_RenderState_getStats(renderer->state);
+	unsigned int skipped = 0U;
+	unsigned int index = 0U;
+
+	for (index = 0U; index < GAE_RENDERSTATE_STAT_COUNT; ++index)
+		skipped += stats->redundant[index];
+	return skipped;
+}
+
+void printResult(const char* name, const Result_t* const result, const Result_t* const baseline) {
+	const double total = result->record + result->submit;
+
+	printf("%-10s record %8.3fms  submit %8.3fms  frame %8.3fms  %u draws, %u state changes, %u skipped", name, result->record, result->submit, total, result->drawCalls, result->stateChanges, result->skipped);
+	if ((0 != baseline) && (0.0 < total))
+		printf("  %.2fx", (baseline->record + baseline->submit) / total);
+	printf("\n");
+}
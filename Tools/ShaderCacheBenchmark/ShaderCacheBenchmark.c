@@ -0,0 +1,113 @@
+/* Shader cache benchmark - creates a set of programs cold, with an empty cache, then warm, as the next launch would,
+ * then again after a driver change, and times each pass.
+ * The headless mock GL stands in for the driver, with every compile and link costing -compile microseconds.
+ * Usage: shadercachebenchmark [-programs N] [-compile MICROSECONDS] [-cache DIRECTORY]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/stat.h>
+
+#include "../../GAE_Types.h"
+#include "../../File/File.h"
+#include "../../Graphics/Shader.h"
+#include "../../Graphics/ShaderCache.h"
+#include "../../Graphics/Context/Mock/MockGL.h"
+
+#define MAX_SOURCE 512U
+
+static void printUsage(const char* name);
+static double createPrograms(const char* directory, const unsigned int programs, GAE_ShaderCache_t** cache);
+
+int main(int argc, char** argv) {
+	GAE_ShaderCache_t* cache = 0;
+	const char* directory = "shadercache";
+	unsigned int programs = 32U;
+	unsigned int compileTime = 5000U;
+	double cold = 0.0;
+	double warm = 0.0;
+	double changed = 0.0;
+	int arg = 1;
+
+	for (; arg < argc; ++arg) {
+		if ((0 == strcmp(argv[arg], "-programs")) && (arg + 1 < argc))
+			programs = (unsigned int)strtoul(argv[++arg], 0, 10);
+		else if ((0 == strcmp(argv[arg], "-compile")) && (arg + 1 < argc))
+			compileTime = (unsigned int)strtoul(argv[++arg], 0, 10);
+		else if ((0 == strcmp(argv[arg], "-cache")) && (arg + 1 < argc))
+			directory = argv[++arg];
+		else {
+			printUsage(argv[0]);
+			return 1;
+		}
+	}
+
+	if (0U == programs) {
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	mkdir(directory, 0755);
+	GAE_MockGL_setExtensions("GL_OES_get_program_binary");
+	GAE_MockGL_setCompileTime(compileTime);
+
+	/* each pass starts from a fresh "context", as a new launch would */
+	GAE_MockGL_reset();
+	cold = createPrograms(directory, programs, &cache);
+	printf("Cold:    %8.3fms  %u hits, %u misses, %u stored, %u compiles\n", cold, cache->hits, cache->misses, cache->stores, GAE_MockGL_getTotalStats()->compiles);
+	GAE_ShaderCache_delete(cache);
+
+	GAE_MockGL_reset();
+	warm = createPrograms(directory, programs, &cache);
+	printf("Warm:    %8.3fms  %u hits, %u misses, %u stored, %u compiles\n", warm, cache->hits, cache->misses, cache->stores, GAE_MockGL_getTotalStats()->compiles);
+	GAE_ShaderCache_delete(cache);
+
+	GAE_MockGL_reset();
+	GAE_MockGL_setRenderer("GLESGAE MockGL - updated driver");
+	changed = createPrograms(directory, programs, &cache);
+	printf("Driver:  %8.3fms  %u hits, %u misses, %u stored, %u compiles\n", changed, cache->hits, cache->misses, cache->stores, GAE_MockGL_getTotalStats()->compiles);
+	GAE_ShaderCache_delete(cache);
+
+	printf("%u programs, warm start %.1fx faster than cold\n", programs, (0.0 < warm) ? cold / warm : 0.0);
+	return 0;
+}
+
+void printUsage(const char* name) {
+	fprintf(stderr, "Usage: %s [-programs N] [-compile MICROSECONDS] [-cache DIRECTORY]\n", name);
+}
+
+double createPrograms(const char* directory, const unsigned int programs, GAE_ShaderCache_t** cache) {
+	GAE_File_t* vFile = GAE_File_create("benchmark vertex shader");
+	GAE_File_t* fFile = GAE_File_create("benchmark fragment shader");
+	GAE_Shader_t** shaders = malloc(sizeof(GAE_Shader_t*) * programs);
+	char vSource[MAX_SOURCE];
+	char fSource[MAX_SOURCE];
+	unsigned int index = 0U;
+	clock_t start = clock();
+	double elapsed = 0.0;
+
+	*cache = GAE_ShaderCache_create(directory);
+	GAE_Shader_setCache(*cache);
+
+	for (index = 0U; index < programs; ++index) {
+		/* every program differs a little, as a real set of material shaders would */
+		snprintf(vSource, sizeof(vSource), "attribute vec4 a_position;\nattribute vec2 a_texCoord0;\nvarying vec2 v_texCoord0;\nuniform mat4 u_mvp;\nvoid main() {\ngl_Position = u_mvp * a_position * %u.0;\nv_texCoord0 = a_texCoord0;\n}\n", index + 1U);
+		snprintf(fSource, sizeof(fSource), "varying vec2 v_texCoord0;\nuniform sampler2D s_texture0;\nvoid main() {\ngl_FragColor = texture2D(s_texture0, v_texCoord0) * %u.0;\n}\n", index + 1U);
+		GAE_File_setBuffer(vFile, (GAE_BYTE*)vSource, strlen(vSource) + 1U, GAE_FILE_BUFFER_NOT_OWNED, 0);
+		GAE_File_setBuffer(fFile, (GAE_BYTE*)fSource, strlen(fSource) + 1U, GAE_FILE_BUFFER_NOT_OWNED, 0);
+		shaders[index] = GAE_Shader_create(vFile, fFile);
+	}
+
+	elapsed = (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC;
+
+	GAE_Shader_setCache(0);
+	for (index = 0U; index < programs; ++index)
+		GAE_Shader_delete(shaders[index]);
+	free(shaders);
+	GAE_File_delete(vFile);
+	GAE_File_delete(fFile);
+
+	return elapsed;
+}
@@ -0,0 +1,134 @@
+/* Simulation benchmark - runs a fixed tick simulation and an unpaced render loop for a while, first with the simulation
+ * ticked inline by the render loop, as a serial onLoop would, then on its own thread, and prints the timings of both.
+ * Ticks and frames burn -tick and -render microseconds each, standing in for game logic and draw submission.
+ * Usage: simulationbenchmark [-entities N] [-rate TICKS_PER_SECOND] [-tick MICROSECONDS] [-render MICROSECONDS] [-seconds N]
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../GAE_Types.h"
+#include "../../Maths/Matrix.h"
+#include "../../Time/Clock.h"
+#include "../../Time/Simulation.h"
+
+typedef struct World_s {
+	GAE_Clock_t* clock;				/* the simulation thread's, for burning time */
+	float time;
+	unsigned int entities;
+	float work;
+} World_t;
+
+static void printUsage(const char* name);
+static void burn(GAE_Clock_t* clock, const float seconds);
+static void tickWorld(GAE_Snapshot_t* snapshot, const float deltaTime, void* userData);
+static void run(const char* name, const GAE_BOOL isThreaded, const float rate, const float seconds, const float render, World_t* world);
+
+int main(int argc, char** argv) {
+	World_t world;
+	float rate = 60.0F;
+	float seconds = 2.0F;
+	float render = 0.008F;
+	int arg = 1;
+
+	world.entities = 1000U;
+	world.work = 0.008F;
+	for (; arg < argc; ++arg) {
+		if ((0 == strcmp(argv[arg], "-entities")) && (arg + 1 < argc))
+			world.entities = (unsigned int)strtoul(argv[++arg], 0, 10);
+		else if ((0 == strcmp(argv[arg], "-rate")) && (arg + 1 < argc))
+			rate = (float)atof(argv[++arg]);
+		else if ((0 == strcmp(argv[arg], "-tick")) && (arg + 1 < argc))
+			world.work = (float)atof(argv[++arg]) / 1000000.0F;
+		else if ((0 == strcmp(argv[arg], "-render")) && (arg + 1 < argc))
+			render = (float)atof(argv[++arg]) / 1000000.0F;
+		else if ((0 == strcmp(argv[arg], "-seconds")) && (arg + 1 < argc))
+			seconds = (float)atof(argv[++arg]);
+		else {
+			printUsage(argv[0]);
+			return 1;
+		}
+	}
+
+	if ((0.0F >= rate) || (0.0F >= seconds)) {
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	printf("%u entities at %.0f ticks a second, %.2fms a tick, %.2fms a frame\n", world.entities, rate, world.work * 1000.0F, render * 1000.0F);
+	run("Serial", GAE_FALSE, rate, seconds, render, &world);
+	run("Threaded", GAE_TRUE, rate, seconds, render, &world);
+
+	return 0;
+}
+
+void printUsage(const char* name) {
+	fprintf(stderr, "Usage: %s [-entities N] [-rate TICKS_PER_SECOND] [-tick MICROSECONDS] [-render MICROSECONDS] [-seconds N]\n", name);
+}
+
+void burn(GAE_Clock_t* clock, const float seconds) {
+	GAE_Clock_reset(clock);
+	do {
+		GAE_Clock_update(clock);
+	} while (clock->deltaTime < seconds);
+}
+
+void tickWorld(GAE_Snapshot_t* snapshot, const float deltaTime, void* userData) {
+	World_t* world = (World_t*)userData;
+	GAE_Matrix4_t transform;
+	unsigned int index = 0U;
+
+	world->time += deltaTime;
+	GAE_Matrix4_setToIdentity(&transform);
+	for (index = 0U; index < world->entities; ++index) {
+		const float angle = world->time + (float)index;
+		transform[12] = cosf(angle) * 100.0F;
+		transform[13] = sinf(angle) * 100.0F;
+		GAE_Snapshot_add(snapshot, index, (unsigned int)(world->time * 10.0F) % 8U, transform);
+	}
+	snapshot->camera[12] = world->time;
+
+	burn(world->clock, world->work);
+}
+
+void run(const char* name, const GAE_BOOL isThreaded, const float rate, const float seconds, const float render, World_t* world) {
+	GAE_Simulation_t* simulation = GAE_Simulation_create(rate, world->entities, tickWorld, world);
+	GAE_Snapshot_t* frame = GAE_Snapshot_create(world->entities);
+	GAE_Clock_t* clock = GAE_Clock_create();
+	GAE_Clock_t* renderClock = GAE_Clock_create();
+	GAE_Simulation_Stats_t* stats = 0;
+	GAE_BOOL isWarm = GAE_FALSE;
+
+	world->clock = GAE_Clock_create();
+	world->time = 0.0F;
+	GAE_Simulation_start(simulation, isThreaded);
+
+	/* a quarter second warms up, while the first snapshots arrive and the threads settle, then the timings start over */
+	GAE_Clock_reset(clock);
+	for (;;) {
+		GAE_Simulation_interpolate(simulation, frame);
+		burn(renderClock, render);
+		GAE_Simulation_endFrame(simulation);
+
+		GAE_Clock_update(clock);
+		if ((GAE_FALSE == isWarm) && (0.25F <= clock->deltaTime)) {
+			GAE_Simulation_resetStats(simulation);
+			GAE_Clock_reset(clock);
+			isWarm = GAE_TRUE;
+		}
+		else if ((GAE_TRUE == isWarm) && (seconds <= clock->deltaTime))
+			break;
+	}
+
+	stats = GAE_Simulation_getStats(simulation);
+	printf("%-9s %5u frames (%6.1f a second)  frame %6.3fms, render load %3.0f%%  tick %6.3fms, tick load %3.0f%%\n", name, stats->frames, (float)stats->frames / seconds, stats->frameTime * 1000.0F, stats->renderLoad * 100.0F, stats->tickTime * 1000.0F, stats->tickLoad * 100.0F);
+	printf("%-9s latency %6.3fms (max %6.3fms)  %u snapshots missed, %u ticks dropped\n", "", stats->latency * 1000.0F, stats->maxLatency * 1000.0F, stats->missedSnapshots, stats->droppedTicks);
+
+	GAE_Simulation_delete(simulation);
+	GAE_Snapshot_delete(frame);
+	GAE_Clock_delete(world->clock);
+	GAE_Clock_delete(renderClock);
+	GAE_Clock_delete(clock);
+}
@@ -0,0 +1,253 @@
+/* Spatial benchmark - moves a field of objects each frame and keeps a GAE_SpatialGrid and a GAE_QuadTree
+ * up to date, either by clearing and inserting everything again or by moving each object in place,
+ * then runs a camera query and a handful of radius queries against them.
+ * Usage: spatialbenchmark [-objects N] [-frames N] [-cell N]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../../GAE_Types.h"
+#include "../../Graphics/Camera.h"
+#include "../../Maths/Matrix.h"
+#include "../../Utils/QuadTree.h"
+#include "../../Utils/SpatialGrid.h"
+
+#define WORLD_SIZE 8192.0F
+#define QUAD_TREE_DEPTH 7U
+#define RADIUS_QUERIES 64U
+#define FRAME_TIME (1.0F / 60.0F)
+
+typedef struct Object_s {
+	GAE_Vector2_t position;
+	GAE_Vector2_t velocity;
+	float size;
+	unsigned int handle;
+} Object_t;
+
+typedef struct Timings_s {
+	double update;
+	double query;
+	unsigned int found;
+} Timings_t;
+
+static void printUsage(const char* name);
+static void moveObjects(Object_t* objects, const unsigned int count);
+static void getBounds(const Object_t* const object, GAE_Vector4_t bounds);
+static GAE_BOOL countVisitor(const unsigned int handle, void* const userData, void* const context);
+static void runGrid(GAE_SpatialGrid_t* grid, Object_t* objects, const unsigned int count, const unsigned int frames, GAE_Camera_t* camera, const GAE_BOOL isRebuilding, Timings_t* timings);
+static void runTree(GAE_QuadTree_t* tree, Object_t* objects, const unsigned int count, const unsigned int frames, GAE_Camera_t* camera, const GAE_BOOL isRebuilding, Timings_t* timings);
+static void printTimings(const char* name, const Timings_t* const timings, const unsigned int frames);
+
+int main(int argc, char** argv) {
+	GAE_Vector4_t bounds = { 0.0F, 0.0F, WORLD_SIZE, WORLD_SIZE };
+	GAE_Camera_t* camera = 0;
+	Object_t* objects = 0;
+	Object_t* start = 0;
+	unsigned int count = 50000U;
+	unsigned int frames = 300U;
+	float cellSize = 64.0F;
+	unsigned int index = 0U;
+	Timings_t timings;
+	int arg = 1;
+
+	for (; arg < argc; ++arg) {
+		if ((0 == strcmp(argv[arg], "-objects")) && (arg + 1 < argc))
+			count = (unsigned int)strtoul(argv[++arg], 0, 10);
+		else if ((0 == strcmp(argv[arg], "-frames")) && (arg + 1 < argc))
+			frames = (unsigned int)strtoul(argv[++arg], 0, 10);
+		else if ((0 == strcmp(argv[arg], "-cell")) && (arg + 1 < argc))
+			cellSize = (float)strtod(argv[++arg], 0);
+		else {
+			printUsage(argv[0]);
+			return 1;
+		}
+	}
+
+	if ((0U == count) || (0U == frames) || (0.0F >= cellSize)) {
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	/* mostly small, with the odd large one, so the tree has something over the grid */
+	srand(1234U);
+	start = malloc(sizeof(Object_t) * count);
+	objects = malloc(sizeof(Object_t) * count);
+	for (index = 0U; index < count; ++index) {
+		start[index].position[0] = WORLD_SIZE * (float)rand() / (float)RAND_MAX;
+		start[index].position[1] = WORLD_SIZE * (float)rand() / (float)RAND_MAX;
+		start[index].velocity[0] = 200.0F * ((float)rand() / (float)RAND_MAX - 0.5F);
+		start[index].velocity[1] = 200.0F * ((float)rand() / (float)RAND_MAX - 0.5F);
+		start[index].size = (0 == index % 100U) ? 256.0F : 4.0F + 12.0F * (float)rand() / (float)RAND_MAX;
+		start[index].handle = 0U;
+	}
+
+	/* a 1280x720 view in the middle of the world */
+	camera = GAE_Camera_create(GAE_CAMERA_TYPE_2D);
+	camera->left = 0.0F;
+	camera->right = 1280.0F;
+	camera->top = 0.0F;
+	camera->bottom = 720.0F;
+	camera->transform[12] = WORLD_SIZE * 0.5F;
+	camera->transform[13] = WORLD_SIZE * 0.5F;
+
+	printf("%u objects over %u frames, %.0f unit grid cells, %u level quadtree\n", count, frames, cellSize, QUAD_TREE_DEPTH);
+
+	{
+		GAE_SpatialGrid_t* grid = GAE_SpatialGrid_create(bounds, cellSize);
+
+		memcpy(objects, start, sizeof(Object_t) * count);
+		runGrid(grid, objects, count, frames, camera, GAE_TRUE, &timings);
+		printTimings("Grid, rebuilt", &timings, frames);
+
+		GAE_SpatialGrid_clear(grid);
+		memcpy(objects, start, sizeof(Object_t) * count);
+		runGrid(grid, objects, count, frames, camera, GAE_FALSE, &timings);
+		printTimings("Grid, moved", &timings, frames);
+
+		GAE_SpatialGrid_delete(grid);
+	}
+
+	{
+		GAE_QuadTree_t* tree = GAE_QuadTree_create(bounds, QUAD_TREE_DEPTH);
+
+		memcpy(objects, start, sizeof(Object_t) * count);
+		runTree(tree, objects, count, frames, camera, GAE_TRUE, &timings);
+		printTimings("QuadTree, rebuilt", &timings, frames);
+
+		GAE_QuadTree_clear(tree);
+		memcpy(objects, start, sizeof(Object_t) * count);
+		runTree(tree, objects, count, frames, camera, GAE_FALSE, &timings);
+		printTimings("QuadTree, moved", &timings, frames);
+
+		GAE_QuadTree_delete(tree);
+	}
+
+	GAE_Camera_delete(camera);
+	free(objects);
+	free(start);
+
+	return 0;
+}
+
+void printUsage(const char* name) {
+	fprintf(stderr, "Usage: %s [-objects N] [-frames N] [-cell N]\n", name);
+}
+
+void moveObjects(Object_t* objects, const unsigned int count) {
+	unsigned int index = 0U;
+
+	for (index = 0U; index < count; ++index) {
+		Object_t* object = objects + index;
+
+		object->position[0] += object->velocity[0] * FRAME_TIME;
+		object->position[1] += object->velocity[1] * FRAME_TIME;
+		if ((0.0F > object->position[0]) || (WORLD_SIZE < object->position[0]))
+			object->velocity[0] = -object->velocity[0];
+		if ((0.0F > object->position[1]) || (WORLD_SIZE < object->position[1]))
+			object->velocity[1] = -object->velocity[1];
+	}
+}
+
+void getBounds(const Object_t* const object, GAE_Vector4_t bounds) {
+	const float half = object->size * 0.5F;
+
+	bounds[0] = object->position[0] - half;
+	bounds[1] = object->position[1] - half;
+	bounds[2] = object->position[0] + half;
+	bounds[3] = object->position[1] + half;
+}
+
+GAE_BOOL countVisitor(const unsigned int handle, void* const userData, void* const context) {
+	GAE_UNUSED(handle);
+	GAE_UNUSED(userData);
+	++*(unsigned int*)context;
+	return GAE_TRUE;
+}
+
+void runGrid(GAE_SpatialGrid_t* grid, Object_t* objects, const unsigned int count, const unsigned int frames, GAE_Camera_t* camera, const GAE_BOOL isRebuilding, Timings_t* timings) {
+	GAE_Vector4_t bounds;
+	GAE_Vector2_t centre;
+	unsigned int frame = 0U;
+	unsigned int index = 0U;
+	clock_t start = 0;
+
+	memset(timings, 0, sizeof(Timings_t));
+	for (index = 0U; index < count; ++index) {
+		getBounds(objects + index, bounds);
+		objects[index].handle = GAE_SpatialGrid_insert(grid, bounds, objects + index);
+	}
+
+	for (frame = 0U; frame < frames; ++frame) {
+		moveObjects(objects, count);
+
+		start = clock();
+		if (GAE_TRUE == isRebuilding)
+			GAE_SpatialGrid_clear(grid);
+		for (index = 0U; index < count; ++index) {
+			getBounds(objects + index, bounds);
+			if (GAE_TRUE == isRebuilding)
+				objects[index].handle = GAE_SpatialGrid_insert(grid, bounds, objects + index);
+			else
+				GAE_SpatialGrid_move(grid, objects[index].handle, bounds);
+		}
+		timings->update += (double)(clock() - start);
+
+		start = clock();
+		GAE_SpatialGrid_queryCamera(grid, camera, countVisitor, &timings->found);
+		for (index = 0U; index < RADIUS_QUERIES; ++index) {
+			centre[0] = objects[index * (count / RADIUS_QUERIES)].position[0];
+			centre[1] = objects[index * (count / RADIUS_QUERIES)].position[1];
+			GAE_SpatialGrid_queryRadius(grid, centre, 100.0F, countVisitor, &timings->found);
+		}
+		timings->query += (double)(clock() - start);
+	}
+}
+
+void runTree(GAE_QuadTree_t* tree, Object_t* objects, const unsigned int count, const unsigned int frames, GAE_Camera_t* camera, const GAE_BOOL isRebuilding, Timings_t* timings) {
+	GAE_Vector4_t bounds;
+	GAE_Vector2_t centre;
+	unsigned int frame = 0U;
+	unsigned int index = 0U;
+	clock_t start = 0;
+
+	memset(timings, 0, sizeof(Timings_t));
+	for (index = 0U; index < count; ++index) {
+		getBounds(objects + index, bounds);
+		objects[index].handle = GAE_QuadTree_insert(tree, bounds, objects + index);
+	}
+
+	for (frame = 0U; frame < frames; ++frame) {
+		moveObjects(objects, count);
+
+		start = clock();
+		if (GAE_TRUE == isRebuilding)
+			GAE_QuadTree_clear(tree);
+		for (index = 0U; index < count; ++index) {
+			getBounds(objects + index, bounds);
+			if (GAE_TRUE == isRebuilding)
+				objects[index].handle = GAE_QuadTree_insert(tree, bounds, objects + index);
+			else
+				GAE_QuadTree_move(tree, objects[index].handle, bounds);
+		}
+		timings->update += (double)(clock() - start);
+
+		start = clock();
+		GAE_QuadTree_queryCamera(tree, camera, countVisitor, &timings->found);
+		for (index = 0U; index < RADIUS_QUERIES; ++index) {
+			centre[0] = objects[index * (count / RADIUS_QUERIES)].position[0];
+			centre[1] = objects[index * (count / RADIUS_QUERIES)].position[1];
+			GAE_QuadTree_queryRadius(tree, centre, 100.0F, countVisitor, &timings->found);
+		}
+		timings->query += (double)(clock() - start);
+	}
+}
+
+void printTimings(const char* name, const Timings_t* const timings, const unsigned int frames) {
+	const double update = timings->update * 1000.0 / CLOCKS_PER_SEC / frames;
+	const double query = timings->query * 1000.0 / CLOCKS_PER_SEC / frames;
+
+	printf("%-18s update: %.3fms  queries: %.3fms  (%u found per frame)\n", name, update, query, timings->found / frames);
+}
@@ -0,0 +1,330 @@
+/* Offline texture cooker - decodes an image once and writes it as a cooked
+ * texture (see Graphics/CookedTexture.h) that loads without any decoding:
+ * optionally premultiplied, with a mip chain built by a box or Kaiser filter,
+ * or no mips at all for textures sampled with nearest filtering.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../GAE_Types.h"
+#include "../../File/File.h"
+#include "../../Graphics/CookedTexture.h"
+#include "../../External/stb/stb_image.h"
+
+#define KAISER_RADIUS 3.0F
+#define KAISER_ALPHA 4.0F
+#define PI 3.14159265358979F
+
+typedef enum MipFilter_e {
+	MIP_FILTER_NONE
+,	MIP_FILTER_BOX
+,	MIP_FILTER_KAISER
+} MipFilter;
+
+typedef struct Image_s {
+	float* pixels; /* RGBA, 0 - 255 */
+	unsigned int width;
+	unsigned int height;
+} Image_t;
+
+static void printUsage(const char* name);
+static GAE_BOOL loadImage(const char* path, Image_t* image);
+static void premultiply(Image_t* image);
+static float filterWeight(const MipFilter filter, const float distance);
+static float besselI0(const float x);
+static void resample(const float* source, const unsigned int sourceLength, const unsigned int sourceStride, float* target, const unsigned int targetLength, const unsigned int targetStride, const unsigned int count, const unsigned int step, const MipFilter filter);
+static Image_t downsample(const Image_t* source, const MipFilter filter);
+static void quantise(const Image_t* image, const GAE_CookedTexture_Format format, GAE_BYTE* target);
+static GAE_BOOL writeUint32(FILE* file, const unsigned int value);
+static GAE_BOOL writeTexture(const char* path, Image_t* levels, const unsigned int levelCount, const GAE_CookedTexture_Format format, const unsigned int flags);
+
+int main(int argc, char** argv) {
+	Image_t levels[GAE_COOKED_TEXTURE_MAX_LEVELS];
+	MipFilter filter = MIP_FILTER_BOX;
+	GAE_CookedTexture_Format format = GAE_COOKED_TEXTURE_FORMAT_RGBA8;
+	unsigned int flags = 0U;
+	unsigned int levelCount = 1U;
+	unsigned int level = 0U;
+	GAE_BOOL written = GAE_FALSE;
+	int arg = 1;
+
+	while ((arg < argc) && ('-' == argv[arg][0])) {
+		if (0 == strcmp(argv[arg], "-premultiply"))
+			flags |= GAE_COOKED_TEXTURE_FLAG_PREMULTIPLIED;
+		else if (0 == strcmp(argv[arg], "-rgb"))
+			format = GAE_COOKED_TEXTURE_FORMAT_RGB8;
+		else if ((0 == strcmp(argv[arg], "-mips")) && (arg + 1 < argc)) {
+			++arg;
+			if (0 == strcmp(argv[arg], "none"))
+				filter = MIP_FILTER_NONE;
+			else if (0 == strcmp(argv[arg], "box"))
+				filter = MIP_FILTER_BOX;
+			else if (0 == strcmp(argv[arg], "kaiser"))
+				filter = MIP_FILTER_KAISER;
+			else {
+				printUsage(argv[0]);
+				return 1;
+			}
+		} else {
+			printUsage(argv[0]);
+			return 1;
+		}
+		++arg;
+	}
+
+	if (arg + 2 != argc) {
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	if (GAE_FALSE == loadImage(argv[arg], &levels[0])) {
+		fprintf(stderr, "Failed to load image: %s\n", argv[arg]);
+		return 1;
+	}
+
+	if (0U != (flags & GAE_COOKED_TEXTURE_FLAG_PREMULTIPLIED))
+		premultiply(&levels[0]);
+
+	/* filter the premultiplied values so transparent texels don't bleed colour */
+	if (MIP_FILTER_NONE != filter) {
+		while ((levelCount < GAE_COOKED_TEXTURE_MAX_LEVELS) && ((1U < levels[levelCount - 1U].width) || (1U < levels[levelCount - 1U].height))) {
+			levels[levelCount] = downsample(&levels[levelCount - 1U], filter);
+			++levelCount;
+		}
+	}
+
+	written = writeTexture(argv[arg + 1], levels, levelCount, format, flags);
+	if (GAE_FALSE == written)
+		fprintf(stderr, "Failed to write cooked texture: %s\n", argv[arg + 1]);
+	else
+		printf("Cooked %ux%u with %u levels\n", levels[0].width, levels[0].height, levelCount);
+
+	for (level = 0U; level < levelCount; ++level)
+		free(levels[level].pixels);
+
+	return (GAE_TRUE == written) ? 0 : 1;
+}
+
+void printUsage(const char* name) {
+	fprintf(stderr, "Usage: %s [-premultiply] [-rgb] [-mips none|box|kaiser] input output\n", name);
+}
+
+GAE_BOOL loadImage(const char* path, Image_t* image) {
+	GAE_File_t* file = GAE_File_create(path);
+	GAE_FILE_STATUS fileStatus = GAE_FILE_ERROR;
+	GAE_FILE_READ_STATUS readStatus = GAE_FILE_READ_ERROR;
+	unsigned char* data = 0;
+	int width = 0;
+	int height = 0;
+	int channels = 0;
+	unsigned long index = 0UL;
+
+	GAE_File_open(file, GAE_FILE_OPEN_READ, GAE_FILE_BINARY, &fileStatus);
+	if (GAE_FILE_OPEN == fileStatus)
+		GAE_File_read(file, GAE_FILE_READ_ALL, &readStatus);
+
+	if (GAE_FILE_READ_ERROR != readStatus)
+		data = stbi_load_from_memory(file->buffer, (int)file->bufferSize, &width, &height, &channels, 4);
+
+	GAE_File_close(file, GAE_FILE_CLOSE_DELETE_DATA, 0);
+	GAE_File_delete(file);
+
+	if (0 == data)
+		return GAE_FALSE;
+
+	image->width = (unsigned int)width;
+	image->height = (unsigned int)height;
+	image->pixels = malloc(sizeof(float) * 4U * image->width * image->height);
+	for (index = 0UL; index < 4UL * image->width * image->height; ++index)
+		image->pixels[index] = (float)data[index];
+
+	stbi_image_free(data);
+	return GAE_TRUE;
+}
+
+void premultiply(Image_t* image) {
+	unsigned long index = 0UL;
+
+	for (index = 0UL; index < (unsigned long)image->width * image->height; ++index) {
+		float* pixel = &image->pixels[index * 4UL];
+		const float alpha = pixel[3] / 255.0F;
+		pixel[0] *= alpha;
+		pixel[1] *= alpha;
+		pixel[2] *= alpha;
+	}
+}
+
+float filterWeight(const MipFilter filter, const float distance) {
+	const float x = fabsf(distance);
+
+	if (MIP_FILTER_BOX == filter)
+		return (x < 0.5F) ? 1.0F : 0.0F;
+
+	/* Kaiser windowed sinc */
+	if (x >= KAISER_RADIUS)
+		return 0.0F;
+	else {
+		const float ratio = x / KAISER_RADIUS;
+		const float window = besselI0(KAISER_ALPHA * sqrtf(1.0F - ratio * ratio)) / besselI0(KAISER_ALPHA);
+		const float sinc = (x < 0.0001F) ? 1.0F : sinf(PI * x) / (PI * x);
+		return sinc * window;
+	}
+}
+
+float besselI0(const float x) {
+	float sum = 1.0F;
+	float term = 1.0F;
+	float k = 1.0F;
+
+	/* power series, converges quickly for the small alphas used here */
+	for (k = 1.0F; k < 32.0F; k += 1.0F) {
+		const float half = x / (2.0F * k);
+		term *= half * half;
+		sum += term;
+		if (term < sum * 1e-7F)
+			break;
+	}
+
+	return sum;
+}
+
+void resample(const float* source, const unsigned int sourceLength, const unsigned int sourceStride, float* target, const unsigned int targetLength, const unsigned int targetStride, const unsigned int count, const unsigned int step, const MipFilter filter) {
+	const float scale = (float)sourceLength / (float)targetLength;
+	const float radius = ((MIP_FILTER_BOX == filter) ? 0.5F : KAISER_RADIUS) * scale;
+	unsigned int line = 0U;
+	unsigned int index = 0U;
+
+	/* runs count independent lines of pixels, stride apart, with pixels step apart along each line */
+	for (line = 0U; line < count; ++line) {
+		const float* sourceLine = source + line * sourceStride * 4U;
+		float* targetLine = target + line * targetStride * 4U;
+
+		for (index = 0U; index < targetLength; ++index) {
+			const float centre = ((float)index + 0.5F) * scale;
+			const int first = (int)floorf(centre - radius);
+			const int last = (int)ceilf(centre + radius);
+			float sum[4] = { 0.0F, 0.0F, 0.0F, 0.0F };
+			float total = 0.0F;
+			unsigned int channel = 0U;
+			int tap = 0;
+
+			for (tap = first; tap <= last; ++tap) {
+				const float weight = filterWeight(filter, ((float)tap + 0.5F - centre) / scale);
+				const int clamped = (tap < 0) ? 0 : ((tap >= (int)sourceLength) ? (int)sourceLength - 1 : tap);
+				const float* pixel = sourceLine + (unsigned int)clamped * step * 4U;
+
+				if (0.0F == weight)
+					continue;
+
+				for (channel = 0U; channel < 4U; ++channel)
+					sum[channel] += pixel[channel] * weight;
+				total += weight;
+			}
+
+			for (channel = 0U; channel < 4U; ++channel) {
+				const float value = sum[channel] / total;
+				targetLine[index * step * 4U + channel] = (value < 0.0F) ? 0.0F : ((value > 255.0F) ? 255.0F : value);
+			}
+		}
+	}
+}
+
+Image_t downsample(const Image_t* source, const MipFilter filter) {
+	Image_t target;
+	float* horizontal = 0;
+
+	target.width = (1U < source->width) ? source->width >> 1U : 1U;
+	target.height = (1U < source->height) ? source->height >> 1U : 1U;
+	target.pixels = malloc(sizeof(float) * 4U * target.width * target.height);
+
+	/* separable - rows first into a target width x source height image, then columns */
+	horizontal = malloc(sizeof(float) * 4U * target.width * source->height);
+	resample(source->pixels, source->width, source->width, horizontal, target.width, target.width, source->height, 1U, filter);
+	resample(horizontal, source->height, 1U, target.pixels, target.height, 1U, target.width, target.width, filter);
+	free(horizontal);
+
+	return target;
+}
+
+void quantise(const Image_t* image, const GAE_CookedTexture_Format format, GAE_BYTE* target) {
+	const unsigned int pixelSize = (GAE_COOKED_TEXTURE_FORMAT_RGB8 == format) ? 3U : 4U;
+	const unsigned int rowSize = GAE_CookedTexture_getLevelSize(format, image->width, 1U);
+	unsigned int x = 0U;
+	unsigned int y = 0U;
+	unsigned int channel = 0U;
+
+	memset(target, 0, rowSize * image->height);
+	for (y = 0U; y < image->height; ++y) {
+		for (x = 0U; x < image->width; ++x) {
+			const float* pixel = &image->pixels[(y * image->width + x) * 4U];
+			for (channel = 0U; channel < pixelSize; ++channel)
+				target[y * rowSize + x * pixelSize + channel] = (GAE_BYTE)(pixel[channel] + 0.5F);
+		}
+	}
+}
+
+GAE_BOOL writeUint32(FILE* file, const unsigned int value) {
+	GAE_BYTE bytes[4];
+
+	bytes[0] = (GAE_BYTE)(value & 0xFFU);
+	bytes[1] = (GAE_BYTE)((value >> 8U) & 0xFFU);
+	bytes[2] = (GAE_BYTE)((value >> 16U) & 0xFFU);
+	bytes[3] = (GAE_BYTE)(value >> 24U);
+
+	return (4U == fwrite(bytes, 1U, 4U, file)) ? GAE_TRUE : GAE_FALSE;
+}
+
+GAE_BOOL writeTexture(const char* path, Image_t* levels, const unsigned int levelCount, const GAE_CookedTexture_Format format, const unsigned int flags) {
+	FILE* file = fopen(path, "wb");
+	const GAE_BYTE padding[GAE_COOKED_TEXTURE_ALIGNMENT] = { 0U };
+	unsigned int offsets[GAE_COOKED_TEXTURE_MAX_LEVELS];
+	unsigned int offset = GAE_COOKED_TEXTURE_HEADER_SIZE + levelCount * 8U;
+	unsigned int position = 0U;
+	unsigned int level = 0U;
+	GAE_BOOL status = GAE_TRUE;
+
+	if (0 == file)
+		return GAE_FALSE;
+
+	for (level = 0U; level < levelCount; ++level) {
+		offset = (offset + GAE_COOKED_TEXTURE_ALIGNMENT - 1U) & ~(GAE_COOKED_TEXTURE_ALIGNMENT - 1U);
+		offsets[level] = offset;
+		offset += GAE_CookedTexture_getLevelSize(format, levels[level].width, levels[level].height);
+	}
+
+	status = (4U == fwrite("GTEX", 1U, 4U, file)) ? GAE_TRUE : GAE_FALSE;
+	status &= writeUint32(file, GAE_COOKED_TEXTURE_VERSION);
+	status &= writeUint32(file, (unsigned int)format);
+	status &= writeUint32(file, levels[0].width);
+	status &= writeUint32(file, levels[0].height);
+	status &= writeUint32(file, levelCount);
+	status &= writeUint32(file, flags);
+	status &= writeUint32(file, 0U);
+
+	for (level = 0U; level < levelCount; ++level) {
+		status &= writeUint32(file, offsets[level]);
+		status &= writeUint32(file, GAE_CookedTexture_getLevelSize(format, levels[level].width, levels[level].height));
+	}
+
+	position = GAE_COOKED_TEXTURE_HEADER_SIZE + levelCount * 8U;
+	for (level = 0U; (level < levelCount) && (GAE_TRUE == status); ++level) {
+		const unsigned int size = GAE_CookedTexture_getLevelSize(format, levels[level].width, levels[level].height);
+		GAE_BYTE* data = malloc(size);
+
+		if (offsets[level] != position)
+			status &= (offsets[level] - position == fwrite(padding, 1U, offsets[level] - position, file)) ? GAE_TRUE : GAE_FALSE;
+
+		quantise(&levels[level], format, data);
+		status &= (size == fwrite(data, 1U, size, file)) ? GAE_TRUE : GAE_FALSE;
+		position = offsets[level] + size;
+		free(data);
+	}
+
+	if (0 != fclose(file))
+		status = GAE_FALSE;
+
+	return status;
+}
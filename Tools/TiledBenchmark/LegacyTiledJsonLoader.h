@@ -0,0 +1,9 @@
+#ifndef _LEGACY_TILED_JSON_LOADER_H_
+#define _LEGACY_TILED_JSON_LOADER_H_
+
+#include "../../Utils/Tiled/TiledJsonLoader.h"
+
+/* Parses the map in string as GAE_TiledParser_create did before the single pass parser, through jsmn. The string is written to. Returns the map unbaked - delete it with GAE_TiledParser_delete. */
+GAE_Tiled_t* GAE_LegacyTiledParser_parse(char* string);
+
+#endif
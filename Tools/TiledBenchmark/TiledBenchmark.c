@@ -0,0 +1,290 @@
+/* Tiled benchmark - times GAE_TiledParser_parse on each map, read into memory beforehand so only the parse is counted.
+ * Without any maps, a 1MB and a 50MB one are generated in the working directory, laid out as Tiled writes them
+ * with four layers of random tiles, then the same again with the layers' data base64 encoded, and removed again afterwards.
+ * Built with TILED_BENCHMARK_LEGACY, the jsmn loader the parser replaced is timed on each CSV map too, and its layers checked against the parser's.
+ * Usage: tiledbenchmark [-iterations N] [map ...]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../../GAE_Types.h"
+#include "../../File/File.h"
+#include "../../Utils/Array.h"
+#include "../../Utils/Tiled/TiledJsonLoader.h"
+
+#ifdef TILED_BENCHMARK_LEGACY
+	#include "LegacyTiledJsonLoader.h"
+#endif
+
+#define GENERATED_LAYERS 4U
+#define GENERATED_TILESET_SIZE 240U
+
+static void printUsage(const char* name);
+static GAE_BOOL generateMap(const char* const path, const unsigned int size, const GAE_BOOL isBase64);
+static void writeBase64(FILE* file, const unsigned int* const tiles, const unsigned int count);
+static GAE_BOOL benchmark(const char* const path, const unsigned int iterations);
+#ifdef TILED_BENCHMARK_LEGACY
+static GAE_BOOL benchmarkLegacy(GAE_File_t* const file, const char* const path, const unsigned int iterations, const double parseSeconds);
+static GAE_BOOL isSameLayers(GAE_Tiled_t* const tilemap, GAE_Tiled_t* const legacyMap);
+#endif
+
+int main(int argc, char** argv) {
+	static const char* const generatedPaths[4] = { "tiledbenchmark_1mb.json", "tiledbenchmark_1mb_base64.json", "tiledbenchmark_50mb.json", "tiledbenchmark_50mb_base64.json" };
+	/* the grid sizes that fill roughly 1MB and 50MB at four layers of random tiles written as CSV */
+	static const unsigned int generatedSizes[4] = { 249U, 249U, 1766U, 1766U };
+	unsigned int iterations = 10U;
+	GAE_BOOL status = GAE_TRUE;
+	int arg = 1;
+
+	while ((arg < argc) && ('-' == argv[arg][0])) {
+		if ((0 == strcmp(argv[arg], "-iterations")) && (arg + 1 < argc))
+			iterations = (unsigned int)strtoul(argv[++arg], 0, 10);
+		else {
+			printUsage(argv[0]);
+			return 1;
+		}
+		++arg;
+	}
+
+	if (0U == iterations) {
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	if (arg < argc) {
+		for (; (arg < argc) && (GAE_TRUE == status); ++arg)
+			status = benchmark(argv[arg], iterations);
+	}
+	else {
+		unsigned int index = 0U;
+
+		for (index = 0U; (index < 4U) && (GAE_TRUE == status); ++index) {
+			status = generateMap(generatedPaths[index], generatedSizes[index], (1U == index % 2U) ? GAE_TRUE : GAE_FALSE);
+			if (GAE_TRUE == status)
+				status = benchmark(generatedPaths[index], iterations);
+			remove(generatedPaths[index]);
+		}
+	}
+
+	return (GAE_TRUE == status) ? 0 : 1;
+}
+
+void printUsage(const char* name) {
+	fprintf(stderr, "Usage: %s [-iterations N] [map ...]\n", name);
+}
+
+GAE_BOOL generateMap(const char* const path, const unsigned int size, const GAE_BOOL isBase64) {
+	FILE* file = fopen(path, "w");
+	unsigned int* tiles = 0;
+	unsigned int layer = 0U;
+	unsigned int tile = 0U;
+	unsigned int seed = 1U;
+	GAE_BOOL status = GAE_TRUE;
+
+	if (0 == file) {
+		fprintf(stderr, "Failed to create %s\n", path);
+		return GAE_FALSE;
+	}
+
+	tiles = malloc(size * size * sizeof(unsigned int));
+	fprintf(file, "{ \"height\":%u,\n \"layers\":[\n", size);
+	for (layer = 0U; layer < GENERATED_LAYERS; ++layer) {
+		for (tile = 0U; tile < size * size; ++tile) {
+			seed = (seed * 1103515245U) + 12345U;
+			/* the last layer is mostly empty, as detail layers are */
+			tiles[tile] = ((GENERATED_LAYERS - 1U == layer) && (0U != (seed >> 16U) % 8U)) ? 0U : (seed >> 16U) % GENERATED_TILESET_SIZE;
+		}
+
+		if (GAE_TRUE == isBase64) {
+			fprintf(file, "        {\n         \"compression\":\"\",\n         \"data\":\"");
+			writeBase64(file, tiles, size * size);
+			fprintf(file, "\",\n         \"encoding\":\"base64\",\n");
+		}
+		else {
+			fprintf(file, "        {\n         \"data\":[");
+			for (tile = 0U; tile < size * size; ++tile)
+				fprintf(file, (0U == tile) ? "%u" : ", %u", tiles[tile]);
+			fprintf(file, "],\n");
+		}
+
+		fprintf(file, "         \"height\":%u,\n         \"name\":\"Layer %u\",\n         \"opacity\":1,\n         \"type\":\"tilelayer\",\n"
+			"         \"visible\":true,\n         \"width\":%u,\n         \"x\":0,\n         \"y\":0\n        }%s\n", size, layer, size, (GENERATED_LAYERS - 1U == layer) ? "" : ",");
+	}
+	free(tiles);
+
+	fprintf(file, " ],\n \"orientation\":\"orthogonal\",\n \"properties\":\n    {\n     \"music\":\"level1.ogg\"\n    },\n \"tileheight\":16,\n"
+		" \"tilesets\":[\n        {\n         \"firstgid\":1,\n         \"imageheight\":256,\n         \"imagewidth\":256,\n         \"margin\":0,\n"
+		"         \"name\":\"tiles\",\n         \"properties\":\n            {\n\n            },\n         \"spacing\":0,\n"
+		"         \"tileheight\":16,\n         \"tilewidth\":16\n        }],\n \"tilewidth\":16,\n \"version\":1,\n \"width\":%u\n}\n", size);
+
+	if (0 != ferror(file))
+		status = GAE_FALSE;
+	if (0 != fclose(file))
+		status = GAE_FALSE;
+	if (GAE_FALSE == status)
+		fprintf(stderr, "Failed to write %s\n", path);
+
+	return status;
+}
+
+/* Writes the tiles as Tiled does, each as four little endian bytes, base64 encoded with padding. */
+void writeBase64(FILE* file, const unsigned int* const tiles, const unsigned int count) {
+	static const char* const ALPHABET = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	const unsigned long size = (unsigned long)count * 4UL;
+	unsigned long index = 0UL;
+
+	for (index = 0UL; index < size; index += 3UL) {
+		unsigned long group = 0UL;
+		unsigned long byte = 0UL;
+
+		for (byte = 0UL; byte < 3UL; ++byte) {
+			group <<= 8U;
+			if (index + byte < size)
+				group |= (tiles[(index + byte) / 4UL] >> (((index + byte) % 4UL) * 8U)) & 0xFFU;
+		}
+
+		fputc(ALPHABET[(group >> 18U) & 0x3FU], file);
+		fputc(ALPHABET[(group >> 12U) & 0x3FU], file);
+		fputc((index + 1UL < size) ? ALPHABET[(group >> 6U) & 0x3FU] : '=', file);
+		fputc((index + 2UL < size) ? ALPHABET[group & 0x3FU] : '=', file);
+	}
+}
+
+GAE_BOOL benchmark(const char* const path, const unsigned int iterations) {
+	GAE_File_t* file = GAE_File_create(path);
+	GAE_FILE_STATUS fileStatus = GAE_FILE_ERROR;
+	GAE_FILE_READ_STATUS readStatus = GAE_FILE_READ_ERROR;
+	unsigned long tiles = 0UL;
+	unsigned int iteration = 0U;
+	double parseTime = 0.0;
+	double seconds = 0.0;
+
+	GAE_File_open(file, GAE_FILE_OPEN_READ, GAE_FILE_ASCII, &fileStatus);
+	if (GAE_FILE_OPEN == fileStatus)
+		GAE_File_read(file, GAE_FILE_READ_ALL, &readStatus);
+	GAE_File_close(file, GAE_FILE_CLOSE_RETAIN_DATA, 0);
+
+	if (GAE_FILE_READ_ERROR == readStatus) {
+		fprintf(stderr, "Failed to read %s\n", path);
+		GAE_File_delete(file);
+		return GAE_FALSE;
+	}
+
+	for (iteration = 0U; iteration < iterations; ++iteration) {
+		const clock_t start = clock();
+		GAE_Tiled_t* tilemap = GAE_TiledParser_parse(file);
+		GAE_Tiled_Layer_t* layer = 0;
+
+		parseTime += (double)(clock() - start) / (double)CLOCKS_PER_SEC;
+		if (0 == tilemap) {
+			fprintf(stderr, "%s isn't a valid map\n", path);
+			GAE_File_deleteBuffer(file, 0);
+			GAE_File_delete(file);
+			return GAE_FALSE;
+		}
+
+		tiles = 0UL;
+		for (layer = GAE_Array_begin(tilemap->layers); layer < (GAE_Tiled_Layer_t*)GAE_Array_end(tilemap->layers); ++layer) {
+			if (0 != layer->data)
+				tiles += GAE_Array_length(layer->data);
+		}
+
+		GAE_TiledParser_delete(tilemap);
+	}
+
+	seconds = parseTime / (double)iterations;
+	printf("%s: %lu bytes, %lu tiles - %.3fms per parse, %.1fMB/s\n", path, file->bufferSize, tiles,
+		seconds * 1000.0, (0.0 < seconds) ? (double)file->bufferSize / (seconds * 1048576.0) : 0.0);
+
+#ifdef TILED_BENCHMARK_LEGACY
+	if (GAE_FALSE == benchmarkLegacy(file, path, iterations, seconds)) {
+		GAE_File_deleteBuffer(file, 0);
+		GAE_File_delete(file);
+		return GAE_FALSE;
+	}
+#endif
+
+	GAE_File_deleteBuffer(file, 0);
+	GAE_File_delete(file);
+	return GAE_TRUE;
+}
+
+#ifdef TILED_BENCHMARK_LEGACY
+GAE_BOOL benchmarkLegacy(GAE_File_t* const file, const char* const path, const unsigned int iterations, const double parseSeconds) {
+	/* the legacy loader writes terminators into the string, so each run gets a fresh copy, made off the clock */
+	char* string = 0;
+	GAE_Tiled_t* tilemap = 0;
+	unsigned int iteration = 0U;
+	double parseTime = 0.0;
+	double seconds = 0.0;
+	GAE_BOOL status = GAE_TRUE;
+
+	if (0 != strstr((const char*)file->buffer, "\"encoding\"")) {
+		printf("%s: skipped by the legacy loader, which only reads CSV layer data\n", path);
+		return GAE_TRUE;
+	}
+
+	tilemap = GAE_TiledParser_parse(file);
+	string = malloc(file->bufferSize + 1U);
+	for (iteration = 0U; (iteration < iterations) && (GAE_TRUE == status); ++iteration) {
+		clock_t start = 0;
+		GAE_Tiled_t* legacyMap = 0;
+
+		memcpy(string, file->buffer, file->bufferSize);
+		string[file->bufferSize] = '\0';
+
+		start = clock();
+		legacyMap = GAE_LegacyTiledParser_parse(string);
+		parseTime += (double)(clock() - start) / (double)CLOCKS_PER_SEC;
+
+		if ((0U == iteration) && (GAE_FALSE == isSameLayers(tilemap, legacyMap))) {
+			fprintf(stderr, "%s: the legacy loader's layers don't match the parser's\n", path);
+			status = GAE_FALSE;
+		}
+
+		GAE_TiledParser_delete(legacyMap);
+	}
+	free(string);
+	GAE_TiledParser_delete(tilemap);
+
+	if (GAE_FALSE == status)
+		return GAE_FALSE;
+
+	seconds = parseTime / (double)iterations;
+	printf("%s: legacy loader - %.3fms per parse, %.1fMB/s, %.1fx the parser's time\n", path, seconds * 1000.0,
+		(0.0 < seconds) ? (double)file->bufferSize / (seconds * 1048576.0) : 0.0, (0.0 < parseSeconds) ? seconds / parseSeconds : 0.0);
+
+	return GAE_TRUE;
+}
+
+/* Compares the layers' sizes and data - the rest the legacy loader reads differently, or not at all. */
+GAE_BOOL isSameLayers(GAE_Tiled_t* const tilemap, GAE_Tiled_t* const legacyMap) {
+	unsigned int layerIndex = 0U;
+
+	if (GAE_Array_length(tilemap->layers) != GAE_Array_length(legacyMap->layers))
+		return GAE_FALSE;
+
+	for (layerIndex = 0U; layerIndex < GAE_Array_length(tilemap->layers); ++layerIndex) {
+		GAE_Tiled_Layer_t* layer = GAE_Array_get(tilemap->layers, layerIndex);
+		GAE_Tiled_Layer_t* legacyLayer = GAE_Array_get(legacyMap->layers, layerIndex);
+		const unsigned int length = (0 != layer->data) ? GAE_Array_length(layer->data) : 0U;
+		unsigned int index = 0U;
+
+		if ((layer->width != legacyLayer->width) || (layer->height != legacyLayer->height))
+			return GAE_FALSE;
+
+		if (length != ((0 != legacyLayer->data) ? GAE_Array_length(legacyLayer->data) : 0U))
+			return GAE_FALSE;
+
+		for (index = 0U; index < length; ++index) {
+			if (GAE_TiledParser_getGid(layer, index) != *(unsigned int*)GAE_Array_get(legacyLayer->data, index))
+				return GAE_FALSE;
+		}
+	}
+
+	return GAE_TRUE;
+}
+#endif
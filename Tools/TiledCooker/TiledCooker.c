@@ -0,0 +1,316 @@
+/* Tiled cooker - cooks each Tiled JSON map into the binary form GAE_TiledParser_create loads without parsing (see Utils/Tiled/TiledCooked.h).
+ * With -verify, each cooked map is loaded back and every field of it compared against the JSON it came from.
+ * With -bench, each map and its cooked copy are then loaded, parsed and every tile read, with the time taken printed.
+ * Usage: tiledcooker [-verify] [-bench ITERATIONS] input output [input output ...]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../GAE_Types.h"
+#include "../../File/File.h"
+#include "../../Time/Clock.h"
+#include "../../Utils/Array.h"
+#include "../../Utils/Map.h"
+#include "../../Utils/Tiled/TiledJsonLoader.h"
+#include "../../Utils/Tiled/TiledCooked.h"
+
+static void printUsage(const char* name);
+static GAE_Tiled_t* loadMap(const char* const path, GAE_File_t** file);
+static void deleteMap(GAE_Tiled_t* tilemap, GAE_File_t* file);
+static GAE_BOOL cookFile(const char* const input, const char* const output);
+static GAE_BOOL isSameProperties(GAE_Map_t* const properties, GAE_Map_t* const cookedProperties);
+static GAE_BOOL isSameLayer(GAE_Tiled_Layer_t* const layer, GAE_Tiled_Layer_t* const cookedLayer);
+static GAE_BOOL isSameTileset(GAE_Tiled_Tileset_t* const tileset, GAE_Tiled_Tileset_t* const cookedTileset);
+static GAE_BOOL verify(const char* const input, const char* const output);
+static GAE_BOOL benchmark(const char* const input, const char* const output, const unsigned int iterations);
+
+int main(int argc, char** argv) {
+	GAE_BOOL isVerified = GAE_FALSE;
+	unsigned int iterations = 0U;
+	GAE_BOOL status = GAE_TRUE;
+	int first = 0;
+	int arg = 1;
+
+	while ((arg < argc) && ('-' == argv[arg][0])) {
+		if (0 == strcmp(argv[arg], "-verify"))
+			isVerified = GAE_TRUE;
+		else if ((0 == strcmp(argv[arg], "-bench")) && (arg + 1 < argc))
+			iterations = (unsigned int)strtoul(argv[++arg], 0, 10);
+		else {
+			printUsage(argv[0]);
+			return 1;
+		}
+		++arg;
+	}
+
+	if ((arg >= argc) || (0 != (argc - arg) % 2)) {
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	first = arg;
+	for (; (arg < argc) && (GAE_TRUE == status); arg += 2)
+		status = cookFile(argv[arg], argv[arg + 1]);
+
+	for (arg = first; (GAE_TRUE == isVerified) && (arg < argc) && (GAE_TRUE == status); arg += 2)
+		status = verify(argv[arg], argv[arg + 1]);
+
+	for (arg = first; (0U < iterations) && (arg < argc) && (GAE_TRUE == status); arg += 2)
+		status = benchmark(argv[arg], argv[arg + 1], iterations);
+
+	return (GAE_TRUE == status) ? 0 : 1;
+}
+
+void printUsage(const char* name) {
+	fprintf(stderr, "Usage: %s [-verify] [-bench ITERATIONS] input output [input output ...]\n", name);
+}
+
+/* Maps the file and parses it, without loading images or baking - the file is kept open for a cooked map's layers to point into. */
+GAE_Tiled_t* loadMap(const char* const path, GAE_File_t** file) {
+	GAE_FILE_STATUS fileStatus = GAE_FILE_ERROR;
+	GAE_FILE_READ_STATUS readStatus = GAE_FILE_READ_ERROR;
+	GAE_Tiled_t* tilemap = 0;
+
+	*file = GAE_File_create(path);
+	GAE_File_open(*file, GAE_FILE_OPEN_MAP, GAE_FILE_BINARY, &fileStatus);
+	if (GAE_FILE_OPEN == fileStatus)
+		GAE_File_read(*file, GAE_FILE_READ_ALL, &readStatus);
+
+	if (GAE_FILE_READ_ERROR != readStatus)
+		tilemap = GAE_TiledParser_parse(*file);
+
+	if (0 == tilemap) {
+		GAE_File_close(*file, GAE_FILE_CLOSE_DELETE_DATA, 0);
+		GAE_File_delete(*file);
+		*file = 0;
+	}
+
+	return tilemap;
+}
+
+void deleteMap(GAE_Tiled_t* tilemap, GAE_File_t* file) {
+	GAE_TiledParser_delete(tilemap);
+	GAE_File_close(file, GAE_FILE_CLOSE_DELETE_DATA, 0);
+	GAE_File_delete(file);
+}
+
+GAE_BOOL cookFile(const char* const input, const char* const output) {
+	GAE_File_t* file = 0;
+	GAE_Tiled_t* tilemap = loadMap(input, &file);
+	GAE_BYTE* cooked = 0;
+	unsigned long cookedSize = 0UL;
+	FILE* outputFile = 0;
+	GAE_BOOL status = GAE_FALSE;
+
+	if (0 == tilemap) {
+		fprintf(stderr, "%s isn't a valid map\n", input);
+		return GAE_FALSE;
+	}
+
+	cooked = GAE_TiledCooked_write(tilemap, &cookedSize);
+	if (0 == cooked)
+		fprintf(stderr, "%s is too large to cook\n", input);
+	else {
+		outputFile = fopen(output, "wb");
+		if (0 != outputFile) {
+			status = (cookedSize == fwrite(cooked, 1U, cookedSize, outputFile)) ? GAE_TRUE : GAE_FALSE;
+			if (0 != fclose(outputFile))
+				status = GAE_FALSE;
+		}
+
+		if (GAE_FALSE == status)
+			fprintf(stderr, "Failed to write %s\n", output);
+		else
+			printf("%s: %lu bytes into %lu\n", input, file->bufferSize, cookedSize);
+	}
+
+	free(cooked);
+	deleteMap(tilemap, file);
+	return status;
+}
+
+GAE_BOOL isSameProperties(GAE_Map_t* const properties, GAE_Map_t* const cookedProperties) {
+	unsigned int index = 0U;
+
+	if ((0 == properties) || (0 == cookedProperties))
+		return (properties == cookedProperties) ? GAE_TRUE : GAE_FALSE;
+
+	if (GAE_Map_length(properties) != GAE_Map_length(cookedProperties))
+		return GAE_FALSE;
+
+	/* both filled in the order they were written */
+	for (index = 0U; index < GAE_Map_length(properties); ++index) {
+		if ((0 != strcmp((char*)GAE_Array_get(properties->ids, index), (char*)GAE_Array_get(cookedProperties->ids, index)))
+		|| (0 != strcmp((char*)GAE_Array_get(properties->values, index), (char*)GAE_Array_get(cookedProperties->values, index))))
+			return GAE_FALSE;
+	}
+
+	return GAE_TRUE;
+}
+
+GAE_BOOL isSameLayer(GAE_Tiled_Layer_t* const layer, GAE_Tiled_Layer_t* const cookedLayer) {
+	unsigned int index = 0U;
+
+	if ((0 != strcmp(layer->name, cookedLayer->name)) || (0 != strcmp(layer->type, cookedLayer->type))
+	|| (layer->width != cookedLayer->width) || (layer->height != cookedLayer->height) || (layer->opacity != cookedLayer->opacity)
+	|| (layer->visible != cookedLayer->visible) || (layer->x != cookedLayer->x) || (layer->y != cookedLayer->y))
+		return GAE_FALSE;
+
+	if ((0 == layer->data) || (0 == cookedLayer->data))
+		return (layer->data == cookedLayer->data) ? GAE_TRUE : GAE_FALSE;
+
+	if (GAE_Array_length(layer->data) != GAE_Array_length(cookedLayer->data))
+		return GAE_FALSE;
+
+	for (index = 0U; index < GAE_Array_length(layer->data); ++index) {
+		if (GAE_TiledParser_getGid(layer, index) != GAE_TiledParser_getGid(cookedLayer, index))
+			return GAE_FALSE;
+	}
+
+	return GAE_TRUE;
+}
+
+GAE_BOOL isSameTileset(GAE_Tiled_Tileset_t* const tileset, GAE_Tiled_Tileset_t* const cookedTileset) {
+	unsigned int index = 0U;
+
+	if ((0 != strcmp(tileset->name, cookedTileset->name)) || (0 != strcmp(tileset->imagePath, cookedTileset->imagePath))
+	|| (tileset->firstGid != cookedTileset->firstGid) || (tileset->imageWidth != cookedTileset->imageWidth) || (tileset->imageHeight != cookedTileset->imageHeight)
+	|| (tileset->margin != cookedTileset->margin) || (tileset->spacing != cookedTileset->spacing)
+	|| (tileset->tileWidth != cookedTileset->tileWidth) || (tileset->tileHeight != cookedTileset->tileHeight)
+	|| (tileset->offset[0] != cookedTileset->offset[0]) || (tileset->offset[1] != cookedTileset->offset[1]))
+		return GAE_FALSE;
+
+	if ((GAE_FALSE == isSameProperties(tileset->properties, cookedTileset->properties))
+	|| (GAE_Array_length(tileset->terrains) != GAE_Array_length(cookedTileset->terrains))
+	|| (GAE_Array_length(tileset->tiles) != GAE_Array_length(cookedTileset->tiles)))
+		return GAE_FALSE;
+
+	for (index = 0U; index < GAE_Array_length(tileset->terrains); ++index) {
+		GAE_Tiled_Terrain_t* terrain = GAE_Array_get(tileset->terrains, index);
+		GAE_Tiled_Terrain_t* cookedTerrain = GAE_Array_get(cookedTileset->terrains, index);
+
+		if ((0 != strcmp(terrain->name, cookedTerrain->name)) || (terrain->tile != cookedTerrain->tile))
+			return GAE_FALSE;
+	}
+
+	for (index = 0U; index < GAE_Array_length(tileset->tiles); ++index) {
+		GAE_Tiled_Tile_t* tile = GAE_Array_get(tileset->tiles, index);
+		GAE_Tiled_Tile_t* cookedTile = GAE_Array_get(cookedTileset->tiles, index);
+
+		if ((tile->id != cookedTile->id) || (0 != memcmp(tile->terrain, cookedTile->terrain, sizeof(tile->terrain))))
+			return GAE_FALSE;
+	}
+
+	return GAE_TRUE;
+}
+
+GAE_BOOL verify(const char* const input, const char* const output) {
+	GAE_File_t* file = 0;
+	GAE_File_t* cookedFile = 0;
+	GAE_Tiled_t* tilemap = loadMap(input, &file);
+	GAE_Tiled_t* cookedMap = loadMap(output, &cookedFile);
+	GAE_BOOL status = GAE_TRUE;
+	unsigned int index = 0U;
+
+	if ((0 == tilemap) || (0 == cookedMap)) {
+		fprintf(stderr, "Failed to load %s or %s\n", input, output);
+		status = GAE_FALSE;
+	}
+	else {
+		if ((tilemap->width != cookedMap->width) || (tilemap->height != cookedMap->height) || (tilemap->tileWidth != cookedMap->tileWidth)
+		|| (tilemap->tileHeight != cookedMap->tileHeight) || (tilemap->version != cookedMap->version) || (tilemap->orientation != cookedMap->orientation)) {
+			fprintf(stderr, "%s: map differs\n", output);
+			status = GAE_FALSE;
+		}
+
+		if (GAE_FALSE == isSameProperties(tilemap->properties, cookedMap->properties)) {
+			fprintf(stderr, "%s: map properties differ\n", output);
+			status = GAE_FALSE;
+		}
+
+		if (GAE_Array_length(tilemap->layers) != GAE_Array_length(cookedMap->layers)) {
+			fprintf(stderr, "%s: %u layers rather than %u\n", output, GAE_Array_length(cookedMap->layers), GAE_Array_length(tilemap->layers));
+			status = GAE_FALSE;
+		}
+		for (index = 0U; (GAE_TRUE == status) && (index < GAE_Array_length(tilemap->layers)); ++index) {
+			if (GAE_FALSE == isSameLayer(GAE_Array_get(tilemap->layers, index), GAE_Array_get(cookedMap->layers, index))) {
+				fprintf(stderr, "%s: layer %u differs\n", output, index);
+				status = GAE_FALSE;
+			}
+		}
+
+		if (GAE_Array_length(tilemap->tilesets) != GAE_Array_length(cookedMap->tilesets)) {
+			fprintf(stderr, "%s: %u tilesets rather than %u\n", output, GAE_Array_length(cookedMap->tilesets), GAE_Array_length(tilemap->tilesets));
+			status = GAE_FALSE;
+		}
+		for (index = 0U; (GAE_TRUE == status) && (index < GAE_Array_length(tilemap->tilesets)); ++index) {
+			if (GAE_FALSE == isSameTileset(GAE_Array_get(tilemap->tilesets, index), GAE_Array_get(cookedMap->tilesets, index))) {
+				fprintf(stderr, "%s: tileset %u differs\n", output, index);
+				status = GAE_FALSE;
+			}
+		}
+
+		if (GAE_TRUE == status)
+			printf("%s: matches %s\n", output, input);
+	}
+
+	if (0 != tilemap)
+		deleteMap(tilemap, file);
+	if (0 != cookedMap)
+		deleteMap(cookedMap, cookedFile);
+	return status;
+}
+
+GAE_BOOL benchmark(const char* const input, const char* const output, const unsigned int iterations) {
+	GAE_Clock_t* timer = GAE_Clock_create();
+	const char* paths[2];
+	float times[2] = { 0.0F, 0.0F };
+	unsigned long sums[2] = { 0UL, 0UL };
+	unsigned int iteration = 0U;
+	unsigned int index = 0U;
+	GAE_BOOL status = GAE_TRUE;
+
+	paths[0] = input;
+	paths[1] = output;
+
+	for (iteration = 0U; (iteration < iterations) && (GAE_TRUE == status); ++iteration) {
+		for (index = 0U; (index < 2U) && (GAE_TRUE == status); ++index) {
+			GAE_File_t* file = 0;
+			GAE_Tiled_t* tilemap = 0;
+			GAE_Tiled_Layer_t* layer = 0;
+
+			GAE_Clock_reset(timer);
+			tilemap = loadMap(paths[index], &file);
+			if (0 == tilemap) {
+				status = GAE_FALSE;
+				break;
+			}
+
+			/* every tile read once, as baking would, so the cooked map's pages are all touched */
+			for (layer = GAE_Array_begin(tilemap->layers); layer < (GAE_Tiled_Layer_t*)GAE_Array_end(tilemap->layers); ++layer) {
+				unsigned int tile = 0U;
+
+				for (tile = 0U; (0 != layer->data) && (tile < GAE_Array_length(layer->data)); ++tile)
+					sums[index] += GAE_TiledParser_getGid(layer, tile);
+			}
+
+			deleteMap(tilemap, file);
+			GAE_Clock_update(timer);
+			times[index] += timer->deltaTime;
+		}
+	}
+
+	if (GAE_FALSE == status)
+		fprintf(stderr, "Failed to load %s or %s\n", input, output);
+	else {
+		if (sums[0] != sums[1])
+			fprintf(stderr, "%s doesn't hold the tiles of %s\n", output, input);
+
+		printf("%s: %.3fms, cooked %.3fms\n", input, times[0] * 1000.0F / (float)iterations, times[1] * 1000.0F / (float)iterations);
+	}
+
+	GAE_Clock_delete(timer);
+	return status;
+}
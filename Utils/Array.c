@@ -39,6 +39,15 @@ GAE_Array_t* GAE_Array_reserve(GAE_Array_t* array, const unsigned int amount) {
 	return array;
 }
 
+GAE_Array_t* GAE_Array_resize(GAE_Array_t* array, const unsigned int length) {
+	if ((length * array->size) > array->allocated)
+		GAE_Array_reserve(array, length);
+
+	array->used = length * array->size;
+
+	return array;
+}
+
 GAE_Array_t* GAE_Array_push(GAE_Array_t* array, void* const data) {
 	if ((array->allocated - array->used) < array->size)
 		GAE_Array_reserve(array, GAE_Array_length(array) + 1U);
@@ -16,6 +16,9 @@ GAE_Array_t* GAE_Array_create(const unsigned int size);
 /* Creates a contiguous chunk of memory for the specified amount of Array elements. */
 GAE_Array_t* GAE_Array_reserve(GAE_Array_t* array, const unsigned int amount);
 
+/* Sets the length of the Array, reserving room if it grows - new elements are left uninitialised. */
+GAE_Array_t* GAE_Array_resize(GAE_Array_t* array, const unsigned int length);
+
 /* Copies the data into the Array - data can be freed after this call. */
 GAE_Array_t* GAE_Array_push(GAE_Array_t* array, void* const data);
 
@@ -0,0 +1,153 @@
+#include "Base64.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+	#define GAE_BASE64_SSE
+	#include <emmintrin.h>
+#endif
+
+#define INVALID 0x80U
+
+/* The six bits each character stands for, or INVALID. */
+static const GAE_BYTE VALUES[256] = {
+	0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U
+,	0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U
+,	0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x3EU, 0x80U, 0x80U, 0x80U, 0x3FU
+,	0x34U, 0x35U, 0x36U, 0x37U, 0x38U, 0x39U, 0x3AU, 0x3BU, 0x3CU, 0x3DU, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U
+,	0x80U, 0x00U, 0x01U, 0x02U, 0x03U, 0x04U, 0x05U, 0x06U, 0x07U, 0x08U, 0x09U, 0x0AU, 0x0BU, 0x0CU, 0x0DU, 0x0EU
+,	0x0FU, 0x10U, 0x11U, 0x12U, 0x13U, 0x14U, 0x15U, 0x16U, 0x17U, 0x18U, 0x19U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U
+,	0x80U, 0x1AU, 0x1BU, 0x1CU, 0x1DU, 0x1EU, 0x1FU, 0x20U, 0x21U, 0x22U, 0x23U, 0x24U, 0x25U, 0x26U, 0x27U, 0x28U
+,	0x29U, 0x2AU, 0x2BU, 0x2CU, 0x2DU, 0x2EU, 0x2FU, 0x30U, 0x31U, 0x32U, 0x33U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U
+,	0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U
+,	0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U
+,	0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U
+,	0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U
+,	0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U
+,	0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U
+,	0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U
+,	0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U
+};
+
+static unsigned long getPadding(const char* const source, const unsigned long length);
+
+unsigned long GAE_Base64_getDecodedSize(const char* const source, const unsigned long length) {
+	const unsigned long count = length - getPadding(source, length);
+	return ((count / 4UL) * 3UL) + (((count % 4UL) * 3UL) / 4UL);
+}
+
+GAE_BOOL GAE_Base64_decode(const char* const source, const unsigned long length, GAE_BYTE* destination, const unsigned long size) {
+	const unsigned char* in = (const unsigned char*)source;
+	const unsigned long padding = getPadding(source, length);
+	const unsigned long count = length - padding;
+	const unsigned long quads = count / 4UL;
+	GAE_BYTE* out = destination;
+	unsigned int invalid = 0U;
+	unsigned long quad = 0UL;
+
+	/* padding only ever rounds out the last quad, and a single character left over is never whole bytes */
+	if (((0UL != padding) && (0UL != length % 4UL)) || (1UL == count % 4UL) || (size != GAE_Base64_getDecodedSize(source, length)))
+		return GAE_FALSE;
+
+	#if defined(GAE_BASE64_SSE)
+	{
+		const __m128i upperLow = _mm_set1_epi8('A' - 1);
+		const __m128i upperHigh = _mm_set1_epi8('Z' + 1);
+		const __m128i lowerLow = _mm_set1_epi8('a' - 1);
+		const __m128i lowerHigh = _mm_set1_epi8('z' + 1);
+		const __m128i digitLow = _mm_set1_epi8('0' - 1);
+		const __m128i digitHigh = _mm_set1_epi8('9' + 1);
+		const __m128i plus = _mm_set1_epi8('+');
+		const __m128i slash = _mm_set1_epi8('/');
+		const __m128i lowBytes = _mm_set1_epi16(0x00FF);
+		const __m128i pairs = _mm_set1_epi32(0x00011000);
+		const __m128i lowLanes = _mm_set_epi32(0, 0x00FFFFFF, 0, 0x00FFFFFF);
+		const __m128i highLanes = _mm_set_epi32(0x00FFFFFF, 0, 0x00FFFFFF, 0);
+		const __m128i lowHalf = _mm_set_epi32(0, 0, -1, -1);
+		int valid = 0xFFFF;
+
+		/* twelve bytes are written sixteen at a time, so this stops while there are at least two quads left to overwrite the rest */
+		for (; quad + 6UL <= quads; quad += 4UL) {
+			const __m128i characters = _mm_loadu_si128((const __m128i*)(const void*)in);
+			const __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(characters, upperLow), _mm_cmplt_epi8(characters, upperHigh));
+			const __m128i lower = _mm_and_si128(_mm_cmpgt_epi8(characters, lowerLow), _mm_cmplt_epi8(characters, lowerHigh));
+			const __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(characters, digitLow), _mm_cmplt_epi8(characters, digitHigh));
+			const __m128i isPlus = _mm_cmpeq_epi8(characters, plus);
+			const __m128i isSlash = _mm_cmpeq_epi8(characters, slash);
+			__m128i shift = _mm_and_si128(upper, _mm_set1_epi8(-'A'));
+			__m128i values;
+
+			/* each character is shifted onto its value by whichever range it falls in - bytes above 127 compare as negative, so fall in none */
+			shift = _mm_or_si128(shift, _mm_and_si128(lower, _mm_set1_epi8(26 - 'a')));
+			shift = _mm_or_si128(shift, _mm_and_si128(digit, _mm_set1_epi8(52 - '0')));
+			shift = _mm_or_si128(shift, _mm_and_si128(isPlus, _mm_set1_epi8(62 - '+')));
+			shift = _mm_or_si128(shift, _mm_and_si128(isSlash, _mm_set1_epi8(63 - '/')));
+			valid &= _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, isPlus)), isSlash));
+			values = _mm_add_epi8(characters, shift);
+
+			/* the pairs of characters into twelve bits each, then those pairs into the 24 bits of each quad */
+			values = _mm_add_epi16(_mm_slli_epi16(_mm_and_si128(values, lowBytes), 6), _mm_srli_epi16(values, 8));
+			values = _mm_madd_epi16(values, pairs);
+
+			/* the three bytes of each quad into the order they're written, then packed down to the bottom twelve bytes */
+			values = _mm_or_si128(_mm_or_si128(_mm_and_si128(_mm_srli_epi32(values, 16), _mm_set1_epi32(0xFF)), _mm_and_si128(values, _mm_set1_epi32(0xFF00))),
+				_mm_slli_epi32(_mm_and_si128(values, _mm_set1_epi32(0xFF)), 16));
+			values = _mm_or_si128(_mm_and_si128(values, lowLanes), _mm_srli_epi64(_mm_and_si128(values, highLanes), 8));
+			values = _mm_or_si128(_mm_and_si128(values, lowHalf), _mm_srli_si128(_mm_andnot_si128(lowHalf, values), 2));
+			_mm_storeu_si128((__m128i*)(void*)out, values);
+			in += 16;
+			out += 12;
+		}
+
+		if (0xFFFF != valid)
+			return GAE_FALSE;
+	}
+	#endif
+
+	for (; quad + 2UL <= quads; quad += 2UL) {
+		const unsigned int first = ((unsigned int)VALUES[in[0]] << 18U) | ((unsigned int)VALUES[in[1]] << 12U) | ((unsigned int)VALUES[in[2]] << 6U) | (unsigned int)VALUES[in[3]];
+		const unsigned int second = ((unsigned int)VALUES[in[4]] << 18U) | ((unsigned int)VALUES[in[5]] << 12U) | ((unsigned int)VALUES[in[6]] << 6U) | (unsigned int)VALUES[in[7]];
+
+		invalid |= VALUES[in[0]] | VALUES[in[1]] | VALUES[in[2]] | VALUES[in[3]] | VALUES[in[4]] | VALUES[in[5]] | VALUES[in[6]] | VALUES[in[7]];
+		out[0] = (GAE_BYTE)(first >> 16U);
+		out[1] = (GAE_BYTE)(first >> 8U);
+		out[2] = (GAE_BYTE)first;
+		out[3] = (GAE_BYTE)(second >> 16U);
+		out[4] = (GAE_BYTE)(second >> 8U);
+		out[5] = (GAE_BYTE)second;
+		in += 8;
+		out += 6;
+	}
+
+	/* the last whole quad and whatever's left of a partial one, as if it were padded */
+	{
+		const unsigned long remaining = count - (unsigned long)((const char*)in - source);
+		unsigned int value = 0U;
+		unsigned long index = 0UL;
+
+		for (index = 0UL; index < remaining; ++index) {
+			invalid |= VALUES[in[index]];
+			value = (value << 6U) | (unsigned int)VALUES[in[index]];
+			if ((3UL == index % 4UL) || (index + 1UL == remaining)) {
+				const unsigned long bytes = (((index % 4UL) + 1UL) * 3UL) / 4UL;
+
+				value <<= 6U * (3U - (unsigned int)(index % 4UL));
+				out[0] = (GAE_BYTE)(value >> 16U);
+				if (1UL < bytes)
+					out[1] = (GAE_BYTE)(value >> 8U);
+				if (2UL < bytes)
+					out[2] = (GAE_BYTE)value;
+				out += bytes;
+				value = 0U;
+			}
+		}
+	}
+
+	return (0U == (invalid & INVALID)) ? GAE_TRUE : GAE_FALSE;
+}
+
+/* Returns how many of the last two characters are padding. */
+unsigned long getPadding(const char* const source, const unsigned long length) {
+	if ((0UL < length) && ('=' == source[length - 1UL]))
+		return ((1UL < length) && ('=' == source[length - 2UL])) ? 2UL : 1UL;
+
+	return 0UL;
+}
@@ -0,0 +1,18 @@
+#ifndef _BASE64_H_
+#define _BASE64_H_
+
+#include "../GAE_Types.h"
+
+/*
+	Base64 decoding, of the standard alphabet with or without its padding and with nothing else between the characters.
+	Sixteen characters are classified and packed at a time where SSE2 is available, and two quads at a time otherwise,
+	with anything outside the alphabet caught once at the end rather than tested for character by character.
+*/
+
+/* Returns how many bytes length characters of base64 decode to, padding and all. */
+unsigned long GAE_Base64_getDecodedSize(const char* const source, const unsigned long length);
+
+/* Decodes source into destination, returning GAE_TRUE only if every character is valid and they fill exactly size bytes. */
+GAE_BOOL GAE_Base64_decode(const char* const source, const unsigned long length, GAE_BYTE* destination, const unsigned long size);
+
+#endif
@@ -0,0 +1,190 @@
+#include "LZ4.h"
+
+#include <string.h>
+
+#define HASH_BITS 12U
+#define HASH_SIZE (1U << HASH_BITS)
+#define MIN_MATCH 4UL
+#define MAX_OFFSET 65535UL
+#define LAST_LITERALS 5UL			/* the block always ends on at least this many literals */
+#define MATCH_MARGIN 12UL			/* and the last match starts at least this far from the end */
+#define RUN_MASK 15UL
+
+static unsigned int readUint32(const GAE_BYTE* data);
+static unsigned int hashSequence(const unsigned int sequence);
+static GAE_BOOL writeLength(GAE_BYTE* destination, const unsigned long capacity, unsigned long* out, unsigned long length);
+static GAE_BOOL writeSequence(GAE_BYTE* destination, const unsigned long capacity, unsigned long* out, const GAE_BYTE* literals, const unsigned long literalCount, const unsigned long offset, const unsigned long matchLength);
+static GAE_BOOL readLength(const GAE_BYTE* source, const unsigned long sourceSize, unsigned long* in, unsigned long* length);
+
+unsigned long GAE_LZ4_getBound(const unsigned long size) {
+	return size + (size / 255UL) + 16UL;
+}
+
+unsigned long GAE_LZ4_compress(const GAE_BYTE* const source, const unsigned long size, GAE_BYTE* destination, const unsigned long capacity) {
+	unsigned long table[HASH_SIZE];		/* position + 1 of the last sequence seen with each hash, 0 for none */
+	unsigned long position = 0UL;
+	unsigned long anchor = 0UL;
+	unsigned long out = 0UL;
+
+	memset(table, 0, sizeof(table));
+
+	if (size > MATCH_MARGIN) {
+		const unsigned long matchLimit = size - LAST_LITERALS;
+		const unsigned long startLimit = size - MATCH_MARGIN;
+
+		while (position < startLimit) {
+			const unsigned int sequence = readUint32(source + position);
+			const unsigned int hash = hashSequence(sequence);
+			const unsigned long candidate = table[hash];
+			unsigned long match = 0UL;
+			unsigned long length = MIN_MATCH;
+
+			table[hash] = position + 1UL;
+			if ((0UL == candidate) || (MAX_OFFSET < position - (candidate - 1UL)) || (sequence != readUint32(source + candidate - 1UL))) {
+				/* step further the longer nothing has matched, so incompressible data passes quickly */
+				position += 1UL + ((position - anchor) >> 6U);
+				continue;
+			}
+
+			match = candidate - 1UL;
+			while ((position + length < matchLimit) && (source[match + length] == source[position + length]))
+				++length;
+
+			if (GAE_FALSE == writeSequence(destination, capacity, &out, source + anchor, position - anchor, position - match, length))
+				return 0UL;
+
+			position += length;
+			anchor = position;
+		}
+	}
+
+	/* the last sequence is literals alone */
+	if (GAE_FALSE == writeSequence(destination, capacity, &out, source + anchor, size - anchor, 0UL, 0UL))
+		return 0UL;
+
+	return out;
+}
+
+GAE_BOOL GAE_LZ4_decompress(const GAE_BYTE* const source, const unsigned long sourceSize, GAE_BYTE* destination, const unsigned long size) {
+	unsigned long in = 0UL;
+	unsigned long out = 0UL;
+
+	for (;;) {
+		unsigned long literalCount = 0UL;
+		unsigned long matchLength = 0UL;
+		unsigned long offset = 0UL;
+		unsigned int token = 0U;
+
+		if (in >= sourceSize)
+			return GAE_FALSE;
+
+		token = source[in++];
+		literalCount = token >> 4U;
+		if ((RUN_MASK == literalCount) && (GAE_FALSE == readLength(source, sourceSize, &in, &literalCount)))
+			return GAE_FALSE;
+
+		if ((literalCount > sourceSize - in) || (literalCount > size - out))
+			return GAE_FALSE;
+
+		memcpy(destination + out, source + in, literalCount);
+		in += literalCount;
+		out += literalCount;
+
+		if (in == sourceSize)
+			return (out == size) ? GAE_TRUE : GAE_FALSE;
+
+		if (2UL > sourceSize - in)
+			return GAE_FALSE;
+
+		offset = (unsigned long)source[in] | ((unsigned long)source[in + 1UL] << 8U);
+		in += 2UL;
+		if ((0UL == offset) || (offset > out))
+			return GAE_FALSE;
+
+		matchLength = token & RUN_MASK;
+		if ((RUN_MASK == matchLength) && (GAE_FALSE == readLength(source, sourceSize, &in, &matchLength)))
+			return GAE_FALSE;
+		matchLength += MIN_MATCH;
+
+		if (matchLength > size - out)
+			return GAE_FALSE;
+
+		/* matches may overlap what they write, repeating a short run, so only copy whole when they can't */
+		if (offset >= matchLength)
+			memcpy(destination + out, destination + out - offset, matchLength);
+		else {
+			unsigned long index = 0UL;
+			for (index = 0UL; index < matchLength; ++index)
+				destination[out + index] = destination[out + index - offset];
+		}
+		out += matchLength;
+	}
+}
+
+unsigned int readUint32(const GAE_BYTE* data) {
+	return (unsigned int)data[0] | ((unsigned int)data[1] << 8U) | ((unsigned int)data[2] << 16U) | ((unsigned int)data[3] << 24U);
+}
+
+unsigned int hashSequence(const unsigned int sequence) {
+	return ((sequence * 2654435761U) & 0xFFFFFFFFU) >> (32U - HASH_BITS);
+}
+
+GAE_BOOL writeLength(GAE_BYTE* destination, const unsigned long capacity, unsigned long* out, unsigned long length) {
+	while (255UL <= length) {
+		if (*out >= capacity)
+			return GAE_FALSE;
+		destination[(*out)++] = 255U;
+		length -= 255UL;
+	}
+
+	if (*out >= capacity)
+		return GAE_FALSE;
+	destination[(*out)++] = (GAE_BYTE)length;
+	return GAE_TRUE;
+}
+
+GAE_BOOL writeSequence(GAE_BYTE* destination, const unsigned long capacity, unsigned long* out, const GAE_BYTE* literals, const unsigned long literalCount, const unsigned long offset, const unsigned long matchLength) {
+	const unsigned long matchCode = (0UL != matchLength) ? matchLength - MIN_MATCH : 0UL;
+	unsigned int token = 0U;
+
+	if (*out >= capacity)
+		return GAE_FALSE;
+
+	token = (unsigned int)(((literalCount < RUN_MASK) ? literalCount : RUN_MASK) << 4U);
+	token |= (unsigned int)((matchCode < RUN_MASK) ? matchCode : RUN_MASK);
+	destination[(*out)++] = (GAE_BYTE)token;
+
+	if ((RUN_MASK <= literalCount) && (GAE_FALSE == writeLength(destination, capacity, out, literalCount - RUN_MASK)))
+		return GAE_FALSE;
+
+	if (literalCount > capacity - *out)
+		return GAE_FALSE;
+	memcpy(destination + *out, literals, literalCount);
+	*out += literalCount;
+
+	if (0UL == matchLength)
+		return GAE_TRUE;
+
+	if (2UL > capacity - *out)
+		return GAE_FALSE;
+	destination[(*out)++] = (GAE_BYTE)(offset & 0xFFU);
+	destination[(*out)++] = (GAE_BYTE)(offset >> 8U);
+
+	if ((RUN_MASK <= matchCode) && (GAE_FALSE == writeLength(destination, capacity, out, matchCode - RUN_MASK)))
+		return GAE_FALSE;
+
+	return GAE_TRUE;
+}
+
+GAE_BOOL readLength(const GAE_BYTE* source, const unsigned long sourceSize, unsigned long* in, unsigned long* length) {
+	unsigned int byte = 255U;
+
+	while (255U == byte) {
+		if (*in >= sourceSize)
+			return GAE_FALSE;
+		byte = source[(*in)++];
+		*length += byte;
+	}
+
+	return GAE_TRUE;
+}
@@ -0,0 +1,21 @@
+#ifndef _LZ4_H_
+#define _LZ4_H_
+
+#include "../GAE_Types.h"
+
+/*
+	LZ4 block format - raw blocks with no frame around them, so the caller keeps the sizes.
+	Compression is a single greedy pass, quick enough for tools but not tuned for ratio;
+	decompression checks every length against both buffers, so a corrupt block fails rather than overruns.
+*/
+
+/* Returns the most a block of size bytes can compress to. */
+unsigned long GAE_LZ4_getBound(const unsigned long size);
+
+/* Compresses source into destination, returning the compressed size - or 0 if it didn't fit in capacity. */
+unsigned long GAE_LZ4_compress(const GAE_BYTE* const source, const unsigned long size, GAE_BYTE* destination, const unsigned long capacity);
+
+/* Decompresses source into destination, returning GAE_TRUE only if the block is valid and fills exactly size bytes. */
+GAE_BOOL GAE_LZ4_decompress(const GAE_BYTE* const source, const unsigned long sourceSize, GAE_BYTE* destination, const unsigned long size);
+
+#endif
@@ -0,0 +1,88 @@
+#include "LinearAllocator.h"
+
+#include <assert.h>
+
+static GAE_LinearAllocator_Block_t* createBlock(const size_t size);
+
+GAE_LinearAllocator_t* GAE_LinearAllocator_create(const size_t blockSize) {
+	GAE_LinearAllocator_t* allocator = malloc(sizeof(GAE_LinearAllocator_t));
+	assert(allocator);
+
+	allocator->blockSize = (0U < blockSize) ? blockSize : 4096U;
+	allocator->first = createBlock(allocator->blockSize);
+	allocator->current = allocator->first;
+	allocator->used = 0U;
+
+	return allocator;
+}
+
+void* GAE_LinearAllocator_allocate(GAE_LinearAllocator_t* allocator, const size_t size, const size_t alignment) {
+	GAE_LinearAllocator_Block_t* block = allocator->current;
+	const size_t mask = (0U < alignment) ? alignment - 1U : 0U;
+	size_t start = 0U;
+
+	assert(0U == (alignment & mask));
+
+	for (;;) {
+		/* align the address, not the offset, as blocks are only as aligned as malloc makes them */
+		start = ((size_t)(block->data + block->used) + mask) & ~mask;
+		start -= (size_t)block->data;
+		if (start + size <= block->size)
+			break;
+
+		/* blocks after current are left over from before the last reset, and are reused in order */
+		if ((0 != block->next) && (size + mask <= block->next->size)) {
+			block = block->next;
+			block->used = 0U;
+			continue;
+		}
+
+		{
+			GAE_LinearAllocator_Block_t* newBlock = createBlock((size + mask > allocator->blockSize) ? size + mask : allocator->blockSize);
+			newBlock->next = block->next;
+			block->next = newBlock;
+			block = newBlock;
+		}
+	}
+
+	allocator->current = block;
+	allocator->used += start + size - block->used;
+	block->used = start + size;
+
+	return block->data + start;
+}
+
+GAE_LinearAllocator_t* GAE_LinearAllocator_reset(GAE_LinearAllocator_t* allocator) {
+	allocator->first->used = 0U;
+	allocator->current = allocator->first;
+	allocator->used = 0U;
+
+	return allocator;
+}
+
+void GAE_LinearAllocator_delete(GAE_LinearAllocator_t* allocator) {
+	GAE_LinearAllocator_Block_t* block = allocator->first;
+
+	while (0 != block) {
+		GAE_LinearAllocator_Block_t* next = block->next;
+		free(block->data);
+		free(block);
+		block = next;
+	}
+
+	free(allocator);
+	allocator = 0;
+}
+
+GAE_LinearAllocator_Block_t* createBlock(const size_t size) {
+	GAE_LinearAllocator_Block_t* block = malloc(sizeof(GAE_LinearAllocator_Block_t));
+	assert(block);
+
+	block->data = malloc(size);
+	assert(block->data);
+	block->size = size;
+	block->used = 0U;
+	block->next = 0;
+
+	return block;
+}
@@ -0,0 +1,39 @@
+#ifndef _LINEAR_ALLOCATOR_H_
+#define _LINEAR_ALLOCATOR_H_
+
+#include <stdlib.h>
+#include "../GAE_Types.h"
+
+/*
+	Bump allocator for memory that all dies at once, such as a frame's worth of render commands.
+	Allocating is a pointer bump, there's no per-allocation free, and reset hands every block back for reuse without freeing it.
+	Not thread safe - give each thread its own.
+*/
+
+typedef struct GAE_LinearAllocator_Block_s {
+	GAE_BYTE* data;
+	size_t size;
+	size_t used;
+	struct GAE_LinearAllocator_Block_s* next;
+} GAE_LinearAllocator_Block_t;
+
+typedef struct GAE_LinearAllocator_s {
+	GAE_LinearAllocator_Block_t* first;
+	GAE_LinearAllocator_Block_t* current;
+	size_t blockSize;				/* size of each new block, unless an allocation needs more */
+	size_t used;					/* bytes handed out since the last reset */
+} GAE_LinearAllocator_t;
+
+/* Creates a new allocator that grows in blocks of blockSize bytes. */
+GAE_LinearAllocator_t* GAE_LinearAllocator_create(const size_t blockSize);
+
+/* Returns size bytes aligned to alignment, which must be a power of two. This should NOT be freed. */
+void* GAE_LinearAllocator_allocate(GAE_LinearAllocator_t* allocator, const size_t size, const size_t alignment);
+
+/* Releases every allocation at once, keeping the blocks for reuse. */
+GAE_LinearAllocator_t* GAE_LinearAllocator_reset(GAE_LinearAllocator_t* allocator);
+
+/* Deletes the allocator and every block it allocated. */
+void GAE_LinearAllocator_delete(GAE_LinearAllocator_t* allocator);
+
+#endif
@@ -164,8 +164,8 @@ void logToFile(GAE_Logger_t* logger, const GAE_LOG_TYPE type, const char* text)
 	char* timeString;
 	char finalText[FILE_BUFFER_SIZE];
 	
-	timeString = ctime(&rawTime);
 	time(&rawTime);
+	timeString = ctime(&rawTime);
 	
 	switch (logger->fileType) {
 		case GAE_LOG_FILE_TEXT:
@@ -0,0 +1,272 @@
+#include "QuadTree.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define INVALID_HANDLE 0xFFFFFFFFU
+
+static unsigned int getNode(GAE_QuadTree_t* tree, const GAE_Vector4_t bounds);
+static void addToNode(GAE_QuadTree_t* tree, const unsigned int handle, const unsigned int node);
+static void removeFromNode(GAE_QuadTree_t* tree, const unsigned int handle);
+static unsigned int getLevel(GAE_QuadTree_t* tree, const unsigned int node);
+static unsigned int getCell(const float position, const float origin, const float inverseCellSize, const unsigned int count);
+static unsigned int query(GAE_QuadTree_t* tree, const GAE_Vector4_t rect, const float* const centre, const float radius, GAE_SpatialGrid_Visitor visitor, void* const context);
+
+GAE_QuadTree_t* GAE_QuadTree_create(const GAE_Vector4_t bounds, const unsigned int depth) {
+	GAE_QuadTree_t* tree = malloc(sizeof(GAE_QuadTree_t));
+	const float width = bounds[2] - bounds[0];
+	const float height = bounds[3] - bounds[1];
+	unsigned int nodeCount = 0U;
+	unsigned int level = 0U;
+
+	memcpy(tree->bounds, bounds, sizeof(GAE_Vector4_t));
+	tree->size = (width > height) ? width : height;
+	if (0.0F >= tree->size)
+		tree->size = 1.0F;
+	tree->depth = (depth > GAE_QUAD_TREE_MAX_DEPTH) ? GAE_QUAD_TREE_MAX_DEPTH : depth;
+
+	for (level = 0U; level <= tree->depth; ++level) {
+		tree->levelOffsets[level] = nodeCount;
+		tree->levelCounts[level] = 0U;
+		nodeCount += (1U << level) * (1U << level);
+	}
+
+	tree->nodes = calloc(nodeCount, sizeof(GAE_QuadTree_Node_t));
+	tree->proxies = 0;
+	tree->proxyCount = 0U;
+	tree->proxyCapacity = 0U;
+	tree->freeProxy = INVALID_HANDLE;
+
+	return tree;
+}
+
+unsigned int GAE_QuadTree_insert(GAE_QuadTree_t* tree, const GAE_Vector4_t bounds, void* const userData) {
+	GAE_QuadTree_Proxy_t* proxy = 0;
+	unsigned int handle = tree->freeProxy;
+
+	if (INVALID_HANDLE != handle)
+		tree->freeProxy = tree->proxies[handle].nextFree;
+	else {
+		if (tree->proxyCount == tree->proxyCapacity) {
+			tree->proxyCapacity = (0U < tree->proxyCapacity) ? tree->proxyCapacity * 2U : 64U;
+			tree->proxies = realloc(tree->proxies, sizeof(GAE_QuadTree_Proxy_t) * tree->proxyCapacity);
+		}
+		handle = tree->proxyCount++;
+	}
+
+	proxy = tree->proxies + handle;
+	memcpy(proxy->bounds, bounds, sizeof(GAE_Vector4_t));
+	proxy->userData = userData;
+	proxy->nextFree = INVALID_HANDLE;
+	proxy->isUsed = GAE_TRUE;
+
+	addToNode(tree, handle, getNode(tree, bounds));
+
+	return handle;
+}
+
+GAE_QuadTree_t* GAE_QuadTree_move(GAE_QuadTree_t* tree, const unsigned int handle, const GAE_Vector4_t bounds) {
+	GAE_QuadTree_Proxy_t* proxy = tree->proxies + handle;
+	unsigned int node = 0U;
+
+	if ((handle >= tree->proxyCount) || (GAE_FALSE == proxy->isUsed))
+		return tree;
+
+	memcpy(proxy->bounds, bounds, sizeof(GAE_Vector4_t));
+	node = getNode(tree, bounds);
+	if (node == proxy->node)
+		return tree;
+
+	removeFromNode(tree, handle);
+	addToNode(tree, handle, node);
+
+	return tree;
+}
+
+GAE_QuadTree_t* GAE_QuadTree_remove(GAE_QuadTree_t* tree, const unsigned int handle) {
+	GAE_QuadTree_Proxy_t* proxy = tree->proxies + handle;
+
+	if ((handle >= tree->proxyCount) || (GAE_FALSE == proxy->isUsed))
+		return tree;
+
+	removeFromNode(tree, handle);
+	proxy->isUsed = GAE_FALSE;
+	proxy->userData = 0;
+	proxy->nextFree = tree->freeProxy;
+	tree->freeProxy = handle;
+
+	return tree;
+}
+
+GAE_QuadTree_t* GAE_QuadTree_clear(GAE_QuadTree_t* tree) {
+	const unsigned int nodeCount = tree->levelOffsets[tree->depth] + (1U << tree->depth) * (1U << tree->depth);
+	unsigned int index = 0U;
+
+	for (index = 0U; index < nodeCount; ++index)
+		tree->nodes[index].count = 0U;
+	for (index = 0U; index <= tree->depth; ++index)
+		tree->levelCounts[index] = 0U;
+
+	tree->proxyCount = 0U;
+	tree->freeProxy = INVALID_HANDLE;
+
+	return tree;
+}
+
+unsigned int GAE_QuadTree_queryRect(GAE_QuadTree_t* tree, const GAE_Vector4_t rect, GAE_SpatialGrid_Visitor visitor, void* const context) {
+	return query(tree, rect, 0, 0.0F, visitor, context);
+}
+
+unsigned int GAE_QuadTree_queryRadius(GAE_QuadTree_t* tree, const GAE_Vector2_t centre, const float radius, GAE_SpatialGrid_Visitor visitor, void* const context) {
+	GAE_Vector4_t rect;
+
+	rect[0] = centre[0] - radius;
+	rect[1] = centre[1] - radius;
+	rect[2] = centre[0] + radius;
+	rect[3] = centre[1] + radius;
+
+	return query(tree, rect, centre, radius, visitor, context);
+}
+
+unsigned int GAE_QuadTree_queryCamera(GAE_QuadTree_t* tree, struct GAE_Camera_s* const camera, GAE_SpatialGrid_Visitor visitor, void* const context) {
+	GAE_Vector4_t rect;
+
+	if (GAE_FALSE == GAE_SpatialGrid_getCameraBounds(camera, rect))
+		return 0U;
+
+	return query(tree, rect, 0, 0.0F, visitor, context);
+}
+
+void GAE_QuadTree_delete(GAE_QuadTree_t* tree) {
+	const unsigned int nodeCount = tree->levelOffsets[tree->depth] + (1U << tree->depth) * (1U << tree->depth);
+	unsigned int index = 0U;
+
+	for (index = 0U; index < nodeCount; ++index)
+		free(tree->nodes[index].handles);
+
+	free(tree->nodes);
+	free(tree->proxies);
+	free(tree);
+	tree = 0;
+}
+
+unsigned int getNode(GAE_QuadTree_t* tree, const GAE_Vector4_t bounds) {
+	const float width = bounds[2] - bounds[0];
+	const float height = bounds[3] - bounds[1];
+	const float extent = (width > height) ? width : height;
+	const float centreX = (bounds[0] + bounds[2]) * 0.5F;
+	const float centreY = (bounds[1] + bounds[3]) * 0.5F;
+	float cellSize = tree->size;
+	unsigned int level = 0U;
+	unsigned int dimension = 0U;
+
+	/* the root's loose bounds only cover the tree, so anything centred outside it is kept there and always checked */
+	if ((centreX < tree->bounds[0]) || (centreX > tree->bounds[0] + tree->size) || (centreY < tree->bounds[1]) || (centreY > tree->bounds[1] + tree->size))
+		return 0U;
+
+	/* the deepest level whose cells are still as big as the object - its loose bounds then always hold it */
+	while ((level < tree->depth) && (cellSize * 0.5F >= extent)) {
+		cellSize *= 0.5F;
+		++level;
+	}
+
+	dimension = 1U << level;
+	return tree->levelOffsets[level]
+		+ getCell(centreY, tree->bounds[1], 1.0F / cellSize, dimension) * dimension
+		+ getCell(centreX, tree->bounds[0], 1.0F / cellSize, dimension);
+}
+
+void addToNode(GAE_QuadTree_t* tree, const unsigned int handle, const unsigned int node) {
+	GAE_QuadTree_Node_t* treeNode = tree->nodes + node;
+	GAE_QuadTree_Proxy_t* proxy = tree->proxies + handle;
+
+	if (treeNode->count == treeNode->capacity) {
+		treeNode->capacity = (0U < treeNode->capacity) ? treeNode->capacity * 2U : 4U;
+		treeNode->handles = realloc(treeNode->handles, sizeof(unsigned int) * treeNode->capacity);
+	}
+
+	proxy->node = node;
+	proxy->slot = treeNode->count;
+	treeNode->handles[treeNode->count++] = handle;
+	++tree->levelCounts[getLevel(tree, node)];
+}
+
+void removeFromNode(GAE_QuadTree_t* tree, const unsigned int handle) {
+	GAE_QuadTree_Proxy_t* proxy = tree->proxies + handle;
+	GAE_QuadTree_Node_t* treeNode = tree->nodes + proxy->node;
+	const unsigned int last = treeNode->handles[--treeNode->count];
+
+	/* the last handle fills the gap, and learns its new slot */
+	treeNode->handles[proxy->slot] = last;
+	tree->proxies[last].slot = proxy->slot;
+	--tree->levelCounts[getLevel(tree, proxy->node)];
+}
+
+unsigned int getLevel(GAE_QuadTree_t* tree, const unsigned int node) {
+	unsigned int level = tree->depth;
+
+	while (node < tree->levelOffsets[level])
+		--level;
+
+	return level;
+}
+
+unsigned int getCell(const float position, const float origin, const float inverseCellSize, const unsigned int count) {
+	const float cell = (position - origin) * inverseCellSize;
+
+	if (cell <= 0.0F)
+		return 0U;
+	if (cell >= (float)(count - 1U))
+		return count - 1U;
+	return (unsigned int)cell;
+}
+
+unsigned int query(GAE_QuadTree_t* tree, const GAE_Vector4_t rect, const float* const centre, const float radius, GAE_SpatialGrid_Visitor visitor, void* const context) {
+	float cellSize = tree->size;
+	unsigned int visited = 0U;
+	unsigned int level = 0U;
+	unsigned int row = 0U;
+	unsigned int column = 0U;
+	unsigned int index = 0U;
+
+	for (level = 0U; level <= tree->depth; ++level, cellSize *= 0.5F) {
+		const unsigned int dimension = 1U << level;
+		const float inverseCellSize = 1.0F / cellSize;
+		const float looseness = cellSize * 0.5F;
+		unsigned int range[4] = { 0U, 0U, 0U, 0U };
+
+		if (0U == tree->levelCounts[level])
+			continue;
+
+		/* a node's objects can hang over it by up to half a cell, so widen the search by as much */
+		if (0U < level) {
+			range[0] = getCell(rect[0] - looseness, tree->bounds[0], inverseCellSize, dimension);
+			range[1] = getCell(rect[1] - looseness, tree->bounds[1], inverseCellSize, dimension);
+			range[2] = getCell(rect[2] + looseness, tree->bounds[0], inverseCellSize, dimension);
+			range[3] = getCell(rect[3] + looseness, tree->bounds[1], inverseCellSize, dimension);
+		}
+
+		for (row = range[1]; row <= range[3]; ++row) {
+			for (column = range[0]; column <= range[2]; ++column) {
+				const GAE_QuadTree_Node_t* node = tree->nodes + tree->levelOffsets[level] + row * dimension + column;
+
+				for (index = 0U; index < node->count; ++index) {
+					const unsigned int handle = node->handles[index];
+					const GAE_QuadTree_Proxy_t* proxy = tree->proxies + handle;
+
+					if ((proxy->bounds[2] < rect[0]) || (proxy->bounds[0] > rect[2]) || (proxy->bounds[3] < rect[1]) || (proxy->bounds[1] > rect[3]))
+						continue;
+
+					if ((0 != centre) && (GAE_FALSE == GAE_SpatialGrid_isCircleOverlapping(proxy->bounds, centre, radius)))
+						continue;
+
+					++visited;
+					if ((0 != visitor) && (GAE_FALSE == visitor(handle, proxy->userData, context)))
+						return visited;
+				}
+			}
+		}
+	}
+
+	return visited;
+}
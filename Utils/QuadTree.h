@@ -0,0 +1,75 @@
+#ifndef _QUAD_TREE_H_
+#define _QUAD_TREE_H_
+
+#include "../GAE_Types.h"
+#include "SpatialGrid.h"
+
+/*
+	Loose quadtree of AABBs - an alternative to GAE_SpatialGrid when object sizes vary wildly.
+	Every level is a flat grid of nodes, half the size of the one above, and each node's loose bounds are twice its size,
+	so an object lives in exactly one node - picked from its size and centre - and moving it is a swap-remove and an append.
+	Bounds follow GAE_SpatialGrid - 0 - left, 1 - top, 2 - right, 3 - bottom - as do the visitor and camera queries.
+	Queries aren't re-entrant - don't query the same tree from inside a visitor.
+*/
+
+/* Deepest level a tree may have - the bottom level has 4^depth nodes. */
+#define GAE_QUAD_TREE_MAX_DEPTH 10U
+
+struct GAE_Camera_s;
+
+typedef struct GAE_QuadTree_Proxy_s {
+	GAE_Vector4_t bounds;
+	void* userData;
+	unsigned int node;
+	unsigned int slot;				/* index in the node's handles, for constant time removal */
+	unsigned int nextFree;
+	GAE_BOOL isUsed;
+} GAE_QuadTree_Proxy_t;
+
+typedef struct GAE_QuadTree_Node_s {
+	unsigned int* handles;
+	unsigned int count;
+	unsigned int capacity;
+} GAE_QuadTree_Node_t;
+
+typedef struct GAE_QuadTree_s {
+	GAE_Vector4_t bounds;
+	float size;						/* of the square root node */
+	unsigned int depth;
+	unsigned int levelOffsets[GAE_QUAD_TREE_MAX_DEPTH + 1U];	/* first node of each level */
+	unsigned int levelCounts[GAE_QUAD_TREE_MAX_DEPTH + 1U];		/* object count of each level, to skip empty ones */
+	GAE_QuadTree_Node_t* nodes;
+	GAE_QuadTree_Proxy_t* proxies;	/* indexed by handle */
+	unsigned int proxyCount;
+	unsigned int proxyCapacity;
+	unsigned int freeProxy;
+} GAE_QuadTree_t;
+
+/* Creates a tree covering bounds, with depth levels below the root. */
+GAE_QuadTree_t* GAE_QuadTree_create(const GAE_Vector4_t bounds, const unsigned int depth);
+
+/* Adds an object and returns its handle. */
+unsigned int GAE_QuadTree_insert(GAE_QuadTree_t* tree, const GAE_Vector4_t bounds, void* const userData);
+
+/* Updates an object's bounds - free when it stays within the same node. */
+GAE_QuadTree_t* GAE_QuadTree_move(GAE_QuadTree_t* tree, const unsigned int handle, const GAE_Vector4_t bounds);
+
+/* Removes an object - its handle may be handed out again. */
+GAE_QuadTree_t* GAE_QuadTree_remove(GAE_QuadTree_t* tree, const unsigned int handle);
+
+/* Removes every object, keeping the memory for reuse. */
+GAE_QuadTree_t* GAE_QuadTree_clear(GAE_QuadTree_t* tree);
+
+/* Visits every object overlapping rect, returning how many were visited. */
+unsigned int GAE_QuadTree_queryRect(GAE_QuadTree_t* tree, const GAE_Vector4_t rect, GAE_SpatialGrid_Visitor visitor, void* const context);
+
+/* Visits every object within radius of centre, returning how many were visited. */
+unsigned int GAE_QuadTree_queryRadius(GAE_QuadTree_t* tree, const GAE_Vector2_t centre, const float radius, GAE_SpatialGrid_Visitor visitor, void* const context);
+
+/* Visits every object a 2D camera can see, returning how many were visited. */
+unsigned int GAE_QuadTree_queryCamera(GAE_QuadTree_t* tree, struct GAE_Camera_s* const camera, GAE_SpatialGrid_Visitor visitor, void* const context);
+
+/* Deletes the tree. */
+void GAE_QuadTree_delete(GAE_QuadTree_t* tree);
+
+#endif
@@ -0,0 +1,281 @@
+#include "SpatialGrid.h"
+
+#include "../Graphics/Camera.h"
+#include "../Maths/Matrix.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define INVALID_HANDLE 0xFFFFFFFFU
+
+static unsigned int getCell(const float position, const float origin, const float inverseCellSize, const unsigned int count);
+static void getCellRange(GAE_SpatialGrid_t* grid, const GAE_Vector4_t bounds, unsigned int range[4]);
+static void addToCells(GAE_SpatialGrid_t* grid, const unsigned int handle, const unsigned int range[4]);
+static void removeFromCells(GAE_SpatialGrid_t* grid, const unsigned int handle, const unsigned int range[4]);
+static unsigned int nextQueryStamp(GAE_SpatialGrid_t* grid);
+static unsigned int query(GAE_SpatialGrid_t* grid, const GAE_Vector4_t rect, const float* const centre, const float radius, GAE_SpatialGrid_Visitor visitor, void* const context);
+
+GAE_SpatialGrid_t* GAE_SpatialGrid_create(const GAE_Vector4_t bounds, const float cellSize) {
+	GAE_SpatialGrid_t* grid = malloc(sizeof(GAE_SpatialGrid_t));
+	const float width = bounds[2] - bounds[0];
+	const float height = bounds[3] - bounds[1];
+
+	memcpy(grid->bounds, bounds, sizeof(GAE_Vector4_t));
+	grid->cellSize = (0.0F < cellSize) ? cellSize : 1.0F;
+	grid->inverseCellSize = 1.0F / grid->cellSize;
+	grid->columns = (0.0F < width) ? (unsigned int)(width * grid->inverseCellSize) + 1U : 1U;
+	grid->rows = (0.0F < height) ? (unsigned int)(height * grid->inverseCellSize) + 1U : 1U;
+	grid->cells = calloc(grid->columns * grid->rows, sizeof(GAE_SpatialGrid_Cell_t));
+	grid->proxies = 0;
+	grid->proxyCount = 0U;
+	grid->proxyCapacity = 0U;
+	grid->freeProxy = INVALID_HANDLE;
+	grid->queryStamp = 0U;
+
+	return grid;
+}
+
+unsigned int GAE_SpatialGrid_insert(GAE_SpatialGrid_t* grid, const GAE_Vector4_t bounds, void* const userData) {
+	GAE_SpatialGrid_Proxy_t* proxy = 0;
+	unsigned int handle = grid->freeProxy;
+
+	if (INVALID_HANDLE != handle)
+		grid->freeProxy = grid->proxies[handle].nextFree;
+	else {
+		if (grid->proxyCount == grid->proxyCapacity) {
+			grid->proxyCapacity = (0U < grid->proxyCapacity) ? grid->proxyCapacity * 2U : 64U;
+			grid->proxies = realloc(grid->proxies, sizeof(GAE_SpatialGrid_Proxy_t) * grid->proxyCapacity);
+		}
+		handle = grid->proxyCount++;
+	}
+
+	proxy = grid->proxies + handle;
+	memcpy(proxy->bounds, bounds, sizeof(GAE_Vector4_t));
+	proxy->userData = userData;
+	proxy->queryStamp = 0U;
+	proxy->nextFree = INVALID_HANDLE;
+	proxy->isUsed = GAE_TRUE;
+
+	getCellRange(grid, bounds, proxy->cells);
+	addToCells(grid, handle, proxy->cells);
+
+	return handle;
+}
+
+GAE_SpatialGrid_t* GAE_SpatialGrid_move(GAE_SpatialGrid_t* grid, const unsigned int handle, const GAE_Vector4_t bounds) {
+	GAE_SpatialGrid_Proxy_t* proxy = grid->proxies + handle;
+	unsigned int range[4];
+
+	if ((handle >= grid->proxyCount) || (GAE_FALSE == proxy->isUsed))
+		return grid;
+
+	memcpy(proxy->bounds, bounds, sizeof(GAE_Vector4_t));
+	getCellRange(grid, bounds, range);
+
+	/* most moves stay within the same cells, and only need the bounds updated */
+	if (0 == memcmp(range, proxy->cells, sizeof(range)))
+		return grid;
+
+	removeFromCells(grid, handle, proxy->cells);
+	addToCells(grid, handle, range);
+	memcpy(proxy->cells, range, sizeof(range));
+
+	return grid;
+}
+
+GAE_SpatialGrid_t* GAE_SpatialGrid_remove(GAE_SpatialGrid_t* grid, const unsigned int handle) {
+	GAE_SpatialGrid_Proxy_t* proxy = grid->proxies + handle;
+
+	if ((handle >= grid->proxyCount) || (GAE_FALSE == proxy->isUsed))
+		return grid;
+
+	removeFromCells(grid, handle, proxy->cells);
+	proxy->isUsed = GAE_FALSE;
+	proxy->userData = 0;
+	proxy->nextFree = grid->freeProxy;
+	grid->freeProxy = handle;
+
+	return grid;
+}
+
+GAE_SpatialGrid_t* GAE_SpatialGrid_clear(GAE_SpatialGrid_t* grid) {
+	const unsigned int cellCount = grid->columns * grid->rows;
+	unsigned int index = 0U;
+
+	for (index = 0U; index < cellCount; ++index)
+		grid->cells[index].count = 0U;
+
+	grid->proxyCount = 0U;
+	grid->freeProxy = INVALID_HANDLE;
+
+	return grid;
+}
+
+unsigned int GAE_SpatialGrid_queryRect(GAE_SpatialGrid_t* grid, const GAE_Vector4_t rect, GAE_SpatialGrid_Visitor visitor, void* const context) {
+	return query(grid, rect, 0, 0.0F, visitor, context);
+}
+
+unsigned int GAE_SpatialGrid_queryRadius(GAE_SpatialGrid_t* grid, const GAE_Vector2_t centre, const float radius, GAE_SpatialGrid_Visitor visitor, void* const context) {
+	GAE_Vector4_t rect;
+
+	rect[0] = centre[0] - radius;
+	rect[1] = centre[1] - radius;
+	rect[2] = centre[0] + radius;
+	rect[3] = centre[1] + radius;
+
+	return query(grid, rect, centre, radius, visitor, context);
+}
+
+unsigned int GAE_SpatialGrid_queryCamera(GAE_SpatialGrid_t* grid, GAE_Camera_t* const camera, GAE_SpatialGrid_Visitor visitor, void* const context) {
+	GAE_Vector4_t rect;
+
+	if (GAE_FALSE == GAE_SpatialGrid_getCameraBounds(camera, rect))
+		return 0U;
+
+	return query(grid, rect, 0, 0.0F, visitor, context);
+}
+
+void GAE_SpatialGrid_delete(GAE_SpatialGrid_t* grid) {
+	const unsigned int cellCount = grid->columns * grid->rows;
+	unsigned int index = 0U;
+
+	for (index = 0U; index < cellCount; ++index)
+		free(grid->cells[index].handles);
+
+	free(grid->cells);
+	free(grid->proxies);
+	free(grid);
+	grid = 0;
+}
+
+GAE_BOOL GAE_SpatialGrid_getCameraBounds(GAE_Camera_t* const camera, GAE_Vector4_t bounds) {
+	GAE_Vector3_t position;
+
+	if ((0 == camera) || (GAE_CAMERA_TYPE_2D != camera->type))
+		return GAE_FALSE;
+
+	/* the same view rect the tile layers cull against */
+	GAE_Matrix4_getPosition(&camera->transform, &position);
+	bounds[0] = position[0] + camera->left;
+	bounds[2] = position[0] + camera->right;
+	bounds[1] = position[1] + ((camera->top < camera->bottom) ? camera->top : camera->bottom);
+	bounds[3] = position[1] + ((camera->top < camera->bottom) ? camera->bottom : camera->top);
+
+	return GAE_TRUE;
+}
+
+GAE_BOOL GAE_SpatialGrid_isCircleOverlapping(const GAE_Vector4_t bounds, const GAE_Vector2_t centre, const float radius) {
+	const float nearestX = (centre[0] < bounds[0]) ? bounds[0] : ((centre[0] > bounds[2]) ? bounds[2] : centre[0]);
+	const float nearestY = (centre[1] < bounds[1]) ? bounds[1] : ((centre[1] > bounds[3]) ? bounds[3] : centre[1]);
+	const float x = centre[0] - nearestX;
+	const float y = centre[1] - nearestY;
+
+	return (x * x + y * y <= radius * radius) ? GAE_TRUE : GAE_FALSE;
+}
+
+unsigned int getCell(const float position, const float origin, const float inverseCellSize, const unsigned int count) {
+	const float cell = (position - origin) * inverseCellSize;
+
+	/* anything beyond the grid lives in the border cells */
+	if (cell <= 0.0F)
+		return 0U;
+	if (cell >= (float)(count - 1U))
+		return count - 1U;
+	return (unsigned int)cell;
+}
+
+void getCellRange(GAE_SpatialGrid_t* grid, const GAE_Vector4_t bounds, unsigned int range[4]) {
+	range[0] = getCell(bounds[0], grid->bounds[0], grid->inverseCellSize, grid->columns);
+	range[1] = getCell(bounds[1], grid->bounds[1], grid->inverseCellSize, grid->rows);
+	range[2] = getCell(bounds[2], grid->bounds[0], grid->inverseCellSize, grid->columns);
+	range[3] = getCell(bounds[3], grid->bounds[1], grid->inverseCellSize, grid->rows);
+}
+
+void addToCells(GAE_SpatialGrid_t* grid, const unsigned int handle, const unsigned int range[4]) {
+	unsigned int row = 0U;
+	unsigned int column = 0U;
+
+	for (row = range[1]; row <= range[3]; ++row) {
+		for (column = range[0]; column <= range[2]; ++column) {
+			GAE_SpatialGrid_Cell_t* cell = grid->cells + row * grid->columns + column;
+
+			if (cell->count == cell->capacity) {
+				cell->capacity = (0U < cell->capacity) ? cell->capacity * 2U : 4U;
+				cell->handles = realloc(cell->handles, sizeof(unsigned int) * cell->capacity);
+			}
+
+			cell->handles[cell->count++] = handle;
+		}
+	}
+}
+
+void removeFromCells(GAE_SpatialGrid_t* grid, const unsigned int handle, const unsigned int range[4]) {
+	unsigned int row = 0U;
+	unsigned int column = 0U;
+	unsigned int index = 0U;
+
+	for (row = range[1]; row <= range[3]; ++row) {
+		for (column = range[0]; column <= range[2]; ++column) {
+			GAE_SpatialGrid_Cell_t* cell = grid->cells + row * grid->columns + column;
+
+			/* cells are unordered, so the last handle fills the gap */
+			for (index = 0U; index < cell->count; ++index) {
+				if (handle == cell->handles[index]) {
+					cell->handles[index] = cell->handles[--cell->count];
+					break;
+				}
+			}
+		}
+	}
+}
+
+unsigned int nextQueryStamp(GAE_SpatialGrid_t* grid) {
+	unsigned int index = 0U;
+
+	/* on wrapping, stale stamps could match again - clear them all first */
+	if (0U == ++grid->queryStamp) {
+		for (index = 0U; index < grid->proxyCount; ++index)
+			grid->proxies[index].queryStamp = 0U;
+		grid->queryStamp = 1U;
+	}
+
+	return grid->queryStamp;
+}
+
+unsigned int query(GAE_SpatialGrid_t* grid, const GAE_Vector4_t rect, const float* const centre, const float radius, GAE_SpatialGrid_Visitor visitor, void* const context) {
+	const unsigned int stamp = nextQueryStamp(grid);
+	unsigned int range[4];
+	unsigned int visited = 0U;
+	unsigned int row = 0U;
+	unsigned int column = 0U;
+	unsigned int index = 0U;
+
+	getCellRange(grid, rect, range);
+
+	for (row = range[1]; row <= range[3]; ++row) {
+		for (column = range[0]; column <= range[2]; ++column) {
+			const GAE_SpatialGrid_Cell_t* cell = grid->cells + row * grid->columns + column;
+
+			for (index = 0U; index < cell->count; ++index) {
+				const unsigned int handle = cell->handles[index];
+				GAE_SpatialGrid_Proxy_t* proxy = grid->proxies + handle;
+
+				if (stamp == proxy->queryStamp)
+					continue;
+				proxy->queryStamp = stamp;
+
+				if ((proxy->bounds[2] < rect[0]) || (proxy->bounds[0] > rect[2]) || (proxy->bounds[3] < rect[1]) || (proxy->bounds[1] > rect[3]))
+					continue;
+
+				if ((0 != centre) && (GAE_FALSE == GAE_SpatialGrid_isCircleOverlapping(proxy->bounds, centre, radius)))
+					continue;
+
+				++visited;
+				if ((0 != visitor) && (GAE_FALSE == visitor(handle, proxy->userData, context)))
+					return visited;
+			}
+		}
+	}
+
+	return visited;
+}
@@ -0,0 +1,80 @@
+#ifndef _SPATIAL_GRID_H_
+#define _SPATIAL_GRID_H_
+
+#include "../GAE_Types.h"
+
+/*
+	Uniform grid of AABBs, for "what is near here" and "what is on screen" without scanning everything.
+	Bounds are GAE_Vector4_t - 0 - left, 1 - top, 2 - right, 3 - bottom - with top the smaller y.
+	Anything outside the grid's own bounds is kept in the border cells, so is still found, just less cheaply.
+	Queries call the visitor once per overlapping object; return GAE_FALSE from it to stop early.
+	Queries aren't re-entrant - don't query the same grid from inside a visitor.
+*/
+
+struct GAE_Camera_s;
+
+typedef GAE_BOOL (*GAE_SpatialGrid_Visitor)(const unsigned int handle, void* const userData, void* const context);
+
+typedef struct GAE_SpatialGrid_Proxy_s {
+	GAE_Vector4_t bounds;
+	void* userData;
+	unsigned int cells[4];			/* 0 - first column, 1 - first row, 2 - last column, 3 - last row */
+	unsigned int queryStamp;		/* the last query that visited it, so objects spanning cells are visited once */
+	unsigned int nextFree;
+	GAE_BOOL isUsed;
+} GAE_SpatialGrid_Proxy_t;
+
+typedef struct GAE_SpatialGrid_Cell_s {
+	unsigned int* handles;
+	unsigned int count;
+	unsigned int capacity;
+} GAE_SpatialGrid_Cell_t;
+
+typedef struct GAE_SpatialGrid_s {
+	GAE_Vector4_t bounds;
+	float cellSize;
+	float inverseCellSize;
+	unsigned int columns;
+	unsigned int rows;
+	GAE_SpatialGrid_Cell_t* cells;
+	GAE_SpatialGrid_Proxy_t* proxies;	/* indexed by handle */
+	unsigned int proxyCount;			/* handles handed out so far, live or free */
+	unsigned int proxyCapacity;
+	unsigned int freeProxy;
+	unsigned int queryStamp;
+} GAE_SpatialGrid_t;
+
+/* Creates a grid covering bounds with square cells - size them around the typical object or query. */
+GAE_SpatialGrid_t* GAE_SpatialGrid_create(const GAE_Vector4_t bounds, const float cellSize);
+
+/* Adds an object and returns its handle. */
+unsigned int GAE_SpatialGrid_insert(GAE_SpatialGrid_t* grid, const GAE_Vector4_t bounds, void* const userData);
+
+/* Updates an object's bounds - cheap when it stays within the same cells. */
+GAE_SpatialGrid_t* GAE_SpatialGrid_move(GAE_SpatialGrid_t* grid, const unsigned int handle, const GAE_Vector4_t bounds);
+
+/* Removes an object - its handle may be handed out again. */
+GAE_SpatialGrid_t* GAE_SpatialGrid_remove(GAE_SpatialGrid_t* grid, const unsigned int handle);
+
+/* Removes every object, keeping the memory for reuse. */
+GAE_SpatialGrid_t* GAE_SpatialGrid_clear(GAE_SpatialGrid_t* grid);
+
+/* Visits every object overlapping rect, returning how many were visited. */
+unsigned int GAE_SpatialGrid_queryRect(GAE_SpatialGrid_t* grid, const GAE_Vector4_t rect, GAE_SpatialGrid_Visitor visitor, void* const context);
+
+/* Visits every object within radius of centre, returning how many were visited. */
+unsigned int GAE_SpatialGrid_queryRadius(GAE_SpatialGrid_t* grid, const GAE_Vector2_t centre, const float radius, GAE_SpatialGrid_Visitor visitor, void* const context);
+
+/* Visits every object a 2D camera can see, returning how many were visited. */
+unsigned int GAE_SpatialGrid_queryCamera(GAE_SpatialGrid_t* grid, struct GAE_Camera_s* const camera, GAE_SpatialGrid_Visitor visitor, void* const context);
+
+/* Deletes the grid. */
+void GAE_SpatialGrid_delete(GAE_SpatialGrid_t* grid);
+
+/* Fills bounds with the world rect a 2D camera shows. Returns GAE_FALSE for 3D cameras, which have no such rect. */
+GAE_BOOL GAE_SpatialGrid_getCameraBounds(struct GAE_Camera_s* const camera, GAE_Vector4_t bounds);
+
+/* Returns whether a circle touches an AABB. */
+GAE_BOOL GAE_SpatialGrid_isCircleOverlapping(const GAE_Vector4_t bounds, const GAE_Vector2_t centre, const float radius);
+
+#endif
@@ -2,52 +2,397 @@
 #include "../../../Utils/Array.h"
 #include "../../../Graphics/Renderer/Renderer.h"
 #include "../../../Graphics/Sprite.h"
+#include "../../../Graphics/Camera.h"
+#include "../../../Graphics/State/RenderState.h"
+#include "../../../Graphics/Mesh.h"
+#include "../../../Graphics/VertexBuffer.h"
+#include "../../../Graphics/IndexBuffer.h"
 #include "../../../Maths/Matrix.h"
 #include "../../../Maths/Vector.h"
 
-GAE_Tiled_t* GAE_TiledParser_draw(GAE_Tiled_t* tilemap, GAE_Renderer_t* renderer, const unsigned int layerId) {
-	unsigned int y = 0U;
-	unsigned int x = 0U;
-	
+#include <stdlib.h>
+#include <string.h>
+
+/* Tiled stores flip flags in the top bits of each global tile id */
+#define FLIPPED_HORIZONTALLY 0x80000000U
+#define FLIPPED_VERTICALLY 0x40000000U
+#define FLIPPED_DIAGONALLY 0x20000000U
+#define GID_MASK 0x1FFFFFFFU
+
+#define TILE_VERTICES 4U
+#define TILE_INDICES 6U
+#define VERTEX_FLOATS 4U /* interleaved position x, y and texcoord u, v */
+#define TILE_FLOATS (TILE_VERTICES * VERTEX_FLOATS)
+#define TILE_BYTES (TILE_FLOATS * sizeof(float))
+
+/* Which of the tile's left or right, and top or bottom, edges each corner of its quad is on */
+static const unsigned int CORNER_X[TILE_VERTICES] = { 0U, 1U, 1U, 0U };
+static const unsigned int CORNER_Y[TILE_VERTICES] = { 1U, 1U, 0U, 0U };
+
+static unsigned int findLayerTilesets(GAE_Tiled_t* tilemap, GAE_Tiled_Layer_t* layer, GAE_BOOL* isUsed);
+static void bakeChunks(GAE_Tiled_t* tilemap, GAE_Tiled_Layer_t* layer, GAE_Tiled_Tileset_t* tileset, float* vertices);
+static GAE_IndexBuffer_t* createChunkIndices(const unsigned int tiles);
+static GAE_BOOL buildTile(GAE_Tiled_t* tilemap, GAE_Tiled_Layer_t* layer, GAE_Tiled_Tileset_t* tileset, const unsigned int x, const unsigned int y, float* vertices);
+static void queueUpdate(GAE_VertexBuffer_t* buffer, const unsigned int offset, const unsigned int size);
+
+GAE_Tiled_t* GAE_TiledParser_bake(GAE_Tiled_t* tilemap, const unsigned int layerId) {
 	GAE_Tiled_Layer_t* layer = (GAE_Tiled_Layer_t*)GAE_Array_get(tilemap->layers, layerId);
-	GAE_Tiled_Tileset_t* tileset = getTileset(tilemap, *(unsigned int*)GAE_Array_begin(layer->data));
-	
-	const unsigned int margin = tileset->margin;
-	/*const unsigned int srcWidth = tileset->tileWidth + margin;*/
-	/*const unsigned int srcHeight = tileset->tileHeight + margin;*/
-	const unsigned int dstWidth = tilemap->tileWidth + margin;
-	const unsigned int dstHeight = tilemap->tileHeight + margin;
-	/*const unsigned int tilemapWidthInTiles = (tileset->imageWidth / srcWidth);*/
-	const unsigned int offsetX = layer->x;
-	const unsigned int offsetY = layer->y;
-	
-	#define ROWCOL(x,y,width) (x + y * width)
-	
-	for (y = 0U; y < layer->height; ++y) {
-		for (x = 0U; x < layer->width; ++x) {
-			/*const unsigned int tileId = *(unsigned int*)GAE_Array_get(layer->data, ROWCOL(x, y, layer->width)) - 1U;*/
-            GAE_Vector3_t position = {offsetX + (x * dstWidth), offsetY + (y * dstHeight), 0.0};
-            position[0] = 0;
-            position[1] = 0;
-            GAE_Matrix4_setToIdentity(&tileset->image->transform);
-            GAE_Matrix4_setPosition(&tileset->image->transform, &position);
-			/*
-			src.x = (tileId % tilemapWidthInTiles) * srcWidth;
-			src.y = (tileId / tilemapWidthInTiles) * srcWidth;
-			src.w = srcWidth;
-			src.h = srcHeight;
-
-			dst.x = (x * dstWidth) + offsetX;
-			dst.y = (y * dstHeight) + offsetY;
-			dst.w = dstWidth;
-			dst.h = dstHeight;
-            */
-			
-			GAE_Renderer_drawSprite(renderer, tileset->image);
+	const unsigned int tilesetCount = GAE_Array_length(tilemap->tilesets);
+	GAE_BOOL* isUsed = 0;
+	float* vertices = 0;
+	unsigned int index = 0U;
+
+	if (0 != layer->chunks)
+		GAE_TiledParser_unbake(tilemap, layerId);
+
+	if ((0 == layer->data) || (0U == GAE_Array_length(layer->data)) || (0U == tilesetCount))
+		return tilemap; /* object groups and image layers have no tile data */
+
+	isUsed = (GAE_BOOL*)malloc(tilesetCount * sizeof(GAE_BOOL));
+	if (0U == findLayerTilesets(tilemap, layer, isUsed)) {
+		free(isUsed);
+		return tilemap;
+	}
+
+	layer->chunksWide = (layer->width + GAE_TILED_CHUNK_SIZE - 1U) / GAE_TILED_CHUNK_SIZE;
+	layer->chunksHigh = (layer->height + GAE_TILED_CHUNK_SIZE - 1U) / GAE_TILED_CHUNK_SIZE;
+	layer->chunkSets = 0U;
+	layer->chunks = GAE_Array_create(sizeof(GAE_Tiled_Chunk_t));
+	layer->chunkIndices = createChunkIndices(GAE_TILED_CHUNK_SIZE * GAE_TILED_CHUNK_SIZE);
+
+	vertices = (float*)malloc(GAE_TILED_CHUNK_SIZE * GAE_TILED_CHUNK_SIZE * TILE_BYTES);
+
+	/* A chunk draws with one material, so each tileset in the layer gets a set of chunks of its own, drawn in tileset order */
+	for (index = 0U; index < tilesetCount; ++index) {
+		if (GAE_TRUE == isUsed[index])
+			bakeChunks(tilemap, layer, (GAE_Tiled_Tileset_t*)GAE_Array_get(tilemap->tilesets, index), vertices);
+	}
+
+	free(vertices);
+	free(isUsed);
+
+	return tilemap;
+}
+
+GAE_Tiled_t* GAE_TiledParser_unbake(GAE_Tiled_t* tilemap, const unsigned int layerId) {
+	GAE_Tiled_Layer_t* layer = (GAE_Tiled_Layer_t*)GAE_Array_get(tilemap->layers, layerId);
+	GAE_Tiled_Chunk_t* chunk = 0;
+
+	if (0 == layer->chunks)
+		return tilemap;
+
+	for (chunk = (GAE_Tiled_Chunk_t*)GAE_Array_begin(layer->chunks); chunk < (GAE_Tiled_Chunk_t*)GAE_Array_end(layer->chunks); ++chunk) {
+		if (chunk->mesh->iBuffer != layer->chunkIndices)
+			GAE_IndexBuffer_delete(chunk->mesh->iBuffer);
+		GAE_VertexBuffer_delete(chunk->mesh->vBuffer);
+		GAE_Mesh_delete(chunk->mesh);
+	}
+
+	GAE_IndexBuffer_delete(layer->chunkIndices);
+	layer->chunkIndices = 0;
+
+	GAE_Array_delete(layer->chunks);
+	layer->chunks = 0;
+	layer->chunksWide = 0U;
+	layer->chunksHigh = 0U;
+	layer->chunkSets = 0U;
+
+	return tilemap;
+}
+
+GAE_Tiled_t* GAE_TiledParser_setTileId(GAE_Tiled_t* tilemap, const unsigned int x, const unsigned int y, const unsigned int layerId, const unsigned int tileId) {
+	static const float EMPTY_TILE[TILE_FLOATS] = { 0.0F };
+	GAE_Tiled_Layer_t* layer = 0;
+	GAE_Tiled_Tileset_t* tileset = 0;
+	GAE_Tiled_Chunk_t* chunk = 0;
+	float* vertices = 0;
+	unsigned int index = 0U;
+	unsigned int chunkIndex = 0U;
+	unsigned int set = 0U;
+	unsigned int tile = 0U;
+	GAE_BOOL wasEmpty = GAE_TRUE;
+	GAE_BOOL isEmpty = GAE_TRUE;
+	GAE_BOOL isBaked = GAE_FALSE;
+
+	if (layerId >= GAE_Array_length(tilemap->layers))
+		return tilemap;
+
+	layer = (GAE_Tiled_Layer_t*)GAE_Array_get(tilemap->layers, layerId);
+	if ((0 == layer->data) || (x >= layer->width) || (y >= layer->height) || (y * layer->width + x >= GAE_Array_length(layer->data)))
+		return tilemap;
+
+	index = y * layer->width + x;
+	GAE_TiledParser_setGid(layer, index, tileId + 1U); /* matches getTileId, which hands back ids offset by one */
+
+	if (0 == layer->chunks) /* nothing baked yet as the layer was empty, so bake it now */
+		return GAE_TiledParser_bake(tilemap, layerId);
+
+	/* a tileset the layer didn't use before needs its own set of chunks, so bake the layer again to add them */
+	chunkIndex = (y / GAE_TILED_CHUNK_SIZE) * layer->chunksWide + (x / GAE_TILED_CHUNK_SIZE);
+	tileset = getTileset(tilemap, (tileId + 1U) & GID_MASK);
+	if ((0 != tileset) && (0 != tileset->image)) {
+		for (set = 0U; set < layer->chunkSets; ++set) {
+			chunk = (GAE_Tiled_Chunk_t*)GAE_Array_get(layer->chunks, set * layer->chunksWide * layer->chunksHigh + chunkIndex);
+			if (tileset == chunk->tileset)
+				isBaked = GAE_TRUE;
 		}
+
+		if (GAE_FALSE == isBaked)
+			return GAE_TiledParser_bake(tilemap, layerId);
+	}
+
+	/* the cell has a slot in every set at this position - only the set for the tile's tileset draws it, the rest are cleared */
+	for (set = 0U; set < layer->chunkSets; ++set) {
+		chunk = (GAE_Tiled_Chunk_t*)GAE_Array_get(layer->chunks, set * layer->chunksWide * layer->chunksHigh + chunkIndex);
+		tile = (x - chunk->x) + (y - chunk->y) * chunk->width;
+
+		/* empty cells, and any tile the chunk couldn't draw, are left as all zero degenerate quads */
+		vertices = (float*)chunk->mesh->vBuffer->data + (tile * TILE_FLOATS);
+		wasEmpty = (0 == memcmp(vertices, EMPTY_TILE, TILE_BYTES)) ? GAE_TRUE : GAE_FALSE;
+		isEmpty = (GAE_TRUE == buildTile(tilemap, layer, chunk->tileset, x, y, vertices)) ? GAE_FALSE : GAE_TRUE;
+		if ((GAE_TRUE == wasEmpty) && (GAE_TRUE == isEmpty))
+			continue;
+
+		if ((GAE_TRUE == wasEmpty) && (GAE_FALSE == isEmpty))
+			++chunk->tileCount;
+		else if ((GAE_FALSE == wasEmpty) && (GAE_TRUE == isEmpty))
+			--chunk->tileCount;
+
+		queueUpdate(chunk->mesh->vBuffer, tile * TILE_BYTES, TILE_BYTES);
+	}
+
+	return tilemap;
+}
+
+GAE_Tiled_t* GAE_TiledParser_draw(GAE_Tiled_t* tilemap, GAE_Renderer_t* renderer, const unsigned int layerId) {
+	GAE_Tiled_Layer_t* layer = (GAE_Tiled_Layer_t*)GAE_Array_get(tilemap->layers, layerId);
+	GAE_Camera_t* camera = renderer->state->camera;
+	GAE_Tiled_Chunk_t* chunk = 0;
+	GAE_Matrix4_t transform;
+	GAE_Vector3_t position;
+	float view[4]; /* 0 - left, 1 - top, 2 - right, 3 - bottom */
+	GAE_BOOL isCulling = GAE_FALSE;
+
+	if (0 == layer->chunks)
+		return tilemap;
+
+	if ((0 != camera) && (GAE_CAMERA_TYPE_2D == camera->type)) {
+		GAE_Matrix4_getPosition(&camera->transform, &position);
+		view[0] = position[0] + camera->left;
+		view[2] = position[0] + camera->right;
+		view[1] = position[1] + ((camera->top < camera->bottom) ? camera->top : camera->bottom);
+		view[3] = position[1] + ((camera->top < camera->bottom) ? camera->bottom : camera->top);
+		isCulling = GAE_TRUE;
+	}
+
+	GAE_Matrix4_setToIdentity(&transform);
+
+	for (chunk = (GAE_Tiled_Chunk_t*)GAE_Array_begin(layer->chunks); chunk < (GAE_Tiled_Chunk_t*)GAE_Array_end(layer->chunks); ++chunk) {
+		if (0U == chunk->tileCount)
+			continue;
+
+		if ((GAE_TRUE == isCulling)
+		&& ((chunk->bounds[2] < view[0]) || (chunk->bounds[0] > view[2]) || (chunk->bounds[3] < view[1]) || (chunk->bounds[1] > view[3])))
+			continue;
+
+		GAE_Renderer_drawMesh(renderer, chunk->mesh, &transform);
 	}
-	
-	#undef ROWCOL
-	
+
 	return tilemap;
 }
+
+unsigned int findLayerTilesets(GAE_Tiled_t* tilemap, GAE_Tiled_Layer_t* layer, GAE_BOOL* isUsed) {
+	const GAE_Tiled_Tileset_t* const tilesets = (GAE_Tiled_Tileset_t*)GAE_Array_begin(tilemap->tilesets);
+	const unsigned int length = GAE_Array_length(layer->data);
+	unsigned int lastGid = 0U;
+	unsigned int count = 0U;
+	unsigned int index = 0U;
+
+	/* Only tilesets with a loaded image can be drawn from - runs of the same tile only need looking up once */
+	memset(isUsed, 0, GAE_Array_length(tilemap->tilesets) * sizeof(GAE_BOOL));
+	for (index = 0U; index < length; ++index) {
+		const unsigned int gid = GAE_TiledParser_getGid(layer, index) & GID_MASK;
+		GAE_Tiled_Tileset_t* tileset = 0;
+
+		if ((0U == gid) || (lastGid == gid))
+			continue;
+
+		lastGid = gid;
+		tileset = getTileset(tilemap, gid);
+		if ((0 != tileset) && (0 != tileset->image) && (GAE_FALSE == isUsed[tileset - tilesets])) {
+			isUsed[tileset - tilesets] = GAE_TRUE;
+			++count;
+		}
+	}
+
+	return count;
+}
+
+void bakeChunks(GAE_Tiled_t* tilemap, GAE_Tiled_Layer_t* layer, GAE_Tiled_Tileset_t* tileset, float* vertices) {
+	GAE_VertexBuffer_Format_t format[GAE_VERTEXBUFFER_FORMAT_SIZE];
+	GAE_VertexBuffer_t* vBuffer = 0;
+	GAE_IndexBuffer_t* iBuffer = 0;
+	GAE_Tiled_Chunk_t chunk;
+	unsigned int chunkX = 0U;
+	unsigned int chunkY = 0U;
+	unsigned int x = 0U;
+	unsigned int y = 0U;
+	unsigned int overhangX = 0U;
+	unsigned int overhangY = 0U;
+
+	/* tiles larger than the map grid hang up and right out of their cell */
+	if (tileset->tileWidth > tilemap->tileWidth)
+		overhangX = tileset->tileWidth - tilemap->tileWidth;
+	if (tileset->tileHeight > tilemap->tileHeight)
+		overhangY = tileset->tileHeight - tilemap->tileHeight;
+
+	memset(format, 0, sizeof(format));
+	format[0] = GAE_VertexBuffer_Format_create(GAE_VERTEXBUFFER_FORMAT_POSITION_2F, 0U);
+	format[1] = GAE_VertexBuffer_Format_create(GAE_VERTEXBUFFER_FORMAT_TEXTURE_2F, 2U * sizeof(float));
+
+	GAE_Array_reserve(layer->chunks, (layer->chunkSets + 1U) * layer->chunksWide * layer->chunksHigh);
+	++layer->chunkSets;
+
+	for (chunkY = 0U; chunkY < layer->chunksHigh; ++chunkY) {
+		for (chunkX = 0U; chunkX < layer->chunksWide; ++chunkX) {
+			chunk.tileset = tileset;
+			chunk.x = chunkX * GAE_TILED_CHUNK_SIZE;
+			chunk.y = chunkY * GAE_TILED_CHUNK_SIZE;
+			chunk.width = (GAE_TILED_CHUNK_SIZE < (layer->width - chunk.x)) ? GAE_TILED_CHUNK_SIZE : (layer->width - chunk.x);
+			chunk.height = (GAE_TILED_CHUNK_SIZE < (layer->height - chunk.y)) ? GAE_TILED_CHUNK_SIZE : (layer->height - chunk.y);
+			chunk.tileCount = 0U;
+
+			/* Every cell keeps its slot - empty cells, and other tilesets' tiles, are degenerate quads - so an edit only touches its own range */
+			for (y = 0U; y < chunk.height; ++y) {
+				for (x = 0U; x < chunk.width; ++x) {
+					if (GAE_TRUE == buildTile(tilemap, layer, tileset, chunk.x + x, chunk.y + y, vertices + ((x + y * chunk.width) * TILE_FLOATS)))
+						++chunk.tileCount;
+				}
+			}
+
+			chunk.bounds[0] = (float)(layer->x + chunk.x * tilemap->tileWidth + tileset->offset[0]);
+			chunk.bounds[1] = (float)(layer->y + chunk.y * tilemap->tileHeight + tileset->offset[1]) - (float)overhangY;
+			chunk.bounds[2] = chunk.bounds[0] + (float)(chunk.width * tilemap->tileWidth + overhangX);
+			chunk.bounds[3] = (float)(layer->y + (chunk.y + chunk.height) * tilemap->tileHeight + tileset->offset[1]);
+
+			vBuffer = GAE_VertexBuffer_createWithFormat((GAE_BYTE*)vertices, chunk.width * chunk.height * TILE_BYTES, GAE_VERTEXBUFFER_TYPE_STATIC, format);
+			if ((GAE_TILED_CHUNK_SIZE == chunk.width) && (GAE_TILED_CHUNK_SIZE == chunk.height))
+				iBuffer = layer->chunkIndices;
+			else
+				iBuffer = createChunkIndices(chunk.width * chunk.height);
+
+			chunk.mesh = GAE_Mesh_create(vBuffer, iBuffer, tileset->image->mesh->material);
+			GAE_Array_push(layer->chunks, (void*)&chunk);
+		}
+	}
+}
+
+GAE_IndexBuffer_t* createChunkIndices(const unsigned int tiles) {
+	unsigned short* indices = (unsigned short*)malloc(tiles * TILE_INDICES * sizeof(unsigned short));
+	GAE_IndexBuffer_t* buffer = 0;
+	unsigned short* itr = indices;
+	unsigned int tile = 0U;
+	unsigned short base = 0U;
+
+	/* Same winding as the sprite quad */
+	for (tile = 0U; tile < tiles; ++tile) {
+		base = (unsigned short)(tile * TILE_VERTICES);
+		*itr++ = base;
+		*itr++ = base + 3U;
+		*itr++ = base + 2U;
+		*itr++ = base + 2U;
+		*itr++ = base + 1U;
+		*itr++ = base;
+	}
+
+	buffer = GAE_IndexBuffer_create((GAE_BYTE*)indices, tiles * TILE_INDICES, GAE_INDEXBUFFER_INDEX_UNSIGNED_SHORT, GAE_INDEXBUFFER_FORMAT_TRIANGLES, GAE_INDEXBUFFER_DRAW_STATIC);
+	free(indices);
+
+	return buffer;
+}
+
+GAE_BOOL buildTile(GAE_Tiled_t* tilemap, GAE_Tiled_Layer_t* layer, GAE_Tiled_Tileset_t* tileset, const unsigned int x, const unsigned int y, float* vertices) {
+	const unsigned int gid = GAE_TiledParser_getGid(layer, y * layer->width + x);
+	const unsigned int id = gid & GID_MASK;
+	const unsigned int stepX = tileset->tileWidth + tileset->spacing;
+	const unsigned int stepY = tileset->tileHeight + tileset->spacing;
+	unsigned int columns = 0U;
+	unsigned int localId = 0U;
+	float left, top, right, bottom;
+	float u[2]; /* left and right */
+	float v[2]; /* top and bottom */
+	unsigned int corner = 0U;
+
+	if ((0U == id) || (tileset != getTileset(tilemap, id)) || (0U == tileset->imageWidth) || (0U == tileset->imageHeight) || (0U == stepX)) {
+		memset(vertices, 0, TILE_BYTES);
+		return GAE_FALSE;
+	}
+
+	columns = (tileset->imageWidth - (2U * tileset->margin) + tileset->spacing) / stepX;
+	if (0U == columns)
+		columns = 1U;
+
+	localId = id - tileset->firstGid;
+	u[0] = (float)(tileset->margin + (localId % columns) * stepX) / (float)tileset->imageWidth;
+	v[0] = (float)(tileset->margin + (localId / columns) * stepY) / (float)tileset->imageHeight;
+	u[1] = u[0] + (float)tileset->tileWidth / (float)tileset->imageWidth;
+	v[1] = v[0] + (float)tileset->tileHeight / (float)tileset->imageHeight;
+
+	/* Tiles are anchored to the bottom-left of their cell, as Tiled does */
+	left = (float)(layer->x + x * tilemap->tileWidth + tileset->offset[0]);
+	bottom = (float)(layer->y + (y + 1U) * tilemap->tileHeight + tileset->offset[1]);
+	right = left + (float)tileset->tileWidth;
+	top = bottom - (float)tileset->tileHeight;
+
+	/* 0 - bottom left, 1 - bottom right, 2 - top right, 3 - top left */
+	vertices[0] = left;		vertices[1] = bottom;
+	vertices[4] = right;	vertices[5] = bottom;
+	vertices[8] = right;	vertices[9] = top;
+	vertices[12] = left;	vertices[13] = top;
+
+	/* Tiled transposes a diagonally flipped tile before flipping it horizontally then vertically,
+	 * so each corner samples the tile at its own position flipped, then with the axes swapped */
+	for (corner = 0U; corner < TILE_VERTICES; ++corner) {
+		unsigned int cornerX = CORNER_X[corner] ^ ((0U != (gid & FLIPPED_HORIZONTALLY)) ? 1U : 0U);
+		unsigned int cornerY = CORNER_Y[corner] ^ ((0U != (gid & FLIPPED_VERTICALLY)) ? 1U : 0U);
+
+		if (0U != (gid & FLIPPED_DIAGONALLY)) {
+			const unsigned int swap = cornerX;
+			cornerX = cornerY;
+			cornerY = swap;
+		}
+
+		vertices[(corner * VERTEX_FLOATS) + 2U] = u[cornerX];
+		vertices[(corner * VERTEX_FLOATS) + 3U] = v[cornerY];
+	}
+
+	return GAE_TRUE;
+}
+
+void queueUpdate(GAE_VertexBuffer_t* buffer, const unsigned int offset, const unsigned int size) {
+	GAE_VertexBuffer_UpdateData_t* update = buffer->updateData;
+	unsigned int begin = offset;
+	unsigned int end = offset + size;
+
+	if (0 == buffer->vboId)
+		return; /* not uploaded yet, so the initial upload will pick the change up */
+
+	/* Merge with any edit still waiting on the renderer, so only one sub upload happens */
+	if (0 != update) {
+		if (update->offset < begin)
+			begin = update->offset;
+		if ((update->offset + update->size) > end)
+			end = update->offset + update->size;
+		free(update->data);
+	}
+	else {
+		update = (GAE_VertexBuffer_UpdateData_t*)malloc(sizeof(GAE_VertexBuffer_UpdateData_t));
+		update->retain = GAE_FALSE;
+		buffer->updateData = update;
+	}
+
+	update->offset = begin;
+	update->size = end - begin;
+	update->data = (GAE_BYTE*)malloc(update->size);
+	memcpy(update->data, buffer->data + begin, update->size);
+}
@@ -4,12 +4,29 @@
 #include "../../../Graphics/Sprite.h"
 #include "SDL2/SDL.h"
 
+/* SDL2 blits each tile from the tileset texture, so there's nothing to bake */
+GAE_Tiled_t* GAE_TiledParser_bake(GAE_Tiled_t* tilemap, const unsigned int layerId) {
+	GAE_UNUSED(layerId);
+	return tilemap;
+}
+
+GAE_Tiled_t* GAE_TiledParser_unbake(GAE_Tiled_t* tilemap, const unsigned int layerId) {
+	GAE_UNUSED(layerId);
+	return tilemap;
+}
+
+GAE_Tiled_t* GAE_TiledParser_setTileId(GAE_Tiled_t* tilemap, const unsigned int x, const unsigned int y, const unsigned int layerId, const unsigned int tileId) {
+	GAE_Tiled_Layer_t* layer = (GAE_Tiled_Layer_t*)GAE_Array_get(tilemap->layers, layerId);
+	GAE_TiledParser_setGid(layer, y * layer->width + x, tileId + 1U);
+	return tilemap;
+}
+
 GAE_Tiled_t* GAE_TiledParser_draw(GAE_Tiled_t* tilemap, GAE_Renderer_t* renderer, const unsigned int layerId) {
 	unsigned int y = 0U;
 	unsigned int x = 0U;
 	
 	GAE_Tiled_Layer_t* layer = (GAE_Tiled_Layer_t*)GAE_Array_get(tilemap->layers, layerId);
-	GAE_Tiled_Tileset_t* tileset = getTileset(tilemap, *(unsigned int*)GAE_Array_begin(layer->data));
+	GAE_Tiled_Tileset_t* tileset = getTileset(tilemap, GAE_TiledParser_getGid(layer, 0U));
 	
 	const unsigned int margin = tileset->margin;
 	const unsigned int srcWidth = tileset->tileWidth + margin;
@@ -24,7 +41,7 @@ GAE_Tiled_t* GAE_TiledParser_draw(GAE_Tiled_t* tilemap, GAE_Renderer_t* renderer
 	
 	for (y = 0U; y < layer->height; ++y) {
 		for (x = 0U; x < layer->width; ++x) {
-			const unsigned int tileId = *(unsigned int*)GAE_Array_get(layer->data, ROWCOL(x, y, layer->width)) - 1U;
+			const unsigned int tileId = GAE_TiledParser_getGid(layer, ROWCOL(x, y, layer->width)) - 1U;
 			SDL_Rect src;
 			SDL_Rect dst;
 			
@@ -0,0 +1,454 @@
+#include "TiledCooked.h"
+
+#include "../Array.h"
+#include "../Map.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define NAME_SIZE 128U
+#define LAYER_SIZE ((NAME_SIZE * 2U) + (9U * 4U))
+#define TILESET_SIZE (NAME_SIZE + GAE_TILED_PATH_SIZE + (15U * 4U))
+#define PROPERTY_SIZE (GAE_TILED_PROPERTY_SIZE * 2U)
+#define TERRAIN_SIZE (NAME_SIZE + 4U)
+#define TILE_SIZE (5U * 4U)
+
+static unsigned int readUint32(const GAE_BYTE* data);
+static void writeUint32(GAE_BYTE* data, const unsigned int value);
+static void readString(char* destination, const GAE_BYTE* data, const unsigned int size);
+static void writeString(GAE_BYTE* data, const char* const string, const unsigned int size);
+static GAE_BOOL isRange(const unsigned long size, const unsigned long offset, const unsigned long count, const unsigned long recordSize);
+static GAE_BOOL isLittleEndian(void);
+static unsigned int getTileSize(GAE_Tiled_Layer_t* const layer);
+static unsigned long alignOffset(const unsigned long offset);
+static unsigned long writeProperties(GAE_BYTE* output, unsigned long position, GAE_Map_t* const properties, GAE_BYTE* offsetField);
+static GAE_Map_t* readProperties(const GAE_BYTE* const data, const unsigned long offset, const unsigned int count);
+static GAE_BOOL isValid(const GAE_BYTE* const data, const unsigned long size);
+static void readLayer(const GAE_BYTE* const data, const GAE_BYTE* record, GAE_Tiled_Layer_t* layer);
+static void readTileset(const GAE_BYTE* const data, const GAE_BYTE* record, GAE_Tiled_Tileset_t* tileset);
+
+GAE_BOOL GAE_TiledCooked_isHeader(const GAE_BYTE* const data, const unsigned long count) {
+	return ((GAE_TILED_COOKED_HEADER_SIZE <= count) && (0 == memcmp(data, "GTMP", 4U))) ? GAE_TRUE : GAE_FALSE;
+}
+
+GAE_Tiled_t* GAE_TiledCooked_read(const GAE_BYTE* const data, const unsigned long size) {
+	GAE_Tiled_t* tilemap = 0;
+	unsigned int layerCount = 0U;
+	unsigned int tilesetCount = 0U;
+	unsigned int index = 0U;
+
+	/* everything is checked up front, so nothing after can fail part way */
+	if (GAE_FALSE == isValid(data, size))
+		return 0;
+
+	tilemap = (GAE_Tiled_t*)malloc(sizeof(GAE_Tiled_t));
+	memset(tilemap, 0, sizeof(GAE_Tiled_t));
+	tilemap->width = readUint32(data + 12U);
+	tilemap->height = readUint32(data + 16U);
+	tilemap->tileWidth = readUint32(data + 20U);
+	tilemap->tileHeight = readUint32(data + 24U);
+	tilemap->version = readUint32(data + 28U);
+	tilemap->orientation = (GAE_TILED_ORIENTATION)readUint32(data + 32U);
+	tilemap->properties = readProperties(data, readUint32(data + 52U), readUint32(data + 56U));
+
+	layerCount = readUint32(data + 40U);
+	tilemap->layers = GAE_Array_create(sizeof(GAE_Tiled_Layer_t));
+	if (0U < layerCount)
+		GAE_Array_reserve(tilemap->layers, layerCount);
+	for (index = 0U; index < layerCount; ++index) {
+		GAE_Tiled_Layer_t layer;
+
+		readLayer(data, data + readUint32(data + 36U) + (index * LAYER_SIZE), &layer);
+		GAE_Array_push(tilemap->layers, &layer);
+	}
+
+	tilesetCount = readUint32(data + 48U);
+	tilemap->tilesets = GAE_Array_create(sizeof(GAE_Tiled_Tileset_t));
+	if (0U < tilesetCount)
+		GAE_Array_reserve(tilemap->tilesets, tilesetCount);
+	for (index = 0U; index < tilesetCount; ++index) {
+		GAE_Tiled_Tileset_t tileset;
+
+		readTileset(data, data + readUint32(data + 44U) + (index * TILESET_SIZE), &tileset);
+		GAE_Array_push(tilemap->tilesets, &tileset);
+	}
+
+	return tilemap;
+}
+
+GAE_BYTE* GAE_TiledCooked_write(GAE_Tiled_t* const tilemap, unsigned long* cookedSize) {
+	const unsigned int layerCount = GAE_Array_length(tilemap->layers);
+	const unsigned int tilesetCount = GAE_Array_length(tilemap->tilesets);
+	const unsigned long layerTable = GAE_TILED_COOKED_HEADER_SIZE;
+	const unsigned long tilesetTable = layerTable + (layerCount * LAYER_SIZE);
+	unsigned long position = tilesetTable + (tilesetCount * TILESET_SIZE);
+	unsigned long size = position;
+	GAE_Tiled_Layer_t* layer = 0;
+	GAE_Tiled_Tileset_t* tileset = 0;
+	GAE_BYTE* output = 0;
+	GAE_BYTE* record = 0;
+
+	/* sized first, with everything but the tiles ahead of them and each layer's tiles aligned */
+	if (0 != tilemap->properties)
+		size += GAE_Map_length(tilemap->properties) * PROPERTY_SIZE;
+	for (tileset = GAE_Array_begin(tilemap->tilesets); tileset < (GAE_Tiled_Tileset_t*)GAE_Array_end(tilemap->tilesets); ++tileset) {
+		if (0 != tileset->properties)
+			size += GAE_Map_length(tileset->properties) * PROPERTY_SIZE;
+		size += (GAE_Array_length(tileset->terrains) * TERRAIN_SIZE) + (GAE_Array_length(tileset->tiles) * TILE_SIZE);
+	}
+	for (layer = GAE_Array_begin(tilemap->layers); layer < (GAE_Tiled_Layer_t*)GAE_Array_end(tilemap->layers); ++layer) {
+		if (0 != layer->data)
+			size = alignOffset(size) + (GAE_Array_length(layer->data) * getTileSize(layer));
+	}
+
+	/* offsets are 32 bit */
+	if (0xFFFFFFFFUL < size)
+		return 0;
+
+	/* zeroed, for the padding */
+	output = (GAE_BYTE*)calloc(size, 1U);
+	if (0 == output)
+		return 0;
+
+	memcpy(output, "GTMP", 4U);
+	writeUint32(output + 4U, GAE_TILED_COOKED_VERSION);
+	writeUint32(output + 8U, (unsigned int)size);
+	writeUint32(output + 12U, tilemap->width);
+	writeUint32(output + 16U, tilemap->height);
+	writeUint32(output + 20U, tilemap->tileWidth);
+	writeUint32(output + 24U, tilemap->tileHeight);
+	writeUint32(output + 28U, tilemap->version);
+	writeUint32(output + 32U, (unsigned int)tilemap->orientation);
+	writeUint32(output + 36U, (unsigned int)layerTable);
+	writeUint32(output + 40U, layerCount);
+	writeUint32(output + 44U, (unsigned int)tilesetTable);
+	writeUint32(output + 48U, tilesetCount);
+	position = writeProperties(output, position, tilemap->properties, output + 52U);
+
+	record = output + tilesetTable;
+	for (tileset = GAE_Array_begin(tilemap->tilesets); tileset < (GAE_Tiled_Tileset_t*)GAE_Array_end(tilemap->tilesets); ++tileset) {
+		GAE_BYTE* fields = record + NAME_SIZE + GAE_TILED_PATH_SIZE;
+		GAE_Tiled_Terrain_t* terrain = 0;
+		GAE_Tiled_Tile_t* tile = 0;
+
+		writeString(record, tileset->name, NAME_SIZE);
+		writeString(record + NAME_SIZE, tileset->imagePath, GAE_TILED_PATH_SIZE);
+		writeUint32(fields, tileset->firstGid);
+		writeUint32(fields + 4U, tileset->imageWidth);
+		writeUint32(fields + 8U, tileset->imageHeight);
+		writeUint32(fields + 12U, tileset->margin);
+		writeUint32(fields + 16U, tileset->spacing);
+		writeUint32(fields + 20U, tileset->tileWidth);
+		writeUint32(fields + 24U, tileset->tileHeight);
+		writeUint32(fields + 28U, tileset->offset[0]);
+		writeUint32(fields + 32U, tileset->offset[1]);
+		position = writeProperties(output, position, tileset->properties, fields + 36U);
+
+		writeUint32(fields + 44U, (unsigned int)position);
+		writeUint32(fields + 48U, GAE_Array_length(tileset->terrains));
+		for (terrain = GAE_Array_begin(tileset->terrains); terrain < (GAE_Tiled_Terrain_t*)GAE_Array_end(tileset->terrains); ++terrain) {
+			writeString(output + position, terrain->name, NAME_SIZE);
+			writeUint32(output + position + NAME_SIZE, terrain->tile);
+			position += TERRAIN_SIZE;
+		}
+
+		writeUint32(fields + 52U, (unsigned int)position);
+		writeUint32(fields + 56U, GAE_Array_length(tileset->tiles));
+		for (tile = GAE_Array_begin(tileset->tiles); tile < (GAE_Tiled_Tile_t*)GAE_Array_end(tileset->tiles); ++tile) {
+			writeUint32(output + position, tile->id);
+			writeUint32(output + position + 4U, tile->terrain[0U]);
+			writeUint32(output + position + 8U, tile->terrain[1U]);
+			writeUint32(output + position + 12U, tile->terrain[2U]);
+			writeUint32(output + position + 16U, tile->terrain[3U]);
+			position += TILE_SIZE;
+		}
+
+		record += TILESET_SIZE;
+	}
+
+	record = output + layerTable;
+	for (layer = GAE_Array_begin(tilemap->layers); layer < (GAE_Tiled_Layer_t*)GAE_Array_end(tilemap->layers); ++layer) {
+		const unsigned int tileSize = getTileSize(layer);
+		GAE_BYTE* fields = record + (NAME_SIZE * 2U);
+
+		writeString(record, layer->name, NAME_SIZE);
+		writeString(record + NAME_SIZE, layer->type, NAME_SIZE);
+		writeUint32(fields, layer->width);
+		writeUint32(fields + 4U, layer->height);
+		writeUint32(fields + 8U, layer->opacity);
+		writeUint32(fields + 12U, (GAE_TRUE == layer->visible) ? 1U : 0U);
+		writeUint32(fields + 16U, layer->x);
+		writeUint32(fields + 20U, layer->y);
+		writeUint32(fields + 24U, tileSize);
+
+		if (0U != tileSize) {
+			const unsigned int length = GAE_Array_length(layer->data);
+			unsigned int index = 0U;
+
+			position = alignOffset(position);
+			writeUint32(fields + 28U, length);
+			writeUint32(fields + 32U, (unsigned int)position);
+			for (index = 0U; index < length; ++index) {
+				const unsigned int gid = GAE_TiledParser_getGid(layer, index);
+
+				if (2U == tileSize) {
+					output[position] = (GAE_BYTE)(gid & 0xFFU);
+					output[position + 1U] = (GAE_BYTE)(gid >> 8U);
+				}
+				else
+					writeUint32(output + position, gid);
+				position += tileSize;
+			}
+		}
+
+		record += LAYER_SIZE;
+	}
+
+	*cookedSize = size;
+	return output;
+}
+
+unsigned int readUint32(const GAE_BYTE* data) {
+	return (unsigned int)data[0] | ((unsigned int)data[1] << 8U) | ((unsigned int)data[2] << 16U) | ((unsigned int)data[3] << 24U);
+}
+
+void writeUint32(GAE_BYTE* data, const unsigned int value) {
+	data[0] = (GAE_BYTE)(value & 0xFFU);
+	data[1] = (GAE_BYTE)((value >> 8U) & 0xFFU);
+	data[2] = (GAE_BYTE)((value >> 16U) & 0xFFU);
+	data[3] = (GAE_BYTE)(value >> 24U);
+}
+
+/* Copies a string field out, terminated even when it fills the field. */
+void readString(char* destination, const GAE_BYTE* data, const unsigned int size) {
+	memcpy(destination, data, size);
+	destination[size - 1U] = '\0';
+}
+
+/* Copies as much of the string as fits into a zeroed field, leaving room for the terminator. */
+void writeString(GAE_BYTE* data, const char* const string, const unsigned int size) {
+	unsigned int length = 0U;
+
+	while ((length + 1U < size) && ('\0' != string[length]))
+		++length;
+	memcpy(data, string, length);
+}
+
+/* Returns whether count records of recordSize at offset are all within size bytes, without overflowing. */
+GAE_BOOL isRange(const unsigned long size, const unsigned long offset, const unsigned long count, const unsigned long recordSize) {
+	return ((offset <= size) && (count <= (size - offset) / recordSize)) ? GAE_TRUE : GAE_FALSE;
+}
+
+GAE_BOOL isLittleEndian(void) {
+	const unsigned int one = 1U;
+	return (1U == *(const GAE_BYTE*)&one) ? GAE_TRUE : GAE_FALSE;
+}
+
+/* Returns the bytes each of the layer's tiles is cooked to - 0 without data, 2 where every gid fits, else 4. */
+unsigned int getTileSize(GAE_Tiled_Layer_t* const layer) {
+	const unsigned int length = (0 != layer->data) ? GAE_Array_length(layer->data) : 0U;
+	unsigned int index = 0U;
+
+	if (0 == layer->data)
+		return 0U;
+
+	for (index = 0U; index < length; ++index) {
+		if (0xFFFFU < GAE_TiledParser_getGid(layer, index))
+			return 4U;
+	}
+
+	return 2U;
+}
+
+unsigned long alignOffset(const unsigned long offset) {
+	return (offset + GAE_TILED_COOKED_ALIGNMENT - 1U) & ~(unsigned long)(GAE_TILED_COOKED_ALIGNMENT - 1U);
+}
+
+/* Writes the properties out at position, and their offset and count into the two fields at offsetField, returning where they end. */
+unsigned long writeProperties(GAE_BYTE* output, unsigned long position, GAE_Map_t* const properties, GAE_BYTE* offsetField) {
+	const char* keys = 0;
+	const char* values = 0;
+	unsigned int count = 0U;
+	unsigned int size = 0U;
+	unsigned int index = 0U;
+
+	if (0 == properties)
+		return position;
+
+	count = GAE_Map_length(properties);
+	size = properties->ids->size;
+	keys = (const char*)GAE_Map_ids(properties);
+	values = (const char*)GAE_Map_begin(properties);
+
+	writeUint32(offsetField, (unsigned int)position);
+	writeUint32(offsetField + 4U, count);
+	for (index = 0U; index < count; ++index) {
+		char key[GAE_TILED_PROPERTY_SIZE];
+		char value[GAE_TILED_PROPERTY_SIZE];
+
+		/* the maps are terminated within GAE_TILED_PROPERTY_SIZE, but needn't be exactly that wide */
+		memset(key, 0, sizeof(key));
+		memset(value, 0, sizeof(value));
+		memcpy(key, keys + (index * size), (size < sizeof(key)) ? size : sizeof(key) - 1U);
+		memcpy(value, values + (index * properties->values->size), (properties->values->size < sizeof(value)) ? properties->values->size : sizeof(value) - 1U);
+
+		writeString(output + position, key, GAE_TILED_PROPERTY_SIZE);
+		writeString(output + position + GAE_TILED_PROPERTY_SIZE, value, GAE_TILED_PROPERTY_SIZE);
+		position += PROPERTY_SIZE;
+	}
+
+	return position;
+}
+
+GAE_Map_t* readProperties(const GAE_BYTE* const data, const unsigned long offset, const unsigned int count) {
+	GAE_Map_t* properties = 0;
+	unsigned int index = 0U;
+
+	if (0U == offset)
+		return 0;
+
+	properties = GAE_TiledParser_createProperties();
+	for (index = 0U; index < count; ++index) {
+		char key[GAE_TILED_PROPERTY_SIZE];
+		char value[GAE_TILED_PROPERTY_SIZE];
+
+		readString(key, data + offset + (index * PROPERTY_SIZE), GAE_TILED_PROPERTY_SIZE);
+		readString(value, data + offset + (index * PROPERTY_SIZE) + GAE_TILED_PROPERTY_SIZE, GAE_TILED_PROPERTY_SIZE);
+		GAE_Map_push(properties, (void*)key, (void*)value);
+	}
+
+	return properties;
+}
+
+GAE_BOOL isValid(const GAE_BYTE* const data, const unsigned long size) {
+	unsigned long layerTable = 0UL;
+	unsigned long tilesetTable = 0UL;
+	unsigned int layerCount = 0U;
+	unsigned int tilesetCount = 0U;
+	unsigned int index = 0U;
+
+	if ((GAE_FALSE == GAE_TiledCooked_isHeader(data, size)) || (GAE_TILED_COOKED_VERSION != readUint32(data + 4U)) || (size < readUint32(data + 8U)))
+		return GAE_FALSE;
+
+	if (GAE_TILED_STAGGERED < readUint32(data + 32U))
+		return GAE_FALSE;
+
+	layerTable = readUint32(data + 36U);
+	layerCount = readUint32(data + 40U);
+	tilesetTable = readUint32(data + 44U);
+	tilesetCount = readUint32(data + 48U);
+	if ((GAE_FALSE == isRange(size, layerTable, layerCount, LAYER_SIZE)) || (GAE_FALSE == isRange(size, tilesetTable, tilesetCount, TILESET_SIZE)))
+		return GAE_FALSE;
+
+	if (GAE_FALSE == isRange(size, readUint32(data + 52U), readUint32(data + 56U), PROPERTY_SIZE))
+		return GAE_FALSE;
+
+	for (index = 0U; index < layerCount; ++index) {
+		const GAE_BYTE* fields = data + layerTable + (index * LAYER_SIZE) + (NAME_SIZE * 2U);
+		const unsigned int tileSize = readUint32(fields + 24U);
+
+		if ((0U != tileSize) && (2U != tileSize) && (4U != tileSize))
+			return GAE_FALSE;
+		if ((0U != tileSize) && (GAE_FALSE == isRange(size, readUint32(fields + 32U), readUint32(fields + 28U), tileSize)))
+			return GAE_FALSE;
+	}
+
+	for (index = 0U; index < tilesetCount; ++index) {
+		const GAE_BYTE* fields = data + tilesetTable + (index * TILESET_SIZE) + NAME_SIZE + GAE_TILED_PATH_SIZE;
+
+		if ((GAE_FALSE == isRange(size, readUint32(fields + 36U), readUint32(fields + 40U), PROPERTY_SIZE))
+		|| (GAE_FALSE == isRange(size, readUint32(fields + 44U), readUint32(fields + 48U), TERRAIN_SIZE))
+		|| (GAE_FALSE == isRange(size, readUint32(fields + 52U), readUint32(fields + 56U), TILE_SIZE)))
+			return GAE_FALSE;
+	}
+
+	return GAE_TRUE;
+}
+
+void readLayer(const GAE_BYTE* const data, const GAE_BYTE* record, GAE_Tiled_Layer_t* layer) {
+	const GAE_BYTE* fields = record + (NAME_SIZE * 2U);
+	const unsigned int tileSize = readUint32(fields + 24U);
+	const unsigned int tileCount = readUint32(fields + 28U);
+	const GAE_BYTE* tiles = data + readUint32(fields + 32U);
+	unsigned int index = 0U;
+
+	memset(layer, 0, sizeof(GAE_Tiled_Layer_t));
+	readString(layer->name, record, NAME_SIZE);
+	readString(layer->type, record + NAME_SIZE, NAME_SIZE);
+	layer->width = readUint32(fields);
+	layer->height = readUint32(fields + 4U);
+	layer->opacity = readUint32(fields + 8U);
+	layer->visible = (0U != readUint32(fields + 12U)) ? GAE_TRUE : GAE_FALSE;
+	layer->x = readUint32(fields + 16U);
+	layer->y = readUint32(fields + 20U);
+
+	if (0U == tileSize)
+		return;
+
+	layer->data = GAE_Array_create(tileSize);
+	if (0U == tileCount)
+		return;
+
+	if ((GAE_TRUE == isLittleEndian()) && (0U == (size_t)tiles % tileSize)) {
+		/* the array borrows the tiles where they lie - setting one copies them out first */
+		layer->data->data = (GAE_BYTE*)tiles;
+		layer->data->allocated = tileCount * tileSize;
+		layer->data->used = tileCount * tileSize;
+		layer->isShared = GAE_TRUE;
+		return;
+	}
+
+	GAE_Array_resize(layer->data, tileCount);
+	for (index = 0U; index < tileCount; ++index) {
+		if (2U == tileSize)
+			*(unsigned short*)GAE_Array_get(layer->data, index) = (unsigned short)(tiles[index * 2U] | (tiles[(index * 2U) + 1U] << 8U));
+		else
+			*(unsigned int*)GAE_Array_get(layer->data, index) = readUint32(tiles + (index * 4U));
+	}
+}
+
+void readTileset(const GAE_BYTE* const data, const GAE_BYTE* record, GAE_Tiled_Tileset_t* tileset) {
+	const GAE_BYTE* fields = record + NAME_SIZE + GAE_TILED_PATH_SIZE;
+	const GAE_BYTE* terrains = data + readUint32(fields + 44U);
+	const GAE_BYTE* tiles = data + readUint32(fields + 52U);
+	const unsigned int terrainCount = readUint32(fields + 48U);
+	const unsigned int tileCount = readUint32(fields + 56U);
+	unsigned int index = 0U;
+
+	memset(tileset, 0, sizeof(GAE_Tiled_Tileset_t));
+	readString(tileset->name, record, NAME_SIZE);
+	readString(tileset->imagePath, record + NAME_SIZE, GAE_TILED_PATH_SIZE);
+	tileset->firstGid = readUint32(fields);
+	tileset->imageWidth = readUint32(fields + 4U);
+	tileset->imageHeight = readUint32(fields + 8U);
+	tileset->margin = readUint32(fields + 12U);
+	tileset->spacing = readUint32(fields + 16U);
+	tileset->tileWidth = readUint32(fields + 20U);
+	tileset->tileHeight = readUint32(fields + 24U);
+	tileset->offset[0] = readUint32(fields + 28U);
+	tileset->offset[1] = readUint32(fields + 32U);
+	tileset->properties = readProperties(data, readUint32(fields + 36U), readUint32(fields + 40U));
+
+	tileset->terrains = GAE_Array_create(sizeof(GAE_Tiled_Terrain_t));
+	for (index = 0U; index < terrainCount; ++index) {
+		GAE_Tiled_Terrain_t terrain;
+
+		memset(&terrain, 0, sizeof(GAE_Tiled_Terrain_t));
+		readString(terrain.name, terrains + (index * TERRAIN_SIZE), NAME_SIZE);
+		terrain.tile = readUint32(terrains + (index * TERRAIN_SIZE) + NAME_SIZE);
+		GAE_Array_push(tileset->terrains, &terrain);
+	}
+
+	tileset->tiles = GAE_Array_create(sizeof(GAE_Tiled_Tile_t));
+	for (index = 0U; index < tileCount; ++index) {
+		const GAE_BYTE* fields = tiles + (index * TILE_SIZE);
+		GAE_Tiled_Tile_t tile;
+
+		tile.id = readUint32(fields);
+		tile.terrain[0U] = readUint32(fields + 4U);
+		tile.terrain[1U] = readUint32(fields + 8U);
+		tile.terrain[2U] = readUint32(fields + 12U);
+		tile.terrain[3U] = readUint32(fields + 16U);
+		GAE_Array_push(tileset->tiles, &tile);
+	}
+}
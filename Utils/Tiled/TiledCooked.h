@@ -0,0 +1,39 @@
+#ifndef _TILED_COOKED_H_
+#define _TILED_COOKED_H_
+
+#include "TiledJsonLoader.h"
+
+/*
+	Cooked tilemaps - a Tiled map converted offline into a blob that loads without parsing anything.
+	GAE_TiledParser_parse spots the header, and GAE_TiledParser_create maps the file, so each layer's data
+	points straight into the file's buffer and loading a layer costs only the pages of it that get touched.
+	A layer's gids are stored 16 bit where they all fit, else 32, at offsets aligned to GAE_TILED_COOKED_ALIGNMENT.
+	Where the buffer can't be used as it is - a big endian platform, or a buffer that isn't aligned - the data is copied out instead.
+	All values little endian, and strings zero padded to the size of the field they're in:
+	 0 - "GTMP"            20 - tile width           40 - layer count
+	 4 - version           24 - tile height          44 - tileset table offset
+	 8 - size              28 - Tiled version        48 - tileset count
+	12 - width             32 - orientation          52 - properties offset, 0 for none
+	16 - height            36 - layer table offset   56 - property count
+	Layers are a name and type of 128 bytes each, then width, height, opacity, visible, x, y,
+	tile size - 0 for no data, 2 or 4 - tile count and the offset of the tiles.
+	Tilesets are a name of 128 bytes and image path of GAE_TILED_PATH_SIZE, then first gid, image width, image height,
+	margin, spacing, tile width, tile height, offset x and y, and offsets and counts of their properties, terrains and tiles.
+	Properties are a name and value of GAE_TILED_PROPERTY_SIZE each, terrains a name of 128 bytes and tile,
+	and tiles an id and four terrains.
+*/
+
+#define GAE_TILED_COOKED_VERSION 1U
+#define GAE_TILED_COOKED_HEADER_SIZE 60U
+#define GAE_TILED_COOKED_ALIGNMENT 16U
+
+/* Returns whether the first count bytes of a file start a cooked map. */
+GAE_BOOL GAE_TiledCooked_isHeader(const GAE_BYTE* const data, const unsigned long count);
+
+/* Reads the cooked map of size bytes at data, without loading images, returning 0 if it isn't valid. The data must outlive the map. */
+GAE_Tiled_t* GAE_TiledCooked_read(const GAE_BYTE* const data, const unsigned long size);
+
+/* Cooks the map into a new blob, returning it and its size in cookedSize, or 0 if it's too large. */
+GAE_BYTE* GAE_TiledCooked_write(GAE_Tiled_t* const tilemap, unsigned long* cookedSize);
+
+#endif
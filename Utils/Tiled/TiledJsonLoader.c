@@ -1,559 +1,1161 @@
 #include "TiledJsonLoader.h"
+#include "TiledCooked.h"
 
 #include "../../File/File.h"
-#include "../../External/jsmn/jsmn.h"
 #include "../../Graphics/Sprite.h"
+#include "../../External/stb/stb_image.h"
 #include "../Map.h"
 #include "../Array.h"
+#include "../Base64.h"
+#include "../Zstd.h"
 
-#include <assert.h>
 #include <stdlib.h>
 #include <string.h>
 
-#define JSON_TOKENS 256
-char* KEYS[] = { "height", "layers", "data", "name", "opacity", "type", "visible", "width", "x", "y", "orientation", "properties", "tileheight", "tilesets", "firstgid", "image", "imageheight", "imagewidth", "margin", "spacing", "tilewidth", "version", "terrains", "tiles", "tileoffset", "tile", "terrain", "tileproperties", "transparentcolor" };
-typedef enum KEY_e { KEY_HEIGHT, KEY_LAYERS, KEY_DATA, KEY_NAME, KEY_OPACITY, KEY_TYPE, KEY_VISIBLE, KEY_WIDTH, KEY_X, KEY_Y, KEY_ORIENTATION, KEY_PROPERTIES, KEY_TILEHEIGHT, KEY_TILESETS, KEY_FIRSTGID, KEY_IMAGE, KEY_IMAGEHEIGHT, KEY_IMAGEWIDTH, KEY_MARGIN, KEY_SPACING, KEY_TILEWIDTH, KEY_VERSION, KEY_TERRAINS, KEY_TILES, KEY_TILEOFFSET, KEY_TILE, KEY_TERRAIN, KEY_TILEPROPERTIES, KEY_TRANSPARENTCOLOR, KEY_MAX } KEY;
-
-jsmntok_t* jsonTokenise(const char* js);
-GAE_BOOL json_token_streq(char* js, jsmntok_t* t, char* s);
-char* json_token_tostr(char* js, jsmntok_t* t);
-
-void parseRootKey(jsmntok_t* token, char* string, const KEY key, GAE_Tiled_t* tiledParser);
-void parseLayerKey(jsmntok_t* token, char* string, const KEY key, GAE_Tiled_Layer_t* layerParser);
-void parseTilesetKey(jsmntok_t* token, char* string, const KEY key, GAE_Tiled_Tileset_t* tilesetParser);
-void parseTerrainKey(jsmntok_t* token, char* string, const KEY key, GAE_Tiled_Terrain_t* terrainParser);
-void parseTileKey(jsmntok_t* token, char* string, const KEY key, GAE_Tiled_Tile_t* tileParser);
-GAE_Array_t* parseData(jsmntok_t* token, char* string);
-
-GAE_Tiled_t* handleMap(jsmntok_t* tokens, char* string);
-GAE_Tiled_Layer_t* handleLayer(jsmntok_t* tokens, char* string);
-GAE_Tiled_Tileset_t* handleTileset(jsmntok_t* tokens, char* string);
+#define KEY_SLOT_COUNT 64U
+
+static const char* const KEYS[] = { "height", "layers", "data", "name", "opacity", "type", "visible", "width", "x", "y", "orientation", "properties", "tileheight", "tilesets", "firstgid", "image", "imageheight", "imagewidth", "margin", "spacing", "tilewidth", "version", "terrains", "tiles", "tileoffset", "tile", "terrain", "tileproperties", "transparentcolor", "encoding", "compression" };
+typedef enum KEY_e { KEY_HEIGHT, KEY_LAYERS, KEY_DATA, KEY_NAME, KEY_OPACITY, KEY_TYPE, KEY_VISIBLE, KEY_WIDTH, KEY_X, KEY_Y, KEY_ORIENTATION, KEY_PROPERTIES, KEY_TILEHEIGHT, KEY_TILESETS, KEY_FIRSTGID, KEY_IMAGE, KEY_IMAGEHEIGHT, KEY_IMAGEWIDTH, KEY_MARGIN, KEY_SPACING, KEY_TILEWIDTH, KEY_VERSION, KEY_TERRAINS, KEY_TILES, KEY_TILEOFFSET, KEY_TILE, KEY_TERRAIN, KEY_TILEPROPERTIES, KEY_TRANSPARENTCOLOR, KEY_ENCODING, KEY_COMPRESSION, KEY_MAX } KEY;
+
+/* Every key by the slot findKey hashes it to - no two share one, so a lookup is a hash and one compare.
+ * A new key needs a free slot, or new multipliers in findKey that give every key its own. */
+static const KEY KEY_SLOTS[KEY_SLOT_COUNT] = {
+	KEY_MAX, KEY_X, KEY_MAX, KEY_TILEHEIGHT, KEY_VERSION, KEY_DATA, KEY_MAX, KEY_MAX
+,	KEY_MAX, KEY_IMAGE, KEY_MAX, KEY_MAX, KEY_TILEOFFSET, KEY_MAX, KEY_NAME, KEY_MAX
+,	KEY_MAX, KEY_MAX, KEY_MAX, KEY_ORIENTATION, KEY_MAX, KEY_TYPE, KEY_MAX, KEY_TERRAIN
+,	KEY_TERRAINS, KEY_IMAGEHEIGHT, KEY_MAX, KEY_SPACING, KEY_MAX, KEY_MAX, KEY_MAX, KEY_MAX
+,	KEY_MAX, KEY_Y, KEY_MAX, KEY_IMAGEWIDTH, KEY_MAX, KEY_TILEPROPERTIES, KEY_MAX, KEY_MAX
+,	KEY_TILEWIDTH, KEY_ENCODING, KEY_LAYERS, KEY_PROPERTIES, KEY_MAX, KEY_OPACITY, KEY_MAX, KEY_WIDTH
+,	KEY_MAX, KEY_TILE, KEY_MAX, KEY_MAX, KEY_COMPRESSION, KEY_MARGIN, KEY_MAX, KEY_MAX
+,	KEY_TILES, KEY_HEIGHT, KEY_TILESETS, KEY_MAX, KEY_FIRSTGID, KEY_VISIBLE, KEY_MAX, KEY_TRANSPARENTCOLOR
+};
+
+/* The JSON is read in one pass straight into the map, without tokenising it first.
+ * Anything malformed clears isValid, after which every member and element loop stops where it is. */
+typedef struct Reader_s {
+	const char* position;
+	const char* end;
+	GAE_BOOL isValid;
+} Reader_t;
+
+static KEY findKey(const char* const name, const unsigned int length);
+static void skipSpace(Reader_t* reader);
+static GAE_BOOL enter(Reader_t* reader, const char open);
+static GAE_BOOL readSpan(Reader_t* reader, const char** start, unsigned int* length);
+static void readString(Reader_t* reader, char* destination, const unsigned int size);
+static unsigned int readInteger(Reader_t* reader);
+static GAE_BOOL readBoolean(Reader_t* reader);
+static unsigned int readDigits(const char** position, const char* const end);
+static unsigned int readHex(const char* const digits);
+static void skipValue(Reader_t* reader);
+static GAE_BOOL nextMember(Reader_t* reader, const char** name, unsigned int* length);
+static GAE_BOOL nextElement(Reader_t* reader);
+
+static GAE_Tiled_t* parseMap(Reader_t* reader);
+static void parseLayer(Reader_t* reader, GAE_Tiled_Layer_t* layer);
+static void parseTileset(Reader_t* reader, GAE_Tiled_Tileset_t* tileset);
+static void parseTerrains(Reader_t* reader, GAE_Array_t* terrains);
+static void parseTiles(Reader_t* reader, GAE_Array_t* tiles);
+static GAE_Map_t* parseProperties(Reader_t* reader);
+static GAE_Array_t* parseData(Reader_t* reader);
+static GAE_Array_t* decodeData(Reader_t* reader, const char* const start, const unsigned int length, const char* const compression, const unsigned int count);
+static GAE_BOOL inflateGzip(const GAE_BYTE* const source, const unsigned long sourceSize, GAE_BYTE* destination, const unsigned long size);
+static unsigned int countElements(const char* position, const char* const end);
+
+static GAE_BOOL isLayerChanged(GAE_Tiled_Layer_t* const layer, GAE_Tiled_Layer_t* const newLayer);
+static GAE_BOOL isTilesetChanged(GAE_Tiled_Tileset_t* const tileset, GAE_Tiled_Tileset_t* const newTileset);
+static void loadImages(GAE_Tiled_t* tilemap);
+static void copyLayerData(GAE_Tiled_Layer_t* layer, const unsigned int size);
+static void deleteLayerData(GAE_Tiled_Layer_t* layer);
+static void deleteTileset(GAE_Tiled_Tileset_t* tileset);
+static void deleteMap(GAE_Tiled_t* tilemap);
 
 GAE_BOOL StringCompare(void* A, void* B) {
 	char* a = (char*)A;
 	char* b = (char*)B;
-	
+
 	return !strncmp(a, b, strlen(a)); /*strncmp returns 0 if they match*/
 }
 
 GAE_Tiled_t* GAE_TiledParser_create(struct GAE_File_s* const file) {
 	GAE_FILE_STATUS openStatus;
 	GAE_FILE_READ_STATUS readStatus;
-	jsmntok_t* tokens = 0;
+	GAE_Tiled_t* tilemap = 0;
+	unsigned int index = 0U;
+
+	/* binary, as a cooked map is used as it's read */
+	GAE_File_open(file, GAE_FILE_OPEN_MAP, GAE_FILE_BINARY, &openStatus);
+	if (GAE_FILE_OPEN != openStatus)
+		return 0;
 
-	GAE_File_open(file, GAE_FILE_OPEN_READ, GAE_FILE_ASCII, &openStatus);
 	GAE_File_read(file, GAE_FILE_READ_ALL, &readStatus);
-	tokens = jsonTokenise((char*)file->buffer);
+	if (GAE_FILE_READ_ERROR == readStatus)
+		return 0;
+
+	tilemap = GAE_TiledParser_parse(file);
+	if (0 == tilemap)
+		return 0;
+
+	loadImages(tilemap);
+	for (index = 0U; index < GAE_Array_length(tilemap->layers); ++index)
+		GAE_TiledParser_bake(tilemap, index);
 
-	return handleMap(tokens, (char*)file->buffer);
+	return tilemap;
 }
 
-void GAE_TiledParser_delete(GAE_Tiled_t* tiledParser) {
-	free(tiledParser);
-	tiledParser = 0;
+GAE_Tiled_t* GAE_TiledParser_parse(struct GAE_File_s* const file) {
+	Reader_t reader;
+	GAE_Tiled_t* tilemap = 0;
+
+	if (0 == file->buffer)
+		return 0;
+
+	if (GAE_TRUE == GAE_TiledCooked_isHeader(file->buffer, file->bufferSize))
+		return GAE_TiledCooked_read(file->buffer, file->bufferSize);
+
+	reader.position = (const char*)file->buffer;
+	reader.end = reader.position + file->bufferSize;
+	reader.isValid = GAE_TRUE;
+
+	tilemap = parseMap(&reader);
+	if (GAE_FALSE == reader.isValid) {
+		deleteMap(tilemap);
+		return 0;
+	}
+
+	return tilemap;
 }
 
-jsmntok_t* jsonTokenise(const char* js) {
-	jsmn_parser parser;
-	unsigned int numTokens = JSON_TOKENS;
-	jsmntok_t* tokens = (jsmntok_t*)malloc(sizeof(jsmntok_t) * numTokens);
-	int ret = 0;
+GAE_Tiled_t* GAE_TiledParser_reload(GAE_Tiled_t* tilemap, struct GAE_File_s* const file, GAE_BOOL* status) {
+	GAE_FILE_STATUS openStatus;
+	GAE_FILE_READ_STATUS readStatus;
+	GAE_Tiled_t* newMap = 0;
+	GAE_BOOL isRebuilt = GAE_FALSE;
+	unsigned int layerCount = 0U;
+	unsigned int index = 0U;
+
+	/* anything kept from the last parse is out of date - once no layer points into it */
+	for (index = 0U; index < GAE_Array_length(tilemap->layers); ++index) {
+		GAE_Tiled_Layer_t* layer = GAE_Array_get(tilemap->layers, index);
 
-	jsmn_init(&parser);
-	ret = jsmn_parse(&parser, js, tokens, numTokens);
+		if (GAE_TRUE == layer->isShared)
+			copyLayerData(layer, layer->data->size);
+	}
 
-	while (ret == JSMN_ERROR_NOMEM) { /* Not enough tokens allocated, allocate some more */
-		numTokens = numTokens * 2 + 1;
-		tokens = realloc(tokens, sizeof(jsmntok_t) * numTokens);
-		ret = jsmn_parse(&parser, js, tokens, numTokens);
+	GAE_File_close(file, GAE_FILE_CLOSE_DELETE_DATA, 0);
+	if (0 != file->buffer) {
+		GAE_File_deleteBuffer(file, 0);
+		file->buffer = 0;
+		file->bufferSize = 0UL;
 	}
 
-	if (ret == JSMN_ERROR_INVAL) {
-		/*log_die("jsmn_parse: invalid JSON string");*/
+	GAE_File_open(file, GAE_FILE_OPEN_MAP, GAE_FILE_BINARY, &openStatus);
+	if (GAE_FILE_OPEN != openStatus) {
+		if (0 != status)
+			*status = GAE_FALSE;
+		return tilemap;
 	}
-	if (ret == JSMN_ERROR_PART) {
-		/*log_die("jsmn_parse: truncated JSON string");*/
+
+	GAE_File_read(file, GAE_FILE_READ_ALL, &readStatus);
+	if (GAE_FILE_READ_ERROR == readStatus) {
+		if (0 != status)
+			*status = GAE_FALSE;
+		return tilemap;
 	}
 
-    return tokens;
-}
+	newMap = GAE_TiledParser_parse(file);
+	if (0 == newMap) {
+		if (0 != status)
+			*status = GAE_FALSE;
+		return tilemap;
+	}
 
-GAE_BOOL json_token_streq(char* js, jsmntok_t* t, char* s) {
-	return (0 == strncmp(js + t->start, s, t->end - t->start)
-		&& strlen(s) == (size_t) (t->end - t->start));
-}
+	/* every layer is built against the grid and the tilesets, so a change to either rebuilds the lot */
+	if ((tilemap->width != newMap->width) || (tilemap->height != newMap->height) || (tilemap->tileWidth != newMap->tileWidth) || (tilemap->tileHeight != newMap->tileHeight) || (tilemap->orientation != newMap->orientation))
+		isRebuilt = GAE_TRUE;
 
-char* json_token_tostr(char* js, jsmntok_t* t) {
-	js[t->end] = '\0';
-	return js + t->start;
-}
+	if (GAE_Array_length(tilemap->tilesets) != GAE_Array_length(newMap->tilesets))
+		isRebuilt = GAE_TRUE;
+	for (index = 0U; (GAE_FALSE == isRebuilt) && (index < GAE_Array_length(tilemap->tilesets)); ++index)
+		isRebuilt = isTilesetChanged(GAE_Array_get(tilemap->tilesets, index), GAE_Array_get(newMap->tilesets, index));
 
-GAE_Tiled_t* handleMap(jsmntok_t* tokens, char* string) {
-	GAE_Tiled_t* tiledParser = (GAE_Tiled_t*)malloc(sizeof(GAE_Tiled_t));
+	if (GAE_TRUE == isRebuilt) {
+		for (index = 0U; index < GAE_Array_length(tilemap->layers); ++index)
+			GAE_TiledParser_unbake(tilemap, index);
+	}
 
-	unsigned int index = 0U;
-	unsigned int currentToken = 1U;
-	unsigned int objects = 0U;
-	unsigned int keyIndex = 0U;
-	unsigned int depth = 0U;
-	int parent = 0U;
-	jsmntok_t* token = &tokens[index];
+	/* the tilesets in use keep their sprites unless they changed - their images reload on their own */
+	{
+		GAE_Array_t* oldTilesets = (GAE_TRUE == isRebuilt) ? tilemap->tilesets : newMap->tilesets;
+		GAE_Tiled_Tileset_t* tileset = 0;
 
-	memset(tiledParser, 0, sizeof(GAE_Tiled_t));
+		for (tileset = GAE_Array_begin(oldTilesets); tileset < (GAE_Tiled_Tileset_t*)GAE_Array_end(oldTilesets); ++tileset)
+			deleteTileset(tileset);
+		GAE_Array_delete(oldTilesets);
 
-	tiledParser->layers = GAE_Array_create(sizeof(GAE_Tiled_Layer_t));
-	tiledParser->tilesets = GAE_Array_create(sizeof(GAE_Tiled_Tileset_t));
-	tiledParser->properties = 0;
+		if (GAE_TRUE == isRebuilt) {
+			tilemap->tilesets = newMap->tilesets;
+			loadImages(tilemap);
+		}
+	}
 
-	assert(token->type == JSMN_OBJECT); /* First token should be the entire JSON object */
+	if (0 != tilemap->properties)
+		GAE_Map_delete(tilemap->properties);
+	tilemap->properties = newMap->properties;
+	tilemap->width = newMap->width;
+	tilemap->height = newMap->height;
+	tilemap->tileWidth = newMap->tileWidth;
+	tilemap->tileHeight = newMap->tileHeight;
+	tilemap->version = newMap->version;
+	tilemap->orientation = newMap->orientation;
+
+	/* layers are matched up by index, and only those that differ are rebuilt */
+	layerCount = GAE_Array_length(newMap->layers);
+	for (index = 0U; index < layerCount; ++index) {
+		GAE_Tiled_Layer_t* newLayer = GAE_Array_get(newMap->layers, index);
+
+		if (index >= GAE_Array_length(tilemap->layers)) {
+			GAE_Array_push(tilemap->layers, newLayer);
+			GAE_TiledParser_bake(tilemap, index);
+		}
+		else {
+			GAE_Tiled_Layer_t* layer = GAE_Array_get(tilemap->layers, index);
+
+			if ((GAE_TRUE == isRebuilt) || (GAE_TRUE == isLayerChanged(layer, newLayer))) {
+				GAE_TiledParser_unbake(tilemap, index);
+				deleteLayerData(layer);
+				memcpy(layer, newLayer, sizeof(GAE_Tiled_Layer_t));
+				GAE_TiledParser_bake(tilemap, index);
+			}
+			else
+				deleteLayerData(newLayer);
+		}
+	}
 
-	objects = token->size / 2U; /* How many objects and things have we here? JSMN counts open/closed objects. */
+	while (GAE_Array_length(tilemap->layers) > layerCount) {
+		GAE_Tiled_Layer_t* layer = 0;
 
-	for (index = 0U; index < objects;) {
-		token = &tokens[currentToken++];
+		GAE_TiledParser_unbake(tilemap, GAE_Array_length(tilemap->layers) - 1U);
+		layer = GAE_Array_pop(tilemap->layers);
+		deleteLayerData(layer);
+		free(layer);
+	}
 
-		if (token->parent < parent) {
-			--depth;
-			parent = token->parent;
+	GAE_Array_delete(newMap->layers);
+	free(newMap);
 
-			if (parent == 0)
-				depth = 0;
-		}
+	if (0 != status)
+		*status = GAE_TRUE;
+	return tilemap;
+}
 
-		for (keyIndex = 0U; keyIndex < KEY_MAX; ++keyIndex) {
-			if (json_token_streq(string, token, KEYS[keyIndex])) {
-				if (0 == depth) {
-					parseRootKey(&tokens[currentToken], string, keyIndex, tiledParser);
-					++index;
+void GAE_TiledParser_delete(GAE_Tiled_t* tiledParser) {
+	unsigned int index = 0U;
+	for (index = 0U; index < GAE_Array_length(tiledParser->layers); ++index)
+		GAE_TiledParser_unbake(tiledParser, index);
+
+	deleteMap(tiledParser);
+	tiledParser = 0;
+}
+
+GAE_Tiled_t* parseMap(Reader_t* reader) {
+	GAE_Tiled_t* tilemap = (GAE_Tiled_t*)malloc(sizeof(GAE_Tiled_t));
+	const char* name = 0;
+	unsigned int length = 0U;
+
+	memset(tilemap, 0, sizeof(GAE_Tiled_t));
+	tilemap->layers = GAE_Array_create(sizeof(GAE_Tiled_Layer_t));
+	tilemap->tilesets = GAE_Array_create(sizeof(GAE_Tiled_Tileset_t));
+
+	if (GAE_FALSE == enter(reader, '{')) {
+		reader->isValid = GAE_FALSE;
+		return tilemap;
+	}
+
+	while (GAE_TRUE == nextMember(reader, &name, &length)) {
+		switch (findKey(name, length)) {
+			case KEY_HEIGHT: {
+				tilemap->height = readInteger(reader);
+			}
+			break;
+			case KEY_WIDTH: {
+				tilemap->width = readInteger(reader);
+			}
+			break;
+			case KEY_PROPERTIES: {
+				if (0 == tilemap->properties)
+					tilemap->properties = parseProperties(reader);
+				else
+					skipValue(reader);
+			}
+			break;
+			case KEY_ORIENTATION: {
+				char orientation[16];
+
+				readString(reader, orientation, sizeof(orientation));
+				if (0 == strcmp(orientation, "isometric"))
+					tilemap->orientation = GAE_TILED_ISOMETRIC;
+				/* the misspelling was all that used to be matched, so maps written to suit it still load */
+				else if ((0 == strcmp(orientation, "orthogonal")) || (0 == strcmp(orientation, "orthagonal")))
+					tilemap->orientation = GAE_TILED_ORTHAGONAL;
+				else if (0 == strcmp(orientation, "staggered"))
+					tilemap->orientation = GAE_TILED_STAGGERED;
+			}
+			break;
+			case KEY_TILEHEIGHT: {
+				tilemap->tileHeight = readInteger(reader);
+			}
+			break;
+			case KEY_TILEWIDTH: {
+				tilemap->tileWidth = readInteger(reader);
+			}
+			break;
+			case KEY_VERSION: {
+				tilemap->version = readInteger(reader);
+			}
+			break;
+			case KEY_LAYERS: {
+				if (GAE_TRUE == enter(reader, '[')) {
+					while (GAE_TRUE == nextElement(reader)) {
+						GAE_Tiled_Layer_t layer;
+
+						memset(&layer, 0, sizeof(GAE_Tiled_Layer_t));
+						if (GAE_TRUE == enter(reader, '{')) {
+							parseLayer(reader, &layer);
+							GAE_Array_push(tilemap->layers, &layer);
+						}
+					}
 				}
-				break;
 			}
+			break;
+			case KEY_TILESETS: {
+				if (GAE_TRUE == enter(reader, '[')) {
+					while (GAE_TRUE == nextElement(reader)) {
+						GAE_Tiled_Tileset_t tileset;
+
+						memset(&tileset, 0, sizeof(GAE_Tiled_Tileset_t));
+						if (GAE_TRUE == enter(reader, '{')) {
+							tileset.terrains = GAE_Array_create(sizeof(GAE_Tiled_Terrain_t));
+							tileset.tiles = GAE_Array_create(sizeof(GAE_Tiled_Tile_t));
+							parseTileset(reader, &tileset);
+							GAE_Array_push(tilemap->tilesets, &tileset);
+						}
+					}
+				}
+			}
+			break;
+			default:
+				skipValue(reader);
+			break;
 		}
-		if ((token->type == JSMN_OBJECT) || (token->type == JSMN_ARRAY)) {
-			++depth;
-			parent = currentToken - 1U;
+	}
+
+	return tilemap;
+}
+
+void parseLayer(Reader_t* reader, GAE_Tiled_Layer_t* layer) {
+	const char* name = 0;
+	unsigned int length = 0U;
+	/* encoded data comes before the encoding that says how to read it, so it's kept until the whole layer's been read */
+	const char* encoded = 0;
+	unsigned int encodedLength = 0U;
+	char encoding[16] = "csv";
+	char compression[16] = "";
+
+	while (GAE_TRUE == nextMember(reader, &name, &length)) {
+		switch (findKey(name, length)) {
+			case KEY_HEIGHT: {
+				layer->height = readInteger(reader);
+			}
+			break;
+			case KEY_WIDTH: {
+				layer->width = readInteger(reader);
+			}
+			break;
+			case KEY_DATA: {
+				skipSpace(reader);
+				if ((0 != layer->data) || (0 != encoded))
+					skipValue(reader);
+				else if ((reader->position < reader->end) && ('"' == *reader->position))
+					readSpan(reader, &encoded, &encodedLength);
+				else
+					layer->data = parseData(reader);
+			}
+			break;
+			case KEY_ENCODING: {
+				readString(reader, encoding, sizeof(encoding));
+			}
+			break;
+			case KEY_COMPRESSION: {
+				readString(reader, compression, sizeof(compression));
+			}
+			break;
+			case KEY_NAME: {
+				readString(reader, layer->name, sizeof(layer->name));
+			}
+			break;
+			case KEY_OPACITY: {
+				layer->opacity = readInteger(reader);
+			}
+			break;
+			case KEY_TYPE: {
+				readString(reader, layer->type, sizeof(layer->type));
+			}
+			break;
+			case KEY_VISIBLE: {
+				layer->visible = readBoolean(reader);
+			}
+			break;
+			case KEY_X: {
+				layer->x = readInteger(reader);
+			}
+			break;
+			case KEY_Y: {
+				layer->y = readInteger(reader);
+			}
+			break;
+			default:
+				skipValue(reader);
+			break;
 		}
 	}
 
-    return tiledParser;
+	if ((0 != encoded) && (GAE_TRUE == reader->isValid)) {
+		if ((0 == strcmp(encoding, "base64")) && ((0U == layer->width) || (0xFFFFFFFFU / 4U / layer->width >= layer->height)))
+			layer->data = decodeData(reader, encoded, encodedLength, compression, layer->width * layer->height);
+		else
+			reader->isValid = GAE_FALSE;
+	}
 }
 
-GAE_Tiled_Layer_t* handleLayer(jsmntok_t* tokens, char* string) {
-	GAE_Tiled_Layer_t* layer = (GAE_Tiled_Layer_t*)malloc(sizeof(GAE_Tiled_Layer_t));
+void parseTileset(Reader_t* reader, GAE_Tiled_Tileset_t* tileset) {
+	const char* name = 0;
+	unsigned int length = 0U;
 
-	unsigned int index = 0U;
-	unsigned int currentToken = 1U;
-	unsigned int objects = 0U;
-	unsigned int keyIndex = 0U;
-	jsmntok_t* token = &tokens[index];
+	while (GAE_TRUE == nextMember(reader, &name, &length)) {
+		switch (findKey(name, length)) {
+			case KEY_FIRSTGID: {
+				tileset->firstGid = readInteger(reader);
+			}
+			break;
+			case KEY_IMAGEWIDTH: {
+				tileset->imageWidth = readInteger(reader);
+			}
+			break;
+			case KEY_IMAGEHEIGHT: {
+				tileset->imageHeight = readInteger(reader);
+			}
+			break;
+			case KEY_MARGIN: {
+				tileset->margin = readInteger(reader);
+			}
+			break;
+			case KEY_SPACING: {
+				tileset->spacing = readInteger(reader);
+			}
+			break;
+			case KEY_TILEWIDTH: {
+				tileset->tileWidth = readInteger(reader);
+			}
+			break;
+			case KEY_TILEHEIGHT: {
+				tileset->tileHeight = readInteger(reader);
+			}
+			break;
+			case KEY_TILEOFFSET: {
+				if (GAE_TRUE == enter(reader, '{')) {
+					while (GAE_TRUE == nextMember(reader, &name, &length)) {
+						switch (findKey(name, length)) {
+							case KEY_X: {
+								tileset->offset[0] = readInteger(reader);
+							}
+							break;
+							case KEY_Y: {
+								tileset->offset[1] = readInteger(reader);
+							}
+							break;
+							default:
+								skipValue(reader);
+							break;
+						}
+					}
+				}
+			}
+			break;
+			case KEY_IMAGE: {
+				readString(reader, tileset->imagePath, sizeof(tileset->imagePath));
+			}
+			break;
+			case KEY_TERRAINS: {
+				parseTerrains(reader, tileset->terrains);
+			}
+			break;
+			case KEY_TILES: {
+				parseTiles(reader, tileset->tiles);
+			}
+			break;
+			case KEY_PROPERTIES: {
+				if (0 == tileset->properties)
+					tileset->properties = parseProperties(reader);
+				else
+					skipValue(reader);
+			}
+			break;
+			case KEY_NAME: {
+				readString(reader, tileset->name, sizeof(tileset->name));
+			}
+			break;
+			default:
+				skipValue(reader);
+			break;
+		}
+	}
+}
 
-	memset(layer, 0, sizeof(GAE_Tiled_Layer_t));
+void parseTerrains(Reader_t* reader, GAE_Array_t* terrains) {
+	const char* name = 0;
+	unsigned int length = 0U;
 
-	assert(token->type == JSMN_OBJECT);
-	objects = token->size / 2U;
+	if (GAE_FALSE == enter(reader, '['))
+		return;
 
-	for (index = 0U; index < objects;) {
-		token = &tokens[currentToken++];
+	while (GAE_TRUE == nextElement(reader)) {
+		GAE_Tiled_Terrain_t terrain;
 
-		for (keyIndex = 0U; keyIndex < KEY_MAX; ++keyIndex) {
-			if (json_token_streq(string, token, KEYS[keyIndex])) {
-				parseLayerKey(&tokens[currentToken], string, keyIndex, layer);
-				++index;
+		memset(&terrain, 0, sizeof(GAE_Tiled_Terrain_t));
+		if (GAE_FALSE == enter(reader, '{'))
+			continue;
+
+		while (GAE_TRUE == nextMember(reader, &name, &length)) {
+			switch (findKey(name, length)) {
+				case KEY_NAME: {
+					readString(reader, terrain.name, sizeof(terrain.name));
+				}
+				break;
+				case KEY_TILE: {
+					terrain.tile = readInteger(reader);
+				}
+				break;
+				default:
+					skipValue(reader);
 				break;
 			}
 		}
+
+		GAE_Array_push(terrains, &terrain);
 	}
-	return layer;
 }
 
-GAE_Tiled_Tileset_t* handleTileset(jsmntok_t* tokens, char* string) {
-	GAE_Tiled_Tileset_t* tileset = (GAE_Tiled_Tileset_t*)malloc(sizeof(GAE_Tiled_Tileset_t));
-	unsigned int index = 0U;
-	unsigned int currentToken = 1U;
-	unsigned int objects = 0U;
-	unsigned int keyIndex = 0U;
-	jsmntok_t* token = &tokens[index];
-	int parent = (&tokens[currentToken])->parent;
-
-	memset(tileset, 0, sizeof(GAE_Tiled_Tileset_t));
-	tileset->terrains = GAE_Array_create(sizeof(GAE_Tiled_Terrain_t));
-	tileset->tiles = GAE_Array_create(sizeof(GAE_Tiled_Tile_t));
-
-	assert(token->type == JSMN_OBJECT);
-	objects = token->size / 2U;
-
-	for (index = 0U; index < objects;) {
-		token = &tokens[currentToken++];
-
-		if ((&tokens[currentToken])->parent == parent) {
-			for (keyIndex = 0U; keyIndex < KEY_MAX; ++keyIndex) {
-				if (json_token_streq(string, token, KEYS[keyIndex])) {
-					parseTilesetKey(&tokens[currentToken], string, keyIndex, tileset);
-					++index;
-					break;
+/* Tiles are an object keyed by their id, each giving the terrain at its corners. */
+void parseTiles(Reader_t* reader, GAE_Array_t* tiles) {
+	const char* id = 0;
+	unsigned int idLength = 0U;
+	const char* name = 0;
+	unsigned int length = 0U;
+
+	if (GAE_FALSE == enter(reader, '{'))
+		return;
+
+	while (GAE_TRUE == nextMember(reader, &id, &idLength)) {
+		GAE_Tiled_Tile_t tile;
+		Reader_t idReader;
+
+		memset(&tile, 0, sizeof(GAE_Tiled_Tile_t));
+		idReader.position = id;
+		idReader.end = id + idLength;
+		idReader.isValid = GAE_TRUE;
+		tile.id = readInteger(&idReader);
+
+		if (GAE_FALSE == enter(reader, '{'))
+			continue;
+
+		while (GAE_TRUE == nextMember(reader, &name, &length)) {
+			switch (findKey(name, length)) {
+				case KEY_TERRAIN: {
+					unsigned int corner = 0U;
+
+					if (GAE_TRUE == enter(reader, '[')) {
+						while (GAE_TRUE == nextElement(reader)) {
+							if (4U > corner)
+								tile.terrain[corner++] = readInteger(reader);
+							else
+								skipValue(reader);
+						}
+					}
 				}
+				break;
+				default:
+					skipValue(reader);
+				break;
 			}
 		}
+
+		GAE_Array_push(tiles, &tile);
 	}
+}
 
-	return tileset;
+/* Properties are kept as strings by name - values that aren't strings are kept as they're written.
+ * Only the object form is read, so the array of named, typed properties newer Tiled writes is skipped. */
+GAE_Map_t* parseProperties(Reader_t* reader) {
+	char keyBuffer[GAE_TILED_PROPERTY_SIZE];
+	char valueBuffer[GAE_TILED_PROPERTY_SIZE];
+	const char* name = 0;
+	unsigned int length = 0U;
+	GAE_Map_t* map = 0;
+
+	if (GAE_FALSE == enter(reader, '{'))
+		return 0;
+
+	map = GAE_TiledParser_createProperties();
+	while (GAE_TRUE == nextMember(reader, &name, &length)) {
+		Reader_t keyReader;
+
+		/* the name's quotes are either side of it, so it can be read again as a string to unescape it */
+		keyReader.position = name - 1;
+		keyReader.end = name + length + 1U;
+		keyReader.isValid = GAE_TRUE;
+		readString(&keyReader, keyBuffer, sizeof(keyBuffer));
+
+		skipSpace(reader);
+		if ((reader->position < reader->end) && ('"' == *reader->position))
+			readString(reader, valueBuffer, sizeof(valueBuffer));
+		else {
+			const char* start = reader->position;
+			unsigned int size = 0U;
+
+			skipValue(reader);
+			size = (unsigned int)(reader->position - start);
+			if (sizeof(valueBuffer) <= size)
+				size = sizeof(valueBuffer) - 1U;
+			memcpy(valueBuffer, start, size);
+			valueBuffer[size] = '\0';
+		}
+
+		GAE_Map_push(map, (void*)keyBuffer, (void*)valueBuffer);
+	}
+
+	return map;
 }
 
-GAE_Tiled_Terrain_t* handleTerrains(jsmntok_t* tokens, char* string) {
-	GAE_Tiled_Terrain_t* terrain = malloc(sizeof(GAE_Tiled_Terrain_t));
+/* The array is sized by counting its elements before any are read, so each tile is written straight into place.
+ * Data that isn't an array is skipped. */
+GAE_Array_t* parseData(Reader_t* reader) {
+	GAE_Array_t* data = 0;
+	unsigned int* tiles = 0;
+	unsigned int count = 0U;
 	unsigned int index = 0U;
-	unsigned int currentToken = 1U;
-	unsigned int objects = 0U;
-	unsigned int keyIndex = 0U;
-	jsmntok_t* token = &tokens[index];
-	int parent = (&tokens[currentToken])->parent;
-
-	objects = token->size / 2U;
-	memset(terrain, 0, sizeof(GAE_Tiled_Terrain_t));
-
-	for (index = 0U; index < objects;) {
-		token = &tokens[currentToken++];
-
-		if ((&tokens[currentToken])->parent == parent) {
-			for (keyIndex = 0U; keyIndex < KEY_MAX; ++keyIndex) {
-				if (json_token_streq(string, token, KEYS[keyIndex])) {
-					parseTerrainKey(&tokens[currentToken], string, keyIndex, terrain);
-					++index;
-					break;
-				}
-			}
+
+	if (GAE_FALSE == enter(reader, '['))
+		return 0;
+
+	count = countElements(reader->position, reader->end);
+	data = GAE_Array_create(sizeof(unsigned int));
+	GAE_Array_resize(data, count);
+	tiles = (unsigned int*)GAE_Array_begin(data);
+
+	while (GAE_TRUE == nextElement(reader)) {
+		if (count <= index) {
+			reader->isValid = GAE_FALSE;
+			break;
 		}
-	}
 
-	if (0 == strlen(terrain->name)) {
-		free (terrain);
-		terrain = 0;
+		tiles[index++] = readInteger(reader);
 	}
 
-	return terrain;
+	GAE_Array_resize(data, index);
+	return data;
 }
 
-GAE_Tiled_Tile_t* handleTiles(jsmntok_t* tokens, char* string) {
-	GAE_Tiled_Tile_t* tile = malloc(sizeof(GAE_Tiled_Tile_t));
-	unsigned int index = 0U;
-	unsigned int currentToken = 1U;
-	unsigned int objects = 0U;
-	unsigned int keyIndex = 0U;
-	jsmntok_t* token = &tokens[index];
-
-	memset(tile, 0, sizeof(GAE_Tiled_Tile_t));
-	tile->id = atoi(json_token_tostr(string, token));
-	token = &tokens[1U];
-
-	objects = tokens->size / 2U;
-	printf("Objects: %d\n%s\n", objects, json_token_tostr(string,tokens));
-
-	for (index = 0U; index < objects;) {
-		for (keyIndex = 0U; keyIndex < KEY_MAX; ++keyIndex) {
-			if (json_token_streq(string, &token[currentToken], KEYS[keyIndex])) {
-				parseTileKey(&token[currentToken], string, keyIndex, tile);
+/* Decodes a layer's base64 data into its count tiles, which Tiled writes as little endian unsigned ints, after inflating
+ * them with zlib, gzip or zstd where compressed. Uncompressed data is decoded straight into the array, without a copy. */
+GAE_Array_t* decodeData(Reader_t* reader, const char* const start, const unsigned int length, const char* const compression, const unsigned int count) {
+	const unsigned long size = (unsigned long)count * 4UL;
+	const unsigned int one = 1U;
+	GAE_Array_t* data = GAE_Array_create(sizeof(unsigned int));
+	const char* source = start;
+	unsigned long sourceLength = length;
+	char* unescaped = 0;
+	GAE_BYTE* tiles = 0;
+	GAE_BOOL isEscaped = GAE_TRUE;
+	GAE_BOOL isDecoded = GAE_FALSE;
+
+	GAE_Array_resize(data, count);
+	tiles = (GAE_BYTE*)GAE_Array_begin(data);
+
+	/* the only escape base64 can have is a solidus written as \/ */
+	if (0 != memchr(start, '\\', length)) {
+		unsigned int index = 0U;
+
+		unescaped = malloc(length);
+		sourceLength = 0UL;
+		for (index = 0U; index < length; ++index) {
+			if ('\\' == start[index]) {
+				if ((index + 1U >= length) || ('/' != start[index + 1U]))
+					break;
 				++index;
-				break;
 			}
+			unescaped[sourceLength++] = start[index];
 		}
+
+		source = unescaped;
+		isEscaped = (index == length) ? GAE_TRUE : GAE_FALSE;
 	}
-	
-	return tile;
+
+	if ((GAE_TRUE == isEscaped) && ('\0' == compression[0])) {
+		if (size == GAE_Base64_getDecodedSize(source, sourceLength))
+			isDecoded = GAE_Base64_decode(source, sourceLength, tiles, size);
+	}
+	else if (GAE_TRUE == isEscaped) {
+		const unsigned long compressedSize = GAE_Base64_getDecodedSize(source, sourceLength);
+		GAE_BYTE* compressed = malloc(compressedSize + 1UL);
+
+		if (GAE_TRUE == GAE_Base64_decode(source, sourceLength, compressed, compressedSize)) {
+			if (0 == strcmp(compression, "zlib"))
+				isDecoded = ((0x7FFFFFFFUL >= size) && (0x7FFFFFFFUL >= compressedSize) && ((int)size == stbi_zlib_decode_buffer((char*)tiles, (int)size, (const char*)compressed, (int)compressedSize))) ? GAE_TRUE : GAE_FALSE;
+			else if (0 == strcmp(compression, "gzip"))
+				isDecoded = inflateGzip(compressed, compressedSize, tiles, size);
+			else if (0 == strcmp(compression, "zstd"))
+				isDecoded = GAE_Zstd_decompress(compressed, compressedSize, tiles, size);
+		}
+
+		free(compressed);
+	}
+
+	free(unescaped);
+
+	if (GAE_FALSE == isDecoded) {
+		reader->isValid = GAE_FALSE;
+		GAE_Array_resize(data, 0U);
+		return data;
+	}
+
+	/* big endian, so each tile's bytes are read back in the order they were written */
+	if (1U != *(const GAE_BYTE*)&one) {
+		unsigned int* tile = (unsigned int*)GAE_Array_begin(data);
+		unsigned int index = 0U;
+
+		for (index = 0U; index < count; ++index, tiles += 4)
+			tile[index] = (unsigned int)tiles[0] | ((unsigned int)tiles[1] << 8U) | ((unsigned int)tiles[2] << 16U) | ((unsigned int)tiles[3] << 24U);
+	}
+
+	return data;
 }
 
-GAE_Map_t* handleProperties(jsmntok_t* tokens, char* string) {
-	char keyBuffer[256];
-	char valueBuffer[256];
-	unsigned int index = 0;
-	unsigned int objects = 0U;
-	unsigned int currentToken = 1U;
-	unsigned int keySize = 256U;
-	unsigned int valueSize = 256U;
-	char* keyString = 0;
-	char* valueString = 0;
+/* Inflates a gzip member (RFC 1952) past its header, checking the length its trailer gives. */
+GAE_BOOL inflateGzip(const GAE_BYTE* const source, const unsigned long sourceSize, GAE_BYTE* destination, const unsigned long size) {
+	const GAE_BYTE flags = (10UL <= sourceSize) ? source[3] : 0U;
+	unsigned long position = 10UL;
 
-	GAE_Map_t* map = GAE_Map_create(sizeof(keyBuffer), sizeof(valueBuffer), StringCompare);
-	jsmntok_t* key = tokens;
-	jsmntok_t* value = tokens;
+	if ((18UL > sourceSize) || (0x1FU != source[0]) || (0x8BU != source[1]) || (8U != source[2]) || (0x7FFFFFFFUL < size) || (0x7FFFFFFFUL < sourceSize))
+		return GAE_FALSE;
+
+	/* extra field, name, comment and header CRC, in that order where the flags say they're there */
+	if (0U != (flags & 0x04U)) {
+		if (position + 2UL > sourceSize)
+			return GAE_FALSE;
+		position += 2UL + ((unsigned long)source[position] | ((unsigned long)source[position + 1UL] << 8U));
+	}
+	if (0U != (flags & 0x08U)) {
+		while ((position < sourceSize) && (0U != source[position]))
+			++position;
+		++position;
+	}
+	if (0U != (flags & 0x10U)) {
+		while ((position < sourceSize) && (0U != source[position]))
+			++position;
+		++position;
+	}
+	if (0U != (flags & 0x02U))
+		position += 2UL;
 
-	assert(key->type == JSMN_OBJECT); /* First token should be the entire JSON object */
+	if ((position + 8UL > sourceSize) || ((size & 0xFFFFFFFFUL) != ((unsigned long)source[sourceSize - 4UL] | ((unsigned long)source[sourceSize - 3UL] << 8U) | ((unsigned long)source[sourceSize - 2UL] << 16U) | ((unsigned long)source[sourceSize - 1UL] << 24U))))
+		return GAE_FALSE;
 
-	objects = key->size / 2U; /* How many objects and things have we here? JSMN counts open/closed objects. */
+	return ((int)size == stbi_zlib_decode_noheader_buffer((char*)destination, (int)size, (const char*)&source[position], (int)(sourceSize - position - 8UL))) ? GAE_TRUE : GAE_FALSE;
+}
 
-	for (index = 0U; index < objects; ++index) {
-		key = &tokens[currentToken++];
-		value = &tokens[currentToken++];
+/* Counts the elements of the flat array that carries on from position by the commas between them. */
+unsigned int countElements(const char* position, const char* const end) {
+	unsigned int count = 1U;
 
-		keyString = json_token_tostr(string, key);
-		valueString = json_token_tostr(string, value);
+	while ((position < end) && ((' ' == *position) || ('\n' == *position) || ('\r' == *position) || ('\t' == *position)))
+		++position;
 
-		if (255 > strlen(keyString))
-			keySize = strlen(keyString) + 1;
-		else keySize = 255;
+	if ((position >= end) || (']' == *position))
+		return 0U;
 
-		if (255 > strlen(valueString))
-			valueSize = strlen(valueString) + 1;
-		else valueSize = 255;
-		
-		strncpy(keyBuffer, (void*)json_token_tostr(string, key), keySize);
-		strncpy(valueBuffer, json_token_tostr(string, value), valueSize);
-		GAE_Map_push(map, (void*)keyBuffer, (void*)valueBuffer);
-      }
+	for (; (position < end) && (']' != *position); ++position) {
+		if (',' == *position)
+			++count;
+	}
 
-    return map;
+	return count;
 }
 
-void parseRootKey(jsmntok_t* token, char* string, const KEY key, GAE_Tiled_t* tiledParser) {
-	switch (key) {
-		case KEY_HEIGHT: {
-			tiledParser->height = atoi(json_token_tostr(string, token));
-		}
-		break;
-		case KEY_WIDTH: {
-			tiledParser->width = atoi(json_token_tostr(string, token));
-		}
-		break;
-		case KEY_PROPERTIES: {
-			if (0 == tiledParser->properties)
-				tiledParser->properties = handleProperties(token, string);
-		}
-		break;
-		case KEY_ORIENTATION: {
-			if (json_token_streq(string, token, "isometric"))
-				tiledParser->orientation = GAE_TILED_ISOMETRIC;
-			else if (json_token_streq(string, token, "orthagonal"))
-				tiledParser->orientation = GAE_TILED_ORTHAGONAL;
-			else if (json_token_streq(string, token, "staggered"))
-				tiledParser->orientation = GAE_TILED_STAGGERED;
-		}
-		break;
-		case KEY_TILEHEIGHT: {
-			tiledParser->tileHeight = atoi(json_token_tostr(string, token));
-		}
-		break;
-		case KEY_TILEWIDTH: {
-			tiledParser->tileWidth = atoi(json_token_tostr(string, token));
-		}
-		break;
-		case KEY_VERSION: {
-			tiledParser->version = atoi(json_token_tostr(string, token));
-		}
-		break;
-		case KEY_LAYERS: {
-			unsigned int objects = token->size;
-			unsigned int index = 0U;
-			if (token->type == JSMN_OBJECT) {
-				index = 1U;
-				objects = 1U;
-			}
-
-			for (index = 0U; 0U != objects; ++index) {
-				if (JSMN_OBJECT == token[index].type) {
-					GAE_Tiled_Layer_t* newLayer = handleLayer(&token[index], string);
-					assert(newLayer);
-					GAE_Array_push(tiledParser->layers, newLayer);
-					--objects;
-				}
-			}
+/* Looks the key up by its perfect hash of the first, middle and last characters and length - see KEY_SLOTS. */
+KEY findKey(const char* const name, const unsigned int length) {
+	const unsigned char* const characters = (const unsigned char*)name;
+	KEY key = KEY_MAX;
+
+	if (0U == length)
+		return KEY_MAX;
+
+	key = KEY_SLOTS[((characters[0] * 18U) + (characters[length / 2U] * 9U) + (characters[length - 1U] * 5U) + length) & (KEY_SLOT_COUNT - 1U)];
+	if ((KEY_MAX == key) || (length != strlen(KEYS[key])) || (0 != memcmp(name, KEYS[key], length)))
+		return KEY_MAX;
+
+	return key;
+}
+
+void skipSpace(Reader_t* reader) {
+	while ((reader->position < reader->end) && ((' ' == *reader->position) || ('\n' == *reader->position) || ('\r' == *reader->position) || ('\t' == *reader->position)))
+		++reader->position;
+}
+
+/* Steps into the object or array that opens with open, or skips whatever else is there and returns GAE_FALSE. */
+GAE_BOOL enter(Reader_t* reader, const char open) {
+	skipSpace(reader);
+	if ((reader->position < reader->end) && (open == *reader->position)) {
+		++reader->position;
+		return GAE_TRUE;
+	}
+
+	skipValue(reader);
+	return GAE_FALSE;
+}
+
+/* Reads past the string at the reader, giving where its contents start and their length as written, still escaped. */
+GAE_BOOL readSpan(Reader_t* reader, const char** start, unsigned int* length) {
+	const char* position = 0;
+
+	skipSpace(reader);
+	if ((reader->position >= reader->end) || ('"' != *reader->position)) {
+		reader->isValid = GAE_FALSE;
+		return GAE_FALSE;
+	}
+
+	/* found with memchr, as layer data can be megabytes of base64 - a quote is only escaped by an odd run of backslashes before it */
+	for (position = reader->position + 1; position < reader->end; ++position) {
+		const char* backslash = 0;
+
+		position = memchr(position, '"', (size_t)(reader->end - position));
+		if (0 == position)
+			break;
+
+		for (backslash = position; (backslash - 1 > reader->position) && ('\\' == backslash[-1]); --backslash)
+			;
+		if (0 == (position - backslash) % 2) {
+			*start = reader->position + 1;
+			*length = (unsigned int)(position - *start);
+			reader->position = position + 1;
+			return GAE_TRUE;
 		}
-		break;
-		case KEY_TILESETS: {
-			unsigned int objects = token->size;
-			unsigned int index = 0U;
-			if (token->type == JSMN_OBJECT) {
-				objects = 1U;
-				index = 1U;
-			}
-
-			for (index = 0U; 0U != objects; ++index) {
-				if (JSMN_OBJECT == token[index].type) {
-					GAE_Tiled_Tileset_t* newTileset = handleTileset(&token[index], string);
-					assert(newTileset);
-					GAE_Array_push(tiledParser->tilesets, newTileset);
-					--objects;
+	}
+
+	reader->isValid = GAE_FALSE;
+	return GAE_FALSE;
+}
+
+/* Reads the string at the reader into destination, unescaped and cut short to fit - anything that isn't a string reads as empty. */
+void readString(Reader_t* reader, char* destination, const unsigned int size) {
+	const char* start = 0;
+	unsigned int length = 0U;
+	unsigned int index = 0U;
+	unsigned int used = 0U;
+
+	destination[0] = '\0';
+	skipSpace(reader);
+	if ((reader->position >= reader->end) || ('"' != *reader->position)) {
+		skipValue(reader);
+		return;
+	}
+
+	if (GAE_FALSE == readSpan(reader, &start, &length))
+		return;
+
+	for (index = 0U; (index < length) && (used + 1U < size); ++index) {
+		char character = start[index];
+
+		if (('\\' == character) && (index + 1U < length)) {
+			character = start[++index];
+			switch (character) {
+				case 'b': character = '\b'; break;
+				case 'f': character = '\f'; break;
+				case 'n': character = '\n'; break;
+				case 'r': character = '\r'; break;
+				case 't': character = '\t'; break;
+				case 'u': {
+					/* written out as UTF-8, and dropped rather than split when it won't all fit */
+					unsigned int code = 0U;
+
+					if (index + 4U >= length) {
+						index = length;
+						continue;
+					}
+
+					code = readHex(&start[index + 1U]);
+					index += 4U;
+					if (0x80U > code)
+						character = (char)code;
+					else if (0x800U > code) {
+						if (used + 3U > size) {
+							index = length;
+							continue;
+						}
+						destination[used++] = (char)(0xC0U | (code >> 6U));
+						character = (char)(0x80U | (code & 0x3FU));
+					}
+					else {
+						if (used + 4U > size) {
+							index = length;
+							continue;
+						}
+						destination[used++] = (char)(0xE0U | (code >> 12U));
+						destination[used++] = (char)(0x80U | ((code >> 6U) & 0x3FU));
+						character = (char)(0x80U | (code & 0x3FU));
+					}
 				}
+				break;
+				default: /* quotes, slashes and backslashes are themselves */
+				break;
 			}
 		}
-		default:
-		break;
+
+		destination[used++] = character;
 	}
+
+	destination[used] = '\0';
 }
 
-void parseLayerKey(jsmntok_t* token, char* string, const KEY key, GAE_Tiled_Layer_t* layerParser) {
-	switch (key) {
-		case KEY_HEIGHT: {
-			layerParser->height = atoi(json_token_tostr(string, token));
-		}
-		break;
-		case KEY_WIDTH: {
-			layerParser->width = atoi(json_token_tostr(string, token));
-		}
-		break;
-		case KEY_DATA: {
-			if (0 == layerParser->data)
-				layerParser->data = parseData(token, string);
-		}
-		break;
-		case KEY_NAME: {
-			char* name = json_token_tostr(string, token);
-			unsigned int length = strlen(name);
+/* Reads a number as atoi would, dropping any fraction or exponent, or the number a string starts with.
+ * Anything else is skipped and reads as 0. */
+unsigned int readInteger(Reader_t* reader) {
+	unsigned int value = 0U;
+	GAE_BOOL isNegative = GAE_FALSE;
 
-			if (127 > length)
-				length = 127;
+	skipSpace(reader);
+	if (reader->position >= reader->end) {
+		reader->isValid = GAE_FALSE;
+		return 0U;
+	}
 
-			strncpy(layerParser->name, name, length);
-		}
-		break;
-		case KEY_OPACITY: {
-			layerParser->opacity = atoi(json_token_tostr(string, token));
-		}
-		break;
-		case KEY_TYPE: {
-			char* type = json_token_tostr(string, token);
-			unsigned int length = strlen(type);
+	if ('"' == *reader->position) {
+		Reader_t number;
+		const char* start = 0;
+		unsigned int length = 0U;
 
-			if (127 > length)
-				length = 127;
+		if (GAE_FALSE == readSpan(reader, &start, &length))
+			return 0U;
 
-			strncpy(layerParser->type, type, length);
-		}
-		break;
-		case KEY_VISIBLE: {
-			layerParser->visible = atoi(json_token_tostr(string, token));
-		}
-		break;
-		case KEY_X: {
-			layerParser->x = atoi(json_token_tostr(string, token));
-		}
-		break;
-		case KEY_Y: {
-			layerParser->y = atoi(json_token_tostr(string, token));
-		}
-		default:
-		break;
+		number.position = start;
+		number.end = start + length;
+		number.isValid = GAE_TRUE;
+		return readInteger(&number);
+	}
+
+	if ('-' == *reader->position) {
+		isNegative = GAE_TRUE;
+		++reader->position;
+	}
+
+	if ((reader->position >= reader->end) || ('0' > *reader->position) || ('9' < *reader->position)) {
+		skipValue(reader);
+		return 0U;
 	}
+
+	value = readDigits(&reader->position, reader->end);
+	while ((reader->position < reader->end) && (('.' == *reader->position) || ('e' == *reader->position) || ('E' == *reader->position) || ('+' == *reader->position) || ('-' == *reader->position) || (('0' <= *reader->position) && ('9' >= *reader->position))))
+		++reader->position;
+
+	return (GAE_TRUE == isNegative) ? 0U - value : value;
 }
 
-void parseTilesetKey(jsmntok_t* token, char* string, const KEY key, GAE_Tiled_Tileset_t* tilesetParser) {
-	switch (key) {
-		case KEY_FIRSTGID: {
-			tilesetParser->firstGid = atoi(json_token_tostr(string, token));
-		}
-		break;
-		case KEY_IMAGEWIDTH: {
-			tilesetParser->imageWidth = atoi(json_token_tostr(string, token));
-		}
-		break;
-		case KEY_IMAGEHEIGHT: {
-			tilesetParser->imageHeight = atoi(json_token_tostr(string, token));
-		}
-		break;
-		case KEY_MARGIN: {
-			tilesetParser->margin = atoi(json_token_tostr(string, token));
-		}
-		break;
-		case KEY_SPACING: {
-			tilesetParser->spacing = atoi(json_token_tostr(string, token));
-		}
-		break;
-		case KEY_TILEWIDTH: {
-			tilesetParser->tileWidth = atoi(json_token_tostr(string, token));
-		}
-		break;
-		case KEY_TILEHEIGHT: {
-			tilesetParser->tileHeight = atoi(json_token_tostr(string, token));
-		}
-		break;
-		case KEY_TILEOFFSET: {
-			tilesetParser->offset[0] = atoi(json_token_tostr(string, token + 2));
-			tilesetParser->offset[1] = atoi(json_token_tostr(string, token + 4));
-		}
-		break;
-		case KEY_IMAGE: {
-			tilesetParser->image = GAE_Sprite_create(json_token_tostr(string, token));			
+/* Reads true or false, or a number as true when it isn't 0. */
+GAE_BOOL readBoolean(Reader_t* reader) {
+	skipSpace(reader);
+	if ((reader->position < reader->end) && (('t' == *reader->position) || ('f' == *reader->position))) {
+		const GAE_BOOL value = ('t' == *reader->position) ? GAE_TRUE : GAE_FALSE;
+
+		skipValue(reader);
+		return value;
+	}
+
+	return (0U != readInteger(reader)) ? GAE_TRUE : GAE_FALSE;
+}
+
+/* Reads the run of digits at position four at a time while there are four bytes left to load:
+ * every byte that isn't a digit is flagged, the lowest flag gives how many digits lead the rest,
+ * and those are folded into pairs then the pair of pairs with two multiplies rather than one a digit. */
+unsigned int readDigits(const char** position, const char* const end) {
+	static const unsigned int POWERS[5] = { 1U, 10U, 100U, 1000U, 10000U };
+	const unsigned char* digits = (const unsigned char*)*position;
+	const unsigned char* const last = (const unsigned char*)end;
+	unsigned int value = 0U;
+	unsigned int count = 4U;
+
+	while ((4U == count) && (4 <= last - digits)) {
+		/* loaded a byte at a time, so the first digit is the lowest byte whatever the platform's order */
+		const unsigned int word = (unsigned int)digits[0] | ((unsigned int)digits[1] << 8U) | ((unsigned int)digits[2] << 16U) | ((unsigned int)digits[3] << 24U);
+		const unsigned int invalid = ((word & 0xF0F0F0F0U) ^ 0x30303030U) | ((((word & 0x7F7F7F7FU) + 0x06060606U) & 0xF0F0F0F0U) ^ 0x30303030U);
+		const unsigned int flags = (((invalid & 0x7F7F7F7FU) + 0x7F7F7F7FU) | invalid) & 0x80808080U;
+		unsigned int lanes = 0U;
+
+		if (0U != flags)
+			count = (((((flags & (0U - flags)) - 1U) >> 7U) & 0x01010101U) * 0x01010101U) >> 24U;
+		if (0U == count)
+			break;
+
+		lanes = (word & 0x0F0F0F0FU) << (8U * (4U - count));
+		lanes = ((lanes * 10U) + (lanes >> 8U)) & 0x00FF00FFU;
+		lanes = ((lanes * 100U) + (lanes >> 16U)) & 0x0000FFFFU;
+		value = (value * POWERS[count]) + lanes;
+		digits += count;
+	}
+
+	while ((digits < last) && ('0' <= *digits) && ('9' >= *digits))
+		value = (value * 10U) + (unsigned int)(*digits++ - '0');
+
+	*position = (const char*)digits;
+	return value;
+}
+
+unsigned int readHex(const char* const digits) {
+	unsigned int value = 0U;
+	unsigned int index = 0U;
+
+	for (index = 0U; index < 4U; ++index) {
+		const char digit = digits[index];
+
+		value <<= 4U;
+		if (('0' <= digit) && ('9' >= digit))
+			value |= (unsigned int)(digit - '0');
+		else if (('a' <= digit) && ('f' >= digit))
+			value |= (unsigned int)(digit - 'a' + 10);
+		else if (('A' <= digit) && ('F' >= digit))
+			value |= (unsigned int)(digit - 'A' + 10);
+	}
+
+	return value;
+}
+
+/* Skips the value at the reader, however deeply it nests. */
+void skipValue(Reader_t* reader) {
+	const char* start = 0;
+	unsigned int length = 0U;
+	unsigned int depth = 0U;
+
+	skipSpace(reader);
+	if (reader->position >= reader->end) {
+		reader->isValid = GAE_FALSE;
+		return;
+	}
+
+	switch (*reader->position) {
+		case '"': {
+			readSpan(reader, &start, &length);
 		}
 		break;
-		case KEY_TERRAINS: {
+		case '{':
+		case '[': {
+			while (reader->position < reader->end) {
+				const char character = *reader->position;
+
+				if ('"' == character) {
+					if (GAE_FALSE == readSpan(reader, &start, &length))
+						return;
+					continue;
+				}
+
+				++reader->position;
+				if (('{' == character) || ('[' == character))
+					++depth;
+				else if ((('}' == character) || (']' == character)) && (0U == --depth))
+					return;
+			}
+
+			reader->isValid = GAE_FALSE;
 		}
 		break;
-		case KEY_TILES: {
+		case ',':
+		case ':':
+		case ']':
+		case '}': {
+			/* a missing value - nothing can be skipped, so reading carries on no further */
+			reader->isValid = GAE_FALSE;
 		}
 		break;
-		case KEY_PROPERTIES: {
-			tilesetParser->properties = handleProperties(token, string);
+		default: {
+			/* numbers, true, false and null */
+			while ((reader->position < reader->end) && (',' != *reader->position) && (']' != *reader->position) && ('}' != *reader->position)
+				&& (' ' != *reader->position) && ('\n' != *reader->position) && ('\r' != *reader->position) && ('\t' != *reader->position))
+				++reader->position;
 		}
 		break;
-		case KEY_NAME: {
-			char* name = json_token_tostr(string, token);
-			unsigned int length = strlen(name);
+	}
+}
 
-			if (127 > length)
-				length = 127;
+/* Moves on to the next member of the object being read, giving its name, or steps out of the object and returns GAE_FALSE at its end. */
+GAE_BOOL nextMember(Reader_t* reader, const char** name, unsigned int* length) {
+	if (GAE_FALSE == reader->isValid)
+		return GAE_FALSE;
 
-			strncpy(tilesetParser->name, name, length);
-		}
-		break;
-		default:
-		break;
+	skipSpace(reader);
+	if ((reader->position < reader->end) && (',' == *reader->position)) {
+		++reader->position;
+		skipSpace(reader);
 	}
-}
 
-void parseTerrainKey(jsmntok_t* token, char* string, const KEY key, GAE_Tiled_Terrain_t* terrainParser) {
-	switch (key) {
-		case KEY_NAME: {
-			char* name = json_token_tostr(string, token);
-			unsigned int length = strlen(name);
+	if (reader->position >= reader->end) {
+		reader->isValid = GAE_FALSE;
+		return GAE_FALSE;
+	}
 
-			if (127 > length)
-				length = 127;
+	if ('}' == *reader->position) {
+		++reader->position;
+		return GAE_FALSE;
+	}
 
-			strncpy(terrainParser->name, name, length);
-			printf("Terrain: %s\n", terrainParser->name);
-		}
-		break;
-		case KEY_TILE: {
-			terrainParser->tile = atoi(json_token_tostr(string, token));
-		}
-		break;
-		default:
-		break;
+	if (GAE_FALSE == readSpan(reader, name, length))
+		return GAE_FALSE;
+
+	skipSpace(reader);
+	if ((reader->position >= reader->end) || (':' != *reader->position)) {
+		reader->isValid = GAE_FALSE;
+		return GAE_FALSE;
 	}
+
+	++reader->position;
+	return GAE_TRUE;
 }
 
-void parseTileKey(jsmntok_t* token, char* string, const KEY key, GAE_Tiled_Tile_t* tileParser) {
-	switch (key) {
-		case KEY_TERRAIN: {
-			tileParser->terrain[0U] = atoi(json_token_tostr(string, token + 2U));
-			tileParser->terrain[1U] = atoi(json_token_tostr(string, token + 3U));
-			tileParser->terrain[2U] = atoi(json_token_tostr(string, token + 4U));
-			tileParser->terrain[3U] = atoi(json_token_tostr(string, token + 5U));
-		}
-		break;
-		default:
-		break;
+/* Moves on to the next element of the array being read, or steps out of the array and returns GAE_FALSE at its end. */
+GAE_BOOL nextElement(Reader_t* reader) {
+	if (GAE_FALSE == reader->isValid)
+		return GAE_FALSE;
+
+	skipSpace(reader);
+	if ((reader->position < reader->end) && (',' == *reader->position)) {
+		++reader->position;
+		skipSpace(reader);
 	}
-}
 
-GAE_Array_t* parseData(jsmntok_t* token, char* string) {
-	GAE_Array_t* data = GAE_Array_create(sizeof(unsigned int));
-	unsigned int index = 0U;
-	unsigned int currentToken = 1U;
-	const unsigned int size = token->size;
-	unsigned int value = 0U;
-	assert(token->type == JSMN_ARRAY);
+	if (reader->position >= reader->end) {
+		reader->isValid = GAE_FALSE;
+		return GAE_FALSE;
+	}
 
-	for (index = 0U; index < size; ++index) {
-		value = atoi(json_token_tostr(string, token + currentToken));
-		GAE_Array_push(data, (void*)&value);
-		++currentToken;
+	if (']' == *reader->position) {
+		++reader->position;
+		return GAE_FALSE;
 	}
 
-	return data;
+	return GAE_TRUE;
 }
 
-
+/* The owner is the tileset starting closest at or below the gid, as each runs on until the next one's first gid. */
 GAE_Tiled_Tileset_t* getTileset(GAE_Tiled_t* tilemap, const unsigned int tileId) {
 	const unsigned int tilesetCount = GAE_Array_length(tilemap->tilesets);
+	GAE_Tiled_Tileset_t* owner = NULL;
 	unsigned int index = 0U;
 	
 	if (tilesetCount == 1U)
@@ -561,15 +1163,151 @@ GAE_Tiled_Tileset_t* getTileset(GAE_Tiled_t* tilemap, const unsigned int tileId)
 	
 	for (index = 0U; index < tilesetCount; ++index) {
 		GAE_Tiled_Tileset_t* tileset = (GAE_Tiled_Tileset_t*)GAE_Array_get(tilemap->tilesets, index);
-		if (tileId > tileset->firstGid)
-			return tileset;
+		if ((tileId >= tileset->firstGid) && ((NULL == owner) || (tileset->firstGid > owner->firstGid)))
+			owner = tileset;
 	}
 	
-	return NULL;
+	return owner;
 }
 
 unsigned int GAE_TiledParser_getTileId(GAE_Tiled_t* tilemap, const unsigned int x, const unsigned int y, const unsigned int layerId) {
 	GAE_Tiled_Layer_t* layer = (GAE_Tiled_Layer_t*)GAE_Array_get(tilemap->layers, layerId);
-	return *(unsigned int*)GAE_Array_get(layer->data, y * layer->width + x) - 1U;
+	return GAE_TiledParser_getGid(layer, y * layer->width + x) - 1U;
+}
+
+unsigned int GAE_TiledParser_getGid(GAE_Tiled_Layer_t* const layer, const unsigned int index) {
+	if (sizeof(unsigned short) == layer->data->size)
+		return *(unsigned short*)GAE_Array_get(layer->data, index);
+
+	return *(unsigned int*)GAE_Array_get(layer->data, index);
+}
+
+void GAE_TiledParser_setGid(GAE_Tiled_Layer_t* const layer, const unsigned int index, const unsigned int gid) {
+	const GAE_BOOL isNarrow = (sizeof(unsigned short) == layer->data->size) ? GAE_TRUE : GAE_FALSE;
+
+	if ((GAE_TRUE == isNarrow) && (0xFFFFU < gid))
+		copyLayerData(layer, sizeof(unsigned int));
+	else if (GAE_TRUE == layer->isShared)
+		copyLayerData(layer, layer->data->size);
+
+	if (sizeof(unsigned short) == layer->data->size)
+		*(unsigned short*)GAE_Array_get(layer->data, index) = (unsigned short)gid;
+	else
+		*(unsigned int*)GAE_Array_get(layer->data, index) = gid;
+}
+
+GAE_Map_t* GAE_TiledParser_createProperties(void) {
+	return GAE_Map_create(GAE_TILED_PROPERTY_SIZE, GAE_TILED_PROPERTY_SIZE, StringCompare);
+}
+
+GAE_BOOL isLayerChanged(GAE_Tiled_Layer_t* const layer, GAE_Tiled_Layer_t* const newLayer) {
+	const unsigned int dataLength = (0 != layer->data) ? GAE_Array_length(layer->data) : 0U;
+	const unsigned int newDataLength = (0 != newLayer->data) ? GAE_Array_length(newLayer->data) : 0U;
+	unsigned int index = 0U;
+
+	if ((layer->width != newLayer->width) || (layer->height != newLayer->height) || (layer->x != newLayer->x) || (layer->y != newLayer->y))
+		return GAE_TRUE;
+
+	if ((layer->opacity != newLayer->opacity) || (layer->visible != newLayer->visible))
+		return GAE_TRUE;
+
+	if ((0 != strcmp(layer->name, newLayer->name)) || (0 != strcmp(layer->type, newLayer->type)))
+		return GAE_TRUE;
+
+	if (dataLength != newDataLength)
+		return GAE_TRUE;
+
+	if ((0U < dataLength) && (layer->data->size == newLayer->data->size))
+		return (0 != memcmp(GAE_Array_begin(layer->data), GAE_Array_begin(newLayer->data), dataLength * layer->data->size)) ? GAE_TRUE : GAE_FALSE;
+
+	/* one's from a cooked map and held narrower, so compare gid by gid */
+	for (index = 0U; index < dataLength; ++index) {
+		if (GAE_TiledParser_getGid(layer, index) != GAE_TiledParser_getGid(newLayer, index))
+			return GAE_TRUE;
+	}
+
+	return GAE_FALSE;
+}
+
+GAE_BOOL isTilesetChanged(GAE_Tiled_Tileset_t* const tileset, GAE_Tiled_Tileset_t* const newTileset) {
+	if ((tileset->firstGid != newTileset->firstGid) || (tileset->imageWidth != newTileset->imageWidth) || (tileset->imageHeight != newTileset->imageHeight))
+		return GAE_TRUE;
+
+	if ((tileset->margin != newTileset->margin) || (tileset->spacing != newTileset->spacing) || (tileset->tileWidth != newTileset->tileWidth) || (tileset->tileHeight != newTileset->tileHeight))
+		return GAE_TRUE;
+
+	if ((tileset->offset[0] != newTileset->offset[0]) || (tileset->offset[1] != newTileset->offset[1]))
+		return GAE_TRUE;
+
+	if (0 != strcmp(tileset->imagePath, newTileset->imagePath))
+		return GAE_TRUE;
+
+	return (0 != strcmp(tileset->name, newTileset->name)) ? GAE_TRUE : GAE_FALSE;
 }
 
+void loadImages(GAE_Tiled_t* tilemap) {
+	GAE_Tiled_Tileset_t* tileset = 0;
+
+	for (tileset = GAE_Array_begin(tilemap->tilesets); tileset < (GAE_Tiled_Tileset_t*)GAE_Array_end(tilemap->tilesets); ++tileset) {
+		if ((0 == tileset->image) && ('\0' != tileset->imagePath[0]))
+			tileset->image = GAE_Sprite_create(tileset->imagePath);
+	}
+}
+
+/* Copies the layer's data into an array of its own with elements of size, widening them if need be. */
+void copyLayerData(GAE_Tiled_Layer_t* layer, const unsigned int size) {
+	const unsigned int length = GAE_Array_length(layer->data);
+	GAE_Array_t* data = GAE_Array_create(size);
+	unsigned int index = 0U;
+
+	GAE_Array_resize(data, length);
+	if (size == layer->data->size)
+		memcpy(GAE_Array_begin(data), GAE_Array_begin(layer->data), length * size);
+	else {
+		for (index = 0U; index < length; ++index)
+			*(unsigned int*)GAE_Array_get(data, index) = GAE_TiledParser_getGid(layer, index);
+	}
+
+	deleteLayerData(layer);
+	layer->data = data;
+}
+
+void deleteLayerData(GAE_Tiled_Layer_t* layer) {
+	if (0 == layer->data)
+		return;
+
+	/* only the array is the layer's to free when its elements are in a cooked map */
+	if (GAE_TRUE == layer->isShared)
+		free(layer->data);
+	else
+		GAE_Array_delete(layer->data);
+
+	layer->data = 0;
+	layer->isShared = GAE_FALSE;
+}
+
+void deleteTileset(GAE_Tiled_Tileset_t* tileset) {
+	if (0 != tileset->image)
+		GAE_Sprite_delete(tileset->image);
+	if (0 != tileset->properties)
+		GAE_Map_delete(tileset->properties);
+	GAE_Array_delete(tileset->terrains);
+	GAE_Array_delete(tileset->tiles);
+}
+
+void deleteMap(GAE_Tiled_t* tilemap) {
+	GAE_Tiled_Layer_t* layer = 0;
+	GAE_Tiled_Tileset_t* tileset = 0;
+
+	for (layer = GAE_Array_begin(tilemap->layers); layer < (GAE_Tiled_Layer_t*)GAE_Array_end(tilemap->layers); ++layer)
+		deleteLayerData(layer);
+
+	for (tileset = GAE_Array_begin(tilemap->tilesets); tileset < (GAE_Tiled_Tileset_t*)GAE_Array_end(tilemap->tilesets); ++tileset)
+		deleteTileset(tileset);
+
+	GAE_Array_delete(tilemap->layers);
+	GAE_Array_delete(tilemap->tilesets);
+	if (0 != tilemap->properties)
+		GAE_Map_delete(tilemap->properties);
+	free(tilemap);
+}
@@ -8,6 +8,13 @@ struct GAE_Map_s;
 struct GAE_Array_s;
 struct GAE_Texture_s;
 struct GAE_Renderer_s;
+struct GAE_Mesh_s;
+struct GAE_IndexBuffer_s;
+struct GAE_Tiled_Tileset_s;
+
+#define GAE_TILED_CHUNK_SIZE 32U /* layers are baked into chunks of GAE_TILED_CHUNK_SIZE x GAE_TILED_CHUNK_SIZE tiles */
+#define GAE_TILED_PROPERTY_SIZE 256U /* property names and values are kept as strings of up to this, terminator included */
+#define GAE_TILED_PATH_SIZE 1024U
 
 typedef enum GAE_TILED_ORIENTATION_e {
 	GAE_TILED_ORTHAGONAL
@@ -15,16 +22,33 @@ typedef enum GAE_TILED_ORIENTATION_e {
 ,	GAE_TILED_STAGGERED
 } GAE_TILED_ORIENTATION;
 
+typedef struct GAE_Tiled_Chunk_s {
+	struct GAE_Mesh_s* mesh;
+	struct GAE_Tiled_Tileset_s* tileset; /* the one tileset whose tiles this chunk draws */
+	unsigned int x; /* in tiles */
+	unsigned int y;
+	unsigned int width;
+	unsigned int height;
+	unsigned int tileCount; /* amount of non-empty tiles */
+	float bounds[4]; /* 0 - left, 1 - top, 2 - right, 3 - bottom in pixels */
+} GAE_Tiled_Chunk_t;
+
 typedef struct GAE_Tiled_Layer_s {
 	char name[128];
 	char type[128];
-	struct GAE_Array_s* data;
+	struct GAE_Array_s* data; /* gids, unsigned int - or unsigned short from a cooked map where they all fit */
+	GAE_BOOL isShared; /* data points into a cooked map's buffer, so is copied out before it's written */
 	unsigned int width;
 	unsigned int height;
 	unsigned int opacity;
 	GAE_BOOL visible;
 	unsigned int x;
 	unsigned int y;
+	struct GAE_Array_s* chunks; /* chunksWide x chunksHigh for each tileset the layer uses, one tileset after another */
+	unsigned int chunksWide;
+	unsigned int chunksHigh;
+	unsigned int chunkSets; /* tilesets the layer draws from, each baked into a set of chunks of its own */
+	struct GAE_IndexBuffer_s* chunkIndices; /* shared by every full sized chunk */
 } GAE_Tiled_Layer_t;
 
 typedef struct GAE_Tiled_Terrain_s {
@@ -43,6 +67,7 @@ typedef struct GAE_Tiled_Tileset_s {
 	unsigned int imageHeight;
 	unsigned int margin;
 	char name[128];
+	char imagePath[GAE_TILED_PATH_SIZE];
 	struct GAE_Sprite_s* image;
 	struct GAE_Map_s* properties;
 	struct GAE_Array_s* terrains;
@@ -66,9 +91,25 @@ typedef struct GAE_Tiled_s {
 	struct GAE_Array_s* tilesets;
 } GAE_Tiled_t;
 
+/* Opens the file mapped, parses it, loads the tileset images and bakes every layer - returns 0 if it can't be read or isn't a valid map.
+ * A cooked map's layers point into the file's buffer, which must then be kept until the map is deleted. */
 GAE_Tiled_t* GAE_TiledParser_create(struct GAE_File_s* const file);
+/* Parses the Tiled JSON or cooked map already read into the file's buffer, without loading images or baking, returning 0 if it isn't valid.
+ * Layer data can be CSV, or base64 either uncompressed or compressed with zlib, gzip or zstd. */
+GAE_Tiled_t* GAE_TiledParser_parse(struct GAE_File_s* const file);
+/* Creates an empty map of properties, as the parser fills. */
+struct GAE_Map_s* GAE_TiledParser_createProperties(void);
+/* Returns the gid at index in the layer's data, whichever size it's held at. */
+unsigned int GAE_TiledParser_getGid(GAE_Tiled_Layer_t* const layer, const unsigned int index);
+/* Sets the gid at index in the layer's data, copying the data out of a cooked map or widening it first if it needs to be. */
+void GAE_TiledParser_setGid(GAE_Tiled_Layer_t* const layer, const unsigned int index, const unsigned int gid);
+/* Parses the file again and rebuilds only the layers that changed, or all of them if the grid or tilesets did - the map is kept as it was if the file isn't valid. */
+GAE_Tiled_t* GAE_TiledParser_reload(GAE_Tiled_t* tilemap, struct GAE_File_s* const file, GAE_BOOL* status);
 unsigned int GAE_TiledParser_getTileId(GAE_Tiled_t* tilemap, const unsigned int x, const unsigned int y, const unsigned int layerId);
 GAE_Tiled_Tileset_t* getTileset(GAE_Tiled_t* tilemap, const unsigned int tileId);
+GAE_Tiled_t* GAE_TiledParser_setTileId(GAE_Tiled_t* tilemap, const unsigned int x, const unsigned int y, const unsigned int layerId, const unsigned int tileId);
+GAE_Tiled_t* GAE_TiledParser_bake(GAE_Tiled_t* tilemap, const unsigned int layerId);
+GAE_Tiled_t* GAE_TiledParser_unbake(GAE_Tiled_t* tilemap, const unsigned int layerId);
 GAE_Tiled_t* GAE_TiledParser_draw(GAE_Tiled_t* tilemap, struct GAE_Renderer_s* renderer, const unsigned int layerId);
 void GAE_TiledParser_delete(GAE_Tiled_t* tiledParser);
 
@@ -0,0 +1,49 @@
+#include "TripleBuffer.h"
+
+#include <stdlib.h>
+
+#include "../Threads/Thread.h"
+
+#define INDEX_MASK 3U
+
+GAE_TripleBuffer_t* GAE_TripleBuffer_create(void) {
+	GAE_TripleBuffer_t* buffer = malloc(sizeof(GAE_TripleBuffer_t));
+
+	buffer->back = 0U;
+	buffer->middle = 1U;
+	buffer->front = 2U;
+
+	return buffer;
+}
+
+unsigned int GAE_TripleBuffer_getBack(GAE_TripleBuffer_t* const buffer) {
+	return buffer->back;
+}
+
+unsigned int GAE_TripleBuffer_publish(GAE_TripleBuffer_t* buffer) {
+	/* the exchange both publishes what was written and hands back whichever buffer is spare now */
+	buffer->back = GAE_Atomic_exchange(&buffer->middle, buffer->back | GAE_TRIPLE_BUFFER_FRESH) & INDEX_MASK;
+	return buffer->back;
+}
+
+GAE_BOOL GAE_TripleBuffer_isFresh(GAE_TripleBuffer_t* const buffer) {
+	return (0U != (GAE_Atomic_load(&buffer->middle) & GAE_TRIPLE_BUFFER_FRESH)) ? GAE_TRUE : GAE_FALSE;
+}
+
+GAE_BOOL GAE_TripleBuffer_acquire(GAE_TripleBuffer_t* buffer) {
+	if (GAE_FALSE == GAE_TripleBuffer_isFresh(buffer))
+		return GAE_FALSE;
+
+	/* only the writer can change middle meanwhile, and only to another fresh buffer, so this can't come back stale */
+	buffer->front = GAE_Atomic_exchange(&buffer->middle, buffer->front) & INDEX_MASK;
+	return GAE_TRUE;
+}
+
+unsigned int GAE_TripleBuffer_getFront(GAE_TripleBuffer_t* const buffer) {
+	return buffer->front;
+}
+
+void GAE_TripleBuffer_delete(GAE_TripleBuffer_t* buffer) {
+	free(buffer);
+	buffer = 0;
+}
@@ -0,0 +1,42 @@
+#ifndef _TRIPLE_BUFFER_H_
+#define _TRIPLE_BUFFER_H_
+
+#include "../GAE_Types.h"
+
+/*
+	Lock-free hand over of whole buffers from one writing thread to one reading thread.
+	Only indices 0 to 2 are juggled - the caller keeps three buffers of whatever it likes and uses the index it is given.
+	The writer always has a buffer to write, and the reader always has the newest finished one, so neither ever waits.
+	Buffers the reader didn't get to in time are simply written over.
+*/
+
+typedef struct GAE_TripleBuffer_s {
+	volatile unsigned int middle;	/* index of the spare buffer, with GAE_TRIPLE_BUFFER_FRESH set if it's newer than the reader's */
+	unsigned int back;				/* the writer's */
+	unsigned int front;				/* the reader's */
+} GAE_TripleBuffer_t;
+
+#define GAE_TRIPLE_BUFFER_FRESH 4U
+
+/* Creates a new triple buffer - the writer starts on 0, the reader on 2. */
+GAE_TripleBuffer_t* GAE_TripleBuffer_create(void);
+
+/* Returns the index the writer should fill. */
+unsigned int GAE_TripleBuffer_getBack(GAE_TripleBuffer_t* const buffer);
+
+/* Hands the filled back buffer over to the reader, returning the next index to fill. Writer thread only. */
+unsigned int GAE_TripleBuffer_publish(GAE_TripleBuffer_t* buffer);
+
+/* Returns GAE_TRUE if a buffer newer than front has been published - it stays so until acquired. Reader thread only. */
+GAE_BOOL GAE_TripleBuffer_isFresh(GAE_TripleBuffer_t* const buffer);
+
+/* Takes the newest published buffer if there is one, returning GAE_TRUE if front changed. Reader thread only. */
+GAE_BOOL GAE_TripleBuffer_acquire(GAE_TripleBuffer_t* buffer);
+
+/* Returns the index the reader should read. */
+unsigned int GAE_TripleBuffer_getFront(GAE_TripleBuffer_t* const buffer);
+
+/* Deletes the triple buffer. */
+void GAE_TripleBuffer_delete(GAE_TripleBuffer_t* buffer);
+
+#endif
@@ -0,0 +1,861 @@
+#include "Zstd.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define MAGIC 0xFD2FB528U
+#define SKIPPABLE_MAGIC 0x184D2A50U
+#define SKIPPABLE_MASK 0xFFFFFFF0U
+#define MAX_BLOCK_SIZE 131072UL
+#define HUFFMAN_MAX_BITS 11U
+#define WEIGHTS_MAX_LOG 6U
+#define MAX_TABLE_LOG 9U
+#define MAX_SYMBOLS 64U
+
+typedef enum TABLE_e {
+	TABLE_LITERALS
+,	TABLE_OFFSETS
+,	TABLE_MATCHES
+,	TABLE_COUNT
+} TABLE;
+
+typedef struct FseEntry_s {
+	unsigned short baseline;
+	GAE_BYTE symbol;
+	GAE_BYTE bits;
+} FseEntry_t;
+
+typedef struct HuffmanEntry_s {
+	GAE_BYTE symbol;
+	GAE_BYTE bits;
+} HuffmanEntry_t;
+
+/* FSE and Huffman streams are read backwards from the last bit written - reading past the start gives zeros, and takes position below 0. */
+typedef struct BitReader_s {
+	const GAE_BYTE* start;
+	unsigned long size;
+	long position; /* bits left before the start */
+} BitReader_t;
+
+/* What carries from one block to the next within a frame. */
+typedef struct Context_s {
+	FseEntry_t tables[TABLE_COUNT][1U << MAX_TABLE_LOG];
+	unsigned int tableLogs[TABLE_COUNT];
+	GAE_BOOL hasTable[TABLE_COUNT];
+	HuffmanEntry_t huffman[1U << HUFFMAN_MAX_BITS];
+	unsigned int huffmanBits; /* 0 until a block has described a tree */
+	unsigned int offsets[3];
+	GAE_BYTE literals[MAX_BLOCK_SIZE];
+	unsigned long literalCount;
+} Context_t;
+
+static const unsigned int LITERAL_BASELINES[36] = {
+	0U, 1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U, 9U, 10U, 11U, 12U, 13U, 14U, 15U
+,	16U, 18U, 20U, 22U, 24U, 28U, 32U, 40U, 48U, 64U, 128U, 256U, 512U, 1024U, 2048U, 4096U
+,	8192U, 16384U, 32768U, 65536U
+};
+static const GAE_BYTE LITERAL_BITS[36] = {
+	0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U
+,	1U, 1U, 1U, 1U, 2U, 2U, 3U, 3U, 4U, 6U, 7U, 8U, 9U, 10U, 11U, 12U
+,	13U, 14U, 15U, 16U
+};
+static const unsigned int MATCH_BASELINES[53] = {
+	3U, 4U, 5U, 6U, 7U, 8U, 9U, 10U, 11U, 12U, 13U, 14U, 15U, 16U, 17U, 18U
+,	19U, 20U, 21U, 22U, 23U, 24U, 25U, 26U, 27U, 28U, 29U, 30U, 31U, 32U, 33U, 34U
+,	35U, 37U, 39U, 41U, 43U, 47U, 51U, 59U, 67U, 83U, 99U, 131U, 259U, 515U, 1027U, 2051U
+,	4099U, 8195U, 16387U, 32771U, 65539U
+};
+static const GAE_BYTE MATCH_BITS[53] = {
+	0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U
+,	0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U
+,	1U, 1U, 1U, 1U, 2U, 2U, 3U, 3U, 4U, 4U, 5U, 7U, 8U, 9U, 10U, 11U
+,	12U, 13U, 14U, 15U, 16U
+};
+
+/* The distributions used where a block asks for the predefined tables, with -1 for less than one. */
+static const short LITERAL_DEFAULTS[36] = {
+	4, 3, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 1
+,	2, 2, 2, 2, 2, 2, 2, 2, 2, 3, 2, 1, 1, 1, 1, 1
+,	-1, -1, -1, -1
+};
+static const short OFFSET_DEFAULTS[29] = {
+	1, 1, 1, 1, 1, 1, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1
+,	1, 1, 1, 1, 1, 1, 1, 1, -1, -1, -1, -1, -1
+};
+static const short MATCH_DEFAULTS[53] = {
+	1, 4, 3, 2, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1
+,	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1
+,	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, -1, -1
+,	-1, -1, -1, -1, -1
+};
+
+/* Per table - the most symbols, the largest accuracy log allowed, and the predefined distribution and its log. */
+static const unsigned int TABLE_SYMBOLS[TABLE_COUNT] = { 36U, 32U, 53U };
+static const unsigned int TABLE_MAX_LOGS[TABLE_COUNT] = { 9U, 8U, 9U };
+static const unsigned int TABLE_DEFAULT_LOGS[TABLE_COUNT] = { 6U, 5U, 6U };
+static const unsigned int TABLE_DEFAULT_COUNTS[TABLE_COUNT] = { 36U, 29U, 53U };
+
+static unsigned int readLittleEndian(const GAE_BYTE* data, const unsigned int count);
+static unsigned int highBit(unsigned int value);
+static unsigned int readForward(const GAE_BYTE* data, const unsigned long size, const unsigned long bit, const unsigned int count);
+static GAE_BOOL initBits(BitReader_t* reader, const GAE_BYTE* start, const unsigned long size);
+static unsigned int peekBits(BitReader_t* reader, const unsigned int count);
+static unsigned int readBits(BitReader_t* reader, const unsigned int count);
+static unsigned long readCounts(const GAE_BYTE* data, const unsigned long size, short* counts, unsigned int* symbolCount, unsigned int* log, const unsigned int maxSymbols, const unsigned int maxLog);
+static GAE_BOOL buildTable(FseEntry_t* table, const short* counts, const unsigned int symbolCount, const unsigned int log);
+static GAE_BOOL buildHuffman(Context_t* context, GAE_BYTE* weights, const unsigned int weightCount);
+static unsigned long readHuffman(Context_t* context, const GAE_BYTE* data, const unsigned long size);
+static GAE_BOOL decodeHuffman(Context_t* context, const GAE_BYTE* data, const unsigned long size, GAE_BYTE* out, const unsigned long count);
+static unsigned long readLiterals(Context_t* context, const GAE_BYTE* data, const unsigned long size);
+static GAE_BOOL readTable(Context_t* context, const TABLE table, const unsigned int mode, const GAE_BYTE* data, const unsigned long size, unsigned long* used);
+static unsigned int getOffset(Context_t* context, const unsigned int offsetValue, const unsigned int literalLength);
+static GAE_BOOL decodeSequences(Context_t* context, const GAE_BYTE* data, const unsigned long size, GAE_BYTE* const frameStart, GAE_BYTE** out, GAE_BYTE* const end);
+static unsigned long decodeFrame(Context_t* context, const GAE_BYTE* source, const unsigned long sourceSize, GAE_BYTE** out, GAE_BYTE* const end);
+
+GAE_BOOL GAE_Zstd_decompress(const GAE_BYTE* const source, const unsigned long sourceSize, GAE_BYTE* destination, const unsigned long size) {
+	Context_t* context = (Context_t*)malloc(sizeof(Context_t));
+	GAE_BYTE* out = destination;
+	unsigned long position = 0UL;
+	GAE_BOOL status = GAE_TRUE;
+
+	if (0 == context)
+		return GAE_FALSE;
+
+	while ((GAE_TRUE == status) && (position < sourceSize)) {
+		const unsigned long used = decodeFrame(context, source + position, sourceSize - position, &out, destination + size);
+
+		if (0UL == used)
+			status = GAE_FALSE;
+		position += used;
+	}
+
+	free(context);
+	return ((GAE_TRUE == status) && (out == destination + size)) ? GAE_TRUE : GAE_FALSE;
+}
+
+unsigned int readLittleEndian(const GAE_BYTE* data, const unsigned int count) {
+	unsigned int value = 0U;
+	unsigned int index = 0U;
+
+	for (index = 0U; index < count; ++index)
+		value |= (unsigned int)data[index] << (8U * index);
+
+	return value;
+}
+
+unsigned int highBit(unsigned int value) {
+	unsigned int bit = 0U;
+
+	while (1U < value) {
+		value >>= 1U;
+		++bit;
+	}
+
+	return bit;
+}
+
+/* Reads count bits, of up to 24, from bit on in a stream read forwards - anything past size reads as zeros. */
+unsigned int readForward(const GAE_BYTE* data, const unsigned long size, const unsigned long bit, const unsigned int count) {
+	const unsigned long byte = bit / 8UL;
+	unsigned int word = 0U;
+
+	if (byte < size)
+		word = readLittleEndian(data + byte, (size - byte < 4UL) ? (unsigned int)(size - byte) : 4U);
+
+	return (word >> (bit % 8UL)) & ((1U << count) - 1U);
+}
+
+/* Starts the reader on the bit below the highest one of the last byte, which only marks where the stream ends. */
+GAE_BOOL initBits(BitReader_t* reader, const GAE_BYTE* start, const unsigned long size) {
+	if ((0UL == size) || (0U == start[size - 1UL]))
+		return GAE_FALSE;
+
+	reader->start = start;
+	reader->size = size;
+	reader->position = (long)(((size - 1UL) * 8UL) + highBit(start[size - 1UL]));
+	return GAE_TRUE;
+}
+
+/* Returns the next count bits, of up to 24, without moving past them. */
+unsigned int peekBits(BitReader_t* reader, const unsigned int count) {
+	const long low = reader->position - (long)count;
+	unsigned long byte = 0UL;
+	unsigned int word = 0U;
+
+	if (0L >= reader->position)
+		return 0U;
+
+	/* what's left runs out before count, so the bits that are there are the top of it */
+	if (0L > low) {
+		word = readLittleEndian(reader->start, (reader->size < 4UL) ? (unsigned int)reader->size : 4U);
+		return (word & ((1U << reader->position) - 1U)) << (unsigned int)(-low);
+	}
+
+	byte = (unsigned long)low / 8UL;
+	word = readLittleEndian(reader->start + byte, (reader->size - byte < 4UL) ? (unsigned int)(reader->size - byte) : 4U);
+	return (word >> ((unsigned long)low % 8UL)) & ((1U << count) - 1U);
+}
+
+/* Reads the next count bits, of up to 31. */
+unsigned int readBits(BitReader_t* reader, const unsigned int count) {
+	unsigned int value = 0U;
+
+	if (0U == count)
+		return 0U;
+
+	if (24U < count) {
+		value = readBits(reader, count - 16U) << 16U;
+		return value | readBits(reader, 16U);
+	}
+
+	value = peekBits(reader, count);
+	reader->position -= (long)count;
+	return value;
+}
+
+/* Reads an FSE table description into counts, returning how many bytes it took, or 0 if it isn't valid. */
+unsigned long readCounts(const GAE_BYTE* data, const unsigned long size, short* counts, unsigned int* symbolCount, unsigned int* log, const unsigned int maxSymbols, const unsigned int maxLog) {
+	unsigned long bit = 4UL;
+	unsigned int symbol = 0U;
+	unsigned int bits = 0U;
+	int remaining = 0;
+	int threshold = 0;
+
+	if (0UL == size)
+		return 0UL;
+
+	*log = (data[0] & 15U) + 5U;
+	if (maxLog < *log)
+		return 0UL;
+
+	remaining = (1 << *log) + 1;
+	threshold = 1 << *log;
+	bits = *log + 1U;
+
+	while ((1 < remaining) && (symbol < maxSymbols)) {
+		const int max = (2 * threshold) - 1 - remaining;
+		const int value = (int)readForward(data, size, bit, bits);
+		int count = 0;
+
+		/* the smaller values take one bit fewer */
+		if ((value & (threshold - 1)) < max) {
+			count = value & (threshold - 1);
+			bit += bits - 1U;
+		}
+		else {
+			count = value & ((2 * threshold) - 1);
+			if (count >= threshold)
+				count -= max;
+			bit += bits;
+		}
+
+		--count;
+		remaining -= (0 > count) ? -count : count;
+		counts[symbol++] = (short)count;
+
+		/* a zero is followed by how many more zeros there are, two bits at a time while they're all set */
+		if (0 == count) {
+			unsigned int repeat = 3U;
+
+			while (3U == repeat) {
+				repeat = readForward(data, size, bit, 2U);
+				bit += 2UL;
+				if (maxSymbols < symbol + repeat)
+					return 0UL;
+				memset(counts + symbol, 0, repeat * sizeof(short));
+				symbol += repeat;
+			}
+		}
+
+		while (remaining < threshold) {
+			--bits;
+			threshold >>= 1;
+		}
+	}
+
+	if ((1 != remaining) || (size * 8UL < bit))
+		return 0UL;
+
+	*symbolCount = symbol;
+	return (bit + 7UL) / 8UL;
+}
+
+/* Spreads the symbols over the table by their counts, as the encoder did. */
+GAE_BOOL buildTable(FseEntry_t* table, const short* counts, const unsigned int symbolCount, const unsigned int log) {
+	const unsigned int size = 1U << log;
+	const unsigned int mask = size - 1U;
+	const unsigned int step = (size >> 1U) + (size >> 3U) + 3U;
+	unsigned short next[MAX_SYMBOLS];
+	unsigned int high = size - 1U;
+	unsigned int position = 0U;
+	unsigned int symbol = 0U;
+	unsigned int index = 0U;
+
+	/* those less than one take a slot each at the top, so are spread around */
+	for (symbol = 0U; symbol < symbolCount; ++symbol) {
+		if (-1 == counts[symbol]) {
+			table[high--].symbol = (GAE_BYTE)symbol;
+			next[symbol] = 1U;
+		}
+		else
+			next[symbol] = (unsigned short)counts[symbol];
+	}
+
+	for (symbol = 0U; symbol < symbolCount; ++symbol) {
+		for (index = 0U; (int)index < counts[symbol]; ++index) {
+			table[position].symbol = (GAE_BYTE)symbol;
+			do {
+				position = (position + step) & mask;
+			} while (position > high);
+		}
+	}
+
+	if (0U != position)
+		return GAE_FALSE;
+
+	for (index = 0U; index < size; ++index) {
+		const unsigned int state = next[table[index].symbol]++;
+		const unsigned int bits = log - highBit(state);
+
+		table[index].bits = (GAE_BYTE)bits;
+		table[index].baseline = (unsigned short)((state << bits) - size);
+	}
+
+	return GAE_TRUE;
+}
+
+/* Builds the decoding table from the weights of all but the last symbol, whose weight is whatever makes the total a power of two. */
+GAE_BOOL buildHuffman(Context_t* context, GAE_BYTE* weights, const unsigned int weightCount) {
+	unsigned int total = 0U;
+	unsigned int remaining = 0U;
+	unsigned int bits = 0U;
+	unsigned int weight = 0U;
+	unsigned int symbol = 0U;
+	unsigned int position = 0U;
+
+	for (symbol = 0U; symbol < weightCount; ++symbol) {
+		if (HUFFMAN_MAX_BITS < weights[symbol])
+			return GAE_FALSE;
+		if (0U != weights[symbol])
+			total += 1U << (weights[symbol] - 1U);
+	}
+
+	if (0U == total)
+		return GAE_FALSE;
+
+	bits = highBit(total) + 1U;
+	remaining = (1U << bits) - total;
+	if ((HUFFMAN_MAX_BITS < bits) || (0U != (remaining & (remaining - 1U))))
+		return GAE_FALSE;
+	weights[weightCount] = (GAE_BYTE)(highBit(remaining) + 1U);
+
+	/* the lightest symbols take the lowest codes, and in the order they come within a weight */
+	for (weight = 1U; weight <= bits; ++weight) {
+		for (symbol = 0U; symbol <= weightCount; ++symbol) {
+			if (weight == weights[symbol]) {
+				const unsigned int length = 1U << (weight - 1U);
+				unsigned int index = 0U;
+
+				for (index = 0U; index < length; ++index) {
+					context->huffman[position + index].symbol = (GAE_BYTE)symbol;
+					context->huffman[position + index].bits = (GAE_BYTE)(bits + 1U - weight);
+				}
+				position += length;
+			}
+		}
+	}
+
+	context->huffmanBits = bits;
+	return GAE_TRUE;
+}
+
+/* Reads the tree description, returning how many bytes it took, or 0 if it isn't valid. */
+unsigned long readHuffman(Context_t* context, const GAE_BYTE* data, const unsigned long size) {
+	GAE_BYTE weights[256];
+	unsigned int weightCount = 0U;
+	unsigned long used = 0UL;
+
+	if (0UL == size)
+		return 0UL;
+
+	if (128U > data[0]) {
+		/* weights compressed with their own FSE table, decoded by two states taking turns */
+		FseEntry_t table[1U << WEIGHTS_MAX_LOG];
+		short counts[MAX_SYMBOLS];
+		BitReader_t reader;
+		unsigned int symbolCount = 0U;
+		unsigned int log = 0U;
+		unsigned int states[2];
+		unsigned int turn = 0U;
+		unsigned long countsSize = 0UL;
+
+		used = 1UL + data[0];
+		if (size < used)
+			return 0UL;
+
+		countsSize = readCounts(data + 1, data[0], counts, &symbolCount, &log, HUFFMAN_MAX_BITS + 1U, WEIGHTS_MAX_LOG);
+		if ((0UL == countsSize) || (GAE_FALSE == buildTable(table, counts, symbolCount, log)))
+			return 0UL;
+		if ((data[0] <= countsSize) || (GAE_FALSE == initBits(&reader, data + 1 + countsSize, data[0] - countsSize)))
+			return 0UL;
+
+		states[0] = readBits(&reader, log);
+		states[1] = readBits(&reader, log);
+		for (;;) {
+			FseEntry_t* entry = &table[states[turn]];
+
+			if (253U < weightCount)
+				return 0UL;
+
+			weights[weightCount++] = entry->symbol;
+			states[turn] = entry->baseline + readBits(&reader, entry->bits);
+
+			/* once the stream's overrun, the other state still holds a weight */
+			if (0L > reader.position) {
+				weights[weightCount++] = table[states[1U - turn]].symbol;
+				break;
+			}
+			turn = 1U - turn;
+		}
+	}
+	else {
+		unsigned int index = 0U;
+
+		weightCount = data[0] - 127U;
+		used = 1UL + ((weightCount + 1U) / 2U);
+		if (size < used)
+			return 0UL;
+
+		for (index = 0U; index < weightCount; ++index)
+			weights[index] = (0U == index % 2U) ? (GAE_BYTE)(data[1U + (index / 2U)] >> 4U) : (GAE_BYTE)(data[1U + (index / 2U)] & 15U);
+	}
+
+	return (GAE_TRUE == buildHuffman(context, weights, weightCount)) ? used : 0UL;
+}
+
+/* Decodes count literals from one stream, which must use every bit it has. */
+GAE_BOOL decodeHuffman(Context_t* context, const GAE_BYTE* data, const unsigned long size, GAE_BYTE* out, const unsigned long count) {
+	const unsigned int bits = context->huffmanBits;
+	BitReader_t reader;
+	unsigned long index = 0UL;
+
+	if (GAE_FALSE == initBits(&reader, data, size))
+		return GAE_FALSE;
+
+	for (index = 0UL; index < count; ++index) {
+		const HuffmanEntry_t* entry = &context->huffman[peekBits(&reader, bits)];
+
+		out[index] = entry->symbol;
+		reader.position -= entry->bits;
+	}
+
+	return (0L == reader.position) ? GAE_TRUE : GAE_FALSE;
+}
+
+/* Reads the block's literals into the context, returning how many bytes they took, or 0 if they aren't valid. */
+unsigned long readLiterals(Context_t* context, const GAE_BYTE* data, const unsigned long size) {
+	const unsigned int type = data[0] & 3U;
+	const unsigned int format = (data[0] >> 2U) & 3U;
+	unsigned long header = 0UL;
+	unsigned long count = 0UL;
+	unsigned long compressedSize = 0UL;
+	unsigned long position = 0UL;
+
+	/* raw or a single byte repeated */
+	if (2U > type) {
+		header = (1U == format) ? 2UL : ((3U == format) ? 3UL : 1UL);
+		if (size < header)
+			return 0UL;
+
+		if (1UL == header)
+			count = data[0] >> 3U;
+		else if (2UL == header)
+			count = (data[0] >> 4U) + ((unsigned long)data[1] << 4U);
+		else
+			count = (data[0] >> 4U) + ((unsigned long)data[1] << 4U) + ((unsigned long)data[2] << 12U);
+
+		if (MAX_BLOCK_SIZE < count)
+			return 0UL;
+		context->literalCount = count;
+
+		if (0U == type) {
+			if (size - header < count)
+				return 0UL;
+			memcpy(context->literals, data + header, count);
+			return header + count;
+		}
+
+		if (size - header < 1UL)
+			return 0UL;
+		memset(context->literals, data[header], count);
+		return header + 1UL;
+	}
+
+	/* Huffman coded, with a new tree or the last one */
+	header = (3U == format) ? 5UL : ((2U == format) ? 4UL : 3UL);
+	if (size < header)
+		return 0UL;
+
+	if (3UL == header) {
+		const unsigned int value = readLittleEndian(data, 3U);
+		count = (value >> 4U) & 0x3FFU;
+		compressedSize = (value >> 14U) & 0x3FFU;
+	}
+	else if (4UL == header) {
+		const unsigned int value = readLittleEndian(data, 4U);
+		count = (value >> 4U) & 0x3FFFU;
+		compressedSize = value >> 18U;
+	}
+	else {
+		const unsigned int value = readLittleEndian(data, 4U);
+		count = (value >> 4U) & 0x3FFFFU;
+		compressedSize = (value >> 22U) | ((unsigned long)data[4] << 10U);
+	}
+
+	if ((MAX_BLOCK_SIZE < count) || (size - header < compressedSize))
+		return 0UL;
+	context->literalCount = count;
+
+	position = header;
+	if (2U == type) {
+		const unsigned long used = readHuffman(context, data + position, compressedSize);
+		if (0UL == used)
+			return 0UL;
+		position += used;
+	}
+	else if (0U == context->huffmanBits)
+		return 0UL;
+
+	if (header + compressedSize < position)
+		return 0UL;
+
+	if (0U == format) {
+		if (GAE_FALSE == decodeHuffman(context, data + position, header + compressedSize - position, context->literals, count))
+			return 0UL;
+	}
+	else {
+		/* four streams, each a quarter of the literals but the last, which takes what's left */
+		const unsigned long streamsSize = header + compressedSize - position;
+		const unsigned long segment = (count + 3UL) / 4UL;
+		unsigned long sizes[4];
+		unsigned long stream = 0UL;
+		unsigned int index = 0U;
+
+		if ((6UL > streamsSize) || (count < segment * 3UL))
+			return 0UL;
+
+		sizes[0] = readLittleEndian(data + position, 2U);
+		sizes[1] = readLittleEndian(data + position + 2U, 2U);
+		sizes[2] = readLittleEndian(data + position + 4U, 2U);
+		if (streamsSize - 6UL < sizes[0] + sizes[1] + sizes[2])
+			return 0UL;
+		sizes[3] = streamsSize - 6UL - sizes[0] - sizes[1] - sizes[2];
+
+		stream = position + 6UL;
+		for (index = 0U; index < 4U; ++index) {
+			const unsigned long length = (3U == index) ? count - (segment * 3UL) : segment;
+
+			if (GAE_FALSE == decodeHuffman(context, data + stream, sizes[index], context->literals + (segment * index), length))
+				return 0UL;
+			stream += sizes[index];
+		}
+	}
+
+	return header + compressedSize;
+}
+
+/* Sets up the table for literal lengths, offsets or match lengths as mode says - predefined, a single symbol, described here, or the last one. */
+GAE_BOOL readTable(Context_t* context, const TABLE table, const unsigned int mode, const GAE_BYTE* data, const unsigned long size, unsigned long* used) {
+	static const short* const DEFAULTS[TABLE_COUNT] = { LITERAL_DEFAULTS, OFFSET_DEFAULTS, MATCH_DEFAULTS };
+	FseEntry_t* entries = context->tables[table];
+	short counts[MAX_SYMBOLS];
+	unsigned int symbolCount = 0U;
+	unsigned int log = 0U;
+
+	*used = 0UL;
+	switch (mode) {
+		case 0U: {
+			log = TABLE_DEFAULT_LOGS[table];
+			if (GAE_FALSE == buildTable(entries, DEFAULTS[table], TABLE_DEFAULT_COUNTS[table], log))
+				return GAE_FALSE;
+		}
+		break;
+		case 1U: {
+			if ((0UL == size) || (TABLE_SYMBOLS[table] <= data[0]))
+				return GAE_FALSE;
+			entries[0].symbol = data[0];
+			entries[0].bits = 0U;
+			entries[0].baseline = 0U;
+			*used = 1UL;
+		}
+		break;
+		case 2U: {
+			*used = readCounts(data, size, counts, &symbolCount, &log, TABLE_SYMBOLS[table], TABLE_MAX_LOGS[table]);
+			if ((0UL == *used) || (GAE_FALSE == buildTable(entries, counts, symbolCount, log)))
+				return GAE_FALSE;
+		}
+		break;
+		default: {
+			if (GAE_FALSE == context->hasTable[table])
+				return GAE_FALSE;
+			log = context->tableLogs[table];
+		}
+		break;
+	}
+
+	context->tableLogs[table] = log;
+	context->hasTable[table] = GAE_TRUE;
+	return GAE_TRUE;
+}
+
+/* Turns the offset value into an offset, either new or one of the last three, and keeps those up to date - 0 if it isn't valid. */
+unsigned int getOffset(Context_t* context, const unsigned int offsetValue, const unsigned int literalLength) {
+	unsigned int* offsets = context->offsets;
+	unsigned int offset = 0U;
+	unsigned int repeat = 0U;
+
+	if (3U < offsetValue) {
+		offset = offsetValue - 3U;
+		offsets[2] = offsets[1];
+		offsets[1] = offsets[0];
+		offsets[0] = offset;
+		return offset;
+	}
+
+	/* without literals first, the repeats shift along by one, and the last is one less than the most recent */
+	repeat = offsetValue - 1U + ((0U == literalLength) ? 1U : 0U);
+	if (0U == repeat)
+		return offsets[0];
+
+	offset = (3U == repeat) ? offsets[0] - 1U : offsets[repeat];
+	if (1U < repeat)
+		offsets[2] = offsets[1];
+	offsets[1] = offsets[0];
+	offsets[0] = offset;
+	return offset;
+}
+
+/* Decodes the sequences, each some literals then a match, and carries them out - with whatever literals are left copied at the end. */
+GAE_BOOL decodeSequences(Context_t* context, const GAE_BYTE* data, const unsigned long size, GAE_BYTE* const frameStart, GAE_BYTE** out, GAE_BYTE* const end) {
+	const GAE_BYTE* literals = context->literals;
+	const GAE_BYTE* const literalsEnd = context->literals + context->literalCount;
+	GAE_BYTE* output = *out;
+	unsigned long position = 1UL;
+	unsigned long count = 0UL;
+
+	if (0UL == size)
+		return GAE_FALSE;
+
+	if (128U > data[0])
+		count = data[0];
+	else if (255U > data[0]) {
+		if (2UL > size)
+			return GAE_FALSE;
+		count = ((unsigned long)(data[0] - 128U) << 8U) + data[1];
+		position = 2UL;
+	}
+	else {
+		if (3UL > size)
+			return GAE_FALSE;
+		count = data[1] + ((unsigned long)data[2] << 8U) + 0x7F00UL;
+		position = 3UL;
+	}
+
+	if (0UL < count) {
+		BitReader_t reader;
+		unsigned int states[TABLE_COUNT];
+		unsigned int modes = 0U;
+		unsigned int table = 0U;
+		unsigned long sequence = 0UL;
+
+		if (size <= position)
+			return GAE_FALSE;
+		modes = data[position++];
+		if (0U != (modes & 3U))
+			return GAE_FALSE;
+
+		for (table = 0U; table < TABLE_COUNT; ++table) {
+			unsigned long used = 0UL;
+
+			if (GAE_FALSE == readTable(context, (TABLE)table, (modes >> (6U - (2U * table))) & 3U, data + position, size - position, &used))
+				return GAE_FALSE;
+			position += used;
+		}
+
+		if ((size < position) || (GAE_FALSE == initBits(&reader, data + position, size - position)))
+			return GAE_FALSE;
+
+		states[TABLE_LITERALS] = readBits(&reader, context->tableLogs[TABLE_LITERALS]);
+		states[TABLE_OFFSETS] = readBits(&reader, context->tableLogs[TABLE_OFFSETS]);
+		states[TABLE_MATCHES] = readBits(&reader, context->tableLogs[TABLE_MATCHES]);
+
+		for (sequence = 0UL; sequence < count; ++sequence) {
+			const FseEntry_t* literalEntry = &context->tables[TABLE_LITERALS][states[TABLE_LITERALS]];
+			const FseEntry_t* offsetEntry = &context->tables[TABLE_OFFSETS][states[TABLE_OFFSETS]];
+			const FseEntry_t* matchEntry = &context->tables[TABLE_MATCHES][states[TABLE_MATCHES]];
+			unsigned int offsetValue = 0U;
+			unsigned int matchLength = 0U;
+			unsigned int literalLength = 0U;
+			unsigned int offset = 0U;
+
+			/* the extra bits come offset, match, then literals, and the states update literals, match, then offset */
+			offsetValue = (1U << offsetEntry->symbol) + readBits(&reader, offsetEntry->symbol);
+			matchLength = MATCH_BASELINES[matchEntry->symbol] + readBits(&reader, MATCH_BITS[matchEntry->symbol]);
+			literalLength = LITERAL_BASELINES[literalEntry->symbol] + readBits(&reader, LITERAL_BITS[literalEntry->symbol]);
+			if (sequence + 1UL < count) {
+				states[TABLE_LITERALS] = literalEntry->baseline + readBits(&reader, literalEntry->bits);
+				states[TABLE_MATCHES] = matchEntry->baseline + readBits(&reader, matchEntry->bits);
+				states[TABLE_OFFSETS] = offsetEntry->baseline + readBits(&reader, offsetEntry->bits);
+			}
+
+			offset = getOffset(context, offsetValue, literalLength);
+			if ((0U == offset) || ((unsigned long)(literalsEnd - literals) < literalLength) || ((unsigned long)(end - output) < (unsigned long)literalLength + matchLength))
+				return GAE_FALSE;
+
+			memcpy(output, literals, literalLength);
+			literals += literalLength;
+			output += literalLength;
+
+			if ((unsigned long)(output - frameStart) < offset)
+				return GAE_FALSE;
+
+			/* a match closer than its length repeats what it's copying, so goes a byte at a time */
+			if (offset >= matchLength)
+				memcpy(output, output - offset, matchLength);
+			else {
+				const GAE_BYTE* match = output - offset;
+				unsigned int index = 0U;
+
+				for (index = 0U; index < matchLength; ++index)
+					output[index] = match[index];
+			}
+			output += matchLength;
+		}
+
+		if (0L != reader.position)
+			return GAE_FALSE;
+	}
+	else if (size != position)
+		return GAE_FALSE;
+
+	if ((unsigned long)(end - output) < (unsigned long)(literalsEnd - literals))
+		return GAE_FALSE;
+	memcpy(output, literals, (unsigned long)(literalsEnd - literals));
+	output += literalsEnd - literals;
+
+	*out = output;
+	return GAE_TRUE;
+}
+
+/* Decodes the frame at source into out, returning how many bytes it took, or 0 if it isn't valid. */
+unsigned long decodeFrame(Context_t* context, const GAE_BYTE* source, const unsigned long sourceSize, GAE_BYTE** out, GAE_BYTE* const end) {
+	static const unsigned int DICTIONARY_SIZES[4] = { 0U, 1U, 2U, 4U };
+	GAE_BYTE* const frameStart = *out;
+	unsigned int descriptor = 0U;
+	unsigned int sizeBytes = 0U;
+	unsigned long contentSize = 0UL;
+	unsigned long position = 5UL;
+	GAE_BOOL isSingleSegment = GAE_FALSE;
+	GAE_BOOL isLast = GAE_FALSE;
+
+	if (8UL > sourceSize)
+		return 0UL;
+
+	/* skippable frames carry anything at all, so are stepped over */
+	if (SKIPPABLE_MAGIC == (readLittleEndian(source, 4U) & SKIPPABLE_MASK)) {
+		const unsigned long skipped = readLittleEndian(source + 4, 4U);
+		return (sourceSize - 8UL < skipped) ? 0UL : 8UL + skipped;
+	}
+
+	if (MAGIC != readLittleEndian(source, 4U))
+		return 0UL;
+
+	/* the reserved bit must be clear, and a dictionary, where there is one, can't be provided */
+	descriptor = source[4];
+	isSingleSegment = (0U != (descriptor & 0x20U)) ? GAE_TRUE : GAE_FALSE;
+	if (0U != (descriptor & 0x08U))
+		return 0UL;
+
+	if (GAE_FALSE == isSingleSegment)
+		++position;
+
+	if ((sourceSize < position + DICTIONARY_SIZES[descriptor & 3U]) || (0U != readLittleEndian(source + position, DICTIONARY_SIZES[descriptor & 3U])))
+		return 0UL;
+	position += DICTIONARY_SIZES[descriptor & 3U];
+
+	sizeBytes = (0U == (descriptor >> 6U)) ? ((GAE_TRUE == isSingleSegment) ? 1U : 0U) : (1U << (descriptor >> 6U));
+	if (sourceSize < position + sizeBytes)
+		return 0UL;
+	if (8U == sizeBytes) {
+		if (0U != readLittleEndian(source + position + 4U, 4U))
+			return 0UL;
+		contentSize = readLittleEndian(source + position, 4U);
+	}
+	else if (0U < sizeBytes)
+		contentSize = readLittleEndian(source + position, sizeBytes) + ((2U == sizeBytes) ? 256UL : 0UL);
+	position += sizeBytes;
+
+	context->offsets[0] = 1U;
+	context->offsets[1] = 4U;
+	context->offsets[2] = 8U;
+	context->huffmanBits = 0U;
+	memset(context->hasTable, 0, sizeof(context->hasTable));
+
+	while (GAE_FALSE == isLast) {
+		unsigned int header = 0U;
+		unsigned long blockSize = 0UL;
+
+		if (sourceSize - position < 3UL)
+			return 0UL;
+		header = readLittleEndian(source + position, 3U);
+		isLast = (0U != (header & 1U)) ? GAE_TRUE : GAE_FALSE;
+		blockSize = header >> 3U;
+		position += 3UL;
+
+		switch ((header >> 1U) & 3U) {
+			case 0U: {
+				if ((sourceSize - position < blockSize) || ((unsigned long)(end - *out) < blockSize))
+					return 0UL;
+				memcpy(*out, source + position, blockSize);
+				*out += blockSize;
+				position += blockSize;
+			}
+			break;
+			case 1U: {
+				if ((sourceSize - position < 1UL) || ((unsigned long)(end - *out) < blockSize))
+					return 0UL;
+				memset(*out, source[position], blockSize);
+				*out += blockSize;
+				position += 1UL;
+			}
+			break;
+			case 2U: {
+				unsigned long used = 0UL;
+
+				if ((MAX_BLOCK_SIZE < blockSize) || (sourceSize - position < blockSize) || (0UL == blockSize))
+					return 0UL;
+
+				used = readLiterals(context, source + position, blockSize);
+				if ((0UL == used) || (GAE_FALSE == decodeSequences(context, source + position + used, blockSize - used, frameStart, out, end)))
+					return 0UL;
+				position += blockSize;
+			}
+			break;
+			default:
+				return 0UL;
+			break;
+		}
+	}
+
+	/* the checksum is skipped, not checked */
+	if (0U != (descriptor & 0x04U)) {
+		if (sourceSize - position < 4UL)
+			return 0UL;
+		position += 4UL;
+	}
+
+	if ((0U < sizeBytes) && ((unsigned long)(*out - frameStart) != contentSize))
+		return 0UL;
+
+	return position;
+}
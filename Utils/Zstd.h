@@ -0,0 +1,15 @@
+#ifndef _ZSTD_H_
+#define _ZSTD_H_
+
+#include "../GAE_Types.h"
+
+/*
+	Zstandard decompression (RFC 8878) - one or more frames decoded straight into a buffer the caller has sized.
+	Frames that need a dictionary aren't supported, and content checksums are skipped rather than checked;
+	every length, offset and table is checked against the buffers, so corrupt data fails rather than overruns.
+*/
+
+/* Decompresses source into destination, returning GAE_TRUE only if every frame is valid and they fill exactly size bytes. */
+GAE_BOOL GAE_Zstd_decompress(const GAE_BYTE* const source, const unsigned long sourceSize, GAE_BYTE* destination, const unsigned long size);
+
+#endif
@@ -6,11 +6,11 @@ LOCAL_MODULE    := glesgae
 
 FILE_LIST := $(wildcard $(LOCAL_PATH)/../Events/*.c)
 FILE_LIST += $(wildcard $(LOCAL_PATH)/../Events/SDL2/*.c)
-FILE_LIST += $(wildcard $(LOCAL_PATH)/../External/jsmn/*.c)
 FILE_LIST += $(wildcard $(LOCAL_PATH)/../File/*.c)
 FILE_LIST += $(wildcard $(LOCAL_PATH)/../File/Android/*.c)
 FILE_LIST += $(wildcard $(LOCAL_PATH)/../Graphics/*.c)
 FILE_LIST += $(wildcard $(LOCAL_PATH)/../Graphics/Context/SDL2/*.c)
+FILE_LIST += $(wildcard $(LOCAL_PATH)/../Graphics/Renderer/*.c)
 FILE_LIST += $(wildcard $(LOCAL_PATH)/../Graphics/Renderer/SDL2/*.c)
 FILE_LIST += $(wildcard $(LOCAL_PATH)/../Graphics/Sprite/SDL2/*.c)
 FILE_LIST += $(wildcard $(LOCAL_PATH)/../Graphics/Target/Texture/SDL2/*.c)
@@ -22,6 +22,7 @@ FILE_LIST += $(wildcard $(LOCAL_PATH)/../Maths/*.c)
 FILE_LIST += $(wildcard $(LOCAL_PATH)/../Platform/*.cpp)
 FILE_LIST += $(wildcard $(LOCAL_PATH)/../Platform/SDL2/*.c)
 FILE_LIST += $(wildcard $(LOCAL_PATH)/../States/*.c)
+FILE_LIST += $(wildcard $(LOCAL_PATH)/../Threads/Posix/*.c)
 FILE_LIST += $(wildcard $(LOCAL_PATH)/../Time/*.c)
 FILE_LIST += $(wildcard $(LOCAL_PATH)/../Time/Android/*.c)
 FILE_LIST += $(wildcard $(LOCAL_PATH)/../Utils/*.c)